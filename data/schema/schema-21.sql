@@ -0,0 +1,39 @@
+CREATE VIRTUAL TABLE songs_fts USING fts5(
+
+  title,
+  album,
+  artist,
+  albumartist,
+  composer,
+  performer,
+  grouping,
+  genre,
+  comment,
+
+  content='songs',
+  content_rowid='rowid',
+  tokenize='unicode61 remove_diacritics 2'
+
+);
+
+INSERT INTO songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment)
+SELECT rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment FROM songs;
+
+CREATE TRIGGER songs_fts_insert AFTER INSERT ON songs BEGIN
+  INSERT INTO songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment)
+  VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER songs_fts_delete AFTER DELETE ON songs BEGIN
+  INSERT INTO songs_fts (songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment)
+  VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER songs_fts_update AFTER UPDATE ON songs BEGIN
+  INSERT INTO songs_fts (songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment)
+  VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment)
+  VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+UPDATE schema_version SET version=21;
@@ -0,0 +1,11 @@
+CREATE INDEX IF NOT EXISTS idx_playcount ON songs (playcount) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_skipcount ON songs (skipcount) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_lastplayed ON songs (lastplayed) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_ctime ON songs (ctime) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_rating ON songs (rating) WHERE unavailable = 0;
+
+UPDATE schema_version SET version=22;
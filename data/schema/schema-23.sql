@@ -0,0 +1,5 @@
+CREATE INDEX IF NOT EXISTS idx_artist_album_title ON songs (artist, album, title) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_fingerprint ON songs (fingerprint);
+
+UPDATE schema_version SET version=23;
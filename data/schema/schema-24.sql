@@ -0,0 +1,10 @@
+CREATE TABLE IF NOT EXISTS lyrics (
+  artist TEXT NOT NULL,
+  title TEXT NOT NULL,
+  provider TEXT,
+  lyrics TEXT NOT NULL,
+  fetchtime INTEGER,
+  PRIMARY KEY (artist, title)
+);
+
+UPDATE schema_version SET version=24;
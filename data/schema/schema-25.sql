@@ -0,0 +1,9 @@
+CREATE INDEX IF NOT EXISTS idx_albumartist_album_url ON songs (effective_albumartist, album, url) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_comp_albumartist_album ON songs (compilation_effective, effective_albumartist, album, url) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_directory_id ON songs (directory_id);
+
+CREATE INDEX IF NOT EXISTS idx_playlist_items_playlist ON playlist_items (playlist);
+
+UPDATE schema_version SET version=25;
@@ -0,0 +1,46 @@
+/* Strawberry Music Player
+   Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+
+   Strawberry is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Strawberry is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <glib.h>
+#include <gst/gst.h>
+
+#include "gststrawberryeq.h"
+#include "gstequalizerplugin.h"
+
+static gboolean gst_strawberryeq_plugin_init(GstPlugin *plugin) {
+
+  if (!gst_element_register(plugin, "strawberryeq", GST_RANK_NONE, GST_TYPE_STRAWBERRYEQ)) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+int gststrawberryeq_register_static() {
+
+  return gst_plugin_register_static(
+    GST_VERSION_MAJOR,
+    GST_VERSION_MINOR,
+    "strawberryeq",
+    "Peaking biquad cascade equalizer",
+    gst_strawberryeq_plugin_init,
+    "0.1",
+    "GPL",
+    "StrawberryEq",
+    "StrawberryEq",
+    "https://www.strawberrymusicplayer.org");
+}
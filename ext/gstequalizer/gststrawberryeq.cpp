@@ -0,0 +1,317 @@
+/* Strawberry Music Player
+   Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+
+   Strawberry is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Strawberry is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include <glib.h>
+
+#include <gst/gst.h>
+#include <gst/audio/gstaudiofilter.h>
+
+#include "gststrawberryeq.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_strawberryeq_debug);
+
+namespace {
+
+// How fast a gain change is ramped towards its target, in dB per second.
+// Fast enough to feel immediate on a slider, slow enough that the coefficient steps per block are inaudible.
+constexpr gdouble kGainRampDbPerSecond = 48.0;
+
+// Gains this close to 0 dB leave the band flat, the band is then skipped.
+constexpr gdouble kFlatGainThresholdDb = 0.01;
+
+}  // namespace
+
+#define gst_strawberryeq_parent_class parent_class
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+G_DEFINE_TYPE(GstStrawberryEq, gst_strawberryeq, GST_TYPE_AUDIO_FILTER)
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+static void gst_strawberryeq_finalize(GObject *object);
+static gboolean gst_strawberryeq_stop(GstBaseTransform *trans);
+static GstFlowReturn gst_strawberryeq_transform_ip(GstBaseTransform *trans, GstBuffer *buffer);
+static gboolean gst_strawberryeq_setup(GstAudioFilter *base, const GstAudioInfo *info);
+
+static void gst_strawberryeq_class_init(GstStrawberryEqClass *klass) {
+
+  GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
+  GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+  GstAudioFilterClass *filter_class = GST_AUDIO_FILTER_CLASS(klass);
+  GstCaps *caps = nullptr;
+
+  gobject_class->finalize = gst_strawberryeq_finalize;
+
+  trans_class->stop = GST_DEBUG_FUNCPTR(gst_strawberryeq_stop);
+  trans_class->transform_ip = GST_DEBUG_FUNCPTR(gst_strawberryeq_transform_ip);
+  trans_class->passthrough_on_same_caps = FALSE;
+
+  filter_class->setup = GST_DEBUG_FUNCPTR(gst_strawberryeq_setup);
+
+  GST_DEBUG_CATEGORY_INIT(gst_strawberryeq_debug, "strawberryeq", 0, "strawberry equalizer element");
+
+  gst_element_class_set_static_metadata(element_class, "Strawberry equalizer",
+    "Filter/Effect/Audio",
+    "Peaking biquad cascade equalizer with ramped gain changes",
+    "Jonas Kvinge <jonas@jkvinge.net>");
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+  caps = gst_caps_from_string(GST_AUDIO_CAPS_MAKE("{ F32LE }") ", layout = (string) interleaved");
+#else
+  caps = gst_caps_from_string(GST_AUDIO_CAPS_MAKE("{ F32BE }") ", layout = (string) interleaved");
+#endif
+
+  gst_audio_filter_class_add_pad_templates(filter_class, caps);
+  gst_caps_unref(caps);
+
+}
+
+static void gst_strawberryeq_init(GstStrawberryEq *eq) {
+
+  g_mutex_init(&eq->lock);
+
+  eq->num_bands = 0;
+  for (gint i = 0; i < GST_STRAWBERRYEQ_MAX_BANDS; ++i) {
+    GstStrawberryEqBand &band = eq->bands[i];
+    band.frequency = 0.0;
+    band.bandwidth = 0.0;
+    band.target_gain_db = 0.0;
+    band.current_gain_db = 0.0;
+    band.b0 = band.b1 = band.b2 = band.a1 = band.a2 = 0.0;
+    band.active = FALSE;
+  }
+
+  eq->state = nullptr;
+  eq->channels = 0;
+  eq->rate = 0;
+
+}
+
+static void gst_strawberryeq_finalize(GObject *object) {
+
+  GstStrawberryEq *eq = GST_STRAWBERRYEQ(object);
+
+  g_free(eq->state);
+  eq->state = nullptr;
+
+  g_mutex_clear(&eq->lock);
+
+  G_OBJECT_CLASS(parent_class)->finalize(object);
+
+}
+
+// Peaking biquad from the RBJ audio EQ cookbook, with the bandwidth given in Hz.
+// Must be called with the lock held and a valid rate.
+static void gst_strawberryeq_update_coefficients(GstStrawberryEq *eq, GstStrawberryEqBand *band) {
+
+  if (std::abs(band->current_gain_db) < kFlatGainThresholdDb && std::abs(band->target_gain_db) < kFlatGainThresholdDb) {
+    band->active = FALSE;
+    return;
+  }
+
+  const gdouble q = band->bandwidth > 0.0 ? band->frequency / band->bandwidth : 1.0;
+  const gdouble w0 = 2.0 * G_PI * band->frequency / eq->rate;
+  const gdouble amp = std::pow(10.0, band->current_gain_db / 40.0);
+  const gdouble alpha = std::sin(w0) / (2.0 * q);
+
+  const gdouble a0 = 1.0 + alpha / amp;
+  band->b0 = (1.0 + alpha * amp) / a0;
+  band->b1 = (-2.0 * std::cos(w0)) / a0;
+  band->b2 = (1.0 - alpha * amp) / a0;
+  band->a1 = (-2.0 * std::cos(w0)) / a0;
+  band->a2 = (1.0 - alpha / amp) / a0;
+
+  band->active = TRUE;
+
+}
+
+// Moves the ramped gains one block closer to their targets and refreshes the coefficients.
+// Must be called with the lock held. Returns the number of active bands.
+static gint gst_strawberryeq_ramp_gains(GstStrawberryEq *eq, const gdouble block_seconds) {
+
+  const gdouble max_step = kGainRampDbPerSecond * block_seconds;
+
+  gint active_bands = 0;
+  for (gint i = 0; i < eq->num_bands; ++i) {
+    GstStrawberryEqBand *band = &eq->bands[i];
+    if (band->current_gain_db != band->target_gain_db) {
+      const gdouble diff = band->target_gain_db - band->current_gain_db;
+      if (std::abs(diff) <= max_step) {
+        band->current_gain_db = band->target_gain_db;
+      }
+      else {
+        band->current_gain_db += diff > 0.0 ? max_step : -max_step;
+      }
+      gst_strawberryeq_update_coefficients(eq, band);
+    }
+    if (band->active) ++active_bands;
+  }
+
+  return active_bands;
+
+}
+
+static gboolean gst_strawberryeq_setup(GstAudioFilter *base, const GstAudioInfo *info) {
+
+  GstStrawberryEq *eq = GST_STRAWBERRYEQ(base);
+
+  g_mutex_lock(&eq->lock);
+
+  eq->channels = GST_AUDIO_INFO_CHANNELS(info);
+  eq->rate = GST_AUDIO_INFO_RATE(info);
+
+  g_free(eq->state);
+  eq->state = g_new0(gdouble, static_cast<gsize>(GST_STRAWBERRYEQ_MAX_BANDS) * eq->channels * 2);
+
+  // The coefficients depend on the sample rate, so refresh all bands.
+  for (gint i = 0; i < eq->num_bands; ++i) {
+    gst_strawberryeq_update_coefficients(eq, &eq->bands[i]);
+  }
+
+  g_mutex_unlock(&eq->lock);
+
+  return TRUE;
+
+}
+
+static gboolean gst_strawberryeq_stop(GstBaseTransform *trans) {
+
+  GstStrawberryEq *eq = GST_STRAWBERRYEQ(trans);
+
+  g_mutex_lock(&eq->lock);
+  g_free(eq->state);
+  eq->state = nullptr;
+  g_mutex_unlock(&eq->lock);
+
+  return TRUE;
+
+}
+
+static GstFlowReturn gst_strawberryeq_transform_ip(GstBaseTransform *trans, GstBuffer *buffer) {
+
+  GstStrawberryEq *eq = GST_STRAWBERRYEQ(trans);
+
+  if (GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_GAP)) return GST_FLOW_OK;
+
+  const gint channels = eq->channels;
+  const gint rate = eq->rate;
+  if (channels == 0 || rate == 0 || !eq->state) return GST_FLOW_OK;
+
+  GstMapInfo map;
+  if (!gst_buffer_map(buffer, &map, static_cast<GstMapFlags>(GST_MAP_READ | GST_MAP_WRITE))) {
+    return GST_FLOW_ERROR;
+  }
+
+  const guint frames = static_cast<guint>(map.size / (sizeof(gfloat) * channels));
+
+  g_mutex_lock(&eq->lock);
+
+  const gint active_bands = gst_strawberryeq_ramp_gains(eq, static_cast<gdouble>(frames) / rate);
+
+  if (active_bands == 0) {
+    // Every band is flat, which is the common case: leave the audio untouched.
+    g_mutex_unlock(&eq->lock);
+    gst_buffer_unmap(buffer, &map);
+    return GST_FLOW_OK;
+  }
+
+  // Run the cascade one band at a time over the whole block.
+  // The inner loop walks the channels of one interleaved frame, which is contiguous memory,
+  // so the compiler can vectorize it across channels (NEON/SSE lanes with stereo or multichannel audio).
+  for (gint i = 0; i < eq->num_bands; ++i) {
+    const GstStrawberryEqBand &band = eq->bands[i];
+    if (!band.active) continue;
+
+    const gdouble b0 = band.b0;
+    const gdouble b1 = band.b1;
+    const gdouble b2 = band.b2;
+    const gdouble a1 = band.a1;
+    const gdouble a2 = band.a2;
+
+    gdouble *state = eq->state + static_cast<gsize>(i) * channels * 2;
+    gfloat *data = reinterpret_cast<gfloat*>(map.data);
+
+    for (guint frame = 0; frame < frames; ++frame) {
+      for (gint channel = 0; channel < channels; ++channel) {
+        // Transposed direct form II: y = b0*x + z1; z1 = b1*x - a1*y + z2; z2 = b2*x - a2*y
+        gdouble *z = state + channel * 2;
+        const gdouble x = data[channel];
+        const gdouble y = b0 * x + z[0];
+        z[0] = b1 * x - a1 * y + z[1];
+        z[1] = b2 * x - a2 * y;
+        data[channel] = static_cast<gfloat>(y);
+      }
+      data += channels;
+    }
+  }
+
+  g_mutex_unlock(&eq->lock);
+
+  gst_buffer_unmap(buffer, &map);
+
+  return GST_FLOW_OK;
+
+}
+
+void gst_strawberryeq_set_num_bands(GstStrawberryEq *eq, const gint num_bands) {
+
+  g_return_if_fail(GST_IS_STRAWBERRYEQ(eq));
+  g_return_if_fail(num_bands >= 0 && num_bands <= GST_STRAWBERRYEQ_MAX_BANDS);
+
+  g_mutex_lock(&eq->lock);
+  eq->num_bands = num_bands;
+  if (eq->state) memset(eq->state, 0, static_cast<gsize>(GST_STRAWBERRYEQ_MAX_BANDS) * eq->channels * 2 * sizeof(gdouble));
+  g_mutex_unlock(&eq->lock);
+
+}
+
+void gst_strawberryeq_set_band(GstStrawberryEq *eq, const gint band, const gdouble frequency, const gdouble bandwidth, const gdouble gain_db) {
+
+  g_return_if_fail(GST_IS_STRAWBERRYEQ(eq));
+  g_return_if_fail(band >= 0 && band < eq->num_bands);
+
+  g_mutex_lock(&eq->lock);
+  eq->bands[band].frequency = frequency;
+  eq->bands[band].bandwidth = bandwidth;
+  eq->bands[band].target_gain_db = gain_db;
+  if (eq->rate > 0) gst_strawberryeq_update_coefficients(eq, &eq->bands[band]);
+  g_mutex_unlock(&eq->lock);
+
+}
+
+void gst_strawberryeq_set_band_gain(GstStrawberryEq *eq, const gint band, const gdouble gain_db) {
+
+  g_return_if_fail(GST_IS_STRAWBERRYEQ(eq));
+  g_return_if_fail(band >= 0 && band < eq->num_bands);
+
+  g_mutex_lock(&eq->lock);
+  // Only the target changes here, the streaming thread ramps the applied gain towards it so the change is click-free.
+  eq->bands[band].target_gain_db = gain_db;
+  if (std::abs(gain_db) >= kFlatGainThresholdDb && !eq->bands[band].active && eq->rate > 0) {
+    // Reactivate a skipped band, starting the ramp from flat.
+    gst_strawberryeq_update_coefficients(eq, &eq->bands[band]);
+  }
+  g_mutex_unlock(&eq->lock);
+
+}
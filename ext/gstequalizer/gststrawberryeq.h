@@ -0,0 +1,92 @@
+/* Strawberry Music Player
+   Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+
+   Strawberry is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Strawberry is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A replacement for GStreamer's equalizer-nbands:
+//   - A cascade of peaking biquads in 32 bit float, processing channel-interleaved blocks
+//     with the channel loop innermost so the compiler can vectorize across channels.
+//   - Bands sitting at 0 dB are skipped entirely, and the whole element is a no-op
+//     while every band is flat, which is the common case.
+//   - Gain changes are ramped towards their target per block and the coefficients
+//     recomputed from the ramped gain, so moving a slider doesn't click.
+
+#ifndef GST_EQUALIZER_STRAWBERRYEQ_H
+#define GST_EQUALIZER_STRAWBERRYEQ_H
+
+#include <gst/gst.h>
+#include <gst/audio/gstaudiofilter.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_STRAWBERRYEQ            (gst_strawberryeq_get_type())
+#define GST_STRAWBERRYEQ(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_STRAWBERRYEQ, GstStrawberryEq))
+#define GST_IS_STRAWBERRYEQ(obj)         (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_STRAWBERRYEQ))
+#define GST_STRAWBERRYEQ_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_STRAWBERRYEQ, GstStrawberryEqClass))
+#define GST_IS_STRAWBERRYEQ_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_STRAWBERRYEQ))
+
+#define GST_STRAWBERRYEQ_MAX_BANDS 16
+
+struct GstStrawberryEqBand {
+  // Filter parameters, set from the application thread under the element lock.
+  gdouble frequency;
+  gdouble bandwidth;
+  gdouble target_gain_db;
+
+  // Gain the coefficients are currently computed from, ramped towards the target per block.
+  gdouble current_gain_db;
+
+  // Biquad coefficients (transposed direct form II, normalized by a0).
+  gdouble b0, b1, b2, a1, a2;
+
+  // False while the band sits at 0 dB, the band is then skipped.
+  gboolean active;
+};
+
+struct GstStrawberryEq {
+  GstAudioFilter parent;
+
+  // Protects the band parameters against the streaming thread.
+  GMutex lock;
+
+  gint num_bands;
+  GstStrawberryEqBand bands[GST_STRAWBERRYEQ_MAX_BANDS];
+
+  // Per band and channel filter state (2 doubles each), allocated in setup().
+  gdouble *state;
+
+  gint channels;
+  gint rate;
+};
+
+struct GstStrawberryEqClass {
+  GstAudioFilterClass parent_class;
+};
+
+GType gst_strawberryeq_get_type(void);
+
+// Sets the number of bands. Frees any state, so only call while the pipeline is not playing.
+void gst_strawberryeq_set_num_bands(GstStrawberryEq *eq, const gint num_bands);
+
+// Places a band at the given center frequency with the given bandwidth (both in Hz) and gain (dB).
+// The gain takes effect with a short ramp, so this is safe to call while playing.
+void gst_strawberryeq_set_band(GstStrawberryEq *eq, const gint band, const gdouble frequency, const gdouble bandwidth, const gdouble gain_db);
+
+// Changes only the gain (dB) of a band, with a short ramp. Safe to call while playing.
+void gst_strawberryeq_set_band_gain(GstStrawberryEq *eq, const gint band, const gdouble gain_db);
+
+G_END_DECLS
+
+#endif  // GST_EQUALIZER_STRAWBERRYEQ_H
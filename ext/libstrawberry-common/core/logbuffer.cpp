@@ -0,0 +1,75 @@
+/* This file is part of Strawberry.
+   Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <QMutexLocker>
+
+#include "logbuffer.h"
+
+namespace logging {
+
+namespace {
+// How many lines to keep. At a typical 150 bytes per line this bounds the buffer to roughly 15 MB during day-long operations.
+constexpr qsizetype kLogBufferCapacity = 100000;
+}  // namespace
+
+LogBuffer *LogBuffer::Instance() {
+
+  static LogBuffer buffer;
+  return &buffer;
+
+}
+
+void LogBuffer::Append(const int level, const QString &category, const QString &text) {
+
+  if (!enabled_) return;
+
+  QMutexLocker locker(&mutex_);
+
+  Line line;
+  line.sequence = next_sequence_++;
+  line.level = level;
+  line.category = category;
+  line.text = text;
+  lines_.append(line);
+
+  if (lines_.count() > kLogBufferCapacity) {
+    lines_.removeFirst();
+  }
+
+}
+
+QList<LogBuffer::Line> LogBuffer::LinesSince(const quint64 sequence) const {
+
+  QMutexLocker locker(&mutex_);
+
+  if (lines_.isEmpty() || sequence >= next_sequence_) return QList<Line>();
+
+  // Sequence numbers are contiguous, so the first line to return can be found by offset.
+  const quint64 first_sequence = lines_.first().sequence;
+  const qsizetype start = sequence > first_sequence ? static_cast<qsizetype>(sequence - first_sequence) : 0;
+
+  return lines_.mid(start);
+
+}
+
+void LogBuffer::Clear() {
+
+  QMutexLocker locker(&mutex_);
+  lines_.clear();
+
+}
+
+}  // namespace logging
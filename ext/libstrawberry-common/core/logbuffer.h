@@ -0,0 +1,67 @@
+/* This file is part of Strawberry.
+   Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef LOGBUFFER_H
+#define LOGBUFFER_H
+
+#include <atomic>
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QList>
+#include <QString>
+
+namespace logging {
+
+// A bounded, thread-safe ring buffer of formatted log lines.
+// It is disabled by default so the worker processes that share this library don't pay for it;
+// the player enables it at startup and the Console dialog reads from it incrementally by sequence number.
+class LogBuffer {
+ public:
+  struct Line {
+    quint64 sequence = 0;
+    int level = 0;  // A logging::Level
+    QString category;
+    QString text;
+  };
+
+  static LogBuffer *Instance();
+
+  void SetEnabled(const bool enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+
+  void Append(const int level, const QString &category, const QString &text);
+
+  // Returns the buffered lines whose sequence number is `sequence` or higher.
+  // Lines that have already been dropped from the ring are silently skipped, so callers can poll with the last sequence number they saw plus one.
+  QList<Line> LinesSince(const quint64 sequence) const;
+
+  void Clear();
+
+ private:
+  LogBuffer() : enabled_(false), next_sequence_(0) {}
+  Q_DISABLE_COPY(LogBuffer)
+
+  std::atomic<bool> enabled_;
+
+  mutable QMutex mutex_;
+  quint64 next_sequence_;
+  QList<Line> lines_;
+};
+
+}  // namespace logging
+
+#endif  // LOGBUFFER_H
@@ -19,6 +19,7 @@
 
 #include "config.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -57,12 +58,15 @@
 #include <QMessageLogContext>
 #include <QDebug>
 
+#include "logbuffer.h"
 #include "logging.h"
 
 namespace logging {
 
-static Level sDefaultLevel = Level_Debug;
+static std::atomic<int> sDefaultLevel{Level_Debug};
 static QMap<QString, Level> *sClassLevels = nullptr;
+// Whether any per-class levels are configured. While this is false the qLog gate is a single atomic compare.
+static std::atomic<bool> sHasClassLevels{false};
 static QIODevice *sNullDevice = nullptr;
 
 const char *kDefaultLogLevels = "*:3";
@@ -133,11 +137,49 @@ class LoggedDebug : public DebugBase<LoggedDebug> {
   explicit LoggedDebug(QtMsgType t) : DebugBase(t) { nospace() << kMessageHandlerMagic; }
 };
 
+// Every line that reaches the terminal was formatted by CreateLogger as "hh:mm:ss.zzz LEVEL  category...",
+// so the level and category for the log buffer can be recovered from fixed positions instead of threading them through QDebug.
+static void AppendLineToLogBuffer(const QString &line) {
+
+  if (!LogBuffer::Instance()->enabled()) return;
+
+  Level level = Level_Debug;
+  const QString level_name = line.mid(12, 7).trimmed();
+  if (level_name == QLatin1String("FATAL") || level_name == QLatin1String("ERROR")) {
+    level = Level_Error;
+  }
+  else if (level_name == QLatin1String("WARN")) {
+    level = Level_Warning;
+  }
+  else if (level_name == QLatin1String("INFO")) {
+    level = Level_Info;
+  }
+
+  // The category field is "Class:line" or "Class:line(category)", left justified but not truncated, so cut at the first space.
+  QString category = line.mid(19);
+  const qint64 space = category.indexOf(QLatin1Char(' '));
+  if (space != -1) category = category.left(space);
+  const qint64 paren = category.indexOf(QLatin1Char('('));
+  if (paren != -1) {
+    category = category.mid(paren + 1);
+    if (category.endsWith(QLatin1Char(')'))) category.chop(1);
+  }
+  else {
+    const qint64 colon = category.indexOf(QLatin1Char(':'));
+    if (colon != -1) category = category.left(colon);
+  }
+
+  LogBuffer::Instance()->Append(level, category, line);
+
+}
+
 static void MessageHandler(QtMsgType type, const QMessageLogContext&, const QString &message) {
 
   if (message.startsWith(QLatin1String(kMessageHandlerMagic))) {
-    QByteArray message_data = message.toUtf8();
-    fprintf(type == QtCriticalMsg || type == QtFatalMsg ? stderr : stdout, "%s\n", message_data.constData() + kMessageHandlerMagicLen);
+    const QString line = message.mid(static_cast<qint64>(kMessageHandlerMagicLen));
+    AppendLineToLogBuffer(line);
+    const QByteArray message_data = line.toUtf8();
+    fprintf(type == QtCriticalMsg || type == QtFatalMsg ? stderr : stdout, "%s\n", message_data.constData());
     fflush(type == QtCriticalMsg || type == QtFatalMsg ? stderr : stdout);
     return;
   }
@@ -162,6 +204,7 @@ static void MessageHandler(QtMsgType type, const QMessageLogContext&, const QStr
     d << line.toLocal8Bit().constData();
     if (d.buf_) {
       d.buf_->close();
+      AppendLineToLogBuffer(QString::fromLocal8Bit(d.buf_->buffer()));
       fprintf(type == QtCriticalMsg || type == QtFatalMsg ? stderr : stdout, "%s\n", d.buf_->buffer().data());
       fflush(type == QtCriticalMsg || type == QtFatalMsg ? stderr : stdout);
     }
@@ -213,10 +256,11 @@ void SetLevels(const QString &levels) {
     }
 
     if (class_name.isEmpty() || class_name == QLatin1Char('*')) {
-      sDefaultLevel = static_cast<Level>(level);
+      sDefaultLevel.store(level);
     }
     else {
       sClassLevels->insert(class_name, static_cast<Level>(level));
+      sHasClassLevels.store(true);
     }
   }
 
@@ -246,6 +290,25 @@ static QString ParsePrettyFunction(const char *pretty_function) {
 
 }
 
+bool IsLevelEnabled(const int level, const char *pretty_function, const char *category) {
+
+  // Fatal is never filtered, it has to reach the handler that aborts.
+  if (level <= Level_Error) return true;
+
+  if (!sHasClassLevels.load(std::memory_order_relaxed)) {
+    return level <= sDefaultLevel.load(std::memory_order_relaxed);
+  }
+
+  const QString filter_category = (category != nullptr) ? QLatin1String(category) : ParsePrettyFunction(pretty_function);
+  int threshold_level = sDefaultLevel.load(std::memory_order_relaxed);
+  if (sClassLevels && sClassLevels->contains(filter_category)) {
+    threshold_level = sClassLevels->value(filter_category);
+  }
+
+  return level <= threshold_level;
+
+}
+
 template <class T>
 static T CreateLogger(Level level, const QString &class_name, int line, const char *category) {
 
@@ -261,7 +324,8 @@ static T CreateLogger(Level level, const QString &class_name, int line, const ch
 
   QString filter_category = (category != nullptr) ? QLatin1String(category) : class_name;
   // Check the settings to see if we're meant to show or hide this message.
-  Level threshold_level = sDefaultLevel;
+  // The qLog macros already checked IsLevelEnabled, this re-check covers callers that construct loggers directly.
+  int threshold_level = sDefaultLevel.load(std::memory_order_relaxed);
   if (sClassLevels && sClassLevels->contains(filter_category)) {
     threshold_level = sClassLevels->value(filter_category);
   }
@@ -29,19 +29,32 @@
 #  define qLog(level) while (false) QNoDebug()
 #  define qLogCat(level, category) while (false) QNoDebug()
 #else
+
+// The for loop gates the whole statement on IsLevelEnabled, so when a message is filtered out
+// neither the logger nor the streamed arguments are constructed or formatted - qLog(Debug) in a
+// per-file loop costs one atomic load when debug logging is off.
+// A for statement is used instead of an if so the macro cannot steal an else from surrounding code.
 #  ifdef _MSC_VER
-#    define qLog(level) logging::CreateLogger##level(__LINE__, __FUNCSIG__, nullptr)
+#    define qLog(level) \
+       for (bool qlog_enabled = logging::IsLevelEnabled(logging::Level_##level, __FUNCSIG__, nullptr); qlog_enabled; qlog_enabled = false) \
+         logging::CreateLogger##level(__LINE__, __FUNCSIG__, nullptr)
 #  else
-#    define qLog(level) logging::CreateLogger##level(__LINE__, __PRETTY_FUNCTION__, nullptr)
+#    define qLog(level) \
+       for (bool qlog_enabled = logging::IsLevelEnabled(logging::Level_##level, __PRETTY_FUNCTION__, nullptr); qlog_enabled; qlog_enabled = false) \
+         logging::CreateLogger##level(__LINE__, __PRETTY_FUNCTION__, nullptr)
 #  endif  // _MSC_VER
 
 // This macro specifies a separate category for message filtering.
 // The default qLog will use the class name extracted from the function name for this purpose.
 // The category is also printed in the message along with the class name.
 #  ifdef _MSC_VER
-#    define qLogCat(level, category) logging::CreateLogger##level(__LINE__, __FUNCSIG__, category)
+#    define qLogCat(level, category) \
+       for (bool qlog_enabled = logging::IsLevelEnabled(logging::Level_##level, __FUNCSIG__, category); qlog_enabled; qlog_enabled = false) \
+         logging::CreateLogger##level(__LINE__, __FUNCSIG__, category)
 #  else
-#    define qLogCat(level, category) logging::CreateLogger##level(__LINE__, __PRETTY_FUNCTION__, category)
+#    define qLogCat(level, category) \
+       for (bool qlog_enabled = logging::IsLevelEnabled(logging::Level_##level, __PRETTY_FUNCTION__, category); qlog_enabled; qlog_enabled = false) \
+         logging::CreateLogger##level(__LINE__, __PRETTY_FUNCTION__, category)
 #  endif  // _MSC_VER
 
 #endif  // QT_NO_DEBUG_STREAM
@@ -70,6 +83,10 @@ enum Level {
   void Init();
   void SetLevels(const QString &levels);
 
+  // Whether a message at this level in this context would be shown at all, used by the qLog macros to skip argument formatting for filtered messages.
+  // A single atomic load and compare when no per-class levels are configured; the class name is only parsed out of the function signature when they are.
+  bool IsLevelEnabled(const int level, const char *pretty_function, const char *category);
+
   void DumpStackTrace();
 
 QDebug CreateLoggerInfo(int line, const char *pretty_function, const char *category);
@@ -35,11 +35,14 @@
 #include <QDir>
 #include <QFile>
 #include <QList>
+#include <QPair>
 #include <QQueue>
 #include <QString>
 #include <QStringList>
 #include <QAtomicInt>
 #include <QRandomGenerator>
+#include <QDateTime>
+#include <QTimer>
 
 #include "core/logging.h"
 
@@ -63,6 +66,8 @@ class _WorkerPoolBase : public QObject {
   virtual void ProcessReadyReadStandardError() {}
   virtual void ProcessError(QProcess::ProcessError) {}
   virtual void SendQueuedMessages() {}
+  virtual void ReapIdleWorkers() {}
+  virtual void LogWorkerStats() {}
 };
 
 
@@ -86,6 +91,14 @@ class WorkerPool : public _WorkerPoolBase {
   // Sets the number of worker process to use.  Defaults to 1 <= (processors / 2) <= 2.
   void SetWorkerCount(const int count);
 
+  int worker_count() const { return worker_count_; }
+
+  // Sets the maximum number of worker processes the pool may grow to under queue pressure.
+  // The extra workers are dedicated to batch traffic, so interactive requests never queue behind a bulk operation,
+  // and they are reaped again once they have been idle for a while.
+  // Defaults to the worker count, i.e. no autoscaling.
+  void SetMaxWorkerCount(const int count);
+
   // Sets the prefix to use for the local server (on unix this is a named pipe in /tmp).
   // Defaults to QApplication::applicationName().
   // A random number is appended to this name when creating each server.
@@ -96,8 +109,13 @@ class WorkerPool : public _WorkerPoolBase {
 
   // Fills in the message's "id" field and creates a reply future.
   // The message is queued and the WorkerPool's thread will send it to the next available worker.
+  // Messages sent with batch set go to the dedicated batch workers when the pool has headroom for them.
+  // Can be called from any thread.
+  ReplyType *SendMessageWithReply(MessageType *message, const bool batch = false);
+
+  // Returns a snapshot of per-worker queue depths, queued messages and request statistics as one line per item.
   // Can be called from any thread.
-  ReplyType *SendMessageWithReply(MessageType *message);
+  QString DiagnosticsReport();
 
  protected:
   // These are all reimplemented slots, they are called on the WorkerPool's thread.
@@ -107,15 +125,21 @@ class WorkerPool : public _WorkerPoolBase {
   void ProcessReadyReadStandardError() override;
   void ProcessError(QProcess::ProcessError error) override;
   void SendQueuedMessages() override;
+  void ReapIdleWorkers() override;
+  void LogWorkerStats() override;
 
  private:
   struct Worker {
-    Worker() : local_server_(nullptr), local_socket_(nullptr), process_(nullptr), handler_(nullptr) {}
+    Worker() : local_server_(nullptr), local_socket_(nullptr), process_(nullptr), handler_(nullptr), batch_(false), idle_since_ms_(0) {}
 
     QLocalServer *local_server_;
     QLocalSocket *local_socket_;
     QProcess *process_;
     HandlerType *handler_;
+    // Whether this is a dedicated batch worker that was spawned under queue pressure and can be reaped when idle.
+    bool batch_;
+    // When the worker was last seen without pending requests, 0 while it's busy.
+    qint64 idle_since_ms_;
   };
 
   // Must only ever be called on my thread.
@@ -143,22 +167,53 @@ class WorkerPool : public _WorkerPoolBase {
   // and sets the request's ID to the ID of the reply.  Can be called from any thread
   ReplyType *NewReply(MessageType *message);
 
-  // Returns the next handler, or nullptr if there isn't one.  Must be called from my thread.
+  // Returns the next regular handler, or nullptr if there isn't one.  Must be called from my thread.
   HandlerType *NextHandler() const;
 
+  // Returns the least busy batch handler, spawning a new batch worker first when they are all busy and the pool can still grow.
+  // Falls back to the regular handlers when the pool has no headroom for batch workers.  Must be called from my thread.
+  HandlerType *NextBatchHandler();
+
+  // Shuts down one worker and removes it from the pool.  Must be called from my thread.
+  void StopOneWorker(const int index);
+
+  // Updates the request statistics when a reply finishes.  Must be called from my thread.
+  void RecordReplyFinished(ReplyType *reply, const qint64 elapsed_ms);
+
  private:
+  // How often idle batch workers are looked for, and how long one must have been idle to be reaped.
+  static constexpr int kReapIntervalMs = 10 * 1000;
+  static constexpr int kWorkerIdleTimeoutMs = 60 * 1000;
+
+  // How often the request statistics are logged, when there was traffic since the last time.
+  static constexpr int kStatsLogIntervalMs = 60 * 1000;
+  // Upper bounds of the latency histogram buckets; the last bucket takes everything above the last bound.
+  static constexpr int kLatencyBucketCount = 8;
+  static constexpr qint64 kLatencyBucketBoundsMs[kLatencyBucketCount - 1] = {1, 5, 10, 50, 100, 500, 1000};
+
   QString local_server_name_;
   QString executable_name_;
   QString executable_path_;
 
   int worker_count_;
+  int max_worker_count_;
   mutable int next_worker_;
   QList<Worker> workers_;
+  QTimer *reap_timer_;
+  QTimer *stats_log_timer_;
+
+  // Request statistics, only touched on my thread.
+  quint64 stats_completed_;
+  quint64 stats_failed_;
+  quint64 stats_reply_bytes_;
+  quint64 stats_latency_total_ms_;
+  quint64 stats_latency_buckets_[kLatencyBucketCount];
+  quint64 stats_completed_at_last_log_;
 
   QAtomicInt next_id_;
 
   QMutex message_queue_mutex_;
-  QQueue<ReplyType *> message_queue_;
+  QQueue<QPair<ReplyType*, bool>> message_queue_;
 };
 
 
@@ -166,7 +221,16 @@ template<typename HandlerType>
 WorkerPool<HandlerType>::WorkerPool(QObject *parent)
     : _WorkerPoolBase(parent),
       worker_count_(1),
+      max_worker_count_(0),
       next_worker_(0),
+      reap_timer_(new QTimer(this)),
+      stats_log_timer_(new QTimer(this)),
+      stats_completed_(0),
+      stats_failed_(0),
+      stats_reply_bytes_(0),
+      stats_latency_total_ms_(0),
+      stats_latency_buckets_{},
+      stats_completed_at_last_log_(0),
       next_id_(0) {
 
   local_server_name_ = qApp->applicationName().toLower();
@@ -175,6 +239,12 @@ WorkerPool<HandlerType>::WorkerPool(QObject *parent)
     local_server_name_ = QStringLiteral("workerpool");
   }
 
+  reap_timer_->setInterval(kReapIntervalMs);
+  QObject::connect(reap_timer_, &QTimer::timeout, this, &WorkerPool::ReapIdleWorkers);
+
+  stats_log_timer_->setInterval(kStatsLogIntervalMs);
+  QObject::connect(stats_log_timer_, &QTimer::timeout, this, &WorkerPool::LogWorkerStats);
+
 }
 
 template<typename HandlerType>
@@ -202,8 +272,8 @@ WorkerPool<HandlerType>::~WorkerPool() {
     }
   }
 
-  for (ReplyType *reply : message_queue_) {
-    reply->Abort();
+  for (const QPair<ReplyType*, bool> &queued : message_queue_) {
+    queued.first->Abort();
   }
 
 }
@@ -214,6 +284,12 @@ void WorkerPool<HandlerType>::SetWorkerCount(const int count) {
   worker_count_ = count;
 }
 
+template<typename HandlerType>
+void WorkerPool<HandlerType>::SetMaxWorkerCount(const int count) {
+  Q_ASSERT(workers_.isEmpty());
+  max_worker_count_ = count;
+}
+
 template<typename HandlerType>
 void WorkerPool<HandlerType>::SetLocalServerName(const QString &local_server_name) {
   Q_ASSERT(workers_.isEmpty());
@@ -272,6 +348,12 @@ void WorkerPool<HandlerType>::DoStart() {
     workers_ << worker;
   }
 
+  if (max_worker_count_ > worker_count_) {
+    reap_timer_->start();
+  }
+
+  stats_log_timer_->start();
+
 }
 
 template<typename HandlerType>
@@ -408,14 +490,14 @@ WorkerPool<HandlerType>::NewReply(MessageType *message) {
 
 template <typename HandlerType>
 typename WorkerPool<HandlerType>::ReplyType*
-WorkerPool<HandlerType>::SendMessageWithReply(MessageType *message) {
+WorkerPool<HandlerType>::SendMessageWithReply(MessageType *message, const bool batch) {
 
   ReplyType *reply = NewReply(message);
 
   // Add the pending reply to the queue
   {
     QMutexLocker l(&message_queue_mutex_);
-    message_queue_.enqueue(reply);
+    message_queue_.enqueue(qMakePair(reply, batch));
   }
 
   // Wake up the main thread
@@ -430,18 +512,24 @@ void WorkerPool<HandlerType>::SendQueuedMessages() {
 
   QMutexLocker l(&message_queue_mutex_);
 
-  while (!message_queue_.isEmpty()) {
-    ReplyType *reply = message_queue_.dequeue();
+  // Batch and regular messages go to different workers, so a message that can't be dispatched yet must not block the ones behind it.
+  qsizetype i = 0;
+  while (i < message_queue_.count()) {
+    ReplyType *reply = message_queue_[i].first;
+    const bool batch = message_queue_[i].second;
 
     // Find a worker for this message
-    HandlerType *handler = NextHandler();
+    HandlerType *handler = batch ? NextBatchHandler() : NextHandler();
     if (!handler) {
-      // No available handlers - put the message on the front of the queue.
-      message_queue_.prepend(reply);
+      // No available handler - leave the message in the queue.
       qLog(Debug) << "No available handlers to process request";
-      break;
+      ++i;
+      continue;
     }
 
+    message_queue_.removeAt(i);
+    const qint64 sent_ms = QDateTime::currentMSecsSinceEpoch();
+    QObject::connect(reply, &ReplyType::Finished, this, [this, reply, sent_ms]() { RecordReplyFinished(reply, QDateTime::currentMSecsSinceEpoch() - sent_ms); });
     handler->SendRequest(reply);
   }
 
@@ -453,7 +541,7 @@ HandlerType *WorkerPool<HandlerType>::NextHandler() const {
   for (int i = 0; i < workers_.count(); ++i) {
     const int worker_index = (next_worker_ + i) % workers_.count();
 
-    if (workers_[worker_index].handler_ && !workers_[worker_index].handler_->is_device_closed()) {
+    if (!workers_[worker_index].batch_ && workers_[worker_index].handler_ && !workers_[worker_index].handler_->is_device_closed()) {
       next_worker_ = (worker_index + 1) % workers_.count();
       return workers_[worker_index].handler_;
     }
@@ -463,4 +551,171 @@ HandlerType *WorkerPool<HandlerType>::NextHandler() const {
 
 }
 
+template<typename HandlerType>
+HandlerType *WorkerPool<HandlerType>::NextBatchHandler() {
+
+  // Without headroom for extra workers, batch traffic shares the regular workers.
+  if (max_worker_count_ <= worker_count_) return NextHandler();
+
+  HandlerType *least_busy = nullptr;
+  int least_pending = 0;
+  int batch_worker_count = 0;
+  for (const Worker &worker : std::as_const(workers_)) {
+    if (!worker.batch_) continue;
+    // Count workers that are still starting up too, so pending messages don't spawn more than one worker each.
+    ++batch_worker_count;
+    if (!worker.handler_ || worker.handler_->is_device_closed()) continue;
+    const int pending = worker.handler_->pending_reply_count();
+    if (!least_busy || pending < least_pending) {
+      least_busy = worker.handler_;
+      least_pending = pending;
+    }
+  }
+
+  // Grow under queue pressure: all batch workers have requests in flight (or none exist yet) and there's still room.
+  if ((!least_busy || least_pending > 0) && worker_count_ + batch_worker_count < max_worker_count_) {
+    Worker worker;
+    worker.batch_ = true;
+    StartOneWorker(&worker);
+    workers_ << worker;
+    // When there's no connected batch worker yet the message stays queued until this one connects.
+  }
+
+  return least_busy;
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::StopOneWorker(const int index) {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  Worker &worker = workers_[index];
+
+  if (worker.process_) {
+    QObject::disconnect(worker.process_, &QProcess::errorOccurred, this, &WorkerPool::ProcessError);
+    QObject::disconnect(worker.process_, &QProcess::readyReadStandardOutput, this, &WorkerPool::ProcessReadyReadStandardOutput);
+    QObject::disconnect(worker.process_, &QProcess::readyReadStandardError, this, &WorkerPool::ProcessReadyReadStandardError);
+  }
+
+  if (worker.local_socket_) {
+    // The worker exits by itself when its socket is closed.
+    worker.local_socket_->close();
+    if (worker.process_) worker.process_->waitForFinished(500);
+  }
+
+  if (worker.process_ && worker.process_->state() == QProcess::Running) {
+    worker.process_->terminate();
+    if (!worker.process_->waitForFinished(500)) {
+      worker.process_->kill();
+    }
+  }
+
+  DeleteQObjectPointerLater(&worker.handler_);
+  DeleteQObjectPointerLater(&worker.local_socket_);
+  DeleteQObjectPointerLater(&worker.local_server_);
+  DeleteQObjectPointerLater(&worker.process_);
+
+  workers_.removeAt(index);
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::RecordReplyFinished(ReplyType *reply, const qint64 elapsed_ms) {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  ++stats_completed_;
+  if (!reply->is_successful()) ++stats_failed_;
+  stats_reply_bytes_ += reply->message().ByteSizeLong();
+  stats_latency_total_ms_ += static_cast<quint64>(elapsed_ms);
+
+  int bucket = 0;
+  while (bucket < kLatencyBucketCount - 1 && elapsed_ms >= kLatencyBucketBoundsMs[bucket]) ++bucket;
+  ++stats_latency_buckets_[bucket];
+
+}
+
+template<typename HandlerType>
+QString WorkerPool<HandlerType>::DiagnosticsReport() {
+
+  // The workers and statistics are only touched on my thread, so gather the snapshot there.
+  if (QThread::currentThread() != thread()) {
+    QString report;
+    QMetaObject::invokeMethod(this, [this, &report]() { report = DiagnosticsReport(); }, Qt::BlockingQueuedConnection);
+    return report;
+  }
+
+  QString report;
+  for (int i = 0; i < workers_.count(); ++i) {
+    const Worker &worker = workers_[i];
+    QString pending = QStringLiteral("not connected");
+    if (worker.handler_ && !worker.handler_->is_device_closed()) {
+      pending = QStringLiteral("%1 pending").arg(worker.handler_->pending_reply_count());
+    }
+    report += QStringLiteral("worker %1%2: %3\n").arg(i).arg(worker.batch_ ? QStringLiteral(" (batch)") : QString(), pending);
+  }
+  {
+    QMutexLocker l(&message_queue_mutex_);
+    report += QStringLiteral("undispatched messages: %1\n").arg(message_queue_.count());
+  }
+  report += QStringLiteral("requests finished: %1, failed: %2, reply bytes: %3\n").arg(stats_completed_).arg(stats_failed_).arg(stats_reply_bytes_);
+  if (stats_completed_ > 0) {
+    report += QStringLiteral("average latency: %1 ms\n").arg(stats_latency_total_ms_ / stats_completed_);
+  }
+  report += QStringLiteral("latency histogram:");
+  for (int bucket = 0; bucket < kLatencyBucketCount; ++bucket) {
+    if (bucket < kLatencyBucketCount - 1) {
+      report += QStringLiteral(" <%1ms: %2").arg(kLatencyBucketBoundsMs[bucket]).arg(stats_latency_buckets_[bucket]);
+    }
+    else {
+      report += QStringLiteral(" >=%1ms: %2").arg(kLatencyBucketBoundsMs[kLatencyBucketCount - 2]).arg(stats_latency_buckets_[bucket]);
+    }
+  }
+
+  return report;
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::LogWorkerStats() {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  // Only log when there was traffic since the last time.
+  if (stats_completed_ == stats_completed_at_last_log_) return;
+  stats_completed_at_last_log_ = stats_completed_;
+
+  qLog(Debug) << "Worker pool statistics for" << executable_name_;
+  const QStringList lines = DiagnosticsReport().split(QLatin1Char('\n'));
+  for (const QString &line : lines) {
+    qLog(Debug) << line;
+  }
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::ReapIdleWorkers() {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+  for (int i = static_cast<int>(workers_.count()) - 1; i >= 0; --i) {
+    Worker &worker = workers_[i];
+    if (!worker.batch_ || !worker.handler_) continue;
+    if (worker.handler_->pending_reply_count() > 0) {
+      worker.idle_since_ms_ = 0;
+    }
+    else if (worker.idle_since_ms_ == 0) {
+      worker.idle_since_ms_ = now;
+    }
+    else if (now - worker.idle_since_ms_ >= kWorkerIdleTimeoutMs) {
+      qLog(Debug) << "Reaping idle batch worker" << &worker;
+      StopOneWorker(i);
+    }
+  }
+
+}
+
 #endif  // WORKERPOOL_H
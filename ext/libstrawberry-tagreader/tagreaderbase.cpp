@@ -27,6 +27,7 @@
 #include <QBuffer>
 #include <QImage>
 #include <QMimeDatabase>
+#include <QSharedMemory>
 
 #include "core/logging.h"
 #include "tagreaderbase.h"
@@ -82,6 +83,24 @@ int TagReaderBase::ConvertToPOPMRating(const float rating) {
 
 }
 
+// Copies out cover data that the sender passed in a shared memory segment instead of inline in the message.
+// The blob is copied out of the segment once, but no longer gets protobuf-serialized, copied through the socket and deserialized.
+QByteArray TagReaderBase::LoadCoverDataFromSharedMemory(const spb::tagreader::SharedMemoryBlock &shmem) {
+
+  QSharedMemory shared_memory(QString::fromStdString(shmem.key()));
+  if (!shared_memory.attach(QSharedMemory::ReadOnly)) {
+    qLog(Error) << "Could not attach to shared memory segment" << QString::fromStdString(shmem.key()) << shared_memory.errorString();
+    return QByteArray();
+  }
+
+  const qint64 size = qMin(static_cast<qint64>(shmem.size()), static_cast<qint64>(shared_memory.size()));
+  const QByteArray data(static_cast<const char*>(shared_memory.constData()), size);
+  shared_memory.detach();
+
+  return data;
+
+}
+
 TagReaderBase::Cover TagReaderBase::LoadCoverFromRequest(const QString &song_filename, const spb::tagreader::WriteFileRequest &request) {
 
   if (!request.has_save_cover() || !request.save_cover()) {
@@ -93,7 +112,10 @@ TagReaderBase::Cover TagReaderBase::LoadCoverFromRequest(const QString &song_fil
     cover_filename = QString::fromStdString(request.cover_filename());
   }
   QByteArray cover_data;
-  if (request.has_cover_data()) {
+  if (request.has_cover_shmem()) {
+    cover_data = LoadCoverDataFromSharedMemory(request.cover_shmem());
+  }
+  else if (request.has_cover_data()) {
     cover_data = QByteArray(request.cover_data().data(), static_cast<qint64>(request.cover_data().size()));
   }
   QString cover_mime_type;
@@ -112,7 +134,10 @@ TagReaderBase::Cover TagReaderBase::LoadCoverFromRequest(const QString &song_fil
     cover_filename = QString::fromStdString(request.cover_filename());
   }
   QByteArray cover_data;
-  if (request.has_cover_data()) {
+  if (request.has_cover_shmem()) {
+    cover_data = LoadCoverDataFromSharedMemory(request.cover_shmem());
+  }
+  else if (request.has_cover_data()) {
     cover_data = QByteArray(request.cover_data().data(), static_cast<qint64>(request.cover_data().size()));
   }
   QString cover_mime_type;
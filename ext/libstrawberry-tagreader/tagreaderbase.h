@@ -83,6 +83,7 @@ class TagReaderBase {
   static Cover LoadCoverFromRequest(const QString &song_filename, const spb::tagreader::SaveEmbeddedArtRequest &request);
 
  private:
+  static QByteArray LoadCoverDataFromSharedMemory(const spb::tagreader::SharedMemoryBlock &shmem);
   static Cover LoadCoverFromRequest(const QString &song_filename, const QString &cover_filename, QByteArray cover_data, QString cover_mime_type);
 
   Q_DISABLE_COPY(TagReaderBase)
@@ -228,13 +228,19 @@ constexpr char kASF_MusicBrainz_DiscId[] = "MusicBrainz/Disc Id";
 constexpr char kASF_MusicBrainz_ReleaseGroupId[] = "MusicBrainz/Release Group Id";
 constexpr char kASF_MusicBrainz_WorkId[] = "MusicBrainz/Work Id";
 
+// Files at least this big get a bounded read:
+// audio properties are read with TagLib's fast style, which trusts the headers instead of scanning the audio data,
+// so only the tag regions at the head and tail of the file are touched.
+// Without this, reading the tags of multi-GB DSD and live-concert FLAC files causes an I/O storm on spinning disks.
+constexpr qint64 kPartialParseFileSize = 512LL * 1024 * 1024;
+
 }  // namespace
 
 class FileRefFactory {
  public:
   FileRefFactory() = default;
   virtual ~FileRefFactory() = default;
-  virtual TagLib::FileRef *GetFileRef(const QString &filename) = 0;
+  virtual TagLib::FileRef *GetFileRef(const QString &filename, const TagLib::AudioProperties::ReadStyle audio_properties_style = TagLib::AudioProperties::Average) = 0;
 
  private:
   Q_DISABLE_COPY(FileRefFactory)
@@ -243,11 +249,11 @@ class FileRefFactory {
 class TagLibFileRefFactory : public FileRefFactory {
  public:
   TagLibFileRefFactory() = default;
-  TagLib::FileRef *GetFileRef(const QString &filename) override {
+  TagLib::FileRef *GetFileRef(const QString &filename, const TagLib::AudioProperties::ReadStyle audio_properties_style) override {
 #ifdef Q_OS_WIN32
-    return new TagLib::FileRef(filename.toStdWString().c_str());
+    return new TagLib::FileRef(filename.toStdWString().c_str(), true, audio_properties_style);
 #else
-    return new TagLib::FileRef(QFile::encodeName(filename).constData());
+    return new TagLib::FileRef(QFile::encodeName(filename).constData(), true, audio_properties_style);
 #endif
   }
 
@@ -327,13 +333,18 @@ TagReaderBase::Result TagReaderTagLib::ReadFile(const QString &filename, spb::ta
   }
   song->set_lastseen(QDateTime::currentSecsSinceEpoch());
 
-  std::unique_ptr<TagLib::FileRef> fileref(factory_->GetFileRef(filename));
+  const bool partial_parse = fileinfo.size() >= kPartialParseFileSize;
+
+  std::unique_ptr<TagLib::FileRef> fileref(factory_->GetFileRef(filename, partial_parse ? TagLib::AudioProperties::Fast : TagLib::AudioProperties::Average));
   if (!fileref || fileref->isNull()) {
     qLog(Error) << "TagLib could not open file" << filename;
     return Result::ErrorCode::FileOpenError;
   }
 
   song->set_filetype(GuessFileType(fileref.get()));
+  if (partial_parse) {
+    song->set_partial_parse(true);
+  }
 
   if (fileref->audioProperties()) {
     song->set_bitrate(fileref->audioProperties()->bitrate());
@@ -21,6 +21,8 @@
 #include <memory>
 #include <string>
 
+#include <google/protobuf/arena.h>
+
 #include <QCoreApplication>
 #include <QObject>
 #include <QIODevice>
@@ -56,10 +58,13 @@ TagReaderWorker::TagReaderWorker(QIODevice *socket, QObject *parent)
 
 void TagReaderWorker::MessageArrived(const spb::tagreader::Message &message) {
 
-  spb::tagreader::Message reply;
+  // Build the reply on an arena: a batch response allocates a whole tree of metadata messages,
+  // and the arena frees them in one step once the reply is sent, instead of field by field.
+  google::protobuf::Arena arena;
+  spb::tagreader::Message *reply = google::protobuf::Arena::Create<spb::tagreader::Message>(&arena);
 
-  HandleMessage(message, reply);
-  SendReply(message, &reply);
+  HandleMessage(message, *reply);
+  SendReply(message, reply);
 
 }
 
@@ -73,6 +78,12 @@ void TagReaderWorker::DeviceClosed() {
 
 void TagReaderWorker::HandleMessage(const spb::tagreader::Message &message, spb::tagreader::Message &reply) {
 
+  // Batch requests loop over the readers per file, so they are handled before the per-reader loop below.
+  if (message.has_read_file_batch_request()) {
+    HandleReadFileBatch(message.read_file_batch_request(), reply.mutable_read_file_batch_response());
+    return;
+  }
+
   for (shared_ptr<TagReaderBase> reader : tagreaders_) {
 
     if (message.has_is_media_file_request()) {
@@ -191,3 +202,25 @@ void TagReaderWorker::HandleMessage(const spb::tagreader::Message &message, spb:
   }
 
 }
+
+void TagReaderWorker::HandleReadFileBatch(const spb::tagreader::ReadFileBatchRequest &request, spb::tagreader::ReadFileBatchResponse *response) {
+
+  for (int i = 0; i < request.filenames_size(); ++i) {
+    const QString filename = QString::fromStdString(request.filenames(i));
+    spb::tagreader::ReadFileResponse *file_response = response->add_responses();
+    for (shared_ptr<TagReaderBase> reader : tagreaders_) {
+      const TagReaderBase::Result result = reader->ReadFile(filename, file_response->mutable_metadata());
+      file_response->set_success(result.success());
+      if (result.success()) {
+        if (file_response->has_error()) {
+          file_response->clear_error();
+        }
+        break;
+      }
+      if (!file_response->has_error()) {
+        file_response->set_error(TagReaderBase::ErrorString(result).toStdString());
+      }
+    }
+  }
+
+}
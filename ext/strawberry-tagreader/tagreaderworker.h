@@ -47,6 +47,7 @@ class TagReaderWorker : public AbstractMessageHandler<spb::tagreader::Message> {
 
  private:
   void HandleMessage(const spb::tagreader::Message &message, spb::tagreader::Message &reply);
+  void HandleReadFileBatch(const spb::tagreader::ReadFileBatchRequest &request, spb::tagreader::ReadFileBatchResponse *response);
 
   QList<shared_ptr<TagReaderBase>> tagreaders_;
 };
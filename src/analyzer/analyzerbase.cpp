@@ -33,12 +33,20 @@
 #include <QPainter>
 #include <QPalette>
 #include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QShowEvent>
 #include <QHideEvent>
 #include <QTimerEvent>
 
 #include "engine/enginebase.h"
 
+namespace {
+// Framerates the governor falls back to when painting is too expensive for the configured rate.
+constexpr int kGovernorMediumTimeout = 1000 / 30;
+constexpr int kGovernorLowTimeout = 1000 / 20;
+constexpr float kGovernorCostSmoothing = 0.1F;
+}  // namespace
+
 // INSTRUCTIONS Base2D
 // 1. do anything that depends on height() in init(), Base2D will call it before you are shown
 // 2. otherwise you can use the constructor to initialize things
@@ -57,7 +65,9 @@ AnalyzerBase::AnalyzerBase(QWidget *parent, const uint scopeSize)
       lastscope_(512),
       new_frame_(false),
       is_playing_(false),
-      timeout_(40) {
+      timeout_(40),
+      paint_cost_ms_(0.0F),
+      governed_timeout_(40) {
 
   setAttribute(Qt::WA_OpaquePaintEvent, true);
 
@@ -68,7 +78,7 @@ AnalyzerBase::~AnalyzerBase() {
 }
 
 void AnalyzerBase::showEvent(QShowEvent*) {
-  timer_.start(timeout(), this);
+  timer_.start(governed_timeout_, this);
 }
 
 void AnalyzerBase::hideEvent(QHideEvent*) {
@@ -78,24 +88,30 @@ void AnalyzerBase::hideEvent(QHideEvent*) {
 void AnalyzerBase::ChangeTimeout(const int timeout) {
 
   timeout_ = timeout;
+  governed_timeout_ = timeout;
+  paint_cost_ms_ = 0.0F;
   if (timer_.isActive()) {
     timer_.stop();
-    timer_.start(timeout_, this);
+    timer_.start(governed_timeout_, this);
   }
 
 }
 
 void AnalyzerBase::transform(Scope &scope) {
 
-  QVector<float> aux(fht_->size());
-  if (static_cast<quint64>(aux.size()) >= scope.size()) {
-    std::copy(scope.begin(), scope.end(), aux.begin());
+  if (transform_aux_.size() != static_cast<size_t>(fht_->size())) {
+    transform_aux_.resize(fht_->size());
+  }
+
+  if (transform_aux_.size() >= scope.size()) {
+    std::copy(scope.begin(), scope.end(), transform_aux_.begin());
+    std::fill(transform_aux_.begin() + scope.size(), transform_aux_.end(), 0.0F);
   }
   else {
-    std::copy(scope.begin(), scope.begin() + aux.size(), aux.begin());
+    std::copy(scope.begin(), scope.begin() + transform_aux_.size(), transform_aux_.begin());
   }
 
-  fht_->logSpectrum(scope.data(), aux.data());
+  fht_->logSpectrum(scope.data(), transform_aux_.data());
   fht_->scale(scope.data(), 1.0F / 20);
 
   scope.resize(fht_->size() / 2);  // second half of values are rubbish
@@ -104,25 +120,34 @@ void AnalyzerBase::transform(Scope &scope) {
 
 void AnalyzerBase::paintEvent(QPaintEvent *e) {
 
+  QElapsedTimer paint_timer;
+  paint_timer.start();
+
   QPainter p(this);
   p.fillRect(e->rect(), palette().color(QPalette::Window));
 
   switch (engine_->state()) {
     case EngineBase::State::Playing:{
-      const EngineBase::Scope &thescope = engine_->scope(timeout_);
-      int i = 0;
-
-      // convert to mono here - our built in analyzers need mono, but the engines provide interleaved pcm
-      for (uint x = 0; static_cast<int>(x) < fht_->size(); ++x) {
-        lastscope_[x] = static_cast<float>(thescope[i] + thescope[i + 1]) / (2 * (1U << 15U));
-        i += 2;
+      // The spectrum is computed once per audio frame.
+      // Repaints that arrive in between (expose and resize events) reuse the previous result instead of running the transform again.
+      if (new_frame_ || current_scope_.empty()) {
+        const EngineBase::Scope &thescope = engine_->scope(timeout_);
+        int i = 0;
+
+        // convert to mono here - our built in analyzers need mono, but the engines provide interleaved pcm
+        for (uint x = 0; static_cast<int>(x) < fht_->size(); ++x) {
+          lastscope_[x] = static_cast<float>(thescope[i] + thescope[i + 1]) / (2 * (1U << 15U));
+          i += 2;
+        }
+
+        transform(lastscope_);
+        current_scope_ = lastscope_;
+
+        lastscope_.resize(fht_->size());
       }
 
       is_playing_ = true;
-      transform(lastscope_);
-      analyze(p, lastscope_, new_frame_);
-
-      lastscope_.resize(fht_->size());
+      analyze(p, current_scope_, new_frame_);
 
       break;
     }
@@ -138,6 +163,8 @@ void AnalyzerBase::paintEvent(QPaintEvent *e) {
 
   new_frame_ = false;
 
+  paint_cost_ms_ = paint_cost_ms_ * (1.0F - kGovernorCostSmoothing) + static_cast<float>(paint_timer.nsecsElapsed()) / 1000000.0F * kGovernorCostSmoothing;
+
 }
 
 int AnalyzerBase::resizeExponent(int exp) {
@@ -152,6 +179,7 @@ int AnalyzerBase::resizeExponent(int exp) {
   if (exp != fht_->sizeExp()) {
     delete fht_;
     fht_ = new FHT(exp);
+    current_scope_.clear();
   }
   return exp;
 
@@ -254,6 +282,25 @@ void AnalyzerBase::timerEvent(QTimerEvent *e) {
     return;
   }
 
+  // Fully obscured or minimized: the frame would be thrown away, so don't fetch a scope or paint at all.
+  if (window()->isMinimized() || visibleRegion().isEmpty()) {
+    return;
+  }
+
+  // Back off to 30 then 20 fps when painting eats most of the frame budget, and return to the configured rate once it is cheap again.
+  int wanted_timeout = timeout_;
+  if (paint_cost_ms_ > static_cast<float>(wanted_timeout) / 2) {
+    wanted_timeout = qMax(wanted_timeout, kGovernorMediumTimeout);
+  }
+  if (paint_cost_ms_ > static_cast<float>(wanted_timeout) / 2) {
+    wanted_timeout = qMax(wanted_timeout, kGovernorLowTimeout);
+  }
+  if (wanted_timeout != governed_timeout_) {
+    governed_timeout_ = wanted_timeout;
+    timer_.stop();
+    timer_.start(governed_timeout_, this);
+  }
+
   new_frame_ = true;
   update();
 
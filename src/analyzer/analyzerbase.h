@@ -85,10 +85,18 @@ class AnalyzerBase : public QWidget {
   FHT *fht_;
   SharedPtr<EngineBase> engine_;
   Scope lastscope_;
+  // Scratch buffer reused by transform(), so no allocation happens per frame.
+  Scope transform_aux_;
+  // Spectrum of the most recent audio frame, reused by repaints that arrive between frames.
+  Scope current_scope_;
 
   bool new_frame_;
   bool is_playing_;
   int timeout_;
+  // Frame governor state: smoothed paint cost in milliseconds, and the interval actually applied to the timer,
+  // which backs off below the configured rate when painting eats most of the frame budget.
+  float paint_cost_ms_;
+  int governed_timeout_;
 };
 
 #endif  // ANALYZERBASE_H
@@ -102,7 +102,8 @@ void FHT::semiLogSpectrum(float *p) {
 
   power2(p);
   for (int i = 0; i < (num_ / 2); i++, p++) {
-    float e = 10.0F * static_cast<float>(log10(sqrt(*p / static_cast<float>(2))));
+    // 10 * log10(sqrt(x / 2)) == 5 * log10(x / 2), saves the sqrt and keeps the whole loop in single precision.
+    float e = 5.0F * std::log10(*p / 2.0F);
     *p = e < 0 ? 0 : e;
   }
 
@@ -112,7 +113,7 @@ void FHT::spectrum(float *p) {
 
   power2(p);
   for (int i = 0; i < (num_ / 2); i++, p++) {
-    *p = static_cast<float>(sqrt(*p / 2));
+    *p = std::sqrt(*p / 2.0F);
   }
 
 }
@@ -128,12 +129,13 @@ void FHT::power2(float *p) {
 
   _transform(p, num_, 0);
 
-  *p = static_cast<float>(2 * pow(*p, 2));
+  // Plain multiplications instead of pow(): this runs for every bin on every frame, and pow() goes through the double-precision libm path.
+  *p = 2.0F * *p * *p;
   p++;
 
   float *q = p + num_ - 2;
   for (int i = 1; i < (num_ / 2); i++) {
-    *p = static_cast<float>(pow(*p, 2) + pow(*q, 2));
+    *p = (*p * *p) + (*q * *q);
     p++;
     q--;
   }
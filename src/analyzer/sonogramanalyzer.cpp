@@ -31,7 +31,7 @@
 const char *SonogramAnalyzer::kName = QT_TRANSLATE_NOOP("AnalyzerContainer", "Sonogram");
 
 SonogramAnalyzer::SonogramAnalyzer(QWidget *parent)
-    : AnalyzerBase(parent, 9) {}
+    : AnalyzerBase(parent, 9), ring_pos_(0) {}
 
 void SonogramAnalyzer::resizeEvent(QResizeEvent *e) {
 
@@ -39,45 +39,48 @@ void SonogramAnalyzer::resizeEvent(QResizeEvent *e) {
 
   canvas_ = QPixmap(size());
   canvas_.fill(palette().color(QPalette::Window));
+  ring_pos_ = 0;
 
 }
 
 void SonogramAnalyzer::analyze(QPainter &p, const Scope &s, const bool new_frame) {
 
-  if (!new_frame || engine_->state() == EngineBase::State::Paused) {
-    p.drawPixmap(0, 0, canvas_);
-    return;
-  }
-
-  QPainter canvas_painter(&canvas_);
-  canvas_painter.drawPixmap(0, 0, canvas_, 1, 0, width() - 1, -1);
-
-  Scope::const_iterator it = s.begin(), end = s.end();
-
-  for (int y = height() - 1; y;) {
-    QColor c;
-    if (it >= end || *it < .005) {
-      c = palette().color(QPalette::Window);
-    }
-    else if (*it < .05) {
-      c.setHsv(95, 255, 255 - static_cast<int>(*it * 4000.0));
-    }
-    else if (*it < 1.0) {
-      c.setHsv(95 - static_cast<int>(*it * 90.0), 255, 255);
-    }
-    else {
-      c = Qt::red;
+  if (new_frame && engine_->state() != EngineBase::State::Paused) {
+    // Only the new spectrum column is painted; the rest of the canvas stays as it is.
+    QPainter canvas_painter(&canvas_);
+
+    Scope::const_iterator it = s.begin(), end = s.end();
+
+    for (int y = height() - 1; y;) {
+      QColor c;
+      if (it >= end || *it < .005) {
+        c = palette().color(QPalette::Window);
+      }
+      else if (*it < .05) {
+        c.setHsv(95, 255, 255 - static_cast<int>(*it * 4000.0));
+      }
+      else if (*it < 1.0) {
+        c.setHsv(95 - static_cast<int>(*it * 90.0), 255, 255);
+      }
+      else {
+        c = Qt::red;
+      }
+
+      canvas_painter.setPen(c);
+      canvas_painter.drawPoint(ring_pos_, y--);
+
+      if (it < end) ++it;
     }
 
-    canvas_painter.setPen(c);
-    canvas_painter.drawPoint(width() - 1, y--);
+    canvas_painter.end();
 
-    if (it < end) ++it;
+    ring_pos_ = (ring_pos_ + 1) % qMax(width(), 1);
   }
 
-  canvas_painter.end();
-
-  p.drawPixmap(0, 0, canvas_);
+  // Scrolling is pure composition:
+  // the columns from ring_pos_ onwards are the oldest and go on the left, the ones before it are the newest and go on the right.
+  p.drawPixmap(0, 0, canvas_, ring_pos_, 0, width() - ring_pos_, -1);
+  p.drawPixmap(width() - ring_pos_, 0, canvas_, 0, 0, ring_pos_, -1);
 
 }
 
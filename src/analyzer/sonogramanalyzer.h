@@ -44,7 +44,10 @@ class SonogramAnalyzer : public AnalyzerBase {
   void demo(QPainter &p) override;
 
  private:
+  // The canvas is used as a ring buffer of spectrum columns:
+  // each new column is painted once at ring_pos_ and scrolling happens by drawing the two ring segments in order, so the old columns are never rewritten.
   QPixmap canvas_;
+  int ring_pos_;
 };
 
 #endif  // SONOGRAMANALYZER_H
@@ -107,6 +107,8 @@ void SCollection::Init() {
   watcher_->set_task_manager(app_->task_manager());
 
   QObject::connect(&*backend_, &CollectionBackend::Error, this, &SCollection::Error);
+  // A database profile switch re-points every connection at the new file; the backend drops per-profile caches and resets the model.
+  QObject::connect(&*app_->database(), &Database::DatabaseSwitched, &*backend_, &CollectionBackend::DatabaseSwitched);
   QObject::connect(&*backend_, &CollectionBackend::DirectoryAdded, watcher_, &CollectionWatcher::AddDirectory);
   QObject::connect(&*backend_, &CollectionBackend::DirectoryDeleted, watcher_, &CollectionWatcher::RemoveDirectory);
   QObject::connect(&*backend_, &CollectionBackend::SongsRatingChanged, this, &SCollection::SongsRatingChanged);
@@ -21,6 +21,8 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -31,6 +33,7 @@
 #include <QMutex>
 #include <QSet>
 #include <QMap>
+#include <QHash>
 #include <QVector>
 #include <QVariant>
 #include <QByteArray>
@@ -38,9 +41,11 @@
 #include <QStringList>
 #include <QUrl>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QDateTime>
 #include <QRegularExpression>
+#include <QTimer>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
@@ -51,20 +56,38 @@
 #include "core/scopedtransaction.h"
 #include "core/song.h"
 #include "core/sqlrow.h"
+#include "core/taskmanager.h"
 #include "smartplaylists/smartplaylistsearch.h"
 
 #include "collectiondirectory.h"
 #include "collectionbackend.h"
+
 #include "collectionfilteroptions.h"
 #include "collectionquery.h"
 #include "collectiontask.h"
 
+namespace {
+// Number of songs written per transaction in AddOrUpdateSongs() before the chunk is committed,
+// so readers on other connections aren't starved during a full rescan.
+constexpr int kAddOrUpdateSongsChunkSize = 400;
+
+// How long rating/playcount/skipcount updates are buffered before FlushPendingStatistics() writes them in one transaction.
+constexpr int kPendingStatisticsFlushIntervalMs = 250;
+
+// First line of an exported play statistics file, followed by the format version.
+constexpr char kPlayStatisticsMagic[] = "#strawberry_playstats";
+// Rows applied per transaction during an import, so playback queries interleave between batches.
+constexpr int kImportPlayStatisticsBatchSize = 5000;
+}  // namespace
+
 CollectionBackend::CollectionBackend(QObject *parent)
     : CollectionBackendInterface(parent),
       db_(nullptr),
       task_manager_(nullptr),
       source_(Song::Source::Unknown),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      known_fingerprints_loaded_(false),
+      pending_statistics_timer_(nullptr) {
 
   original_thread_ = thread();
 
@@ -102,6 +125,8 @@ void CollectionBackend::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
 
+  FlushPendingStatistics();
+
   moveToThread(original_thread_);
   emit ExitFinished();
 
@@ -181,6 +206,14 @@ void CollectionBackend::ResetPlayStatisticsAsync(const QList<int> &id_list, cons
   QMetaObject::invokeMethod(this, "ResetPlayStatistics", Qt::QueuedConnection, Q_ARG(QList<int>, id_list), Q_ARG(bool, save_tags));
 }
 
+void CollectionBackend::ExportPlayStatisticsAsync(const QString &filename) {
+  QMetaObject::invokeMethod(this, "ExportPlayStatistics", Qt::QueuedConnection, Q_ARG(QString, filename));
+}
+
+void CollectionBackend::ImportPlayStatisticsAsync(const QString &filename) {
+  QMetaObject::invokeMethod(this, "ImportPlayStatistics", Qt::QueuedConnection, Q_ARG(QString, filename));
+}
+
 void CollectionBackend::LoadDirectories() {
 
   const CollectionDirectoryList dirs = GetAllDirectories();
@@ -616,109 +649,163 @@ void CollectionBackend::AddOrUpdateSongsAsync(const SongList &songs) {
 
 void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
+  AddKnownFingerprints(songs);
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
-  ScopedTransaction transaction(&db);
+  std::unique_ptr<ScopedTransaction> transaction = std::make_unique<ScopedTransaction>(&db);
+
+  // All statements are prepared once and reused for every song in the batch.
+  SqlQuery check_dir(db);
+  if (!dirs_table_.isEmpty()) {
+    check_dir.prepare(QStringLiteral("SELECT ROWID FROM %1 WHERE ROWID = :id").arg(dirs_table_));
+  }
+
+  SqlQuery check_id(db);
+  check_id.prepare(QStringLiteral("SELECT ROWID FROM %1 WHERE ROWID = :id").arg(songs_table_));
 
+  SqlQuery check_song_id(db);
+  check_song_id.prepare(QStringLiteral("SELECT ROWID FROM %1 WHERE SONG_ID = :song_id").arg(songs_table_));
+
+  SqlQuery update_query(db);
+  update_query.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
+
+  SqlQuery insert_query(db);
+  insert_query.prepare(QStringLiteral("INSERT INTO %1 (%2) VALUES (%3)").arg(songs_table_, Song::kColumnSpec, Song::kBindSpec));
+
+  // Songs are accumulated per chunk and only announced once their transaction has been committed.
   SongList added_songs;
   SongList changed_songs;
+  SongList added_songs_pending;
+  SongList changed_songs_pending;
+
+  QSet<int> existing_directories;
+  int pending = 0;
+
+  const auto commit_chunk = [&transaction, &db, &added_songs, &changed_songs, &added_songs_pending, &changed_songs_pending, &pending](const bool reopen) {
+    transaction->Commit();
+    added_songs << added_songs_pending;
+    changed_songs << changed_songs_pending;
+    added_songs_pending.clear();
+    changed_songs_pending.clear();
+    pending = 0;
+    if (reopen) {
+      transaction = std::make_unique<ScopedTransaction>(&db);
+    }
+  };
+
+  const auto notify = [this, &added_songs, &changed_songs]() {
+    if (!added_songs.isEmpty()) emit SongsAdded(added_songs);
+    if (!changed_songs.isEmpty()) emit SongsChanged(changed_songs);
+  };
 
   for (const Song &song : songs) {
 
     // Do a sanity check first - make sure the song's directory still exists
     // This is to fix a possible race condition when a directory is removed while CollectionWatcher is scanning it.
-    if (!dirs_table_.isEmpty()) {
-      SqlQuery check_dir(db);
-      check_dir.prepare(QStringLiteral("SELECT ROWID FROM %1 WHERE ROWID = :id").arg(dirs_table_));
+    if (!dirs_table_.isEmpty() && !existing_directories.contains(song.directory_id())) {
       check_dir.BindValue(QStringLiteral(":id"), song.directory_id());
       if (!check_dir.Exec()) {
         db_->ReportErrors(check_dir);
+        notify();
         return;
       }
 
       if (!check_dir.next()) continue;
 
+      existing_directories << song.directory_id();
+
     }
 
     if (song.id() != -1) {  // This song exists in the DB.
 
-      // Get the previous song data first
-      Song old_song(GetSongById(song.id()));
-      if (!old_song.is_valid()) continue;
+      // Make sure the row is still there
+      check_id.BindValue(QStringLiteral(":id"), song.id());
+      if (!check_id.Exec()) {
+        db_->ReportErrors(check_id);
+        notify();
+        return;
+      }
+      if (!check_id.next()) continue;
 
       // Update
-      {
-        SqlQuery q(db);
-        q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
-        song.BindToQuery(&q);
-        q.BindValue(QStringLiteral(":id"), song.id());
-        if (!q.Exec()) {
-          db_->ReportErrors(q);
-          return;
-        }
+      song.BindToQuery(&update_query);
+      update_query.BindValue(QStringLiteral(":id"), song.id());
+      if (!update_query.Exec()) {
+        db_->ReportErrors(update_query);
+        notify();
+        return;
       }
 
-      changed_songs << song;
-
-      continue;
+      changed_songs_pending << song;
 
     }
-    else if (!song.song_id().isEmpty()) {  // Song has a unique id, check if the song exists.
+    else {
 
-      // Get the previous song data first
-      Song old_song(GetSongBySongId(song.song_id()));
+      int old_id = -1;
+      if (!song.song_id().isEmpty()) {  // Song has a unique id, check if the song exists.
+        check_song_id.BindValue(QStringLiteral(":song_id"), song.song_id());
+        if (!check_song_id.Exec()) {
+          db_->ReportErrors(check_song_id);
+          notify();
+          return;
+        }
+        if (check_song_id.next()) {
+          old_id = check_song_id.value(0).toInt();
+        }
+      }
 
-      if (old_song.is_valid() && old_song.id() != -1) {
+      if (old_id != -1) {
 
         Song new_song = song;
-        new_song.set_id(old_song.id());
+        new_song.set_id(old_id);
 
         // Update
-        {
-          SqlQuery q(db);
-          q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
-          new_song.BindToQuery(&q);
-          q.BindValue(QStringLiteral(":id"), new_song.id());
-          if (!q.Exec()) {
-            db_->ReportErrors(q);
-            return;
-          }
+        new_song.BindToQuery(&update_query);
+        update_query.BindValue(QStringLiteral(":id"), new_song.id());
+        if (!update_query.Exec()) {
+          db_->ReportErrors(update_query);
+          notify();
+          return;
         }
 
-        changed_songs << new_song;
+        changed_songs_pending << new_song;
 
-        continue;
       }
-    }
+      else {
 
-    // Create new song
+        // Create new song - insert the row and create a new ID
+        song.BindToQuery(&insert_query);
+        if (!insert_query.Exec()) {
+          db_->ReportErrors(insert_query);
+          notify();
+          return;
+        }
+        const int id = insert_query.lastInsertId().toInt();
+        if (id == -1) {
+          notify();
+          return;
+        }
+
+        Song song_copy(song);
+        song_copy.set_id(id);
+        added_songs_pending << song_copy;
 
-    int id = -1;
-    {  // Insert the row and create a new ID
-      SqlQuery q(db);
-      q.prepare(QStringLiteral("INSERT INTO %1 (%2) VALUES (%3)").arg(songs_table_, Song::kColumnSpec, Song::kBindSpec));
-      song.BindToQuery(&q);
-      if (!q.Exec()) {
-        db_->ReportErrors(q);
-        return;
       }
-      // Get the new ID
-      id = q.lastInsertId().toInt();
-    }
 
-    if (id == -1) return;
+    }
 
-    Song song_copy(song);
-    song_copy.set_id(id);
-    added_songs << song_copy;
+    // Commit in bounded chunks so a full rescan doesn't hold one giant transaction that starves readers.
+    if (++pending >= kAddOrUpdateSongsChunkSize) {
+      commit_chunk(true);
+    }
 
   }
 
-  transaction.Commit();
+  commit_chunk(false);
 
-  if (!added_songs.isEmpty()) emit SongsAdded(added_songs);
-  if (!changed_songs.isEmpty()) emit SongsChanged(changed_songs);
+  notify();
 
   UpdateTotalSongCountAsync();
   UpdateTotalArtistCountAsync();
@@ -726,12 +813,50 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
 }
 
+void CollectionBackend::SyncSongsInDirectory(const SongList &songs, const int directory_id) {
+
+  const SongList cached_songs = FindSongsInDirectory(directory_id);
+
+  QHash<QUrl, Song> cached_songs_by_url;
+  cached_songs_by_url.reserve(cached_songs.count());
+  for (const Song &cached_song : cached_songs) {
+    cached_songs_by_url.insert(cached_song.url(), cached_song);
+  }
+
+  SongList songs_to_add_or_update;
+  QSet<QUrl> seen_urls;
+  seen_urls.reserve(songs.count());
+  for (const Song &song : songs) {
+    seen_urls << song.url();
+    const QHash<QUrl, Song>::const_iterator it = cached_songs_by_url.constFind(song.url());
+    if (it == cached_songs_by_url.constEnd()) {
+      songs_to_add_or_update << song;
+    }
+    else if (!song.IsAllMetadataEqual(it.value()) || !song.IsFingerprintEqual(it.value())) {
+      Song changed_song = song;
+      changed_song.set_id(it.value().id());
+      songs_to_add_or_update << changed_song;
+    }
+  }
+
+  SongList songs_to_delete;
+  for (const Song &cached_song : cached_songs) {
+    if (!seen_urls.contains(cached_song.url())) songs_to_delete << cached_song;
+  }
+
+  if (!songs_to_delete.isEmpty()) DeleteSongs(songs_to_delete);
+  if (!songs_to_add_or_update.isEmpty()) AddOrUpdateSongs(songs_to_add_or_update);
+
+}
+
 void CollectionBackend::UpdateSongsBySongIDAsync(const SongMap &new_songs) {
   QMetaObject::invokeMethod(this, "UpdateSongsBySongID", Qt::QueuedConnection, Q_ARG(SongMap, new_songs));
 }
 
 void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
+  AddKnownFingerprints(new_songs.values());
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -1292,8 +1417,49 @@ SongList CollectionBackend::GetSongsBySongId(const QStringList &song_ids, QSqlDa
 
 }
 
+bool CollectionBackend::HasFingerprint(const QString &fingerprint) {
+
+  QMutexLocker l(&known_fingerprints_mutex_);
+
+  if (!known_fingerprints_loaded_) {
+    QMutexLocker db_locker(db_->Mutex());
+    QSqlDatabase db(db_->Connect());
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("SELECT DISTINCT fingerprint FROM %1 WHERE fingerprint IS NOT NULL AND fingerprint != ''").arg(songs_table_));
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return true;  // Fall back to the SQLite lookup.
+    }
+    while (q.next()) {
+      known_fingerprints_ << q.value(0).toString();
+    }
+    known_fingerprints_loaded_ = true;
+  }
+
+  return known_fingerprints_.contains(fingerprint);
+
+}
+
+void CollectionBackend::AddKnownFingerprints(const SongList &songs) {
+
+  QMutexLocker l(&known_fingerprints_mutex_);
+
+  if (!known_fingerprints_loaded_) return;
+
+  for (const Song &song : songs) {
+    if (!song.fingerprint().isEmpty()) {
+      known_fingerprints_ << song.fingerprint();
+    }
+  }
+
+}
+
 SongList CollectionBackend::GetSongsByFingerprint(const QString &fingerprint) {
 
+  if (!HasFingerprint(fingerprint)) {
+    return SongList();
+  }
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -1811,20 +1977,11 @@ void CollectionBackend::IncrementPlayCount(const int id) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  PendingStatistics &pending = pending_statistics_[id];
+  ++pending.playcount_delta;
+  pending.lastplayed = QDateTime::currentSecsSinceEpoch();
 
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET playcount = playcount + 1, lastplayed = :now WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(QStringLiteral(":now"), QDateTime::currentSecsSinceEpoch());
-  q.BindValue(QStringLiteral(":id"), id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
-  }
-
-  Song new_song = GetSongById(id, db);
-  emit SongsStatisticsChanged(SongList() << new_song);
+  SchedulePendingStatisticsFlush();
 
 }
 
@@ -1834,19 +1991,265 @@ void CollectionBackend::IncrementSkipCount(const int id, const float progress) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  ++pending_statistics_[id].skipcount_delta;
 
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET skipcount = skipcount + 1 WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(QStringLiteral(":id"), id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
+  SchedulePendingStatisticsFlush();
+
+}
+
+void CollectionBackend::SchedulePendingStatisticsFlush() {
+
+  if (!pending_statistics_timer_) {
+    pending_statistics_timer_ = new QTimer(this);
+    pending_statistics_timer_->setSingleShot(true);
+    pending_statistics_timer_->setInterval(kPendingStatisticsFlushIntervalMs);
+    QObject::connect(pending_statistics_timer_, &QTimer::timeout, this, &CollectionBackend::FlushPendingStatistics);
+  }
+
+  // Not restarted while running, so a steady stream of updates still flushes every interval.
+  if (!pending_statistics_timer_->isActive()) {
+    pending_statistics_timer_->start();
+  }
+
+}
+
+void CollectionBackend::FlushPendingStatistics() {
+
+  if (pending_statistics_.isEmpty()) return;
+
+  const QMap<int, PendingStatistics> pending = pending_statistics_;
+  pending_statistics_.clear();
+
+  QList<int> statistics_ids;
+  QList<int> rating_ids;
+  bool statistics_save_tags = false;
+  bool rating_save_tags = false;
+
+  {
+    QMutexLocker l(db_->Mutex());
+    QSqlDatabase db(db_->Connect());
+
+    ScopedTransaction transaction(&db);
+
+    SqlQuery playcount_query(db);
+    playcount_query.prepare(QStringLiteral("UPDATE %1 SET playcount = playcount + :delta, lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
+    SqlQuery skipcount_query(db);
+    skipcount_query.prepare(QStringLiteral("UPDATE %1 SET skipcount = skipcount + :delta WHERE ROWID = :id").arg(songs_table_));
+    SqlQuery rating_query(db);
+    rating_query.prepare(QStringLiteral("UPDATE %1 SET rating = :rating WHERE ROWID = :id").arg(songs_table_));
+    SqlQuery set_playcount_query(db);
+    set_playcount_query.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount WHERE ROWID = :id").arg(songs_table_));
+    SqlQuery set_lastplayed_query(db);
+    set_lastplayed_query.prepare(QStringLiteral("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id AND lastplayed < :lastplayed").arg(songs_table_));
+
+    for (QMap<int, PendingStatistics>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+      const int id = it.key();
+      const PendingStatistics &entry = it.value();
+      if (entry.has_playcount) {
+        set_playcount_query.BindValue(QStringLiteral(":playcount"), entry.playcount);
+        set_playcount_query.BindValue(QStringLiteral(":id"), id);
+        if (!set_playcount_query.Exec()) {
+          db_->ReportErrors(set_playcount_query);
+          return;
+        }
+        statistics_save_tags = statistics_save_tags || entry.save_tags;
+      }
+      if (entry.lastplayed_if_newer >= 0) {
+        set_lastplayed_query.BindValue(QStringLiteral(":lastplayed"), entry.lastplayed_if_newer);
+        set_lastplayed_query.BindValue(QStringLiteral(":id"), id);
+        if (!set_lastplayed_query.Exec()) {
+          db_->ReportErrors(set_lastplayed_query);
+          return;
+        }
+      }
+      if (entry.playcount_delta > 0) {
+        playcount_query.BindValue(QStringLiteral(":delta"), entry.playcount_delta);
+        playcount_query.BindValue(QStringLiteral(":lastplayed"), entry.lastplayed);
+        playcount_query.BindValue(QStringLiteral(":id"), id);
+        if (!playcount_query.Exec()) {
+          db_->ReportErrors(playcount_query);
+          return;
+        }
+      }
+      if (entry.skipcount_delta > 0) {
+        skipcount_query.BindValue(QStringLiteral(":delta"), entry.skipcount_delta);
+        skipcount_query.BindValue(QStringLiteral(":id"), id);
+        if (!skipcount_query.Exec()) {
+          db_->ReportErrors(skipcount_query);
+          return;
+        }
+      }
+      if (entry.has_rating) {
+        rating_query.BindValue(QStringLiteral(":rating"), entry.rating);
+        rating_query.BindValue(QStringLiteral(":id"), id);
+        if (!rating_query.Exec()) {
+          db_->ReportErrors(rating_query);
+          return;
+        }
+        rating_ids << id;
+        rating_save_tags = rating_save_tags || entry.save_tags;
+      }
+      if (entry.playcount_delta > 0 || entry.skipcount_delta > 0 || entry.has_playcount || entry.lastplayed_if_newer >= 0) {
+        statistics_ids << id;
+      }
+    }
+
+    transaction.Commit();
+  }
+
+  if (!statistics_ids.isEmpty()) {
+    emit SongsStatisticsChanged(GetSongsById(statistics_ids), statistics_save_tags);
+  }
+
+  if (!rating_ids.isEmpty()) {
+    emit SongsRatingChanged(GetSongsById(rating_ids), rating_save_tags);
+  }
+
+}
+
+void CollectionBackend::ExportPlayStatistics(const QString &filename) {
+
+  // Make sure buffered statistics are in the database before they are read back out.
+  FlushPendingStatistics();
+
+  // Read-only snapshot connection, so a big export never queues behind playback queries or a running scan.
+  QSqlDatabase db(db_->ConnectRead());
+
+  const QString where = QStringLiteral("playcount > 0 OR skipcount > 0 OR lastplayed > 0 OR rating >= 0");
+
+  int total = 0;
+  {
+    SqlQuery count_query(db);
+    count_query.prepare(QStringLiteral("SELECT COUNT(*) FROM %1 WHERE %2").arg(songs_table_, where));
+    if (count_query.Exec() && count_query.Next()) {
+      total = count_query.value(0).toInt();
+    }
+  }
+
+  SqlQuery query(db);
+  query.prepare(QStringLiteral("SELECT url, playcount, skipcount, lastplayed, rating FROM %1 WHERE %2").arg(songs_table_, where));
+  if (!query.Exec()) {
+    db_->ReportErrors(query);
     return;
   }
 
-  Song new_song = GetSongById(id, db);
-  emit SongsStatisticsChanged(SongList() << new_song);
+  // Write to a temporary file first, so an interrupted export can't truncate a previous backup.
+  const QString filename_tmp = filename + QStringLiteral(".tmp");
+  QFile file(filename_tmp);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    emit Error(tr("Unable to open play statistics file %1 for writing: %2").arg(filename_tmp, file.errorString()));
+    return;
+  }
+
+  const int task_id = task_manager_->StartTask(tr("Exporting play statistics"));
+
+  file.write(QByteArray(kPlayStatisticsMagic) + "\t1\n");
+
+  // One tab separated line per song: URL as stored in the database, playcount, skipcount, lastplayed, rating.
+  int count = 0;
+  while (query.Next()) {
+    QByteArray line = query.value(0).toByteArray();
+    line += '\t' + QByteArray::number(query.value(1).toInt());
+    line += '\t' + QByteArray::number(query.value(2).toInt());
+    line += '\t' + QByteArray::number(query.value(3).toLongLong());
+    line += '\t' + QByteArray::number(static_cast<double>(query.value(4).toFloat()));
+    line += '\n';
+    file.write(line);
+    ++count;
+    if (count % 2000 == 0) task_manager_->SetTaskProgress(task_id, count, total);
+  }
+
+  file.close();
+
+  if (QFile::exists(filename)) QFile::remove(filename);
+  if (!QFile::rename(filename_tmp, filename)) {
+    emit Error(tr("Unable to rename play statistics file %1 to %2").arg(filename_tmp, filename));
+    task_manager_->SetTaskFinished(task_id);
+    return;
+  }
+
+  task_manager_->SetTaskFinished(task_id);
+
+  qLog(Info) << "Exported play statistics for" << count << "songs to" << filename;
+
+  emit PlayStatisticsExported(count);
+
+}
+
+void CollectionBackend::ImportPlayStatistics(const QString &filename) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    emit Error(tr("Unable to open play statistics file %1 for reading: %2").arg(filename, file.errorString()));
+    return;
+  }
+
+  const QByteArray header = file.readLine().trimmed();
+  if (!header.startsWith(kPlayStatisticsMagic)) {
+    emit Error(tr("File %1 is not a play statistics file.").arg(filename));
+    return;
+  }
+
+  // Apply buffered statistics first, so a pending flush can't overwrite imported rows afterwards.
+  FlushPendingStatistics();
+
+  const int task_id = task_manager_->StartTask(tr("Importing play statistics"));
+
+  int imported = 0;
+  while (!file.atEnd()) {
+
+    // Collect one batch of parsed rows.
+    QList<QList<QByteArray>> rows;
+    rows.reserve(kImportPlayStatisticsBatchSize);
+    while (!file.atEnd() && rows.count() < kImportPlayStatisticsBatchSize) {
+      const QList<QByteArray> columns = file.readLine().trimmed().split('\t');
+      if (columns.count() != 5 || columns.first().isEmpty()) continue;
+      rows << columns;
+    }
+    if (rows.isEmpty()) break;
+
+    // One transaction per batch, the database mutex is released in between so playback queries interleave.
+    {
+      QMutexLocker l(db_->Mutex());
+      QSqlDatabase db(db_->Connect());
+
+      ScopedTransaction transaction(&db);
+
+      // Playcount and skipcount are absolute, lastplayed only ever moves forward, and the rating is left alone when the file has none.
+      SqlQuery query(db);
+      query.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount, skipcount = :skipcount, lastplayed = CASE WHEN :lastplayed > lastplayed THEN :lastplayed ELSE lastplayed END, rating = CASE WHEN :rating >= 0 THEN :rating ELSE rating END WHERE url = :url").arg(songs_table_));
+
+      for (const QList<QByteArray> &columns : std::as_const(rows)) {
+        query.BindValue(QStringLiteral(":playcount"), columns.value(1).toInt());
+        query.BindValue(QStringLiteral(":skipcount"), columns.value(2).toInt());
+        query.BindValue(QStringLiteral(":lastplayed"), columns.value(3).toLongLong());
+        query.BindValue(QStringLiteral(":rating"), columns.value(4).toFloat());
+        query.BindValue(QStringLiteral(":url"), QString::fromUtf8(columns.value(0)));
+        if (!query.Exec()) {
+          db_->ReportErrors(query);
+          task_manager_->SetTaskFinished(task_id);
+          return;
+        }
+        imported += query.numRowsAffected();
+      }
+
+      transaction.Commit();
+    }
+
+    task_manager_->SetTaskProgress(task_id, static_cast<int>(file.pos()), static_cast<int>(file.size()));
+
+  }
+
+  task_manager_->SetTaskFinished(task_id);
+
+  qLog(Info) << "Imported play statistics for" << imported << "songs from" << filename;
+
+  if (imported > 0) {
+    // The import can touch most of the collection, one full reload is cheaper than emitting every changed song.
+    emit DatabaseReset();
+  }
+
+  emit PlayStatisticsImported(imported);
 
 }
 
@@ -1862,6 +2265,18 @@ void CollectionBackend::ResetPlayStatistics(const QList<int> &id_list, const boo
 
   if (id_list.isEmpty()) return;
 
+  // Drop buffered play/skip counts for these songs so a pending flush doesn't resurrect them, but keep any buffered rating.
+  for (const int id : id_list) {
+    if (pending_statistics_.contains(id)) {
+      PendingStatistics &pending = pending_statistics_[id];
+      pending.playcount_delta = 0;
+      pending.skipcount_delta = 0;
+      pending.lastplayed = -1;
+      pending.has_playcount = false;
+      pending.lastplayed_if_newer = -1;
+    }
+  }
+
   QStringList id_str_list;
   id_str_list.reserve(id_list.count());
   for (const int id : id_list) {
@@ -1920,37 +2335,81 @@ void CollectionBackend::DeleteAll() {
     t.Commit();
   }
 
+  {
+    QMutexLocker l(&known_fingerprints_mutex_);
+    known_fingerprints_.clear();
+    known_fingerprints_loaded_ = false;
+  }
+
+  emit DatabaseReset();
+
+}
+
+void CollectionBackend::DatabaseSwitched() {
+
+  // All connections point at the new profile file now, so everything cached from the old one is stale.
+  // Buffered statistics hold ROWIDs from the old profile and must not be flushed into the new one.
+  pending_statistics_.clear();
+
+  {
+    QMutexLocker l(&known_fingerprints_mutex_);
+    known_fingerprints_.clear();
+    known_fingerprints_loaded_ = false;
+  }
+
   emit DatabaseReset();
 
 }
 
 SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &search) {
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  // Read-only snapshot connection, so smart playlist previews and dynamic playlist refreshes don't queue behind a running scan transaction.
+  QSqlDatabase db(db_->ConnectRead());
 
-  // Build the query
-  QString sql = search.ToSql(songs_table());
+  // With placeholders for the excluded IDs, limit and offset the statement text only depends on the search definition,
+  // so refreshes of the same dynamic playlist reuse the statement compiled on the first run instead of re-planning it every time.
+  SqlQuery *query = db_->GetCachedQuery(db, search.ToSql(songs_table(), true));
+  search.BindParameters(query);
 
   // Run the query
   SongList ret;
-  SqlQuery query(db);
-  query.prepare(sql);
-  if (!query.Exec()) {
-    db_->ReportErrors(query);
+  if (!query->Exec()) {
+    db_->ReportErrors(*query);
     return ret;
   }
 
   // Read the results
-  while (query.next()) {
+  while (query->next()) {
     Song song;
-    song.InitFromQuery(query, true);
+    song.InitFromQuery(*query, true);
     ret << song;
   }
+  query->finish();
+
   return ret;
 
 }
 
+int CollectionBackend::SmartPlaylistsCountSongs(const SmartPlaylistSearch &search) {
+
+  QSqlDatabase db(db_->ConnectRead());
+
+  SqlQuery *query = db_->GetCachedQuery(db, search.ToCountSql(songs_table()));
+  if (!query->Exec()) {
+    db_->ReportErrors(*query);
+    return -1;
+  }
+
+  int count = -1;
+  if (query->next()) {
+    count = query->value(0).toInt();
+  }
+  query->finish();
+
+  return count;
+
+}
+
 SongList CollectionBackend::SmartPlaylistsGetAllSongs() {
 
   // Get all the songs!
@@ -1996,24 +2455,16 @@ void CollectionBackend::UpdateLastPlayed(const QString &artist, const QString &a
     return;
   }
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
+  // Buffered and written behind in one transaction with the other statistics, so a history import doesn't issue one UPDATE per track.
   for (const Song &song : songs) {
     if (song.lastplayed() >= lastplayed) {
       continue;
     }
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(QStringLiteral(":lastplayed"), lastplayed);
-    q.BindValue(QStringLiteral(":id"), song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      continue;
-    }
+    PendingStatistics &pending = pending_statistics_[song.id()];
+    pending.lastplayed_if_newer = std::max(pending.lastplayed_if_newer, lastplayed);
   }
 
-  emit SongsStatisticsChanged(SongList() << songs);
+  SchedulePendingStatisticsFlush();
 
 }
 
@@ -2025,21 +2476,14 @@ void CollectionBackend::UpdatePlayCount(const QString &artist, const QString &ti
     return;
   }
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
   for (const Song &song : songs) {
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(QStringLiteral(":playcount"), playcount);
-    q.BindValue(QStringLiteral(":id"), song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      return;
-    }
+    PendingStatistics &pending = pending_statistics_[song.id()];
+    pending.has_playcount = true;
+    pending.playcount = playcount;
+    pending.save_tags = pending.save_tags || save_tags;
   }
 
-  emit SongsStatisticsChanged(SongList() << songs, save_tags);
+  SchedulePendingStatisticsFlush();
 
 }
 
@@ -2055,26 +2499,14 @@ void CollectionBackend::UpdateSongsRating(const QList<int> &id_list, const float
 
   if (id_list.isEmpty()) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
-  QStringList id_str_list;
-  id_str_list.reserve(id_list.count());
-  for (int i : id_list) {
-    id_str_list << QString::number(i);
-  }
-  QString ids = id_str_list.join(QLatin1Char(','));
-  SqlQuery q(db);
-  q.prepare(QStringLiteral("UPDATE %1 SET rating = :rating WHERE ROWID IN (%2)").arg(songs_table_, ids));
-  q.BindValue(QStringLiteral(":rating"), rating);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
+  for (const int id : id_list) {
+    PendingStatistics &pending = pending_statistics_[id];
+    pending.has_rating = true;
+    pending.rating = rating;
+    pending.save_tags = pending.save_tags || save_tags;
   }
 
-  SongList new_song_list = GetSongsById(id_str_list, db);
-
-  emit SongsRatingChanged(new_song_list, save_tags);
+  SchedulePendingStatisticsFlush();
 
 }
 
@@ -31,6 +31,9 @@
 #include <QObject>
 #include <QFileInfo>
 #include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -43,6 +46,7 @@
 #include "collectiondirectory.h"
 
 class QThread;
+class QTimer;
 class TaskManager;
 class Database;
 class SmartPlaylistSearch;
@@ -220,6 +224,12 @@ class CollectionBackend : public CollectionBackendInterface {
   void ResetPlayStatisticsAsync(const int id, const bool save_tags = false);
   void ResetPlayStatisticsAsync(const QList<int> &id_list, const bool save_tags = false);
 
+  // Export/import rating, playcount, skipcount and lastplayed for every song with statistics, keyed by URL,
+  // to/from a plain line-based file, so statistics can be moved between profiles or backed up periodically.
+  // The export reads from a snapshot connection and the import writes in batched transactions, so neither blocks playback.
+  void ExportPlayStatisticsAsync(const QString &filename);
+  void ImportPlayStatisticsAsync(const QString &filename);
+
   void DeleteAllAsync();
 
   Song GetSongBySongId(const QString &song_id);
@@ -229,10 +239,16 @@ class CollectionBackend : public CollectionBackendInterface {
 
   SongList SmartPlaylistsGetAllSongs();
   SongList SmartPlaylistsFindSongs(const SmartPlaylistSearch &search);
+  // Returns how many songs match the search without fetching them, or -1 on error.
+  int SmartPlaylistsCountSongs(const SmartPlaylistSearch &search);
 
   void AddOrUpdateSongsAsync(const SongList &songs);
   void UpdateSongsBySongIDAsync(const SongMap &new_songs);
 
+  // Makes the given directory contain exactly the given songs, writing only the differences against what is already stored.
+  // Reconnecting an unchanged device becomes a read and a few count updates instead of a full delete and rewrite.
+  void SyncSongsInDirectory(const SongList &songs, const int directory_id);
+
   void UpdateSongRatingAsync(const int id, const float rating, const bool save_tags = false);
   void UpdateSongsRatingAsync(const QList<int> &ids, const float rating, const bool save_tags = false);
 
@@ -263,6 +279,8 @@ class CollectionBackend : public CollectionBackendInterface {
   void ResetPlayStatistics(const QList<int> &id_list, const bool save_tags = false);
   bool ResetPlayStatistics(const QStringList &id_str_list);
   void DeleteAll();
+  // Drops state cached from the previous profile after Database::SwitchDatabaseFile() and reloads the models.
+  void DatabaseSwitched();
   void SongPathChanged(const Song &song, const QFileInfo &new_file, const std::optional<int> new_collection_directory_id);
 
   SongList GetSongsBy(const QString &artist, const QString &album, const QString &title);
@@ -275,6 +293,11 @@ class CollectionBackend : public CollectionBackendInterface {
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExpireSongs(const int directory_id, const int expire_unavailable_songs_days);
 
+  void FlushPendingStatistics();
+
+  void ExportPlayStatistics(const QString &filename);
+  void ImportPlayStatistics(const QString &filename);
+
  signals:
   void DirectoryAdded(const CollectionDirectory &dir, const CollectionSubdirectoryList &subdir);
   void DirectoryDeleted(const CollectionDirectory &dir);
@@ -292,6 +315,9 @@ class CollectionBackend : public CollectionBackendInterface {
   void TotalAlbumCountUpdated(const int count);
   void SongsRatingChanged(const SongList &songs, const bool save_tags);
 
+  void PlayStatisticsExported(const int count);
+  void PlayStatisticsImported(const int count);
+
   void ExitFinished();
 
   void Error(const QString &error);
@@ -318,6 +344,28 @@ class CollectionBackend : public CollectionBackendInterface {
   Song GetSongBySongId(const QString &song_id, QSqlDatabase &db);
   SongList GetSongsBySongId(const QStringList &song_ids, QSqlDatabase &db);
 
+  // In-memory membership probe over all known fingerprints, so negative GetSongsByFingerprint() lookups during scans are answered without an SQLite query.
+  // The set is loaded once on the first lookup and only ever grows, stale entries just cost a fallback query and never a wrong result.
+  bool HasFingerprint(const QString &fingerprint);
+  void AddKnownFingerprints(const SongList &songs);
+
+  // Rating/playcount/skipcount updates are buffered per song and written behind in one batched transaction by FlushPendingStatistics(),
+  // so rapid rating sprees and scrobble-driven playcount bumps don't contend with scan writes one UPDATE at a time.
+  struct PendingStatistics {
+    PendingStatistics() : playcount_delta(0), skipcount_delta(0), lastplayed(-1), has_playcount(false), playcount(0), lastplayed_if_newer(-1), has_rating(false), rating(0.0F), save_tags(false) {}
+    int playcount_delta;
+    int skipcount_delta;
+    qint64 lastplayed;
+    // Absolute values from history imports, applied before any buffered deltas.
+    bool has_playcount;
+    int playcount;
+    qint64 lastplayed_if_newer;
+    bool has_rating;
+    float rating;
+    bool save_tags;
+  };
+  void SchedulePendingStatisticsFlush();
+
  private:
   SharedPtr<Database> db_;
   SharedPtr<TaskManager> task_manager_;
@@ -326,6 +374,14 @@ class CollectionBackend : public CollectionBackendInterface {
   QString dirs_table_;
   QString subdirs_table_;
   QThread *original_thread_;
+
+  QSet<QString> known_fingerprints_;
+  bool known_fingerprints_loaded_;
+  QMutex known_fingerprints_mutex_;
+
+  // Only touched from the backend thread.
+  QMap<int, PendingStatistics> pending_statistics_;
+  QTimer *pending_statistics_timer_;
 };
 
 #endif  // COLLECTIONBACKEND_H
@@ -43,7 +43,39 @@ const QStringList CollectionFilter::Operators = QStringList() << QStringLiteral(
                                                               << QStringLiteral(">")
                                                               << QStringLiteral(">=");
 
-CollectionFilter::CollectionFilter(QObject *parent) : QSortFilterProxyModel(parent) {
+namespace {
+
+// Tokens shorter than this have no trigrams and fall back to plain substring verification.
+constexpr qsizetype kTrigramLength = 3;
+
+quint64 TrigramKey(const QChar c1, const QChar c2, const QChar c3) {
+  return (static_cast<quint64>(c1.unicode()) << 32) | (static_cast<quint64>(c2.unicode()) << 16) | static_cast<quint64>(c3.unicode());
+}
+
+void AddTrigrams(const QString &text, QSet<quint64> &trigrams) {
+
+  const QString lower = text.toLower();
+  for (qsizetype i = 0; i + kTrigramLength <= lower.length(); ++i) {
+    trigrams << TrigramKey(lower[i], lower[i + 1], lower[i + 2]);
+  }
+
+}
+
+// The index is lowercased with QString::toLower(), which matches Qt's case insensitive comparison for ASCII,
+// so only ASCII tokens are checked against the index to rule out false negatives from exotic case folding.
+bool IsAsciiToken(const QString &token) {
+
+  for (const QChar c : token) {
+    if (c.unicode() >= 128) return false;
+  }
+
+  return true;
+
+}
+
+}  // namespace
+
+CollectionFilter::CollectionFilter(QObject *parent) : QSortFilterProxyModel(parent), cached_use_candidates_(false) {
 
   setSortLocaleAware(true);
   setDynamicSortFilter(true);
@@ -51,6 +83,56 @@ CollectionFilter::CollectionFilter(QObject *parent) : QSortFilterProxyModel(pare
 
 }
 
+void CollectionFilter::UpdateSongIndex(const Song &song) {
+
+  const int id = song.id();
+  RemoveSongFromIndex(id);
+
+  QSet<quint64> trigrams;
+  AddTrigrams(song.effective_albumartist(), trigrams);
+  AddTrigrams(song.artist(), trigrams);
+  AddTrigrams(song.album(), trigrams);
+  AddTrigrams(song.title(), trigrams);
+  AddTrigrams(song.composer(), trigrams);
+  AddTrigrams(song.performer(), trigrams);
+  AddTrigrams(song.grouping(), trigrams);
+  AddTrigrams(song.genre(), trigrams);
+  AddTrigrams(song.comment(), trigrams);
+
+  for (const quint64 key : std::as_const(trigrams)) {
+    trigram_index_[key].insert(id);
+  }
+  song_trigrams_.insert(id, trigrams);
+
+  // The candidate set for the current filter string may have changed, recompute it on the next filter pass.
+  cached_filter_string_.clear();
+
+}
+
+void CollectionFilter::RemoveSongFromIndex(const int id) {
+
+  if (!song_trigrams_.contains(id)) return;
+
+  const QSet<quint64> trigrams = song_trigrams_.take(id);
+  for (const quint64 key : trigrams) {
+    QHash<quint64, QSet<int>>::iterator it = trigram_index_.find(key);
+    if (it == trigram_index_.end()) continue;
+    it.value().remove(id);
+    if (it.value().isEmpty()) trigram_index_.erase(it);
+  }
+
+  cached_filter_string_.clear();
+
+}
+
+void CollectionFilter::ClearIndex() {
+
+  trigram_index_.clear();
+  song_trigrams_.clear();
+  cached_filter_string_.clear();
+
+}
+
 bool CollectionFilter::filterAcceptsRow(const int source_row, const QModelIndex &source_parent) const {
 
   CollectionModel *model = qobject_cast<CollectionModel*>(sourceModel());
@@ -72,23 +154,47 @@ bool CollectionFilter::filterAcceptsRow(const int source_row, const QModelIndex
     return item->type == CollectionItem::Type::LoadingIndicator;
   }
 
+  // Parse the filter string and intersect the trigram index once per filter change, not once per row.
+  if (filter_string != cached_filter_string_) {
+    ParseFilterString(filter_string);
+  }
+
+  if (cached_filters_.isEmpty() && cached_filter_strings_.isEmpty()) return true;
+
+  // Songs outside the candidate set can't contain all the search tokens, skip the per-field verification.
+  if (cached_use_candidates_ && !cached_candidate_ids_.contains(item->metadata.id())) return false;
+
+  return item->metadata.is_valid() && ItemMetadataMatchesFilters(item->metadata, cached_filters_, cached_filter_strings_);
+
+}
+
+void CollectionFilter::ParseFilterString(const QString &filter_string) const {
+
+  cached_filter_string_ = filter_string;
+  cached_filters_.clear();
+  cached_filter_strings_.clear();
+  cached_candidate_ids_.clear();
+  cached_use_candidates_ = false;
+
+  QString normalized_filter_string = filter_string;
+
   for (const QString &foperator : Operators) {
-    if (filter_string.contains(foperator + QLatin1Char(' '))) {
-      filter_string = filter_string.replace(foperator + QLatin1Char(' '), foperator);
+    if (normalized_filter_string.contains(foperator + QLatin1Char(' '))) {
+      normalized_filter_string = normalized_filter_string.replace(foperator + QLatin1Char(' '), foperator);
     }
-    if (filter_string.contains(QLatin1Char(' ') + foperator)) {
-      filter_string = filter_string.replace(QLatin1Char(' ') + foperator, foperator);
+    if (normalized_filter_string.contains(QLatin1Char(' ') + foperator)) {
+      normalized_filter_string = normalized_filter_string.replace(QLatin1Char(' ') + foperator, foperator);
     }
   }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-  const QStringList tokens = filter_string.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+  const QStringList tokens = normalized_filter_string.split(QLatin1Char(' '), Qt::SkipEmptyParts);
 #else
-  const QStringList tokens = filter_string.split(QLatin1Char(' '), QString::SkipEmptyParts);
+  const QStringList tokens = normalized_filter_string.split(QLatin1Char(' '), QString::SkipEmptyParts);
 #endif
-  QStringList filter_strings;
+  QStringList &filter_strings = cached_filter_strings_;
 
-  FilterList filters;
+  FilterList &filters = cached_filters_;
   static QRegularExpression operator_regex(QStringLiteral("(=|<[>=]?|>=?|!=)"));
   for (int i = 0; i < tokens.count(); ++i) {
     const QString &token = tokens[i];
@@ -162,9 +268,25 @@ bool CollectionFilter::filterAcceptsRow(const int source_row, const QModelIndex
     filter_strings << token;
   }
 
-  if (filters.isEmpty() && filter_strings.isEmpty()) return true;
-
-  return item->metadata.is_valid() && ItemMetadataMatchesFilters(item->metadata, filters, filter_strings);
+  // Intersect the trigram ID sets of the free-text tokens into one candidate set.
+  // A song outside it can't contain all the tokens; songs inside it are still verified with substring matching.
+  if (song_trigrams_.isEmpty()) return;
+  for (const QString &token : std::as_const(cached_filter_strings_)) {
+    if (token.length() < kTrigramLength || !IsAsciiToken(token)) continue;
+    QSet<quint64> trigrams;
+    AddTrigrams(token, trigrams);
+    for (const quint64 key : std::as_const(trigrams)) {
+      const QSet<int> ids = trigram_index_.value(key);
+      if (cached_use_candidates_) {
+        cached_candidate_ids_.intersect(ids);
+      }
+      else {
+        cached_candidate_ids_ = ids;
+        cached_use_candidates_ = true;
+      }
+      if (cached_candidate_ids_.isEmpty()) return;
+    }
+  }
 
 }
 
@@ -28,6 +28,8 @@
 #include <QVariant>
 #include <QString>
 #include <QStringList>
+#include <QHash>
+#include <QSet>
 
 #include "core/song.h"
 
@@ -39,6 +41,13 @@ class CollectionFilter : public QSortFilterProxyModel {
  public:
   explicit CollectionFilter(QObject *parent = nullptr);
 
+  // Maintains the trigram index over the song's text-searchable fields.
+  // The model calls these whenever a song node is created, updated or removed,
+  // so the index follows the model incrementally instead of being rebuilt per filter change.
+  void UpdateSongIndex(const Song &song);
+  void RemoveSongFromIndex(const int id);
+  void ClearIndex();
+
  protected:
   bool filterAcceptsRow(const int source_row, const QModelIndex &source_parent) const override;
 
@@ -63,6 +72,21 @@ class CollectionFilter : public QSortFilterProxyModel {
   static bool FieldLongLongValueMatchesData(const qint64 value, const QString &foperator, const qint64 data);
   static bool FieldFloatValueMatchesData(const float value, const QString &foperator, const float data);
   static bool ContainsOperators(const QString &token);
+
+  // Re-parses the filter string into field filters and free-text tokens, and intersects the
+  // trigram index into a candidate ID set, so filterAcceptsRow() does this once per filter change instead of once per row.
+  void ParseFilterString(const QString &filter_string) const;
+
+  // Maps each trigram of the lowercased searchable text to the IDs of the songs containing it, with the reverse map used for removal and updates.
+  QHash<quint64, QSet<int>> trigram_index_;
+  QHash<int, QSet<quint64>> song_trigrams_;
+
+  // Parsed form of the current filter string, cached across filterAcceptsRow() calls.
+  mutable QString cached_filter_string_;
+  mutable FilterList cached_filters_;
+  mutable QStringList cached_filter_strings_;
+  mutable QSet<int> cached_candidate_ids_;
+  mutable bool cached_use_candidates_;
 };
 
 #endif  // COLLECTIONFILTER_H
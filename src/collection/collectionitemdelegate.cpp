@@ -22,9 +22,15 @@
 #include "config.h"
 
 #include <QtGlobal>
+#include <QApplication>
 #include <QAbstractItemModel>
 #include <QAbstractItemView>
+#include <QStyle>
 #include <QStyleOptionViewItem>
+#include <QStaticText>
+#include <QHash>
+#include <QFontMetrics>
+#include <QTransform>
 #include <QVariant>
 #include <QString>
 #include <QLocale>
@@ -47,6 +53,11 @@
 #include "collectionitemdelegate.h"
 #include "collectionmodel.h"
 
+namespace {
+// Upper bound for the text layout cache. Entries are keyed on text, width and font, so stale entries simply stop being hit when the model changes and the cache is cleared once it fills up.
+constexpr int kStaticTextCacheMaxItems = 4096;
+}  // namespace
+
 CollectionItemDelegate::CollectionItemDelegate(QObject *parent) : QStyledItemDelegate(parent) {}
 
 void CollectionItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opt, const QModelIndex &idx) const {
@@ -114,9 +125,52 @@ void CollectionItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem
     painter->restore();
   }
   else {
-    QStyledItemDelegate::paint(painter, opt, idx);
+    QStyleOptionViewItem option = opt;
+    initStyleOption(&option, idx);
+
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+
+    // Draw the background, selection and icon through the style, then draw the text from the layout cache, so scrolling does not elide and lay out the same strings on every repaint.
+    const QString text = option.text;
+    option.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &option, painter, widget);
+
+    if (text.isEmpty()) return;
+
+    const int text_margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    const QRect text_rect = style->subElementRect(QStyle::SE_ItemViewItemText, &option, widget).adjusted(text_margin, 0, -text_margin, 0);
+    if (text_rect.width() <= 0) return;
+
+    const QStaticText &static_text = CachedStaticText(option.font, text_rect.width(), text);
+
+    const QPalette::ColorGroup color_group = option.state & QStyle::State_Enabled ? (option.state & QStyle::State_Active ? QPalette::Normal : QPalette::Inactive) : QPalette::Disabled;
+
+    painter->save();
+    painter->setFont(option.font);
+    painter->setPen(option.palette.color(color_group, option.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text));
+    painter->drawStaticText(QPoint(text_rect.left(), text_rect.top() + (text_rect.height() - static_cast<int>(static_text.size().height())) / 2), static_text);
+    painter->restore();
+  }
+
+}
+
+const QStaticText &CollectionItemDelegate::CachedStaticText(const QFont &font, const int width, const QString &text) const {
+
+  const QString key = font.key() + QLatin1Char('/') + QString::number(width) + QLatin1Char('/') + text;
+
+  QHash<QString, QStaticText>::iterator i = static_text_cache_.find(key);
+  if (i == static_text_cache_.end()) {
+    if (static_text_cache_.count() >= kStaticTextCacheMaxItems) static_text_cache_.clear();
+    QStaticText static_text(QFontMetrics(font).elidedText(text, Qt::ElideRight, width));
+    static_text.setTextFormat(Qt::PlainText);
+    static_text.setPerformanceHint(QStaticText::AggressiveCaching);
+    static_text.prepare(QTransform(), font);
+    i = static_text_cache_.insert(key, static_text);
   }
 
+  return i.value();
+
 }
 
 bool CollectionItemDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &idx) {
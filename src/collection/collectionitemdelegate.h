@@ -28,6 +28,10 @@
 #include <QStyledItemDelegate>
 #include <QStyleOption>
 #include <QStyleOptionViewItem>
+#include <QStaticText>
+#include <QHash>
+#include <QString>
+#include <QFont>
 
 class QAbstractItemView;
 class QPainter;
@@ -42,6 +46,12 @@ class CollectionItemDelegate : public QStyledItemDelegate {
 
  public slots:
   bool helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &idx) override;
+
+ private:
+  // Returns the elided and laid out text for an item, creating and caching it on first use so repaints while scrolling reuse the layout.
+  const QStaticText &CachedStaticText(const QFont &font, const int width, const QString &text) const;
+
+  mutable QHash<QString, QStaticText> static_text_cache_;
 };
 
 #endif  // COLLECTIONITEMDELEGATE_H
@@ -29,7 +29,6 @@
 #include <QtGlobal>
 #include <QtConcurrent>
 #include <QThread>
-#include <QMutex>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QDataStream>
@@ -51,6 +50,7 @@
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "core/scoped_ptr.h"
 #include "core/shared_ptr.h"
@@ -60,6 +60,7 @@
 #include "core/logging.h"
 #include "core/sqlrow.h"
 #include "core/settings.h"
+#include "core/startuptimeline.h"
 #include "collectionfilteroptions.h"
 #include "collectionquery.h"
 #include "collectionbackend.h"
@@ -79,6 +80,10 @@ const int CollectionModel::kPrettyCoverSize = 32;
 namespace {
 constexpr char kPixmapDiskCacheDir[] = "pixmapcache";
 constexpr char kVariousArtists[] = QT_TR_NOOP("Various artists");
+// How long one ProcessUpdate tick may spend applying queued batches before yielding to the event loop.
+constexpr qint64 kProcessUpdatesTimeBudgetMs = 25;
+// How many rows LoadSongsFromSql reads before streaming a batch to the model.
+constexpr qsizetype kStreamedLoadBatchSize = 400;
 }  // namespace
 
 QNetworkDiskCache *CollectionModel::sIconCache = nullptr;
@@ -96,7 +101,11 @@ CollectionModel::CollectionModel(SharedPtr<CollectionBackend> backend, Applicati
       total_song_count_(0),
       total_artist_count_(0),
       total_album_count_(0),
-      loading_(false) {
+      loading_(false),
+      fresh_load_required_(true),
+      current_load_id_(0) {
+
+  const StartupTimeline::Phase phase("CollectionModel");
 
   filter_->setSourceModel(this);
   filter_->setSortRole(Role_SortText);
@@ -118,10 +127,13 @@ CollectionModel::CollectionModel(SharedPtr<CollectionBackend> backend, Applicati
     QObject::connect(app_, &Application::ClearPixmapDiskCache, this, &CollectionModel::ClearDiskCache);
   }
 
+  // Emitted from the database thread, so this is a queued connection and batches arrive in order on the model thread.
+  QObject::connect(this, &CollectionModel::SongsLoaded, this, &CollectionModel::AddStreamedSongs);
+
   QObject::connect(&*backend_, &CollectionBackend::SongsAdded, this, &CollectionModel::AddReAddOrUpdate);
   QObject::connect(&*backend_, &CollectionBackend::SongsChanged, this, &CollectionModel::AddReAddOrUpdate);
   QObject::connect(&*backend_, &CollectionBackend::SongsDeleted, this, &CollectionModel::RemoveSongs);
-  QObject::connect(&*backend_, &CollectionBackend::DatabaseReset, this, &CollectionModel::ScheduleReset);
+  QObject::connect(&*backend_, &CollectionBackend::DatabaseReset, this, &CollectionModel::ScheduleFullReset);
   QObject::connect(&*backend_, &CollectionBackend::TotalSongCountUpdated, this, &CollectionModel::TotalSongCountUpdatedSlot);
   QObject::connect(&*backend_, &CollectionBackend::TotalArtistCountUpdated, this, &CollectionModel::TotalArtistCountUpdatedSlot);
   QObject::connect(&*backend_, &CollectionBackend::TotalAlbumCountUpdated, this, &CollectionModel::TotalAlbumCountUpdatedSlot);
@@ -159,7 +171,7 @@ void CollectionModel::Init() {
 }
 
 void CollectionModel::Reset() {
-  ScheduleReset();
+  ScheduleFullReset();
 }
 
 void CollectionModel::Clear() {
@@ -169,12 +181,14 @@ void CollectionModel::Clear() {
     root_ = nullptr;
   }
   song_nodes_.clear();
+  if (filter_) filter_->ClearIndex();
   container_nodes_[0].clear();
   container_nodes_[1].clear();
   container_nodes_[2].clear();
   divider_nodes_.clear();
   pending_art_.clear();
   pending_cache_keys_.clear();
+  pending_prefetch_ids_.clear();
 
 }
 
@@ -195,6 +209,10 @@ void CollectionModel::EndReset() {
 
 void CollectionModel::Reload() {
 
+  // A pure regroup (same filter, same song set) can rebuild the tree from the songs already in memory, skipping the database round trip.
+  // Pending updates haven't reached song_nodes_ yet, so they force a fresh query.
+  const bool reuse_songs = !fresh_load_required_ && updates_.isEmpty() && !song_nodes_.isEmpty();
+
   loading_ = true;
   if (timer_reload_->isActive()) {
     timer_reload_->stop();
@@ -203,6 +221,22 @@ void CollectionModel::Reload() {
 
   options_active_ = options_current_;
 
+  if (reuse_songs) {
+    SongList songs;
+    songs.reserve(song_nodes_.count());
+    for (CollectionItem *node : std::as_const(song_nodes_)) {
+      songs << node->metadata;
+    }
+    BeginReset();
+    ScheduleAddSongs(songs);
+    EndReset();
+    loading_ = false;
+    if (!updates_.isEmpty() && !timer_update_->isActive()) {
+      timer_update_->start();
+    }
+    return;
+  }
+
   BeginReset();
   // Show a loading indicator in the model.
   CollectionItem *loading = new CollectionItem(CollectionItem::Type::LoadingIndicator, root_);
@@ -221,6 +255,13 @@ void CollectionModel::ScheduleReset() {
 
 }
 
+void CollectionModel::ScheduleFullReset() {
+
+  fresh_load_required_ = true;
+  ScheduleReset();
+
+}
+
 void CollectionModel::ReloadSettings() {
 
   Settings settings;
@@ -274,7 +315,7 @@ void CollectionModel::SetFilterMode(const CollectionFilterOptions::FilterMode fi
 
   if (options_current_.filter_options.filter_mode() != filter_mode) {
     options_current_.filter_options.set_filter_mode(filter_mode);
-    ScheduleReset();
+    ScheduleFullReset();
   }
 
 }
@@ -283,7 +324,7 @@ void CollectionModel::SetFilterMaxAge(const int filter_max_age) {
 
   if (options_current_.filter_options.max_age() != filter_max_age) {
     options_current_.filter_options.set_max_age(filter_max_age);
-    ScheduleReset();
+    ScheduleFullReset();
   }
 
 }
@@ -420,6 +461,8 @@ QMimeData *CollectionModel::mimeData(const QModelIndexList &indexes) const {
     GetChildSongs(IndexToItem(idx), &urls, &data->songs, &song_ids);
   }
 
+  data->songs = HydrateSongs(data->songs);
+
   data->setUrls(urls);
   data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->songs);
 
@@ -478,75 +521,108 @@ void CollectionModel::ProcessUpdate() {
     return;
   }
 
-  const CollectionModelUpdate update = updates_.dequeue();
+  // Process as many queued batches as fit in the time budget, so large rebuilds finish quickly while the UI still gets to breathe between ticks.
+  QElapsedTimer elapsed_timer;
+  elapsed_timer.start();
+
+  do {
+    const CollectionModelUpdate update = updates_.dequeue();
+
+    switch (update.type) {
+      case CollectionModelUpdate::Type::AddReAddOrUpdate:
+        AddReAddOrUpdateSongsInternal(update.songs);
+        break;
+      case CollectionModelUpdate::Type::Add:
+        AddSongsInternal(update.songs);
+        break;
+      case CollectionModelUpdate::Type::Update:
+        UpdateSongsInternal(update.songs);
+        break;
+      case CollectionModelUpdate::Type::Remove:
+        RemoveSongsInternal(update.songs);
+        break;
+    }
+  } while (!updates_.isEmpty() && !loading_ && elapsed_timer.elapsed() < kProcessUpdatesTimeBudgetMs);
 
   if (updates_.isEmpty()) {
     timer_update_->stop();
   }
 
-  switch (update.type) {
-    case CollectionModelUpdate::Type::AddReAddOrUpdate:
-      AddReAddOrUpdateSongsInternal(update.songs);
-      break;
-    case CollectionModelUpdate::Type::Add:
-      AddSongsInternal(update.songs);
-      break;
-    case CollectionModelUpdate::Type::Update:
-      UpdateSongsInternal(update.songs);
-      break;
-    case CollectionModelUpdate::Type::Remove:
-      RemoveSongsInternal(update.songs);
-      break;
-  }
-
 }
 
 void CollectionModel::AddReAddOrUpdateSongsInternal(const SongList &songs) {
 
   if (loading_) return;
 
-  SongList songs_added;
-  SongList songs_removed;
-  SongList songs_updated;
+  // Snapshot the old metadata for the affected ids on the UI thread,
+  // then compute the diff off the UI thread so the view stays responsive while a scan streams in changes.
+  QHash<int, Song> old_songs;
+  old_songs.reserve(songs.count());
+  for (const Song &new_song : songs) {
+    if (song_nodes_.contains(new_song.id())) {
+      old_songs.insert(new_song.id(), song_nodes_[new_song.id()]->metadata);
+    }
+  }
+
+  QFuture<UpdateClassification> future = QtConcurrent::run(&CollectionModel::ClassifySongsForUpdate, songs, old_songs, options_active_);
+  QFutureWatcher<UpdateClassification> *watcher = new QFutureWatcher<UpdateClassification>();
+  QObject::connect(watcher, &QFutureWatcher<void>::finished, this, &CollectionModel::AddReAddOrUpdateSongsClassified);
+  watcher->setFuture(future);
+
+}
+
+CollectionModel::UpdateClassification CollectionModel::ClassifySongsForUpdate(const SongList &songs, const QHash<int, Song> &old_songs, const Options &options) {
+
+  UpdateClassification classification;
 
   for (const Song &new_song : songs) {
-    if (!song_nodes_.contains(new_song.id())) {
-      songs_added << new_song;
+    if (!old_songs.contains(new_song.id())) {
+      classification.added << new_song;
       continue;
     }
-    const Song &old_song = song_nodes_[new_song.id()]->metadata;
+    const Song &old_song = old_songs[new_song.id()];
     bool container_key_changed = false;
     bool has_unique_album_identifier_1 = false;
     bool has_unique_album_identifier_2 = false;
     for (int i = 0; i < 3; ++i) {
-      const GroupBy group_by = options_active_.group_by[i];
+      const GroupBy group_by = options.group_by[i];
       if (group_by == GroupBy::None) break;
-      if (options_active_.show_various_artists && IsArtistGroupBy(group_by) && (new_song.is_compilation() || old_song.is_compilation())) {
+      if (options.show_various_artists && IsArtistGroupBy(group_by) && (new_song.is_compilation() || old_song.is_compilation())) {
         has_unique_album_identifier_1 = true;
         has_unique_album_identifier_2 = true;
         if (new_song.is_compilation() != old_song.is_compilation()) {
           container_key_changed = true;
         }
       }
-      else if (ContainerKey(group_by, new_song, has_unique_album_identifier_1) != ContainerKey(group_by, old_song, has_unique_album_identifier_2)) {
+      else if (ContainerKey(group_by, new_song, has_unique_album_identifier_1, options.separate_albums_by_grouping) != ContainerKey(group_by, old_song, has_unique_album_identifier_2, options.separate_albums_by_grouping)) {
         container_key_changed = true;
       }
     }
 
     if (container_key_changed) {
       qLog(Debug) << "Container key for" << new_song.id() << new_song.PrettyTitleWithArtist() << "is changed, re-adding song.";
-      songs_removed << old_song;
-      songs_added << new_song;
+      classification.removed << old_song;
+      classification.added << new_song;
     }
     else {
       qLog(Debug) << "Container key for" << new_song.id() << new_song.PrettyTitleWithArtist() << "is uchanged, only updating song metadata.";
-      songs_updated << new_song;
+      classification.updated << new_song;
     }
   }
 
-  ScheduleRemoveSongs(songs_removed);
-  ScheduleUpdateSongs(songs_updated);
-  ScheduleAddSongs(songs_added);
+  return classification;
+
+}
+
+void CollectionModel::AddReAddOrUpdateSongsClassified() {
+
+  QFutureWatcher<UpdateClassification> *watcher = static_cast<QFutureWatcher<UpdateClassification>*>(sender());
+  const UpdateClassification classification = watcher->result();
+  watcher->deleteLater();
+
+  ScheduleRemoveSongs(classification.removed);
+  ScheduleUpdateSongs(classification.updated);
+  ScheduleAddSongs(classification.added);
 
 }
 
@@ -611,6 +687,7 @@ void CollectionModel::UpdateSongsInternal(const SongList &songs) {
     const bool song_title_data_changed = IsSongTitleDataChanged(old_song, new_song);
     const bool art_changed = !old_song.IsArtEqual(new_song);
     SetSongItemData(item, new_song);
+    filter_->UpdateSongIndex(new_song);
     if (art_changed) {
       for (CollectionItem *parent = item->parent; parent != root_; parent = parent->parent) {
         if (IsAlbumGroupBy(options_active_.group_by[parent->container_level])) {
@@ -655,6 +732,7 @@ void CollectionModel::RemoveSongsInternal(const SongList &songs) {
       beginRemoveRows(ItemToIndex(node->parent), node->row, node->row);
       node->parent->Delete(node->row);
       song_nodes_.remove(song.id());
+      filter_->RemoveSongFromIndex(song.id());
       endRemoveRows();
 
     }
@@ -767,6 +845,7 @@ void CollectionModel::CreateSongItem(const Song &song, CollectionItem *parent) {
   CollectionItem *item = new CollectionItem(CollectionItem::Type::Song, parent);
   SetSongItemData(item, song);
   song_nodes_.insert(song.id(), item);
+  filter_->UpdateSongIndex(song);
 
   endInsertRows();
 
@@ -808,31 +887,45 @@ CollectionItem *CollectionModel::CreateCompilationArtistNode(CollectionItem *par
 
 void CollectionModel::LoadSongsFromSqlAsync() {
 
+  const int load_id = ++current_load_id_;
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  QFuture<SongList> future = QtConcurrent::run(&CollectionModel::LoadSongsFromSql, this, options_active_.filter_options);
+  QFuture<void> future = QtConcurrent::run(&CollectionModel::LoadSongsFromSql, this, options_active_.filter_options, load_id);
 #else
-  QFuture<SongList> future = QtConcurrent::run(this, &CollectionModel::LoadSongsFromSql, options_active_.filter_options);
+  QFuture<void> future = QtConcurrent::run(this, &CollectionModel::LoadSongsFromSql, options_active_.filter_options, load_id);
 #endif
-  QFutureWatcher<SongList> *watcher = new QFutureWatcher<SongList>();
-  QObject::connect(watcher, &QFutureWatcher<void>::finished, this, &CollectionModel::LoadSongsFromSqlAsyncFinished);
+  QFutureWatcher<void> *watcher = new QFutureWatcher<void>();
+  QObject::connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, load_id]() {
+    watcher->deleteLater();
+    LoadSongsFromSqlFinished(load_id);
+  });
   watcher->setFuture(future);
 
 }
 
-SongList CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter_options) {
-
-  SongList songs;
+void CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter_options, const int load_id) {
 
   {
-    QMutexLocker l(backend_->db()->Mutex());
-    QSqlDatabase db(backend_->db()->Connect());
+    // Read-only snapshot connection, so the model reload doesn't queue behind a running scan transaction.
+    QSqlDatabase db(backend_->db()->ConnectRead());
     CollectionQuery q(db, backend_->songs_table(), filter_options);
-    q.SetColumnSpec(QStringLiteral("%songs_table.ROWID, ") + Song::kColumnSpec);
+    // Only hydrate the columns the model needs for grouping and display, full songs are re-queried by id when they leave the model.
+    q.SetColumnSpec(QStringLiteral("%songs_table.ROWID, ") + Song::kProjectionColumnSpec);
     if (q.Exec()) {
+      // Stream batches to the model as rows are read, so the first artists show up long before the query finishes.
+      SongList songs;
+      songs.reserve(kStreamedLoadBatchSize);
       while (q.Next()) {
         Song song;
-        song.InitFromQuery(q, true);
+        song.InitFromProjectionQuery(q, true);
         songs << song;
+        if (songs.count() >= kStreamedLoadBatchSize) {
+          emit SongsLoaded(load_id, songs);
+          songs.clear();
+        }
+      }
+      if (!songs.isEmpty()) {
+        emit SongsLoaded(load_id, songs);
       }
     }
     else {
@@ -844,21 +937,35 @@ SongList CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter
     backend_->db()->Close();
   }
 
-  return songs;
-
 }
 
-void CollectionModel::LoadSongsFromSqlAsyncFinished() {
+void CollectionModel::AddStreamedSongs(const int load_id, const SongList &songs) {
 
-  QFutureWatcher<SongList> *watcher = static_cast<QFutureWatcher<SongList>*>(sender());
-  const SongList songs = watcher->result();
-  watcher->deleteLater();
+  if (load_id != current_load_id_) return;  // From a query a newer reload superseded
+
+  if (loading_) {
+    // First batch: replace the loading indicator with the empty tree the batches fill in.
+    BeginReset();
+    EndReset();
+    loading_ = false;
+  }
 
-  BeginReset();
   ScheduleAddSongs(songs);
-  EndReset();
 
-  loading_ = false;
+}
+
+void CollectionModel::LoadSongsFromSqlFinished(const int load_id) {
+
+  if (load_id != current_load_id_) return;
+
+  if (loading_) {
+    // The query returned no rows, so no batch cleared the loading indicator.
+    BeginReset();
+    EndReset();
+    loading_ = false;
+  }
+
+  fresh_load_required_ = false;
 
   if (!updates_.isEmpty() && !timer_update_->isActive()) {
     timer_update_->start();
@@ -900,7 +1007,7 @@ void CollectionModel::ClearItemPixmapCache(CollectionItem *item) {
 
 }
 
-QVariant CollectionModel::AlbumIcon(const QModelIndex &idx) {
+QVariant CollectionModel::AlbumIcon(const QModelIndex &idx, const bool prefetch) {
 
   CollectionItem *item = IndexToItem(idx);
   if (!item) return pixmap_no_cover_;
@@ -936,19 +1043,67 @@ QVariant CollectionModel::AlbumIcon(const QModelIndex &idx) {
     AlbumCoverLoaderOptions cover_loader_options(AlbumCoverLoaderOptions::Option::ScaledImage | AlbumCoverLoaderOptions::Option::PadScaledImage);
     cover_loader_options.desired_scaled_size = QSize(kPrettyCoverSize, kPrettyCoverSize);
     cover_loader_options.types = cover_types_;
+    cover_loader_options.low_priority = prefetch;
     const quint64 id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options, songs.first());
     pending_art_[id] = ItemAndCacheKey(item, cache_key);
     pending_cache_keys_.insert(cache_key);
+    if (prefetch) pending_prefetch_ids_.insert(id);
   }
 
   return pixmap_no_cover_;
 
 }
 
+void CollectionModel::PrefetchAlbumCovers(const QModelIndexList &indexes) {
+
+  if (!options_active_.show_pretty_covers) return;
+
+  for (const QModelIndex &idx : indexes) {
+    if (!idx.isValid()) continue;
+    const CollectionItem *item = IndexToItem(idx);
+    if (!item || item->type != CollectionItem::Type::Container) continue;
+    if (!IsAlbumGroupBy(options_active_.group_by[item->container_level])) continue;
+    AlbumIcon(idx, true);
+  }
+
+}
+
+void CollectionModel::PrefetchChildAlbumCovers(const QModelIndex &parent) {
+
+  if (!options_active_.show_pretty_covers) return;
+
+  const int rows = rowCount(parent);
+  QModelIndexList indexes;
+  indexes.reserve(rows);
+  for (int i = 0; i < rows; ++i) {
+    indexes << index(i, 0, parent);
+  }
+  PrefetchAlbumCovers(indexes);
+
+}
+
+void CollectionModel::CancelAlbumCoverPrefetch() {
+
+  if (pending_prefetch_ids_.isEmpty()) return;
+
+  app_->album_cover_loader()->CancelTasks(pending_prefetch_ids_);
+
+  for (const quint64 id : std::as_const(pending_prefetch_ids_)) {
+    if (pending_art_.contains(id)) {
+      const ItemAndCacheKey item_and_cache_key = pending_art_.take(id);
+      pending_cache_keys_.remove(item_and_cache_key.second);
+    }
+  }
+  pending_prefetch_ids_.clear();
+
+}
+
 void CollectionModel::AlbumCoverLoaded(const quint64 id, const AlbumCoverLoaderResult &result) {
 
   if (!pending_art_.contains(id)) return;
 
+  pending_prefetch_ids_.remove(id);
+
   ItemAndCacheKey item_and_cache_key = pending_art_.take(id);
   CollectionItem *item = item_and_cache_key.first;
   if (!item) return;
@@ -1227,6 +1382,12 @@ bool CollectionModel::IsSongTitleDataChanged(const Song &song1, const Song &song
 
 QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier) const {
 
+  return ContainerKey(group_by, song, has_unique_album_identifier, options_active_.separate_albums_by_grouping);
+
+}
+
+QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier, const bool separate_albums_by_grouping) {
+
   QString key;
 
   switch (group_by) {
@@ -1241,32 +1402,32 @@ QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song,
     case GroupBy::Album:
       key = TextOrUnknown(song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::AlbumDisc:
       key = PrettyAlbumDisc(song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::YearAlbum:
       key = PrettyYearAlbum(song.year(), song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::YearAlbumDisc:
       key = PrettyYearAlbumDisc(song.year(), song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::OriginalYearAlbum:
       key = PrettyYearAlbum(song.effective_originalyear(), song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::OriginalYearAlbumDisc:
       key = PrettyYearAlbumDisc(song.effective_originalyear(), song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::Disc:
       key = PrettyDisc(song.disc());
@@ -1493,6 +1654,40 @@ SongList CollectionModel::GetChildSongs(const QModelIndexList &indexes) const {
   for (const QModelIndex &idx : indexes) {
     GetChildSongs(IndexToItem(idx), &dontcare, &ret, &song_ids);
   }
+  return HydrateSongs(ret);
+
+}
+
+SongList CollectionModel::HydrateSongs(const SongList &songs) const {
+
+  // The model only keeps the projected columns in memory,
+  // re-query the full rows by id so all metadata travels with the songs when they leave the model.
+
+  QList<int> ids;
+  ids.reserve(songs.count());
+  for (const Song &song : songs) {
+    if (song.id() == -1) return songs;
+    ids << song.id();
+  }
+  if (ids.isEmpty()) return songs;
+
+  const SongList full_songs = backend_->GetSongsById(ids);
+  QMap<int, Song> songs_by_id;
+  for (const Song &song : full_songs) {
+    songs_by_id.insert(song.id(), song);
+  }
+
+  SongList ret;
+  ret.reserve(songs.count());
+  for (const Song &song : songs) {
+    if (songs_by_id.contains(song.id())) {
+      ret << songs_by_id[song.id()];
+    }
+    else {
+      ret << song;
+    }
+  }
+
   return ret;
 
 }
@@ -192,14 +192,32 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   static QString SortTextForBitrate(const int bitrate);
   static bool IsSongTitleDataChanged(const Song &song1, const Song &song2);
   QString ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier) const;
+  static QString ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier, const bool separate_albums_by_grouping);
+
+  // Result of classifying a batch of changed songs into model operations, computed off the UI thread.
+  struct UpdateClassification {
+    SongList added;
+    SongList updated;
+    SongList removed;
+  };
+  static UpdateClassification ClassifySongsForUpdate(const SongList &songs, const QHash<int, Song> &old_songs, const Options &options);
 
   // Get information about the collection
   void GetChildSongs(CollectionItem *item, QList<QUrl> *urls, SongList *songs, QSet<int> *song_ids) const;
+  // Re-queries full song rows by id, since the model itself only keeps the projected column subset.
+  SongList HydrateSongs(const SongList &songs) const;
   SongList GetChildSongs(const QModelIndex &idx) const;
   SongList GetChildSongs(const QModelIndexList &indexes) const;
 
   void ExpandAll(CollectionItem *item = nullptr) const;
 
+  // Starts low priority cover loads for album nodes that are not cached yet, used by the view to warm the cache for rows just outside the viewport.
+  void PrefetchAlbumCovers(const QModelIndexList &indexes);
+  // Queues one batch of low priority cover loads for all album children of an expanded container, instead of one load per album as each row is painted.
+  void PrefetchChildAlbumCovers(const QModelIndex &parent);
+  // Cancels prefetch loads that have not started yet, called when the view scrolls away from the prefetched range.
+  void CancelAlbumCoverPrefetch();
+
  signals:
   void TotalSongCountUpdated(const int count);
   void TotalArtistCountUpdated(const int count);
@@ -207,6 +225,8 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   void GroupingChanged(const CollectionModel::Grouping g, const bool separate_albums_by_grouping);
   void SongsAdded(const SongList &songs);
   void SongsRemoved(const SongList &songs);
+  // Emitted from the database thread as LoadSongsFromSql reads rows, so the tree fills in progressively instead of after the full query.
+  void SongsLoaded(const int load_id, const SongList &songs);
 
  public slots:
   void SetFilterMode(const CollectionFilterOptions::FilterMode filter_mode);
@@ -239,7 +259,8 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   CollectionItem *CreateCompilationArtistNode(CollectionItem *parent);
 
   void LoadSongsFromSqlAsync();
-  SongList LoadSongsFromSql(const CollectionFilterOptions &filter_options = CollectionFilterOptions());
+  void LoadSongsFromSql(const CollectionFilterOptions &filter_options, const int load_id);
+  void LoadSongsFromSqlFinished(const int load_id);
 
   static QString DividerKey(const GroupBy group_by, const Song &song, const QString &sort_text);
   static QString DividerDisplayText(const GroupBy group_by, const QString &key);
@@ -248,16 +269,18 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   static bool IsCompilationArtistNode(const CollectionItem *node) { return node == node->parent->compilation_artist_node_; }
   QString AlbumIconPixmapCacheKey(const QModelIndex &idx) const;
   static QUrl AlbumIconPixmapDiskCacheKey(const QString &cache_key);
-  QVariant AlbumIcon(const QModelIndex &idx);
+  QVariant AlbumIcon(const QModelIndex &idx, const bool prefetch = false);
   void ClearItemPixmapCache(CollectionItem *item);
   bool CompareItems(const CollectionItem *a, const CollectionItem *b) const;
   static qint64 MaximumCacheSize(Settings *s, const char *size_id, const char *size_unit_id, const qint64 cache_size_default);
 
  private slots:
+  void AddReAddOrUpdateSongsClassified();
   void Reload();
   void ScheduleReset();
+  void ScheduleFullReset();
   void ProcessUpdate();
-  void LoadSongsFromSqlAsyncFinished();
+  void AddStreamedSongs(const int load_id, const SongList &songs);
   void AlbumCoverLoaded(const quint64 id, const AlbumCoverLoaderResult &result);
 
   // From CollectionBackend
@@ -294,6 +317,12 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
 
   bool loading_;
 
+  // Whether the next reload has to re-query the database, or can regroup the songs already held in song_nodes_.
+  bool fresh_load_required_;
+
+  // Incremented per reload; batches streamed by a superseded query are dropped.
+  int current_load_id_;
+
   QQueue<CollectionModelUpdate> updates_;
 
   // Keyed on database ID
@@ -308,6 +337,8 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   using ItemAndCacheKey = QPair<CollectionItem*, QString>;
   QMap<quint64, ItemAndCacheKey> pending_art_;
   QSet<QString> pending_cache_keys_;
+  // Cover loads started by PrefetchAlbumCovers, so they can be canceled when the view scrolls away.
+  QSet<quint64> pending_prefetch_ids_;
 };
 
 Q_DECLARE_METATYPE(CollectionModel::Grouping)
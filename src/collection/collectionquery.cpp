@@ -57,6 +57,51 @@ CollectionQuery::CollectionQuery(const QSqlDatabase &db, const QString &songs_ta
     where_clauses_ << QStringLiteral("(artist = '' OR album = '' OR title ='')");
   }
 
+  if (!filter_options.filter_text().isEmpty()) {
+    AddTextFilter(filter_options.filter_text());
+  }
+
+}
+
+void CollectionQuery::AddTextFilter(const QString &filter_text) {
+
+  static const QRegularExpression regex_whitespace(QStringLiteral("\\s+"));
+  const QStringList tokens = filter_text.split(regex_whitespace, Qt::SkipEmptyParts);
+  if (tokens.isEmpty()) return;
+
+  if (songs_table_ == QLatin1String("songs")) {
+    // The songs table has a FTS5 index, use a prefix match per token instead of LIKE '%text%' which forces a full table scan.
+    QStringList match_tokens;
+    match_tokens.reserve(tokens.count());
+    for (QString token : tokens) {
+      token.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+      match_tokens << QLatin1Char('"') + token + QStringLiteral("\"*");
+    }
+    where_clauses_ << QStringLiteral("ROWID IN (SELECT rowid FROM songs_fts WHERE songs_fts MATCH ?)");
+    bound_values_ << match_tokens.join(QLatin1Char(' '));
+  }
+  else {
+    // Song tables for other sources have no FTS index, fall back to LIKE filters.
+    static const QStringList text_columns = QStringList() << QStringLiteral("title")
+                                                          << QStringLiteral("album")
+                                                          << QStringLiteral("artist")
+                                                          << QStringLiteral("albumartist")
+                                                          << QStringLiteral("composer")
+                                                          << QStringLiteral("performer")
+                                                          << QStringLiteral("grouping")
+                                                          << QStringLiteral("genre")
+                                                          << QStringLiteral("comment");
+    for (const QString &token : tokens) {
+      QStringList column_clauses;
+      column_clauses.reserve(text_columns.count());
+      for (const QString &column : text_columns) {
+        column_clauses << QStringLiteral("%1 LIKE ?").arg(column);
+        bound_values_ << QStringLiteral("%%1%").arg(token);
+      }
+      where_clauses_ << QLatin1Char('(') + column_clauses.join(QLatin1String(" OR ")) + QLatin1Char(')');
+    }
+  }
+
 }
 
 void CollectionQuery::AddWhere(const QString &column, const QVariant &value, const QString &op) {
@@ -107,8 +152,9 @@ void CollectionQuery::AddCompilationRequirement(const bool compilation) {
 }
 
 QString CollectionQuery::GetInnerQuery() const {
+  // Join the view directly (no subselect wrapper), so the planner can flatten it and answer both the grouping and the join from idx_artist_album_title.
   return duplicates_only_
-             ? QStringLiteral(" INNER JOIN (select * from duplicated_songs) dsongs        "
+             ? QStringLiteral(" INNER JOIN duplicated_songs dsongs        "
                    "ON (%songs_table.artist = dsongs.dup_artist       "
                    "AND %songs_table.album = dsongs.dup_album     "
                    "AND %songs_table.title = dsongs.dup_title)    ")
@@ -66,6 +66,9 @@ class CollectionQuery : public SqlQuery {
   // Please note that IN operator expects a QStringList as value.
   void AddWhere(const QString &column, const QVariant &value, const QString &op = QStringLiteral("="));
 
+  // Adds a free text filter. Uses the FTS5 index on the songs table when available, otherwise falls back to LIKE filters.
+  void AddTextFilter(const QString &filter_text);
+
   void SetBoundValues(const QVariantList &bound_values) { bound_values_ = bound_values; }
   void SetDuplicatesOnly(const bool duplicates_only) { duplicates_only_ = duplicates_only; }
   void SetIncludeUnavailable(const bool include_unavailable) { include_unavailable_ = include_unavailable; }
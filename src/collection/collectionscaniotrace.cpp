@@ -0,0 +1,171 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStorageInfo>
+#include <QString>
+
+#include "core/logging.h"
+
+#include "collectionscaniotrace.h"
+
+namespace {
+
+// Directories beyond this are folded into their filesystem totals only, so the profile stays readable on large libraries.
+constexpr int kMaxDirectoriesInProfile = 25;
+
+struct OpStats {
+  qint64 count = 0;
+  qint64 total_nsecs = 0;
+  qint64 max_nsecs = 0;
+  void Add(const qint64 nsecs) {
+    ++count;
+    total_nsecs += nsecs;
+    max_nsecs = qMax(max_nsecs, nsecs);
+  }
+  void Add(const OpStats &other) {
+    count += other.count;
+    total_nsecs += other.total_nsecs;
+    max_nsecs = qMax(max_nsecs, other.max_nsecs);
+  }
+};
+
+struct DirStats {
+  OpStats list;
+  OpStats stat;
+  OpStats tag_read;
+  qint64 TotalNsecs() const { return list.total_nsecs + stat.total_nsecs + tag_read.total_nsecs; }
+};
+
+QMutex sMutex;
+QHash<QString, DirStats> sDirStats;
+QHash<QString, QString> sFilesystemCache;
+QElapsedTimer sScanTimer;
+
+// Resolves the mount point a directory lives on, cached because QStorageInfo itself stats the path.
+QString FilesystemForDir(const QString &dir) {
+
+  if (sFilesystemCache.contains(dir)) return sFilesystemCache[dir];
+  QString root = QStorageInfo(dir).rootPath();
+  if (root.isEmpty()) root = QStringLiteral("unknown");
+  sFilesystemCache.insert(dir, root);
+  return root;
+
+}
+
+QString FormatStats(const OpStats &stats) {
+
+  if (stats.count == 0) return QStringLiteral("-");
+  return QStringLiteral("%1x %2ms avg %3us max %4us")
+      .arg(stats.count)
+      .arg(stats.total_nsecs / 1000000)
+      .arg(stats.total_nsecs / stats.count / 1000)
+      .arg(stats.max_nsecs / 1000);
+
+}
+
+}  // namespace
+
+bool ScanIOTrace::Enabled() {
+
+  static const bool enabled = qEnvironmentVariableIsSet("STRAWBERRY_SCAN_IO_TRACE");
+  return enabled;
+
+}
+
+void ScanIOTrace::BeginScan() {
+
+  if (!Enabled()) return;
+
+  QMutexLocker locker(&sMutex);
+  sDirStats.clear();
+  sScanTimer.start();
+
+}
+
+void ScanIOTrace::Record(const Op op, const QString &path, const qint64 nsecs) {
+
+  const QString dir = op == Op::List ? path : path.left(path.lastIndexOf(QLatin1Char('/')));
+
+  QMutexLocker locker(&sMutex);
+  DirStats &stats = sDirStats[dir];
+  switch (op) {
+    case Op::List:
+      stats.list.Add(nsecs);
+      break;
+    case Op::Stat:
+      stats.stat.Add(nsecs);
+      break;
+    case Op::TagRead:
+      stats.tag_read.Add(nsecs);
+      break;
+  }
+
+}
+
+void ScanIOTrace::EndScan() {
+
+  if (!Enabled()) return;
+
+  QMutexLocker locker(&sMutex);
+
+  if (sDirStats.isEmpty()) return;
+
+  QHash<QString, DirStats> fs_stats;
+  QList<QString> dirs = sDirStats.keys();
+  for (const QString &dir : std::as_const(dirs)) {
+    const DirStats &stats = sDirStats[dir];
+    DirStats &fs = fs_stats[FilesystemForDir(dir)];
+    fs.list.Add(stats.list);
+    fs.stat.Add(stats.stat);
+    fs.tag_read.Add(stats.tag_read);
+  }
+
+  qLog(Info) << "Scan I/O profile:" << sScanTimer.elapsed() << "ms wall," << dirs.count() << "directories";
+
+  QList<QString> filesystems = fs_stats.keys();
+  std::sort(filesystems.begin(), filesystems.end(), [&fs_stats](const QString &a, const QString &b) { return fs_stats[a].TotalNsecs() > fs_stats[b].TotalNsecs(); });
+  for (const QString &fs : std::as_const(filesystems)) {
+    const DirStats &stats = fs_stats[fs];
+    qLog(Info) << "Filesystem" << fs << "- list:" << FormatStats(stats.list) << "stat:" << FormatStats(stats.stat) << "tags:" << FormatStats(stats.tag_read);
+  }
+
+  std::sort(dirs.begin(), dirs.end(), [](const QString &a, const QString &b) { return sDirStats[a].TotalNsecs() > sDirStats[b].TotalNsecs(); });
+  const int count = qMin(static_cast<int>(dirs.count()), kMaxDirectoriesInProfile);
+  for (int i = 0; i < count; ++i) {
+    const DirStats &stats = sDirStats[dirs[i]];
+    qLog(Info) << "Directory" << dirs[i] << "- list:" << FormatStats(stats.list) << "stat:" << FormatStats(stats.stat) << "tags:" << FormatStats(stats.tag_read);
+  }
+  if (dirs.count() > count) {
+    qLog(Info) << "..." << (dirs.count() - count) << "more directories omitted";
+  }
+
+  sDirStats.clear();
+  sFilesystemCache.clear();
+
+}
@@ -0,0 +1,55 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COLLECTIONSCANIOTRACE_H
+#define COLLECTIONSCANIOTRACE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+
+// Opt-in I/O trace for collection scans, enabled with the STRAWBERRY_SCAN_IO_TRACE environment variable.
+// The watcher records per-file listing, stat and tag-read timings while a scan runs,
+// and EndScan() dumps a profile aggregated by directory and by filesystem to the log.
+// The per-directory breakdown separates metadata-latency-bound scans (stat/listing dominated, typical for NAS)
+// from throughput-bound ones (tag-read dominated), which is what the scan parallelism should be tuned against.
+// All methods are thread safe, samples arrive from the scan thread pool.
+class ScanIOTrace {
+ public:
+  enum class Op {
+    List,     // Directory listing including the per-child stats done while iterating.
+    Stat,     // Standalone file stats (mtime checks against the database).
+    TagRead,  // Tag extraction, measured from the watcher side so it includes the tag reader IPC round trip.
+  };
+
+  // Cheap enough to call per file, reads the environment once.
+  static bool Enabled();
+
+  // Clears the aggregates and starts the scan wall clock.
+  static void BeginScan();
+
+  // Records one operation of nsecs nanoseconds against the directory containing path.
+  static void Record(const Op op, const QString &path, const qint64 nsecs);
+
+  // Logs the profile if any samples were recorded.
+  static void EndScan();
+};
+
+#endif  // COLLECTIONSCANIOTRACE_H
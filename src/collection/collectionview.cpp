@@ -45,7 +45,9 @@
 #include <QMenu>
 #include <QAction>
 #include <QMessageBox>
+#include <QScrollBar>
 #include <QSettings>
+#include <QTimer>
 #include <QtEvents>
 
 #include "core/application.h"
@@ -55,6 +57,7 @@
 #include "core/deletefiles.h"
 #include "core/settings.h"
 #include "utilities/filemanagerutils.h"
+#include "widgets/debugoverlay.h"
 #include "collection.h"
 #include "collectionbackend.h"
 #include "collectiondirectorymodel.h"
@@ -75,6 +78,13 @@
 
 using std::make_unique;
 
+namespace {
+// How long scrolling has to settle before covers outside the viewport are prefetched.
+constexpr int kPrefetchDelayMs = 250;
+// How many rows above and below the viewport to prefetch covers for.
+constexpr int kPrefetchRows = 25;
+}  // namespace
+
 CollectionView::CollectionView(QWidget *parent)
     : AutoExpandingTreeView(parent),
       app_(nullptr),
@@ -83,6 +93,7 @@ CollectionView::CollectionView(QWidget *parent)
       total_artist_count_(-1),
       total_album_count_(-1),
       nomusic_(QStringLiteral(":/pictures/nomusic.png")),
+      prefetch_timer_(new QTimer(this)),
       context_menu_(nullptr),
       action_load_(nullptr),
       action_add_to_playlist_(nullptr),
@@ -114,6 +125,13 @@ CollectionView::CollectionView(QWidget *parent)
 
   setStyleSheet(QStringLiteral("QTreeView::item{padding-top:1px;}"));
 
+  prefetch_timer_->setSingleShot(true);
+  prefetch_timer_->setInterval(kPrefetchDelayMs);
+  QObject::connect(prefetch_timer_, &QTimer::timeout, this, &CollectionView::PrefetchCovers);
+  QObject::connect(verticalScrollBar(), &QScrollBar::valueChanged, prefetch_timer_, qOverload<>(&QTimer::start));
+  QObject::connect(this, &CollectionView::expanded, this, &CollectionView::ContainerExpanded);
+  QObject::connect(this, &CollectionView::collapsed, prefetch_timer_, qOverload<>(&QTimer::start));
+
 }
 
 CollectionView::~CollectionView() = default;
@@ -313,6 +331,8 @@ void CollectionView::TotalAlbumCountUpdated(const int count) {
 
 void CollectionView::paintEvent(QPaintEvent *event) {
 
+  ScopedPaintTimer paint_timer("CollectionView");
+
   if (total_song_count_ == 0) {
     QPainter p(viewport());
     QRect rect(viewport()->rect());
@@ -835,3 +855,49 @@ void CollectionView::DeleteFilesFinished(const SongList &songs_with_errors) {
   // It deletes itself when the user closes it
 
 }
+
+void CollectionView::PrefetchCovers() {
+
+  if (!app_ || !model()) return;
+
+  QSortFilterProxyModel *proxy_model = qobject_cast<QSortFilterProxyModel*>(model());
+  if (!proxy_model) return;
+  CollectionModel *collection_model = qobject_cast<CollectionModel*>(proxy_model->sourceModel());
+  if (!collection_model) return;
+
+  // Whatever was queued for the previous range is stale now.
+  collection_model->CancelAlbumCoverPrefetch();
+
+  const QModelIndex first_visible = indexAt(viewport()->rect().topLeft());
+  if (!first_visible.isValid()) return;
+
+  // Collect the rows just outside the viewport on both sides, nearest rows first.
+  QModelIndexList indexes;
+  QModelIndex idx = indexAt(viewport()->rect().bottomLeft());
+  for (int i = 0; i < kPrefetchRows && idx.isValid(); ++i) {
+    idx = indexBelow(idx);
+    if (idx.isValid()) indexes << proxy_model->mapToSource(idx);
+  }
+  idx = first_visible;
+  for (int i = 0; i < kPrefetchRows && idx.isValid(); ++i) {
+    idx = indexAbove(idx);
+    if (idx.isValid()) indexes << proxy_model->mapToSource(idx);
+  }
+
+  if (!indexes.isEmpty()) {
+    collection_model->PrefetchAlbumCovers(indexes);
+  }
+
+}
+
+void CollectionView::ContainerExpanded(const QModelIndex &proxy_index) {
+
+  QSortFilterProxyModel *proxy_model = qobject_cast<QSortFilterProxyModel*>(model());
+  if (!proxy_model) return;
+  CollectionModel *collection_model = qobject_cast<CollectionModel*>(proxy_model->sourceModel());
+  if (!collection_model) return;
+
+  // Queue covers for all the newly revealed albums in one batch, nearest first as the model hands them back in row order.
+  collection_model->PrefetchChildAlbumCovers(proxy_model->mapToSource(proxy_index));
+
+}
@@ -41,6 +41,7 @@ class QAction;
 class QContextMenuEvent;
 class QMouseEvent;
 class QPaintEvent;
+class QTimer;
 
 class Application;
 class CollectionFilterWidget;
@@ -113,6 +114,8 @@ class CollectionView : public AutoExpandingTreeView {
   void NoShowInVarious();
   void Delete();
   void DeleteFilesFinished(const SongList &songs_with_errors);
+  void PrefetchCovers();
+  void ContainerExpanded(const QModelIndex &proxy_index);
 
  private:
   void RecheckIsEmpty();
@@ -130,6 +133,9 @@ class CollectionView : public AutoExpandingTreeView {
 
   QPixmap nomusic_;
 
+  // Debounces scrolling before covers for rows just outside the viewport are prefetched.
+  QTimer *prefetch_timer_;
+
   QMenu *context_menu_;
   QModelIndex context_menu_index_;
   QAction *action_load_;
@@ -26,6 +26,9 @@
 
 #include <QObject>
 #include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <QMutexLocker>
 #include <QIODevice>
 #include <QDir>
 #include <QDirIterator>
@@ -33,6 +36,7 @@
 #include <QFileInfo>
 #include <QMetaObject>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QMap>
 #include <QList>
@@ -43,8 +47,11 @@
 #include <QUrl>
 #include <QImage>
 #include <QSettings>
+#include <QStandardPaths>
+#include <QDataStream>
 
 #include "core/filesystemwatcherinterface.h"
+#include "core/ioscheduler.h"
 #include "core/logging.h"
 #include "core/tagreaderclient.h"
 #include "core/taskmanager.h"
@@ -53,6 +60,7 @@
 #include "utilities/timeconstants.h"
 #include "collectiondirectory.h"
 #include "collectionbackend.h"
+#include "collectionscaniotrace.h"
 #include "collectionwatcher.h"
 #include "playlistparsers/cueparser.h"
 #include "settings/collectionsettingspage.h"
@@ -71,6 +79,11 @@
 
 using namespace std::chrono_literals;
 
+namespace {
+constexpr quint32 kDirSnapshotMagic = 0x53747261;  // 'Stra'
+constexpr quint32 kDirSnapshotVersion = 1;
+}  // namespace
+
 QStringList CollectionWatcher::sValidImages = QStringList() << QStringLiteral("jpg") << QStringLiteral("png") << QStringLiteral("gif") << QStringLiteral("jpeg");
 QStringList CollectionWatcher::kIgnoredExtensions = QStringList() << QStringLiteral("tmp") << QStringLiteral("tar") << QStringLiteral("gz") << QStringLiteral("bz2") << QStringLiteral("xz") << QStringLiteral("tbz") << QStringLiteral("tgz") << QStringLiteral("z") << QStringLiteral("zip") << QStringLiteral("rar");
 
@@ -83,6 +96,8 @@ CollectionWatcher::CollectionWatcher(Song::Source source, QObject *parent)
       original_thread_(nullptr),
       scan_on_startup_(true),
       monitor_(true),
+      scan_concurrency_(1),
+      scan_pool_(new QThreadPool(this)),
       song_tracking_(false),
       song_ebur128_loudness_analysis_(false),
       mark_songs_unavailable_(source_ == Song::Source::Collection),
@@ -96,6 +111,8 @@ CollectionWatcher::CollectionWatcher(Song::Source source, QObject *parent)
       rescan_paused_(false),
       total_watches_(0),
       cue_parser_(new CueParser(backend_, this)),
+      dir_snapshot_loaded_(false),
+      dir_snapshot_dirty_(false),
       last_scan_time_(0) {
 
   original_thread_ = thread();
@@ -155,6 +172,8 @@ void CollectionWatcher::ReloadSettings() {
   s.beginGroup(CollectionSettingsPage::kSettingsGroup);
   scan_on_startup_ = s.value("startup_scan", true).toBool();
   monitor_ = s.value("monitor", true).toBool();
+  scan_concurrency_ = qBound(1, s.value("scan_concurrency", 1).toInt(), 32);
+  scan_pool_->setMaxThreadCount(scan_concurrency_);
   const QStringList filters = s.value("cover_art_patterns", QStringList() << QStringLiteral("front") << QStringLiteral("cover")).toStringList();
   if (source_ == Song::Source::Collection) {
     song_tracking_ = s.value("song_tracking", false).toBool();
@@ -209,6 +228,7 @@ CollectionWatcher::ScanTransaction::ScanTransaction(CollectionWatcher *watcher,
       expire_unavailable_songs_days_(60),
       watcher_(watcher),
       cached_songs_dirty_(true),
+      cached_songs_by_identity_dirty_(true),
       cached_songs_missing_fingerprint_dirty_(true),
       cached_songs_missing_loudness_characteristics_dirty_(true),
       known_subdirs_dirty_(true) {
@@ -234,12 +254,34 @@ CollectionWatcher::ScanTransaction::~ScanTransaction() {
     CommitNewOrUpdatedSongs();
   }
 
+  // Discard any pipelined tag-read replies that were never claimed.
+  for (TagReaderReply *reply : std::as_const(pending_tag_reads_)) {
+    reply->WaitForFinished();
+    reply->deleteLater();
+  }
+  pending_tag_reads_.clear();
+
   watcher_->task_manager_->SetTaskFinished(task_id_);
 
 }
 
+void CollectionWatcher::ScanTransaction::AddPendingTagRead(const QString &file, TagReaderReply *reply) {
+
+  QMutexLocker locker(&mutex_);
+  pending_tag_reads_.insert(file, reply);
+
+}
+
+TagReaderReply *CollectionWatcher::ScanTransaction::TakePendingTagRead(const QString &file) {
+
+  QMutexLocker locker(&mutex_);
+  return pending_tag_reads_.take(file);
+
+}
+
 void CollectionWatcher::ScanTransaction::AddToProgress(const quint64 n) {
 
+  QMutexLocker locker(&mutex_);
   progress_ += n;
   watcher_->task_manager_->SetTaskProgress(task_id_, progress_, progress_max_);
 
@@ -247,6 +289,7 @@ void CollectionWatcher::ScanTransaction::AddToProgress(const quint64 n) {
 
 void CollectionWatcher::ScanTransaction::AddToProgressMax(const quint64 n) {
 
+  QMutexLocker locker(&mutex_);
   progress_max_ += n;
   watcher_->task_manager_->SetTaskProgress(task_id_, progress_, progress_max_);
 
@@ -314,6 +357,8 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
 
 SongList CollectionWatcher::ScanTransaction::FindSongsInSubdirectory(const QString &path) {
 
+  QMutexLocker locker(&mutex_);
+
   if (cached_songs_dirty_) {
     const SongList songs = watcher_->backend_->FindSongsInDirectory(dir_);
     for (const Song &song : songs) {
@@ -331,8 +376,29 @@ SongList CollectionWatcher::ScanTransaction::FindSongsInSubdirectory(const QStri
 
 }
 
+SongList CollectionWatcher::ScanTransaction::FindMovedSongCandidates(const QString &basename, const qint64 filesize, const qint64 mtime) {
+
+  QMutexLocker locker(&mutex_);
+
+  if (cached_songs_by_identity_dirty_) {
+    const SongList songs = watcher_->backend_->FindSongsInDirectory(dir_);
+    for (const Song &song : songs) {
+      if (song.filesize() <= 0 || song.mtime() <= 0) continue;
+      const QString key = song.url().toLocalFile().section(QLatin1Char('/'), -1) + QLatin1Char(':') + QString::number(song.filesize()) + QLatin1Char(':') + QString::number(song.mtime());
+      cached_songs_by_identity_.insert(key, song);
+    }
+    cached_songs_by_identity_dirty_ = false;
+  }
+
+  const QString key = basename + QLatin1Char(':') + QString::number(filesize) + QLatin1Char(':') + QString::number(mtime);
+  return cached_songs_by_identity_.values(key);
+
+}
+
 bool CollectionWatcher::ScanTransaction::HasSongsWithMissingFingerprint(const QString &path) {
 
+  QMutexLocker locker(&mutex_);
+
   if (cached_songs_missing_fingerprint_dirty_) {
     const SongList songs = watcher_->backend_->SongsWithMissingFingerprint(dir_);
     for (const Song &song : songs) {
@@ -348,6 +414,8 @@ bool CollectionWatcher::ScanTransaction::HasSongsWithMissingFingerprint(const QS
 
 bool CollectionWatcher::ScanTransaction::HasSongsWithMissingLoudnessCharacteristics(const QString &path) {
 
+  QMutexLocker locker(&mutex_);
+
   if (cached_songs_missing_loudness_characteristics_dirty_) {
     const SongList songs = watcher_->backend_->SongsWithMissingLoudnessCharacteristics(dir_);
     for (const Song &song : songs) {
@@ -361,8 +429,23 @@ bool CollectionWatcher::ScanTransaction::HasSongsWithMissingLoudnessCharacterist
 
 }
 
+SongList CollectionWatcher::ScanTransaction::TakeSongsMissingLoudnessCharacteristics(const QString &path) {
+
+  QMutexLocker locker(&mutex_);
+
+  if (!HasSongsWithMissingLoudnessCharacteristics(path)) return SongList();
+
+  const SongList songs = cached_songs_missing_loudness_characteristics_.values(path);
+  cached_songs_missing_loudness_characteristics_.remove(path);
+
+  return songs;
+
+}
+
 void CollectionWatcher::ScanTransaction::SetKnownSubdirs(const CollectionSubdirectoryList &subdirs) {
 
+  QMutexLocker locker(&mutex_);
+
   known_subdirs_ = subdirs;
   known_subdirs_dirty_ = false;
 
@@ -370,6 +453,8 @@ void CollectionWatcher::ScanTransaction::SetKnownSubdirs(const CollectionSubdire
 
 bool CollectionWatcher::ScanTransaction::HasSeenSubdir(const QString &path) {
 
+  QMutexLocker locker(&mutex_);
+
   if (known_subdirs_dirty_) {
     SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
   }
@@ -380,6 +465,8 @@ bool CollectionWatcher::ScanTransaction::HasSeenSubdir(const QString &path) {
 
 CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetImmediateSubdirs(const QString &path) {
 
+  QMutexLocker locker(&mutex_);
+
   if (known_subdirs_dirty_) {
     SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
   }
@@ -397,6 +484,8 @@ CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetImmediateSubdi
 
 CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetAllSubdirs() {
 
+  QMutexLocker locker(&mutex_);
+
   if (known_subdirs_dirty_) {
     SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
   }
@@ -409,6 +498,8 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
 
   stop_requested_ = false;
 
+  ScanIOTrace::BeginScan();
+
   watched_dirs_[dir.id] = dir;
 
   if (subdirs.isEmpty()) {
@@ -417,7 +508,8 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
     const quint64 files_count = FilesCountForPath(&transaction, dir.path);
     transaction.SetKnownSubdirs(subdirs);
     transaction.AddToProgressMax(files_count);
-    ScanSubdirectory(dir.path, CollectionSubdirectory(), files_count, &transaction);
+    ScanSubdirectoryAsync(dir.path, CollectionSubdirectory(), files_count, &transaction);
+    WaitForScanCompletion();
     last_scan_time_ = QDateTime::currentSecsSinceEpoch();
   }
   else {
@@ -430,15 +522,19 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
     for (const CollectionSubdirectory &subdir : subdirs) {
       if (stop_requested_ || abort_requested_) break;
 
-      if (scan_on_startup_) ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
+      if (scan_on_startup_) ScanSubdirectoryAsync(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
 
       if (monitor_) AddWatch(dir, subdir.path);
     }
 
+    WaitForScanCompletion();
+
     last_scan_time_ = QDateTime::currentSecsSinceEpoch();
 
   }
 
+  ScanIOTrace::EndScan();
+
   emit CompilationsNeedUpdating();
 
 }
@@ -457,6 +553,10 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
     }
   }
 
+  // One subdirectory is one unit of scan I/O, serialize it against other background jobs on the same spinning disk.
+  // The token is reentrant, so the recursive calls below for removed and new subdirectories don't wait on us.
+  IoScheduler::ScopedToken io_token(QStringList() << path);
+
   bool songs_missing_fingerprint = false;
   bool songs_missing_loudness_characteristics = false;
 #ifdef HAVE_SONGFINGERPRINTING
@@ -470,8 +570,12 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
   }
 #endif
 
-  if (!t->ignores_mtime() && !force_noincremental && t->is_incremental() && subdir.mtime == path_info.lastModified().toSecsSinceEpoch() && !songs_missing_fingerprint && !songs_missing_loudness_characteristics) {
-    // The directory hasn't changed since last time
+  if (!t->ignores_mtime() && !force_noincremental && t->is_incremental() && subdir.mtime == path_info.lastModified().toSecsSinceEpoch() && !songs_missing_fingerprint) {
+    // The directory hasn't changed since last time.
+    // Songs that are only missing loudness characteristics don't need a full rescan, analyse the existing songs in place.
+    if (songs_missing_loudness_characteristics) {
+      PerformEBUR128AnalysisForSubdir(path, t);
+    }
     t->AddToProgress(files_count);
     return;
   }
@@ -489,6 +593,9 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
     }
   }
 
+  QElapsedTimer io_trace_timer;
+  if (ScanIOTrace::Enabled()) io_trace_timer.start();
+
   // First we "quickly" get a list of the files in the directory that we think might be music.  While we're here, we also look for new subdirectories and possible album artwork.
   QDirIterator it(path, QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
   while (it.hasNext()) {
@@ -530,9 +637,32 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
 
   if (stop_requested_ || abort_requested_) return;
 
+  if (ScanIOTrace::Enabled()) ScanIOTrace::Record(ScanIOTrace::Op::List, path, io_trace_timer.nsecsElapsed());
+
   // Ask the database for a list of files in this directory
   SongList songs_in_db = t->FindSongsInSubdirectory(path);
 
+  // Pipeline tag-read requests for all the new and changed files in this directory across the tag reader workers,
+  // so tag extraction scales with the worker count instead of being serialised on one blocking request at a time.
+  // The replies are claimed by ReadFileTags() in the per-file pass below, any that end up unused are discarded when the transaction finishes.
+  for (const QString &file : std::as_const(files_on_disk)) {
+    if (stop_requested_ || abort_requested_) return;
+    if (!CueParser::FindCueFilename(file).isEmpty()) continue;  // CUE associated files are parsed from the CUE sheet, not the tags.
+    SongList matching_songs;
+    bool needs_tag_read = true;
+    if (FindSongsByPath(songs_in_db, file, &matching_songs)) {
+      const Song &matching_song = matching_songs.first();
+      const qint64 matching_song_cue_mtime = static_cast<qint64>(GetMtimeForCue(matching_song.cue_path()));
+      if (ScanIOTrace::Enabled()) io_trace_timer.start();
+      const QFileInfo fileinfo(file);
+      needs_tag_read = t->ignores_mtime() || matching_song.mtime() != qMax(fileinfo.lastModified().toSecsSinceEpoch(), matching_song_cue_mtime);
+      if (ScanIOTrace::Enabled()) ScanIOTrace::Record(ScanIOTrace::Op::Stat, file, io_trace_timer.nsecsElapsed());
+    }
+    if (needs_tag_read) {
+      t->AddPendingTagRead(file, TagReaderClient::Instance()->ReadFile(file, true));
+    }
+  }
+
   QSet<QString> cues_processed;
 
   // Now compare the list from the database with the list of files on disk
@@ -630,14 +760,21 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
       // Nothing has changed - mark the song available without re-scanning
       else if (matching_song.unavailable()) {
         qLog(Debug) << "Unavailable song" << file << "restored.";
+        QMutexLocker locker(t->mutex());
         t->readded_songs << matching_songs;
       }
 
     }
-    else {  // Search the DB by fingerprint.
+    else {  // Search the DB for a moved file, cheaply by file identity first, then by fingerprint.
       QString fingerprint;
+      bool matched_by_identity = false;
+      if (song_tracking_ && FindSongsByFileIdentity(file, t, &matching_songs)) {
+        matched_by_identity = true;
+        // Keep the stored fingerprint, the content is the same file.
+        fingerprint = matching_songs.first().fingerprint();
+      }
 #ifdef HAVE_SONGFINGERPRINTING
-      if (song_tracking_) {
+      if (song_tracking_ && !matched_by_identity) {
         Chromaprinter chromaprinter(file);
         fingerprint = chromaprinter.CreateFingerprint();
         if (fingerprint.isEmpty()) {
@@ -645,7 +782,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         }
       }
 #endif
-      if (song_tracking_ && !fingerprint.isEmpty() && fingerprint != QLatin1String("NONE") && FindSongsByFingerprint(file, fingerprint, &matching_songs)) {
+      if (matched_by_identity || (song_tracking_ && !fingerprint.isEmpty() && fingerprint != QLatin1String("NONE") && FindSongsByFingerprint(file, fingerprint, &matching_songs))) {
 
         // The song is in the database and still on disk.
         // Check the mtime to see if it's been changed since it was added.
@@ -659,17 +796,20 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
 
         // Make sure the songs aren't deleted, as they still exist elsewhere with a different file path.
         bool matching_songs_has_cue = false;
-        for (const Song &matching_song : std::as_const(matching_songs)) {
-          QString matching_filename = matching_song.url().toLocalFile();
-          if (!t->files_changed_path_.contains(matching_filename)) {
-            t->files_changed_path_ << matching_filename;
-            qLog(Debug) << matching_filename << "has changed path to" << file;
-          }
-          if (t->deleted_songs.contains(matching_song)) {
-            t->deleted_songs.removeAll(matching_song);
-          }
-          if (matching_song.has_cue()) {
-            matching_songs_has_cue = true;
+        {
+          QMutexLocker locker(t->mutex());
+          for (const Song &matching_song : std::as_const(matching_songs)) {
+            QString matching_filename = matching_song.url().toLocalFile();
+            if (!t->files_changed_path_.contains(matching_filename)) {
+              t->files_changed_path_ << matching_filename;
+              qLog(Debug) << matching_filename << "has changed path to" << file;
+            }
+            if (t->deleted_songs.contains(matching_song)) {
+              t->deleted_songs.removeAll(matching_song);
+            }
+            if (matching_song.has_cue()) {
+              matching_songs_has_cue = true;
+            }
           }
         }
 
@@ -682,7 +822,10 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         // Get new album art
         const QUrl art_automatic = ArtForSong(file, album_art);
 
-        if (new_cue.isEmpty() || new_cue_mtime == 0) {  // If no CUE or it's about to lose it.
+        if (matched_by_identity && (new_cue.isEmpty() || new_cue_mtime == 0)) {  // Moved without content change, reuse the row as-is.
+          UpdateMovedSongs(file, matching_songs, art_automatic, t);
+        }
+        else if (new_cue.isEmpty() || new_cue_mtime == 0) {  // If no CUE or it's about to lose it.
           UpdateNonCueAssociatedSong(file, fingerprint, matching_songs, art_automatic, matching_songs_has_cue && new_cue_mtime == 0, t);
         }
         else {  // If CUE associated.
@@ -692,7 +835,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
       }
       else {  // The song is on disk but not in the DB
 
-        const SongList songs = ScanNewFile(file, path, fingerprint, new_cue, &cues_processed);
+        const SongList songs = ScanNewFile(file, path, fingerprint, new_cue, &cues_processed, t);
         if (songs.isEmpty()) {
           t->AddToProgress(1);
           continue;
@@ -703,6 +846,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         // Choose art for the song(s)
         const QUrl art_automatic = ArtForSong(file, album_art);
 
+        QMutexLocker locker(t->mutex());
         for (Song song : songs) {
           song.set_directory_id(t->dir());
           if (song.art_automatic().isEmpty()) song.set_art_automatic(art_automatic);
@@ -713,36 +857,62 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
     t->AddToProgress(1);
   }
 
-  // Look for deleted songs
-  for (const Song &song : std::as_const(songs_in_db)) {
-    QString file = song.url().toLocalFile();
-    if (!song.unavailable() && !files_on_disk.contains(file) && !t->files_changed_path_.contains(file)) {
-      qLog(Debug) << "Song deleted from disk:" << file;
-      t->deleted_songs << song;
+  {
+    QMutexLocker locker(t->mutex());
+
+    // Look for deleted songs
+    for (const Song &song : std::as_const(songs_in_db)) {
+      QString file = song.url().toLocalFile();
+      if (!song.unavailable() && !files_on_disk.contains(file) && !t->files_changed_path_.contains(file)) {
+        qLog(Debug) << "Song deleted from disk:" << file;
+        t->deleted_songs << song;
+      }
     }
-  }
 
-  // Add this subdir to the new or touched list
-  CollectionSubdirectory updated_subdir;
-  updated_subdir.directory_id = t->dir();
-  updated_subdir.mtime = path_info.exists() ? path_info.lastModified().toSecsSinceEpoch() : 0;
-  updated_subdir.path = path;
+    // Add this subdir to the new or touched list
+    CollectionSubdirectory updated_subdir;
+    updated_subdir.directory_id = t->dir();
+    updated_subdir.mtime = path_info.exists() ? path_info.lastModified().toSecsSinceEpoch() : 0;
+    updated_subdir.path = path;
 
-  if (subdir.directory_id == -1) {
-    t->new_subdirs << updated_subdir;
-  }
-  else {
-    t->touched_subdirs << updated_subdir;
-  }
+    if (subdir.directory_id == -1) {
+      t->new_subdirs << updated_subdir;
+    }
+    else {
+      t->touched_subdirs << updated_subdir;
+    }
 
-  if (updated_subdir.mtime == 0) {  // CollectionSubdirectory deleted, mark it for removal from the watcher.
-    t->deleted_subdirs << updated_subdir;
+    if (updated_subdir.mtime == 0) {  // CollectionSubdirectory deleted, mark it for removal from the watcher.
+      t->deleted_subdirs << updated_subdir;
+    }
   }
 
-  // Recurse into the new subdirs that we found
+  // Scan the new subdirs that we found.
+  // With scan concurrency above 1 these are dispatched to the scanner pool so independent subtrees are walked in parallel.
   for (const CollectionSubdirectory &my_new_subdir : std::as_const(my_new_subdirs)) {
     if (stop_requested_ || abort_requested_) return;
-    ScanSubdirectory(my_new_subdir.path, my_new_subdir, 0, t, true);
+    ScanSubdirectoryAsync(my_new_subdir.path, my_new_subdir, 0, t, true);
+  }
+
+}
+
+void CollectionWatcher::ScanSubdirectoryAsync(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, ScanTransaction *t, const bool force_noincremental) {
+
+  if (scan_concurrency_ <= 1) {
+    ScanSubdirectory(path, subdir, files_count, t, force_noincremental);
+    return;
+  }
+
+  scan_pool_->start([this, path, subdir, files_count, t, force_noincremental]() {
+    ScanSubdirectory(path, subdir, files_count, t, force_noincremental);
+  });
+
+}
+
+void CollectionWatcher::WaitForScanCompletion() {
+
+  if (scan_concurrency_ > 1) {
+    scan_pool_->waitForDone();
   }
 
 }
@@ -760,15 +930,9 @@ void CollectionWatcher::UpdateCueAssociatedSongs(const QString &file,
     sections_map.insert(song.beginning_nanosec(), song);
   }
 
-  // Load new CUE songs
-  QFile cue_file(matching_cue);
-  if (!cue_file.exists()) return;
-  if (!cue_file.open(QIODevice::ReadOnly)) {
-    qLog(Error) << "Could not open CUE file" << matching_cue << "for reading:" << cue_file.errorString();
-    return;
-  }
-  const SongList songs = cue_parser_->Load(&cue_file, matching_cue, path, false);
-  cue_file.close();
+  // Load new CUE songs, one parse is shared between all the media files the sheet references.
+  const SongList songs = cue_parser_->LoadFromFileCached(matching_cue, QDir(path), false);
+  if (songs.isEmpty()) return;
 
   // Update every song that's in the CUE and collection
   QSet<int> used_ids;
@@ -787,11 +951,13 @@ void CollectionWatcher::UpdateCueAssociatedSongs(const QString &file,
       used_ids.insert(matching_cue_song.id());
     }
     else {  // A new section
+      QMutexLocker locker(t->mutex());
       t->new_songs << new_cue_song;
     }
   }
 
   // Sections that are now missing
+  QMutexLocker locker(t->mutex());
   for (const Song &old_cue : old_cue_songs) {
     if (!used_ids.contains(old_cue.id())) {
       t->deleted_songs << old_cue;
@@ -809,6 +975,7 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
   // If a CUE got deleted, we turn it's first section into the new 'raw' (cueless) song, and we just remove the rest of the sections from the collection
   const Song &matching_song = matching_songs.first();
   if (cue_deleted) {
+    QMutexLocker locker(t->mutex());
     for (const Song &song : matching_songs) {
       if (!song.IsAllMetadataEqual(matching_song)) {
         t->deleted_songs << song;
@@ -817,7 +984,7 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
   }
 
   Song song_on_disk(source_);
-  const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(file, &song_on_disk);
+  const TagReaderClient::Result result = ReadFileTags(file, &song_on_disk, t);
   if (result.success() && song_on_disk.is_valid()) {
     song_on_disk.set_source(source_);
     song_on_disk.set_directory_id(t->dir());
@@ -831,7 +998,24 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
 
 }
 
-SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed) {
+void CollectionWatcher::UpdateMovedSongs(const QString &file, const SongList &matching_songs, const QUrl &art_automatic, ScanTransaction *t) {
+
+  // Same basename, size and mtime means the content is unchanged and only the path moved:
+  // keep the row with all its stats, rating and metadata and skip re-reading tags or re-analyzing the file.
+  const QFileInfo fileinfo(file);
+  for (const Song &matching_song : matching_songs) {
+    Song song = matching_song;
+    song.set_source(source_);
+    song.set_directory_id(t->dir());
+    song.set_url(QUrl::fromLocalFile(file));
+    song.set_basefilename(fileinfo.fileName());
+    song.set_art_automatic(art_automatic);
+    AddChangedSong(file, matching_song, song, t);
+  }
+
+}
+
+SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed, ScanTransaction *t) {
 
   SongList songs;
 
@@ -841,20 +1025,11 @@ SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path
     // Don't process the same CUE many times
     if (cues_processed->contains(matching_cue)) return songs;
 
-    QFile cue_file(matching_cue);
-    if (!cue_file.exists()) return songs;
-
-    if (!cue_file.open(QIODevice::ReadOnly)) {
-      qLog(Error) << "Could not open CUE file" << matching_cue << "for reading:" << cue_file.errorString();
-      return songs;
-    }
-
     // Ignore FILEs pointing to other media files.
     // Also, watch out for incorrect media files.
     // Playlist parser for CUEs considers every entry in sheet valid, and we don't want invalid media getting into collection!
     QString file_nfd = file.normalized(QString::NormalizationForm_D);
-    SongList cue_congs = cue_parser_->Load(&cue_file, matching_cue, path, false);
-    cue_file.close();
+    SongList cue_congs = cue_parser_->LoadFromFileCached(matching_cue, QDir(path), false);
     songs.reserve(cue_congs.count());
     for (Song &cue_song : cue_congs) {
       cue_song.set_source(source_);
@@ -870,7 +1045,7 @@ SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path
   }
   else {  // It's a normal media file
     Song song(source_);
-    const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(file, &song);
+    const TagReaderClient::Result result = ReadFileTags(file, &song, t);
     if (result.success() && song.is_valid()) {
       song.set_source(source_);
       PerformEBUR128Analysis(song);
@@ -883,6 +1058,20 @@ SongList CollectionWatcher::ScanNewFile(const QString &file, const QString &path
 
 }
 
+TagReaderClient::Result CollectionWatcher::ReadFileTags(const QString &file, Song *song, ScanTransaction *t) {
+
+  QElapsedTimer io_trace_timer;
+  if (ScanIOTrace::Enabled()) io_trace_timer.start();
+
+  TagReaderReply *reply = t->TakePendingTagRead(file);
+  const TagReaderClient::Result result = reply ? TagReaderClient::Instance()->ReadFileReplyBlocking(reply, song) : TagReaderClient::Instance()->ReadFileBlocking(file, song);
+
+  if (ScanIOTrace::Enabled()) ScanIOTrace::Record(ScanIOTrace::Op::TagRead, file, io_trace_timer.nsecsElapsed());
+
+  return result;
+
+}
+
 void CollectionWatcher::AddChangedSong(const QString &file, const Song &matching_song, const Song &new_song, ScanTransaction *t) {
 
   bool notify_new = false;
@@ -942,6 +1131,7 @@ void CollectionWatcher::AddChangedSong(const QString &file, const Song &matching
 
   }
 
+  QMutexLocker locker(t->mutex());
   if (notify_new) {
     t->new_songs << new_song;
   }
@@ -965,6 +1155,41 @@ void CollectionWatcher::PerformEBUR128Analysis(Song &song) const {
 
 }
 
+void CollectionWatcher::PerformEBUR128AnalysisForSubdir(const QString &path, ScanTransaction *t) {
+
+#ifdef HAVE_EBUR128
+
+  const SongList songs = t->TakeSongsMissingLoudnessCharacteristics(path);
+  if (songs.isEmpty()) return;
+
+  qLog(Debug) << "Analysing loudness characteristics for" << songs.count() << "songs in" << path;
+
+  // Fan the analyses out over the global thread pool so one pipeline runs per core, instead of analysing the files one at a time.
+  const SongList analysed_songs = QtConcurrent::blockingMapped(songs, [this](Song song) {
+    if (!stop_requested_ && !abort_requested_) {
+      std::optional<EBUR128Measures> loudness_characteristics = EBUR128Analysis::Compute(song);
+      if (loudness_characteristics) {
+        song.set_ebur128_integrated_loudness_lufs(loudness_characteristics->loudness_lufs);
+        song.set_ebur128_loudness_range_lu(loudness_characteristics->range_lu);
+      }
+    }
+    return song;
+  });
+
+  QMutexLocker locker(t->mutex());
+  for (const Song &song : analysed_songs) {
+    if (song.ebur128_integrated_loudness_lufs()) {
+      t->new_songs << song;
+    }
+  }
+
+#else
+  Q_UNUSED(path)
+  Q_UNUSED(t)
+#endif
+
+}
+
 quint64 CollectionWatcher::GetMtimeForCue(const QString &cue_path) {
 
   if (cue_path.isEmpty()) {
@@ -1028,6 +1253,31 @@ bool CollectionWatcher::FindSongsByPath(const SongList &songs, const QString &pa
 
 }
 
+bool CollectionWatcher::FindSongsByFileIdentity(const QString &file, ScanTransaction *t, SongList *out) {
+
+  const QFileInfo fileinfo(file);
+  const SongList candidates = t->FindMovedSongCandidates(fileinfo.fileName(), fileinfo.size(), fileinfo.lastModified().toSecsSinceEpoch());
+
+  // Group the candidates by their old file, the match is only trusted when exactly one old file is gone.
+  QMap<QString, SongList> candidates_by_old_file;
+  for (const Song &song : candidates) {
+    // CUE sections carry structure beyond the file itself, leave those to the full rescan path.
+    if (song.has_cue()) return false;
+    const QString filename = song.url().toLocalFile();
+    if (filename == file) continue;
+    // The old file is still on disk, so this is a copy, not a move.
+    if (QFileInfo::exists(filename)) continue;
+    candidates_by_old_file[filename] << song;
+  }
+
+  if (candidates_by_old_file.count() != 1) return false;
+
+  *out = candidates_by_old_file.first();
+
+  return true;
+
+}
+
 bool CollectionWatcher::FindSongsByFingerprint(const QString &file, const QString &fingerprint, SongList *out) {
 
   SongList songs = backend_->GetSongsByFingerprint(fingerprint);
@@ -1099,8 +1349,10 @@ void CollectionWatcher::RescanPathsNow() {
       subdir.directory_id = dir;
       subdir.mtime = 0;
       subdir.path = path;
-      ScanSubdirectory(path, subdir, subdir_files_count[path], &transaction);
+      ScanSubdirectoryAsync(path, subdir, subdir_files_count[path], &transaction);
     }
+
+    WaitForScanCompletion();
   }
 
   rescan_queue_.clear();
@@ -1217,6 +1469,8 @@ void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mt
 
   stop_requested_ = false;
 
+  ScanIOTrace::BeginScan();
+
   for (const CollectionDirectory &dir : std::as_const(watched_dirs_)) {
 
     if (stop_requested_ || abort_requested_) break;
@@ -1238,11 +1492,15 @@ void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mt
 
     for (const CollectionSubdirectory &subdir : std::as_const(subdirs)) {
       if (stop_requested_ || abort_requested_) break;
-      ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
+      ScanSubdirectoryAsync(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
     }
 
+    WaitForScanCompletion();
+
   }
 
+  ScanIOTrace::EndScan();
+
   last_scan_time_ = QDateTime::currentSecsSinceEpoch();
 
   emit CompilationsNeedUpdating();
@@ -1287,18 +1545,107 @@ quint64 CollectionWatcher::FilesCountForPath(ScanTransaction *t, const QString &
 
 quint64 CollectionWatcher::FilesCountForSubdirs(ScanTransaction *t, const CollectionSubdirectoryList &subdirs, QMap<QString, quint64> &subdir_files_count) {
 
+  LoadDirSnapshot();
+
   quint64 i = 0;
   for (const CollectionSubdirectory &subdir : subdirs) {
     if (stop_requested_ || abort_requested_) break;
-    const quint64 files_count = FilesCountForPath(t, subdir.path);
+    quint64 files_count = 0;
+    const qint64 current_mtime = QFileInfo(subdir.path).lastModified().toSecsSinceEpoch();
+    // If the subdirectory hasn't changed since the snapshot was taken we can reuse the file count and skip walking the subtree.
+    if (current_mtime != 0 && dir_snapshot_.contains(subdir.path) && dir_snapshot_[subdir.path].mtime == current_mtime) {
+      files_count = dir_snapshot_[subdir.path].files_count;
+    }
+    else {
+      files_count = FilesCountForPath(t, subdir.path);
+      DirSnapshotEntry entry;
+      entry.mtime = current_mtime;
+      entry.files_count = files_count;
+      dir_snapshot_.insert(subdir.path, entry);
+      dir_snapshot_dirty_ = true;
+    }
     subdir_files_count[subdir.path] = files_count;
     i += files_count;
   }
 
+  SaveDirSnapshot();
+
   return i;
 
 }
 
+QString CollectionWatcher::DirSnapshotFilename() const {
+
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/collectionwatcher-snapshot.bin");
+
+}
+
+void CollectionWatcher::LoadDirSnapshot() {
+
+  // Only the local collection keeps a snapshot, device watchers always walk their directories.
+  if (source_ != Song::Source::Collection || dir_snapshot_loaded_) return;
+
+  dir_snapshot_loaded_ = true;
+
+  QFile file(DirSnapshotFilename());
+  if (!file.exists()) return;
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Could not open collection directory snapshot" << file.fileName() << "for reading:" << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  quint32 magic = 0, version = 0;
+  s >> magic >> version;
+  if (magic != kDirSnapshotMagic || version != kDirSnapshotVersion) {
+    file.close();
+    return;
+  }
+
+  quint32 count = 0;
+  s >> count;
+  dir_snapshot_.reserve(static_cast<int>(count));
+  for (quint32 idx = 0; idx < count && s.status() == QDataStream::Ok; ++idx) {
+    QString path;
+    DirSnapshotEntry entry;
+    s >> path >> entry.mtime >> entry.files_count;
+    dir_snapshot_.insert(path, entry);
+  }
+
+  if (s.status() != QDataStream::Ok) {
+    qLog(Error) << "Collection directory snapshot" << file.fileName() << "is corrupt, ignoring it.";
+    dir_snapshot_.clear();
+  }
+
+  file.close();
+
+}
+
+void CollectionWatcher::SaveDirSnapshot() {
+
+  if (source_ != Song::Source::Collection || !dir_snapshot_dirty_) return;
+
+  QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QFile file(DirSnapshotFilename());
+  if (!file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Could not open collection directory snapshot" << file.fileName() << "for writing:" << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  s << kDirSnapshotMagic << kDirSnapshotVersion;
+  s << static_cast<quint32>(dir_snapshot_.count());
+  for (QHash<QString, DirSnapshotEntry>::const_iterator it = dir_snapshot_.constBegin(); it != dir_snapshot_.constEnd(); ++it) {
+    s << it.key() << it.value().mtime << it.value().files_count;
+  }
+
+  file.close();
+
+  dir_snapshot_dirty_ = false;
+
+}
+
 void CollectionWatcher::RescanSongsAsync(const SongList &songs) {
 
   QMetaObject::invokeMethod(this, "RescanSongs", Qt::QueuedConnection, Q_ARG(SongList, songs));
@@ -1324,6 +1671,7 @@ void CollectionWatcher::RescanSongs(const SongList &songs) {
       ScanSubdirectory(song_path, subdir, files_count, &transaction);
       scanned_paths << subdir.path;
     }
+    WaitForScanCompletion();
   }
 
   emit CompilationsNeedUpdating();
@@ -29,6 +29,7 @@
 #include <QHash>
 #include <QMap>
 #include <QMultiMap>
+#include <QMutex>
 #include <QSet>
 #include <QString>
 #include <QStringList>
@@ -37,8 +38,10 @@
 #include "collectiondirectory.h"
 #include "core/shared_ptr.h"
 #include "core/song.h"
+#include "core/tagreaderclient.h"
 
 class QThread;
+class QThreadPool;
 class QTimer;
 
 class CollectionBackend;
@@ -103,8 +106,11 @@ class CollectionWatcher : public QObject {
     ~ScanTransaction();
 
     SongList FindSongsInSubdirectory(const QString &path);
+    // All songs in this directory sharing the given basename, size and mtime, used to recognize moved files.
+    SongList FindMovedSongCandidates(const QString &basename, const qint64 filesize, const qint64 mtime);
     bool HasSongsWithMissingFingerprint(const QString &path);
     bool HasSongsWithMissingLoudnessCharacteristics(const QString &path);
+    SongList TakeSongsMissingLoudnessCharacteristics(const QString &path);
     bool HasSeenSubdir(const QString &path);
     void SetKnownSubdirs(const CollectionSubdirectoryList &subdirs);
     CollectionSubdirectoryList GetImmediateSubdirs(const QString &path);
@@ -113,6 +119,12 @@ class CollectionWatcher : public QObject {
     void AddToProgress(const quint64 n = 1);
     void AddToProgressMax(const quint64 n);
 
+    // Pipelined tag-read requests keyed by filename.
+    // ScanSubdirectory() dispatches a batch of read requests for a whole directory up front, and the per-file handlers claim the replies here.
+    // Replies that are never claimed are discarded when the transaction finishes.
+    void AddPendingTagRead(const QString &file, TagReaderReply *reply);
+    TagReaderReply *TakePendingTagRead(const QString &file);
+
     // Emits the signals for new & deleted songs etc and clears the lists. This causes the new stuff to be updated on UI.
     void CommitNewOrUpdatedSongs();
 
@@ -120,6 +132,9 @@ class CollectionWatcher : public QObject {
     bool is_incremental() const { return incremental_; }
     bool ignores_mtime() const { return ignores_mtime_; }
 
+    // Serializes access to the result lists below when subdirectories are scanned by multiple scanner threads.
+    QRecursiveMutex *mutex() { return &mutex_; }
+
     SongList deleted_songs;
     SongList readded_songs;
     SongList new_songs;
@@ -156,6 +171,10 @@ class CollectionWatcher : public QObject {
     QMultiMap<QString, Song> cached_songs_;
     bool cached_songs_dirty_;
 
+    // Keyed by "basename:filesize:mtime" for FindMovedSongCandidates.
+    QMultiMap<QString, Song> cached_songs_by_identity_;
+    bool cached_songs_by_identity_dirty_;
+
     QMultiMap<QString, Song> cached_songs_missing_fingerprint_;
     bool cached_songs_missing_fingerprint_dirty_;
 
@@ -164,6 +183,10 @@ class CollectionWatcher : public QObject {
 
     CollectionSubdirectoryList known_subdirs_;
     bool known_subdirs_dirty_;
+
+    QHash<QString, TagReaderReply*> pending_tag_reads_;
+
+    QRecursiveMutex mutex_;
   };
 
  private slots:
@@ -181,6 +204,10 @@ class CollectionWatcher : public QObject {
   static bool FindSongsByPath(const SongList &songs, const QString &path, SongList *out);
   bool FindSongsByFingerprint(const QString &file, const QString &fingerprint, SongList *out);
   static bool FindSongsByFingerprint(const QString &file, const SongList &songs, const QString &fingerprint, SongList *out);
+  // Matches a new file against a song whose file is gone by basename, size and mtime.
+  // A move or rename keeps all three, so moved files are recognized without decoding them for a fingerprint.
+  // Only an unambiguous match (exactly one old path, no CUE) counts, anything else falls back to the fingerprint search.
+  bool FindSongsByFileIdentity(const QString &file, ScanTransaction *t, SongList *out);
   inline static QString NoExtensionPart(const QString &fileName);
   inline static QString ExtensionPart(const QString &fileName);
   inline static QString DirectoryPart(const QString &fileName);
@@ -195,17 +222,38 @@ class CollectionWatcher : public QObject {
   void UpdateCueAssociatedSongs(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, const QUrl &art_automatic, const SongList &old_cue_songs, ScanTransaction *t);
   // Updates a single non-cue associated and altered (according to mtime) song during a scan.
   void UpdateNonCueAssociatedSong(const QString &file, const QString &fingerprint, const SongList &matching_songs, const QUrl &art_automatic, const bool cue_deleted, ScanTransaction *t);
+  // Points songs matched by file identity at their new location, keeping stats, rating and metadata without re-reading tags - the content didn't change, only the path.
+  void UpdateMovedSongs(const QString &file, const SongList &matching_songs, const QUrl &art_automatic, ScanTransaction *t);
   // Scans a single media file that's present on the disk but not yet in the collection.
   // It may result in a multiple files added to the collection when the media file has many sections (like a CUE related media file).
-  SongList ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed);
+  SongList ScanNewFile(const QString &file, const QString &path, const QString &fingerprint, const QString &matching_cue, QSet<QString> *cues_processed, ScanTransaction *t);
+
+  // Reads the tags for a media file, using the reply pipelined by ScanSubdirectory() when there is one, otherwise sending a blocking request.
+  TagReaderClient::Result ReadFileTags(const QString &file, Song *song, ScanTransaction *t);
 
   static void AddChangedSong(const QString &file, const Song &matching_song, const Song &new_song, ScanTransaction *t);
 
   void PerformEBUR128Analysis(Song &song) const;
 
+  // Analyses every song in a subdirectory that is missing EBU R 128 loudness characteristics, running one analysis per core,
+  // without re-reading tags or fingerprints for files that haven't otherwise changed.
+  // The results are committed through the transaction like any other updated songs.
+  void PerformEBUR128AnalysisForSubdir(const QString &path, ScanTransaction *t);
+
   quint64 FilesCountForPath(ScanTransaction *t, const QString &path);
   quint64 FilesCountForSubdirs(ScanTransaction *t, const CollectionSubdirectoryList &subdirs, QMap<QString, quint64> &subdir_files_count);
 
+  // A compact binary snapshot of (path, mtime, files count) per subdirectory,
+  // persisted between sessions so a startup incremental scan can skip re-walking unchanged subtrees.
+  QString DirSnapshotFilename() const;
+  void LoadDirSnapshot();
+  void SaveDirSnapshot();
+
+  // Dispatches a subdirectory scan to the scanner thread pool when scan concurrency is above 1, otherwise scans synchronously.
+  // Callers must call WaitForScanCompletion() before the transaction goes out of scope.
+  void ScanSubdirectoryAsync(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, ScanTransaction *t, const bool force_noincremental = false);
+  void WaitForScanCompletion();
+
   QString FindCueFilename(const QString &filename);
 
  private:
@@ -224,6 +272,8 @@ class CollectionWatcher : public QObject {
 
   bool scan_on_startup_;
   bool monitor_;
+  int scan_concurrency_;
+  QThreadPool *scan_pool_;
   bool song_tracking_;
   bool song_ebur128_loudness_analysis_;
   bool mark_songs_unavailable_;
@@ -244,6 +294,14 @@ class CollectionWatcher : public QObject {
 
   CueParser *cue_parser_;
 
+  struct DirSnapshotEntry {
+    qint64 mtime = 0;
+    quint64 files_count = 0;
+  };
+  QHash<QString, DirSnapshotEntry> dir_snapshot_;
+  bool dir_snapshot_loaded_;
+  bool dir_snapshot_dirty_;
+
   static QStringList sValidImages;
   static QStringList kIgnoredExtensions;
 
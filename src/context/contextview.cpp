@@ -43,6 +43,7 @@
 #include <QLabel>
 #include <QTextEdit>
 #include <QSettings>
+#include <QTimer>
 #include <QResizeEvent>
 #include <QContextMenuEvent>
 #include <QDragEnterEvent>
@@ -66,6 +67,8 @@
 #include "contextalbum.h"
 
 const int ContextView::kWidgetSpacing = 50;
+// How long to wait after a song change before rebuilding the view, so rapid skipping through a playlist only processes the song settled on.
+const int ContextView::kSongChangeDebounceMs = 150;
 
 ContextView::ContextView(QWidget *parent)
     : QWidget(parent),
@@ -108,11 +111,16 @@ ContextView::ContextView(QWidget *parent)
       label_bitrate_(new QLabel(this)),
       label_ebur128_integrated_loudness_(new QLabel(this)),
       label_ebur128_loudness_range_(new QLabel(this)),
+      timer_song_changed_(new QTimer(this)),
       lyrics_tried_(false),
       lyrics_id_(-1) {
 
   setLayout(layout_container_);
 
+  timer_song_changed_->setSingleShot(true);
+  timer_song_changed_->setInterval(kSongChangeDebounceMs);
+  QObject::connect(timer_song_changed_, &QTimer::timeout, this, &ContextView::ApplyPendingSong);
+
   layout_container_->setObjectName(QStringLiteral("context-layout-container"));
   layout_container_->setContentsMargins(0, 0, 0, 0);
   layout_container_->addWidget(scrollarea_);
@@ -244,7 +252,7 @@ void ContextView::Init(Application *app, CollectionView *collectionview, AlbumCo
   album_cover_choice_controller_ = album_cover_choice_controller;
 
   widget_album_->Init(this, album_cover_choice_controller_);
-  lyrics_fetcher_ = new LyricsFetcher(app_->lyrics_providers(), this);
+  lyrics_fetcher_ = new LyricsFetcher(app_->lyrics_providers(), app_->lyrics_backend(), this);
 
   QObject::connect(collectionview_, &CollectionView::TotalSongCountUpdated_, this, &ContextView::UpdateNoSong);
   QObject::connect(collectionview_, &CollectionView::TotalArtistCountUpdated_, this, &ContextView::UpdateNoSong);
@@ -343,8 +351,15 @@ void ContextView::Playing() {}
 
 void ContextView::Stopped() {
 
+  timer_song_changed_->stop();
+  if (lyrics_fetcher_ && lyrics_id_ != -1) {
+    lyrics_fetcher_->Clear();
+    lyrics_id_ = -1;
+  }
+
   song_playing_ = Song();
   song_prev_ = Song();
+  song_pending_ = Song();
   lyrics_.clear();
   image_original_ = QImage();
   widget_album_->SetImage();
@@ -355,18 +370,37 @@ void ContextView::Error() {}
 
 void ContextView::SongChanged(const Song &song) {
 
-  if (widget_stacked_->currentWidget() == widget_play_ && song_playing_.is_valid() && song == song_playing_ && song.title() == song_playing_.title() && song.album() == song_playing_.album() && song.artist() == song_playing_.artist()) {
+  if (!timer_song_changed_->isActive() && widget_stacked_->currentWidget() == widget_play_ && song_playing_.is_valid() && song == song_playing_ && song.title() == song_playing_.title() && song.album() == song_playing_.album() && song.artist() == song_playing_.artist()) {
+    // Metadata update for the song already shown, only the changed labels are touched.
     UpdateSong(song);
+    SearchLyrics();
   }
   else {
-    song_prev_ = song_playing_;
-    song_playing_ = song;
-    lyrics_ = song.lyrics();
-    lyrics_id_ = -1;
-    lyrics_tried_ = false;
-    SetSong();
+    // Debounce the full rebuild, so skipping rapidly through a playlist only rebuilds the view (and fetches lyrics) for the song settled on.
+    song_pending_ = song;
+    if (lyrics_id_ != -1) {
+      // Cancel the in-flight lyric search for the song skipped away from.
+      lyrics_fetcher_->Clear();
+      lyrics_id_ = -1;
+    }
+    timer_song_changed_->start();
   }
 
+}
+
+void ContextView::ApplyPendingSong() {
+
+  const Song song = song_pending_;
+  song_pending_ = Song();
+  if (!song.is_valid()) return;
+
+  song_prev_ = song_playing_;
+  song_playing_ = song;
+  lyrics_ = song.lyrics();
+  lyrics_id_ = -1;
+  lyrics_tried_ = false;
+  SetSong();
+
   SearchLyrics();
 
 }
@@ -35,6 +35,7 @@
 
 class QMenu;
 class QLabel;
+class QTimer;
 class QStackedWidget;
 class QVBoxLayout;
 class QGridLayout;
@@ -84,6 +85,7 @@ class ContextView : public QWidget {
   void AlbumEnabledChanged();
 
  private slots:
+  void ApplyPendingSong();
   void ActionShowAlbum();
   void ActionShowData();
   void ActionShowLyrics();
@@ -102,6 +104,7 @@ class ContextView : public QWidget {
 
  private:
   static const int kWidgetSpacing;
+  static const int kSongChangeDebounceMs;
 
   Application *app_;
   CollectionView *collectionview_;
@@ -150,8 +153,11 @@ class ContextView : public QWidget {
   QLabel *label_ebur128_integrated_loudness_;
   QLabel *label_ebur128_loudness_range_;
 
+  QTimer *timer_song_changed_;
+
   Song song_playing_;
   Song song_prev_;
+  Song song_pending_;
   QImage image_original_;
   bool lyrics_tried_;
   qint64 lyrics_id_;
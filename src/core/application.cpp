@@ -38,6 +38,7 @@
 #include "tagreaderclient.h"
 #include "database.h"
 #include "taskmanager.h"
+#include "jobscheduler.h"
 #include "player.h"
 #include "networkaccessmanager.h"
 
@@ -59,6 +60,7 @@
 #include "covermanager/opentidalcoverprovider.h"
 
 #include "lyrics/lyricsproviders.h"
+#include "lyrics/lyricsbackend.h"
 #include "lyrics/geniuslyricsprovider.h"
 #include "lyrics/ovhlyricsprovider.h"
 #include "lyrics/lololyricsprovider.h"
@@ -126,6 +128,11 @@ class ApplicationImpl {
           return db;
         }),
         task_manager_([]() { return new TaskManager(); }),
+        job_scheduler_([app]() {
+          JobScheduler *job_scheduler = new JobScheduler();
+          job_scheduler->SetTaskManager(app->task_manager());
+          return job_scheduler;
+        }),
         player_([app]() { return new Player(app); }),
         network_([]() { return new NetworkAccessManager(); }),
         device_finders_([]() { return new DeviceFinders(); }),
@@ -181,6 +188,7 @@ class ApplicationImpl {
           lyrics_providers->ReloadSettings();
           return lyrics_providers;
         }),
+        lyrics_backend_([this, app]() { return new LyricsBackend(database_.ptr(), app); }),
         streaming_services_([app]() {
           StreamingServices *streaming_services = new StreamingServices();
 #ifdef HAVE_SUBSONIC
@@ -218,6 +226,7 @@ class ApplicationImpl {
   Lazy<TagReaderClient> tag_reader_client_;
   Lazy<Database> database_;
   Lazy<TaskManager> task_manager_;
+  Lazy<JobScheduler> job_scheduler_;
   Lazy<Player> player_;
   Lazy<NetworkAccessManager> network_;
   Lazy<DeviceFinders> device_finders_;
@@ -231,6 +240,7 @@ class ApplicationImpl {
   Lazy<AlbumCoverLoader> album_cover_loader_;
   Lazy<CurrentAlbumCoverLoader> current_albumcover_loader_;
   Lazy<LyricsProviders> lyrics_providers_;
+  Lazy<LyricsBackend> lyrics_backend_;
   Lazy<StreamingServices> streaming_services_;
   Lazy<RadioServices> radio_services_;
   Lazy<AudioScrobbler> scrobbler_;
@@ -347,6 +357,7 @@ void Application::OpenSettingsDialogAtPage(SettingsDialog::Page page) { emit Set
 SharedPtr<TagReaderClient> Application::tag_reader_client() const { return p_->tag_reader_client_.ptr(); }
 SharedPtr<Database> Application::database() const { return p_->database_.ptr(); }
 SharedPtr<TaskManager> Application::task_manager() const { return p_->task_manager_.ptr(); }
+SharedPtr<JobScheduler> Application::job_scheduler() const { return p_->job_scheduler_.ptr(); }
 SharedPtr<Player> Application::player() const { return p_->player_.ptr(); }
 SharedPtr<NetworkAccessManager> Application::network() const { return p_->network_.ptr(); }
 SharedPtr<DeviceFinders> Application::device_finders() const { return p_->device_finders_.ptr(); }
@@ -360,6 +371,7 @@ SharedPtr<AlbumCoverLoader> Application::album_cover_loader() const { return p_-
 SharedPtr<CoverProviders> Application::cover_providers() const { return p_->cover_providers_.ptr(); }
 SharedPtr<CurrentAlbumCoverLoader> Application::current_albumcover_loader() const { return p_->current_albumcover_loader_.ptr(); }
 SharedPtr<LyricsProviders> Application::lyrics_providers() const { return p_->lyrics_providers_.ptr(); }
+SharedPtr<LyricsBackend> Application::lyrics_backend() const { return p_->lyrics_backend_.ptr(); }
 SharedPtr<PlaylistBackend> Application::playlist_backend() const { return p_->playlist_backend_.ptr(); }
 SharedPtr<PlaylistManager> Application::playlist_manager() const { return p_->playlist_manager_.ptr(); }
 SharedPtr<StreamingServices> Application::streaming_services() const { return p_->streaming_services_.ptr(); }
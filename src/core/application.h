@@ -37,6 +37,7 @@
 class QThread;
 
 class TaskManager;
+class JobScheduler;
 class ApplicationImpl;
 class TagReaderClient;
 class Database;
@@ -56,6 +57,7 @@ class AlbumCoverLoader;
 class CurrentAlbumCoverLoader;
 class CoverProviders;
 class LyricsProviders;
+class LyricsBackend;
 class AudioScrobbler;
 class LastFMImport;
 class StreamingServices;
@@ -75,6 +77,7 @@ class Application : public QObject {
   SharedPtr<TagReaderClient> tag_reader_client() const;
   SharedPtr<Database> database() const;
   SharedPtr<TaskManager> task_manager() const;
+  SharedPtr<JobScheduler> job_scheduler() const;
   SharedPtr<Player> player() const;
   SharedPtr<NetworkAccessManager> network() const;
   SharedPtr<DeviceFinders> device_finders() const;
@@ -94,6 +97,7 @@ class Application : public QObject {
   SharedPtr<CurrentAlbumCoverLoader> current_albumcover_loader() const;
 
   SharedPtr<LyricsProviders> lyrics_providers() const;
+  SharedPtr<LyricsBackend> lyrics_backend() const;
 
   SharedPtr<AudioScrobbler> scrobbler() const;
 
@@ -81,7 +81,8 @@ const char *CommandlineOptions::kHelpText =
     "      --quiet                %31\n"
     "      --verbose              %32\n"
     "      --log-levels <levels>  %33\n"
-    "      --version              %34\n";
+    "      --profile-startup      %34\n"
+    "      --version              %35\n";
 
 const char *CommandlineOptions::kVersionText = "Strawberry %1";
 
@@ -101,6 +102,7 @@ CommandlineOptions::CommandlineOptions(int argc, char **argv)
       play_track_at_(-1),
       show_osd_(false),
       toggle_pretty_osd_(false),
+      profile_startup_(false),
       log_levels_(QLatin1String(logging::kDefaultLogLevels)) {
 
 #ifdef Q_OS_WIN32
@@ -164,6 +166,7 @@ bool CommandlineOptions::Parse() {
       {L"quiet", no_argument, nullptr, LongOptions::Quiet},
       {L"verbose", no_argument, nullptr, LongOptions::Verbose},
       {L"log-levels", required_argument, nullptr, LongOptions::LogLevels},
+      {L"profile-startup", no_argument, nullptr, LongOptions::ProfileStartup},
       {L"version", no_argument, nullptr, LongOptions::Version},
       {nullptr, 0, nullptr, 0}
 #else
@@ -195,6 +198,7 @@ bool CommandlineOptions::Parse() {
     { "quiet", no_argument, nullptr, LongOptions::Quiet },
     { "verbose", no_argument, nullptr, LongOptions::Verbose },
     { "log-levels", required_argument, nullptr, LongOptions::LogLevels },
+    { "profile-startup", no_argument, nullptr, LongOptions::ProfileStartup },
     { "version", no_argument, nullptr, LongOptions::Version },
     { nullptr, 0, nullptr, 0 }
 #endif
@@ -244,7 +248,8 @@ bool CommandlineOptions::Parse() {
                      QObject::tr("Resize the window"),
                      QObject::tr("Equivalent to --log-levels *:1"),
                      QObject::tr("Equivalent to --log-levels *:3"),
-                     QObject::tr("Comma separated list of class:level, level is 0-3"))
+                     QObject::tr("Comma separated list of class:level, level is 0-3"),
+                     QObject::tr("Record how long each startup phase takes and log the timeline"))
                 .arg(QObject::tr("Print out version information"));
 
         std::cout << translated_help_text.toLocal8Bit().constData();
@@ -310,6 +315,9 @@ bool CommandlineOptions::Parse() {
       case LongOptions::LogLevels:
         log_levels_ = OptArgToString(optarg);
         break;
+      case LongOptions::ProfileStartup:
+        profile_startup_ = true;
+        break;
       case LongOptions::Version:{
         QString version_text = QString::fromUtf8(kVersionText).arg(QLatin1String(STRAWBERRY_VERSION_DISPLAY));
         std::cout << version_text.toLocal8Bit().constData() << std::endl;
@@ -80,6 +80,7 @@ class CommandlineOptions {
   int play_track_at() const { return play_track_at_; }
   bool show_osd() const { return show_osd_; }
   bool toggle_pretty_osd() const { return toggle_pretty_osd_; }
+  bool profile_startup() const { return profile_startup_; }
   QList<QUrl> urls() const { return urls_; }
   QString language() const { return language_; }
   QString log_levels() const { return log_levels_; }
@@ -102,7 +103,8 @@ class CommandlineOptions {
     Version,
     VolumeIncreaseBy,
     VolumeDecreaseBy,
-    RestartOrPrevious
+    RestartOrPrevious,
+    ProfileStartup
   };
 
   void RemoveArg(const QString &starts_with, int count);
@@ -134,6 +136,7 @@ class CommandlineOptions {
   int play_track_at_;
   bool show_osd_;
   bool toggle_pretty_osd_;
+  bool profile_startup_;
   QString language_;
   QString log_levels_;
   QString playlist_name_;
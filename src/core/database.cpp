@@ -21,6 +21,7 @@
 
 #include "config.h"
 
+#include <memory>
 #include <utility>
 
 #include <sqlite3.h>
@@ -41,20 +42,37 @@
 #include <QSqlError>
 #include <QStandardPaths>
 #include <QScopeGuard>
+#include <QTimer>
+#include <QDateTime>
 
 #include "core/logging.h"
+#include "core/startuptimeline.h"
 #include "taskmanager.h"
 #include "database.h"
 #include "application.h"
+#include "player.h"
+#include "settings.h"
 #include "sqlquery.h"
 #include "scopedtransaction.h"
 
-const int Database::kSchemaVersion = 20;
+const int Database::kSchemaVersion = 25;
 
 namespace {
 constexpr char kDatabaseFilename[] = "strawberry.db";
 constexpr int kMinSupportedSchemaVersion = 10;
 constexpr char kMagicAllSongsTables[] = "%allsongstables";
+constexpr int kCheckpointIntervalSeconds = 60;
+
+// How often the maintenance scheduler checks whether it should run, and how long maintenance waits between runs.
+// Idle periods (no playback, no running tasks) are detected at check time, so a due run is simply retried on the next check if the application is busy.
+constexpr int kMaintenanceCheckIntervalSeconds = 30 * 60;
+constexpr qint64 kMaintenanceIntervalSeconds = 7 * 24 * 60 * 60;
+
+// Pages reclaimed per incremental vacuum step. Each step is a short write transaction, the database stays usable in between.
+constexpr int kIncrementalVacuumPagesPerStep = 2000;
+
+constexpr char kMaintenanceSettingsGroup[] = "Database";
+constexpr char kMaintenanceLastRunKey[] = "last_maintenance";
 }  // namespace
 
 int Database::sNextConnectionId = 1;
@@ -69,6 +87,8 @@ Database::Database(Application *app, QObject *parent, const QString &database_na
       injected_database_name_(database_name),
       query_hash_(0),
       startup_schema_version_(-1),
+      checkpoint_timer_(new QTimer(this)),
+      maintenance_timer_(new QTimer(this)),
       original_thread_(nullptr) {
 
   original_thread_ = thread();
@@ -80,9 +100,34 @@ Database::Database(Application *app, QObject *parent, const QString &database_na
 
   directory_ = QDir::toNativeSeparators(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
 
+  // Opt-in query tracing with a slow-query log, like a server database:
+  // STRAWBERRY_SQL_TRACE=1 enables it, STRAWBERRY_SQL_SLOW_MS overrides the slow-query threshold.
+  // The per-statement totals show up in the console dialog.
+  if (qEnvironmentVariableIsSet("STRAWBERRY_SQL_TRACE")) {
+    SqlQuery::SetTraceEnabled(true);
+    bool ok = false;
+    const int slow_query_threshold_ms = qEnvironmentVariableIntValue("STRAWBERRY_SQL_SLOW_MS", &ok);
+    if (ok && slow_query_threshold_ms > 0) {
+      SqlQuery::SetSlowQueryThresholdMs(slow_query_threshold_ms);
+    }
+  }
+
+  checkpoint_timer_->setInterval(kCheckpointIntervalSeconds * 1000);
+  checkpoint_timer_->setSingleShot(false);
+  QObject::connect(checkpoint_timer_, &QTimer::timeout, this, &Database::Checkpoint);
+
+  maintenance_timer_->setInterval(kMaintenanceCheckIntervalSeconds * 1000);
+  maintenance_timer_->setSingleShot(false);
+  QObject::connect(maintenance_timer_, &QTimer::timeout, this, &Database::MaintenanceCheck);
+
   QMutexLocker l(&mutex_);
   Connect();
 
+  checkpoint_timer_->start();
+
+  // Tests construct Database without an Application, idle detection needs the player and task manager.
+  if (app_ && injected_database_name_.isNull()) maintenance_timer_->start();
+
 }
 
 Database::~Database() {
@@ -109,8 +154,18 @@ void Database::Exit() {
 
 }
 
+QString Database::DatabaseFilePath() const {
+
+  if (!injected_database_name_.isNull()) return injected_database_name_;
+  if (!profile_database_file_.isEmpty()) return profile_database_file_;
+  return directory_ + QLatin1Char('/') + QLatin1String(kDatabaseFilename);
+
+}
+
 QSqlDatabase Database::Connect() {
 
+  const StartupTimeline::Phase phase("Database::Connect");
+
   QMutexLocker l(&connect_mutex_);
 
   // Create the directory if it doesn't exist
@@ -131,23 +186,60 @@ QSqlDatabase Database::Connect() {
     db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection_id);
   }
   if (db.isOpen()) {
-    return db;
+    if (db.databaseName() == DatabaseFilePath()) {
+      return db;
+    }
+    // A profile switch happened since this thread last connected, reopen against the active file.
+    {
+      QMutexLocker cache_locker(&cached_queries_mutex_);
+      cached_queries_.remove(connection_id);
+    }
+    db.close();
   }
   db.setConnectOptions(QStringLiteral("QSQLITE_BUSY_TIMEOUT=30000"));
   //qLog(Debug) << "Opened database with connection id" << connection_id;
 
-  if (injected_database_name_.isNull()) {
-    db.setDatabaseName(directory_ + QLatin1Char('/') + QLatin1String(kDatabaseFilename));
-  }
-  else {
-    db.setDatabaseName(injected_database_name_);
-  }
+  db.setDatabaseName(DatabaseFilePath());
 
   if (!db.open()) {
     app_->AddError(QStringLiteral("Database: ") + db.lastError().text());
     return db;
   }
 
+  // Use WAL so writers don't block readers.
+  // Automatic checkpointing is turned off, the WAL is merged back on a timer (see Checkpoint()) and when the connection is closed.
+  if (injected_database_name_.isNull()) {
+    // Incremental auto-vacuum lets scheduled maintenance (see PerformMaintenance()) reclaim free pages in small steps without a blocking VACUUM.
+    // This only takes effect when the database file is first created, existing databases keep their mode until a full VACUUM rebuilds them.
+    SqlQuery auto_vacuum_query(db);
+    auto_vacuum_query.prepare(QStringLiteral("PRAGMA auto_vacuum=INCREMENTAL"));
+    if (!auto_vacuum_query.Exec()) {
+      ReportErrors(auto_vacuum_query);
+    }
+    SqlQuery journal_mode_query(db);
+    journal_mode_query.prepare(QStringLiteral("PRAGMA journal_mode=WAL"));
+    if (journal_mode_query.Exec() && journal_mode_query.next()) {
+      if (journal_mode_query.value(0).toString().compare(QLatin1String("wal"), Qt::CaseInsensitive) == 0) {
+        SqlQuery synchronous_query(db);
+        synchronous_query.prepare(QStringLiteral("PRAGMA synchronous=NORMAL"));
+        if (!synchronous_query.Exec()) {
+          ReportErrors(synchronous_query);
+        }
+        SqlQuery autocheckpoint_query(db);
+        autocheckpoint_query.prepare(QStringLiteral("PRAGMA wal_autocheckpoint=0"));
+        if (!autocheckpoint_query.Exec()) {
+          ReportErrors(autocheckpoint_query);
+        }
+      }
+      else {
+        qLog(Warning) << "Could not enable WAL journal mode, journal mode is" << journal_mode_query.value(0).toString();
+      }
+    }
+    else {
+      ReportErrors(journal_mode_query);
+    }
+  }
+
   if (db.tables().count() == 0) {
     // Set up initial schema
     qLog(Info) << "Creating initial database schema";
@@ -198,17 +290,99 @@ QSqlDatabase Database::Connect() {
 
 }
 
+QSqlDatabase Database::ConnectRead() {
+
+  QMutexLocker l(&connect_mutex_);
+
+  const QString connection_id = QStringLiteral("%1_thread_%2_read").arg(connection_id_).arg(reinterpret_cast<quint64>(QThread::currentThread()));
+
+  // Try to find an existing connection for this thread
+  QSqlDatabase db;
+  if (QSqlDatabase::connectionNames().contains(connection_id)) {
+    db = QSqlDatabase::database(connection_id);
+  }
+  else {
+    db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection_id);
+  }
+  if (db.isOpen()) {
+    if (db.databaseName() == DatabaseFilePath()) {
+      return db;
+    }
+    // A profile switch happened since this thread last connected, reopen against the active file.
+    {
+      QMutexLocker cache_locker(&cached_queries_mutex_);
+      cached_queries_.remove(connection_id);
+    }
+    db.close();
+  }
+  db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=30000"));
+
+  db.setDatabaseName(DatabaseFilePath());
+
+  if (!db.open()) {
+    // The database may not exist yet, the write connection creates it and sets up the schema.
+    l.unlock();
+    return Connect();
+  }
+
+  // Attach the same external databases as Connect(), so queries see the same aliases on both connections.
+  const QStringList keys = attached_databases_.keys();
+  for (const QString &key : keys) {
+    QString filename = attached_databases_[key].filename_;
+
+    if (!injected_database_name_.isNull()) filename = injected_database_name_;
+
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("ATTACH DATABASE :filename AS :alias"));
+    q.BindValue(QStringLiteral(":filename"), filename);
+    q.BindValue(QStringLiteral(":alias"), key);
+    if (!q.Exec()) {
+      qFatal("Couldn't attach external database '%s'", key.toLatin1().constData());
+    }
+  }
+
+  return db;
+
+}
+
 void Database::Close() {
 
   QMutexLocker l(&connect_mutex_);
 
   const QString connection_id = QStringLiteral("%1_thread_%2").arg(connection_id_).arg(reinterpret_cast<quint64>(QThread::currentThread()));
 
+  {  // The read-only connection for this thread, if any, needs no checkpoint on close.
+    const QString read_connection_id = connection_id + QStringLiteral("_read");
+    {
+      QMutexLocker cache_locker(&cached_queries_mutex_);
+      cached_queries_.remove(read_connection_id);
+    }
+    if (QSqlDatabase::connectionNames().contains(read_connection_id)) {
+      {
+        QSqlDatabase db = QSqlDatabase::database(read_connection_id);
+        if (db.isOpen()) db.close();
+      }
+      QSqlDatabase::removeDatabase(read_connection_id);
+    }
+  }
+
+  {
+    QMutexLocker cache_locker(&cached_queries_mutex_);
+    cached_queries_.remove(connection_id);
+  }
+
   // Try to find an existing connection for this thread
   if (QSqlDatabase::connectionNames().contains(connection_id)) {
     {
       QSqlDatabase db = QSqlDatabase::database(connection_id);
       if (db.isOpen()) {
+        {  // Merge the remaining WAL content back into the database file before closing.
+          SqlQuery q(db);
+          q.prepare(QStringLiteral("PRAGMA wal_checkpoint(TRUNCATE)"));
+          if (!q.Exec()) {
+            ReportErrors(q);
+          }
+        }
         db.close();
         //qLog(Debug) << "Closed database with connection id" << connection_id;
       }
@@ -218,6 +392,152 @@ void Database::Close() {
 
 }
 
+SqlQuery *Database::GetCachedQuery(const QSqlDatabase &db, const QString &sql) {
+
+  QMutexLocker l(&cached_queries_mutex_);
+
+  QHash<QString, std::shared_ptr<SqlQuery>> &connection_cache = cached_queries_[db.connectionName()];
+  if (connection_cache.contains(sql)) {
+    return connection_cache.value(sql).get();
+  }
+
+  std::shared_ptr<SqlQuery> query = std::make_shared<SqlQuery>(db);
+  query->prepare(sql);
+  connection_cache.insert(sql, query);
+
+  return query.get();
+
+}
+
+void Database::Checkpoint() {
+
+  QMutexLocker l(&mutex_);
+  QSqlDatabase db(Connect());
+  if (!db.isOpen()) return;
+
+  // A passive checkpoint copies as much of the WAL as possible without blocking readers or writers.
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("PRAGMA wal_checkpoint(PASSIVE)"));
+  if (!q.Exec()) {
+    ReportErrors(q);
+  }
+
+}
+
+bool Database::IsIdle() const {
+
+  if (!app_) return false;
+
+  if (app_->player()->GetState() == EngineBase::State::Playing) return false;
+  if (!app_->task_manager()->GetTasks().isEmpty()) return false;
+
+  return true;
+
+}
+
+void Database::MaintenanceCheck() {
+
+  Settings s;
+  s.beginGroup(QLatin1String(kMaintenanceSettingsGroup));
+  const qint64 last_run = s.value(QLatin1String(kMaintenanceLastRunKey), 0).toLongLong();
+  s.endGroup();
+
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+  if (now - last_run < kMaintenanceIntervalSeconds) return;
+
+  // Not idle right now, try again on the next check.
+  if (!IsIdle()) return;
+
+  PerformMaintenance();
+
+  s.beginGroup(QLatin1String(kMaintenanceSettingsGroup));
+  s.setValue(QLatin1String(kMaintenanceLastRunKey), QDateTime::currentSecsSinceEpoch());
+  s.endGroup();
+
+}
+
+void Database::PerformMaintenance() {
+
+  qLog(Info) << "Starting database maintenance";
+
+  const int task_id = app_ ? app_->task_manager()->StartTask(tr("Database maintenance")) : -1;
+  const QScopeGuard task_finisher = qScopeGuard([this, task_id]() { if (task_id != -1) app_->task_manager()->SetTaskFinished(task_id); });
+
+  // PRAGMA optimize refreshes the statistics of any index the query planner has relied on since the connection was opened.
+  {
+    QMutexLocker l(&mutex_);
+    QSqlDatabase db(Connect());
+    if (!db.isOpen()) return;
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("PRAGMA optimize"));
+    if (!q.Exec()) {
+      ReportErrors(q);
+    }
+  }
+
+  // Reclaim free pages in small steps, each step is its own short transaction so readers and writers interleave.
+  // This needs incremental auto-vacuum, which only databases created after it became the default have - existing ones need one full VACUUM to convert.
+  qint64 freelist_count = 0;
+  {
+    QMutexLocker l(&mutex_);
+    QSqlDatabase db(Connect());
+    SqlQuery auto_vacuum_query(db);
+    auto_vacuum_query.prepare(QStringLiteral("PRAGMA auto_vacuum"));
+    if (auto_vacuum_query.Exec() && auto_vacuum_query.next() && auto_vacuum_query.value(0).toInt() == 2) {
+      SqlQuery freelist_query(db);
+      freelist_query.prepare(QStringLiteral("PRAGMA freelist_count"));
+      if (freelist_query.Exec() && freelist_query.next()) {
+        freelist_count = freelist_query.value(0).toLongLong();
+      }
+    }
+    else {
+      qLog(Debug) << "Database does not use incremental auto-vacuum, skipping free page reclamation.";
+    }
+  }
+  const qint64 freelist_total = freelist_count;
+  while (freelist_count > 0) {
+    // The application became busy or is shutting down - stop here, the remaining pages are reclaimed on the next run.
+    if (!IsIdle()) {
+      qLog(Debug) << "Interrupting database maintenance," << freelist_count << "free pages left.";
+      break;
+    }
+    QMutexLocker l(&mutex_);
+    QSqlDatabase db(Connect());
+    SqlQuery vacuum_query(db);
+    vacuum_query.prepare(QStringLiteral("PRAGMA incremental_vacuum(%1)").arg(kIncrementalVacuumPagesPerStep));
+    if (!vacuum_query.Exec()) {
+      ReportErrors(vacuum_query);
+      break;
+    }
+    SqlQuery freelist_query(db);
+    freelist_query.prepare(QStringLiteral("PRAGMA freelist_count"));
+    if (!freelist_query.Exec() || !freelist_query.next()) break;
+    const qint64 new_freelist_count = freelist_query.value(0).toLongLong();
+    if (new_freelist_count >= freelist_count) break;
+    freelist_count = new_freelist_count;
+    if (task_id != -1) app_->task_manager()->SetTaskProgress(task_id, static_cast<quint64>(freelist_total - freelist_count), static_cast<quint64>(freelist_total));
+  }
+
+  // Refresh the planner statistics, bounded so large tables are sampled instead of fully scanned.
+  {
+    QMutexLocker l(&mutex_);
+    QSqlDatabase db(Connect());
+    SqlQuery analysis_limit_query(db);
+    analysis_limit_query.prepare(QStringLiteral("PRAGMA analysis_limit=1000"));
+    if (!analysis_limit_query.Exec()) {
+      ReportErrors(analysis_limit_query);
+    }
+    SqlQuery analyze_query(db);
+    analyze_query.prepare(QStringLiteral("ANALYZE"));
+    if (!analyze_query.Exec()) {
+      ReportErrors(analyze_query);
+    }
+  }
+
+  qLog(Info) << "Database maintenance finished," << (freelist_total - freelist_count) << "of" << freelist_total << "free pages reclaimed";
+
+}
+
 int Database::SchemaVersion(QSqlDatabase *db) {
 
   // Get the database's schema version
@@ -277,6 +597,11 @@ void Database::RecreateAttachedDb(const QString &database_name) {
     }
   }
 
+  {
+    QMutexLocker cache_locker(&cached_queries_mutex_);
+    cached_queries_.clear();
+  }
+
   // We can't just re-attach the database now because it needs to be done for each thread.
   // Close all the database connections, so each thread will re-attach it when they next connect.
   const QStringList connection_names = QSqlDatabase::connectionNames();
@@ -324,6 +649,33 @@ void Database::DetachDatabase(const QString &database_name) {
 
 }
 
+void Database::SwitchDatabaseFile(const QString &filename) {
+
+  {
+    QMutexLocker l(&connect_mutex_);
+    if (filename == DatabaseFilePath()) return;
+  }
+
+  qLog(Info) << "Switching database to" << filename;
+
+  // Flush buffered writes and merge the WAL back into the old file, then close this thread's connections.
+  // Other threads' connections are reopened lazily, Connect() and ConnectRead() notice the stale file name.
+  {
+    QMutexLocker l(&mutex_);
+    Close();
+  }
+
+  {
+    QMutexLocker l(&connect_mutex_);
+    profile_database_file_ = filename;
+    // Let the first connection to the new file bring its schema up to date, just like at startup.
+    startup_schema_version_ = -1;
+  }
+
+  emit DatabaseSwitched();
+
+}
+
 void Database::UpdateDatabaseSchema(int version, QSqlDatabase &db) {
 
   QString filename;
@@ -26,10 +26,13 @@
 
 #include <sqlite3.h>
 
+#include <memory>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QMutex>
 #include <QMap>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
@@ -41,6 +44,7 @@
 #include "sqlquery.h"
 
 class QThread;
+class QTimer;
 class Application;
 
 class Database : public QObject {
@@ -64,9 +68,19 @@ class Database : public QObject {
 
   void ExitAsync();
   QSqlDatabase Connect();
+  // Per-thread read-only connection into the same database.
+  // Under WAL each statement reads from a consistent snapshot and never waits on the scan transaction,
+  // so pure read paths can use this without taking Mutex() and stay responsive during write bursts.
+  // Falls back to Connect() if the database cannot be opened read-only yet.
+  QSqlDatabase ConnectRead();
   void Close();
   void ReportErrors(const SqlQuery &query);
 
+  // Returns a prepared query for the given SQL on the given connection.
+  // Statements are cached per connection and compiled only once, callers bind new values and Exec() for every use.
+  // The returned query is owned by Database and freed when the connection is closed.
+  SqlQuery *GetCachedQuery(const QSqlDatabase &db, const QString &sql);
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
   QRecursiveMutex *Mutex() { return &mutex_; }
 #else
@@ -83,21 +97,34 @@ class Database : public QObject {
   void AttachDatabaseOnDbConnection(const QString &database_name, const AttachedDatabase &database, QSqlDatabase &db);
   void DetachDatabase(const QString &database_name);
 
+  // Switches the main database to a different file (a profile) without restarting the process.
+  // This thread's connections are checkpointed and closed immediately, other threads' connections
+  // are reopened against the new file the next time they call Connect() or ConnectRead().
+  // Emits DatabaseSwitched() so owners can drop per-profile state and reload their models.
+  void SwitchDatabaseFile(const QString &filename);
+
  signals:
   void ExitFinished();
   void Error(const QString &error);
   void Errors(const QStringList &errors);
+  void DatabaseSwitched();
 
  private slots:
   void Exit();
+  void Checkpoint();
+  void MaintenanceCheck();
 
  public slots:
   void DoBackup();
+  void PerformMaintenance();
 
  private:
   static int SchemaVersion(QSqlDatabase *db);
   void UpdateMainSchema(QSqlDatabase *db);
 
+  // The main database file connections open: the injected name for tests, the active profile file after a switch, or the default otherwise.
+  QString DatabaseFilePath() const;
+
   void ExecSchemaCommandsFromFile(QSqlDatabase &db, const QString &filename, int schema_version, bool in_transaction = false);
   void ExecSongTablesCommands(QSqlDatabase &db, const QStringList &song_tables, const QStringList &commands);
 
@@ -106,6 +133,7 @@ class Database : public QObject {
   QStringList SongsTables(QSqlDatabase &db, const int schema_version);
   bool IntegrityCheck(const QSqlDatabase &db);
   void BackupFile(const QString &filename);
+  bool IsIdle() const;
   static bool OpenDatabase(const QString &filename, sqlite3 **connection);
 
   Application *app_;
@@ -130,12 +158,25 @@ class Database : public QObject {
   // Used by tests
   QString injected_database_name_;
 
+  // Set by SwitchDatabaseFile(); empty means the default database file in directory_ is active.
+  QString profile_database_file_;
+
   uint query_hash_;
   QStringList query_cache_;
 
+  // Connection name -> SQL text -> prepared query
+  QHash<QString, QHash<QString, std::shared_ptr<SqlQuery>>> cached_queries_;
+  QMutex cached_queries_mutex_;
+
   // This is the schema version of Strawberry's DB from the app's last run.
   int startup_schema_version_;
 
+  // Periodically merges the WAL back into the main database file, since automatic checkpointing is disabled.
+  QTimer *checkpoint_timer_;
+
+  // Periodically checks whether scheduled maintenance (PRAGMA optimize, incremental vacuum, ANALYZE) is due and the application is idle (see MaintenanceCheck()).
+  QTimer *maintenance_timer_;
+
   QThread *original_thread_;
 
 };
@@ -93,7 +93,7 @@ bool FilesystemMusicStorage::CopyToStorage(const CopyJob &job, QString &error_te
       qLog(Error) << error_text;
     }
     else {
-      result = QFile::copy(src.absoluteFilePath(), dest.absoluteFilePath());
+      result = Utilities::CopyFileFast(src.absoluteFilePath(), dest.absoluteFilePath());
       if (!result) {
         error_text = QObject::tr("Could not copy file %1 to %2.").arg(src.absoluteFilePath(), dest.absoluteFilePath());
         qLog(Error) << error_text;
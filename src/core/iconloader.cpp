@@ -23,6 +23,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QIcon>
@@ -36,6 +37,13 @@
 #include "settings/appearancesettingspage.h"
 #include "iconloader.h"
 
+namespace {
+// Icons resolved by previous Load() calls, so the theme lookups and file probes only happen once per unique request.
+// QIcon is implicitly shared and caches its rasterized pixmaps per size and device pixel ratio internally,
+// so sharing one QIcon also shares the rendered pixmaps between all its users.
+QHash<QString, QIcon> sLoadedIcons;
+}  // namespace
+
 bool IconLoader::system_icons_ = false;
 bool IconLoader::custom_icons_ = false;
 
@@ -53,17 +61,34 @@ void IconLoader::Init() {
     custom_icons_ = true;
   }
 
+  // The icon sources may have changed, forget anything resolved with the old settings.
+  sLoadedIcons.clear();
+
 }
 
 QIcon IconLoader::Load(const QString &name, const bool system_icon, const int fixed_size, const int min_size, const int max_size) {
 
-  QIcon ret;
-
   if (name.isEmpty()) {
     qLog(Error) << "Icon name is empty!";
-    return ret;
+    return QIcon();
   }
 
+  const QString cache_key = QStringLiteral("%1-%2-%3-%4-%5").arg(name).arg(system_icon).arg(fixed_size).arg(min_size).arg(max_size);
+  if (sLoadedIcons.contains(cache_key)) {
+    return sLoadedIcons[cache_key];
+  }
+
+  const QIcon ret = LoadFromDisk(name, system_icon, fixed_size, min_size, max_size);
+  sLoadedIcons.insert(cache_key, ret);
+
+  return ret;
+
+}
+
+QIcon IconLoader::LoadFromDisk(const QString &name, const bool system_icon, const int fixed_size, const int min_size, const int max_size) {
+
+  QIcon ret;
+
   QList<int> sizes;
   if (fixed_size == 0) {
     sizes << 22 << 32 << 48 << 64 << 128;
@@ -29,6 +29,7 @@ class IconLoader {
   static QIcon Load(const QString &name, const bool system_icon = true, const int fixed_size = 0, const int min_size = 0, const int max_size = 0);
  private:
   explicit IconLoader() {}
+  static QIcon LoadFromDisk(const QString &name, const bool system_icon, const int fixed_size, const int min_size, const int max_size);
   static bool system_icons_;
   static bool custom_icons_;
 };
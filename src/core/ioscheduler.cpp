@@ -0,0 +1,173 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2018-2021, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtGlobal>
+
+#include <algorithm>
+
+#include <QMutexLocker>
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+#include <QStorageInfo>
+
+#include "core/logging.h"
+#include "core/settings.h"
+
+#include "ioscheduler.h"
+
+namespace {
+
+constexpr char kSettingsGroup[] = "io_scheduler";
+
+// Slots for filesystems that are not known to be rotational. Matches the parallelism background jobs already have today.
+constexpr int kDefaultSlots = 16;
+// Slots for filesystems on rotational disks, where concurrent bulk readers just make each other seek.
+constexpr int kRotationalSlots = 1;
+
+// Whether the block device (e.g. "/dev/sda2") is on a rotational disk. Unknown devices count as non-rotational,
+// so network mounts and platforms without the sysfs knob keep their current parallelism.
+bool IsRotational(const QString &device) {
+
+#ifdef Q_OS_LINUX
+  // Walk from the partition to the disk it is on: "sda2" -> "sda", "nvme0n1p1" -> "nvme0n1".
+  QString name = QFileInfo(device).fileName();
+  while (!name.isEmpty() && !QFile::exists(QStringLiteral("/sys/block/") + name)) {
+    name.chop(1);
+  }
+  if (name.isEmpty()) return false;
+
+  QFile file(QStringLiteral("/sys/block/") + name + QStringLiteral("/queue/rotational"));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+  return file.readAll().trimmed() == "1";
+#else
+  Q_UNUSED(device)
+  return false;
+#endif
+
+}
+
+}  // namespace
+
+IoScheduler *IoScheduler::Instance() {
+
+  static IoScheduler instance;
+  return &instance;
+
+}
+
+IoScheduler::IoScheduler() = default;
+
+QStringList IoScheduler::KeysForPaths(const QStringList &paths) {
+
+  QStringList keys;
+  for (const QString &path : paths) {
+    if (path.isEmpty()) continue;
+    const QStorageInfo storage_info(path);
+    QString key = QString::fromUtf8(storage_info.device());
+    if (key.isEmpty()) key = storage_info.rootPath();
+    if (key.isEmpty() || keys.contains(key)) continue;
+    keys << key;
+  }
+  std::sort(keys.begin(), keys.end());
+
+  return keys;
+
+}
+
+int IoScheduler::LimitForKey(const QString &key) {
+
+  if (!limits_.contains(key)) {
+    // A per-filesystem override in the configuration file wins over the rotational heuristic,
+    // so transfer parallelism can be tuned per device without rebuilding. Read when the filesystem is first used.
+    QString settings_key = key;
+    settings_key.replace(QLatin1Char('/'), QLatin1Char('_'));
+    Settings s;
+    s.beginGroup(QLatin1String(kSettingsGroup));
+    int limit = s.value(settings_key, 0).toInt();
+    s.endGroup();
+    if (limit <= 0) {
+      limit = IsRotational(key) ? kRotationalSlots : kDefaultSlots;
+      if (limit < kDefaultSlots) {
+        qLog(Debug) << "Serializing background I/O on rotational disk" << key;
+      }
+    }
+    else {
+      qLog(Debug) << "Using configured I/O slot limit" << limit << "for" << key;
+    }
+    limits_.insert(key, limit);
+  }
+
+  return limits_.value(key);
+
+}
+
+void IoScheduler::Acquire(const QStringList &paths) {
+
+  const QStringList keys = KeysForPaths(paths);
+  if (keys.isEmpty()) return;
+
+  const Qt::HANDLE thread_id = QThread::currentThreadId();
+
+  QMutexLocker l(&mutex_);
+  // Keys are sorted, so tokens are always taken in the same order and two jobs can't each hold what the other waits for.
+  for (const QString &key : keys) {
+    if (holders_.value(key).value(thread_id, 0) > 0) {
+      // This thread already holds a token for this filesystem, recursion doesn't wait.
+      ++holders_[key][thread_id];
+      continue;
+    }
+    const int limit = LimitForKey(key);
+    // Don't keep a reference into holders_ across the wait, other threads insert while we sleep.
+    while (holders_.value(key).count() >= limit) {
+      wait_.wait(&mutex_);
+    }
+    holders_[key][thread_id] = 1;
+  }
+
+}
+
+void IoScheduler::Release(const QStringList &paths) {
+
+  const QStringList keys = KeysForPaths(paths);
+  if (keys.isEmpty()) return;
+
+  const Qt::HANDLE thread_id = QThread::currentThreadId();
+
+  QMutexLocker l(&mutex_);
+  for (const QString &key : keys) {
+    QHash<Qt::HANDLE, int> &holders = holders_[key];
+    if (--holders[thread_id] <= 0) {
+      holders.remove(thread_id);
+      if (holders.isEmpty()) holders_.remove(key);
+    }
+  }
+  wait_.wakeAll();
+
+}
+
+IoScheduler::ScopedToken::ScopedToken(const QStringList &paths) : paths_(paths) {
+  Instance()->Acquire(paths_);
+}
+
+IoScheduler::ScopedToken::~ScopedToken() {
+  Instance()->Release(paths_);
+}
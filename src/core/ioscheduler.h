@@ -0,0 +1,73 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2018-2021, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IOSCHEDULER_H
+#define IOSCHEDULER_H
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+// Limits how many background jobs do bulk I/O on the same filesystem at once.
+// Rotational disks get one slot, since concurrent scans, transcodes and copies on the same spindle
+// multiply total runtime through seeking, solid state disks get enough slots to keep current behavior.
+// Jobs hold a token for one unit of work (a file copy, a subdirectory scan), not for their whole runtime,
+// so jobs on different filesystems never wait on each other.
+class IoScheduler {
+
+ public:
+  static IoScheduler *Instance();
+
+  // Blocks until the filesystems holding the given paths have a free slot each.
+  // Reentrant per thread: a thread that already holds a token for a filesystem gets it again without waiting,
+  // so recursive scan code can take tokens at every level. Must never be called from the UI thread.
+  void Acquire(const QStringList &paths);
+  void Release(const QStringList &paths);
+
+  // Holds tokens for the filesystems of the given paths for the lifetime of the object.
+  class ScopedToken {
+   public:
+    explicit ScopedToken(const QStringList &paths);
+    ~ScopedToken();
+   private:
+    QStringList paths_;
+    Q_DISABLE_COPY(ScopedToken)
+  };
+
+ private:
+  explicit IoScheduler();
+
+  // The filesystems the paths are on, deduplicated and sorted so concurrent multi-token acquires can't deadlock.
+  QStringList KeysForPaths(const QStringList &paths);
+  int LimitForKey(const QString &key);
+
+  QMutex mutex_;
+  QWaitCondition wait_;
+  // Threads holding tokens per filesystem, with a recursion count each. One thread counts once against the limit.
+  QHash<QString, QHash<Qt::HANDLE, int>> holders_;
+  // Slots per filesystem, determined once per filesystem.
+  QHash<QString, int> limits_;
+
+  Q_DISABLE_COPY(IoScheduler)
+};
+
+#endif  // IOSCHEDULER_H
@@ -0,0 +1,103 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <functional>
+#include <utility>
+
+#include <QObject>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QString>
+
+#include "taskmanager.h"
+#include "jobscheduler.h"
+
+namespace {
+
+// Queue priorities within the CPU pool, higher values are dequeued first.
+constexpr int kQueuePriorityInteractive = 1;
+constexpr int kQueuePriorityNormal = 0;
+
+class FunctionRunnable : public QRunnable {
+ public:
+  explicit FunctionRunnable(std::function<void()> job) : job_(std::move(job)) {}
+  void run() override { job_(); }
+
+ private:
+  std::function<void()> job_;
+};
+
+}  // namespace
+
+JobScheduler::JobScheduler(QObject *parent)
+    : QObject(parent),
+      pool_cpu_(new QThreadPool(this)),
+      pool_io_(new QThreadPool(this)) {
+
+  // Leave one core for the UI and the audio pipeline.
+  pool_cpu_->setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+  // I/O jobs spend their time blocked, a few threads are enough to keep the disks busy.
+  pool_io_->setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+
+}
+
+void JobScheduler::SetTaskManager(SharedPtr<TaskManager> task_manager) {
+
+  task_manager_ = task_manager;
+
+}
+
+QThreadPool *JobScheduler::PoolForPriority(const Priority priority) const {
+
+  return priority == Priority::Io ? pool_io_ : pool_cpu_;
+
+}
+
+int JobScheduler::QueuePriority(const Priority priority) {
+
+  return priority == Priority::Interactive ? kQueuePriorityInteractive : kQueuePriorityNormal;
+
+}
+
+void JobScheduler::Submit(const Priority priority, std::function<void()> job) {
+
+  Submit(priority, new FunctionRunnable(std::move(job)));
+
+}
+
+void JobScheduler::Submit(const Priority priority, QRunnable *runnable) {
+
+  PoolForPriority(priority)->start(runnable, QueuePriority(priority));
+
+}
+
+void JobScheduler::SubmitTracked(const QString &name, const Priority priority, std::function<void()> job) {
+
+  SharedPtr<TaskManager> task_manager = task_manager_;
+  const int task_id = task_manager ? task_manager->StartTask(name) : 0;
+
+  Submit(priority, [task_manager, task_id, job = std::move(job)]() {
+    job();
+    if (task_manager) task_manager->SetTaskFinished(task_id);
+  });
+
+}
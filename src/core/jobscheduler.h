@@ -0,0 +1,80 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef JOBSCHEDULER_H
+#define JOBSCHEDULER_H
+
+#include "config.h"
+
+#include <functional>
+
+#include <QObject>
+#include <QString>
+
+#include "shared_ptr.h"
+
+class QRunnable;
+class QThreadPool;
+class TaskManager;
+
+// Shared execution layer for background jobs.
+// Instead of each subsystem owning a private thread pool that together oversubscribe the cores when
+// several of them are busy at once, jobs are submitted here with a priority class and run on pools
+// sized once for the machine:
+//  - Interactive and Background share a CPU pool that leaves one core for the UI and audio,
+//    with Interactive jobs dequeued before Background ones.
+//  - Io jobs run on a small separate pool so blocking file work never holds a CPU slot.
+//    Jobs doing bulk I/O should additionally take IoScheduler tokens for per-filesystem throttling.
+// SubmitTracked() registers the job with the TaskManager so it shows up like any other task.
+class JobScheduler : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit JobScheduler(QObject *parent = nullptr);
+
+  enum class Priority {
+    Interactive,
+    Background,
+    Io
+  };
+
+  void SetTaskManager(SharedPtr<TaskManager> task_manager);
+
+  // Everything here is thread safe.
+  void Submit(const Priority priority, std::function<void()> job);
+  // Takes ownership of the runnable unless its auto deletion is disabled.
+  void Submit(const Priority priority, QRunnable *runnable);
+  // Like Submit(), but registers a task with the given name in the TaskManager and marks it finished when the job returns.
+  void SubmitTracked(const QString &name, const Priority priority, std::function<void()> job);
+
+  QThreadPool *cpu_pool() const { return pool_cpu_; }
+  QThreadPool *io_pool() const { return pool_io_; }
+
+ private:
+  QThreadPool *PoolForPriority(const Priority priority) const;
+  static int QueuePriority(const Priority priority);
+
+  SharedPtr<TaskManager> task_manager_;
+  QThreadPool *pool_cpu_;
+  QThreadPool *pool_io_;
+
+  Q_DISABLE_COPY(JobScheduler)
+};
+
+#endif  // JOBSCHEDULER_H
@@ -37,8 +37,10 @@
 #include <QThread>
 #include <QSortFilterProxyModel>
 #include <QByteArray>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QStandardPaths>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFontMetrics>
@@ -113,6 +115,7 @@
 #include "dialogs/errordialog.h"
 #include "dialogs/about.h"
 #include "dialogs/console.h"
+#include "widgets/debugoverlay.h"
 #include "dialogs/trackselectiondialog.h"
 #include "dialogs/edittagdialog.h"
 #include "dialogs/addstreamdialog.h"
@@ -121,6 +124,7 @@
 #include "dialogs/snapdialog.h"
 #include "organize/organizedialog.h"
 #include "widgets/fancytabwidget.h"
+#include "widgets/lazytabwidget.h"
 #include "widgets/playingwidget.h"
 #include "widgets/volumeslider.h"
 #include "widgets/fileview.h"
@@ -264,6 +268,7 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
         Console *console = new Console(app);
         return console;
       }),
+      debug_overlay_(nullptr),
       edit_tag_dialog_(std::bind(&MainWindow::CreateEditTagDialog, this)),
       album_cover_choice_controller_(new AlbumCoverChoiceController(this)),
 #ifdef HAVE_GLOBALSHORTCUTS
@@ -273,7 +278,8 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
       collection_view_(new CollectionViewContainer(this)),
       file_view_(new FileView(this)),
 #ifndef Q_OS_WIN
-      device_view_(new DeviceViewContainer(this)),
+      device_view_(nullptr),
+      device_view_tab_(new LazyTabWidget(this)),
 #endif
       playlist_list_(new PlaylistListContainer(this)),
       queue_view_(new QueueView(this)),
@@ -304,7 +310,8 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
         QObject::connect(add_stream_dialog, &AddStreamDialog::accepted, this, &MainWindow::AddStreamAccepted);
         return add_stream_dialog;
       }),
-      smartplaylists_view_(new SmartPlaylistsViewContainer(app, this)),
+      smartplaylists_view_(nullptr),
+      smartplaylists_view_tab_(new LazyTabWidget(this)),
 #ifdef HAVE_SUBSONIC
       subsonic_view_(new StreamingSongsView(app_, app->streaming_services()->ServiceBySource(Song::Source::Subsonic), QLatin1String(SubsonicSettingsPage::kSettingsGroup), SettingsDialog::Page::Subsonic, this)),
 #endif
@@ -317,7 +324,8 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
 #ifdef HAVE_QOBUZ
       qobuz_view_(new StreamingTabsView(app_, app->streaming_services()->ServiceBySource(Song::Source::Qobuz), QLatin1String(QobuzSettingsPage::kSettingsGroup), SettingsDialog::Page::Qobuz, this)),
 #endif
-      radio_view_(new RadioViewContainer(this)),
+      radio_view_(nullptr),
+      radio_view_tab_(new LazyTabWidget(this)),
       lastfm_import_dialog_(new LastFMImportDialog(app_->lastfm_import(), this)),
       collection_show_all_(nullptr),
       collection_show_duplicates_(nullptr),
@@ -381,16 +389,41 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   // Initialize the search widget
   StyleHelper::setBaseColor(palette().color(QPalette::Highlight).darker());
 
+  // Set up the views that are only built when their tab is first opened, so they don't add to the startup time.
+  smartplaylists_view_tab_->SetFactory([this]() {
+    smartplaylists_view_ = new SmartPlaylistsViewContainer(app_, this);
+    QObject::connect(smartplaylists_view_, &SmartPlaylistsViewContainer::AddToPlaylist, this, &MainWindow::AddToPlaylist);
+    return smartplaylists_view_;
+  });
+
+  radio_view_tab_->SetFactory([this]() {
+    radio_view_ = new RadioViewContainer(this);
+    radio_view_->view()->setModel(app_->radio_services()->sort_model());
+    QObject::connect(radio_view_, &RadioViewContainer::Refresh, &*app_->radio_services(), &RadioServices::RefreshChannels);
+    QObject::connect(radio_view_->view(), &RadioView::GetChannels, &*app_->radio_services(), &RadioServices::GetChannels);
+    QObject::connect(radio_view_->view(), &RadioView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+    return radio_view_;
+  });
+
+#ifndef Q_OS_WIN
+  device_view_tab_->SetFactory([this]() {
+    device_view_ = new DeviceViewContainer(this);
+    device_view_->view()->SetApplication(app_);
+    QObject::connect(device_view_->view(), &DeviceView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+    return device_view_;
+  });
+#endif
+
   // Add tabs to the fancy tab widget
   ui_->tabs->AddTab(context_view_, QStringLiteral("context"), IconLoader::Load(QStringLiteral("strawberry"), true, 0, 32), tr("Context"));
   ui_->tabs->AddTab(collection_view_, QStringLiteral("collection"), IconLoader::Load(QStringLiteral("library-music"), true, 0, 32), tr("Collection"));
   ui_->tabs->AddTab(queue_view_, QStringLiteral("queue"), IconLoader::Load(QStringLiteral("footsteps"), true, 0, 32), tr("Queue"));
   ui_->tabs->AddTab(playlist_list_, QStringLiteral("playlists"), IconLoader::Load(QStringLiteral("view-media-playlist"), true, 0, 32), tr("Playlists"));
-  ui_->tabs->AddTab(smartplaylists_view_, QStringLiteral("smartplaylists"), IconLoader::Load(QStringLiteral("view-media-playlist"), true, 0, 32), tr("Smart playlists"));
+  ui_->tabs->AddTab(smartplaylists_view_tab_, QStringLiteral("smartplaylists"), IconLoader::Load(QStringLiteral("view-media-playlist"), true, 0, 32), tr("Smart playlists"));
   ui_->tabs->AddTab(file_view_, QStringLiteral("files"), IconLoader::Load(QStringLiteral("document-open"), true, 0, 32), tr("Files"));
-  ui_->tabs->AddTab(radio_view_, QStringLiteral("radios"), IconLoader::Load(QStringLiteral("radio"), true, 0, 32), tr("Radios"));
+  ui_->tabs->AddTab(radio_view_tab_, QStringLiteral("radios"), IconLoader::Load(QStringLiteral("radio"), true, 0, 32), tr("Radios"));
 #ifndef Q_OS_WIN
-  ui_->tabs->AddTab(device_view_, QStringLiteral("devices"), IconLoader::Load(QStringLiteral("device"), true, 0, 32), tr("Devices"));
+  ui_->tabs->AddTab(device_view_tab_, QStringLiteral("devices"), IconLoader::Load(QStringLiteral("device"), true, 0, 32), tr("Devices"));
 #endif
 #ifdef HAVE_SUBSONIC
   ui_->tabs->AddTab(subsonic_view_, QStringLiteral("subsonic"), IconLoader::Load(QStringLiteral("subsonic"), true, 0, 32), tr("Subsonic"));
@@ -433,15 +466,10 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
 
   collection_view_->view()->setModel(app_->collection()->model()->filter());
   collection_view_->view()->SetApplication(app_);
-#ifndef Q_OS_WIN
-  device_view_->view()->SetApplication(app_);
-#endif
   playlist_list_->SetApplication(app_);
 
   organize_dialog_->SetDestinationModel(app_->collection()->model()->directory_model());
 
-  radio_view_->view()->setModel(app_->radio_services()->sort_model());
-
   // Icons
   qLog(Debug) << "Creating UI";
 
@@ -669,11 +697,6 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   QObject::connect(album_cover_choice_controller_->search_cover_auto_action(), &QAction::triggered, this, &MainWindow::SearchCoverAutomatically);
   QObject::connect(album_cover_choice_controller_->search_cover_auto_action(), &QAction::toggled, this, &MainWindow::ToggleSearchCoverAuto);
 
-#ifndef Q_OS_WIN
-  // Devices connections
-  QObject::connect(device_view_->view(), &DeviceView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-#endif
-
   // Collection filter widget
   QActionGroup *collection_view_group = new QActionGroup(this);
 
@@ -730,10 +753,6 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   QObject::connect(spotify_view_->search_view(), &StreamingSearchView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
 #endif
 
-  QObject::connect(radio_view_, &RadioViewContainer::Refresh, &*app_->radio_services(), &RadioServices::RefreshChannels);
-  QObject::connect(radio_view_->view(), &RadioView::GetChannels, &*app_->radio_services(), &RadioServices::GetChannels);
-  QObject::connect(radio_view_->view(), &RadioView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-
   // Playlist menu
   QObject::connect(playlist_menu_, &QMenu::aboutToHide, this, &MainWindow::PlaylistMenuHidden);
   playlist_play_pause_ = playlist_menu_->addAction(tr("Play"), this, &MainWindow::PlaylistPlay);
@@ -847,8 +866,9 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   QObject::connect(ui_->tabs, &FancyTabWidget::CurrentChanged, this, &MainWindow::TabSwitched);
 
   // Context
-  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, context_view_, &ContextView::SongChanged);
-  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongMetadataChanged, context_view_, &ContextView::SongChanged);
+  // Queued, so rebuilding the context view (lyrics searches, widget relayout) runs on the next event loop iteration instead of inside the track change itself.
+  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, context_view_, &ContextView::SongChanged, Qt::QueuedConnection);
+  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongMetadataChanged, context_view_, &ContextView::SongChanged, Qt::QueuedConnection);
   QObject::connect(&*app_->player(), &Player::PlaylistFinished, context_view_, &ContextView::Stopped);
   QObject::connect(&*app_->player(), &Player::Playing, context_view_, &ContextView::Playing);
   QObject::connect(&*app_->player(), &Player::Stopped, context_view_, &ContextView::Stopped);
@@ -870,6 +890,7 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
 #ifdef HAVE_MOODBAR
   // Moodbar connections
   QObject::connect(&*app_->moodbar_controller(), &MoodbarController::CurrentMoodbarDataChanged, ui_->track_slider->moodbar_style(), &MoodbarProxyStyle::SetMoodbarData);
+  QObject::connect(&*app_->moodbar_controller(), &MoodbarController::CurrentWaveformDataChanged, ui_->track_slider->moodbar_style(), &MoodbarProxyStyle::SetWaveformData);
 #endif
 
   // Playing widget
@@ -885,6 +906,8 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   QObject::connect(this, &MainWindow::SearchCoverInProgress, ui_->widget_playing, &PlayingWidget::SearchCoverInProgress);
 
   QObject::connect(ui_->action_console, &QAction::triggered, this, &MainWindow::ShowConsole);
+  QObject::connect(ui_->action_debug_overlay, &QAction::toggled, this, &MainWindow::ToggleDebugOverlay);
+  QObject::connect(ui_->action_audio_diagnostics, &QAction::triggered, this, &MainWindow::SaveAudioDiagnostics);
   PlayingWidgetPositionChanged(ui_->widget_playing->show_above_status_bar());
 
   StyleSheetLoader *css_loader = new StyleSheetLoader(this);
@@ -906,9 +929,6 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   QObject::connect(app_->playlist_manager()->sequence(), &PlaylistSequence::RepeatModeChanged, osd_, &OSDBase::RepeatModeChanged);
   QObject::connect(app_->playlist_manager()->sequence(), &PlaylistSequence::ShuffleModeChanged, osd_, &OSDBase::ShuffleModeChanged);
 
-  // Smart playlists
-  QObject::connect(smartplaylists_view_, &SmartPlaylistsViewContainer::AddToPlaylist, this, &MainWindow::AddToPlaylist);
-
   ScrobbleButtonVisibilityChanged(app_->scrobbler()->scrobble_button());
   LoveButtonVisibilityChanged(app_->scrobbler()->love_button());
   ScrobblingEnabledChanged(app_->scrobbler()->enabled());
@@ -1247,8 +1267,8 @@ void MainWindow::ReloadAllSettings() {
   file_view_->ReloadSettings();
   queue_view_->ReloadSettings();
   playlist_list_->ReloadSettings();
-  smartplaylists_view_->ReloadSettings();
-  radio_view_->ReloadSettings();
+  if (smartplaylists_view_) smartplaylists_view_->ReloadSettings();
+  if (radio_view_) radio_view_->ReloadSettings();
   app_->streaming_services()->ReloadSettings();
   app_->radio_services()->ReloadSettings();
   app_->cover_providers()->ReloadSettings();
@@ -1465,7 +1485,8 @@ void MainWindow::SongChanged(const Song &song) {
   }
 #endif
 
-  SendNowPlaying();
+  // Deferred so the now playing submission to the scrobble services doesn't run inside the track change; the OSD and window title above stay immediate.
+  QTimer::singleShot(0, this, &MainWindow::SendNowPlaying);
 
   const bool enable_change_art = song.is_collection_song() && !song.effective_albumartist().isEmpty() && !song.album().isEmpty();
   album_cover_choice_controller_->show_cover_action()->setEnabled(song.has_valid_art() && !song.art_unset());
@@ -3041,6 +3062,7 @@ void MainWindow::AutoCompleteTags() {
     track_selection_dialog_ = make_unique<TrackSelectionDialog>();
     track_selection_dialog_->set_save_on_close(true);
 
+    QObject::connect(&*tag_fetcher_, &TagFetcher::ResultUpdated, &*track_selection_dialog_, &TrackSelectionDialog::FetchTagUpdated, Qt::QueuedConnection);
     QObject::connect(&*tag_fetcher_, &TagFetcher::ResultAvailable, &*track_selection_dialog_, &TrackSelectionDialog::FetchTagFinished, Qt::QueuedConnection);
     QObject::connect(&*tag_fetcher_, &TagFetcher::Progress, &*track_selection_dialog_, &TrackSelectionDialog::FetchTagProgress);
     QObject::connect(&*track_selection_dialog_, &TrackSelectionDialog::accepted, this, &MainWindow::AutoCompleteTagsAccepted);
@@ -3115,6 +3137,43 @@ void MainWindow::ShowConsole() {
 
 }
 
+void MainWindow::SaveAudioDiagnostics() {
+
+  const QString snapshot = app_->player()->engine()->DebugPipelineSnapshot();
+  if (snapshot.isEmpty()) {
+    QMessageBox::information(this, tr("Audio diagnostics"), tr("No audio pipeline is active. Start playback and try again."));
+    return;
+  }
+
+  const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  QDir().mkpath(directory);
+  const QString filename = directory + QStringLiteral("/audio-diagnostics-") + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")) + QStringLiteral(".txt");
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    QMessageBox::warning(this, tr("Audio diagnostics"), tr("Could not write to %1").arg(filename));
+    return;
+  }
+  file.write(snapshot.toUtf8());
+  file.close();
+
+  qLog(Info) << "Audio diagnostics written to" << filename;
+  QMessageBox::information(this, tr("Audio diagnostics"), tr("Audio diagnostics written to %1").arg(filename));
+
+}
+
+void MainWindow::ToggleDebugOverlay(const bool checked) {
+
+  if (checked && !debug_overlay_) {
+    debug_overlay_ = new DebugOverlay(this);
+  }
+  else if (!checked && debug_overlay_) {
+    debug_overlay_->deleteLater();
+    debug_overlay_ = nullptr;
+  }
+
+}
+
 void MainWindow::keyPressEvent(QKeyEvent *e) {
 
   if (e->key() == Qt::Key_Space) {
@@ -64,6 +64,7 @@
 
 class About;
 class Console;
+class DebugOverlay;
 class AlbumCoverManager;
 class Application;
 class ContextView;
@@ -73,6 +74,7 @@ class AlbumCoverChoiceController;
 class CommandlineOptions;
 #ifndef Q_OS_WIN
 class DeviceViewContainer;
+class LazyTabWidget;
 #endif
 class EditTagDialog;
 class Equalizer;
@@ -248,6 +250,8 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   void HandleNotificationPreview(const OSDBase::Behaviour type, const QString &line1, const QString &line2);
 
   void ShowConsole();
+  void ToggleDebugOverlay(const bool checked);
+  void SaveAudioDiagnostics();
 
   void LoadCoverFromFile();
   void SaveCoverToFile();
@@ -309,6 +313,7 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   OSDBase *osd_;
   Lazy<About> about_dialog_;
   Lazy<Console> console_;
+  DebugOverlay *debug_overlay_;
   Lazy<EditTagDialog> edit_tag_dialog_;
   AlbumCoverChoiceController *album_cover_choice_controller_;
 
@@ -318,7 +323,9 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   CollectionViewContainer *collection_view_;
   FileView *file_view_;
 #ifndef Q_OS_WIN
+  // Created by device_view_tab_ when the devices tab is first opened.
   DeviceViewContainer *device_view_;
+  LazyTabWidget *device_view_tab_;
 #endif
   PlaylistListContainer *playlist_list_;
   QueueView *queue_view_;
@@ -339,7 +346,9 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   ScopedPtr<TrackSelectionDialog> track_selection_dialog_;
   PlaylistItemPtrList autocomplete_tag_items_;
 
+  // Created by smartplaylists_view_tab_ when the smart playlists tab is first opened.
   SmartPlaylistsViewContainer *smartplaylists_view_;
+  LazyTabWidget *smartplaylists_view_tab_;
 
 #ifdef HAVE_SUBSONIC
   StreamingSongsView *subsonic_view_;
@@ -354,7 +363,9 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   StreamingTabsView *qobuz_view_;
 #endif
 
+  // Created by radio_view_tab_ when the radios tab is first opened.
   RadioViewContainer *radio_view_;
+  LazyTabWidget *radio_view_tab_;
 
   LastFMImportDialog *lastfm_import_dialog_;
 
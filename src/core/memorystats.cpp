@@ -0,0 +1,91 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <atomic>
+#include <utility>
+
+#include <QtGlobal>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include "logging.h"
+#include "memorystats.h"
+#include "threadsafenetworkdiskcache.h"
+
+namespace MemoryStats {
+
+std::atomic<qint64> song_instances(0);
+std::atomic<qint64> playlist_item_instances(0);
+std::atomic<qint64> scaled_cover_cache_bytes(0);
+
+namespace {
+
+QString MB(const qint64 bytes) {
+  return QStringLiteral("%1 MB").arg(static_cast<double>(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+// Current and peak RSS from the kernel, so subsystem numbers can be read against the whole process.
+void AppendRss(QStringList &lines) {
+
+#ifdef Q_OS_LINUX
+  QFile file(QStringLiteral("/proc/self/status"));
+  if (file.open(QIODevice::ReadOnly)) {
+    const QStringList status_lines = QString::fromLatin1(file.readAll()).split(QLatin1Char('\n'));
+    for (const QString &status_line : status_lines) {
+      if (status_line.startsWith(QLatin1String("VmRSS:")) || status_line.startsWith(QLatin1String("VmHWM:"))) {
+        lines << status_line.simplified();
+      }
+    }
+  }
+#else
+  Q_UNUSED(lines)
+#endif
+
+}
+
+}  // namespace
+
+QString Report() {
+
+  QStringList lines;
+
+  AppendRss(lines);
+
+  lines << QStringLiteral("Songs in memory: %1").arg(song_instances.load(std::memory_order_relaxed));
+  lines << QStringLiteral("Playlist items: %1").arg(playlist_item_instances.load(std::memory_order_relaxed));
+  lines << QStringLiteral("Scaled cover cache: %1").arg(MB(scaled_cover_cache_bytes.load(std::memory_order_relaxed)));
+  lines << QStringLiteral("Network disk cache: %1 (on disk)").arg(MB(ThreadSafeNetworkDiskCache::TotalCacheSize()));
+
+  return lines.join(QLatin1Char('\n'));
+
+}
+
+void Log() {
+
+  const QStringList lines = Report().split(QLatin1Char('\n'));
+  for (const QString &line : lines) {
+    qLog(Info) << line;
+  }
+
+}
+
+}  // namespace MemoryStats
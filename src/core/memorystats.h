@@ -0,0 +1,62 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include "config.h"
+
+#include <atomic>
+
+#include <QtGlobal>
+#include <QString>
+
+// Per-subsystem memory accounting. The counters are relaxed atomics updated from the owning
+// subsystems, so they are cheap enough to stay on in production builds; the report is shown
+// in the console dialog and can be written to the log.
+namespace MemoryStats {
+
+// Live Song instances, counting every copy of the shared data.
+extern std::atomic<qint64> song_instances;
+
+// Live playlist items across all playlists.
+extern std::atomic<qint64> playlist_item_instances;
+
+// Bytes held by the album cover loader's in-memory scaled image cache.
+extern std::atomic<qint64> scaled_cover_cache_bytes;
+
+// Multi-line report with the counters above plus process RSS and the network disk cache size.
+QString Report();
+
+// Writes the report to the log.
+void Log();
+
+// Counts live instances of the class it is a member of, including copies and shared data detaches.
+template<std::atomic<qint64> *counter>
+class InstanceCounter {
+ public:
+  InstanceCounter() { counter->fetch_add(1, std::memory_order_relaxed); }
+  InstanceCounter(const InstanceCounter&) { counter->fetch_add(1, std::memory_order_relaxed); }
+  InstanceCounter &operator=(const InstanceCounter&) { return *this; }
+  ~InstanceCounter() { counter->fetch_sub(1, std::memory_order_relaxed); }
+};
+
+}  // namespace MemoryStats
+
+#endif  // MEMORYSTATS_H
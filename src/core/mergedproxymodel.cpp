@@ -45,6 +45,7 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/operators.hpp>
 
+using boost::multi_index::hashed_non_unique;
 using boost::multi_index::hashed_unique;
 using boost::multi_index::identity;
 using boost::multi_index::indexed_by;
@@ -58,19 +59,31 @@ size_t hash_value(const QModelIndex &idx) { return qHash(idx); }
 namespace {
 
 struct Mapping {
-  explicit Mapping(const QModelIndex &_source_index) : source_index(_source_index) {}
+  explicit Mapping(const QModelIndex &_source_index) : source_index(_source_index), model(_source_index.model()) {}
 
   QModelIndex source_index;
+  const QAbstractItemModel *model;
 };
 
 struct tag_by_source {};
 struct tag_by_pointer {};
+struct tag_by_model {};
+
+// Whether idx is one of the rows [start, end] under parent, or a descendant of one of them.
+bool IsInRemovedRange(QModelIndex idx, const QModelIndex &parent, const int start, const int end) {
+
+  for (; idx.isValid(); idx = idx.parent()) {
+    if (idx.parent() == parent && idx.row() >= start && idx.row() <= end) return true;
+  }
+  return false;
+
+}
 
 }  // namespace
 
 class MergedProxyModelPrivate {
  private:
-  using MappingContainer = multi_index_container<Mapping*, indexed_by<hashed_unique<tag<tag_by_source>, member<Mapping, QModelIndex, &Mapping::source_index>>, ordered_unique<tag<tag_by_pointer>, identity<Mapping*>>>>;
+  using MappingContainer = multi_index_container<Mapping*, indexed_by<hashed_unique<tag<tag_by_source>, member<Mapping, QModelIndex, &Mapping::source_index>>, ordered_unique<tag<tag_by_pointer>, identity<Mapping*>>, hashed_non_unique<tag<tag_by_model>, member<Mapping, const QAbstractItemModel*, &Mapping::model>>>>;
 
  public:
   MappingContainer mappings_;
@@ -129,17 +142,12 @@ void MergedProxyModel::RemoveSubModel(const QModelIndex &source_parent) {
     }
   }
 
-  // Delete all the mappings that reference the submodel
-  auto it = p_->mappings_.get<tag_by_pointer>().begin();
-  auto end = p_->mappings_.get<tag_by_pointer>().end();
-  while (it != end) {
-    if ((*it)->source_index.model() == submodel) {
-      delete *it;
-      it = p_->mappings_.get<tag_by_pointer>().erase(it);
-    }
-    else {
-      ++it;
-    }
+  // Delete the mappings that reference the submodel, without touching the mappings of the other models.
+  auto &mappings_by_model = p_->mappings_.get<tag_by_model>();
+  const auto range = mappings_by_model.equal_range(submodel);
+  for (auto it = range.first; it != range.second;) {
+    delete *it;
+    it = mappings_by_model.erase(it);
   }
 
 }
@@ -203,17 +211,12 @@ void MergedProxyModel::SubModelAboutToBeReset() {
     }
   }
 
-  // Delete all the mappings that reference the submodel
-  auto it = p_->mappings_.get<tag_by_pointer>().begin();
-  auto end = p_->mappings_.get<tag_by_pointer>().end();
-  while (it != end) {
-    if ((*it)->source_index.model() == submodel) {
-      delete *it;
-      it = p_->mappings_.get<tag_by_pointer>().erase(it);
-    }
-    else {
-      ++it;
-    }
+  // Delete the mappings that reference the submodel, without touching the mappings of the other models.
+  auto &mappings_by_model = p_->mappings_.get<tag_by_model>();
+  const auto range = mappings_by_model.equal_range(submodel);
+  for (auto it = range.first; it != range.second;) {
+    delete *it;
+    it = mappings_by_model.erase(it);
   }
 
 }
@@ -254,7 +257,26 @@ void MergedProxyModel::RowsInserted(const QModelIndex&, int, int) {
 }
 
 void MergedProxyModel::RowsAboutToBeRemoved(const QModelIndex &source_parent, int start, int end) {
-  beginRemoveRows(mapFromSource(GetActualSourceParent(source_parent, qobject_cast<QAbstractItemModel*>(sender()))), start, end);
+
+  QAbstractItemModel *model = qobject_cast<QAbstractItemModel*>(sender());
+
+  beginRemoveRows(mapFromSource(GetActualSourceParent(source_parent, model)), start, end);
+
+  // Drop the mappings for the removed rows and their descendants while their source indexes are still valid,
+  // so the container doesn't accumulate stale entries.
+  // Stale proxy indexes still held by the views map to an invalid index in mapToSource().
+  auto &mappings_by_model = p_->mappings_.get<tag_by_model>();
+  const auto range = mappings_by_model.equal_range(model);
+  for (auto it = range.first; it != range.second;) {
+    if (IsInRemovedRange((*it)->source_index, source_parent, start, end)) {
+      delete *it;
+      it = mappings_by_model.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
 }
 
 void MergedProxyModel::RowsRemoved(const QModelIndex&, int, int) {
@@ -40,6 +40,7 @@
 #include <QDBusMessage>
 #include <QDBusArgument>
 #include <QDBusObjectPath>
+#include <QTimer>
 
 #include "core/logging.h"
 
@@ -98,10 +99,25 @@ constexpr char kMprisObjectPath[] = "/org/mpris/MediaPlayer2";
 constexpr char kServiceName[] = "org.mpris.MediaPlayer2.strawberry";
 constexpr char kFreedesktopPath[] = "org.freedesktop.DBus.Properties";
 
+// Minimum time between Seeked signals, so dragging the seek slider doesn't wake every applet on the session bus for each step.
+constexpr int kSeekedRateLimitMs = 100;
+
 Mpris2::Mpris2(Application *app, QObject *parent)
     : QObject(parent),
       app_(app),
-      app_name_(QCoreApplication::applicationName()) {
+      app_name_(QCoreApplication::applicationName()),
+      timer_emit_property_changes_(new QTimer(this)),
+      timer_seeked_(new QTimer(this)),
+      pending_seek_position_(0),
+      has_pending_seek_(false) {
+
+  timer_emit_property_changes_->setSingleShot(true);
+  timer_emit_property_changes_->setInterval(0);
+  QObject::connect(timer_emit_property_changes_, &QTimer::timeout, this, &Mpris2::FlushPropertyChanges);
+
+  timer_seeked_->setSingleShot(true);
+  timer_seeked_->setInterval(kSeekedRateLimitMs);
+  QObject::connect(timer_seeked_, &QTimer::timeout, this, &Mpris2::SeekedRateLimitExpired);
 
   new Mpris2Root(this);
   new Mpris2TrackList(this);
@@ -122,10 +138,11 @@ Mpris2::Mpris2(Application *app, QObject *parent)
 
   QObject::connect(&*app_->player()->engine(), &EngineBase::StateChanged, this, &Mpris2::EngineStateChanged);
   QObject::connect(&*app_->player(), &Player::VolumeChanged, this, &Mpris2::VolumeChanged);
-  QObject::connect(&*app_->player(), &Player::Seeked, this, &Mpris2::Seeked);
+  QObject::connect(&*app_->player(), &Player::Seeked, this, &Mpris2::PlayerSeeked);
 
   QObject::connect(&*app_->playlist_manager(), &PlaylistManager::PlaylistManagerInitialized, this, &Mpris2::PlaylistManagerInitialized);
-  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &Mpris2::CurrentSongChanged);
+  // Queued, so the D-Bus metadata marshalling happens after the track change has been handled.
+  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &Mpris2::CurrentSongChanged, Qt::QueuedConnection);
   QObject::connect(&*app_->playlist_manager(), &PlaylistManager::PlaylistChanged, this, &Mpris2::PlaylistChangedSlot);
   QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentChanged, this, &Mpris2::PlaylistCollectionChanged);
 
@@ -195,12 +212,48 @@ void Mpris2::EmitNotification(const QString &name, const QVariant &value) {
 
 void Mpris2::EmitNotification(const QString &name, const QVariant &value, const QString &mprisEntity) {
 
-  QDBusMessage msg = QDBusMessage::createSignal(QLatin1String(kMprisObjectPath), QLatin1String(kFreedesktopPath), QStringLiteral("PropertiesChanged"));
-  QVariantMap map;
-  map.insert(name, value);
-  QVariantList args = QVariantList() << mprisEntity << map << QStringList();
-  msg.setArguments(args);
-  QDBusConnection::sessionBus().send(msg);
+  // Queue the change and emit one consolidated PropertiesChanged per interface on the next event loop turn,
+  // so seeking and track transitions don't produce a burst of separate signals.
+  pending_property_changes_[mprisEntity].insert(name, value);
+  if (!timer_emit_property_changes_->isActive()) {
+    timer_emit_property_changes_->start();
+  }
+
+}
+
+void Mpris2::FlushPropertyChanges() {
+
+  const QMap<QString, QVariantMap> pending = pending_property_changes_;
+  pending_property_changes_.clear();
+
+  for (QMap<QString, QVariantMap>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+    QDBusMessage msg = QDBusMessage::createSignal(QLatin1String(kMprisObjectPath), QLatin1String(kFreedesktopPath), QStringLiteral("PropertiesChanged"));
+    msg.setArguments(QVariantList() << it.key() << it.value() << QStringList());
+    QDBusConnection::sessionBus().send(msg);
+  }
+
+}
+
+void Mpris2::PlayerSeeked(const qint64 position) {
+
+  if (timer_seeked_->isActive()) {
+    pending_seek_position_ = position;
+    has_pending_seek_ = true;
+    return;
+  }
+
+  emit Seeked(position);
+  timer_seeked_->start();
+
+}
+
+void Mpris2::SeekedRateLimitExpired() {
+
+  if (has_pending_seek_) {
+    has_pending_seek_ = false;
+    emit Seeked(pending_seek_position_);
+    timer_seeked_->start();
+  }
 
 }
 
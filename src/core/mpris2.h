@@ -44,6 +44,7 @@
 class Application;
 class Song;
 class Playlist;
+class QTimer;
 
 using TrackMetadata = QList<QVariantMap>;
 using Track_Ids = QList<QDBusObjectPath>;
@@ -210,6 +211,9 @@ class Mpris2 : public QObject {
   void AlbumCoverLoaded(const Song &song, const AlbumCoverLoaderResult &result = AlbumCoverLoaderResult());
   void EngineStateChanged(EngineBase::State newState);
   void VolumeChanged();
+  void FlushPropertyChanges();
+  void PlayerSeeked(const qint64 position);
+  void SeekedRateLimitExpired();
 
   void PlaylistManagerInitialized();
   void CurrentSongChanged(const Song &song);
@@ -238,6 +242,15 @@ class Mpris2 : public QObject {
   QString desktopfilepath_;
   QVariantMap last_metadata_;
 
+  // Property changes queued for the next event loop turn, keyed on interface so each interface gets one consolidated PropertiesChanged.
+  QMap<QString, QVariantMap> pending_property_changes_;
+  QTimer *timer_emit_property_changes_;
+
+  // Rate limiting for the Seeked signal while the user drags the seek slider.
+  QTimer *timer_seeked_;
+  qint64 pending_seek_position_;
+  bool has_pending_seek_;
+
 };
 
 }  // namespace mpris
@@ -36,19 +36,91 @@ MultiSortFilterProxy::MultiSortFilterProxy(QObject *parent)
     : QSortFilterProxyModel(parent) {}
 
 void MultiSortFilterProxy::AddSortSpec(int role, Qt::SortOrder order) {
+
   sorting_ << SortSpec(role, order);
+  sort_key_cache_.clear();
+
+}
+
+void MultiSortFilterProxy::setSourceModel(QAbstractItemModel *source_model) {
+
+  if (sourceModel()) {
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::dataChanged, this, &MultiSortFilterProxy::SourceDataChanged);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::modelAboutToBeReset, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsAboutToBeInserted, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsAboutToBeRemoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsAboutToBeMoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::layoutAboutToBeChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+  }
+
+  sort_key_cache_.clear();
+
+  // Connected before the base class sees the model, and to the "about to" variants for structural changes:
+  // slots run in connection order, so the stale keys are gone before the proxy's internal handlers
+  // re-sort the affected rows through lessThan() with dynamic sorting enabled.
+  if (source_model) {
+    QObject::connect(source_model, &QAbstractItemModel::dataChanged, this, &MultiSortFilterProxy::SourceDataChanged);
+    QObject::connect(source_model, &QAbstractItemModel::modelAboutToBeReset, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeInserted, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeMoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(source_model, &QAbstractItemModel::layoutAboutToBeChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+  }
+
+  QSortFilterProxyModel::setSourceModel(source_model);
+
+}
+
+void MultiSortFilterProxy::SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right) {
+
+  // Only the changed rows need new sort keys.
+  // Keys are dropped for every column of the row since the sort roles are not tied to the changed columns.
+  const QModelIndex parent = top_left.parent();
+  const int columns = sourceModel()->columnCount(parent);
+  for (int row = top_left.row(); row <= bottom_right.row(); ++row) {
+    for (int column = 0; column < columns; ++column) {
+      sort_key_cache_.remove(sourceModel()->index(row, column, parent));
+    }
+  }
+
+}
+
+void MultiSortFilterProxy::InvalidateSortKeys() {
+
+  // Row numbers shifted, cached keys no longer belong to the indexes they were extracted for.
+  sort_key_cache_.clear();
+
+}
+
+const QList<QVariant> &MultiSortFilterProxy::SortKey(const QModelIndex &idx) const {
+
+  auto it = sort_key_cache_.find(idx);
+  if (it == sort_key_cache_.end()) {
+    QList<QVariant> values;
+    values.reserve(sorting_.count());
+    for (const SortSpec &spec : sorting_) {
+      values << idx.data(spec.first);
+    }
+    it = sort_key_cache_.insert(idx, values);
+  }
+
+  return it.value();
+
 }
 
 bool MultiSortFilterProxy::lessThan(const QModelIndex &left, const QModelIndex &right) const {
 
-  for (const SortSpec &spec : sorting_) {
-    const int ret = Compare(left.data(spec.first), right.data(spec.first));
+  const QList<QVariant> &left_key = SortKey(left);
+  const QList<QVariant> &right_key = SortKey(right);
+
+  for (qsizetype i = 0; i < sorting_.count(); ++i) {
+    const int ret = Compare(left_key[i], right_key[i]);
 
     if (ret < 0) {
-      return spec.second == Qt::AscendingOrder;
+      return sorting_[i].second == Qt::AscendingOrder;
     }
     if (ret > 0) {
-      return spec.second != Qt::AscendingOrder;
+      return sorting_[i].second != Qt::AscendingOrder;
     }
   }
 
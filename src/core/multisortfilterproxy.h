@@ -24,8 +24,10 @@
 #include "config.h"
 
 #include <QSortFilterProxyModel>
+#include <QHash>
 #include <QList>
 #include <QPair>
+#include <QPersistentModelIndex>
 #include <QVariant>
 
 class QObject;
@@ -38,14 +40,26 @@ class MultiSortFilterProxy : public QSortFilterProxyModel {
 
   void AddSortSpec(int role, Qt::SortOrder order = Qt::AscendingOrder);
 
+  void setSourceModel(QAbstractItemModel *source_model) override;
+
  protected:
   bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 
+ private slots:
+  void SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right);
+  void InvalidateSortKeys();
+
  private:
   int Compare(const QVariant &left, const QVariant &right) const;
+  const QList<QVariant> &SortKey(const QModelIndex &idx) const;
 
   using SortSpec = QPair<int, Qt::SortOrder>;
   QList<SortSpec> sorting_;
+
+  // The values for every sort role of a source row, extracted once per sort instead of once per comparison.
+  // Invalidated when the source model changes shape or data.
+  // Keyed by persistent index so an entry can never be returned for a different row after rows shift.
+  mutable QHash<QPersistentModelIndex, QList<QVariant>> sort_key_cache_;
 };
 
 #endif  // MULTISORTFILTERPROXY_H
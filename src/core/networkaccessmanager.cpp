@@ -26,22 +26,97 @@
 #include <QCoreApplication>
 #include <QIODevice>
 #include <QByteArray>
+#include <QList>
+#include <QSet>
 #include <QString>
+#include <QUrl>
+#include <QDateTime>
+#include <QTimer>
+#include <QAbstractNetworkCache>
 #include <QNetworkAccessManager>
+#include <QNetworkCacheMetaData>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 
 #include "networkaccessmanager.h"
 #include "threadsafenetworkdiskcache.h"
 
+namespace {
+// How long after the first host is queued the warmup connections are opened,
+// late enough that the startup I/O and the first paint are out of the way.
+constexpr int kWarmUpDelayMs = 2000;
+}  // namespace
+
 NetworkAccessManager::NetworkAccessManager(QObject *parent)
-    : QNetworkAccessManager(parent) {
+    : QNetworkAccessManager(parent),
+      warmup_scheduled_(false) {
 
   setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
   setCache(new ThreadSafeNetworkDiskCache(this));
 
 }
 
+void NetworkAccessManager::PreConnect(const QUrl &url) {
+
+  if (!url.isValid() || url.host().isEmpty()) return;
+
+  if (url.scheme() == QLatin1String("https")) {
+    connectToHostEncrypted(url.host(), static_cast<quint16>(url.port(443)));
+  }
+  else if (url.scheme() == QLatin1String("http")) {
+    connectToHost(url.host(), static_cast<quint16>(url.port(80)));
+  }
+
+}
+
+void NetworkAccessManager::AddWarmUpUrl(const QUrl &url) {
+
+  if (!url.isValid() || url.host().isEmpty()) return;
+
+  const QString host_key = QStringLiteral("%1:%2").arg(url.host()).arg(url.port(url.scheme() == QLatin1String("https") ? 443 : 80));
+  if (warmup_hosts_.contains(host_key)) return;
+  warmup_hosts_.insert(host_key);
+  warmup_urls_ << url;
+
+  if (!warmup_scheduled_) {
+    warmup_scheduled_ = true;
+    QTimer::singleShot(kWarmUpDelayMs, this, &NetworkAccessManager::WarmUpConnections);
+  }
+
+}
+
+void NetworkAccessManager::WarmUpConnections() {
+
+  warmup_scheduled_ = false;
+
+  const QList<QUrl> urls = warmup_urls_;
+  warmup_urls_.clear();
+  for (const QUrl &url : urls) {
+    PreConnect(url);
+  }
+
+}
+
+void NetworkAccessManager::CacheResponse(const QUrl &url, const QByteArray &data, const int expiry_secs) {
+
+  QAbstractNetworkCache *network_cache = cache();
+  if (!network_cache || !url.isValid() || expiry_secs <= 0) return;
+
+  QNetworkCacheMetaData metadata;
+  metadata.setUrl(url);
+  metadata.setSaveToDisk(true);
+  metadata.setExpirationDate(QDateTime::currentDateTime().addSecs(expiry_secs));
+  QNetworkCacheMetaData::AttributesMap attributes;
+  attributes.insert(QNetworkRequest::HttpStatusCodeAttribute, 200);
+  metadata.setAttributes(attributes);
+
+  QIODevice *device = network_cache->prepare(metadata);
+  if (!device) return;
+  device->write(data);
+  network_cache->insert(device);
+
+}
+
 QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) {
 
   QByteArray user_agent;
@@ -65,6 +140,13 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     new_request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
   }
 
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+  // Allow HTTP/2 unless the caller decided already, so the many small API requests to the same host multiplex over one connection.
+  if (!request.attribute(QNetworkRequest::Http2AllowedAttribute).isValid()) {
+    new_request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+  }
+#endif
+
   return QNetworkAccessManager::createRequest(op, new_request, outgoingData);
 
 }
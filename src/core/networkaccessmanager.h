@@ -26,20 +26,52 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QList>
+#include <QSet>
+#include <QString>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
+#include <QUrl>
 
 class QIODevice;
 class QNetworkReply;
 
+class QByteArray;
+
 class NetworkAccessManager : public QNetworkAccessManager {
   Q_OBJECT
 
  public:
   explicit NetworkAccessManager(QObject *parent = nullptr);
 
+  // Request attribute holding the number of seconds the response stays valid in the disk cache (see CacheResponse()).
+  static constexpr QNetworkRequest::Attribute kCacheExpirySecsAttribute = QNetworkRequest::User;
+
+  // Opens the TCP and TLS connection to the host ahead of the first request, so it doesn't pay for the handshakes.
+  void PreConnect(const QUrl &url);
+
+  // Queues the host of the URL for connection warmup shortly after startup.
+  // Enabled online services register their API endpoint here, so the first cover fetch, scrobble or lyrics search
+  // of a session doesn't pay for DNS resolution and the TLS handshake.
+  // Hosts are deduplicated and the connections are opened in the background once, a little after startup,
+  // so the warmup doesn't compete with the collection and playlist loading.
+  void AddWarmUpUrl(const QUrl &url);
+
+ private slots:
+  void WarmUpConnections();
+
+  // Stores a response in the disk cache with a synthetic expiration date.
+  // The service APIs send no cache headers or validators, so the cache never stores their replies on its own;
+  // the request classes use this for idempotent requests so browsing the same listings again is served from disk.
+  void CacheResponse(const QUrl &url, const QByteArray &data, const int expiry_secs);
+
  protected:
   QNetworkReply *createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) override;
+
+ private:
+  QList<QUrl> warmup_urls_;
+  QSet<QString> warmup_hosts_;
+  bool warmup_scheduled_;
 };
 
 #endif  // NETWORKACCESSMANAGER_H
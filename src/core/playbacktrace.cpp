@@ -0,0 +1,85 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QStringList>
+
+#include "playbacktrace.h"
+
+namespace PlaybackTrace {
+
+namespace {
+
+// Enough to cover several track changes with all their pipeline transitions without growing unbounded.
+constexpr int kMaxEvents = 256;
+
+struct Event {
+  qint64 nsecs = 0;
+  const char *stage = nullptr;
+  QString detail;
+};
+
+QMutex sMutex;
+QList<Event> sEvents;
+QElapsedTimer sClock;
+
+}  // namespace
+
+void Record(const char *stage, const QString &detail) {
+
+  QMutexLocker locker(&sMutex);
+
+  if (!sClock.isValid()) sClock.start();
+
+  Event event;
+  event.nsecs = sClock.nsecsElapsed();
+  event.stage = stage;
+  event.detail = detail;
+  sEvents << event;
+  while (sEvents.count() > kMaxEvents) sEvents.removeFirst();
+
+}
+
+QStringList Report() {
+
+  QMutexLocker locker(&sMutex);
+
+  QStringList lines;
+  lines.reserve(sEvents.count());
+  qint64 previous_nsecs = -1;
+  for (const Event &event : std::as_const(sEvents)) {
+    const double msecs = static_cast<double>(event.nsecs) / 1e6;
+    const QString delta = previous_nsecs < 0 ? QStringLiteral("        ") : QStringLiteral("%1").arg(static_cast<double>(event.nsecs - previous_nsecs) / 1e6, 8, 'f', 1);
+    lines << QStringLiteral("%1 %2 %3 %4").arg(msecs, 12, 'f', 1).arg(delta).arg(QLatin1String(event.stage), -28).arg(event.detail);
+    previous_nsecs = event.nsecs;
+  }
+
+  return lines;
+
+}
+
+}  // namespace PlaybackTrace
@@ -0,0 +1,44 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PLAYBACKTRACE_H
+#define PLAYBACKTRACE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+
+// Timestamped audit trail for the playback control path:
+// player commands (play, next, seek), engine calls, pipeline state changes and the first audio buffer each record an event here,
+// so the latency between a key press and audible effect can be broken down stage by stage.
+// Events go into a small rolling buffer that the console dialog renders on demand; recording is always on and cheap.
+// Thread safe, events arrive from the UI thread, the pipeline bus and the audio streaming threads.
+namespace PlaybackTrace {
+
+// Records one transition. stage is a static string naming the point in the chain, detail is optional context (URL, state names, offset).
+void Record(const char *stage, const QString &detail = QString());
+
+// The buffered events, oldest first, with wall-clock offsets and the delta to the previous event.
+QStringList Report();
+
+}  // namespace PlaybackTrace
+
+#endif  // PLAYBACKTRACE_H
@@ -37,6 +37,7 @@
 #include <QSettings>
 
 #include "core/logging.h"
+#include "core/playbacktrace.h"
 #include "core/settings.h"
 #include "utilities/timeconstants.h"
 
@@ -75,6 +76,13 @@ using std::make_shared;
 
 const char *Player::kSettingsGroup = "Player";
 
+namespace {
+// How many upcoming tracks to resolve stream URLs for in parallel.
+constexpr int kStreamUrlPrefetchCount = 3;
+// How long a resolved stream URL is trusted. The streaming services don't say when their URLs expire, so be conservative and resolve again well before any of them are known to.
+constexpr qint64 kStreamUrlCacheExpirySecs = 240;
+}  // namespace
+
 Player::Player(Application *app, QObject *parent)
     : PlayerInterface(parent),
       app_(app),
@@ -251,6 +259,9 @@ void Player::HandleLoadResult(const UrlHandler::LoadResult &result) {
     loading_async_.removeAll(result.media_url_);
   }
 
+  // Remember the resolved stream URL, so prefetched tracks play without resolving it again.
+  CacheStreamUrl(result);
+
   // Might've been an async load, so check we're still on the same item
   const int current_row = app_->playlist_manager()->active()->current_row();
   if (current_row == -1) {
@@ -376,7 +387,68 @@ void Player::HandleLoadResult(const UrlHandler::LoadResult &result) {
 
 }
 
-void Player::Next() { NextInternal(EngineBase::TrackChangeType::Manual, Playlist::AutoScroll::Always); }
+void Player::CacheStreamUrl(const UrlHandler::LoadResult &result) {
+
+  if (result.type_ != UrlHandler::LoadResult::Type::TrackAvailable || !result.stream_url_.isValid()) return;
+
+  ResolvedStreamUrl entry;
+  entry.result_ = result;
+  entry.resolved_ = QDateTime::currentDateTime();
+  stream_url_cache_.insert(result.media_url_, entry);
+
+}
+
+bool Player::GetCachedStreamUrl(const QUrl &media_url, UrlHandler::LoadResult *result) {
+
+  QMap<QUrl, ResolvedStreamUrl>::const_iterator it = stream_url_cache_.constFind(media_url);
+  if (it == stream_url_cache_.constEnd()) return false;
+
+  if (it.value().resolved_.secsTo(QDateTime::currentDateTime()) >= kStreamUrlCacheExpirySecs) {
+    stream_url_cache_.remove(media_url);
+    return false;
+  }
+
+  *result = it.value().result_;
+
+  return true;
+
+}
+
+void Player::PrefetchUpcomingStreamUrls() {
+
+  Playlist *active_playlist = app_->playlist_manager()->active();
+  if (!active_playlist || active_playlist->current_row() == -1) return;
+
+  const QList<int> rows = active_playlist->next_rows(kStreamUrlPrefetchCount);
+  for (const int row : rows) {
+    PlaylistItemPtr item = active_playlist->item_at(row);
+    if (!item) continue;
+    const QUrl url = item->StreamUrl();
+    if (!url_handlers_.contains(url.scheme())) continue;
+    if (loading_async_.contains(url)) continue;
+    UrlHandler::LoadResult cached_result;
+    if (GetCachedStreamUrl(url, &cached_result)) continue;
+    qLog(Debug) << "Prefetching stream URL for" << url;
+    UrlHandler::LoadResult result = url_handlers_[url.scheme()]->StartLoading(url);
+    // Asynchronous results are stored by HandleLoadResult, and played or preloaded there when the track became the current or next one in the meantime.
+    // Errors are not surfaced here, the track is resolved again when it's actually played and any error is shown then.
+    if (result.type_ == UrlHandler::LoadResult::Type::WillLoadAsynchronously) {
+      loading_async_ << url;
+    }
+    else {
+      CacheStreamUrl(result);
+    }
+  }
+
+}
+
+void Player::Next() {
+
+  PlaybackTrace::Record("player next");
+
+  NextInternal(EngineBase::TrackChangeType::Manual, Playlist::AutoScroll::Always);
+
+}
 
 void Player::NextInternal(const EngineBase::TrackChangeFlags change, const Playlist::AutoScroll autoscroll) {
 
@@ -499,6 +571,8 @@ void Player::TrackEnded() {
 
 void Player::PlayPause(const quint64 offset_nanosec, const Playlist::AutoScroll autoscroll) {
 
+  PlaybackTrace::Record("player play/pause");
+
   switch (engine_->state()) {
     case EngineBase::State::Paused:
       UnPause();
@@ -592,7 +666,13 @@ bool Player::PreviousWouldRestartTrack() const {
 
 }
 
-void Player::Previous() { PreviousItem(EngineBase::TrackChangeType::Manual); }
+void Player::Previous() {
+
+  PlaybackTrace::Record("player previous");
+
+  PreviousItem(EngineBase::TrackChangeType::Manual);
+
+}
 
 void Player::PreviousItem(const EngineBase::TrackChangeFlags change) {
 
@@ -750,13 +830,21 @@ void Player::PlayAt(const int index, const quint64 offset_nanosec, EngineBase::T
 
     stream_change_type_ = change;
     autoscroll_ = autoscroll;
-    HandleLoadResult(url_handlers_[url.scheme()]->StartLoading(url));
+    UrlHandler::LoadResult cached_result;
+    if (GetCachedStreamUrl(url, &cached_result)) {
+      HandleLoadResult(cached_result);
+    }
+    else {
+      HandleLoadResult(url_handlers_[url.scheme()]->StartLoading(url));
+    }
   }
   else {
     qLog(Debug) << "Playing song" << current_item_->Metadata().title() << url << "position" << offset_nanosec;
     engine_->Play(current_item_->Url(), url, change, current_item_->Metadata().has_cue(), current_item_->effective_beginning_nanosec(), current_item_->effective_end_nanosec(), offset_nanosec, current_item_->effective_ebur128_integrated_loudness_lufs());
   }
 
+  PrefetchUpcomingStreamUrls();
+
 }
 
 void Player::CurrentMetadataChanged(const Song &metadata) {
@@ -768,6 +856,8 @@ void Player::CurrentMetadataChanged(const Song &metadata) {
 
 void Player::SeekTo(const quint64 seconds) {
 
+  PlaybackTrace::Record("player seek", QStringLiteral("%1s").arg(seconds));
+
   const qint64 length_nanosec = engine_->length_nanosec();
 
   // If the length is 0 then either there is no song playing, or the song isn't seekable.
@@ -909,7 +999,10 @@ void Player::TrackAboutToEnd() {
   if (url_handlers_.contains(url.scheme())) {
     if (loading_async_.contains(url)) return;
     autoscroll_ = Playlist::AutoScroll::Maybe;
-    UrlHandler::LoadResult result = url_handlers_[url.scheme()]->StartLoading(url);
+    UrlHandler::LoadResult result;
+    if (!GetCachedStreamUrl(url, &result)) {
+      result = url_handlers_[url.scheme()]->StartLoading(url);
+    }
     switch (result.type_) {
       case UrlHandler::LoadResult::Type::Error:
         emit Error(result.error_);
@@ -216,6 +216,11 @@ class Player : public PlayerInterface {
 
   void UnPause();
 
+  // Starts resolving stream URLs for the next few upcoming tracks in parallel, so gapless playback across streaming services does not stall on URL resolution when the track changes.
+  void PrefetchUpcomingStreamUrls();
+  void CacheStreamUrl(const UrlHandler::LoadResult &result);
+  bool GetCachedStreamUrl(const QUrl &media_url, UrlHandler::LoadResult *result);
+
  private:
   Application *app_;
   SharedPtr<EngineBase> engine_;
@@ -236,6 +241,14 @@ class Player : public PlayerInterface {
   QMap<QString, UrlHandler*> url_handlers_;
 
   QList<QUrl> loading_async_;
+
+  // Stream URLs that have already been resolved, with the time they were resolved.
+  // These URLs expire, so entries are only trusted for a short time.
+  struct ResolvedStreamUrl {
+    UrlHandler::LoadResult result_;
+    QDateTime resolved_;
+  };
+  QMap<QUrl, ResolvedStreamUrl> stream_url_cache_;
   uint volume_;
   uint volume_before_mute_;
   QDateTime last_pressed_previous_;
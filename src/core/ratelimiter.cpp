@@ -0,0 +1,123 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2018-2021, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QHash>
+#include <QString>
+#include <QUrl>
+#include <QDateTime>
+
+#include "logging.h"
+#include "ratelimiter.h"
+
+namespace {
+// Hosts that are never configured with SetLimits() get a bucket of this size and refill rate.
+constexpr double kDefaultBurst = 10.0;
+constexpr double kDefaultTokensPerSecond = 10.0;
+// How long a bucket stays paused after a 429 reply.
+constexpr qint64 kBackoffMs = 5000;
+// How fast a bucket that was shrunk by 429 replies grows back to its configured size, in tokens per second.
+constexpr double kCapacityRecoveryPerSecond = 0.1;
+}  // namespace
+
+QMutex RateLimiter::sMutex;
+QHash<QString, RateLimiter::Bucket> RateLimiter::sBuckets;
+
+RateLimiter::Bucket &RateLimiter::GetBucket(const QString &host) {
+
+  if (!sBuckets.contains(host)) {
+    Bucket bucket;
+    bucket.tokens = kDefaultBurst;
+    bucket.capacity = kDefaultBurst;
+    bucket.burst = kDefaultBurst;
+    bucket.tokens_per_second = kDefaultTokensPerSecond;
+    bucket.last_update_ms = 0;
+    bucket.blocked_until_ms = 0;
+    sBuckets.insert(host, bucket);
+  }
+
+  return sBuckets[host];
+
+}
+
+void RateLimiter::Refill(Bucket &bucket, const qint64 now_ms) {
+
+  if (bucket.last_update_ms > 0 && now_ms > bucket.last_update_ms) {
+    const double elapsed_secs = static_cast<double>(now_ms - bucket.last_update_ms) / 1000.0;
+    if (bucket.capacity < bucket.burst) {
+      bucket.capacity = qMin(bucket.burst, bucket.capacity + elapsed_secs * kCapacityRecoveryPerSecond);
+    }
+    bucket.tokens = qMin(bucket.capacity, bucket.tokens + elapsed_secs * bucket.tokens_per_second);
+  }
+  bucket.last_update_ms = now_ms;
+
+}
+
+void RateLimiter::SetLimits(const QString &host, const double burst, const double tokens_per_second) {
+
+  if (host.isEmpty() || burst < 1.0 || tokens_per_second <= 0.0) return;
+
+  QMutexLocker l(&sMutex);
+  Bucket &bucket = GetBucket(host);
+  bucket.burst = burst;
+  bucket.capacity = burst;
+  bucket.tokens = qMin(bucket.tokens, burst);
+  bucket.tokens_per_second = tokens_per_second;
+
+}
+
+bool RateLimiter::TryAcquire(const QUrl &url) {
+
+  const QString host = url.host();
+  if (host.isEmpty()) return true;
+
+  QMutexLocker l(&sMutex);
+  Bucket &bucket = GetBucket(host);
+  const qint64 now_ms = QDateTime::currentMSecsSinceEpoch();
+  Refill(bucket, now_ms);
+
+  if (now_ms < bucket.blocked_until_ms) return false;
+  if (bucket.tokens < 1.0) return false;
+
+  bucket.tokens -= 1.0;
+
+  return true;
+
+}
+
+void RateLimiter::RateLimited(const QUrl &url) {
+
+  const QString host = url.host();
+  if (host.isEmpty()) return;
+
+  QMutexLocker l(&sMutex);
+  Bucket &bucket = GetBucket(host);
+  const qint64 now_ms = QDateTime::currentMSecsSinceEpoch();
+  Refill(bucket, now_ms);
+
+  bucket.capacity = qMax(1.0, bucket.capacity / 2.0);
+  bucket.tokens = 0.0;
+  bucket.blocked_until_ms = now_ms + kBackoffMs;
+
+  qLog(Debug) << "Rate limited by" << host << "- shrinking bucket to" << bucket.capacity << "and pausing for" << kBackoffMs << "ms";
+
+}
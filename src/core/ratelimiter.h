@@ -0,0 +1,68 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2018-2021, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QHash>
+#include <QString>
+
+class QUrl;
+
+// A token bucket rate limiter shared across all the services, keyed by API host.
+// Each host has a bucket that holds up to a burst of tokens and refills at a steady rate,
+// so requests after idle go out immediately in a burst but the sustained rate never exceeds the quota.
+// Callers take a token with TryAcquire() before sending a request and retry later when it returns false,
+// and report HTTP 429 replies with RateLimited() so the bucket for the host shrinks and pauses.
+class RateLimiter {
+
+ public:
+  // Sets the bucket size and refill rate for a host. Hosts that are never configured get the defaults.
+  static void SetLimits(const QString &host, const double burst, const double tokens_per_second);
+  // Takes a token for the host of the URL when one is available.
+  // When this returns false the quota is used up and the caller should retry later.
+  static bool TryAcquire(const QUrl &url);
+  // Reports a HTTP 429 reply from the host of the URL:
+  // empties and halves the bucket and pauses it for a few seconds.
+  // The bucket recovers to its configured size over time when no more 429 replies arrive.
+  static void RateLimited(const QUrl &url);
+
+ private:
+  struct Bucket {
+    double tokens;
+    double capacity;
+    double burst;
+    double tokens_per_second;
+    qint64 last_update_ms;
+    qint64 blocked_until_ms;
+  };
+
+  static Bucket &GetBucket(const QString &host);
+  static void Refill(Bucket &bucket, const qint64 now_ms);
+
+  static QMutex sMutex;
+  static QHash<QString, Bucket> sBuckets;
+
+};
+
+#endif  // RATELIMITER_H
@@ -0,0 +1,118 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+#include "core/logging.h"
+#include "searchnegativecache.h"
+
+SearchNegativeCache::SearchNegativeCache(const QString &filename, const qint64 ttl_secs)
+    : filename_(filename),
+      ttl_secs_(ttl_secs),
+      loaded_(false) {}
+
+bool SearchNegativeCache::Contains(const QString &key) {
+
+  if (!loaded_) Load();
+
+  if (!entries_.contains(key)) return false;
+
+  if (QDateTime::currentSecsSinceEpoch() - entries_.value(key) >= ttl_secs_) {
+    entries_.remove(key);
+    return false;
+  }
+
+  return true;
+
+}
+
+void SearchNegativeCache::Insert(const QString &key) {
+
+  if (!loaded_) Load();
+
+  if (entries_.contains(key)) return;
+
+  const qint64 timestamp = QDateTime::currentSecsSinceEpoch();
+  entries_.insert(key, timestamp);
+
+  QFile file(filename_);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    QTextStream stream(&file);
+    stream << timestamp << ' ' << key << '\n';
+    file.close();
+  }
+  else {
+    qLog(Error) << "Unable to open" << filename_ << "for writing:" << file.errorString();
+  }
+
+}
+
+void SearchNegativeCache::Load() {
+
+  loaded_ = true;
+
+  if (!QDir().mkpath(QFileInfo(filename_).path())) {
+    qLog(Error) << "Unable to create directory for" << filename_;
+    return;
+  }
+
+  QFile file(filename_);
+  if (!file.exists()) return;
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Unable to open" << filename_ << "for reading:" << file.errorString();
+    return;
+  }
+
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+  bool expired_entries = false;
+  QTextStream stream(&file);
+  while (!stream.atEnd()) {
+    const QString line = stream.readLine();
+    const qsizetype idx = line.indexOf(QLatin1Char(' '));
+    if (idx <= 0) continue;
+    const qint64 timestamp = line.first(idx).toLongLong();
+    if (timestamp <= 0) continue;
+    if (now - timestamp >= ttl_secs_) {
+      expired_entries = true;
+      continue;
+    }
+    entries_.insert(line.mid(idx + 1), timestamp);
+  }
+  file.close();
+
+  // Rewrite the file without the expired entries so it doesn't grow forever.
+  if (expired_entries) {
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      QTextStream out(&file);
+      for (QHash<QString, qint64>::const_iterator it = entries_.constBegin(); it != entries_.constEnd(); ++it) {
+        out << it.value() << ' ' << it.key() << '\n';
+      }
+      file.close();
+    }
+  }
+
+}
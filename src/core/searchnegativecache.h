@@ -0,0 +1,51 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SEARCHNEGATIVECACHE_H
+#define SEARCHNEGATIVECACHE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QHash>
+#include <QString>
+
+// Persistent cache of search queries that returned nothing, with a time to live.
+// Used by the cover fetcher (and usable by other searchers such as lyrics) to avoid
+// re-querying every provider for items that are known to have no result.
+// Entries are kept in a plain text file in the cache location, one "<timestamp> <key>" line each.
+// Not thread-safe, intended to be owned and used by a single object.
+class SearchNegativeCache {
+ public:
+  explicit SearchNegativeCache(const QString &filename, const qint64 ttl_secs);
+
+  // Returns true if the key was inserted less than the TTL ago.
+  bool Contains(const QString &key);
+  void Insert(const QString &key);
+
+ private:
+  void Load();
+
+  QString filename_;
+  qint64 ttl_secs_;
+  bool loaded_;
+  QHash<QString, qint64> entries_;
+};
+
+#endif  // SEARCHNEGATIVECACHE_H
@@ -18,20 +18,112 @@
  */
 
 #include <QSettings>
+#include <QCoreApplication>
+#include <QtConcurrentRun>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTimer>
+#include <QHash>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
+#include <QChar>
 
 #include "settings.h"
 
+namespace {
+
+// How long queued changes may sit before they are written out.
+constexpr int kFlushDelayMs = 500;
+
+// Changes queued for the default configuration file that have not been written yet, keyed on the full key path.
+QMutex sPendingMutex;
+QHash<QString, QVariant> sPending;
+bool sFlushScheduled = false;
+
+// Applies the queued changes to the file, QSettings rewrites it atomically through QSaveFile.
+// Runs on the thread pool for timed flushes and on the calling thread from FlushPending().
+void FlushPendingToDisk() {
+
+  QHash<QString, QVariant> pending;
+  {
+    QMutexLocker l(&sPendingMutex);
+    pending = sPending;
+    sPending.clear();
+    sFlushScheduled = false;
+  }
+
+  if (pending.isEmpty()) return;
+
+  QSettings s;
+  for (QHash<QString, QVariant>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+    s.setValue(it.key(), it.value());
+  }
+  s.sync();
+
+}
+
+void ScheduleFlush() {
+
+  {
+    QMutexLocker l(&sPendingMutex);
+    if (sFlushScheduled) return;
+    sFlushScheduled = true;
+  }
+
+  if (QCoreApplication::instance()) {
+    QTimer::singleShot(kFlushDelayMs, QCoreApplication::instance(), []() { (void)QtConcurrent::run(&FlushPendingToDisk); });
+  }
+  else {
+    FlushPendingToDisk();
+  }
+
+}
+
+}  // namespace
+
 Settings::Settings(QObject *parent)
-    : QSettings(parent) {}
+    : QSettings(parent),
+      write_behind_(true),
+      array_depth_(0) {}
 
 Settings::Settings(const QString &filename, const Format format, QObject *parent)
-    : QSettings(filename, format, parent) {}
+    : QSettings(filename, format, parent),
+      write_behind_(false),
+      array_depth_(0) {}
 
-// Compatibility with older Qt versions
+void Settings::FlushPending() {
 
-#if QT_VERSION < QT_VERSION_CHECK(6, 4, 0)
+  FlushPendingToDisk();
+
+}
+
+QString Settings::FullKey(const QString &key) const {
+
+  const QString current_group = group();
+  return current_group.isEmpty() ? key : current_group + QLatin1Char('/') + key;
+
+}
+
+QStringList Settings::PendingKeysForGroup() const {
+
+  const QString current_group = group();
+  const QString prefix = current_group.isEmpty() ? QString() : current_group + QLatin1Char('/');
+
+  QStringList keys;
+  QMutexLocker l(&sPendingMutex);
+  for (QHash<QString, QVariant>::const_iterator it = sPending.constBegin(); it != sPending.constEnd(); ++it) {
+    if (prefix.isEmpty()) {
+      keys << it.key();
+    }
+    else if (it.key().startsWith(prefix)) {
+      keys << it.key().mid(prefix.length());
+    }
+  }
+
+  return keys;
+
+}
 
 void Settings::beginGroup(const char *prefix) {
 
@@ -47,74 +139,186 @@ void Settings::beginGroup(const QString &prefix) {
 
 bool Settings::contains(const char *key) const {
 
-  return QSettings::contains(QLatin1String(key));
+  return contains(QLatin1String(key));
 
 }
 
 bool Settings::contains(const QString &key) const {
 
+  if (write_behind_ && array_depth_ == 0) {
+    QMutexLocker l(&sPendingMutex);
+    if (sPending.contains(FullKey(key))) return true;
+  }
+
   return QSettings::contains(key);
 
 }
 
 QVariant Settings::value(const char *key, const QVariant &default_value) const {
 
-  return QSettings::value(QLatin1String(key), default_value);
+  return value(QLatin1String(key), default_value);
 
 }
 
 QVariant Settings::value(const QString &key, const QVariant &default_value) const {
 
+  if (write_behind_ && array_depth_ == 0) {
+    QMutexLocker l(&sPendingMutex);
+    const QHash<QString, QVariant>::const_iterator it = sPending.constFind(FullKey(key));
+    if (it != sPending.constEnd()) return it.value();
+  }
+
   return QSettings::value(key, default_value);
 
 }
 
 void Settings::setValue(const char *key, const QVariant &value) {
 
-  QSettings::setValue(QLatin1String(key), value);
+  setValue(QLatin1String(key), value);
 
 }
 
 void Settings::setValue(const QString &key, const QVariant &value) {
 
+  if (write_behind_ && array_depth_ == 0 && value.isValid()) {
+    {
+      QMutexLocker l(&sPendingMutex);
+      sPending.insert(FullKey(key), value);
+    }
+    ScheduleFlush();
+    return;
+  }
+
   QSettings::setValue(key, value);
 
 }
 
 int Settings::beginReadArray(const char *prefix) {
 
-  return QSettings::beginReadArray(QLatin1String(prefix));
+  return beginReadArray(QLatin1String(prefix));
 
 }
 
 int Settings::beginReadArray(const QString &prefix) {
 
+  ++array_depth_;
+
   return QSettings::beginReadArray(prefix);
 
 }
 
 void Settings::beginWriteArray(const char *prefix, int size) {
 
-  QSettings::beginWriteArray(QLatin1String(prefix), size);
+  beginWriteArray(QLatin1String(prefix), size);
 
 }
 
 void Settings::beginWriteArray(const QString &prefix, int size) {
 
+  ++array_depth_;
+
   QSettings::beginWriteArray(prefix, size);
 
 }
 
+void Settings::endArray() {
+
+  --array_depth_;
+
+  QSettings::endArray();
+
+}
+
 void Settings::remove(const char *key) {
 
-  QSettings::remove(QLatin1String(key));
+  remove(QLatin1String(key));
 
 }
 
 void Settings::remove(const QString &key) {
 
+  if (write_behind_ && array_depth_ == 0) {
+    // Drop queued changes for the key and any subkeys so a later flush doesn't resurrect them,
+    // then let QSettings do the removal since it also covers subkeys.
+    const QString full_key = FullKey(key);
+    const QString prefix = full_key + QLatin1Char('/');
+    QMutexLocker l(&sPendingMutex);
+    QHash<QString, QVariant>::iterator it = sPending.begin();
+    while (it != sPending.end()) {
+      if (it.key() == full_key || it.key().startsWith(prefix)) {
+        it = sPending.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
   QSettings::remove(key);
 
 }
 
-#endif
+QStringList Settings::childKeys() const {
+
+  QStringList keys = QSettings::childKeys();
+
+  // Merge keys still queued in the pending map, so a key written through the write-behind layer
+  // shows up in enumeration right away instead of after the flush.
+  if (write_behind_ && array_depth_ == 0) {
+    const QStringList pending_keys = PendingKeysForGroup();
+    for (const QString &pending_key : pending_keys) {
+      if (!pending_key.contains(QLatin1Char('/')) && !keys.contains(pending_key)) {
+        keys << pending_key;
+      }
+    }
+  }
+
+  return keys;
+
+}
+
+QStringList Settings::childGroups() const {
+
+  QStringList groups = QSettings::childGroups();
+
+  if (write_behind_ && array_depth_ == 0) {
+    const QStringList pending_keys = PendingKeysForGroup();
+    for (const QString &pending_key : pending_keys) {
+      const qint64 idx = pending_key.indexOf(QLatin1Char('/'));
+      if (idx > 0) {
+        const QString group_name = pending_key.left(idx);
+        if (!groups.contains(group_name)) groups << group_name;
+      }
+    }
+  }
+
+  return groups;
+
+}
+
+QStringList Settings::allKeys() const {
+
+  QStringList keys = QSettings::allKeys();
+
+  if (write_behind_ && array_depth_ == 0) {
+    const QStringList pending_keys = PendingKeysForGroup();
+    for (const QString &pending_key : pending_keys) {
+      if (!keys.contains(pending_key)) keys << pending_key;
+    }
+  }
+
+  return keys;
+
+}
+
+void Settings::clear() {
+
+  if (write_behind_) {
+    // Queued changes would resurrect keys after the file is cleared.
+    QMutexLocker l(&sPendingMutex);
+    sPending.clear();
+  }
+
+  QSettings::clear();
+
+}
@@ -23,14 +23,23 @@
 #include <QSettings>
 #include <QObject>
 #include <QVariant>
+#include <QString>
+#include <QStringList>
 
+// QSettings with a write-behind layer for the default configuration file.
+// setValue() queues the change in a process-wide pending map and schedules a flush,
+// which applies the queued changes and rewrites the file atomically from the thread pool on a short timer.
+// value(), contains() and the key enumeration methods consult the pending map first so readers always see the latest values,
+// and FlushPending() writes anything still queued synchronously at shutdown.
+// This keeps bursts of writes, i.e. from window and splitter moves, from rewriting the file on the UI thread for every change.
+// Settings opened on an explicit filename, and keys written inside arrays, bypass the layer and behave like plain QSettings.
 class Settings : public QSettings {
   Q_OBJECT
 
  public:
   explicit Settings(QObject *parent = nullptr);
   explicit Settings(const QString &filename, const Format format, QObject *parent = nullptr);
-#if QT_VERSION < QT_VERSION_CHECK(6, 4, 0)  // Compatibility with older Qt versions
+
   void beginGroup(const char *prefix);
   void beginGroup(const QString &prefix);
   bool contains(const char *key) const;
@@ -43,9 +52,25 @@ class Settings : public QSettings {
   int beginReadArray(const QString &prefix);
   void beginWriteArray(const char *prefix, int size = -1);
   void beginWriteArray(const QString &prefix, int size = -1);
+  void endArray();
   void remove(const char *key);
   void remove(const QString &key);
-#endif
+  QStringList childKeys() const;
+  QStringList childGroups() const;
+  QStringList allKeys() const;
+  void clear();
+
+  // Synchronously writes any queued changes, called at shutdown.
+  static void FlushPending();
+
+ private:
+  QString FullKey(const QString &key) const;
+  QStringList PendingKeysForGroup() const;
+
+  // Whether this instance uses the default configuration file and takes part in the write-behind layer.
+  bool write_behind_;
+  // Nesting depth of beginReadArray/beginWriteArray, keys inside arrays go straight to QSettings.
+  int array_depth_;
 };
 
 #endif  // SETTINGS_H
@@ -34,10 +34,14 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QDataStream>
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QSharedData>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
 #include <QByteArray>
 #include <QVariantMap>
 #include <QString>
@@ -49,6 +53,7 @@
 #include <QSqlRecord>
 
 #include "core/iconloader.h"
+#include "core/memorystats.h"
 #include "engine/enginemetadata.h"
 #include "utilities/strutils.h"
 #include "utilities/timeutils.h"
@@ -144,6 +149,52 @@ const QStringList Song::kColumns = QStringList() << QStringLiteral("title")
 
 const QStringList Song::kRowIdColumns = QStringList() << QStringLiteral("ROWID") << kColumns;
 
+const QStringList Song::kProjectionColumns = QStringList()
+                                                           << QStringLiteral("title")
+                                                           << QStringLiteral("album")
+                                                           << QStringLiteral("artist")
+                                                           << QStringLiteral("albumartist")
+                                                           << QStringLiteral("track")
+                                                           << QStringLiteral("disc")
+                                                           << QStringLiteral("year")
+                                                           << QStringLiteral("originalyear")
+                                                           << QStringLiteral("genre")
+                                                           << QStringLiteral("compilation")
+                                                           << QStringLiteral("composer")
+                                                           << QStringLiteral("performer")
+                                                           << QStringLiteral("grouping")
+                                                           << QStringLiteral("comment")
+                                                           << QStringLiteral("artist_id")
+                                                           << QStringLiteral("album_id")
+                                                           << QStringLiteral("song_id")
+                                                           << QStringLiteral("beginning")
+                                                           << QStringLiteral("length")
+                                                           << QStringLiteral("bitrate")
+                                                           << QStringLiteral("samplerate")
+                                                           << QStringLiteral("bitdepth")
+                                                           << QStringLiteral("source")
+                                                           << QStringLiteral("directory_id")
+                                                           << QStringLiteral("url")
+                                                           << QStringLiteral("filetype")
+                                                           << QStringLiteral("filesize")
+                                                           << QStringLiteral("mtime")
+                                                           << QStringLiteral("ctime")
+                                                           << QStringLiteral("unavailable")
+                                                           << QStringLiteral("playcount")
+                                                           << QStringLiteral("skipcount")
+                                                           << QStringLiteral("lastplayed")
+                                                           << QStringLiteral("art_embedded")
+                                                           << QStringLiteral("art_automatic")
+                                                           << QStringLiteral("art_manual")
+                                                           << QStringLiteral("art_unset")
+                                                           << QStringLiteral("cue_path")
+                                                           << QStringLiteral("rating")
+                                                           ;
+
+const QStringList Song::kProjectionRowIdColumns = QStringList() << QStringLiteral("ROWID") << kProjectionColumns;
+const QString Song::kProjectionColumnSpec = Song::kProjectionColumns.join(QLatin1String(", "));
+
+
 const QString Song::kColumnSpec = kColumns.join(QLatin1String(", "));
 const QString Song::kRowIdColumnSpec = kRowIdColumns.join(QLatin1String(", "));
 const QString Song::kBindSpec = Utilities::Prepend(QStringLiteral(":"), kColumns).join(QLatin1String(", "));
@@ -237,6 +288,9 @@ struct Song::Private : public QSharedData {
 
   explicit Private(Source source = Source::Unknown);
 
+  // Memory accounting: counts every live copy of the shared data, including detaches.
+  MemoryStats::InstanceCounter<&MemoryStats::song_instances> instance_counter_;
+
   int id_;
 
   bool valid_;
@@ -479,18 +533,18 @@ void Song::set_id(const int id) { d->id_ = id; }
 void Song::set_valid(const bool v) { d->valid_ = v; }
 
 void Song::set_title(const QString &v) { d->title_sortable_ = sortable(v); d->title_ = v; }
-void Song::set_album(const QString &v) { d->album_sortable_ = sortable(v); d->album_ = v; }
-void Song::set_artist(const QString &v) { d->artist_sortable_ = sortable(v); d->artist_ = v; }
-void Song::set_albumartist(const QString &v) { d->albumartist_sortable_ = sortable(v); d->albumartist_ = v; }
+void Song::set_album(const QString &v) { d->album_sortable_ = Intern(sortable(v)); d->album_ = Intern(v); }
+void Song::set_artist(const QString &v) { d->artist_sortable_ = Intern(sortable(v)); d->artist_ = Intern(v); }
+void Song::set_albumartist(const QString &v) { d->albumartist_sortable_ = Intern(sortable(v)); d->albumartist_ = Intern(v); }
 void Song::set_track(const int v) { d->track_ = v; }
 void Song::set_disc(const int v) { d->disc_ = v; }
 void Song::set_year(const int v) { d->year_ = v; }
 void Song::set_originalyear(const int v) { d->originalyear_ = v; }
-void Song::set_genre(const QString &v) { d->genre_ = v; }
+void Song::set_genre(const QString &v) { d->genre_ = Intern(v); }
 void Song::set_compilation(bool v) { d->compilation_ = v; }
-void Song::set_composer(const QString &v) { d->composer_ = v; }
-void Song::set_performer(const QString &v) { d->performer_ = v; }
-void Song::set_grouping(const QString &v) { d->grouping_ = v; }
+void Song::set_composer(const QString &v) { d->composer_ = Intern(v); }
+void Song::set_performer(const QString &v) { d->performer_ = Intern(v); }
+void Song::set_grouping(const QString &v) { d->grouping_ = Intern(v); }
 void Song::set_comment(const QString &v) { d->comment_ = v; }
 void Song::set_lyrics(const QString &v) { d->lyrics_ = v; }
 
@@ -710,6 +764,57 @@ int Song::ColumnIndex(const QString &field) {
 
 }
 
+namespace {
+int ProjectionColumnIndex(const QString &field) {
+  return static_cast<int>(Song::kProjectionRowIdColumns.indexOf(field));
+}
+
+// Pool of field values shared between songs, see Song::Intern().
+// Capped so unusual collections where every value is distinct can't grow it without bound.
+constexpr qsizetype kInternPoolMaxEntries = 262144;
+// Approximate heap allocation of a QString beyond the characters themselves.
+constexpr quint64 kStringAllocOverhead = 24;
+
+QMutex sInternPoolMutex;
+QSet<QString> sInternPool;
+quint64 sInternPoolBytesSaved = 0;
+
+}  // namespace
+
+QString Song::Intern(const QString &value) {
+
+  if (value.isEmpty()) return value;
+
+  QMutexLocker l(&sInternPoolMutex);
+
+  const QSet<QString>::const_iterator it = sInternPool.constFind(value);
+  if (it != sInternPool.constEnd()) {
+    sInternPoolBytesSaved += static_cast<quint64>(value.size()) * sizeof(QChar) + kStringAllocOverhead;
+    return *it;
+  }
+
+  if (sInternPool.count() < kInternPoolMaxEntries) {
+    sInternPool.insert(value);
+  }
+
+  return value;
+
+}
+
+quint64 Song::InternPoolEntries() {
+
+  QMutexLocker l(&sInternPoolMutex);
+  return static_cast<quint64>(sInternPool.count());
+
+}
+
+quint64 Song::InternPoolBytesSaved() {
+
+  QMutexLocker l(&sInternPoolMutex);
+  return sInternPoolBytesSaved;
+
+}
+
 QString Song::JoinSpec(const QString &table) {
   return Utilities::Prepend(table + QLatin1Char('.'), kRowIdColumns).join(QLatin1String(", "));
 }
@@ -1310,11 +1415,11 @@ void Song::InitFromProtobuf(const spb::tagreader::SongMetadata &pb) {
   d->disc_ = pb.disc();
   d->year_ = pb.year();
   d->originalyear_ = pb.originalyear();
-  d->genre_ = QString::fromStdString(pb.genre());
+  d->genre_ = Intern(QString::fromStdString(pb.genre()));
   d->compilation_ = pb.compilation();
-  d->composer_ = QString::fromStdString(pb.composer());
-  d->performer_ = QString::fromStdString(pb.performer());
-  d->grouping_ = QString::fromStdString(pb.grouping());
+  d->composer_ = Intern(QString::fromStdString(pb.composer()));
+  d->performer_ = Intern(QString::fromStdString(pb.performer()));
+  d->grouping_ = Intern(QString::fromStdString(pb.grouping()));
   d->comment_ = QString::fromStdString(pb.comment());
   d->lyrics_ = QString::fromStdString(pb.lyrics());
   set_length_nanosec(static_cast<qint64>(pb.length_nanosec()));
@@ -1429,11 +1534,11 @@ void Song::InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, cons
   d->disc_ = SqlHelper::ValueToInt(r, ColumnIndex(QStringLiteral("disc")) + col);
   d->year_ = SqlHelper::ValueToInt(r, ColumnIndex(QStringLiteral("year")) + col);
   d->originalyear_ = SqlHelper::ValueToInt(r, ColumnIndex(QStringLiteral("originalyear")) + col);
-  d->genre_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("genre")) + col);
+  d->genre_ = Intern(SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("genre")) + col));
   d->compilation_ = r.value(ColumnIndex(QStringLiteral("compilation")) + col).toBool();
-  d->composer_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("composer")) + col);
-  d->performer_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("performer")) + col);
-  d->grouping_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("grouping")) + col);
+  d->composer_ = Intern(SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("composer")) + col));
+  d->performer_ = Intern(SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("performer")) + col));
+  d->grouping_ = Intern(SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("grouping")) + col));
   d->comment_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("comment")) + col);
   d->lyrics_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("lyrics")) + col);
   d->artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(QStringLiteral("artist_id")) + col);
@@ -1509,6 +1614,68 @@ void Song::InitFromQuery(const SqlRow &row, const bool reliable_metadata, const
 
 }
 
+void Song::InitFromProjectionQuery(const QSqlRecord &r, const bool reliable_metadata, const int col) {
+
+  Q_ASSERT(kProjectionRowIdColumns.count() + col <= r.count());
+
+  d->id_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("ROWID")) + col);
+
+  set_title(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("title")) + col));
+  set_album(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("album")) + col));
+  set_artist(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("artist")) + col));
+  set_albumartist(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("albumartist")) + col));
+  d->track_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("track")) + col);
+  d->disc_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("disc")) + col);
+  d->year_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("year")) + col);
+  d->originalyear_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("originalyear")) + col);
+  d->genre_ = Intern(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("genre")) + col));
+  d->compilation_ = r.value(ProjectionColumnIndex(QStringLiteral("compilation")) + col).toBool();
+  d->composer_ = Intern(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("composer")) + col));
+  d->performer_ = Intern(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("performer")) + col));
+  d->grouping_ = Intern(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("grouping")) + col));
+  d->comment_ = SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("comment")) + col);
+  d->artist_id_ = SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("artist_id")) + col);
+  d->album_id_ = SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("album_id")) + col);
+  d->song_id_ = SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("song_id")) + col);
+  d->beginning_ = r.value(ProjectionColumnIndex(QStringLiteral("beginning")) + col).isNull() ? 0 : r.value(ProjectionColumnIndex(QStringLiteral("beginning")) + col).toLongLong();
+  set_length_nanosec(SqlHelper::ValueToLongLong(r, ProjectionColumnIndex(QStringLiteral("length")) + col));
+  d->bitrate_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("bitrate")) + col);
+  d->samplerate_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("samplerate")) + col);
+  d->bitdepth_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("bitdepth")) + col);
+  d->source_ = static_cast<Source>(r.value(ProjectionColumnIndex(QStringLiteral("source")) + col).isNull() ? 0 : r.value(ProjectionColumnIndex(QStringLiteral("source")) + col).toInt());
+  d->directory_id_ = SqlHelper::ValueToInt(r, ProjectionColumnIndex(QStringLiteral("directory_id")) + col);
+  set_url(QUrl::fromEncoded(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("url")) + col).toUtf8()));
+  d->basefilename_ = QFileInfo(d->url_.toLocalFile()).fileName();
+  d->filetype_ = FileType(r.value(ProjectionColumnIndex(QStringLiteral("filetype")) + col).isNull() ? 0 : r.value(ProjectionColumnIndex(QStringLiteral("filetype")) + col).toInt());
+  d->filesize_ = SqlHelper::ValueToLongLong(r, ProjectionColumnIndex(QStringLiteral("filesize")) + col);
+  d->mtime_ = SqlHelper::ValueToLongLong(r, ProjectionColumnIndex(QStringLiteral("mtime")) + col);
+  d->ctime_ = SqlHelper::ValueToLongLong(r, ProjectionColumnIndex(QStringLiteral("ctime")) + col);
+  d->unavailable_ = r.value(ProjectionColumnIndex(QStringLiteral("unavailable")) + col).toBool();
+  d->playcount_ = SqlHelper::ValueToUInt(r, ProjectionColumnIndex(QStringLiteral("playcount")) + col);
+  d->skipcount_ = SqlHelper::ValueToUInt(r, ProjectionColumnIndex(QStringLiteral("skipcount")) + col);
+  d->lastplayed_ = SqlHelper::ValueToLongLong(r, ProjectionColumnIndex(QStringLiteral("lastplayed")) + col);
+
+  d->art_embedded_ = SqlHelper::ValueToBool(r, ProjectionColumnIndex(QStringLiteral("art_embedded")) + col);
+  d->art_automatic_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("art_automatic")) + col).toUtf8());
+  d->art_manual_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("art_manual")) + col).toUtf8());
+  d->art_unset_ = SqlHelper::ValueToBool(r, ProjectionColumnIndex(QStringLiteral("art_unset")) + col);
+
+  d->cue_path_ = SqlHelper::ValueToString(r, ProjectionColumnIndex(QStringLiteral("cue_path")) + col);
+  d->rating_ = SqlHelper::ValueToFloat(r, ProjectionColumnIndex(QStringLiteral("rating")) + col);
+
+  d->valid_ = true;
+  d->init_from_file_ = reliable_metadata;
+
+  InitArtManual();
+
+}
+
+void Song::InitFromProjectionQuery(const SqlQuery &query, const bool reliable_metadata, const int col) {
+
+  InitFromProjectionQuery(query.record(), reliable_metadata, col);
+
+}
+
 void Song::InitFromFilePartial(const QString &filename, const QFileInfo &fileinfo) {
 
   set_url(QUrl::fromLocalFile(filename));
@@ -1560,10 +1727,10 @@ void Song::InitFromItdb(Itdb_Track *track, const QString &prefix) {
   d->track_ = track->track_nr;
   d->disc_ = track->cd_nr;
   d->year_ = track->year;
-  d->genre_ = QString::fromUtf8(track->genre);
+  d->genre_ = Intern(QString::fromUtf8(track->genre));
   d->compilation_ = track->compilation == 1;
-  d->composer_ = QString::fromUtf8(track->composer);
-  d->grouping_ = QString::fromUtf8(track->grouping);
+  d->composer_ = Intern(QString::fromUtf8(track->composer));
+  d->grouping_ = Intern(QString::fromUtf8(track->grouping));
   d->comment_ = QString::fromUtf8(track->comment);
 
   set_length_nanosec(track->tracklen * kNsecPerMsec);
@@ -1652,8 +1819,8 @@ void Song::InitFromMTP(const LIBMTP_track_t *track, const QString &host) {
   set_title(QString::fromUtf8(track->title));
   set_artist(QString::fromUtf8(track->artist));
   set_album(QString::fromUtf8(track->album));
-  d->genre_ = QString::fromUtf8(track->genre);
-  d->composer_ = QString::fromUtf8(track->composer);
+  d->genre_ = Intern(QString::fromUtf8(track->genre));
+  d->composer_ = Intern(QString::fromUtf8(track->composer));
   d->track_ = track->tracknumber;
 
   d->url_ = QUrl(QStringLiteral("mtp://%1/%2").arg(host, QString::number(track->item_id)));
@@ -1938,6 +2105,244 @@ size_t HashSimilar(const Song &song) {
   return qHash(song.title().toLower()) ^ qHash(song.artist().toLower()) ^ qHash(song.album().toLower());
 }
 
+QDataStream &operator<<(QDataStream &s, const Song &song) {
+
+  s << song.is_valid();
+  s << song.id();
+  s << song.title();
+  s << song.album();
+  s << song.artist();
+  s << song.albumartist();
+  s << song.track();
+  s << song.disc();
+  s << song.year();
+  s << song.originalyear();
+  s << song.genre();
+  s << song.compilation();
+  s << song.composer();
+  s << song.performer();
+  s << song.grouping();
+  s << song.comment();
+  s << song.lyrics();
+  s << song.artist_id();
+  s << song.album_id();
+  s << song.song_id();
+  s << song.beginning_nanosec();
+  s << song.end_nanosec();
+  s << song.bitrate();
+  s << song.samplerate();
+  s << song.bitdepth();
+  s << static_cast<qint32>(song.source());
+  s << song.directory_id();
+  s << song.url();
+  s << song.basefilename();
+  s << static_cast<qint32>(song.filetype());
+  s << song.filesize();
+  s << song.mtime();
+  s << song.ctime();
+  s << song.unavailable();
+  s << song.fingerprint();
+  s << song.playcount();
+  s << song.skipcount();
+  s << song.lastplayed();
+  s << song.lastseen();
+  s << song.compilation_detected();
+  s << song.compilation_on();
+  s << song.compilation_off();
+  s << song.art_embedded();
+  s << song.art_automatic();
+  s << song.art_manual();
+  s << song.art_unset();
+  s << song.cue_path();
+  s << song.rating();
+  s << song.acoustid_id();
+  s << song.acoustid_fingerprint();
+  s << song.musicbrainz_album_artist_id();
+  s << song.musicbrainz_artist_id();
+  s << song.musicbrainz_original_artist_id();
+  s << song.musicbrainz_album_id();
+  s << song.musicbrainz_original_album_id();
+  s << song.musicbrainz_recording_id();
+  s << song.musicbrainz_track_id();
+  s << song.musicbrainz_disc_id();
+  s << song.musicbrainz_release_group_id();
+  s << song.musicbrainz_work_id();
+  s << song.ebur128_integrated_loudness_lufs().has_value();
+  s << song.ebur128_integrated_loudness_lufs().value_or(0.0);
+  s << song.ebur128_loudness_range_lu().has_value();
+  s << song.ebur128_loudness_range_lu().value_or(0.0);
+
+  return s;
+
+}
+
+QDataStream &operator>>(QDataStream &s, Song &song) {
+
+  bool valid = false;
+  int id = -1;
+  QString title, album, artist, albumartist;
+  int track = -1, disc = -1, year = -1, originalyear = -1;
+  QString genre;
+  bool compilation = false;
+  QString composer, performer, grouping, comment, lyrics;
+  QString artist_id, album_id, song_id;
+  qint64 beginning = 0, end = -1;
+  int bitrate = -1, samplerate = -1, bitdepth = -1;
+  qint32 source = 0;
+  int directory_id = -1;
+  QUrl url;
+  QString basefilename;
+  qint32 filetype = 0;
+  qint64 filesize = -1, mtime = -1, ctime = -1;
+  bool unavailable = false;
+  QString fingerprint;
+  uint playcount = 0, skipcount = 0;
+  qint64 lastplayed = -1, lastseen = -1;
+  bool compilation_detected = false, compilation_on = false, compilation_off = false;
+  bool art_embedded = false;
+  QUrl art_automatic, art_manual;
+  bool art_unset = false;
+  QString cue_path;
+  float rating = -1;
+  QString acoustid_id, acoustid_fingerprint;
+  QString musicbrainz_album_artist_id, musicbrainz_artist_id, musicbrainz_original_artist_id;
+  QString musicbrainz_album_id, musicbrainz_original_album_id, musicbrainz_recording_id;
+  QString musicbrainz_track_id, musicbrainz_disc_id, musicbrainz_release_group_id, musicbrainz_work_id;
+  bool has_ebur128_integrated_loudness_lufs = false, has_ebur128_loudness_range_lu = false;
+  double ebur128_integrated_loudness_lufs = 0.0, ebur128_loudness_range_lu = 0.0;
+
+  s >> valid;
+  s >> id;
+  s >> title;
+  s >> album;
+  s >> artist;
+  s >> albumartist;
+  s >> track;
+  s >> disc;
+  s >> year;
+  s >> originalyear;
+  s >> genre;
+  s >> compilation;
+  s >> composer;
+  s >> performer;
+  s >> grouping;
+  s >> comment;
+  s >> lyrics;
+  s >> artist_id;
+  s >> album_id;
+  s >> song_id;
+  s >> beginning;
+  s >> end;
+  s >> bitrate;
+  s >> samplerate;
+  s >> bitdepth;
+  s >> source;
+  s >> directory_id;
+  s >> url;
+  s >> basefilename;
+  s >> filetype;
+  s >> filesize;
+  s >> mtime;
+  s >> ctime;
+  s >> unavailable;
+  s >> fingerprint;
+  s >> playcount;
+  s >> skipcount;
+  s >> lastplayed;
+  s >> lastseen;
+  s >> compilation_detected;
+  s >> compilation_on;
+  s >> compilation_off;
+  s >> art_embedded;
+  s >> art_automatic;
+  s >> art_manual;
+  s >> art_unset;
+  s >> cue_path;
+  s >> rating;
+  s >> acoustid_id;
+  s >> acoustid_fingerprint;
+  s >> musicbrainz_album_artist_id;
+  s >> musicbrainz_artist_id;
+  s >> musicbrainz_original_artist_id;
+  s >> musicbrainz_album_id;
+  s >> musicbrainz_original_album_id;
+  s >> musicbrainz_recording_id;
+  s >> musicbrainz_track_id;
+  s >> musicbrainz_disc_id;
+  s >> musicbrainz_release_group_id;
+  s >> musicbrainz_work_id;
+  s >> has_ebur128_integrated_loudness_lufs;
+  s >> ebur128_integrated_loudness_lufs;
+  s >> has_ebur128_loudness_range_lu;
+  s >> ebur128_loudness_range_lu;
+
+  song.set_valid(valid);
+  song.set_id(id);
+  song.set_title(title);
+  song.set_album(album);
+  song.set_artist(artist);
+  song.set_albumartist(albumartist);
+  song.set_track(track);
+  song.set_disc(disc);
+  song.set_year(year);
+  song.set_originalyear(originalyear);
+  song.set_genre(genre);
+  song.set_compilation(compilation);
+  song.set_composer(composer);
+  song.set_performer(performer);
+  song.set_grouping(grouping);
+  song.set_comment(comment);
+  song.set_lyrics(lyrics);
+  song.set_artist_id(artist_id);
+  song.set_album_id(album_id);
+  song.set_song_id(song_id);
+  song.set_beginning_nanosec(beginning);
+  song.set_end_nanosec(end);
+  song.set_bitrate(bitrate);
+  song.set_samplerate(samplerate);
+  song.set_bitdepth(bitdepth);
+  song.set_source(static_cast<Song::Source>(source));
+  song.set_directory_id(directory_id);
+  song.set_url(url);
+  song.set_basefilename(basefilename);
+  song.set_filetype(static_cast<Song::FileType>(filetype));
+  song.set_filesize(filesize);
+  song.set_mtime(mtime);
+  song.set_ctime(ctime);
+  song.set_unavailable(unavailable);
+  song.set_fingerprint(fingerprint);
+  song.set_playcount(playcount);
+  song.set_skipcount(skipcount);
+  song.set_lastplayed(lastplayed);
+  song.set_lastseen(lastseen);
+  song.set_compilation_detected(compilation_detected);
+  song.set_compilation_on(compilation_on);
+  song.set_compilation_off(compilation_off);
+  song.set_art_embedded(art_embedded);
+  song.set_art_automatic(art_automatic);
+  song.set_art_manual(art_manual);
+  song.set_art_unset(art_unset);
+  song.set_cue_path(cue_path);
+  song.set_rating(rating);
+  song.set_acoustid_id(acoustid_id);
+  song.set_acoustid_fingerprint(acoustid_fingerprint);
+  song.set_musicbrainz_album_artist_id(musicbrainz_album_artist_id);
+  song.set_musicbrainz_artist_id(musicbrainz_artist_id);
+  song.set_musicbrainz_original_artist_id(musicbrainz_original_artist_id);
+  song.set_musicbrainz_album_id(musicbrainz_album_id);
+  song.set_musicbrainz_original_album_id(musicbrainz_original_album_id);
+  song.set_musicbrainz_recording_id(musicbrainz_recording_id);
+  song.set_musicbrainz_track_id(musicbrainz_track_id);
+  song.set_musicbrainz_disc_id(musicbrainz_disc_id);
+  song.set_musicbrainz_release_group_id(musicbrainz_release_group_id);
+  song.set_musicbrainz_work_id(musicbrainz_work_id);
+  song.set_ebur128_integrated_loudness_lufs(has_ebur128_integrated_loudness_lufs ? std::optional<double>(ebur128_integrated_loudness_lufs) : std::nullopt);
+  song.set_ebur128_loudness_range_lu(has_ebur128_loudness_range_lu ? std::optional<double>(ebur128_loudness_range_lu) : std::nullopt);
+
+  return s;
+
+}
+
 bool Song::ContainsRegexList(const QString &str, const RegularExpressionList &regex_list) {
 
   for (const QRegularExpression &regex : regex_list) {
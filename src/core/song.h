@@ -42,6 +42,7 @@
 #include <QIcon>
 
 class SqlQuery;
+class QDataStream;
 class QSqlRecord;
 
 class EngineMetadata;
@@ -120,6 +121,12 @@ class Song {
   static const QString kBindSpec;
   static const QString kUpdateSpec;
 
+  // Column subset used by CollectionModel to build the tree.
+  // Excludes large text columns such as lyrics, fingerprints and MusicBrainz IDs which aren't needed for grouping or display.
+  static const QStringList kProjectionColumns;
+  static const QStringList kProjectionRowIdColumns;
+  static const QString kProjectionColumnSpec;
+
   static const QStringList kTextSearchColumns;
   static const QStringList kIntSearchColumns;
   static const QStringList kUIntSearchColumns;
@@ -425,6 +432,9 @@ class Song {
   void InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, const int col = 0);
   void InitFromQuery(const SqlQuery &query, const bool reliable_metadata, const int col = 0);
   void InitFromQuery(const SqlRow &row, const bool reliable_metadata, const int col = 0);
+  // Initializes the song from a query that selected kProjectionColumns instead of the full kColumns.
+  void InitFromProjectionQuery(const QSqlRecord &r, const bool reliable_metadata, const int col = 0);
+  void InitFromProjectionQuery(const SqlQuery &query, const bool reliable_metadata, const int col = 0);
   void InitFromFilePartial(const QString &filename, const QFileInfo &fileinfo);
   void InitArtManual();
   void InitArtAutomatic();
@@ -456,6 +466,14 @@ class Song {
   // It is more efficient to use IsOnSameAlbum, but this function can be used when you need to hash the key to do fast lookups.
   QString AlbumKey() const;
 
+  // String interning for field values that repeat across thousands of songs (artist, album, genre, ...).
+  // Returns a copy sharing the data of the first string with this value seen, so a collection with
+  // 600k songs holds each distinct artist or album name once instead of once per song.
+  // Thread safe. The accessors report the pool size and an estimate of the heap bytes saved.
+  static QString Intern(const QString &value);
+  static quint64 InternPoolEntries();
+  static quint64 InternPoolBytesSaved();
+
   static bool ContainsRegexList(const QString &str, const RegularExpressionList &regex_list);
   static QString StripRegexList(QString str, const RegularExpressionList &regex_list);
   static bool AlbumContainsDisc(const QString &album);
@@ -489,4 +507,8 @@ uint qHash(const Song &song);
 // Hash function using field checked in IsSimilar function
 size_t HashSimilar(const Song &song);
 
+// Binary serialization of all persistent song fields, used by the playlist restore cache.
+QDataStream &operator<<(QDataStream &s, const Song &song);
+QDataStream &operator>>(QDataStream &s, Song &song);
+
 #endif  // SONG_H
@@ -31,15 +31,20 @@
 #include <QIODevice>
 #include <QBuffer>
 #include <QByteArray>
+#include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QSet>
 #include <QTimer>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 #include <QEventLoop>
+#include <QtConcurrent>
 
 #include "core/logging.h"
 
@@ -65,6 +70,25 @@
 QSet<QString> SongLoader::sRawUriSchemes;
 const int SongLoader::kDefaultTimeout = 5000;
 
+namespace {
+
+// Resolving a remote stream (typefind, possibly fetching and parsing a playlist) costs network round trips and can take seconds,
+// so successful outcomes are cached per URL for the lifetime of the process.
+// A cached resolve is always served immediately so a saved stream starts playing right away;
+// entries older than the TTL are additionally revalidated in the background.
+constexpr qint64 kRemoteResolveFreshMs = 60 * 60 * 1000;
+
+struct RemoteResolveCacheEntry {
+  SongList songs;
+  qint64 resolved_ms = 0;
+};
+
+QHash<QUrl, RemoteResolveCacheEntry> sRemoteResolveCache;
+QSet<QUrl> sRemoteRevalidationsInProgress;
+QMutex sRemoteResolveMutex;
+
+}  // namespace
+
 SongLoader::SongLoader(SharedPtr<CollectionBackendInterface> collection_backend, const SharedPtr<Player> player, QObject *parent)
     : QObject(parent),
       player_(player),
@@ -112,6 +136,7 @@ SongLoader::Result SongLoader::Load(const QUrl &url) {
   if (url.isEmpty()) return Result::Error;
 
   url_ = url;
+  requested_url_ = url;
 
   if (url_.isLocalFile()) {
     return LoadLocal(url_.toLocalFile());
@@ -126,6 +151,20 @@ SongLoader::Result SongLoader::Load(const QUrl &url) {
 
   if (player_->engine()->type() == EngineBase::Type::GStreamer) {
 #ifdef HAVE_GSTREAMER
+    // Check if this URL was resolved before, so replaying a saved stream doesn't repeat the typefind round trips.
+    bool fresh = false;
+    {
+      QMutexLocker l(&sRemoteResolveMutex);
+      if (sRemoteResolveCache.contains(url_)) {
+        const RemoteResolveCacheEntry &entry = sRemoteResolveCache[url_];
+        songs_ = entry.songs;
+        fresh = QDateTime::currentMSecsSinceEpoch() - entry.resolved_ms <= kRemoteResolveFreshMs;
+      }
+    }
+    if (!songs_.isEmpty()) {
+      if (!fresh) RevalidateRemoteAsync();
+      return Result::Success;
+    }
     preload_func_ = std::bind(&SongLoader::LoadRemote, this);
     return Result::BlockingLoadRequired;
 #else
@@ -154,38 +193,6 @@ SongLoader::Result SongLoader::LoadFilenamesBlocking() {
 
 }
 
-SongLoader::Result SongLoader::LoadLocalPartial(const QString &filename) {
-
-  qLog(Debug) << "Fast Loading local file" << filename;
-
-  QFileInfo fileinfo(filename);
-
-  if (!fileinfo.exists()) {
-    errors_ << tr("File %1 does not exist.").arg(filename);
-    return Result::Error;
-  }
-
-  // First check to see if it's a directory - if so we can load all the songs inside right away.
-  if (fileinfo.isDir()) {
-    LoadLocalDirectory(filename);
-    return Result::Success;
-  }
-
-  // Assume it's just a normal file
-  if (TagReaderClient::Instance()->IsMediaFileBlocking(filename) || Song::kAcceptedExtensions.contains(fileinfo.suffix(), Qt::CaseInsensitive)) {
-    Song song(Song::Source::LocalFile);
-    song.InitFromFilePartial(filename, fileinfo);
-    if (song.is_valid()) {
-      songs_ << song;
-      return Result::Success;
-    }
-  }
-
-  errors_ << QObject::tr("File %1 is not recognized as a valid audio file.").arg(filename);
-  return Result::Error;
-
-}
-
 SongLoader::Result SongLoader::LoadAudioCD() {
 
 #if defined(HAVE_AUDIOCD) && defined(HAVE_GSTREAMER)
@@ -332,9 +339,8 @@ SongLoader::Result SongLoader::LoadLocalAsync(const QString &filename) {
 
 void SongLoader::LoadMetadataBlocking() {
 
-  for (int i = 0; i < songs_.size(); i++) {
-    EffectiveSongLoad(&songs_[i]);
-  }
+  // Each song reads its own file through the tag reader, so the loads are independent and run in parallel on the thread pool.
+  QtConcurrent::blockingMap(songs_, [this](Song &song) { EffectiveSongLoad(&song); });
 
 }
 
@@ -367,7 +373,8 @@ void SongLoader::LoadPlaylist(ParserBase *parser, const QString &filename) {
 
   QFile file(filename);
   if (file.open(QIODevice::ReadOnly)) {
-    songs_ = parser->Load(&file, filename, QFileInfo(filename).path());
+    // Parse in batches, so a giant playlist file is never buffered in memory whole and the first songs are available while the rest is still being parsed.
+    parser->LoadIncrementally(&file, [this](const SongList &songs) { songs_ << songs; }, filename, QFileInfo(filename).path());
     file.close();
   }
   else {
@@ -391,12 +398,48 @@ static bool CompareSongs(const Song &left, const Song &right) {
 
 }
 
+// Result of probing one file in a dropped directory.
+// The probes run in parallel on the thread pool and the results are assembled in input order afterwards.
+struct DirectoryEntryResult {
+  SongList songs;
+  QStringList errors;
+};
+
+static DirectoryEntryResult LoadDirectoryEntry(const QString &filename) {
+
+  DirectoryEntryResult result;
+
+  QFileInfo fileinfo(filename);
+  if (TagReaderClient::Instance()->IsMediaFileBlocking(filename) || Song::kAcceptedExtensions.contains(fileinfo.suffix(), Qt::CaseInsensitive)) {
+    Song song(Song::Source::LocalFile);
+    song.InitFromFilePartial(filename, fileinfo);
+    if (song.is_valid()) {
+      result.songs << song;
+      return result;
+    }
+  }
+
+  result.errors << QObject::tr("File %1 is not recognized as a valid audio file.").arg(filename);
+
+  return result;
+
+}
+
 void SongLoader::LoadLocalDirectory(const QString &filename) {
 
+  // Walking the tree is cheap, probing every file (media type detection goes through the tag reader) is not,
+  // so collect the filenames first and probe them in parallel on the thread pool.
+  // blockingMapped keeps the results in input order, and also runs jobs on the calling thread, so it is safe from a pool thread.
+  QStringList files;
   QDirIterator it(filename, QDir::Files | QDir::NoDotAndDotDot | QDir::Readable, QDirIterator::Subdirectories);
-
   while (it.hasNext()) {
-    LoadLocalPartial(it.next());
+    files << it.next();
+  }
+
+  const QList<DirectoryEntryResult> results = QtConcurrent::blockingMapped(files, &LoadDirectoryEntry);
+  for (const DirectoryEntryResult &result : results) {
+    songs_ << result.songs;
+    errors_ << result.errors;
   }
 
   std::stable_sort(songs_.begin(), songs_.end(), CompareSongs);
@@ -456,6 +499,15 @@ void SongLoader::StopTypefind() {
     AddAsRawStream();
   }
 
+  if (success_ && !songs_.isEmpty() && !requested_url_.isEmpty()) {
+    // Remember the outcome so the next load of this URL starts without repeating the resolve.
+    QMutexLocker l(&sRemoteResolveMutex);
+    RemoteResolveCacheEntry entry;
+    entry.songs = songs_;
+    entry.resolved_ms = QDateTime::currentMSecsSinceEpoch();
+    sRemoteResolveCache.insert(requested_url_, entry);
+  }
+
   emit LoadRemoteFinished();
 
 }
@@ -537,6 +589,34 @@ SongLoader::Result SongLoader::LoadRemote() {
 }
 #endif
 
+#ifdef HAVE_GSTREAMER
+void SongLoader::RevalidateRemoteAsync() {
+
+  {
+    QMutexLocker l(&sRemoteResolveMutex);
+    if (sRemoteRevalidationsInProgress.contains(url_)) return;
+    sRemoteRevalidationsInProgress.insert(url_);
+  }
+
+  // A detached loader repeats the full remote resolve on the thread pool and refreshes the cache when it finishes.
+  // Failures are ignored, the cached outcome stays in place.
+  SongLoader *loader = new SongLoader(collection_backend_, player_);
+  loader->url_ = url_;
+  loader->requested_url_ = url_;
+  loader->preload_func_ = std::bind(&SongLoader::LoadRemote, loader);
+  const QUrl url = url_;
+  (void)QtConcurrent::run([loader, url]() {
+    loader->LoadFilenamesBlocking();
+    {
+      QMutexLocker l(&sRemoteResolveMutex);
+      sRemoteRevalidationsInProgress.remove(url);
+    }
+    loader->deleteLater();
+  });
+
+}
+#endif
+
 #ifdef HAVE_GSTREAMER
 void SongLoader::TypeFound(GstElement*, uint, GstCaps *caps, void *self) {
 
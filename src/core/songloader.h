@@ -113,7 +113,6 @@ class SongLoader : public QObject {
   Result LoadLocal(const QString &filename);
   SongLoader::Result LoadLocalAsync(const QString &filename);
   void EffectiveSongLoad(Song *song);
-  Result LoadLocalPartial(const QString &filename);
   void LoadLocalDirectory(const QString &filename);
   void LoadPlaylist(ParserBase *parser, const QString &filename);
 
@@ -122,6 +121,10 @@ class SongLoader : public QObject {
 #ifdef HAVE_GSTREAMER
   Result LoadRemote();
 
+  // Repeats the remote resolve for url_ on a detached loader and refreshes the cached outcome when it finishes.
+  // Used when a stale cache entry was served, so playback starts from the cached resolve while the URL is re-checked.
+  void RevalidateRemoteAsync();
+
   // GStreamer callbacks
   static void TypeFound(GstElement *typefind, uint probability, GstCaps *caps, void *self);
   static GstPadProbeReturn DataReady(GstPad*, GstPadProbeInfo *info, gpointer self);
@@ -142,6 +145,9 @@ class SongLoader : public QObject {
   static QSet<QString> sRawUriSchemes;
 
   QUrl url_;
+  // The URL as it was requested, before any rewrite during the resolve (e.g. HTTP to MMS for WMSP streams).
+  // Used as the key for the remote resolve cache.
+  QUrl requested_url_;
   SongList songs_;
 
   const SharedPtr<Player> player_;
@@ -19,13 +19,132 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 
+#include "logging.h"
 #include "sqlquery.h"
 
+namespace {
+
+// Per-statement aggregates, keyed on the caller tag when one is set and the prepared statement text otherwise.
+struct QueryStats {
+  qint64 count = 0;
+  qint64 total_nsecs = 0;
+  qint64 max_nsecs = 0;
+  qint64 rows = 0;
+  qint64 failures = 0;
+};
+
+std::atomic<bool> sTraceEnabled(false);
+std::atomic<int> sSlowQueryThresholdMs(100);
+QMutex sStatsMutex;
+QHash<QString, QueryStats> sStats;
+
+}  // namespace
+
+void SqlQuery::SetTraceEnabled(const bool enabled) {
+  sTraceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void SqlQuery::SetSlowQueryThresholdMs(const int ms) {
+  sSlowQueryThresholdMs.store(ms, std::memory_order_relaxed);
+}
+
+bool SqlQuery::TraceEnabled() {
+  return sTraceEnabled.load(std::memory_order_relaxed);
+}
+
+void SqlQuery::ResetStatistics() {
+
+  QMutexLocker l(&sStatsMutex);
+  sStats.clear();
+
+}
+
+QString SqlQuery::DiagnosticsReport() {
+
+  QHash<QString, QueryStats> stats;
+  {
+    QMutexLocker l(&sStatsMutex);
+    stats = sStats;
+  }
+
+  if (stats.isEmpty()) {
+    return QStringLiteral("No queries traced.");
+  }
+
+  QStringList keys = stats.keys();
+  std::sort(keys.begin(), keys.end(), [&stats](const QString &a, const QString &b) { return stats[a].total_nsecs > stats[b].total_nsecs; });
+
+  QStringList lines;
+  lines << QStringLiteral("%1 %2 %3 %4 %5 %6  statement").arg(QStringLiteral("count"), 8).arg(QStringLiteral("total ms"), 10).arg(QStringLiteral("avg ms"), 8).arg(QStringLiteral("max ms"), 8).arg(QStringLiteral("rows"), 10).arg(QStringLiteral("failed"), 6);
+  for (const QString &key : std::as_const(keys)) {
+    const QueryStats &s = stats[key];
+    QString statement = key.simplified();
+    if (statement.length() > 120) statement = statement.left(117) + QStringLiteral("...");
+    lines << QStringLiteral("%1 %2 %3 %4 %5 %6  %7")
+                 .arg(s.count, 8)
+                 .arg(static_cast<double>(s.total_nsecs) / 1e6, 10, 'f', 1)
+                 .arg(static_cast<double>(s.total_nsecs) / static_cast<double>(s.count) / 1e6, 8, 'f', 2)
+                 .arg(static_cast<double>(s.max_nsecs) / 1e6, 8, 'f', 1)
+                 .arg(s.rows, 10)
+                 .arg(s.failures, 6)
+                 .arg(statement);
+  }
+
+  return lines.join(QLatin1Char('\n'));
+
+}
+
+void SqlQuery::RecordTrace(const qint64 elapsed_nsecs, const bool success) {
+
+  const qint64 rows = isSelect() ? static_cast<qint64>(size()) : static_cast<qint64>(numRowsAffected());
+
+  QString key = tag_.isEmpty() ? prepared_sql_ : tag_;
+  if (key.isEmpty()) key = lastQuery();
+
+  {
+    QMutexLocker l(&sStatsMutex);
+    QueryStats &stats = sStats[key];
+    ++stats.count;
+    stats.total_nsecs += elapsed_nsecs;
+    if (elapsed_nsecs > stats.max_nsecs) stats.max_nsecs = elapsed_nsecs;
+    if (rows > 0) stats.rows += rows;
+    if (!success) ++stats.failures;
+  }
+
+  const qint64 elapsed_ms = elapsed_nsecs / 1000000LL;
+  if (elapsed_ms >= sSlowQueryThresholdMs.load(std::memory_order_relaxed)) {
+    qLog(Warning) << "Slow query:" << elapsed_ms << "ms," << rows << "rows:" << key.simplified().left(200);
+  }
+
+}
+
+bool SqlQuery::prepare(const QString &sql) {
+
+  if (!prepared_sql_.isEmpty() && sql == prepared_sql_) {
+    return true;
+  }
+
+  const bool success = QSqlQuery::prepare(sql);
+  prepared_sql_ = success ? sql : QString();
+
+  return success;
+
+}
+
 void SqlQuery::BindValue(const QString &placeholder, const QVariant &value) {
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -92,7 +211,14 @@ void SqlQuery::BindNotNullIntValue(const QString &placeholder, const int value)
 
 bool SqlQuery::Exec() {
 
+  const bool trace = sTraceEnabled.load(std::memory_order_relaxed);
+  QElapsedTimer timer;
+  if (trace) timer.start();
+
   bool success = exec();
+
+  if (trace) RecordTrace(timer.nsecsElapsed(), success);
+
   last_query_ = executedQuery();
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -38,6 +38,9 @@ class SqlQuery : public QSqlQuery {
 
   int columns() const { return QSqlQuery::record().count(); }
 
+  // Skips re-preparing when the same SQL is already prepared on this query, so a query object can be reused in a loop or kept in the statement cache.
+  bool prepare(const QString &sql);
+
   void BindValue(const QString &placeholder, const QVariant &value);
   void BindStringValue(const QString &placeholder, const QString &value);
   void BindUrlValue(const QString &placeholder, const QUrl &value);
@@ -52,11 +55,27 @@ class SqlQuery : public QSqlQuery {
   bool Exec();
   QString LastQuery() const;
 
+  // Callers can tag a query so traces show who issued it instead of just the statement text.
+  void SetTag(const QString &tag) { tag_ = tag; }
+
+  // Query tracing, enabled from Database: every Exec() records wall time and row count,
+  // statements slower than the threshold are logged, and per-statement totals are aggregated for the console dialog.
+  static void SetTraceEnabled(const bool enabled);
+  static void SetSlowQueryThresholdMs(const int ms);
+  static bool TraceEnabled();
+  static QString DiagnosticsReport();
+  static void ResetStatistics();
+
+ private:
+  void RecordTrace(const qint64 elapsed_nsecs, const bool success);
+
  private:
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
   QMap<QString, QVariant> bound_values_;
 #endif
+  QString prepared_sql_;
   QString last_query_;
+  QString tag_;
 
 };
 
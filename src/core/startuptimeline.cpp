@@ -0,0 +1,118 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+#include "startuptimeline.h"
+#include "core/logging.h"
+
+namespace {
+
+struct PhaseEvent {
+  QString name;
+  qint64 start_ms;
+  qint64 end_ms;  // -1 while the phase is still open
+};
+
+bool sEnabled = false;
+QElapsedTimer sTimer;
+QMutex sMutex;
+QList<PhaseEvent> sEvents;
+
+}  // namespace
+
+StartupTimeline::Phase::Phase(const char *name) : name_(name) {
+  BeginPhase(name_);
+}
+
+StartupTimeline::Phase::~Phase() {
+  EndPhase(name_);
+}
+
+void StartupTimeline::SetEnabled(const bool enabled) {
+
+  QMutexLocker l(&sMutex);
+
+  sEnabled = enabled;
+  if (enabled && !sTimer.isValid()) sTimer.start();
+
+}
+
+bool StartupTimeline::enabled() {
+
+  QMutexLocker l(&sMutex);
+
+  return sEnabled;
+
+}
+
+void StartupTimeline::BeginPhase(const char *name) {
+
+  QMutexLocker l(&sMutex);
+
+  if (!sEnabled) return;
+
+  sEvents << PhaseEvent{ QString::fromUtf8(name), sTimer.elapsed(), -1 };
+
+}
+
+void StartupTimeline::EndPhase(const char *name) {
+
+  QMutexLocker l(&sMutex);
+
+  if (!sEnabled) return;
+
+  const QString phase_name = QString::fromUtf8(name);
+  // Match the most recent open phase with this name, so nested or repeated phases (i.e. one database connection per thread) pair up correctly.
+  for (qsizetype i = sEvents.count() - 1; i >= 0; --i) {
+    if (sEvents[i].name == phase_name && sEvents[i].end_ms == -1) {
+      sEvents[i].end_ms = sTimer.elapsed();
+      return;
+    }
+  }
+
+}
+
+void StartupTimeline::Dump() {
+
+  QMutexLocker l(&sMutex);
+
+  if (!sEnabled || sEvents.isEmpty()) return;
+
+  QList<PhaseEvent> events = sEvents;
+  const qint64 now_ms = sTimer.elapsed();
+
+  std::stable_sort(events.begin(), events.end(), [](const PhaseEvent &a, const PhaseEvent &b) { return a.start_ms < b.start_ms; });
+
+  qLog(Info) << "Startup timeline:";
+  for (const PhaseEvent &event : std::as_const(events)) {
+    const qint64 end_ms = event.end_ms == -1 ? now_ms : event.end_ms;
+    qLog(Info) << QStringLiteral("  %1 ms  +%2 ms  %3%4").arg(event.start_ms, 6).arg(end_ms - event.start_ms, 5).arg(event.name, event.end_ms == -1 ? QStringLiteral(" (still running)") : QString());
+  }
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+
+// Lightweight profiler for the startup path, enabled with --profile-startup.
+// Scoped Phase markers record when the expensive startup stages begin and end,
+// and Dump() prints the collected timeline through the normal log output once
+// the event loop is running, so slow start reports can include it.
+// Recording is thread safe - phases may begin and end on any thread.
+// When profiling is not enabled the markers are cheap no-ops.
+class StartupTimeline {
+ public:
+  // Records a phase from construction to destruction.
+  class Phase {
+   public:
+    explicit Phase(const char *name);
+    ~Phase();
+
+   private:
+    const char *name_;
+    Q_DISABLE_COPY(Phase)
+  };
+
+  static void SetEnabled(const bool enabled);
+  static bool enabled();
+
+  // For stages that cannot be wrapped in a scope, Begin and End must be called with the same name.
+  static void BeginPhase(const char *name);
+  static void EndPhase(const char *name);
+
+  static void Dump();
+};
+
+#endif  // STARTUPTIMELINE_H
@@ -22,23 +22,88 @@
 #include "config.h"
 
 #include <string>
+#include <utility>
+
+#include <cstring>
 
 #include <QtGlobal>
 #include <QObject>
 #include <QThread>
+#include <QBuffer>
 #include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
 #include <QString>
+#include <QStringList>
 #include <QImage>
+#include <QSharedMemory>
+#include <QUuid>
 
 #include "core/logging.h"
+#include "core/settings.h"
 #include "core/workerpool.h"
+#include "utilities/mimeutils.h"
 
 #include "song.h"
 #include "tagreaderclient.h"
+#ifdef HAVE_TAGLIB
+#  include "tagreadertaglib.h"
+#endif
 
 namespace {
+
 constexpr char kWorkerExecutableName[] = "strawberry-tagreader";
+
+constexpr char kSettingsGroup[] = "TagReader";
+
+#ifdef HAVE_TAGLIB
+// Whether a file is in one of the plain, battle-tested formats that are safe to parse in-process when the fast path is enabled.
+// Exotic containers, such as the module formats handled by TagReaderGME, always stay in the worker process.
+bool InProcessReadableFile(const QString &filename) {
+
+  const QString extension = QFileInfo(filename).suffix().toLower();
+
+  return extension == QLatin1String("flac") ||
+         extension == QLatin1String("mp3") ||
+         extension == QLatin1String("ogg") ||
+         extension == QLatin1String("oga") ||
+         extension == QLatin1String("opus") ||
+         extension == QLatin1String("m4a");
+
 }
+#endif
+
+// Cover art blobs at least this big are passed to the worker in a shared memory segment instead of inline in the message,
+// so multi-MB art doesn't get protobuf-serialized, copied through the socket and deserialized.
+constexpr qint64 kCoverDataSharedMemoryThreshold = 512 * 1024;
+
+// How many files a single batched read request carries at most.
+constexpr int kMaxReadFileBatchSize = 200;
+
+// Puts the cover data in the request, either inline or in a shared memory segment when it's large.
+// Returns the segment, which the caller must keep alive until the reply for the request arrives, or nullptr when the data was sent inline.
+template<typename RequestType>
+QSharedMemory *SetRequestCoverData(RequestType *request, const QByteArray &cover_data) {
+
+  if (cover_data.size() >= kCoverDataSharedMemoryThreshold) {
+    QSharedMemory *shared_memory = new QSharedMemory(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    if (shared_memory->create(cover_data.size())) {
+      memcpy(shared_memory->data(), cover_data.constData(), cover_data.size());
+      request->mutable_cover_shmem()->set_key(shared_memory->key().toStdString());
+      request->mutable_cover_shmem()->set_size(static_cast<quint64>(cover_data.size()));
+      return shared_memory;
+    }
+    qLog(Debug) << "Could not create shared memory segment for cover data:" << shared_memory->errorString();
+    delete shared_memory;
+  }
+
+  request->set_cover_data(cover_data.toStdString());
+
+  return nullptr;
+
+}
+
+}  // namespace
 
 TagReaderClient *TagReaderClient::sInstance = nullptr;
 
@@ -48,8 +113,27 @@ TagReaderClient::TagReaderClient(QObject *parent) : QObject(parent), worker_pool
   original_thread_ = thread();
 
   worker_pool_->SetExecutableName(QLatin1String(kWorkerExecutableName));
+  // Let the pool grow with dedicated workers for batch traffic during collection scans, so interactive tag reads and edits never queue behind a scan.
+  worker_pool_->SetMaxWorkerCount(qBound(2, QThread::idealThreadCount() / 2, 4));
   QObject::connect(worker_pool_, &WorkerPool<HandlerType>::WorkerFailedToStart, this, &TagReaderClient::WorkerFailedToStart);
 
+#ifdef HAVE_TAGLIB
+  Settings s;
+  s.beginGroup(kSettingsGroup);
+  const bool inprocess = s.value("inprocess", false).toBool();
+  s.endGroup();
+  // Opt-in: the worker process exists for crash isolation, and the in-process fast path gives that up to skip the IPC round trip for the common formats.
+  inprocess_reader_ = inprocess ? new TagReaderTagLib : nullptr;
+#endif
+
+}
+
+TagReaderClient::~TagReaderClient() {
+
+#ifdef HAVE_TAGLIB
+  delete inprocess_reader_;
+#endif
+
 }
 
 void TagReaderClient::Start() { worker_pool_->Start(); }
@@ -61,6 +145,7 @@ void TagReaderClient::ExitAsync() {
 void TagReaderClient::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
+  tag_cache_.Save();
   moveToThread(original_thread_);
   emit ExitFinished();
 
@@ -78,16 +163,30 @@ TagReaderReply *TagReaderClient::IsMediaFile(const QString &filename) {
 
 }
 
-TagReaderReply *TagReaderClient::ReadFile(const QString &filename) {
+TagReaderReply *TagReaderClient::ReadFile(const QString &filename, const bool batch) {
 
   spb::tagreader::Message message;
   message.mutable_read_file_request()->set_filename(filename.toStdString());
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, batch);
+
+}
+
+TagReaderReply *TagReaderClient::ReadFileBatch(const QStringList &filenames) {
+
+  spb::tagreader::Message message;
+  spb::tagreader::ReadFileBatchRequest *request = message.mutable_read_file_batch_request();
+  for (const QString &filename : filenames) {
+    request->add_filenames(filename.toStdString());
+  }
+  return worker_pool_->SendMessageWithReply(&message, true);
 
 }
 
 TagReaderReply *TagReaderClient::WriteFile(const QString &filename, const Song &metadata, const SaveTypes save_types, const SaveCoverOptions &save_cover_options) {
 
+  // The file is about to change, so the cached tags for it can't be trusted any more.
+  tag_cache_.Remove(filename);
+
   spb::tagreader::Message message;
   spb::tagreader::WriteFileRequest *request = message.mutable_write_file_request();
 
@@ -101,8 +200,9 @@ TagReaderReply *TagReaderClient::WriteFile(const QString &filename, const Song &
   if (!save_cover_options.cover_filename.isEmpty()) {
     request->set_cover_filename(save_cover_options.cover_filename.toStdString());
   }
+  QSharedMemory *cover_shared_memory = nullptr;
   if (!save_cover_options.cover_data.isEmpty()) {
-    request->set_cover_data(save_cover_options.cover_data.toStdString());
+    cover_shared_memory = SetRequestCoverData(request, save_cover_options.cover_data);
   }
   if (!save_cover_options.mime_type.isEmpty()) {
     request->set_cover_mime_type(save_cover_options.mime_type.toStdString());
@@ -112,6 +212,11 @@ TagReaderReply *TagReaderClient::WriteFile(const QString &filename, const Song &
 
   ReplyType *reply = worker_pool_->SendMessageWithReply(&message);
 
+  if (cover_shared_memory) {
+    // Keep the segment attached until the worker has replied, otherwise it's freed before the worker can attach to it.
+    QObject::connect(reply, &TagReaderReply::Finished, reply, [cover_shared_memory]() { delete cover_shared_memory; });
+  }
+
   return reply;
 
 }
@@ -129,6 +234,8 @@ TagReaderReply *TagReaderClient::LoadEmbeddedArt(const QString &filename) {
 
 TagReaderReply *TagReaderClient::SaveEmbeddedArt(const QString &filename, const SaveCoverOptions &save_cover_options) {
 
+  tag_cache_.Remove(filename);
+
   spb::tagreader::Message message;
   spb::tagreader::SaveEmbeddedArtRequest *request = message.mutable_save_embedded_art_request();
 
@@ -137,19 +244,29 @@ TagReaderReply *TagReaderClient::SaveEmbeddedArt(const QString &filename, const
   if (!save_cover_options.cover_filename.isEmpty()) {
     request->set_cover_filename(save_cover_options.cover_filename.toStdString());
   }
+  QSharedMemory *cover_shared_memory = nullptr;
   if (!save_cover_options.cover_data.isEmpty()) {
-    request->set_cover_data(save_cover_options.cover_data.toStdString());
+    cover_shared_memory = SetRequestCoverData(request, save_cover_options.cover_data);
   }
   if (!save_cover_options.mime_type.isEmpty()) {
     request->set_cover_mime_type(save_cover_options.mime_type.toStdString());
   }
 
-  return worker_pool_->SendMessageWithReply(&message);
+  ReplyType *reply = worker_pool_->SendMessageWithReply(&message);
+
+  if (cover_shared_memory) {
+    // Keep the segment attached until the worker has replied, otherwise it's freed before the worker can attach to it.
+    QObject::connect(reply, &TagReaderReply::Finished, reply, [cover_shared_memory]() { delete cover_shared_memory; });
+  }
+
+  return reply;
 
 }
 
 TagReaderReply *TagReaderClient::SaveSongPlaycount(const QString &filename, const uint playcount) {
 
+  tag_cache_.Remove(filename);
+
   spb::tagreader::Message message;
   spb::tagreader::SaveSongPlaycountToFileRequest *request = message.mutable_save_song_playcount_to_file_request();
 
@@ -171,6 +288,8 @@ void TagReaderClient::SaveSongsPlaycount(const SongList &songs) {
 
 TagReaderReply *TagReaderClient::SaveSongRating(const QString &filename, const float rating) {
 
+  tag_cache_.Remove(filename);
+
   spb::tagreader::Message message;
   spb::tagreader::SaveSongRatingToFileRequest *request = message.mutable_save_song_rating_to_file_request();
 
@@ -190,6 +309,50 @@ void TagReaderClient::SaveSongsRating(const SongList &songs) {
 
 }
 
+TagReaderClient::SaveCoverOptions TagReaderClient::EncodeCoverForEmbedding(const SaveCoverOptions &save_cover_options) {
+
+  SaveCoverOptions encoded = save_cover_options;
+
+  if (encoded.cover_data.isEmpty() && !encoded.cover_filename.isEmpty()) {
+    QFile file(encoded.cover_filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+      qLog(Error) << "Failed to open cover file" << encoded.cover_filename << "for reading:" << file.errorString();
+      return save_cover_options;
+    }
+    encoded.cover_data = file.readAll();
+    file.close();
+    encoded.cover_filename.clear();
+  }
+
+  if (encoded.cover_data.isEmpty()) return encoded;
+
+  if (encoded.mime_type.isEmpty()) {
+    encoded.mime_type = Utilities::MimeTypeFromData(encoded.cover_data);
+  }
+
+  // The workers embed JPEG and PNG data as-is, everything else they decode and re-encode, so do that conversion here instead.
+  if (encoded.mime_type == QLatin1String("image/jpeg") || encoded.mime_type == QLatin1String("image/png")) {
+    return encoded;
+  }
+
+  QImage cover_image;
+  if (!cover_image.loadFromData(encoded.cover_data)) {
+    qLog(Error) << "Failed to load image from cover data";
+    return encoded;
+  }
+
+  encoded.cover_data.clear();
+  QBuffer buffer(&encoded.cover_data);
+  if (buffer.open(QIODevice::WriteOnly)) {
+    cover_image.save(&buffer, "JPEG");
+    buffer.close();
+  }
+  encoded.mime_type = QStringLiteral("image/jpeg");
+
+  return encoded;
+
+}
+
 bool TagReaderClient::IsMediaFileBlocking(const QString &filename) {
 
   Q_ASSERT(QThread::currentThread() != thread());
@@ -213,9 +376,48 @@ TagReaderClient::Result TagReaderClient::ReadFileBlocking(const QString &filenam
 
   Q_ASSERT(QThread::currentThread() != thread());
 
+  spb::tagreader::SongMetadata cached_metadata;
+  if (tag_cache_.Load(filename, &cached_metadata)) {
+    song->InitFromProtobuf(cached_metadata);
+    return Result(Result::ErrorCode::Success);
+  }
+
+#ifdef HAVE_TAGLIB
+  if (inprocess_reader_ && InProcessReadableFile(filename)) {
+    return ReadFileInProcess(filename, song);
+  }
+#endif
+
+  return ReadFileReplyBlocking(ReadFile(filename), song);
+
+}
+
+#ifdef HAVE_TAGLIB
+TagReaderClient::Result TagReaderClient::ReadFileInProcess(const QString &filename, Song *song) {
+
+  spb::tagreader::SongMetadata metadata;
+  const TagReaderBase::Result reader_result = inprocess_reader_->ReadFile(filename, &metadata);
+  if (reader_result.success()) {
+    song->InitFromProtobuf(metadata);
+    tag_cache_.Insert(filename, metadata);
+    return Result(Result::ErrorCode::Success);
+  }
+
+  if (reader_result.error_code == TagReaderBase::Result::ErrorCode::Unsupported) {
+    return Result(Result::ErrorCode::Unsupported, TagReaderBase::ErrorString(reader_result));
+  }
+
+  return Result(Result::ErrorCode::Failure, TagReaderBase::ErrorString(reader_result));
+
+}
+#endif
+
+TagReaderClient::Result TagReaderClient::ReadFileReplyBlocking(ReplyType *reply, Song *song) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+
   Result result(Result::ErrorCode::Failure);
 
-  TagReaderReply *reply = ReadFile(filename);
   if (reply->WaitForFinished()) {
     const spb::tagreader::ReadFileResponse &response = reply->message().read_file_response();
     if (response.has_success()) {
@@ -223,6 +425,9 @@ TagReaderClient::Result TagReaderClient::ReadFileBlocking(const QString &filenam
         result.error_code = Result::ErrorCode::Success;
         if (response.has_metadata()) {
           song->InitFromProtobuf(response.metadata());
+          if (reply->request_message().has_read_file_request()) {
+            tag_cache_.Insert(QString::fromStdString(reply->request_message().read_file_request().filename()), response.metadata());
+          }
         }
       }
       else {
@@ -239,6 +444,73 @@ TagReaderClient::Result TagReaderClient::ReadFileBlocking(const QString &filenam
 
 }
 
+QList<TagReaderClient::Result> TagReaderClient::ReadFileBatchBlocking(const QStringList &filenames, SongList *songs) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+  Q_ASSERT(songs->count() == filenames.count());
+
+  QList<Result> results;
+  results.reserve(filenames.count());
+
+  // Answer what we can from the tag cache, so only the files that have changed go to the workers.
+  QStringList miss_filenames;
+  QList<qsizetype> miss_indices;
+  for (qsizetype i = 0; i < filenames.count(); ++i) {
+    spb::tagreader::SongMetadata cached_metadata;
+    if (tag_cache_.Load(filenames[i], &cached_metadata)) {
+      (*songs)[i].InitFromProtobuf(cached_metadata);
+      results << Result(Result::ErrorCode::Success);
+    }
+    else {
+      miss_filenames << filenames[i];
+      miss_indices << i;
+      results << Result(Result::ErrorCode::Failure);
+    }
+  }
+  if (miss_filenames.isEmpty()) return results;
+
+  // Split the files into one batch per worker, so a big batch keeps all the workers busy instead of serializing on one.
+  qsizetype batch_size = (miss_filenames.count() + worker_pool_->worker_count() - 1) / worker_pool_->worker_count();
+  batch_size = qBound(static_cast<qsizetype>(1), batch_size, static_cast<qsizetype>(kMaxReadFileBatchSize));
+
+  QList<QPair<ReplyType*, qsizetype>> replies;
+  for (qsizetype i = 0; i < miss_filenames.count(); i += batch_size) {
+    const QStringList batch_filenames = miss_filenames.mid(i, batch_size);
+    replies << qMakePair(ReadFileBatch(batch_filenames), batch_filenames.count());
+  }
+
+  qsizetype miss_idx = 0;
+  for (const QPair<ReplyType*, qsizetype> &reply_and_count : std::as_const(replies)) {
+    ReplyType *reply = reply_and_count.first;
+    qsizetype count_received = 0;
+    if (reply->WaitForFinished()) {
+      const spb::tagreader::ReadFileBatchResponse &response = reply->message().read_file_batch_response();
+      for (int i = 0; i < response.responses_size() && count_received < reply_and_count.second; ++i, ++count_received, ++miss_idx) {
+        const spb::tagreader::ReadFileResponse &file_response = response.responses(i);
+        const qsizetype song_idx = miss_indices[miss_idx];
+        Result result(Result::ErrorCode::Failure);
+        if (file_response.has_success() && file_response.success()) {
+          result.error_code = Result::ErrorCode::Success;
+          if (file_response.has_metadata()) {
+            (*songs)[song_idx].InitFromProtobuf(file_response.metadata());
+            tag_cache_.Insert(miss_filenames[miss_idx], file_response.metadata());
+          }
+        }
+        else if (file_response.has_error()) {
+          result.error = QString::fromStdString(file_response.error());
+        }
+        results[song_idx] = result;
+      }
+    }
+    // Files the reply didn't cover, e.g. when the request was aborted, keep their failure results.
+    miss_idx += reply_and_count.second - count_received;
+    reply->deleteLater();
+  }
+
+  return results;
+
+}
+
 TagReaderClient::Result TagReaderClient::WriteFileBlocking(const QString &filename, const Song &metadata, const SaveTypes save_types, const SaveCoverOptions &save_cover_options) {
 
   Q_ASSERT(QThread::currentThread() != thread());
@@ -265,9 +537,16 @@ TagReaderClient::Result TagReaderClient::LoadEmbeddedArtBlocking(const QString &
 
   Q_ASSERT(QThread::currentThread() != thread());
 
+  return LoadEmbeddedArtReplyBlocking(LoadEmbeddedArt(filename), data);
+
+}
+
+TagReaderClient::Result TagReaderClient::LoadEmbeddedArtReplyBlocking(ReplyType *reply, QByteArray &data) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+
   Result result(Result::ErrorCode::Failure);
 
-  TagReaderReply *reply = LoadEmbeddedArt(filename);
   if (reply->WaitForFinished()) {
     const spb::tagreader::LoadEmbeddedArtResponse &response = reply->message().load_embedded_art_response();
     if (response.has_success()) {
@@ -291,6 +570,31 @@ TagReaderClient::Result TagReaderClient::LoadEmbeddedArtBlocking(const QString &
 
 }
 
+QList<TagReaderClient::Cover> TagReaderClient::LoadEmbeddedArtBatchBlocking(const QStringList &filenames) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+
+  QList<ReplyType*> replies;
+  replies.reserve(filenames.count());
+  for (const QString &filename : filenames) {
+    replies << LoadEmbeddedArt(filename);
+  }
+
+  QList<Cover> covers;
+  covers.reserve(filenames.count());
+  for (ReplyType *reply : std::as_const(replies)) {
+    Cover cover;
+    const Result result = LoadEmbeddedArtReplyBlocking(reply, cover.data);
+    if (!result.success()) {
+      cover.error = result.error;
+    }
+    covers << cover;
+  }
+
+  return covers;
+
+}
+
 TagReaderClient::Result TagReaderClient::LoadEmbeddedArtAsImageBlocking(const QString &filename, QImage &image) {
 
   Q_ASSERT(QThread::currentThread() != thread());
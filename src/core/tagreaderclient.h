@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QList>
 #include <QString>
+#include <QStringList>
 #include <QImage>
 
 #include "core/messagehandler.h"
@@ -34,16 +35,21 @@
 
 #include "song.h"
 #include "tagreadermessages.pb.h"
+#include "tagreadertagcache.h"
 
 class QThread;
 class Song;
 template<typename HandlerType> class WorkerPool;
+#ifdef HAVE_TAGLIB
+class TagReaderTagLib;
+#endif
 
 class TagReaderClient : public QObject {
   Q_OBJECT
 
  public:
   explicit TagReaderClient(QObject *parent = nullptr);
+  ~TagReaderClient() override;
 
   using HandlerType = AbstractMessageHandler<spb::tagreader::Message>;
   using ReplyType = HandlerType::ReplyType;
@@ -92,24 +98,49 @@ class TagReaderClient : public QObject {
   };
 
   ReplyType *IsMediaFile(const QString &filename);
-  ReplyType *ReadFile(const QString &filename);
+  // Set batch for bulk traffic such as collection scans, so it goes to the pool's dedicated batch workers and never delays interactive reads.
+  ReplyType *ReadFile(const QString &filename, const bool batch = false);
+  // Reads the tags of all the files with a single message, so the per-message IPC overhead is paid once per batch instead of once per file.
+  ReplyType *ReadFileBatch(const QStringList &filenames);
   ReplyType *WriteFile(const QString &filename, const Song &metadata, const SaveTypes types = SaveType::Tags, const SaveCoverOptions &save_cover_options = SaveCoverOptions());
   ReplyType *LoadEmbeddedArt(const QString &filename);
   ReplyType *SaveEmbeddedArt(const QString &filename, const SaveCoverOptions &save_cover_options);
   ReplyType *SaveSongPlaycount(const QString &filename, const uint playcount);
   ReplyType *SaveSongRating(const QString &filename, const float rating);
 
+  // Performs the decode and convert-to-JPEG pass the worker would otherwise repeat for every file:
+  // reads the cover file if only a filename is given and converts formats other than JPEG and PNG, which the workers embed as-is.
+  // Callers embedding one cover into many files can run this once on a worker thread and reuse the encoded data for every file.
+  static SaveCoverOptions EncodeCoverForEmbedding(const SaveCoverOptions &save_cover_options);
+
   // Convenience functions that call the above functions and wait for a response.
   // These block the calling thread with a semaphore, and must NOT be called from the TagReaderClient's thread.
   Result ReadFileBlocking(const QString &filename, Song *song);
+  // Waits for a reply from ReadFile(), fills in the song and deletes the reply.
+  // Callers can send several ReadFile() requests before blocking on the replies to pipeline reads across the workers.
+  Result ReadFileReplyBlocking(ReplyType *reply, Song *song);
+  // Reads the tags of all the files, split into one batch per worker so a big batch keeps all the workers busy.
+  // songs must already contain one song per file; each song is filled in on success, like ReadFileBlocking() does.
+  // Returns one result per file, in the same order as filenames.
+  QList<Result> ReadFileBatchBlocking(const QStringList &filenames, SongList *songs);
   Result WriteFileBlocking(const QString &filename, const Song &metadata, const SaveTypes types = SaveType::Tags, const SaveCoverOptions &save_cover_options = SaveCoverOptions());
   bool IsMediaFileBlocking(const QString &filename);
   Result LoadEmbeddedArtBlocking(const QString &filename, QByteArray &data);
+  // Waits for a reply from LoadEmbeddedArt(), fills in the data and deletes the reply.
+  // Callers can send several LoadEmbeddedArt() requests before blocking on the replies to pipeline loads across the workers.
+  Result LoadEmbeddedArtReplyBlocking(ReplyType *reply, QByteArray &data);
+  // Loads the embedded art for all the files in one pipelined operation:
+  // all the requests are sent before the first reply is collected, so they are spread across the workers.
+  // Returns one Cover per file, in the same order as filenames.
+  QList<Cover> LoadEmbeddedArtBatchBlocking(const QStringList &filenames);
   Result LoadEmbeddedArtAsImageBlocking(const QString &filename, QImage &image);
   Result SaveEmbeddedArtBlocking(const QString &filename, const SaveCoverOptions &save_cover_options);
   Result SaveSongPlaycountBlocking(const QString &filename, const uint playcount);
   Result SaveSongRatingBlocking(const QString &filename, const float rating);
 
+  // Returns a snapshot of the worker pool's queue depths and request statistics, shown in the console dialog.
+  QString WorkerPoolDiagnostics() { return worker_pool_->DiagnosticsReport(); }
+
   // TODO: Make this not a singleton
   static TagReaderClient *Instance() { return sInstance; }
 
@@ -125,11 +156,22 @@ class TagReaderClient : public QObject {
   void SaveSongsRating(const SongList &songs);
 
  private:
+#ifdef HAVE_TAGLIB
+  // Reads the tags in-process and fills in the song, bypassing the worker process.
+  Result ReadFileInProcess(const QString &filename, Song *song);
+#endif
+
   static TagReaderClient *sInstance;
 
   WorkerPool<HandlerType> *worker_pool_;
   QList<spb::tagreader::Message> message_queue_;
   QThread *original_thread_;
+  // Caches the results of blocking reads keyed by (path, mtime, size), so repeat reads of unchanged files skip the worker process.
+  TagReaderTagCache tag_cache_;
+#ifdef HAVE_TAGLIB
+  // Only set when the opt-in in-process fast path is enabled, which trades the crash isolation of the worker process for lower per-file latency.
+  TagReaderTagLib *inprocess_reader_;
+#endif
 };
 
 using TagReaderReply = TagReaderClient::ReplyType;
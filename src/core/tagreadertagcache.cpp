@@ -0,0 +1,191 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <string>
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QString>
+#include <QStringList>
+
+#include "core/logging.h"
+
+#include "tagreadertagcache.h"
+
+namespace {
+
+constexpr quint32 kTagCacheMagic = 0x53745463;  // 'StTc'
+constexpr quint32 kTagCacheVersion = 1;
+
+// How many files the cache keeps tags for.  Entries are evicted least recently used first.
+constexpr int kTagCacheMaxEntries = 20000;
+
+}  // namespace
+
+TagReaderTagCache::TagReaderTagCache() : cache_(kTagCacheMaxEntries), loaded_(false), dirty_(false) {}
+
+TagReaderTagCache::~TagReaderTagCache() { Save(); }
+
+QString TagReaderTagCache::CacheFilename() const {
+
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/tagreader-tagcache.bin");
+
+}
+
+bool TagReaderTagCache::Load(const QString &filename, spb::tagreader::SongMetadata *metadata) {
+
+  const QFileInfo fileinfo(filename);
+  const qint64 mtime = fileinfo.lastModified().toSecsSinceEpoch();
+  const qint64 size = fileinfo.size();
+
+  QMutexLocker l(&mutex_);
+
+  EnsureLoaded();
+
+  CachedTag *cached_tag = cache_.object(filename);
+  if (!cached_tag) return false;
+
+  if (cached_tag->mtime != mtime || cached_tag->size != size) {
+    // The file has changed since the tags were cached, so the entry is useless now.
+    cache_.remove(filename);
+    dirty_ = true;
+    return false;
+  }
+
+  return metadata->ParseFromArray(cached_tag->metadata.constData(), static_cast<int>(cached_tag->metadata.size()));
+
+}
+
+void TagReaderTagCache::Insert(const QString &filename, const spb::tagreader::SongMetadata &metadata) {
+
+  const QFileInfo fileinfo(filename);
+  const qint64 mtime = fileinfo.lastModified().toSecsSinceEpoch();
+  const qint64 size = fileinfo.size();
+  if (mtime == 0 || size <= 0) return;
+
+  const std::string data = metadata.SerializeAsString();
+
+  CachedTag *cached_tag = new CachedTag;
+  cached_tag->mtime = mtime;
+  cached_tag->size = size;
+  cached_tag->metadata = QByteArray(data.data(), static_cast<qint64>(data.size()));
+
+  QMutexLocker l(&mutex_);
+
+  EnsureLoaded();
+
+  cache_.insert(filename, cached_tag);
+  dirty_ = true;
+
+}
+
+void TagReaderTagCache::Remove(const QString &filename) {
+
+  QMutexLocker l(&mutex_);
+
+  EnsureLoaded();
+
+  if (cache_.remove(filename)) {
+    dirty_ = true;
+  }
+
+}
+
+void TagReaderTagCache::EnsureLoaded() {
+
+  if (loaded_) return;
+
+  loaded_ = true;
+
+  QFile file(CacheFilename());
+  if (!file.exists()) return;
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Could not open tag cache" << file.fileName() << "for reading:" << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  quint32 magic = 0, version = 0;
+  s >> magic >> version;
+  if (magic != kTagCacheMagic || version != kTagCacheVersion) {
+    file.close();
+    return;
+  }
+
+  quint32 count = 0;
+  s >> count;
+  for (quint32 idx = 0; idx < count && s.status() == QDataStream::Ok; ++idx) {
+    QString filename;
+    CachedTag *cached_tag = new CachedTag;
+    s >> filename >> cached_tag->mtime >> cached_tag->size >> cached_tag->metadata;
+    if (s.status() == QDataStream::Ok) {
+      cache_.insert(filename, cached_tag);
+    }
+    else {
+      delete cached_tag;
+    }
+  }
+
+  if (s.status() != QDataStream::Ok) {
+    qLog(Error) << "Tag cache" << file.fileName() << "is corrupt, ignoring it.";
+    cache_.clear();
+  }
+
+  file.close();
+
+}
+
+void TagReaderTagCache::Save() {
+
+  QMutexLocker l(&mutex_);
+
+  if (!dirty_) return;
+
+  QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QFile file(CacheFilename());
+  if (!file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Could not open tag cache" << file.fileName() << "for writing:" << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  s << kTagCacheMagic << kTagCacheVersion;
+  const QStringList keys = cache_.keys();
+  s << static_cast<quint32>(keys.count());
+  for (const QString &filename : keys) {
+    const CachedTag *cached_tag = cache_.object(filename);
+    if (!cached_tag) continue;
+    s << filename << cached_tag->mtime << cached_tag->size << cached_tag->metadata;
+  }
+
+  file.close();
+
+  dirty_ = false;
+
+}
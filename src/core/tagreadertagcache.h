@@ -0,0 +1,73 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TAGREADERTAGCACHE_H
+#define TAGREADERTAGCACHE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QString>
+
+#include "tagreadermessages.pb.h"
+
+// A persistent LRU cache of tag reader results keyed by (path, mtime, size),
+// so repeat reads of unchanged files are answered without round-tripping to the worker process.
+// All methods are thread safe.
+class TagReaderTagCache {
+ public:
+  explicit TagReaderTagCache();
+  ~TagReaderTagCache();
+
+  // Returns true and fills in metadata when there is an entry for the file and the file's mtime and size still match.
+  bool Load(const QString &filename, spb::tagreader::SongMetadata *metadata);
+
+  // Stores the metadata for the file, keyed by the file's current mtime and size.
+  void Insert(const QString &filename, const spb::tagreader::SongMetadata &metadata);
+
+  // Drops the entry for the file, used when tags are about to be written so a stale entry can't survive an mtime collision.
+  void Remove(const QString &filename);
+
+  // Writes the cache to disk when entries were added or removed since the last save.
+  void Save();
+
+ private:
+  class CachedTag {
+   public:
+    qint64 mtime = 0;
+    qint64 size = 0;
+    QByteArray metadata;
+  };
+
+  QString CacheFilename() const;
+  // Loads the cache from disk on first use.  mutex_ must be held.
+  void EnsureLoaded();
+
+  QMutex mutex_;
+  QCache<QString, CachedTag> cache_;
+  bool loaded_;
+  bool dirty_;
+
+  Q_DISABLE_COPY(TagReaderTagCache)
+};
+
+#endif  // TAGREADERTAGCACHE_H
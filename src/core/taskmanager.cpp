@@ -108,6 +108,21 @@ void TaskManager::IncreaseTaskProgress(const int id, const quint64 progress, con
 
 }
 
+void TaskManager::SetTaskStatus(const int id, const QString &status) {
+
+  {
+    QMutexLocker l(&mutex_);
+    if (!tasks_.contains(id)) return;
+
+    Task &t = tasks_[id];
+    if (t.status == status) return;
+    t.status = status;
+  }
+
+  emit TasksChanged();
+
+}
+
 void TaskManager::SetTaskFinished(const int id) {
 
   bool resume_collection_watchers = false;
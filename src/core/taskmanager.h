@@ -43,6 +43,8 @@ class TaskManager : public QObject {
     QString name;
     quint64 progress;
     quint64 progress_max;
+    // Optional free-form status shown next to the percentage, e.g. transfer rate and time remaining.
+    QString status;
     bool blocks_collection_scans;
   };
 
@@ -66,6 +68,7 @@ class TaskManager : public QObject {
   void SetTaskBlocksCollectionScans(const int id);
   void SetTaskProgress(const int id, const quint64 progress, const quint64 max = 0);
   void IncreaseTaskProgress(const int id, const quint64 progress, const quint64 max = 0);
+  void SetTaskStatus(const int id, const QString &status);
   void SetTaskFinished(const int id);
   quint64 GetTaskProgress(const int id);
 
@@ -26,82 +26,148 @@
 #include <QCoreApplication>
 #include <QStandardPaths>
 #include <QIODevice>
+#include <QHash>
 #include <QMutex>
 #include <QNetworkDiskCache>
 #include <QNetworkCacheMetaData>
 #include <QAbstractNetworkCache>
+#include <QString>
 #include <QUrl>
 
 #include "threadsafenetworkdiskcache.h"
 
-QMutex ThreadSafeNetworkDiskCache::sMutex;
+QMutex ThreadSafeNetworkDiskCache::sInstancesMutex;
 int ThreadSafeNetworkDiskCache::sInstances = 0;
-QNetworkDiskCache *ThreadSafeNetworkDiskCache::sCache = nullptr;
+QMutex ThreadSafeNetworkDiskCache::sMutexes[kShardCount];
+QNetworkDiskCache *ThreadSafeNetworkDiskCache::sCaches[kShardCount] = {};
+QMutex ThreadSafeNetworkDiskCache::sPreparedDevicesMutex;
+QHash<QIODevice*, int> ThreadSafeNetworkDiskCache::sPreparedDevices;
 
 ThreadSafeNetworkDiskCache::ThreadSafeNetworkDiskCache(QObject *parent) : QAbstractNetworkCache(parent) {
 
-  QMutexLocker l(&sMutex);
+  QMutexLocker l(&sInstancesMutex);
   ++sInstances;
 
-  if (!sCache) {
-    sCache = new QNetworkDiskCache;
+  if (!sCaches[0]) {
 #ifdef Q_OS_WIN32
-    sCache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QStringLiteral("/strawberry/networkcache"));
+    const QString cache_directory = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QStringLiteral("/strawberry/networkcache");
 #else
-    sCache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/networkcache"));
+    const QString cache_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/networkcache");
 #endif
+    for (int i = 0; i < kShardCount; ++i) {
+      sCaches[i] = new QNetworkDiskCache;
+      sCaches[i]->setCacheDirectory(cache_directory + QStringLiteral("/shard-%1").arg(i));
+      // Split Qt's default maximum size across the shards so the total disk usage stays the same.
+      sCaches[i]->setMaximumCacheSize(sCaches[i]->maximumCacheSize() / kShardCount);
+    }
   }
 
 }
 
 ThreadSafeNetworkDiskCache::~ThreadSafeNetworkDiskCache() {
 
-  QMutexLocker l(&sMutex);
+  QMutexLocker l(&sInstancesMutex);
   --sInstances;
 
-  if (sCache && sInstances == 0) {
-    sCache->deleteLater();
-    sCache = nullptr;
+  if (sCaches[0] && sInstances == 0) {
+    for (int i = 0; i < kShardCount; ++i) {
+      sCaches[i]->deleteLater();
+      sCaches[i] = nullptr;
+    }
+    QMutexLocker lp(&sPreparedDevicesMutex);
+    sPreparedDevices.clear();
   }
 
 }
 
+int ThreadSafeNetworkDiskCache::ShardForUrl(const QUrl &url) {
+  return static_cast<int>(qHash(url) % static_cast<uint>(kShardCount));
+}
+
+qint64 ThreadSafeNetworkDiskCache::TotalCacheSize() {
+
+  {
+    QMutexLocker l(&sInstancesMutex);
+    if (!sCaches[0]) return 0;
+  }
+
+  qint64 size = 0;
+  for (int i = 0; i < kShardCount; ++i) {
+    QMutexLocker l(&sMutexes[i]);
+    size += sCaches[i]->cacheSize();
+  }
+
+  return size;
+
+}
+
 qint64 ThreadSafeNetworkDiskCache::cacheSize() const {
-  QMutexLocker l(&sMutex);
-  return sCache->cacheSize();
+
+  return TotalCacheSize();
+
 }
 
 QIODevice *ThreadSafeNetworkDiskCache::data(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->data(url);
+  const int shard = ShardForUrl(url);
+  QMutexLocker l(&sMutexes[shard]);
+  return sCaches[shard]->data(url);
 }
 
 void ThreadSafeNetworkDiskCache::insert(QIODevice *device) {
-  QMutexLocker l(&sMutex);
-  sCache->insert(device);
+
+  int shard = -1;
+  {
+    QMutexLocker l(&sPreparedDevicesMutex);
+    shard = sPreparedDevices.take(device);
+  }
+
+  QMutexLocker l(&sMutexes[shard]);
+  sCaches[shard]->insert(device);
+
 }
 
 QNetworkCacheMetaData ThreadSafeNetworkDiskCache::metaData(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->metaData(url);
+  const int shard = ShardForUrl(url);
+  QMutexLocker l(&sMutexes[shard]);
+  return sCaches[shard]->metaData(url);
 }
 
 QIODevice *ThreadSafeNetworkDiskCache::prepare(const QNetworkCacheMetaData &metaData) {
-  QMutexLocker l(&sMutex);
-  return sCache->prepare(metaData);
+
+  const int shard = ShardForUrl(metaData.url());
+
+  QIODevice *device = nullptr;
+  {
+    QMutexLocker l(&sMutexes[shard]);
+    device = sCaches[shard]->prepare(metaData);
+  }
+
+  if (device) {
+    QMutexLocker l(&sPreparedDevicesMutex);
+    sPreparedDevices.insert(device, shard);
+  }
+
+  return device;
+
 }
 
 bool ThreadSafeNetworkDiskCache::remove(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->remove(url);
+  const int shard = ShardForUrl(url);
+  QMutexLocker l(&sMutexes[shard]);
+  return sCaches[shard]->remove(url);
 }
 
 void ThreadSafeNetworkDiskCache::updateMetaData(const QNetworkCacheMetaData &metaData) {
-  QMutexLocker l(&sMutex);
-  sCache->updateMetaData(metaData);
+  const int shard = ShardForUrl(metaData.url());
+  QMutexLocker l(&sMutexes[shard]);
+  sCaches[shard]->updateMetaData(metaData);
 }
 
 void ThreadSafeNetworkDiskCache::clear() {
-  QMutexLocker l(&sMutex);
-  sCache->clear();
+
+  for (int i = 0; i < kShardCount; ++i) {
+    QMutexLocker l(&sMutexes[i]);
+    sCaches[i]->clear();
+  }
+
 }
@@ -27,6 +27,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QAbstractNetworkCache>
+#include <QHash>
 #include <QMutex>
 #include <QUrl>
 #include <QNetworkCacheMetaData>
@@ -34,6 +35,9 @@
 class QIODevice;
 class QNetworkDiskCache;
 
+// The disk cache is sharded by URL hash into independent QNetworkDiskCache instances,
+// each with its own directory, lock and eviction,
+// so concurrent cover/lyrics/API fetches on different URLs don't serialize on one mutex.
 class ThreadSafeNetworkDiskCache : public QAbstractNetworkCache {
   Q_OBJECT
 
@@ -41,6 +45,9 @@ class ThreadSafeNetworkDiskCache : public QAbstractNetworkCache {
   explicit ThreadSafeNetworkDiskCache(QObject *parent);
   ~ThreadSafeNetworkDiskCache() override;
 
+  // Total size across all shards; 0 when no cache has been created yet. Used by the memory accounting report.
+  static qint64 TotalCacheSize();
+
   qint64 cacheSize() const override;
   QIODevice *data(const QUrl &url) override;
   void insert(QIODevice *device) override;
@@ -53,9 +60,18 @@ class ThreadSafeNetworkDiskCache : public QAbstractNetworkCache {
   void clear() override;
 
  private:
-  static QMutex sMutex;
+  static int ShardForUrl(const QUrl &url);
+
+  static const int kShardCount = 8;
+
+  static QMutex sInstancesMutex;
   static int sInstances;
-  static QNetworkDiskCache *sCache;
+  static QMutex sMutexes[kShardCount];
+  static QNetworkDiskCache *sCaches[kShardCount];
+
+  // insert() must go to the shard whose prepare() created the device.
+  static QMutex sPreparedDevicesMutex;
+  static QHash<QIODevice*, int> sPreparedDevices;
 };
 
 #endif  // THREADSAFENETWORKDISKCACHE_H
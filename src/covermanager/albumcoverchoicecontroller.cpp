@@ -35,6 +35,7 @@
 #include <QMimeData>
 #include <QSet>
 #include <QList>
+#include <QPair>
 #include <QVariant>
 #include <QString>
 #include <QRegularExpression>
@@ -59,6 +60,7 @@
 #include "utilities/coverutils.h"
 #include "utilities/screenutils.h"
 #include "core/application.h"
+#include "core/shared_ptr.h"
 #include "core/song.h"
 #include "core/iconloader.h"
 #include "core/tagreaderclient.h"
@@ -717,17 +719,20 @@ void AlbumCoverChoiceController::SaveCoverEmbeddedToCollectionSongs(const Song &
 
 void AlbumCoverChoiceController::SaveCoverEmbeddedToCollectionSongs(const QString &effective_albumartist, const QString &effective_album, const QString &cover_filename, const QByteArray &image_data, const QString &mime_type) {
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  QFuture<SongList> future = QtConcurrent::run(&CollectionBackend::GetAlbumSongs, app_->collection_backend(), effective_albumartist, effective_album, CollectionFilterOptions());
-#else
-  QFuture<SongList> future = QtConcurrent::run(&*app_->collection_backend(), &CollectionBackend::GetAlbumSongs, effective_albumartist, effective_album, CollectionFilterOptions());
-#endif
-  QFutureWatcher<SongList> *watcher = new QFutureWatcher<SongList>();
-  QObject::connect(watcher, &QFutureWatcher<SongList>::finished, this, [this, watcher, cover_filename, image_data, mime_type]() {
-    const SongList collection_songs = watcher->result();
+  // Resolve the album songs and encode the cover on a worker thread.
+  // The cover is encoded once here, so applying it to a whole album doesn't make every tag writer re-encode the same image.
+  SharedPtr<CollectionBackend> collection_backend = app_->collection_backend();
+  QFuture<QPair<SongList, TagReaderClient::SaveCoverOptions>> future = QtConcurrent::run([collection_backend, effective_albumartist, effective_album, cover_filename, image_data, mime_type]() {
+    const TagReaderClient::SaveCoverOptions save_cover_options = TagReaderClient::EncodeCoverForEmbedding(TagReaderClient::SaveCoverOptions(cover_filename, image_data, mime_type));
+    const SongList collection_songs = collection_backend->GetAlbumSongs(effective_albumartist, effective_album, CollectionFilterOptions());
+    return qMakePair(collection_songs, save_cover_options);
+  });
+  QFutureWatcher<QPair<SongList, TagReaderClient::SaveCoverOptions>> *watcher = new QFutureWatcher<QPair<SongList, TagReaderClient::SaveCoverOptions>>();
+  QObject::connect(watcher, &QFutureWatcher<QPair<SongList, TagReaderClient::SaveCoverOptions>>::finished, this, [this, watcher]() {
+    const QPair<SongList, TagReaderClient::SaveCoverOptions> result = watcher->result();
     watcher->deleteLater();
-    for (const Song &collection_song : collection_songs) {
-      SaveCoverEmbeddedToSong(collection_song, cover_filename, image_data, mime_type);
+    for (const Song &collection_song : result.first) {
+      SaveCoverEmbeddedToSong(collection_song, result.second);
     }
   });
   watcher->setFuture(future);
@@ -736,10 +741,16 @@ void AlbumCoverChoiceController::SaveCoverEmbeddedToCollectionSongs(const QStrin
 
 void AlbumCoverChoiceController::SaveCoverEmbeddedToSong(const Song &song, const QString &cover_filename, const QByteArray &image_data, const QString &mime_type) {
 
+  SaveCoverEmbeddedToSong(song, TagReaderClient::SaveCoverOptions(cover_filename, image_data, mime_type));
+
+}
+
+void AlbumCoverChoiceController::SaveCoverEmbeddedToSong(const Song &song, const TagReaderClient::SaveCoverOptions &save_cover_options) {
+
   QMutexLocker l(&mutex_cover_save_tasks_);
   cover_save_tasks_.append(song);
-  const bool art_embedded = !image_data.isNull();
-  TagReaderReply *reply = app_->tag_reader_client()->SaveEmbeddedArt(song.url().toLocalFile(), TagReaderClient::SaveCoverOptions(cover_filename, image_data, mime_type));
+  const bool art_embedded = !save_cover_options.cover_data.isNull() || !save_cover_options.cover_filename.isEmpty();
+  TagReaderReply *reply = app_->tag_reader_client()->SaveEmbeddedArt(song.url().toLocalFile(), save_cover_options);
   QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, song, art_embedded]() { SaveEmbeddedCoverFinished(reply, song, art_embedded); });
 
 }
@@ -152,6 +152,7 @@ class AlbumCoverChoiceController : public QWidget {
   void SaveCoverEmbeddedToCollectionSongs(const Song &song, const QString &cover_filename, const QByteArray &image_data = QByteArray(), const QString &mime_type = QString());
   void SaveCoverEmbeddedToCollectionSongs(const QString &effective_albumartist, const QString &effective_album, const QString &cover_filename, const QByteArray &image_data = QByteArray(), const QString &mime_type = QString());
   void SaveCoverEmbeddedToSong(const Song &song, const QString &cover_filename, const QByteArray &image_data, const QString &mime_type = QString());
+  void SaveCoverEmbeddedToSong(const Song &song, const TagReaderClient::SaveCoverOptions &save_cover_options);
 
   static bool CanAcceptDrag(const QDragEnterEvent *e);
 
@@ -23,25 +23,24 @@
 #include <QObject>
 #include <QThreadPool>
 
+#include "core/jobscheduler.h"
 #include "core/song.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 #include "albumcoverexporter.h"
 #include "coverexportrunnable.h"
 
-const int AlbumCoverExporter::kMaxConcurrentRequests = 3;
-
-AlbumCoverExporter::AlbumCoverExporter(QObject *parent)
+AlbumCoverExporter::AlbumCoverExporter(SharedPtr<JobScheduler> job_scheduler, QObject *parent)
     : QObject(parent),
-      thread_pool_(new QThreadPool(this)),
+      job_scheduler_(job_scheduler),
+      active_jobs_(0),
       exported_(0),
       skipped_(0),
-      all_(0) {
-  thread_pool_->setMaxThreadCount(kMaxConcurrentRequests);
-}
+      all_(0) {}
 
 void AlbumCoverExporter::SetDialogResult(const AlbumCoverExport::DialogResult &dialog_result) {
   dialog_result_ = dialog_result;
+  seen_cover_dirs_.clear();
 }
 
 void AlbumCoverExporter::SetCoverTypes(const AlbumCoverLoaderOptions::Types &cover_types) {
@@ -50,12 +49,20 @@ void AlbumCoverExporter::SetCoverTypes(const AlbumCoverLoaderOptions::Types &cov
 
 void AlbumCoverExporter::AddExportRequest(const Song &song) {
 
+  // Covers are written as <directory>/<filename>, so albums sharing a directory would overwrite the same file. Export it only once.
+  const QString cover_dir = song.url().toLocalFile().section(QLatin1Char('/'), 0, -2);
+  if (seen_cover_dirs_.contains(cover_dir)) return;
+  seen_cover_dirs_.insert(cover_dir);
+
   requests_.append(new CoverExportRunnable(dialog_result_, cover_types_, song));
   all_ = static_cast<int>(requests_.count());
 
 }
 
-void AlbumCoverExporter::Cancel() { requests_.clear(); }
+void AlbumCoverExporter::Cancel() {
+  requests_.clear();
+  seen_cover_dirs_.clear();
+}
 
 void AlbumCoverExporter::StartExporting() {
 
@@ -67,19 +74,23 @@ void AlbumCoverExporter::StartExporting() {
 
 void AlbumCoverExporter::AddJobsToPool() {
 
-  while (!requests_.isEmpty() && thread_pool_->activeThreadCount() < thread_pool_->maxThreadCount()) {
+  // Each runnable decodes, scales and encodes independently, so the export scales with the core count.
+  // Keep no more runnables in flight than the shared pool has threads, so a cancel doesn't leave a long queue behind.
+  while (!requests_.isEmpty() && active_jobs_ < job_scheduler_->cpu_pool()->maxThreadCount()) {
     CoverExportRunnable *runnable = requests_.dequeue();
 
     QObject::connect(runnable, &CoverExportRunnable::CoverExported, this, &AlbumCoverExporter::CoverExported);
     QObject::connect(runnable, &CoverExportRunnable::CoverSkipped, this, &AlbumCoverExporter::CoverSkipped);
 
-    thread_pool_->start(runnable);
+    ++active_jobs_;
+    job_scheduler_->Submit(JobScheduler::Priority::Background, runnable);
   }
 
 }
 
 void AlbumCoverExporter::CoverExported() {
 
+  --active_jobs_;
   ++exported_;
   emit AlbumCoversExportUpdate(exported_, skipped_, all_);
   AddJobsToPool();
@@ -88,6 +99,7 @@ void AlbumCoverExporter::CoverExported() {
 
 void AlbumCoverExporter::CoverSkipped() {
 
+  --active_jobs_;
   ++skipped_;
   emit AlbumCoversExportUpdate(exported_, skipped_, all_);
   AddJobsToPool();
@@ -25,22 +25,22 @@
 
 #include <QObject>
 #include <QQueue>
+#include <QSet>
 #include <QString>
 
+#include "core/shared_ptr.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 
-class QThreadPool;
 class Song;
 class CoverExportRunnable;
+class JobScheduler;
 
 class AlbumCoverExporter : public QObject {
   Q_OBJECT
 
  public:
-  explicit AlbumCoverExporter(QObject *parent = nullptr);
-
-  static const int kMaxConcurrentRequests;
+  explicit AlbumCoverExporter(SharedPtr<JobScheduler> job_scheduler, QObject *parent = nullptr);
 
   void SetDialogResult(const AlbumCoverExport::DialogResult &dialog_result);
   void SetCoverTypes(const AlbumCoverLoaderOptions::Types &cover_types);
@@ -64,8 +64,12 @@ class AlbumCoverExporter : public QObject {
   AlbumCoverExport::DialogResult dialog_result_;
 
   QQueue<CoverExportRunnable*> requests_;
-  QThreadPool *thread_pool_;
+  // Directories a request was already added for in this run, albums sharing a directory export to the same file so the work is only done once.
+  QSet<QString> seen_cover_dirs_;
+  SharedPtr<JobScheduler> job_scheduler_;
 
+  // Runnables submitted to the shared pool that have not reported back yet.
+  int active_jobs_;
   int exported_;
   int skipped_;
   int all_;
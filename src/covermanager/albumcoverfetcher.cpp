@@ -25,6 +25,7 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QStandardPaths>
 #include <QTimer>
 #include <QString>
 
@@ -38,11 +39,19 @@ using namespace std::chrono_literals;
 
 const int AlbumCoverFetcher::kMaxConcurrentRequests = 5;
 
+namespace {
+// How long a query that returned no cover stays cached before the providers are asked again.
+constexpr qint64 kNegativeCacheTtlSecs = 30LL * 24 * 60 * 60;
+// How many manual search result sets are kept in memory before the cache is emptied.
+constexpr qsizetype kSearchResultsCacheMaxEntries = 100;
+}  // namespace
+
 AlbumCoverFetcher::AlbumCoverFetcher(SharedPtr<CoverProviders> cover_providers, SharedPtr<NetworkAccessManager> network, QObject *parent)
     : QObject(parent),
       cover_providers_(cover_providers),
       network_(network),
       next_id_(0),
+      negative_cache_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/covernegatives.txt"), kNegativeCacheTtlSecs),
       request_starter_(new QTimer(this)) {
 
   request_starter_->setInterval(1s);
@@ -91,8 +100,59 @@ quint64 AlbumCoverFetcher::SearchForCovers(const QString &artist, const QString
 
 }
 
+QString AlbumCoverFetcher::SearchKey(const CoverSearchRequest &req) {
+
+  return req.artist.toLower() + QLatin1Char('\x01') + req.album.toLower() + QLatin1Char('\x01') + req.title.toLower() + QLatin1Char('\x01') + (req.search ? QLatin1Char('s') : QLatin1Char('f')) + (req.batch ? QLatin1Char('b') : QLatin1Char('n'));
+
+}
+
+QString AlbumCoverFetcher::NegativeCacheKey(const CoverSearchRequest &req) {
+
+  return req.artist.simplified().toLower() + QLatin1Char('\x01') + req.album.simplified().toLower() + QLatin1Char('\x01') + req.title.simplified().toLower();
+
+}
+
+QList<quint64> AlbumCoverFetcher::TakeSubscribers(const quint64 request_id) {
+
+  const QString key = request_ids_.take(request_id);
+  if (!key.isEmpty()) request_keys_.remove(key);
+
+  const QList<quint64> subscriber_ids = request_subscribers_.values(request_id);
+  request_subscribers_.remove(request_id);
+
+  return subscriber_ids;
+
+}
+
 void AlbumCoverFetcher::AddRequest(const CoverSearchRequest &req) {
 
+  // Batch fetches for queries that recently returned nothing are answered right away without hitting the network.
+  // Manual searches always go through so the user can retry.
+  if (req.batch && negative_cache_.Contains(NegativeCacheKey(req))) {
+    QMetaObject::invokeMethod(this, [this, req]() {
+      CoverSearchStatistics statistics;
+      statistics.missing_images_++;
+      emit AlbumCoverFetched(req.id, AlbumCoverImageResult(), statistics);
+    }, Qt::QueuedConnection);
+    return;
+  }
+
+  // Manual searches for a query already answered this session are served from the cache, so the dialog populates without any network traffic.
+  if (req.search && search_results_cache_.contains(NegativeCacheKey(req))) {
+    const CoverProviderSearchResults results = search_results_cache_.value(NegativeCacheKey(req));
+    QMetaObject::invokeMethod(this, [this, req, results]() { emit SearchFinished(req.id, results, CoverSearchStatistics()); }, Qt::QueuedConnection);
+    return;
+  }
+
+  // Coalesce with an identical queued or in-flight query, the duplicate is answered when the original request finishes.
+  const QString key = SearchKey(req);
+  if (request_keys_.contains(key)) {
+    request_subscribers_.insert(request_keys_.value(key), req.id);
+    return;
+  }
+  request_keys_.insert(key, req.id);
+  request_ids_.insert(req.id, key);
+
   queued_requests_.enqueue(req);
 
   if (!request_starter_->isActive()) request_starter_->start();
@@ -111,6 +171,9 @@ void AlbumCoverFetcher::Clear() {
     search->deleteLater();
   }
   active_requests_.clear();
+  request_keys_.clear();
+  request_ids_.clear();
+  request_subscribers_.clear();
 
 }
 
@@ -143,7 +206,25 @@ void AlbumCoverFetcher::SingleSearchFinished(const quint64 request_id, const Cov
   AlbumCoverFetcherSearch *search = active_requests_.take(request_id);
 
   search->deleteLater();
-  emit SearchFinished(request_id, results, search->statistics());
+
+  if (results.isEmpty()) {
+    negative_cache_.Insert(NegativeCacheKey(search->request()));
+  }
+  else if (search->request().search) {
+    if (search_results_cache_.count() >= kSearchResultsCacheMaxEntries) search_results_cache_.clear();
+    search_results_cache_.insert(NegativeCacheKey(search->request()), results);
+  }
+
+  const CoverSearchStatistics statistics = search->statistics();
+  emit SearchFinished(request_id, results, statistics);
+
+  const QList<quint64> subscriber_ids = TakeSubscribers(request_id);
+  for (const quint64 subscriber_id : subscriber_ids) {
+    emit SearchFinished(subscriber_id, results, statistics);
+  }
+
+  // Backfill the freed slot right away instead of waiting for the next timer tick.
+  StartRequests();
 
 }
 
@@ -153,6 +234,19 @@ void AlbumCoverFetcher::SingleCoverFetched(const quint64 request_id, const Album
   AlbumCoverFetcherSearch *search = active_requests_.take(request_id);
 
   search->deleteLater();
-  emit AlbumCoverFetched(request_id, result, search->statistics());
+
+  if (!result.is_valid()) {
+    negative_cache_.Insert(NegativeCacheKey(search->request()));
+  }
+
+  const CoverSearchStatistics statistics = search->statistics();
+  emit AlbumCoverFetched(request_id, result, statistics);
+
+  const QList<quint64> subscriber_ids = TakeSubscribers(request_id);
+  for (const quint64 subscriber_id : subscriber_ids) {
+    emit AlbumCoverFetched(subscriber_id, result, statistics);
+  }
+
+  StartRequests();
 
 }
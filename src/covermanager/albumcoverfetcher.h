@@ -37,6 +37,7 @@
 #include <QImage>
 
 #include "core/shared_ptr.h"
+#include "core/searchnegativecache.h"
 
 #include "coversearchstatistics.h"
 #include "albumcoverimageresult.h"
@@ -130,6 +131,9 @@ class AlbumCoverFetcher : public QObject {
 
  private:
   void AddRequest(const CoverSearchRequest &req);
+  static QString SearchKey(const CoverSearchRequest &req);
+  static QString NegativeCacheKey(const CoverSearchRequest &req);
+  QList<quint64> TakeSubscribers(const quint64 request_id);
 
   SharedPtr<CoverProviders> cover_providers_;
   SharedPtr<NetworkAccessManager> network_;
@@ -138,6 +142,18 @@ class AlbumCoverFetcher : public QObject {
   QQueue<CoverSearchRequest> queued_requests_;
   QHash<quint64, AlbumCoverFetcherSearch*> active_requests_;
 
+  // Coalescing of identical queries: key of every queued or in-flight request mapped to its id,
+  // and the ids of duplicate requests that are answered when the original one finishes.
+  QHash<QString, quint64> request_keys_;
+  QHash<quint64, QString> request_ids_;
+  QMultiHash<quint64, quint64> request_subscribers_;
+
+  // Queries that recently returned no cover, so batch runs skip them without network dispatch.
+  SearchNegativeCache negative_cache_;
+
+  // Results of earlier manual searches this session, keyed by normalized query, so reopening the search dialog for the same album is answered instantly.
+  QHash<QString, CoverProviderSearchResults> search_results_cache_;
+
   QTimer *request_starter_;
 };
 
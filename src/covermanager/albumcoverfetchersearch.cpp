@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <utility>
 
 #include <QObject>
 #include <QCoreApplication>
@@ -88,6 +89,8 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
     return;
   }
 
+  search_start_time_.start();
+
   QList<CoverProvider*> cover_providers_sorted = cover_providers->List();
   std::stable_sort(cover_providers_sorted.begin(), cover_providers_sorted.end(), ProviderCompareOrder);
 
@@ -231,10 +234,24 @@ void AlbumCoverFetcherSearch::ProviderSearchFinished(const int id, const CoverPr
   if (!pending_requests_.contains(id)) return;
 
   CoverProvider *provider = pending_requests_.take(id);
+  statistics_.searches_by_provider_[provider->name()]++;
+  statistics_.search_times_by_provider_[provider->name()] += static_cast<quint64>(search_start_time_.elapsed());
+  provider->RecordSearchResult(search_start_time_.elapsed(), !results.isEmpty());
   ProviderSearchResults(provider, results);
 
   // Do we have more providers left?
   if (!pending_requests_.isEmpty()) {
+    // For fetch requests, don't keep waiting for slower providers when a result already scores well enough to end the search.
+    if (!request_.search && !results_.isEmpty()) {
+      float best_score = 0.0;
+      for (const CoverProviderSearchResult &result : std::as_const(results_)) {
+        best_score = std::max(best_score, result.score());
+      }
+      if (best_score >= kGoodScore) {
+        qLog(Debug) << "Result with score" << best_score << "is good enough, canceling the remaining providers";
+        TerminateSearch();
+      }
+    }
     return;
   }
 
@@ -423,7 +440,12 @@ void AlbumCoverFetcherSearch::Cancel() {
 }
 
 bool AlbumCoverFetcherSearch::ProviderCompareOrder(CoverProvider *a, CoverProvider *b) {
+
+  // Providers that have found covers this session go first, the faster one when equal, falling back to the configured order.
+  if (!qFuzzyCompare(a->search_hit_rate(), b->search_hit_rate())) return a->search_hit_rate() > b->search_hit_rate();
+  if (a->average_search_latency_ms() != b->average_search_latency_ms()) return a->average_search_latency_ms() < b->average_search_latency_ms();
   return a->order() < b->order();
+
 }
 
 bool AlbumCoverFetcherSearch::CoverProviderSearchResultCompareScore(const CoverProviderSearchResult &a, const CoverProviderSearchResult &b) {
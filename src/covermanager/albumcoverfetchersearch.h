@@ -26,6 +26,7 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QElapsedTimer>
 #include <QPair>
 #include <QMap>
 #include <QMultiMap>
@@ -58,6 +59,8 @@ class AlbumCoverFetcherSearch : public QObject {
 
   void Start(SharedPtr<CoverProviders> cover_providers);
 
+  const CoverSearchRequest &request() const { return request_; }
+
   // Cancels all pending requests.  No Finished signals will be emitted, and it is the caller's responsibility to delete the AlbumCoverFetcherSearch.
   void Cancel();
 
@@ -117,6 +120,9 @@ class AlbumCoverFetcherSearch : public QObject {
 
   SharedPtr<NetworkAccessManager> network_;
 
+  // Measures how long each provider takes from the start of the search, for the statistics.
+  QElapsedTimer search_start_time_;
+
   bool cancel_requested_;
 
 };
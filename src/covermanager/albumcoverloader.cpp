@@ -29,11 +29,21 @@
 #include <QByteArray>
 #include <QString>
 #include <QUrl>
+#include <QBuffer>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QImageReader>
+#include <QSize>
+#include <QStandardPaths>
+#include <QCryptographicHash>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 
+#include "core/memorystats.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
 #include "core/tagreaderclient.h"
@@ -46,15 +56,36 @@
 
 using std::make_shared;
 
+namespace {
+// Enough for a few hundred scaled covers at typical list and grid sizes.
+constexpr int kScaledImageCacheMaxCost = 32 * 1024 * 1024;
+// How many finished tasks between each statistics line in the debug log.
+constexpr quint64 kStatisticsLogInterval = 200;
+}  // namespace
+
 AlbumCoverLoader::AlbumCoverLoader(QObject *parent)
     : QObject(parent),
       network_(new NetworkAccessManager(this)),
       stop_requested_(false),
       load_image_async_id_(1),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      scaled_image_cache_(kScaledImageCacheMaxCost),
+      stat_finished_tasks_(0),
+      stat_scaled_cache_hits_memory_(0),
+      stat_scaled_cache_hits_disk_(0),
+      stat_scaled_cache_misses_(0),
+      stat_decodes_(0),
+      stat_decode_time_ms_(0) {
 
   original_thread_ = thread();
 
+  scaled_image_cache_dir_ = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/scaledcovers");
+  QDir dir;
+  if (!dir.mkpath(scaled_image_cache_dir_)) {
+    qLog(Error) << "Unable to create scaled covers cache directory" << scaled_image_cache_dir_;
+    scaled_image_cache_dir_.clear();
+  }
+
 }
 
 void AlbumCoverLoader::ExitAsync() {
@@ -75,11 +106,13 @@ void AlbumCoverLoader::Exit() {
 void AlbumCoverLoader::CancelTask(const quint64 id) {
 
   QMutexLocker l(&mutex_load_image_async_);
-  for (QQueue<TaskPtr>::iterator it = tasks_.begin(); it != tasks_.end(); ++it) {
-    TaskPtr task = *it;
-    if (task->id == id) {
-      tasks_.erase(it);
-      break;
+  for (QQueue<TaskPtr> *queue : { &tasks_, &low_priority_tasks_ }) {
+    for (QQueue<TaskPtr>::iterator it = queue->begin(); it != queue->end(); ++it) {
+      TaskPtr task = *it;
+      if (task->id == id) {
+        queue->erase(it);
+        return;
+      }
     }
   }
 
@@ -88,13 +121,15 @@ void AlbumCoverLoader::CancelTask(const quint64 id) {
 void AlbumCoverLoader::CancelTasks(const QSet<quint64> &ids) {
 
   QMutexLocker l(&mutex_load_image_async_);
-  for (QQueue<TaskPtr>::iterator it = tasks_.begin(); it != tasks_.end();) {
-    TaskPtr task = *it;
-    if (ids.contains(task->id)) {
-      it = tasks_.erase(it);
-    }
-    else {
-      ++it;
+  for (QQueue<TaskPtr> *queue : { &tasks_, &low_priority_tasks_ }) {
+    for (QQueue<TaskPtr>::iterator it = queue->begin(); it != queue->end();) {
+      TaskPtr task = *it;
+      if (ids.contains(task->id)) {
+        it = queue->erase(it);
+      }
+      else {
+        ++it;
+      }
     }
   }
 
@@ -156,7 +191,12 @@ quint64 AlbumCoverLoader::EnqueueTask(TaskPtr task) {
   {
     QMutexLocker l(&mutex_load_image_async_);
     task->id = load_image_async_id_++;
-    tasks_.enqueue(task);
+    if (task->options.low_priority) {
+      low_priority_tasks_.enqueue(task);
+    }
+    else {
+      tasks_.enqueue(task);
+    }
   }
 
   QMetaObject::invokeMethod(this, &AlbumCoverLoader::ProcessTasks, Qt::QueuedConnection);
@@ -170,8 +210,15 @@ void AlbumCoverLoader::ProcessTasks() {
   TaskPtr task;
   {
     QMutexLocker l(&mutex_load_image_async_);
-    if (tasks_.isEmpty()) return;
-    task = tasks_.dequeue();
+    if (!tasks_.isEmpty()) {
+      task = tasks_.dequeue();
+    }
+    else if (!low_priority_tasks_.isEmpty()) {
+      task = low_priority_tasks_.dequeue();
+    }
+    else {
+      return;
+    }
   }
 
   ProcessTask(task);
@@ -203,6 +250,8 @@ void AlbumCoverLoader::ProcessTask(TaskPtr task) {
   }
 
   if (!task->success && !task->options.default_cover.isEmpty()) {
+    // The key left over from the last failed attempt must not have the default cover stored under it.
+    task->scaled_cache_key.clear();
     LoadLocalFileImage(task, AlbumCoverLoaderResult::Type::None, task->options.default_cover);
   }
 
@@ -213,11 +262,18 @@ void AlbumCoverLoader::ProcessTask(TaskPtr task) {
 void AlbumCoverLoader::FinishTask(TaskPtr task, const AlbumCoverLoaderResult::Type result_type) {
 
   QImage image_scaled;
-  if (!task->album_cover.image_data.isEmpty() && !task->album_cover.image.isNull()) {
+  if (!task->scaled_image_from_cache.isNull()) {
+    task->result_type = result_type;
+    image_scaled = task->scaled_image_from_cache;
+  }
+  else if (!task->album_cover.image_data.isEmpty() && !task->album_cover.image.isNull()) {
     task->result_type = result_type;
     task->album_cover.mime_type = Utilities::MimeTypeFromData(task->album_cover.image_data);
     if (task->scaled_image()) {
       image_scaled = ImageUtils::ScaleImage(task->album_cover.image, task->options.desired_scaled_size, task->options.device_pixel_ratio, task->pad_scaled_image());
+      if (!image_scaled.isNull() && !task->scaled_cache_key.isEmpty()) {
+        SaveScaledImageToCache(task, image_scaled);
+      }
     }
     if (!task->raw_image_data() && !task->album_cover.image_data.isNull()) {
       task->album_cover.image_data = QByteArray();
@@ -227,10 +283,216 @@ void AlbumCoverLoader::FinishTask(TaskPtr task, const AlbumCoverLoaderResult::Ty
     }
   }
 
+  stat_finished_tasks_++;
+  if (stat_finished_tasks_ % kStatisticsLogInterval == 0) {
+    LogStatistics();
+  }
+
   emit AlbumCoverLoaded(task->id, AlbumCoverLoaderResult(task->success, task->result_type, task->album_cover, image_scaled, task->art_manual_updated, task->art_automatic_updated));
 
 }
 
+void AlbumCoverLoader::LogStatistics() {
+
+  qsizetype queued_tasks = 0;
+  qsizetype queued_low_priority_tasks = 0;
+  {
+    QMutexLocker l(&mutex_load_image_async_);
+    queued_tasks = tasks_.count();
+    queued_low_priority_tasks = low_priority_tasks_.count();
+  }
+
+  qLog(Debug) << "Cover loader:" << stat_finished_tasks_ << "tasks finished,"
+              << stat_scaled_cache_hits_memory_ << "memory cache hits,"
+              << stat_scaled_cache_hits_disk_ << "disk cache hits,"
+              << stat_scaled_cache_misses_ << "cache misses,"
+              << stat_decodes_ << "decodes in" << stat_decode_time_ms_ << "ms,"
+              << queued_tasks << "tasks and" << queued_low_priority_tasks << "prefetch tasks queued";
+
+}
+
+QString AlbumCoverLoader::ScaledCacheKey(TaskPtr task, const AlbumCoverLoaderOptions::Type type) const {
+
+  // Only requests that want just the scaled image can be served from the cache,
+  // callers that also want the original image or the raw data always need the full decode.
+  if (!task->scaled_image() || task->raw_image_data() || task->original_image()) {
+    return QString();
+  }
+  if (!task->options.desired_scaled_size.isValid() || scaled_image_cache_dir_.isEmpty()) {
+    return QString();
+  }
+
+  QString source;
+  QUrl source_url;
+  switch (type) {
+    case AlbumCoverLoaderOptions::Type::Embedded:
+      if (task->art_embedded && task->song_url.isValid() && task->song_url.isLocalFile()) {
+        source = QLatin1String("embedded:") + task->song_url.toString();
+        source_url = task->song_url;
+      }
+      break;
+    case AlbumCoverLoaderOptions::Type::Automatic:
+      if (task->art_automatic.isValid()) {
+        source = task->art_automatic.toString();
+        source_url = task->art_automatic;
+      }
+      break;
+    case AlbumCoverLoaderOptions::Type::Manual:
+      if (task->art_manual.isValid()) {
+        source = task->art_manual.toString();
+        source_url = task->art_manual;
+      }
+      break;
+    case AlbumCoverLoaderOptions::Type::Unset:
+      break;
+  }
+  if (source.isEmpty()) {
+    return QString();
+  }
+
+  // Include the modification time for local sources so replaced covers or retagged files are not served stale.
+  if (source_url.isLocalFile()) {
+    const QFileInfo fileinfo(source_url.toLocalFile());
+    if (!fileinfo.exists()) {
+      return QString();
+    }
+    source += QLatin1Char('-') + QString::number(fileinfo.lastModified().toMSecsSinceEpoch());
+  }
+
+  return source;
+
+}
+
+QString AlbumCoverLoader::ContentCacheKey(TaskPtr task, const QByteArray &content_hash) const {
+
+  return QStringLiteral("%1-%2x%3-%4%5").arg(QString::fromLatin1(content_hash.toHex())).arg(task->options.desired_scaled_size.width()).arg(task->options.desired_scaled_size.height()).arg(task->options.device_pixel_ratio).arg(task->pad_scaled_image() ? QLatin1String("-pad") : QLatin1String(""));
+
+}
+
+QString AlbumCoverLoader::ScaledCacheFilename(const QString &cache_key) const {
+
+  return scaled_image_cache_dir_ + QLatin1Char('/') + QString::fromLatin1(QCryptographicHash::hash(cache_key.toUtf8(), QCryptographicHash::Sha1).toHex()) + QLatin1String(".png");
+
+}
+
+QString AlbumCoverLoader::SourceMappingFilename(const QString &source_key) const {
+
+  return scaled_image_cache_dir_ + QLatin1Char('/') + QString::fromLatin1(QCryptographicHash::hash(source_key.toUtf8(), QCryptographicHash::Sha1).toHex()) + QLatin1String(".src");
+
+}
+
+QByteArray AlbumCoverLoader::ContentHashForSource(const QString &source_key) {
+
+  if (cover_content_hashes_.contains(source_key)) {
+    return cover_content_hashes_.value(source_key);
+  }
+
+  QFile mapping_file(SourceMappingFilename(source_key));
+  if (mapping_file.open(QIODevice::ReadOnly)) {
+    const QByteArray content_hash = QByteArray::fromHex(mapping_file.readAll());
+    mapping_file.close();
+    if (!content_hash.isEmpty()) {
+      cover_content_hashes_.insert(source_key, content_hash);
+      return content_hash;
+    }
+  }
+
+  return QByteArray();
+
+}
+
+QImage AlbumCoverLoader::LoadScaledImageFromCache(TaskPtr task, const QString &cache_key) {
+
+  if (QImage *image_scaled = scaled_image_cache_.object(cache_key)) {
+    stat_scaled_cache_hits_memory_++;
+    return *image_scaled;
+  }
+
+  const QString filename = ScaledCacheFilename(cache_key);
+  if (QFileInfo::exists(filename)) {
+    QImage image_scaled(filename);
+    if (!image_scaled.isNull()) {
+      stat_scaled_cache_hits_disk_++;
+      image_scaled.setDevicePixelRatio(task->options.device_pixel_ratio);
+      scaled_image_cache_.insert(cache_key, new QImage(image_scaled), static_cast<int>(image_scaled.sizeInBytes()));
+      MemoryStats::scaled_cover_cache_bytes.store(scaled_image_cache_.totalCost(), std::memory_order_relaxed);
+      return image_scaled;
+    }
+  }
+
+  return QImage();
+
+}
+
+void AlbumCoverLoader::SaveScaledImageToCache(TaskPtr task, const QImage &image_scaled) {
+
+  // The store is addressed by the hash of the raw image data, so identical covers in different folders share one thumbnail.
+  const QByteArray content_hash = QCryptographicHash::hash(task->album_cover.image_data, QCryptographicHash::Sha1);
+  cover_content_hashes_.insert(task->scaled_cache_key, content_hash);
+
+  const QString mapping_filename = SourceMappingFilename(task->scaled_cache_key);
+  if (!QFileInfo::exists(mapping_filename)) {
+    QFile mapping_file(mapping_filename);
+    if (mapping_file.open(QIODevice::WriteOnly)) {
+      mapping_file.write(content_hash.toHex());
+      mapping_file.close();
+    }
+    else {
+      qLog(Error) << "Unable to save cover mapping file" << mapping_filename << ":" << mapping_file.errorString();
+    }
+  }
+
+  const QString cache_key = ContentCacheKey(task, content_hash);
+  scaled_image_cache_.insert(cache_key, new QImage(image_scaled), static_cast<int>(image_scaled.sizeInBytes()));
+  MemoryStats::scaled_cover_cache_bytes.store(scaled_image_cache_.totalCost(), std::memory_order_relaxed);
+
+  const QString filename = ScaledCacheFilename(cache_key);
+  if (!QFileInfo::exists(filename)) {
+    if (!image_scaled.save(filename, "PNG")) {
+      qLog(Error) << "Unable to save scaled cover to" << filename;
+    }
+  }
+
+}
+
+bool AlbumCoverLoader::DecodeImage(TaskPtr task) {
+
+  QElapsedTimer timer;
+  timer.start();
+
+  bool success = false;
+
+  // Requests that only want the scaled image don't need oversized covers materialized in full:
+  // decode at reduced resolution instead, which for JPEG happens inside the decoder.
+  // Decode to twice the target size so the final smooth scale still has detail to work with.
+  if (task->scaled_image() && !task->original_image() && !task->raw_image_data() && task->options.desired_scaled_size.isValid()) {
+    QBuffer buffer(&task->album_cover.image_data);
+    if (buffer.open(QIODevice::ReadOnly)) {
+      QImageReader reader(&buffer);
+      const QSize image_size = reader.size();
+      const QSize scale_size(static_cast<int>(task->options.desired_scaled_size.width() * task->options.device_pixel_ratio) * 2, static_cast<int>(task->options.desired_scaled_size.height() * task->options.device_pixel_ratio) * 2);
+      if (image_size.isValid() && (image_size.width() > scale_size.width() || image_size.height() > scale_size.height())) {
+        reader.setScaledSize(image_size.scaled(scale_size, Qt::KeepAspectRatio));
+      }
+      const QImage image = reader.read();
+      if (!image.isNull()) {
+        task->album_cover.image = image;
+        success = true;
+      }
+    }
+  }
+
+  if (!success) {
+    success = task->album_cover.image.loadFromData(task->album_cover.image_data);
+  }
+
+  stat_decodes_++;
+  stat_decode_time_ms_ += static_cast<quint64>(timer.elapsed());
+
+  return success;
+
+}
+
 void AlbumCoverLoader::InitArt(TaskPtr task) {
 
   // For local files and streams initialize art if found.
@@ -253,6 +515,29 @@ void AlbumCoverLoader::InitArt(TaskPtr task) {
 
 AlbumCoverLoader::LoadImageResult AlbumCoverLoader::LoadImage(TaskPtr task, const AlbumCoverLoaderOptions::Type type) {
 
+  task->scaled_cache_key = ScaledCacheKey(task, type);
+  if (!task->scaled_cache_key.isEmpty()) {
+    const QByteArray content_hash = ContentHashForSource(task->scaled_cache_key);
+    if (!content_hash.isEmpty()) {
+      task->scaled_image_from_cache = LoadScaledImageFromCache(task, ContentCacheKey(task, content_hash));
+    }
+    if (!task->scaled_image_from_cache.isNull()) {
+      switch (type) {
+        case AlbumCoverLoaderOptions::Type::Embedded:
+          return LoadImageResult(AlbumCoverLoaderResult::Type::Embedded, LoadImageResult::Status::Success);
+        case AlbumCoverLoaderOptions::Type::Automatic:
+          return LoadImageResult(AlbumCoverLoaderResult::Type::Automatic, LoadImageResult::Status::Success);
+        case AlbumCoverLoaderOptions::Type::Manual:
+          return LoadImageResult(AlbumCoverLoaderResult::Type::Manual, LoadImageResult::Status::Success);
+        case AlbumCoverLoaderOptions::Type::Unset:
+          break;
+      }
+    }
+    else {
+      stat_scaled_cache_misses_++;
+    }
+  }
+
   switch (type) {
     case AlbumCoverLoaderOptions::Type::Unset:{
       if (task->art_unset) {
@@ -291,7 +576,7 @@ AlbumCoverLoader::LoadImageResult AlbumCoverLoader::LoadEmbeddedImage(TaskPtr ta
 
   if (task->art_embedded && task->song_url.isValid() && task->song_url.isLocalFile()) {
     const TagReaderClient::Result result = TagReaderClient::Instance()->LoadEmbeddedArtBlocking(task->song_url.toLocalFile(), task->album_cover.image_data);
-    if (result.success() && !task->album_cover.image_data.isEmpty() && task->album_cover.image.loadFromData(task->album_cover.image_data)) {
+    if (result.success() && !task->album_cover.image_data.isEmpty() && DecodeImage(task)) {
       return LoadImageResult(AlbumCoverLoaderResult::Type::Embedded, LoadImageResult::Status::Success);
     }
   }
@@ -354,7 +639,7 @@ AlbumCoverLoader::LoadImageResult AlbumCoverLoader::LoadLocalFileImage(TaskPtr t
     return LoadImageResult(result_type, LoadImageResult::Status::Failure);
   }
 
-  if (!task->album_cover.image.loadFromData(task->album_cover.image_data)) {
+  if (!DecodeImage(task)) {
     qLog(Error) << "Failed to load image from cover file" << cover_file << ":" << file.errorString();
     return LoadImageResult(result_type, LoadImageResult::Status::Failure);
   }
@@ -402,7 +687,7 @@ void AlbumCoverLoader::LoadRemoteImageFinished(QNetworkReply *reply, TaskPtr tas
 
   if (reply->error() == QNetworkReply::NoError) {
     task->album_cover.image_data = reply->readAll();
-    if (!task->album_cover.image_data.isEmpty() && task->album_cover.image.loadFromData(task->album_cover.image_data)) {
+    if (!task->album_cover.image_data.isEmpty() && DecodeImage(task)) {
       task->success = true;
       FinishTask(task, result_type);
       return;
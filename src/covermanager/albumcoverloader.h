@@ -27,6 +27,7 @@
 #include <QMutex>
 #include <QSet>
 #include <QHash>
+#include <QCache>
 #include <QQueue>
 #include <QByteArray>
 #include <QString>
@@ -90,6 +91,10 @@ class AlbumCoverLoader : public QObject {
     QUrl art_manual_updated;
     QUrl art_automatic_updated;
     int redirects;
+    // Identity of the cover source currently being attempted, empty when the request is not cacheable.
+    QString scaled_cache_key;
+    // Pre-scaled image found in the cache, used by FinishTask instead of decoding and scaling the original.
+    QImage scaled_image_from_cache;
   };
   using TaskPtr = SharedPtr<Task>;
 
@@ -116,6 +121,15 @@ class AlbumCoverLoader : public QObject {
   LoadImageResult LoadLocalFileImage(TaskPtr task, const AlbumCoverLoaderResult::Type result_type, const QString &cover_file);
   LoadImageResult LoadRemoteUrlImage(TaskPtr task, const AlbumCoverLoaderResult::Type result_type, const QUrl &cover_url);
   void FinishTask(TaskPtr task, const AlbumCoverLoaderResult::Type result_type);
+  QString ScaledCacheKey(TaskPtr task, const AlbumCoverLoaderOptions::Type type) const;
+  QString ContentCacheKey(TaskPtr task, const QByteArray &content_hash) const;
+  QString ScaledCacheFilename(const QString &cache_key) const;
+  QString SourceMappingFilename(const QString &source_key) const;
+  QByteArray ContentHashForSource(const QString &source_key);
+  QImage LoadScaledImageFromCache(TaskPtr task, const QString &cache_key);
+  void SaveScaledImageToCache(TaskPtr task, const QImage &image_scaled);
+  bool DecodeImage(TaskPtr task);
+  void LogStatistics();
 
  private slots:
   void Exit();
@@ -128,8 +142,24 @@ class AlbumCoverLoader : public QObject {
   bool stop_requested_;
   QMutex mutex_load_image_async_;
   QQueue<TaskPtr> tasks_;
+  // Prefetch requests, only processed when the normal queue is empty.
+  QQueue<TaskPtr> low_priority_tasks_;
   quint64 load_image_async_id_;
   QThread *original_thread_;
+  // Two-tier cache of scaled covers: in-memory LRU backed by pre-scaled thumbnails on disk,
+  // so repeated requests for the same cover at the same size skip the full decode and rescale.
+  // The store is content addressed, identical covers in different folders share one entry.
+  QCache<QString, QImage> scaled_image_cache_;
+  QString scaled_image_cache_dir_;
+  // Maps cover source identity to the content hash of its raw image data, mirrored in small mapping files in the cache directory.
+  QHash<QString, QByteArray> cover_content_hashes_;
+  // Cheap counters for tuning the cache sizes, dumped to the debug log by LogStatistics().
+  quint64 stat_finished_tasks_;
+  quint64 stat_scaled_cache_hits_memory_;
+  quint64 stat_scaled_cache_hits_disk_;
+  quint64 stat_scaled_cache_misses_;
+  quint64 stat_decodes_;
+  quint64 stat_decode_time_ms_;
 };
 
 #endif  // ALBUMCOVERLOADER_H
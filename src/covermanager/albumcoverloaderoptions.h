@@ -50,6 +50,8 @@ class AlbumCoverLoaderOptions {
   qreal device_pixel_ratio;
   Types types;
   QString default_cover;
+  // Low priority requests are only processed when no normal requests are queued, used for prefetching.
+  bool low_priority;
 
   static Types LoadTypes();
 };
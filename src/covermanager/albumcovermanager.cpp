@@ -111,7 +111,7 @@ AlbumCoverManager::AlbumCoverManager(Application *app, SharedPtr<CollectionBacke
       cover_fetcher_(new AlbumCoverFetcher(app_->cover_providers(), app_->network(), this)),
       cover_searcher_(nullptr),
       cover_export_(nullptr),
-      cover_exporter_(new AlbumCoverExporter(this)),
+      cover_exporter_(new AlbumCoverExporter(app->job_scheduler(), this)),
       artist_icon_(IconLoader::Load(QStringLiteral("folder-sound"))),
       all_artists_icon_(IconLoader::Load(QStringLiteral("library-music"))),
       image_nocover_thumbnail_(ImageUtils::GenerateNoCoverImage(QSize(120, 120), devicePixelRatio())),
@@ -26,6 +26,28 @@
 
 #include "core/shared_ptr.h"
 #include "core/application.h"
+#include "core/networkaccessmanager.h"
 #include "coverprovider.h"
 
-CoverProvider::CoverProvider(const QString &name, const bool enabled, const bool authentication_required, const float quality, const bool batch, const bool allow_missing_album, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent) : QObject(parent), app_(app), network_(network), name_(name), enabled_(enabled), order_(0), authentication_required_(authentication_required), quality_(quality), batch_(batch), allow_missing_album_(allow_missing_album) {}
+CoverProvider::CoverProvider(const QString &name, const bool enabled, const bool authentication_required, const float quality, const bool batch, const bool allow_missing_album, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent) : QObject(parent), app_(app), network_(network), name_(name), enabled_(enabled), order_(0), authentication_required_(authentication_required), quality_(quality), batch_(batch), allow_missing_album_(allow_missing_album), searches_attempted_(0), searches_hit_(0), average_search_latency_ms_(0) {}
+
+void CoverProvider::WarmUpConnection() {
+
+  if (enabled_ && network_) network_->AddWarmUpUrl(ApiUrl());
+
+}
+
+void CoverProvider::RecordSearchResult(const qint64 elapsed_ms, const bool hit) {
+
+  ++searches_attempted_;
+  if (hit) ++searches_hit_;
+
+  // Weighted moving average so the latency adapts to current network conditions without jumping on a single slow search.
+  if (searches_attempted_ == 1) {
+    average_search_latency_ms_ = elapsed_ms;
+  }
+  else {
+    average_search_latency_ms_ = (average_search_latency_ms_ * 3 + elapsed_ms) / 4;
+  }
+
+}
@@ -29,6 +29,7 @@
 #include <QVariant>
 #include <QString>
 #include <QStringList>
+#include <QUrl>
 
 #include "core/shared_ptr.h"
 #include "albumcoverfetcher.h"
@@ -55,6 +56,20 @@ class CoverProvider : public QObject {
   void set_enabled(const bool enabled) { enabled_ = enabled; }
   void set_order(const int order) { order_ = order; }
 
+  // Called by AlbumCoverFetcherSearch with the outcome of every search, used to order providers by how well they have done this session.
+  void RecordSearchResult(const qint64 elapsed_ms, const bool hit);
+
+  int searches_attempted() const { return searches_attempted_; }
+  // Providers that have not been tried yet report a full hit rate, so they are not sorted behind proven ones before they had a chance.
+  float search_hit_rate() const { return searches_attempted_ > 0 ? static_cast<float>(searches_hit_) / static_cast<float>(searches_attempted_) : 1.0F; }
+  qint64 average_search_latency_ms() const { return average_search_latency_ms_; }
+
+  // The fixed API endpoint of the service, if it has one.
+  // Used to open the connection for enabled providers in the background at startup, so the first search of a session doesn't pay for DNS and the TLS handshake.
+  virtual QUrl ApiUrl() const { return QUrl(); }
+  // Queues the API endpoint for connection warmup if the provider is enabled.
+  void WarmUpConnection();
+
   bool AuthenticationRequired() const { return authentication_required_; }
   virtual bool IsAuthenticated() const { return true; }
   virtual void Authenticate() {}
@@ -88,6 +103,11 @@ class CoverProvider : public QObject {
   float quality_;
   bool batch_;
   bool allow_missing_album_;
+
+ private:
+  int searches_attempted_;
+  int searches_hit_;
+  qint64 average_search_latency_ms_;
 };
 
 #endif  // COVERPROVIDER_H
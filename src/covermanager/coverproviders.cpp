@@ -71,6 +71,7 @@ void CoverProviders::ReloadSettings() {
     if (provider) {
       provider->set_enabled(true);
       provider->set_order(++i);
+      provider->WarmUpConnection();
       new_providers << provider;  // clazy:exclude=reserve-candidates
     }
   }
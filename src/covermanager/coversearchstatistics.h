@@ -38,6 +38,10 @@ struct CoverSearchStatistics {
   quint64 bytes_transferred_;
   QMap<QString, quint64> total_images_by_provider_;
   QMap<QString, quint64> chosen_images_by_provider_;
+  // Number of searches each provider completed, and the total time in milliseconds
+  // from the start of each search until the provider finished.
+  QMap<QString, quint64> searches_by_provider_;
+  QMap<QString, quint64> search_times_by_provider_;
 
   quint64 chosen_images_;
   quint64 missing_images_;
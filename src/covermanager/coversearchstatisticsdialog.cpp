@@ -74,6 +74,14 @@ void CoverSearchStatisticsDialog::Show(const CoverSearchStatistics &statistics)
     AddLine(tr("Covers from %1").arg(provider), QString::number(statistics.chosen_images_by_provider_[provider]));
   }
 
+  QStringList searched_providers(statistics.searches_by_provider_.keys());
+  std::sort(searched_providers.begin(), searched_providers.end());
+  for (const QString &provider : std::as_const(searched_providers)) {
+    const quint64 searches = statistics.searches_by_provider_[provider];
+    if (searches == 0) continue;
+    AddLine(tr("Average search time from %1").arg(provider), tr("%1 ms").arg(statistics.search_times_by_provider_[provider] / searches));
+  }
+
   if (!providers.isEmpty()) {
     AddSpacer();
   }
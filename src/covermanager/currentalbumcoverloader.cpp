@@ -42,12 +42,18 @@ CurrentAlbumCoverLoader::CurrentAlbumCoverLoader(Application *app, QObject *pare
     : QObject(parent),
       app_(app),
       temp_file_pattern_(QDir::tempPath() + QStringLiteral("/strawberry-cover-XXXXXX.jpg")),
-      id_(0) {
+      id_(0),
+      quick_id_(0) {
 
   options_.options = AlbumCoverLoaderOptions::Option::RawImageData | AlbumCoverLoaderOptions::Option::OriginalImage | AlbumCoverLoaderOptions::Option::ScaledImage;
   options_.desired_scaled_size = QSize(120, 120);
   options_.default_cover = QStringLiteral(":/pictures/cdcase.png");
 
+  // The quick pass only wants the scaled image, which is served from the scaled cover cache or a reduced-resolution decode.
+  quick_options_.options = AlbumCoverLoaderOptions::Option::ScaledImage;
+  quick_options_.desired_scaled_size = options_.desired_scaled_size;
+  quick_options_.default_cover = options_.default_cover;
+
   QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &CurrentAlbumCoverLoader::LoadAlbumCover);
   QObject::connect(&*app_->album_cover_loader(), &AlbumCoverLoader::AlbumCoverLoaded, this, &CurrentAlbumCoverLoader::AlbumCoverReady);
 
@@ -71,20 +77,34 @@ void CurrentAlbumCoverLoader::ReloadSettingsAsync() {
 void CurrentAlbumCoverLoader::ReloadSettings() {
 
   options_.types = AlbumCoverLoaderOptions::LoadTypes();
+  quick_options_.types = options_.types;
 
 }
 
 void CurrentAlbumCoverLoader::LoadAlbumCover(const Song &song) {
 
   last_song_ = song;
+  quick_id_ = app_->album_cover_loader()->LoadImageAsync(quick_options_, last_song_);
   id_ = app_->album_cover_loader()->LoadImageAsync(options_, last_song_);
 
 }
 
 void CurrentAlbumCoverLoader::AlbumCoverReady(const quint64 id, AlbumCoverLoaderResult result) {
 
+  if (id == quick_id_) {
+    quick_id_ = 0;
+    // Show the fast low-resolution pass right away, the full result below swaps it out when ready.
+    if (id_ != 0 && result.success && !result.image_scaled.isNull()) {
+      result.album_cover.image = result.image_scaled;
+      emit AlbumCoverLoaded(last_song_, result);
+    }
+    return;
+  }
+
   if (id != id_) return;
   id_ = 0;
+  // A quick pass still in flight is obsolete now.
+  quick_id_ = 0;
 
   if (!result.album_cover.image.isNull()) {
     temp_cover_ = make_unique<QTemporaryFile>(temp_file_pattern_);
@@ -69,6 +69,9 @@ class CurrentAlbumCoverLoader : public QObject {
   ScopedPtr<QTemporaryFile> temp_cover_;
   ScopedPtr<QTemporaryFile> temp_cover_thumbnail_;
   quint64 id_;
+  // Fast scaled-only pass displayed while the full cover is still decoding.
+  AlbumCoverLoaderOptions quick_options_;
+  quint64 quick_id_;
 
   Song last_song_;
 };
@@ -66,6 +66,8 @@ DeezerCoverProvider::~DeezerCoverProvider() {
 
 }
 
+QUrl DeezerCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kApiUrl)); }
+
 bool DeezerCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   if (artist.isEmpty() && album.isEmpty() && title.isEmpty()) return false;
@@ -43,6 +43,7 @@ class DeezerCoverProvider : public JsonCoverProvider {
   explicit DeezerCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~DeezerCoverProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const QString &artist, const QString &album, const QString &title, const int id) override;
   void CancelSearch(const int id) override;
 
@@ -83,6 +83,8 @@ DiscogsCoverProvider::~DiscogsCoverProvider() {
 
 }
 
+QUrl DiscogsCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrlSearch)); }
+
 bool DiscogsCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   Q_UNUSED(title);
@@ -51,6 +51,7 @@ class DiscogsCoverProvider : public JsonCoverProvider {
   explicit DiscogsCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~DiscogsCoverProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const QString &artist, const QString &album, const QString &title, const int id) override;
   void CancelSearch(const int id) override;
 
@@ -66,6 +66,8 @@ LastFmCoverProvider::~LastFmCoverProvider() {
 
 }
 
+QUrl LastFmCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrl)); }
+
 bool LastFmCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   if (artist.isEmpty() && album.isEmpty() && title.isEmpty()) return false;
@@ -43,6 +43,7 @@ class LastFmCoverProvider : public JsonCoverProvider {
   explicit LastFmCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~LastFmCoverProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const QString &artist, const QString &album, const QString &title, const int id) override;
 
  private slots:
@@ -39,6 +39,7 @@
 #include "core/shared_ptr.h"
 #include "core/application.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "core/logging.h"
 #include "albumcoverfetcher.h"
 #include "jsoncoverprovider.h"
@@ -48,7 +49,11 @@ namespace {
 constexpr char kReleaseSearchUrl[] = "https://musicbrainz.org/ws/2/release/";
 constexpr char kAlbumCoverUrl[] = "https://coverartarchive.org/release/%1/front";
 constexpr int kLimit = 8;
-constexpr int kRequestsDelay = 1000;
+// How often the request queue polls the rate limiter, the request rate itself is enforced by RateLimiter.
+constexpr int kRequestsDelay = 200;
+// MusicBrainz allows an average of one request per second, the bucket lets short bursts use idle quota.
+constexpr double kRequestsBurst = 5.0;
+constexpr double kRequestsPerSecond = 1.0;
 }  // namespace
 
 MusicbrainzCoverProvider::MusicbrainzCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -59,6 +64,8 @@ MusicbrainzCoverProvider::MusicbrainzCoverProvider(Application *app, SharedPtr<N
   timer_flush_requests_->setSingleShot(false);
   QObject::connect(timer_flush_requests_, &QTimer::timeout, this, &MusicbrainzCoverProvider::FlushRequests);
 
+  RateLimiter::SetLimits(QUrl(QString::fromLatin1(kReleaseSearchUrl)).host(), kRequestsBurst, kRequestsPerSecond);
+
 }
 
 MusicbrainzCoverProvider::~MusicbrainzCoverProvider() {
@@ -72,6 +79,8 @@ MusicbrainzCoverProvider::~MusicbrainzCoverProvider() {
 
 }
 
+QUrl MusicbrainzCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kReleaseSearchUrl)); }
+
 bool MusicbrainzCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   Q_UNUSED(title);
@@ -110,12 +119,13 @@ void MusicbrainzCoverProvider::SendSearchRequest(const SearchRequest &request) {
 
 void MusicbrainzCoverProvider::FlushRequests() {
 
-  if (!queue_search_requests_.isEmpty()) {
+  while (!queue_search_requests_.isEmpty() && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(kReleaseSearchUrl)))) {
     SendSearchRequest(queue_search_requests_.dequeue());
-    return;
   }
 
-  timer_flush_requests_->stop();
+  if (queue_search_requests_.isEmpty()) {
+    timer_flush_requests_->stop();
+  }
 
 }
 
@@ -234,6 +244,10 @@ QByteArray MusicbrainzCoverProvider::GetReplyData(QNetworkReply *reply) {
     data = reply->readAll();
   }
   else {
+    // Feed 429 replies back into the rate limiter so the bucket for this host shrinks.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429) {
+      RateLimiter::RateLimited(reply->url());
+    }
     if (reply->error() != QNetworkReply::NoError && reply->error() < 200) {
       // This is a network error, there is nothing more to do.
       QString failure_reason = QStringLiteral("%1 (%2)").arg(reply->errorString()).arg(reply->error());
@@ -45,6 +45,7 @@ class MusicbrainzCoverProvider : public JsonCoverProvider {
   explicit MusicbrainzCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~MusicbrainzCoverProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const QString &artist, const QString &album, const QString &title, const int id) override;
 
  private slots:
@@ -38,6 +38,7 @@
 #include "core/shared_ptr.h"
 #include "core/application.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "core/logging.h"
 #include "core/settings.h"
 #include "utilities/timeconstants.h"
@@ -52,7 +53,11 @@ constexpr char kApiUrl[] = "https://openapi.tidal.com";
 constexpr char kApiClientIdB64[] = "RHBwV3FpTEM4ZFJSV1RJaQ==";
 constexpr char kApiClientSecretB64[] = "cGk0QmxpclZXQWlteWpBc0RnWmZ5RmVlRzA2b3E1blVBVTljUW1IdFhDST0=";
 constexpr int kLimit = 10;
-constexpr const int kRequestsDelay = 1000;
+// How often the request queue polls the rate limiter, the request rate itself is enforced by RateLimiter.
+constexpr const int kRequestsDelay = 200;
+// OpenTidal allows an average of one request per second, the bucket lets short bursts use idle quota.
+constexpr double kRequestsBurst = 5.0;
+constexpr double kRequestsPerSecond = 1.0;
 }  // namespace
 
 using std::make_shared;
@@ -73,6 +78,8 @@ OpenTidalCoverProvider::OpenTidalCoverProvider(Application *app, SharedPtr<Netwo
   timer_flush_requests_->setSingleShot(false);
   QObject::connect(timer_flush_requests_, &QTimer::timeout, this, &OpenTidalCoverProvider::FlushRequests);
 
+  RateLimiter::SetLimits(QUrl(QLatin1String(kApiUrl)).host(), kRequestsBurst, kRequestsPerSecond);
+
   LoadSession();
 
 }
@@ -88,6 +95,8 @@ OpenTidalCoverProvider::~OpenTidalCoverProvider() {
 
 }
 
+QUrl OpenTidalCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kApiUrl)); }
+
 bool OpenTidalCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   if (artist.isEmpty() || album.isEmpty()) return false;
@@ -144,12 +153,13 @@ void OpenTidalCoverProvider::FlushRequests() {
     return;
   }
 
-  if (!search_requests_queue_.isEmpty()) {
+  while (!search_requests_queue_.isEmpty() && RateLimiter::TryAcquire(QUrl(QLatin1String(kApiUrl)))) {
     SendSearchRequest(search_requests_queue_.dequeue());
-    return;
   }
 
-  timer_flush_requests_->stop();
+  if (search_requests_queue_.isEmpty()) {
+    timer_flush_requests_->stop();
+  }
 
 }
 
@@ -270,6 +280,10 @@ QJsonObject OpenTidalCoverProvider::GetJsonObject(QNetworkReply *reply) {
 
   const int http_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
   if (reply->error() != QNetworkReply::NoError || (http_code != 200 && http_code != 207)) {
+    // Feed 429 replies back into the rate limiter so the bucket for this host shrinks.
+    if (http_code == 429) {
+      RateLimiter::RateLimited(reply->url());
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qLog(Error) << "OpenTidal:" << reply->errorString();
       if (reply->error() < 200) {
@@ -47,6 +47,7 @@ class OpenTidalCoverProvider : public JsonCoverProvider {
   explicit OpenTidalCoverProvider(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~OpenTidalCoverProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const QString &artist, const QString &album, const QString &title, const int id) override;
   void CancelSearch(const int id) override;
 
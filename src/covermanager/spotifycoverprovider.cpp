@@ -72,6 +72,8 @@ SpotifyCoverProvider::~SpotifyCoverProvider() {
 
 }
 
+QUrl SpotifyCoverProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kApiUrl)); }
+
 bool SpotifyCoverProvider::StartSearch(const QString &artist, const QString &album, const QString &title, const int id) {
 
   if (!IsAuthenticated()) return false;
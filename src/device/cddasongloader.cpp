@@ -32,6 +32,12 @@
 #include <QObject>
 #include <QMutex>
 #include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QStandardPaths>
 #include <QString>
 #include <QUrl>
 
@@ -47,6 +53,11 @@
 
 using std::make_shared;
 
+namespace {
+constexpr quint32 kMetadataCacheMagic = 0x53434441;  // "SCDA"
+constexpr quint8 kMetadataCacheVersion = 1;
+}  // namespace
+
 CddaSongLoader::CddaSongLoader(const QUrl &url, QObject *parent)
     : QObject(parent),
       url_(url),
@@ -155,61 +166,65 @@ void CddaSongLoader::LoadSongs() {
   gst_element_set_state(pipeline, GST_STATE_READY);
   gst_element_set_state(pipeline, GST_STATE_PAUSED);
 
-  // Get TOC and TAG messages
+  // Get TOC and TAG messages.
+  // They are handled as they arrive instead of after the bus runs dry, so the disc-id lookup (cache or MusicBrainz) overlaps with waiting for the remaining message.
   GstMessage *msg = nullptr;
-  GstMessage *msg_toc = nullptr;
-  GstMessage *msg_tag = nullptr;
-  while ((msg = gst_bus_timed_pop_filtered(GST_ELEMENT_BUS(pipeline), GST_SECOND, static_cast<GstMessageType>(GST_MESSAGE_TOC | GST_MESSAGE_TAG)))) {
-    if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TOC) {
-      if (msg_toc) gst_message_unref(msg_toc);  // Shouldn't happen, but just in case
-      msg_toc = msg;
-    }
-    else if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TAG) {
-      if (msg_tag) gst_message_unref(msg_tag);
-      msg_tag = msg;
-    }
-  }
-
-  // Handle TOC message: get tracks duration
-  if (msg_toc) {
-    GstToc *toc = nullptr;
-    gst_message_parse_toc(msg_toc, &toc, nullptr);
-    if (toc) {
-      GList *entries = gst_toc_get_entries(toc);
-      if (entries && static_cast<guint>(songs.size()) <= g_list_length(entries)) {
-        int i = 0;
-        for (GList *node = entries; node != nullptr; node = node->next) {
-          GstTocEntry *entry = static_cast<GstTocEntry*>(node->data);
-          qint64 duration = 0;
-          gint64 start = 0, stop = 0;
-          if (gst_toc_entry_get_start_stop_times(entry, &start, &stop)) duration = stop - start;
-          songs[i++].set_length_nanosec(duration);
+  bool toc_handled = false;
+  bool tag_handled = false;
+  while ((!toc_handled || !tag_handled) && (msg = gst_bus_timed_pop_filtered(GST_ELEMENT_BUS(pipeline), GST_SECOND, static_cast<GstMessageType>(GST_MESSAGE_TOC | GST_MESSAGE_TAG)))) {
+
+    if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TOC && !toc_handled) {
+      // Handle TOC message: get tracks duration
+      GstToc *toc = nullptr;
+      gst_message_parse_toc(msg, &toc, nullptr);
+      if (toc) {
+        GList *entries = gst_toc_get_entries(toc);
+        if (entries && static_cast<guint>(songs.size()) <= g_list_length(entries)) {
+          int i = 0;
+          for (GList *node = entries; node != nullptr; node = node->next) {
+            GstTocEntry *entry = static_cast<GstTocEntry*>(node->data);
+            qint64 duration = 0;
+            gint64 start = 0, stop = 0;
+            if (gst_toc_entry_get_start_stop_times(entry, &start, &stop)) duration = stop - start;
+            songs[i++].set_length_nanosec(duration);
+          }
         }
       }
+      toc_handled = true;
+      emit SongsDurationLoaded(songs);
     }
-    gst_message_unref(msg_toc);
-  }
-  emit SongsDurationLoaded(songs);
 
+    else if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TAG && !tag_handled) {
+      // Handle TAG message: generate MusicBrainz DiscId
+      GstTagList *tags = nullptr;
+      gst_message_parse_tag(msg, &tags);
+      char *string_mb = nullptr;
+      if (gst_tag_list_get_string(tags, GST_TAG_CDDA_MUSICBRAINZ_DISCID, &string_mb)) {
+        const QString musicbrainz_discid = QString::fromUtf8(string_mb);
+        qLog(Info) << "MusicBrainz discid: " << musicbrainz_discid;
+        tag_handled = true;
+
+        if (LoadMetadataFromCache(musicbrainz_discid)) {
+          qLog(Info) << "Using cached metadata for disc" << musicbrainz_discid;
+        }
 #ifdef HAVE_MUSICBRAINZ
-  // Handle TAG message: generate MusicBrainz DiscId
-  if (msg_tag) {
-    GstTagList *tags = nullptr;
-    gst_message_parse_tag(msg_tag, &tags);
-    char *string_mb = nullptr;
-    if (gst_tag_list_get_string(tags, GST_TAG_CDDA_MUSICBRAINZ_DISCID, &string_mb)) {
-      QString musicbrainz_discid = QString::fromUtf8(string_mb);
-      qLog(Info) << "MusicBrainz discid: " << musicbrainz_discid;
-
-      MusicBrainzClient *musicbrainz_client = new MusicBrainzClient(network_);
-      QObject::connect(musicbrainz_client, &MusicBrainzClient::DiscIdFinished, this, &CddaSongLoader::AudioCDTagsLoaded);
-      musicbrainz_client->StartDiscIdRequest(musicbrainz_discid);
-      g_free(string_mb);
-      gst_message_unref(msg_tag);
-      gst_tag_list_unref(tags);
+        else {
+          musicbrainz_discid_ = musicbrainz_discid;
+          MusicBrainzClient *musicbrainz_client = new MusicBrainzClient(network_);
+          QObject::connect(musicbrainz_client, &MusicBrainzClient::DiscIdFinished, this, &CddaSongLoader::AudioCDTagsLoaded);
+          musicbrainz_client->StartDiscIdRequest(musicbrainz_discid);
+        }
+#endif
+        g_free(string_mb);
+      }
+      if (tags) gst_tag_list_unref(tags);
     }
+
+    gst_message_unref(msg);
+
   }
-#endif
+
+  if (!toc_handled) emit SongsDurationLoaded(songs);
 
   gst_element_set_state(pipeline, GST_STATE_NULL);
   // This will also cause cdda_ to be unref'd.
@@ -241,11 +256,83 @@ void CddaSongLoader::AudioCDTagsLoaded(const QString &artist, const QString &alb
     song.set_url(GetUrlFromTrack(track_number++));
     songs << song;
   }
+
+  if (!musicbrainz_discid_.isEmpty()) {
+    SaveMetadataToCache(musicbrainz_discid_, songs);
+    musicbrainz_discid_.clear();
+  }
+
   emit SongsMetadataLoaded(songs);
 
 }
 #endif
 
+QString CddaSongLoader::MetadataCacheFilename(const QString &discid) {
+
+  // Disc-ids are base64-ish and can contain characters that don't belong in filenames.
+  QString safe_discid = discid;
+  safe_discid.replace(QLatin1Char('/'), QLatin1Char('_'));
+
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QStringLiteral("/cddametadata/") + safe_discid + QStringLiteral(".cache");
+
+}
+
+bool CddaSongLoader::LoadMetadataFromCache(const QString &discid) {
+
+  QFile file(MetadataCacheFilename(discid));
+  if (!file.exists() || !file.open(QIODevice::ReadOnly)) return false;
+
+  QDataStream s(&file);
+  s.setVersion(QDataStream::Qt_5_12);
+
+  quint32 magic = 0;
+  quint8 version = 0;
+  qint32 count = 0;
+  s >> magic >> version >> count;
+  if (magic != kMetadataCacheMagic || version != kMetadataCacheVersion || count <= 0) return false;
+
+  SongList songs;
+  songs.reserve(count);
+  for (qint32 i = 0; i < count; ++i) {
+    Song song;
+    s >> song;
+    if (s.status() != QDataStream::Ok) return false;
+    // The URL is device dependent, regenerate it for the drive the disc is in now.
+    song.set_url(GetUrlFromTrack(song.track()));
+    songs << song;
+  }
+
+  emit SongsMetadataLoaded(songs);
+
+  return true;
+
+}
+
+void CddaSongLoader::SaveMetadataToCache(const QString &discid, const SongList &songs) const {
+
+  const QString filename = MetadataCacheFilename(discid);
+  QDir dir = QFileInfo(filename).dir();
+  if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
+    qLog(Error) << "Could not create CDDA metadata cache directory" << dir.path();
+    return;
+  }
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Could not write CDDA metadata cache" << filename << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << kMetadataCacheMagic << kMetadataCacheVersion << static_cast<qint32>(songs.count());
+  for (const Song &song : songs) {
+    s << song;
+  }
+  file.close();
+
+}
+
 bool CddaSongLoader::HasChanged() {
 
   if (cdio_ && cdio_get_media_changed(cdio_) != 1) {
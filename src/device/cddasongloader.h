@@ -59,6 +59,11 @@ class CddaSongLoader : public QObject {
   void Error(const QString &error);
   QUrl GetUrlFromTrack(const int track_number) const;
 
+  // Persistent disc-id -> metadata cache, so a known CD populates instantly instead of re-querying MusicBrainz on every insertion.
+  static QString MetadataCacheFilename(const QString &discid);
+  bool LoadMetadataFromCache(const QString &discid);
+  void SaveMetadataToCache(const QString &discid, const SongList &songs) const;
+
  signals:
   void SongsLoadError(const QString &error);
   void SongsLoaded(const SongList &songs);
@@ -76,6 +81,9 @@ class CddaSongLoader : public QObject {
   GstElement *cdda_;
   CdIo_t *cdio_;
   QMutex mutex_load_;
+
+  // The disc-id of the in-flight MusicBrainz request, so the reply can be cached under it.
+  QString musicbrainz_discid_;
 };
 
 #endif  // CDDASONGLOADER_H
@@ -220,6 +220,7 @@ void DeviceView::SetApplication(Application *app) {
   setModel(merged_model_);
 
   QObject::connect(merged_model_, &MergedProxyModel::SubModelReset, this, &AutoExpandingTreeView::RecursivelyExpandSlot);
+  QObject::connect(this, &DeviceView::expanded, this, &DeviceView::ContainerExpanded);
 
   properties_dialog_->SetDeviceManager(app_->device_manager());
 
@@ -468,6 +469,18 @@ void DeviceView::DeleteFinished(const SongList &songs_with_errors) {
 
 }
 
+void DeviceView::ContainerExpanded(const QModelIndex &idx) {
+
+  const QModelIndex collection_index = MapToCollection(idx);
+  if (!collection_index.isValid()) return;
+
+  CollectionModel *collection = qobject_cast<CollectionModel*>(const_cast<QAbstractItemModel*>(collection_index.model()));
+  if (!collection) return;
+
+  collection->PrefetchChildAlbumCovers(collection_index);
+
+}
+
 bool DeviceView::CanRecursivelyExpand(const QModelIndex &idx) const {
   // Never expand devices
   return idx.parent().isValid();
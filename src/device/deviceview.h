@@ -94,6 +94,8 @@ class DeviceView : public AutoExpandingTreeView {
   void DeviceDisconnected(const QModelIndex &idx);
 
   void DeleteFinished(const SongList &songs_with_errors);
+  // Batches cover loads for the albums revealed by expanding a container, instead of one load per album as each row is painted.
+  void ContainerExpanded(const QModelIndex &idx);
 
  private:
   QModelIndex MapToDevice(const QModelIndex &merged_model_index) const;
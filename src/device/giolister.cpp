@@ -33,6 +33,7 @@
 
 #include <QtGlobal>
 #include <QMutex>
+#include <QTimer>
 #include <QList>
 #include <QVariantList>
 #include <QVariantMap>
@@ -47,6 +48,11 @@
 #include "devicelister.h"
 #include "giolister.h"
 
+namespace {
+// How long to wait for a burst of mount-changed signals to settle before refreshing the affected mounts.
+constexpr int kMountChangeDebounceIntervalMs = 250;
+}  // namespace
+
 QString GioLister::DeviceInfo::unique_id() const {
 
   if (!volume_root_uri.isEmpty()) return volume_root_uri;
@@ -385,6 +391,41 @@ void GioLister::MountAdded(GMount *mount) {
 
 void GioLister::MountChanged(GMount *mount) {
 
+  // GIO fires a burst of mount-changed signals per mount while volumes are (un)mounted, and refreshing the mount info does synchronous filesystem queries, so coalesce the burst and refresh each mount once.
+  ScopedGObject<GMount> mount_ptr;
+  mount_ptr.reset(mount);
+
+  {
+    QMutexLocker l(&mutex_);
+    if (!pending_mount_changes_.contains(mount_ptr)) {
+      pending_mount_changes_ << mount_ptr;
+    }
+    if (mount_changes_scheduled_) return;
+    mount_changes_scheduled_ = true;
+  }
+
+  QTimer::singleShot(kMountChangeDebounceIntervalMs, this, &GioLister::ProcessPendingMountChanges);
+
+}
+
+void GioLister::ProcessPendingMountChanges() {
+
+  QList<ScopedGObject<GMount>> mounts;
+  {
+    QMutexLocker l(&mutex_);
+    mounts = pending_mount_changes_;
+    pending_mount_changes_.clear();
+    mount_changes_scheduled_ = false;
+  }
+
+  for (const ScopedGObject<GMount> &mount : std::as_const(mounts)) {
+    UpdateMount(mount.get());
+  }
+
+}
+
+void GioLister::UpdateMount(GMount *mount) {
+
   QString id;
   {
     QMutexLocker l(&mutex_);
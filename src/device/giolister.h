@@ -50,7 +50,7 @@ class GioLister : public DeviceLister {
   Q_OBJECT
 
  public:
-  explicit GioLister(QObject *parent = nullptr) : DeviceLister(parent) {}
+  explicit GioLister(QObject *parent = nullptr) : DeviceLister(parent), mount_changes_scheduled_(false) {}
   ~GioLister() override;
 
   int priority() const override { return 50; }
@@ -72,6 +72,9 @@ class GioLister : public DeviceLister {
   void UnmountDevice(const QString &id) override;
   void UpdateDeviceFreeSpace(const QString &id) override;
 
+ private slots:
+  void ProcessPendingMountChanges();
+
  protected:
   bool Init() override;
 
@@ -121,6 +124,8 @@ class GioLister : public DeviceLister {
   void MountChanged(GMount *mount);
   void MountRemoved(GMount *mount);
 
+  void UpdateMount(GMount *mount);
+
   static void VolumeAddedCallback(GVolumeMonitor*, GVolume*, gpointer);
   static void VolumeRemovedCallback(GVolumeMonitor*, GVolume*, gpointer);
 
@@ -146,6 +151,10 @@ class GioLister : public DeviceLister {
 
   QMutex mutex_;
   QMap<QString, DeviceInfo> devices_;
+
+  // Mount-changed signals arrive in bursts while volumes are being (un)mounted; they are coalesced here and each mount is refreshed once per burst.
+  QList<ScopedGObject<GMount>> pending_mount_changes_;
+  bool mount_changes_scheduled_;
 };
 
 template<typename T>
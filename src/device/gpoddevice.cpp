@@ -53,12 +53,19 @@ class DeviceManager;
 
 using std::make_shared;
 
+namespace {
+// How many copied tracks may accumulate before the iTunesDB is checkpointed to disk.
+// The database itself is only written once per sync session in FinishCopy; the checkpoints bound how much is lost if the device is unplugged mid-sync.
+constexpr int kWriteDatabaseCheckpointInterval = 250;
+}  // namespace
+
 GPodDevice::GPodDevice(const QUrl &url, DeviceLister *lister, const QString &unique_id, SharedPtr<DeviceManager> manager, Application *app, const int database_id, const bool first_time, QObject *parent)
     : ConnectedDevice(url, lister, unique_id, manager, app, database_id, first_time, parent),
       loader_(nullptr),
       loader_thread_(nullptr),
       db_(nullptr),
-      closing_(false) {}
+      closing_(false),
+      tracks_copied_since_write_(0) {}
 
 bool GPodDevice::Init() {
 
@@ -269,16 +276,43 @@ bool GPodDevice::CopyToStorage(const CopyJob &job, QString &error_text) {
     QFile::remove(job.source_);
   }
 
+  ++tracks_copied_since_write_;
+  if (tracks_copied_since_write_ >= kWriteDatabaseCheckpointInterval) {
+    WriteDatabaseCheckpoint();
+  }
+
   return true;
 
 }
 
+void GPodDevice::WriteDatabaseCheckpoint() {
+
+  GError *error = nullptr;
+  if (itdb_write(db_, &error)) {
+    // The thumbnails were written with the database, so the temporary cover files are no longer needed.
+    cover_files_.clear();
+  }
+  else {
+    // A failed checkpoint is not fatal, the final write in FinishCopy reports errors to the user.
+    if (error) {
+      qLog(Warning) << "Writing database checkpoint failed:" << QString::fromUtf8(error->message);
+      g_error_free(error);
+    }
+    else {
+      qLog(Warning) << "Writing database checkpoint failed";
+    }
+  }
+  tracks_copied_since_write_ = 0;
+
+}
+
 bool GPodDevice::WriteDatabase(QString &error_text) {
 
   // Write the itunes database
   GError *error = nullptr;
   const bool success = itdb_write(db_, &error);
   cover_files_.clear();
+  tracks_copied_since_write_ = 0;
   if (!success) {
     if (error) {
       error_text = tr("Writing database failed: %1").arg(QString::fromUtf8(error->message));
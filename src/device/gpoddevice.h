@@ -84,6 +84,8 @@ class GPodDevice : public ConnectedDevice, public virtual MusicStorage {
   void Start();
   void Finish(const bool success);
   bool WriteDatabase(QString &error_text);
+  // Periodic safety write during long copy sessions, so an unplug or crash mid-sync does not leave every copied file missing from the database.
+  void WriteDatabaseCheckpoint();
 
  protected:
   GPodLoader *loader_;
@@ -95,6 +97,8 @@ class GPodDevice : public ConnectedDevice, public virtual MusicStorage {
   bool closing_;
 
   QMutex db_busy_;
+  // Tracks copied since the database was last written, used to decide when a checkpoint write is due.
+  int tracks_copied_since_write_;
   SongList songs_to_add_;
   SongList songs_to_remove_;
   QList<SharedPtr<QTemporaryFile>> cover_files_;
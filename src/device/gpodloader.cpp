@@ -102,12 +102,9 @@ Itdb_iTunesDB *GPodLoader::TryLoad() {
     songs << song;
   }
 
-  // Need to remove all the existing songs in the database first
-  backend_->DeleteSongs(backend_->FindSongsInDirectory(1));
-
   if (!abort_) {
-    // Add the songs we've just loaded
-    backend_->AddOrUpdateSongs(songs);
+    // Diff against the songs cached from the previous connection, so an unchanged device doesn't rewrite its table
+    backend_->SyncSongsInDirectory(songs, 1);
   }
 
   // This is done in the loader thread so close the unique DB connection.
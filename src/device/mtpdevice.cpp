@@ -138,7 +138,15 @@ bool MtpDevice::StartCopy(QList<Song::FileType> *supported_types) {
   // Ensure only one "organize files" can be active at any one time
   db_busy_.lock();
 
-  if (!connection_ || !connection_->is_valid()) return false;
+  // Re-establish the session if it was lost since the device was loaded, then keep it open for the whole sync.
+  if (!connection_ || !connection_->is_valid()) {
+    connection_.reset(new MtpConnection(url_));
+    if (!connection_->is_valid()) {
+      QString error_text;
+      FinishCopy(false, error_text);
+      return false;
+    }
+  }
 
   // Did the caller want a list of supported types?
   if (supported_types) {
@@ -248,6 +256,12 @@ bool MtpDevice::FinishDelete(const bool success, QString &error_text) { return F
 bool MtpDevice::GetSupportedFiletypes(QList<Song::FileType> *ret) {
 
   QMutexLocker l(&db_busy_);
+
+  // Reuse the session kept open from the initial load, opening a second session just for this query is slow and confuses some devices.
+  if (connection_ && connection_->is_valid()) {
+    return GetSupportedFiletypes(ret, connection_->device());
+  }
+
   MtpConnection connection(url_);
 
   if (!connection.is_valid()) {
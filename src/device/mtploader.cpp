@@ -98,11 +98,8 @@ bool MtpLoader::TryLoad() {
   }
 
   if (!abort_) {
-    // Need to remove all the existing songs in the database first
-    backend_->DeleteSongs(backend_->FindSongsInDirectory(1));
-
-    // Add the songs we've just loaded
-    backend_->AddOrUpdateSongs(songs);
+    // Diff against the songs cached from the previous connection, so an unchanged device doesn't rewrite its table
+    backend_->SyncSongsInDirectory(songs, 1);
   }
 
   // This is done in the loader thread so close the unique DB connection.
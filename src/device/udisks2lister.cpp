@@ -37,6 +37,7 @@
 #include <QDBusObjectPath>
 #include <QDBusConnection>
 #include <QDBusError>
+#include <QDBusMessage>
 #include <QDBusPendingReply>
 #include <QDBusArgument>
 #include <QJsonArray>
@@ -49,7 +50,6 @@
 #include "udisks2lister.h"
 
 #include "objectmanager.h"
-#include "udisks2block.h"
 #include "udisks2drive.h"
 #include "udisks2filesystem.h"
 #include "udisks2job.h"
@@ -58,9 +58,29 @@ using std::make_unique;
 using std::make_shared;
 
 namespace {
+
 constexpr char kUDisks2Service[] = "org.freedesktop.UDisks2";
+constexpr char kFilesystemInterface[] = "org.freedesktop.UDisks2.Filesystem";
+constexpr char kBlockInterface[] = "org.freedesktop.UDisks2.Block";
+constexpr char kDriveInterface[] = "org.freedesktop.UDisks2.Drive";
+constexpr char kJobInterface[] = "org.freedesktop.UDisks2.Job";
+constexpr char kPropertiesInterface[] = "org.freedesktop.DBus.Properties";
+
+QByteArrayList MountPointsFromProperties(const QVariantMap &filesystem_properties) {
+
+  const QVariant mount_points_variant = filesystem_properties.value(QStringLiteral("MountPoints"));
+  if (mount_points_variant.canConvert<QDBusArgument>()) {
+    QByteArrayList mount_points;
+    mount_points_variant.value<QDBusArgument>() >> mount_points;
+    return mount_points;
+  }
+
+  return mount_points_variant.value<QByteArrayList>();
+
 }
 
+}  // namespace
+
 Udisks2Lister::Udisks2Lister(QObject *parent) : DeviceLister(parent) {}
 
 Udisks2Lister::~Udisks2Lister() = default;
@@ -200,9 +220,13 @@ bool Udisks2Lister::Init() {
     return false;
   }
 
-  QList<QDBusObjectPath> paths = reply.value().keys();
-  for (const QDBusObjectPath &path : paths) {
-    PartitionData partition_data = ReadPartitionData(path);
+  // GetManagedObjects already delivered every property of every object in one call, so read them from the reply instead of issuing property reads per object.
+  const ManagedObjectList managed_objects = reply.value();
+  for (auto it = managed_objects.constBegin(); it != managed_objects.constEnd(); ++it) {
+    const InterfacesAndProperties &interfaces = it.value();
+    const QString drive_path = interfaces.value(QLatin1String(kBlockInterface)).value(QStringLiteral("Drive")).value<QDBusObjectPath>().path();
+    const QVariantMap drive_properties = managed_objects.value(QDBusObjectPath(drive_path)).value(QLatin1String(kDriveInterface));
+    PartitionData partition_data = ReadPartitionData(it.key(), interfaces, drive_properties);
 
     if (!partition_data.dbus_path.isEmpty()) {
       QWriteLocker locker(&device_data_lock_);
@@ -226,30 +250,38 @@ void Udisks2Lister::DBusInterfaceAdded(const QDBusObjectPath &path, const Interf
 
   for (auto interface = interfaces.constBegin(); interface != interfaces.constEnd(); ++interface) {
 
-    if (interface.key() != QLatin1String("org.freedesktop.UDisks2.Job")) continue;
+    if (interface.key() != QLatin1String(kJobInterface)) continue;
 
-    SharedPtr<OrgFreedesktopUDisks2JobInterface> job = make_shared<OrgFreedesktopUDisks2JobInterface>(QLatin1String(kUDisks2Service), path.path(), QDBusConnection::systemBus());
-
-    if (!job->isValid()) continue;
+    // The signal already carries the job's properties, so read them from the argument instead of doing blocking property reads back to the service.
+    const QVariantMap &job_properties = interface.value();
 
+    const QString operation = job_properties.value(QStringLiteral("Operation")).toString();
     bool is_mount_job = false;
-    if (job->operation() == QLatin1String("filesystem-mount")) {
+    if (operation == QLatin1String("filesystem-mount")) {
       is_mount_job = true;
     }
-    else if (job->operation() == QLatin1String("filesystem-unmount")) {
+    else if (operation == QLatin1String("filesystem-unmount")) {
       is_mount_job = false;
     }
     else {
       continue;
     }
 
-    auto mounted_partitions = job->objects();
+    QList<QDBusObjectPath> mounted_partitions;
+    const QVariant objects_variant = job_properties.value(QStringLiteral("Objects"));
+    if (objects_variant.canConvert<QDBusArgument>()) {
+      mounted_partitions = GetMountedPartitionsFromDBusArgument(objects_variant.value<QDBusArgument>());
+    }
 
     if (mounted_partitions.isEmpty()) {
       qLog(Warning) << "Empty Udisks2 mount/umount job " << path.path();
       continue;
     }
 
+    SharedPtr<OrgFreedesktopUDisks2JobInterface> job = make_shared<OrgFreedesktopUDisks2JobInterface>(QLatin1String(kUDisks2Service), path.path(), QDBusConnection::systemBus());
+
+    if (!job->isValid()) continue;
+
     {
       QMutexLocker locker(&jobs_lock_);
       qLog(Debug) << "Adding pending job | DBus Path = " << job->path() << " | IsMountJob = " << is_mount_job << " | First partition = " << mounted_partitions.at(0).path();
@@ -366,43 +398,87 @@ void Udisks2Lister::HandleFinishedUnmountJob(const PartitionData &partition_data
 
 }
 
+QVariantMap Udisks2Lister::GetAllProperties(const QString &path, const QString &interface) {
+
+  QDBusMessage message = QDBusMessage::createMethodCall(QLatin1String(kUDisks2Service), path, QLatin1String(kPropertiesInterface), QStringLiteral("GetAll"));
+  message.setArguments(QVariantList() << interface);
+
+  const QDBusMessage reply = QDBusConnection::systemBus().call(message);
+  if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+    return QVariantMap();
+  }
+
+  QVariantMap properties;
+  reply.arguments().first().value<QDBusArgument>() >> properties;
+
+  return properties;
+
+}
+
 Udisks2Lister::PartitionData Udisks2Lister::ReadPartitionData(const QDBusObjectPath &path) {
 
+  // Fetch each interface's whole property set with a single GetAll call instead of one blocking D-Bus read per property, and stop as soon as the object turns out to be unsuitable.
   PartitionData result;
-  OrgFreedesktopUDisks2FilesystemInterface filesystem(QLatin1String(kUDisks2Service), path.path(), QDBusConnection::systemBus());
-  OrgFreedesktopUDisks2BlockInterface block(QLatin1String(kUDisks2Service), path.path(), QDBusConnection::systemBus());
 
-  if (filesystem.isValid() && block.isValid() && !filesystem.mountPoints().empty()) {
-    OrgFreedesktopUDisks2DriveInterface drive(QLatin1String(kUDisks2Service), block.drive().path(), QDBusConnection::systemBus());
+  const QVariantMap filesystem_properties = GetAllProperties(path.path(), QLatin1String(kFilesystemInterface));
+  if (filesystem_properties.isEmpty() || MountPointsFromProperties(filesystem_properties).isEmpty()) return result;
 
-    if (drive.isValid() && drive.mediaRemovable()) {
-      result.dbus_path = path.path();
-      result.dbus_drive_path = block.drive().path();
+  const QVariantMap block_properties = GetAllProperties(path.path(), QLatin1String(kBlockInterface));
+  if (block_properties.isEmpty()) return result;
 
-      result.serial = drive.serial();
-      result.vendor = drive.vendor();
-      result.model = drive.model();
+  QVariantMap drive_properties;
+  const QString drive_path = block_properties.value(QStringLiteral("Drive")).value<QDBusObjectPath>().path();
+  if (!drive_path.isEmpty() && drive_path != QLatin1String("/")) {
+    drive_properties = GetAllProperties(drive_path, QLatin1String(kDriveInterface));
+  }
 
-      result.label = block.idLabel();
-      result.uuid = block.idUUID();
-      result.capacity = drive.size();
+  InterfacesAndProperties interfaces;
+  interfaces.insert(QLatin1String(kFilesystemInterface), filesystem_properties);
+  interfaces.insert(QLatin1String(kBlockInterface), block_properties);
 
-      if (result.label.isEmpty()) {
-        result.friendly_name = result.model + QLatin1Char(' ') + result.uuid;
-      }
-      else {
-        result.friendly_name = result.label;
-      }
+  return ReadPartitionData(path, interfaces, drive_properties);
 
-      for (const QByteArray &p : filesystem.mountPoints()) {
-        const QString mountpoint = QString::fromUtf8(p.data(), static_cast<qint64>(qstrlen(p.data())));
-        result.mount_paths.push_back(mountpoint);
-      }
+}
 
-      result.free_space = Utilities::FileSystemFreeSpace(result.mount_paths.at(0));
-    }
+Udisks2Lister::PartitionData Udisks2Lister::ReadPartitionData(const QDBusObjectPath &path, const InterfacesAndProperties &interfaces, const QVariantMap &drive_properties) {
+
+  PartitionData result;
+
+  if (!interfaces.contains(QLatin1String(kFilesystemInterface)) || !interfaces.contains(QLatin1String(kBlockInterface))) return result;
+
+  const QVariantMap filesystem_properties = interfaces.value(QLatin1String(kFilesystemInterface));
+  const QVariantMap block_properties = interfaces.value(QLatin1String(kBlockInterface));
+
+  const QByteArrayList mount_points = MountPointsFromProperties(filesystem_properties);
+  if (mount_points.isEmpty()) return result;
+
+  if (drive_properties.isEmpty() || !drive_properties.value(QStringLiteral("MediaRemovable")).toBool()) return result;
+
+  result.dbus_path = path.path();
+  result.dbus_drive_path = block_properties.value(QStringLiteral("Drive")).value<QDBusObjectPath>().path();
+
+  result.serial = drive_properties.value(QStringLiteral("Serial")).toString();
+  result.vendor = drive_properties.value(QStringLiteral("Vendor")).toString();
+  result.model = drive_properties.value(QStringLiteral("Model")).toString();
+
+  result.label = block_properties.value(QStringLiteral("IdLabel")).toString();
+  result.uuid = block_properties.value(QStringLiteral("IdUUID")).toString();
+  result.capacity = drive_properties.value(QStringLiteral("Size")).toULongLong();
+
+  if (result.label.isEmpty()) {
+    result.friendly_name = result.model + QLatin1Char(' ') + result.uuid;
+  }
+  else {
+    result.friendly_name = result.label;
   }
 
+  for (const QByteArray &p : mount_points) {
+    const QString mountpoint = QString::fromUtf8(p.data(), static_cast<qint64>(qstrlen(p.data())));
+    result.mount_paths.push_back(mountpoint);
+  }
+
+  result.free_space = Utilities::FileSystemFreeSpace(result.mount_paths.at(0));
+
   return result;
 
 }
@@ -115,7 +115,11 @@ class Udisks2Lister : public DeviceLister {
     QStringList mount_paths;
   };
 
+  // Fetches every property of the object with one GetAll round trip per interface.
   static PartitionData ReadPartitionData(const QDBusObjectPath &path);
+  // Builds the partition data from property maps that were already delivered over D-Bus, without any further round trips.
+  static PartitionData ReadPartitionData(const QDBusObjectPath &path, const InterfacesAndProperties &interfaces, const QVariantMap &drive_properties);
+  static QVariantMap GetAllProperties(const QString &path, const QString &interface);
   void HandleFinishedMountJob(const Udisks2Lister::PartitionData &partition_data);
   void HandleFinishedUnmountJob(const Udisks2Lister::PartitionData &partition_data, const QDBusObjectPath &mounted_object);
 
@@ -30,29 +30,82 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QSqlError>
+#include <QComboBox>
 #include <QLineEdit>
+#include <QListView>
 #include <QPushButton>
 #include <QScrollBar>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QTextBrowser>
+#include <QTimer>
 
 #include "console.h"
+#include "consolelogmodel.h"
+#include "core/logbuffer.h"
 #include "core/logging.h"
 #include "core/application.h"
 #include "core/database.h"
+#include "core/memorystats.h"
+#include "core/playbacktrace.h"
+#include "core/sqlquery.h"
+#include "core/tagreaderclient.h"
 
-Console::Console(Application *app, QWidget *parent) : QDialog(parent), ui_{}, app_(app) {
+namespace {
+// How often to pull new log lines from the buffer while the dialog is visible.
+constexpr int kLogUpdateIntervalMs = 500;
+}  // namespace
+
+Console::Console(Application *app, QWidget *parent) : QDialog(parent), ui_{}, app_(app), log_model_(nullptr), log_timer_(nullptr), log_follow_tail_(true) {
 
   ui_.setupUi(this);
 
   setWindowFlags(windowFlags() | Qt::WindowMaximizeButtonHint);
 
   QObject::connect(ui_.run, &QPushButton::clicked, this, &Console::RunQuery);
+  QObject::connect(ui_.tagreader_stats, &QPushButton::clicked, this, &Console::ShowTagReaderStats);
+  QObject::connect(ui_.query_stats, &QPushButton::clicked, this, &Console::ShowQueryStats);
+  QObject::connect(ui_.memory_stats, &QPushButton::clicked, this, &Console::ShowMemoryStats);
+  QObject::connect(ui_.playback_trace, &QPushButton::clicked, this, &Console::ShowPlaybackTrace);
+
+  log_model_ = new ConsoleLogModel(this);
+  ui_.log_output->setModel(log_model_);
+
+  log_timer_ = new QTimer(this);
+  log_timer_->setInterval(kLogUpdateIntervalMs);
+  QObject::connect(log_timer_, &QTimer::timeout, log_model_, &ConsoleLogModel::Update);
+
+  QObject::connect(ui_.log_level, &QComboBox::currentIndexChanged, this, &Console::LogLevelChanged);
+  QObject::connect(ui_.log_filter, &QLineEdit::textChanged, log_model_, &ConsoleLogModel::SetCategoryFilter);
+  QObject::connect(ui_.log_search, &QLineEdit::returnPressed, this, &Console::LogSearch);
+  QObject::connect(ui_.log_clear, &QPushButton::clicked, this, &Console::ClearLog);
+  QObject::connect(log_model_, &ConsoleLogModel::rowsAboutToBeInserted, this, &Console::LogRowsAboutToBeInserted);
+  QObject::connect(log_model_, &ConsoleLogModel::rowsInserted, this, &Console::LogRowsInserted);
 
   QFont font(QStringLiteral("Monospace"));
   font.setStyleHint(QFont::TypeWriter);
 
   ui_.output->setFont(font);
   ui_.query->setFont(font);
+  ui_.log_output->setFont(font);
+
+}
+
+void Console::showEvent(QShowEvent *e) {
+
+  QDialog::showEvent(e);
+
+  log_model_->Update();
+  ui_.log_output->scrollToBottom();
+  log_timer_->start();
+
+}
+
+void Console::hideEvent(QHideEvent *e) {
+
+  log_timer_->stop();
+
+  QDialog::hideEvent(e);
 
 }
 
@@ -86,3 +139,111 @@ void Console::RunQuery() {
   ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
 
 }
+
+void Console::ShowQueryStats() {
+
+  ui_.output->append(QStringLiteral("<b>&gt; ") + tr("Query statistics") + QStringLiteral("</b>"));
+
+  // Turn tracing on from here so statistics can be gathered without restarting with STRAWBERRY_SQL_TRACE set.
+  if (!SqlQuery::TraceEnabled()) {
+    SqlQuery::SetTraceEnabled(true);
+    ui_.output->append(tr("Query tracing was off and has now been enabled, use the application and check again.").toHtmlEscaped());
+  }
+  else {
+    const QStringList lines = SqlQuery::DiagnosticsReport().split(QLatin1Char('\n'));
+    for (const QString &line : lines) {
+      ui_.output->append(QStringLiteral("<pre>") + line.toHtmlEscaped() + QStringLiteral("</pre>"));
+    }
+  }
+
+  ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
+
+}
+
+void Console::ShowMemoryStats() {
+
+  ui_.output->append(QStringLiteral("<b>&gt; ") + tr("Memory statistics") + QStringLiteral("</b>"));
+  const QStringList lines = MemoryStats::Report().split(QLatin1Char('\n'));
+  for (const QString &line : lines) {
+    ui_.output->append(line.toHtmlEscaped());
+  }
+
+  ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
+
+}
+
+void Console::ShowPlaybackTrace() {
+
+  ui_.output->append(QStringLiteral("<b>&gt; ") + tr("Playback trace") + QStringLiteral("</b>"));
+
+  const QStringList lines = PlaybackTrace::Report();
+  if (lines.isEmpty()) {
+    ui_.output->append(tr("No playback events recorded yet.").toHtmlEscaped());
+  }
+  else {
+    for (const QString &line : lines) {
+      ui_.output->append(QStringLiteral("<pre>") + line.toHtmlEscaped() + QStringLiteral("</pre>"));
+    }
+  }
+
+  ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
+
+}
+
+void Console::LogLevelChanged(const int idx) {
+
+  // The combobox lists Debug, Info, Warning, Error; logging levels run the other way (Error = 0 .. Debug = 3).
+  log_model_->SetLevelFilter(logging::Level_Debug - idx);
+  ui_.log_output->scrollToBottom();
+
+}
+
+void Console::LogRowsAboutToBeInserted() {
+
+  const QScrollBar *scrollbar = ui_.log_output->verticalScrollBar();
+  log_follow_tail_ = scrollbar->value() >= scrollbar->maximum();
+
+}
+
+void Console::LogRowsInserted() {
+
+  if (log_follow_tail_) {
+    ui_.log_output->scrollToBottom();
+  }
+
+}
+
+void Console::LogSearch() {
+
+  const QString text = ui_.log_search->text();
+  if (text.isEmpty()) return;
+
+  // Continue from the row after the current match so repeated presses step through the matches.
+  const QModelIndex current = ui_.log_output->currentIndex();
+  const int row = log_model_->FindNext(text, current.isValid() ? current.row() + 1 : 0);
+  if (row == -1) return;
+
+  const QModelIndex idx = log_model_->index(row, 0);
+  ui_.log_output->setCurrentIndex(idx);
+  ui_.log_output->scrollTo(idx);
+
+}
+
+void Console::ClearLog() {
+
+  logging::LogBuffer::Instance()->Clear();
+  log_model_->Clear();
+
+}
+
+void Console::ShowTagReaderStats() {
+
+  ui_.output->append(QStringLiteral("<b>&gt; ") + tr("Tag reader statistics") + QStringLiteral("</b>"));
+  const QStringList lines = TagReaderClient::Instance()->WorkerPoolDiagnostics().split(QLatin1Char('\n'));
+  for (const QString &line : lines) {
+    ui_.output->append(line.toHtmlEscaped());
+  }
+
+  ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
+
+}
@@ -31,7 +31,12 @@
 
 #include "ui_console.h"
 
+class QShowEvent;
+class QHideEvent;
+class QTimer;
+
 class Application;
+class ConsoleLogModel;
 
 class Console : public QDialog {
   Q_OBJECT
@@ -39,12 +44,31 @@ class Console : public QDialog {
  public:
   explicit Console(Application *app, QWidget *parent = nullptr);
 
+ protected:
+  void showEvent(QShowEvent *e) override;
+  void hideEvent(QHideEvent *e) override;
+
  private slots:
   void RunQuery();
+  void ShowTagReaderStats();
+  void ShowQueryStats();
+  void ShowMemoryStats();
+  void ShowPlaybackTrace();
+  void LogLevelChanged(const int idx);
+  void LogRowsAboutToBeInserted();
+  void LogRowsInserted();
+  void LogSearch();
+  void ClearLog();
 
  private:
   Ui::Console ui_;
   Application *app_;
+
+  ConsoleLogModel *log_model_;
+  // Pulls new log lines from the buffer while the dialog is visible.
+  QTimer *log_timer_;
+  // Whether the log view was scrolled to the bottom before the last insert, so it keeps following the tail.
+  bool log_follow_tail_;
 };
 
 #endif  // CONSOLE_H
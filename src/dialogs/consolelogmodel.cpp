@@ -0,0 +1,161 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QAbstractListModel>
+#include <QBrush>
+#include <QColor>
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+#include "core/logbuffer.h"
+#include "core/logging.h"
+
+#include "consolelogmodel.h"
+
+namespace {
+// Upper bound on the lines the model mirrors from the ring buffer, so a day-long session stays bounded even though the model only ever appends.
+constexpr qsizetype kMaxLines = 100000;
+}  // namespace
+
+ConsoleLogModel::ConsoleLogModel(QObject *parent)
+    : QAbstractListModel(parent),
+      next_sequence_(0),
+      level_filter_(logging::Level_Debug) {}
+
+int ConsoleLogModel::rowCount(const QModelIndex &parent) const {
+
+  if (parent.isValid()) return 0;
+  return static_cast<int>(visible_.count());
+
+}
+
+QVariant ConsoleLogModel::data(const QModelIndex &idx, int role) const {
+
+  if (!idx.isValid() || idx.row() < 0 || idx.row() >= visible_.count()) return QVariant();
+
+  const logging::LogBuffer::Line &line = lines_[visible_[idx.row()]];
+
+  switch (role) {
+    case Qt::DisplayRole:
+      return line.text;
+    case Qt::ForegroundRole:
+      if (line.level <= logging::Level_Error) return QBrush(QColor(164, 0, 0));
+      if (line.level == logging::Level_Warning) return QBrush(QColor(177, 116, 0));
+      return QVariant();
+    default:
+      return QVariant();
+  }
+
+}
+
+void ConsoleLogModel::SetLevelFilter(const int level) {
+
+  if (level == level_filter_) return;
+  level_filter_ = level;
+  RebuildVisible();
+
+}
+
+void ConsoleLogModel::SetCategoryFilter(const QString &filter) {
+
+  if (filter == category_filter_) return;
+  category_filter_ = filter;
+  RebuildVisible();
+
+}
+
+int ConsoleLogModel::FindNext(const QString &text, const int from_row) const {
+
+  if (text.isEmpty() || visible_.isEmpty()) return -1;
+
+  const int count = static_cast<int>(visible_.count());
+  const int start = from_row >= 0 && from_row < count ? from_row : 0;
+  for (int i = 0; i < count; ++i) {
+    const int row = (start + i) % count;
+    if (lines_[visible_[row]].text.contains(text, Qt::CaseInsensitive)) return row;
+  }
+
+  return -1;
+
+}
+
+void ConsoleLogModel::Update() {
+
+  const QList<logging::LogBuffer::Line> new_lines = logging::LogBuffer::Instance()->LinesSince(next_sequence_);
+  if (new_lines.isEmpty()) return;
+
+  next_sequence_ = new_lines.last().sequence + 1;
+
+  QList<qsizetype> new_visible;
+  for (const logging::LogBuffer::Line &line : new_lines) {
+    lines_.append(line);
+    if (Matches(line)) new_visible.append(lines_.count() - 1);
+  }
+
+  if (!new_visible.isEmpty()) {
+    beginInsertRows(QModelIndex(), static_cast<int>(visible_.count()), static_cast<int>(visible_.count() + new_visible.count() - 1));
+    visible_.append(new_visible);
+    endInsertRows();
+  }
+
+  if (lines_.count() > kMaxLines) {
+    const qsizetype remove_count = lines_.count() - kMaxLines;
+    beginResetModel();
+    lines_.remove(0, remove_count);
+    visible_.clear();
+    for (qsizetype i = 0; i < lines_.count(); ++i) {
+      if (Matches(lines_[i])) visible_.append(i);
+    }
+    endResetModel();
+  }
+
+}
+
+void ConsoleLogModel::Clear() {
+
+  beginResetModel();
+  lines_.clear();
+  visible_.clear();
+  endResetModel();
+
+}
+
+bool ConsoleLogModel::Matches(const logging::LogBuffer::Line &line) const {
+
+  if (line.level > level_filter_) return false;
+  if (!category_filter_.isEmpty() && !line.category.contains(category_filter_, Qt::CaseInsensitive)) return false;
+
+  return true;
+
+}
+
+void ConsoleLogModel::RebuildVisible() {
+
+  beginResetModel();
+  visible_.clear();
+  for (qsizetype i = 0; i < lines_.count(); ++i) {
+    if (Matches(lines_[i])) visible_.append(i);
+  }
+  endResetModel();
+
+}
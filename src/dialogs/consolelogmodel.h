@@ -0,0 +1,68 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONSOLELOGMODEL_H
+#define CONSOLELOGMODEL_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+
+#include "core/logbuffer.h"
+
+// List model over the in-memory log ring buffer for the Console dialog.
+// The view stays virtualized through the model, and filters only rebuild the index of visible rows instead of re-rendering the text.
+class ConsoleLogModel : public QAbstractListModel {
+  Q_OBJECT
+
+ public:
+  explicit ConsoleLogModel(QObject *parent = nullptr);
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &idx, int role = Qt::DisplayRole) const override;
+
+  // Keeps lines whose level is at most `level` (a logging::Level, so Error < Warning < Info < Debug).
+  void SetLevelFilter(const int level);
+  // Keeps lines whose category contains `filter`, case insensitively. An empty filter keeps everything.
+  void SetCategoryFilter(const QString &filter);
+
+  // Returns the first visible row at or after `from_row` (wrapping around) whose text contains `text`, or -1.
+  int FindNext(const QString &text, const int from_row) const;
+
+ public slots:
+  // Pulls new lines from the log buffer. Called on a timer while the dialog is visible.
+  void Update();
+  void Clear();
+
+ private:
+  bool Matches(const logging::LogBuffer::Line &line) const;
+  void RebuildVisible();
+
+  QList<logging::LogBuffer::Line> lines_;
+  // Indexes into lines_ of the rows that pass the filters, in order.
+  QList<qsizetype> visible_;
+  quint64 next_sequence_;
+  int level_filter_;
+  QString category_filter_;
+};
+
+#endif  // CONSOLELOGMODEL_H
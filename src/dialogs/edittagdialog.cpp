@@ -40,6 +40,7 @@
 #include <QDateTime>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QVariant>
 #include <QString>
 #include <QUrl>
@@ -72,6 +73,7 @@
 #include "core/iconloader.h"
 #include "core/logging.h"
 #include "core/tagreaderclient.h"
+#include "core/taskmanager.h"
 #include "core/settings.h"
 #include "utilities/strutils.h"
 #include "utilities/timeutils.h"
@@ -104,6 +106,12 @@ constexpr char kTagsDifferentHintText[] = QT_TR_NOOP("(different across multiple
 constexpr char kArtDifferentHintText[] = QT_TR_NOOP("Different art across multiple songs.");
 constexpr char kSettingsGroup[] = "EditTagDialog";
 constexpr int kSmallImageSize = 128;
+// How many tag writes are kept in flight when saving a multi-song selection.
+// Overridable with the write_concurrency setting for storage that handles more parallel writes, such as a NAS.
+constexpr int kDefaultSaveTagConcurrency = 4;
+// How many songs on each side of the current one get their covers loaded ahead of navigation, and how many prefetched covers are kept.
+constexpr int kPrefetchCoverCount = 2;
+constexpr int kPrefetchedCoverCacheSize = 8;
 }  // namespace
 
 EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
@@ -115,7 +123,7 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       tag_fetcher_(new TagFetcher(app->network(), this)),
       results_dialog_(new TrackSelectionDialog(this)),
 #endif
-      lyrics_fetcher_(new LyricsFetcher(app->lyrics_providers(), this)),
+      lyrics_fetcher_(new LyricsFetcher(app->lyrics_providers(), app->lyrics_backend(), this)),
       cover_menu_(new QMenu(this)),
       image_no_cover_thumbnail_(ImageUtils::GenerateNoCoverImage(QSize(128, 128), devicePixelRatioF())),
       loading_(false),
@@ -123,12 +131,17 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       summary_cover_art_id_(-1),
       tags_cover_art_id_(-1),
       cover_art_is_set_(false),
+      prefetched_covers_(kPrefetchedCoverCacheSize),
       save_tag_pending_(0),
+      save_tag_concurrency_(kDefaultSaveTagConcurrency),
+      save_tag_total_(0),
+      save_tag_task_id_(0),
       lyrics_id_(-1) {
 
   QObject::connect(&*app_->album_cover_loader(), &AlbumCoverLoader::AlbumCoverLoaded, this, &EditTagDialog::AlbumCoverLoaded);
 
 #ifdef HAVE_MUSICBRAINZ
+  QObject::connect(tag_fetcher_, &TagFetcher::ResultUpdated, results_dialog_, &TrackSelectionDialog::FetchTagUpdated, Qt::QueuedConnection);
   QObject::connect(tag_fetcher_, &TagFetcher::ResultAvailable, results_dialog_, &TrackSelectionDialog::FetchTagFinished, Qt::QueuedConnection);
   QObject::connect(tag_fetcher_, &TagFetcher::Progress, results_dialog_, &TrackSelectionDialog::FetchTagProgress);
   QObject::connect(results_dialog_, &TrackSelectionDialog::SongChosen, this, &EditTagDialog::FetchTagSongChosen);
@@ -393,17 +406,25 @@ bool EditTagDialog::SetLoading(const QString &message) {
 
 QList<EditTagDialog::Data> EditTagDialog::LoadData(const SongList &songs) {
 
-  QList<Data> ret;
-
+  SongList editable_songs;
+  QStringList filenames;
   for (const Song &song : songs) {
     if (song.IsEditable()) {
-      // Try reloading the tags from file
-      Song copy(song);
-      const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(copy.url().toLocalFile(), &copy);
-      if (result.success() && copy.is_valid()) {
-        copy.MergeUserSetData(song, false, false);
-        ret << Data(copy);
-      }
+      editable_songs << song;
+      filenames << song.url().toLocalFile();
+    }
+  }
+
+  // Try reloading the tags from file, batched so the IPC overhead is paid once per batch instead of once per file.
+  SongList copies = editable_songs;
+  const QList<TagReaderClient::Result> results = TagReaderClient::Instance()->ReadFileBatchBlocking(filenames, &copies);
+
+  QList<Data> ret;
+  for (qsizetype i = 0; i < copies.count(); ++i) {
+    Song &copy = copies[i];
+    if (results[i].success() && copy.is_valid()) {
+      copy.MergeUserSetData(editable_songs[i], false, false);
+      ret << Data(copy);
     }
   }
 
@@ -731,11 +752,21 @@ void EditTagDialog::SelectionChanged() {
     cover_options.desired_scaled_size = QSize(kSmallImageSize, kSmallImageSize);
     cover_options.device_pixel_ratio = devicePixelRatioF();
     if (data_[indexes.first().row()].cover_action_ == UpdateCoverAction::None) {
-      tags_cover_art_id_ = app_->album_cover_loader()->LoadImageAsync(cover_options, first_song);
+      if (AlbumCoverLoaderResult *prefetched_cover = prefetched_covers_.object(first_song.url())) {
+        // The cover was loaded ahead of the navigation, so it can be applied right away.
+        tags_cover_art_id_ = -1;
+        TagsCoverLoaded(*prefetched_cover);
+      }
+      else {
+        tags_cover_art_id_ = app_->album_cover_loader()->LoadImageAsync(cover_options, first_song);
+      }
     }
     else {
       tags_cover_art_id_ = app_->album_cover_loader()->LoadImageAsync(cover_options, data_[indexes.first().row()].cover_result_);
     }
+    if (indexes.count() == 1) {
+      PrefetchNeighbourCovers(indexes.first().row());
+    }
   }
 
   const bool embedded_cover = (first_song.save_embedded_cover_supported() && (first_song.art_embedded() || album_cover_choice_controller_->get_collection_save_album_cover_type() == CoverOptions::CoverType::Embedded));
@@ -781,12 +812,6 @@ void EditTagDialog::SetDate(QLabel *label, const uint time) {
 
 void EditTagDialog::UpdateSummaryTab(const Song &song) {
 
-  AlbumCoverLoaderOptions cover_options(AlbumCoverLoaderOptions::Option::ScaledImage | AlbumCoverLoaderOptions::Option::PadScaledImage);
-  cover_options.types = cover_types_;
-  cover_options.desired_scaled_size = QSize(kSmallImageSize, kSmallImageSize);
-  cover_options.device_pixel_ratio = devicePixelRatioF();
-  summary_cover_art_id_ = app_->album_cover_loader()->LoadImageAsync(cover_options, song);
-
   ui_->summary->setText(QStringLiteral("<p><b>") + song.PrettyTitleWithArtist().toHtmlEscaped() + QStringLiteral("</b></p>"));
 
   ui_->length->setText(Utilities::PrettyTimeNanosec(song.length_nanosec()));
@@ -835,6 +860,19 @@ void EditTagDialog::UpdateSummaryTab(const Song &song) {
 
   ui_->art_unset->setText(song.art_unset() ? tr("Yes") : tr("No"));
 
+  // The art summary is appended to the summary text once the cover is loaded, so the load goes last.
+  if (AlbumCoverLoaderResult *prefetched_cover = prefetched_covers_.object(song.url())) {
+    summary_cover_art_id_ = -1;
+    SummaryCoverLoaded(*prefetched_cover);
+  }
+  else {
+    AlbumCoverLoaderOptions cover_options(AlbumCoverLoaderOptions::Option::ScaledImage | AlbumCoverLoaderOptions::Option::PadScaledImage);
+    cover_options.types = cover_types_;
+    cover_options.desired_scaled_size = QSize(kSmallImageSize, kSmallImageSize);
+    cover_options.device_pixel_ratio = devicePixelRatioF();
+    summary_cover_art_id_ = app_->album_cover_loader()->LoadImageAsync(cover_options, song);
+  }
+
 }
 
 QString EditTagDialog::GetArtSummary(const Song &song, const AlbumCoverLoaderResult::Type cover_type) {
@@ -901,56 +939,95 @@ void EditTagDialog::UpdateStatisticsTab(const Song &song) {
 void EditTagDialog::AlbumCoverLoaded(const quint64 id, const AlbumCoverLoaderResult &result) {
 
   if (id == summary_cover_art_id_) {
-    if (result.success && !result.image_scaled.isNull() && result.type != AlbumCoverLoaderResult::Type::Unset) {
-      ui_->summary_art->setPixmap(QPixmap::fromImage(result.image_scaled));
-    }
-    else {
-      ui_->summary_art->setPixmap(QPixmap::fromImage(image_no_cover_thumbnail_));
-    }
-    if (ui_->song_list->selectionModel()->selectedIndexes().count() > 0) {
-      const QModelIndex idx = ui_->song_list->selectionModel()->selectedIndexes().first();
-      QString summary = ui_->summary->toPlainText();
-      summary += QLatin1String("<br />");
-      summary += QLatin1String("<br />");
-      summary += GetArtSummary(data_[idx.row()].current_, result.type);
-      ui_->summary->setText(summary);
-    }
     summary_cover_art_id_ = -1;
+    SummaryCoverLoaded(result);
   }
   else if (id == tags_cover_art_id_) {
-    if (result.success && !result.image_scaled.isNull() && result.type != AlbumCoverLoaderResult::Type::Unset) {
-      ui_->tags_art->setPixmap(QPixmap::fromImage(result.image_scaled));
+    tags_cover_art_id_ = -1;
+    TagsCoverLoaded(result);
+  }
+  else if (cover_prefetch_ids_.contains(id)) {
+    const QUrl url = cover_prefetch_ids_.take(id);
+    if (result.success) {
+      prefetched_covers_.insert(url, new AlbumCoverLoaderResult(result));
     }
-    else {
-      ui_->tags_art->setPixmap(QPixmap::fromImage(image_no_cover_thumbnail_));
+  }
+
+}
+
+void EditTagDialog::SummaryCoverLoaded(const AlbumCoverLoaderResult &result) {
+
+  if (result.success && !result.image_scaled.isNull() && result.type != AlbumCoverLoaderResult::Type::Unset) {
+    ui_->summary_art->setPixmap(QPixmap::fromImage(result.image_scaled));
+  }
+  else {
+    ui_->summary_art->setPixmap(QPixmap::fromImage(image_no_cover_thumbnail_));
+  }
+  if (ui_->song_list->selectionModel()->selectedIndexes().count() > 0) {
+    const QModelIndex idx = ui_->song_list->selectionModel()->selectedIndexes().first();
+    QString summary = ui_->summary->toPlainText();
+    summary += QLatin1String("<br />");
+    summary += QLatin1String("<br />");
+    summary += GetArtSummary(data_[idx.row()].current_, result.type);
+    ui_->summary->setText(summary);
+  }
+
+}
+
+void EditTagDialog::TagsCoverLoaded(const AlbumCoverLoaderResult &result) {
+
+  if (result.success && !result.image_scaled.isNull() && result.type != AlbumCoverLoaderResult::Type::Unset) {
+    ui_->tags_art->setPixmap(QPixmap::fromImage(result.image_scaled));
+  }
+  else {
+    ui_->tags_art->setPixmap(QPixmap::fromImage(image_no_cover_thumbnail_));
+  }
+  Song first_song;
+  UpdateCoverAction cover_action = UpdateCoverAction::None;
+  for (const QModelIndex &idx : ui_->song_list->selectionModel()->selectedIndexes()) {
+    data_[idx.row()].cover_result_ = result.album_cover;
+    if (!first_song.is_valid()) {
+      first_song = data_[idx.row()].current_;
+      cover_action = data_[idx.row()].cover_action_;
     }
-    Song first_song;
-    UpdateCoverAction cover_action = UpdateCoverAction::None;
-    for (const QModelIndex &idx : ui_->song_list->selectionModel()->selectedIndexes()) {
-      data_[idx.row()].cover_result_ = result.album_cover;
-      if (!first_song.is_valid()) {
-        first_song = data_[idx.row()].current_;
-        cover_action = data_[idx.row()].cover_action_;
-      }
+  }
+  bool enable_change_art = false;
+  if (first_song.is_valid()) {
+    QString summary = ui_->tags_summary->toPlainText();
+    summary += QLatin1String("<br />");
+    summary += QLatin1String("<br />");
+    if (cover_action == UpdateCoverAction::None) {
+      summary += GetArtSummary(first_song, result.type);
     }
-    bool enable_change_art = false;
-    if (first_song.is_valid()) {
-      QString summary = ui_->tags_summary->toPlainText();
-      summary += QLatin1String("<br />");
-      summary += QLatin1String("<br />");
-      if (cover_action == UpdateCoverAction::None) {
-        summary += GetArtSummary(first_song, result.type);
-      }
-      else {
-        summary += GetArtSummary(cover_action);
-      }
-      ui_->tags_summary->setText(summary);
-      enable_change_art = first_song.is_collection_song() && !first_song.effective_albumartist().isEmpty() && !first_song.album().isEmpty();
+    else {
+      summary += GetArtSummary(cover_action);
     }
-    tags_cover_art_id_ = -1;
-    album_cover_choice_controller_->show_cover_action()->setEnabled(result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
-    album_cover_choice_controller_->cover_to_file_action()->setEnabled(result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
-    album_cover_choice_controller_->delete_cover_action()->setEnabled(enable_change_art && result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
+    ui_->tags_summary->setText(summary);
+    enable_change_art = first_song.is_collection_song() && !first_song.effective_albumartist().isEmpty() && !first_song.album().isEmpty();
+  }
+  album_cover_choice_controller_->show_cover_action()->setEnabled(result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
+  album_cover_choice_controller_->cover_to_file_action()->setEnabled(result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
+  album_cover_choice_controller_->delete_cover_action()->setEnabled(enable_change_art && result.success && result.type != AlbumCoverLoaderResult::Type::Unset);
+
+}
+
+void EditTagDialog::PrefetchNeighbourCovers(const int row) {
+
+  if (data_.count() < 2) return;
+
+  for (int offset = -kPrefetchCoverCount; offset <= kPrefetchCoverCount; ++offset) {
+    if (offset == 0) continue;
+    const int prefetch_row = static_cast<int>((row + offset + data_.count()) % data_.count());
+    if (prefetch_row == row) continue;
+    const Data &other = data_[prefetch_row];
+    if (other.cover_action_ != UpdateCoverAction::None) continue;
+    const QUrl url = other.original_.url();
+    if (prefetched_covers_.contains(url) || cover_prefetch_ids_.values().contains(url)) continue;
+    AlbumCoverLoaderOptions cover_options(AlbumCoverLoaderOptions::Option::RawImageData | AlbumCoverLoaderOptions::Option::OriginalImage | AlbumCoverLoaderOptions::Option::ScaledImage | AlbumCoverLoaderOptions::Option::PadScaledImage);
+    cover_options.types = cover_types_;
+    cover_options.desired_scaled_size = QSize(kSmallImageSize, kSmallImageSize);
+    cover_options.device_pixel_ratio = devicePixelRatioF();
+    cover_prefetch_ids_.insert(app_->album_cover_loader()->LoadImageAsync(cover_options, other.original_), url);
   }
 
 }
@@ -1271,32 +1348,31 @@ void EditTagDialog::SaveData() {
       if (ref.current_.year() <= 0) { ref.current_.set_year(-1); }
       if (ref.current_.originalyear() <= 0) { ref.current_.set_originalyear(-1); }
       if (ref.current_.lastplayed() <= 0) { ref.current_.set_lastplayed(-1); }
-      ++save_tag_pending_;
-      TagReaderClient::SaveCoverOptions savecover_options;
+      PendingTagSave pending_save;
+      pending_save.song = ref.current_;
+      pending_save.cover_action = ref.cover_action_;
       if (save_embedded_cover && ref.cover_action_ == UpdateCoverAction::New) {
         if (!ref.cover_result_.image.isNull()) {
-          savecover_options.mime_type = ref.cover_result_.mime_type;
+          pending_save.cover_options.mime_type = ref.cover_result_.mime_type;
         }
         else if (!embedded_cover_from_file.isEmpty()) {
-          savecover_options.cover_filename = embedded_cover_from_file;
+          pending_save.cover_options.cover_filename = embedded_cover_from_file;
         }
-        savecover_options.cover_data = ref.cover_result_.image_data;
+        pending_save.cover_options.cover_data = ref.cover_result_.image_data;
       }
-      TagReaderClient::SaveTypes save_types;
       if (save_tags) {
-        save_types |= TagReaderClient::SaveType::Tags;
+        pending_save.save_types |= TagReaderClient::SaveType::Tags;
       }
       if (save_playcount) {
-        save_types |= TagReaderClient::SaveType::PlayCount;
+        pending_save.save_types |= TagReaderClient::SaveType::PlayCount;
       }
       if (save_rating) {
-        save_types |= TagReaderClient::SaveType::Rating;
+        pending_save.save_types |= TagReaderClient::SaveType::Rating;
       }
       if (save_embedded_cover) {
-        save_types |= TagReaderClient::SaveType::Cover;
+        pending_save.save_types |= TagReaderClient::SaveType::Cover;
       }
-      TagReaderReply *reply = TagReaderClient::Instance()->WriteFile(ref.current_.url().toLocalFile(), ref.current_, save_types, savecover_options);
-      QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, ref]() { SongSaveTagsComplete(reply, ref.current_.url().toLocalFile(), ref.current_, ref.cover_action_); }, Qt::QueuedConnection);
+      pending_tag_saves_ << pending_save;
     }
     // If the cover was changed, but no tags written, make sure to update the collection.
     else if (ref.cover_action_ != UpdateCoverAction::None && !ref.current_.effective_albumartist().isEmpty() && !ref.current_.album().isEmpty()) {
@@ -1310,7 +1386,64 @@ void EditTagDialog::SaveData() {
 
   }
 
-  if (save_tag_pending_ <= 0) SaveDataFinished();
+  if (pending_tag_saves_.isEmpty()) {
+    SaveDataFinished();
+    return;
+  }
+
+  Settings s;
+  s.beginGroup(kSettingsGroup);
+  save_tag_concurrency_ = qMax(1, s.value("write_concurrency", kDefaultSaveTagConcurrency).toInt());
+  s.endGroup();
+
+  save_tag_total_ = static_cast<int>(pending_tag_saves_.count());
+  save_tag_task_id_ = app_->task_manager()->StartTask(tr("Saving tracks"));
+  app_->task_manager()->SetTaskProgress(save_tag_task_id_, 0, static_cast<quint64>(save_tag_total_));
+
+  // Encode each distinct cover once on a worker thread before any write is queued,
+  // so applying one cover to a whole album converts the image a single time instead of once per track.
+  QFuture<QList<PendingTagSave>> future = QtConcurrent::run([tag_saves = pending_tag_saves_]() mutable {
+    QHash<QByteArray, TagReaderClient::SaveCoverOptions> encoded_covers_by_data;
+    QHash<QString, TagReaderClient::SaveCoverOptions> encoded_covers_by_filename;
+    for (PendingTagSave &tag_save : tag_saves) {
+      if (!tag_save.save_types.testFlag(TagReaderClient::SaveType::Cover)) continue;
+      if (!tag_save.cover_options.cover_data.isEmpty()) {
+        const QByteArray key = tag_save.cover_options.cover_data;
+        if (!encoded_covers_by_data.contains(key)) {
+          encoded_covers_by_data.insert(key, TagReaderClient::EncodeCoverForEmbedding(tag_save.cover_options));
+        }
+        tag_save.cover_options = encoded_covers_by_data[key];
+      }
+      else if (!tag_save.cover_options.cover_filename.isEmpty()) {
+        const QString key = tag_save.cover_options.cover_filename;
+        if (!encoded_covers_by_filename.contains(key)) {
+          encoded_covers_by_filename.insert(key, TagReaderClient::EncodeCoverForEmbedding(tag_save.cover_options));
+        }
+        tag_save.cover_options = encoded_covers_by_filename[key];
+      }
+    }
+    return tag_saves;
+  });
+  QFutureWatcher<QList<PendingTagSave>> *watcher = new QFutureWatcher<QList<PendingTagSave>>();
+  QObject::connect(watcher, &QFutureWatcher<QList<PendingTagSave>>::finished, this, [this, watcher]() {
+    pending_tag_saves_ = watcher->result();
+    watcher->deleteLater();
+    SendNextTagSaveRequests();
+  });
+  watcher->setFuture(future);
+
+}
+
+void EditTagDialog::SendNextTagSaveRequests() {
+
+  // Keep a bounded number of writes in flight: enough to use the parallelism of the storage, without flooding the workers with a huge selection at once.
+  while (!pending_tag_saves_.isEmpty() && save_tag_pending_ < save_tag_concurrency_) {
+    const PendingTagSave pending_save = pending_tag_saves_.takeFirst();
+    ++save_tag_pending_;
+    const QString filename = pending_save.song.url().toLocalFile();
+    TagReaderReply *reply = TagReaderClient::Instance()->WriteFile(filename, pending_save.song, pending_save.save_types, pending_save.cover_options);
+    QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, filename, pending_save]() { SongSaveTagsComplete(reply, filename, pending_save.song, pending_save.cover_action); }, Qt::QueuedConnection);
+  }
 
 }
 
@@ -1495,6 +1628,18 @@ void EditTagDialog::SongSaveTagsComplete(TagReaderReply *reply, const QString &f
     }
   }
 
-  if (save_tag_pending_ <= 0) SaveDataFinished();
+  if (save_tag_task_id_ != 0) {
+    app_->task_manager()->SetTaskProgress(save_tag_task_id_, static_cast<quint64>(save_tag_total_ - save_tag_pending_ - pending_tag_saves_.count()), static_cast<quint64>(save_tag_total_));
+  }
+
+  SendNextTagSaveRequests();
+
+  if (save_tag_pending_ <= 0 && pending_tag_saves_.isEmpty()) {
+    if (save_tag_task_id_ != 0) {
+      app_->task_manager()->SetTaskFinished(save_tag_task_id_);
+      save_tag_task_id_ = 0;
+    }
+    SaveDataFinished();
+  }
 
 }
@@ -31,6 +31,7 @@
 #include <QVariant>
 #include <QString>
 #include <QUrl>
+#include <QCache>
 #include <QList>
 #include <QMap>
 #include <QImage>
@@ -145,9 +146,25 @@ class EditTagDialog : public QDialog {
     QString id_;
   };
 
+  struct PendingTagSave {
+    Song song;
+    UpdateCoverAction cover_action;
+    TagReaderClient::SaveTypes save_types;
+    TagReaderClient::SaveCoverOptions cover_options;
+  };
+
   Song *GetFirstSelected();
   void UpdateCover(const UpdateCoverAction cover_action, const AlbumCoverImageResult &cover_result = AlbumCoverImageResult());
 
+  // Sends pending tag saves until the configured number of writes are in flight.
+  void SendNextTagSaveRequests();
+
+  // Applies a loaded cover to the summary tab / tags tab, shared between async replies and prefetched covers.
+  void SummaryCoverLoaded(const AlbumCoverLoaderResult &result);
+  void TagsCoverLoaded(const AlbumCoverLoaderResult &result);
+  // Starts cover loads for the songs around the given row, so stepping through the selection with next/previous doesn't stall on art loads.
+  void PrefetchNeighbourCovers(const int row);
+
   bool DoesValueVary(const QModelIndexList &sel, const QString &id) const;
   bool IsValueModified(const QModelIndexList &sel, const QString &id) const;
 
@@ -201,10 +218,19 @@ class EditTagDialog : public QDialog {
   quint64 tags_cover_art_id_;
   bool cover_art_is_set_;
 
+  // Covers loaded ahead of the current song, keyed by song URL.
+  QCache<QUrl, AlbumCoverLoaderResult> prefetched_covers_;
+  // Pending prefetch loads, load id to song URL.
+  QMap<quint64, QUrl> cover_prefetch_ids_;
+
   QPushButton *previous_button_;
   QPushButton *next_button_;
 
   int save_tag_pending_;
+  QList<PendingTagSave> pending_tag_saves_;
+  int save_tag_concurrency_;
+  int save_tag_total_;
+  int save_tag_task_id_;
 
   QMap<int, Song> collection_songs_;
 
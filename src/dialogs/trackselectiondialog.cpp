@@ -21,6 +21,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <utility>
 
 #include <QtConcurrentRun>
@@ -49,6 +50,7 @@
 #include "core/iconloader.h"
 #include "core/logging.h"
 #include "core/tagreaderclient.h"
+#include "utilities/timeconstants.h"
 #include "widgets/busyindicator.h"
 #include "trackselectiondialog.h"
 #include "ui_trackselectiondialog.h"
@@ -56,7 +58,8 @@
 TrackSelectionDialog::TrackSelectionDialog(QWidget *parent)
     : QDialog(parent),
       ui_(new Ui_TrackSelectionDialog),
-      save_on_close_(false) {
+      save_on_close_(false),
+      updating_stack_(false) {
 
   // Setup dialog window
   ui_->setupUi(this);
@@ -120,17 +123,22 @@ void TrackSelectionDialog::Init(const SongList &songs) {
 
 }
 
-void TrackSelectionDialog::FetchTagProgress(const Song &original_song, const QString &progress) {
+int TrackSelectionDialog::FindRow(const Song &original_song) const {
 
   // Find the item with this filename
-  int row = -1;
   for (int i = 0; i < data_.count(); ++i) {
     if (data_[i].original_song_.url() == original_song.url()) {
-      row = i;
-      break;
+      return i;
     }
   }
 
+  return -1;
+
+}
+
+void TrackSelectionDialog::FetchTagProgress(const Song &original_song, const QString &progress) {
+
+  const int row = FindRow(original_song);
   if (row == -1) return;
 
   data_[row].progress_string_ = progress;
@@ -142,17 +150,80 @@ void TrackSelectionDialog::FetchTagProgress(const Song &original_song, const QSt
 
 }
 
-void TrackSelectionDialog::FetchTagFinished(const Song &original_song, const SongList &songs_guessed) {
+int TrackSelectionDialog::MatchScore(const Song &original, const Song &candidate) {
 
-  // Find the item with this filename
-  int row = -1;
-  for (int i = 0; i < data_.count(); ++i) {
-    if (data_[i].original_song_.url() == original_song.url()) {
-      row = i;
-      break;
+  int score = 0;
+
+  if (!candidate.title().isEmpty() && QString::compare(original.title(), candidate.title(), Qt::CaseInsensitive) == 0) score += 3;
+  if (!candidate.artist().isEmpty() && QString::compare(original.artist(), candidate.artist(), Qt::CaseInsensitive) == 0) score += 3;
+  if (!candidate.album().isEmpty() && QString::compare(original.album(), candidate.album(), Qt::CaseInsensitive) == 0) score += 2;
+
+  if (original.length_nanosec() > 0 && candidate.length_nanosec() > 0) {
+    const qint64 diff = qAbs(original.length_nanosec() - candidate.length_nanosec());
+    if (diff <= 3 * kNsecPerSec) score += 2;
+    else if (diff <= 10 * kNsecPerSec) score += 1;
+  }
+
+  if (original.track() > 0 && original.track() == candidate.track()) score += 1;
+
+  return score;
+
+}
+
+SongList TrackSelectionDialog::RankResults(const Song &original, const SongList &results) {
+
+  SongList ret = results;
+  std::stable_sort(ret.begin(), ret.end(), [&original](const Song &a, const Song &b) { return MatchScore(original, a) > MatchScore(original, b); });
+  return ret;
+
+}
+
+void TrackSelectionDialog::SetResults(const int row, const SongList &songs_guessed) {
+
+  Data &tag_data = data_[row];
+
+  // Remember the user's pick so it survives re-ranking as more candidates stream in.
+  bool have_previous = false;
+  Song previous;
+  if (tag_data.manual_selection_ && tag_data.selected_result_ >= 0 && tag_data.selected_result_ < tag_data.results_.count()) {
+    previous = tag_data.results_[tag_data.selected_result_];
+    have_previous = true;
+  }
+
+  tag_data.results_ = RankResults(tag_data.original_song_, songs_guessed);
+  // The best ranked candidate is pre-selected until the user picks one themselves.
+  tag_data.selected_result_ = 0;
+
+  if (have_previous) {
+    for (int i = 0; i < tag_data.results_.count(); ++i) {
+      const Song &song = tag_data.results_[i];
+      if (song.title() == previous.title() && song.artist() == previous.artist() && song.album() == previous.album() && song.track() == previous.track() && song.year() == previous.year()) {
+        tag_data.selected_result_ = i;
+        break;
+      }
     }
   }
 
+}
+
+void TrackSelectionDialog::FetchTagUpdated(const Song &original_song, const SongList &songs_guessed) {
+
+  const int row = FindRow(original_song);
+  if (row == -1 || songs_guessed.isEmpty()) return;
+
+  // The lookup is still running, so leave the row marked pending but show what we have.
+  SetResults(row, songs_guessed);
+
+  // If it's the current item, update the display
+  if (ui_->song_list->currentIndex().row() == row) {
+    UpdateStack();
+  }
+
+}
+
+void TrackSelectionDialog::FetchTagFinished(const Song &original_song, const SongList &songs_guessed) {
+
+  const int row = FindRow(original_song);
   if (row == -1) return;
 
   // Set the color back to black
@@ -160,7 +231,7 @@ void TrackSelectionDialog::FetchTagFinished(const Song &original_song, const Son
 
   // Add the results to the list
   data_[row].pending_ = false;
-  data_[row].results_ = songs_guessed;
+  SetResults(row, songs_guessed);
 
   // If it's the current item, update the display
   if (ui_->song_list->currentIndex().row() == row) {
@@ -176,17 +247,21 @@ void TrackSelectionDialog::UpdateStack() {
 
   const Data &tag_data = data_[row];
 
-  if (tag_data.pending_) {
-    ui_->stack->setCurrentWidget(ui_->loading_page);
-    ui_->progress->set_text(tag_data.progress_string_ + QStringLiteral("..."));
-    return;
-  }
+  // Results are shown as soon as any are available, even while the lookup is still running.
   if (tag_data.results_.isEmpty()) {
-    ui_->stack->setCurrentWidget(ui_->error_page);
+    if (tag_data.pending_) {
+      ui_->stack->setCurrentWidget(ui_->loading_page);
+      ui_->progress->set_text(tag_data.progress_string_ + QStringLiteral("..."));
+    }
+    else {
+      ui_->stack->setCurrentWidget(ui_->error_page);
+    }
     return;
   }
   ui_->stack->setCurrentWidget(ui_->results_page);
 
+  updating_stack_ = true;
+
   // Clear tree widget
   ui_->results->clear();
 
@@ -195,7 +270,7 @@ void TrackSelectionDialog::UpdateStack() {
   AddSong(tag_data.original_song_, -1, ui_->results);
 
   // Fill tree view with songs
-  AddDivider(tr("Suggested tags"), ui_->results);
+  AddDivider(tag_data.pending_ ? tr("Suggested tags (searching)") : tr("Suggested tags"), ui_->results);
 
   int song_index = 0;
   for (const Song &song : tag_data.results_) {
@@ -211,6 +286,9 @@ void TrackSelectionDialog::UpdateStack() {
       break;
     }
   }
+
+  updating_stack_ = false;
+
 }
 
 void TrackSelectionDialog::AddDivider(const QString &text, QTreeWidget *parent) const {
@@ -240,6 +318,9 @@ void TrackSelectionDialog::AddSong(const Song &song, int result_index, QTreeWidg
 
 void TrackSelectionDialog::ResultSelected() {
 
+  // Ignore the selection UpdateStack() makes while rebuilding the tree.
+  if (updating_stack_) return;
+
   if (!ui_->results->currentItem()) return;
 
   const int song_row = ui_->song_list->currentRow();
@@ -247,6 +328,7 @@ void TrackSelectionDialog::ResultSelected() {
 
   const int result_index = ui_->results->currentItem()->data(0, Qt::UserRole).toInt();
   data_[song_row].selected_result_ = result_index;
+  data_[song_row].manual_selection_ = true;
 
 }
 
@@ -265,7 +347,11 @@ void TrackSelectionDialog::SaveData(const QList<Data> &data) {
 
   for (int i = 0; i < data.count(); ++i) {
     const Data &ref = data[i];
-    if (ref.pending_ || ref.results_.isEmpty() || ref.selected_result_ == -1) {
+    if (ref.results_.isEmpty() || ref.selected_result_ == -1) {
+      continue;
+    }
+    // A row whose lookup is still running is only applied when the user explicitly confirmed one of the streamed candidates.
+    if (ref.pending_ && !ref.manual_selection_) {
       continue;
     }
 
@@ -303,7 +389,10 @@ void TrackSelectionDialog::accept() {
   QDialog::accept();
 
   for (const Data &tag_data : std::as_const(data_)) {
-    if (tag_data.pending_ || tag_data.results_.isEmpty() || tag_data.selected_result_ == -1) {
+    if (tag_data.results_.isEmpty() || tag_data.selected_result_ == -1) {
+      continue;
+    }
+    if (tag_data.pending_ && !tag_data.manual_selection_) {
       continue;
     }
 
@@ -48,6 +48,8 @@ class TrackSelectionDialog : public QDialog {
 
  public slots:
   void FetchTagProgress(const Song &original_song, const QString &progress);
+  // Shows the candidates found so far for a song while its lookup is still running, so matches can be confirmed while other files are still fingerprinting.
+  void FetchTagUpdated(const Song &original_song, const SongList &songs_guessed);
   void FetchTagFinished(const Song &original_song, const SongList &songs_guessed);
 
   // QDialog
@@ -70,15 +72,24 @@ class TrackSelectionDialog : public QDialog {
   Ui_TrackSelectionDialog *ui_;
 
   struct Data {
-    Data() : pending_(true), selected_result_(0) {}
+    Data() : pending_(true), manual_selection_(false), selected_result_(0) {}
 
     Song original_song_;
     bool pending_;
+    // Whether the user picked a result themselves; if not, the best ranked candidate stays pre-selected as results stream in.
+    bool manual_selection_;
     QString progress_string_;
     SongList results_;
     int selected_result_;
   };
 
+  int FindRow(const Song &original_song) const;
+  void SetResults(const int row, const SongList &songs_guessed);
+
+  // How well a candidate matches the original song; used to rank the results with the best match first.
+  static int MatchScore(const Song &original, const Song &candidate);
+  static SongList RankResults(const Song &original, const SongList &results);
+
   void AddDivider(const QString &text, QTreeWidget *parent) const;
   static void AddSong(const Song &song, int result_index, QTreeWidget *parent);
 
@@ -92,6 +103,8 @@ class TrackSelectionDialog : public QDialog {
   QPushButton *next_button_;
 
   bool save_on_close_;
+  // Set while UpdateStack() rebuilds the tree, so programmatic selection changes are not mistaken for the user's.
+  bool updating_stack_;
 };
 
 #endif  // TRACKSELECTIONDIALOG_H
@@ -72,6 +72,9 @@ QString Chromaprinter::CreateFingerprint() {
 
   if (!buffer_.open(QIODevice::WriteOnly)) return QString();
 
+  // We know exactly how much decoded audio is coming, reserve it up front so the appsink callback never reallocates.
+  buffer_.buffer().reserve(kPlayLengthSecs * kDecodeRate * kDecodeChannels * static_cast<int>(sizeof(int16_t)));
+
   GstElement *pipeline = gst_pipeline_new("pipeline");
   if (!pipeline) {
     buffer_.close();
@@ -19,9 +19,13 @@
 
 #include "config.h"
 
+#include <utility>
+
 #include <QtAlgorithms>
+#include <QtConcurrentRun>
 #include <QObject>
 #include <QList>
+#include <QMutexLocker>
 
 #include "core/logging.h"
 #include "devicefinders.h"
@@ -49,7 +53,7 @@
 #  endif  // _MSC_VER
 #endif  // Q_OS_WIN32
 
-DeviceFinders::DeviceFinders(QObject *parent) : QObject(parent) {}
+DeviceFinders::DeviceFinders(QObject *parent) : QObject(parent), refreshing_(false) {}
 
 DeviceFinders::~DeviceFinders() {
   qDeleteAll(device_finders_);
@@ -88,4 +92,54 @@ void DeviceFinders::Init() {
     device_finders_.append(finder);
   }
 
+  // Warm the device cache in the background, so the backend settings page doesn't have to probe the audio system when it's first opened.
+  RefreshDevicesAsync();
+
+}
+
+EngineDeviceList DeviceFinders::GetDevices(const QString &output) {
+
+  QMutexLocker l(&mutex_);
+
+  EngineDeviceList devices;
+  for (DeviceFinder *finder : std::as_const(device_finders_)) {
+    if (!finder->outputs().contains(output)) continue;
+    devices << cached_devices_.value(finder);
+  }
+
+  return devices;
+
+}
+
+void DeviceFinders::RefreshDevicesAsync() {
+
+  {
+    QMutexLocker l(&mutex_);
+    if (refreshing_) return;
+    refreshing_ = true;
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  (void)QtConcurrent::run(&DeviceFinders::RefreshDevices, this);
+#else
+  (void)QtConcurrent::run(this, &DeviceFinders::RefreshDevices);
+#endif
+
+}
+
+void DeviceFinders::RefreshDevices() {
+
+  QHash<DeviceFinder*, EngineDeviceList> devices;
+  for (DeviceFinder *finder : std::as_const(device_finders_)) {
+    devices.insert(finder, finder->ListDevices());
+  }
+
+  {
+    QMutexLocker l(&mutex_);
+    cached_devices_ = devices;
+    refreshing_ = false;
+  }
+
+  emit DevicesUpdated();
+
 }
@@ -23,9 +23,13 @@
 #include "config.h"
 
 #include <QObject>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QString>
 
+#include "enginedevice.h"
+
 class DeviceFinder;
 
 class DeviceFinders : public QObject {
@@ -38,8 +42,24 @@ class DeviceFinders : public QObject {
   void Init();
   QList<DeviceFinder*> ListFinders() { return device_finders_; }
 
+  // Returns the cached devices for all finders handling the given output.
+  // Served from the cache filled by RefreshDevicesAsync(), so this never blocks on probing the audio system.
+  EngineDeviceList GetDevices(const QString &output);
+
+  // Re-enumerates the devices of every finder on a background thread and emits DevicesUpdated() when the cache has been updated.
+  void RefreshDevicesAsync();
+
+ signals:
+  void DevicesUpdated();
+
  private:
+  void RefreshDevices();
+
   QList<DeviceFinder*> device_finders_;
+
+  QMutex mutex_;
+  QHash<DeviceFinder*, EngineDeviceList> cached_devices_;
+  bool refreshing_;
 };
 
 #endif  // DEVICEFINDERS_H
@@ -503,6 +503,46 @@ std::optional<EBUR128Measures> EBUR128AnalysisImpl::Compute(const Song &song) {
 
 }  // namespace
 
+class EBUR128AnalysisStream::Impl {
+ public:
+  std::optional<EBUR128State> state;
+};
+
+EBUR128AnalysisStream::EBUR128AnalysisStream() : impl_(new Impl) {}
+
+EBUR128AnalysisStream::~EBUR128AnalysisStream() = default;
+
+bool EBUR128AnalysisStream::AddSample(GstSample *sample) {
+
+  const FrameFormat dsc(gst_sample_get_caps(sample));
+  if (!impl_->state) {
+    impl_->state.emplace(dsc);
+  }
+  else if (impl_->state->dsc != dsc) {
+    return false;
+  }
+
+  GstBuffer *buffer = gst_sample_get_buffer(sample);
+  if (buffer) {
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      impl_->state->AddFrames(reinterpret_cast<const char*>(map.data), map.size);
+      gst_buffer_unmap(buffer, &map);
+    }
+  }
+
+  return true;
+
+}
+
+std::optional<EBUR128Measures> EBUR128AnalysisStream::Finalize() {
+
+  if (!impl_->state) return std::nullopt;
+
+  return EBUR128State::Finalize(std::move(impl_->state.value()));
+
+}
+
 std::optional<EBUR128Measures> EBUR128Analysis::Compute(const Song &song) {
 
   Q_ASSERT(QThread::currentThread() != qApp->thread());
@@ -24,6 +24,11 @@
 
 #include <optional>
 
+#include <gst/gst.h>
+
+#include <QtGlobal>
+
+#include "core/scoped_ptr.h"
 #include "core/song.h"
 #include "ebur128measures.h"
 
@@ -38,4 +43,25 @@ class EBUR128Analysis {
   static std::optional<EBUR128Measures> Compute(const Song &song);
 };
 
+// Accumulates EBU R 128 measures incrementally from decoded raw-audio samples.
+// Meant to be fed from an appsink on a tee in another pipeline, for example during a transcode, so the file doesn't have to be decoded a second time just for loudness analysis.
+class EBUR128AnalysisStream {
+ public:
+  explicit EBUR128AnalysisStream();
+  ~EBUR128AnalysisStream();
+
+  // Feeds one decoded sample.
+  // Returns false if the sample format changed mid-stream, in which case the sample is discarded and the measures are no longer meaningful.
+  bool AddSample(GstSample *sample);
+
+  // The accumulated measures, or `std::nullopt` when no audio was fed in.
+  std::optional<EBUR128Measures> Finalize();
+
+ private:
+  class Impl;
+  ScopedPtr<Impl> impl_;
+
+  Q_DISABLE_COPY(EBUR128AnalysisStream)
+};
+
 #endif  // EBUR128ANALYSIS_H
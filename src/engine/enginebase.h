@@ -33,6 +33,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QList>
+#include <QMap>
 #include <QMetaType>
 #include <QVariant>
 #include <QString>
@@ -96,6 +97,17 @@ class EngineBase : public QObject {
 
   using Scope = std::vector<int16_t>;
 
+  // Playback telemetry sampled cheaply by the engine from its pipeline (bus/QoS messages),
+  // so glitches can be attributed to decode, resample or the sink without attaching a debugger.
+  struct Telemetry {
+    quint64 qos_processed_buffers = 0;
+    quint64 qos_dropped_buffers = 0;
+    qint64 qos_jitter_nanosec = 0;
+    int buffer_underruns = 0;
+    qint64 sink_latency_nanosec = -1;
+    QMap<QString, quint64> qos_dropped_by_element;
+  };
+
   static Type TypeFromName(const QString &name);
   static QString Name(const Type type);
   static QString Description(const Type type);
@@ -117,6 +129,12 @@ class EngineBase : public QObject {
 
   virtual const Scope &scope(const int chunk_length) { Q_UNUSED(chunk_length); return scope_; }
 
+  // Telemetry for the currently playing stream. Engines without instrumentation return the defaults.
+  virtual Telemetry telemetry() const { return Telemetry(); }
+
+  // On-demand diagnostic snapshot of the playback pipeline for support reports; empty when the engine has nothing to report.
+  virtual QString DebugPipelineSnapshot() const { return QString(); }
+
   // Sets new values for the beginning and end markers of the currently playing song.
   // This doesn't change the state of engine or the stream's current position.
   virtual void RefreshMarkers(const quint64 beginning_nanosec, const qint64 end_nanosec) {
@@ -51,6 +51,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/logging.h"
+#include "core/playbacktrace.h"
 #include "core/taskmanager.h"
 #include "core/signalchecker.h"
 #include "utilities/timeconstants.h"
@@ -115,6 +116,7 @@ GstEngine::~GstEngine() {
 
   EnsureInitialized();
   current_pipeline_.reset();
+  standby_pipeline_.reset();
 
   if (latest_buffer_) {
     gst_buffer_unref(latest_buffer_);
@@ -186,6 +188,8 @@ bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const Engine
 
   EnsureInitialized();
 
+  PlaybackTrace::Record("engine load", stream_url.toString());
+
   EngineBase::Load(media_url, stream_url, change, force_stop_at_end, beginning_nanosec, end_nanosec, ebur128_integrated_loudness_lufs);
 
   const QByteArray gst_url = FixupUrl(stream_url);
@@ -236,6 +240,9 @@ bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const Engine
     }
   }
 
+  // Build the next standby pipeline once control returns to the event loop, so the next track change can skip element creation too.
+  QMetaObject::invokeMethod(this, &GstEngine::EnsureStandbyPipeline, Qt::QueuedConnection);
+
   return true;
 
 }
@@ -246,6 +253,8 @@ bool GstEngine::Play(const quint64 offset_nanosec) {
 
   if (!current_pipeline_ || current_pipeline_->is_buffering()) return false;
 
+  PlaybackTrace::Record("engine play");
+
   QFutureWatcher<GstStateChangeReturn> *watcher = new QFutureWatcher<GstStateChangeReturn>();
   const int pipeline_id = current_pipeline_->id();
   QObject::connect(watcher, &QFutureWatcher<GstStateChangeReturn>::finished, this, [this, watcher, pipeline_id, offset_nanosec]() {
@@ -342,6 +351,8 @@ void GstEngine::Seek(const quint64 offset_nanosec) {
 
   if (!current_pipeline_) return;
 
+  PlaybackTrace::Record("engine seek");
+
   seek_pos_ = beginning_nanosec_ + offset_nanosec;
   waiting_to_seek_ = true;
 
@@ -349,6 +360,11 @@ void GstEngine::Seek(const quint64 offset_nanosec) {
     SeekNow();
     seek_timer_->start();  // Stop us from seeking again for a little while
   }
+  else {
+    // Still scrubbing: give instant coarse feedback with a cheap keyframe seek.
+    // The accurate seek to the final position happens when the timer fires.
+    current_pipeline_->SeekFast(static_cast<qint64>(seek_pos_));
+  }
 }
 
 void GstEngine::SetVolumeSW(const uint volume) {
@@ -405,6 +421,32 @@ const EngineBase::Scope &GstEngine::scope(const int chunk_length) {
 
 }
 
+EngineBase::Telemetry GstEngine::telemetry() const {
+
+  if (!current_pipeline_) return Telemetry();
+
+  const GstEnginePipeline::Telemetry pipeline_telemetry = current_pipeline_->telemetry();
+
+  Telemetry t;
+  t.qos_processed_buffers = pipeline_telemetry.qos_processed_buffers;
+  t.qos_dropped_buffers = pipeline_telemetry.qos_dropped_buffers;
+  t.qos_jitter_nanosec = pipeline_telemetry.qos_jitter_nanosec;
+  t.buffer_underruns = pipeline_telemetry.buffer_underruns;
+  t.sink_latency_nanosec = pipeline_telemetry.sink_latency_nanosec;
+  t.qos_dropped_by_element = pipeline_telemetry.qos_dropped_by_element;
+
+  return t;
+
+}
+
+QString GstEngine::DebugPipelineSnapshot() const {
+
+  if (!current_pipeline_) return QString();
+
+  return current_pipeline_->DebugSnapshot();
+
+}
+
 EngineBase::OutputDetailsList GstEngine::GetOutputsList() const {
 
   const_cast<GstEngine*>(this)->EnsureInitialized();
@@ -472,6 +514,9 @@ void GstEngine::ReloadSettings() {
 
   if (output_.isEmpty()) output_ = QLatin1String(kAutoSink);
 
+  // The standby pipeline was built with the old output/device/settings, drop it so the next one picks up the new ones.
+  standby_pipeline_.reset();
+
 }
 
 void GstEngine::ConsumeBuffer(GstBuffer *buffer, const int pipeline_id, const QString &format) {
@@ -488,6 +533,7 @@ void GstEngine::SetStereoBalancerEnabled(const bool enabled) {
 
   stereo_balancer_enabled_ = enabled;
   if (current_pipeline_) current_pipeline_->set_stereo_balancer_enabled(enabled);
+  standby_pipeline_.reset();
 
 }
 
@@ -502,6 +548,7 @@ void GstEngine::SetEqualizerEnabled(const bool enabled) {
 
   equalizer_enabled_ = enabled;
   if (current_pipeline_) current_pipeline_->set_equalizer_enabled(enabled);
+  standby_pipeline_.reset();
 
 }
 
@@ -518,6 +565,7 @@ void GstEngine::AddBufferConsumer(GstBufferConsumer *consumer) {
 
   buffer_consumers_ << consumer;
   if (current_pipeline_) current_pipeline_->AddBufferConsumer(consumer);
+  if (standby_pipeline_) standby_pipeline_->AddBufferConsumer(consumer);
 
 }
 
@@ -525,6 +573,7 @@ void GstEngine::RemoveBufferConsumer(GstBufferConsumer *consumer) {
 
   buffer_consumers_.removeAll(consumer);
   if (current_pipeline_) current_pipeline_->RemoveBufferConsumer(consumer);
+  if (standby_pipeline_) standby_pipeline_->RemoveBufferConsumer(consumer);
 
 }
 
@@ -838,9 +887,33 @@ SharedPtr<GstEnginePipeline> GstEngine::CreatePipeline() {
 
 }
 
+void GstEngine::EnsureStandbyPipeline() {
+
+  if (standby_pipeline_) return;
+
+  SharedPtr<GstEnginePipeline> pipeline = CreatePipeline();
+  QString error;
+  if (!pipeline->InitPipeline(error)) {
+    qLog(Error) << "Failed to build standby pipeline:" << error;
+    return;
+  }
+
+  standby_pipeline_ = pipeline;
+
+}
+
 SharedPtr<GstEnginePipeline> GstEngine::CreatePipeline(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, const double ebur128_loudness_normalizing_gain_db) {
 
-  SharedPtr<GstEnginePipeline> ret = CreatePipeline();
+  SharedPtr<GstEnginePipeline> ret;
+
+  // Use the pre-built standby pipeline when there is one, so the track change only has to assign the URL.
+  if (standby_pipeline_) {
+    ret = standby_pipeline_;
+    standby_pipeline_.reset();
+  }
+  else {
+    ret = CreatePipeline();
+  }
   QString error;
   if (!ret->InitFromUrl(media_url, stream_url, gst_url, end_nanosec, ebur128_loudness_normalizing_gain_db, error)) {
     ret.reset();
@@ -76,6 +76,9 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   qint64 length_nanosec() const override;
   const EngineBase::Scope &scope(const int chunk_length) override;
 
+  Telemetry telemetry() const override;
+  QString DebugPipelineSnapshot() const override;
+
   OutputDetailsList GetOutputsList() const override;
   bool ValidOutput(const QString &output) override;
   QString DefaultOutput() override { return QLatin1String(kAutoSink); }
@@ -123,6 +126,8 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   void BufferingProgress(int percent);
   void BufferingFinished();
 
+  void EnsureStandbyPipeline();
+
  private:
   QByteArray FixupUrl(const QUrl &url);
 
@@ -168,6 +173,8 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   SharedPtr<GstEnginePipeline> current_pipeline_;
   SharedPtr<GstEnginePipeline> fadeout_pipeline_;
   SharedPtr<GstEnginePipeline> fadeout_pause_pipeline_;
+  // A fully built but URL-less pipeline prepared ahead of time, so a track change only has to assign the URL instead of creating and linking elements. Dropped whenever settings it was built with change.
+  SharedPtr<GstEnginePipeline> standby_pipeline_;
 
   QList<GstBufferConsumer*> buffer_consumers_;
 
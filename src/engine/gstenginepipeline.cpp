@@ -48,13 +48,17 @@
 #include <QList>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 #include <QTimeLine>
 #include <QEasingCurve>
 #include <QMetaObject>
 #include <QUuid>
 
+#include "ext/gstequalizer/gststrawberryeq.h"
+
 #include "core/logging.h"
+#include "core/playbacktrace.h"
 #include "core/signalchecker.h"
 #include "utilities/timeconstants.h"
 #include "settings/backendsettingspage.h"
@@ -63,6 +67,10 @@
 #include "gstbufferconsumer.h"
 
 constexpr int GstEnginePipeline::kGstStateTimeoutNanosecs = 10000000;
+constexpr quint64 GstEnginePipeline::kAdaptiveBufferDurationMaxNanosec = 60 * kNsecPerSec;
+// Extra room added to the audio queue when the next URL is set for a gapless transition,
+// so the decoder can push the first seconds of the upcoming track while the queue is still full of the current track's tail.
+constexpr quint64 GstEnginePipeline::kNextTrackPreDecodeNanosec = 2 * kNsecPerSec;
 constexpr int GstEnginePipeline::kFaderFudgeMsec = 2000;
 
 constexpr int GstEnginePipeline::kEqBandCount = 10;
@@ -88,9 +96,12 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       rg_compression_(true),
       ebur128_loudness_normalization_(false),
       buffer_duration_nanosec_(BackendSettingsPage::kDefaultBufferDuration * kNsecPerMsec),
+      buffer_duration_current_nanosec_(BackendSettingsPage::kDefaultBufferDuration * kNsecPerMsec),
       buffer_low_watermark_(BackendSettingsPage::kDefaultBufferLowWatermark),
       buffer_high_watermark_(BackendSettingsPage::kDefaultBufferHighWatermark),
       buffering_(false),
+      buffer_underruns_(0),
+      qos_jitter_nanosec_(0),
       proxy_authentication_(false),
       channels_enabled_(false),
       channels_(0),
@@ -109,6 +120,7 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       last_known_position_ns_(0),
       next_uri_set_(false),
       next_uri_reset_(false),
+      next_predecode_headroom_added_(false),
       ebur128_loudness_normalizing_gain_db_(0.0),
       volume_set_(false),
       volume_internal_(-1.0),
@@ -137,6 +149,10 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       about_to_finish_cb_id_(-1),
       notify_volume_cb_id_(-1),
       logged_unsupported_analyzer_format_(false),
+      first_buffer_traced_(false),
+      buffer_probe_caps_(nullptr),
+      buffer_probe_channels_(1),
+      buffer_probe_rate_(0),
       about_to_finish_(false) {
 
   eq_band_gains_.reserve(kEqBandCount);
@@ -218,6 +234,11 @@ GstEnginePipeline::~GstEnginePipeline() {
 
   }
 
+  if (buffer_probe_caps_) {
+    gst_caps_unref(buffer_probe_caps_);
+    buffer_probe_caps_ = nullptr;
+  }
+
 }
 
 void GstEnginePipeline::set_output_device(const QString &output, const QVariant &device) {
@@ -352,6 +373,19 @@ bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_ur
   ebur128_loudness_normalizing_gain_db_ = ebur128_loudness_normalizing_gain_db;
   end_offset_nanosec_ = end_nanosec;
 
+  // The pipeline may already have been built ahead of time as a standby pipeline, see GstEngine::EnsureStandbyPipeline().
+  if (!InitPipeline(error)) return false;
+
+  g_object_set(G_OBJECT(pipeline_), "uri", gst_url.constData(), nullptr);
+
+  return true;
+
+}
+
+bool GstEnginePipeline::InitPipeline(QString &error) {
+
+  if (pipeline_) return true;
+
   guint version_major = 0, version_minor = 0, version_micro = 0, version_nano = 0;
   gst_plugins_base_version(&version_major, &version_minor, &version_micro, &version_nano);
   if (QVersionNumber::compare(QVersionNumber(static_cast<int>(version_major), static_cast<int>(version_minor)), QVersionNumber(1, 24)) >= 0) {
@@ -396,8 +430,6 @@ bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_ur
   flags &= ~0x00000010;
   g_object_set(G_OBJECT(pipeline_), "flags", flags, nullptr);
 
-  g_object_set(G_OBJECT(pipeline_), "uri", gst_url.constData(), nullptr);
-
   pipeline_is_connected_ = true;
 
   return true;
@@ -621,46 +653,22 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
     if (!equalizer_preamp_) {
       return false;
     }
-    equalizer_ = CreateElement(QStringLiteral("equalizer-nbands"), QStringLiteral("equalizer_nbands"), audiobin_, error);
+    equalizer_ = CreateElement(QStringLiteral("strawberryeq"), QStringLiteral("strawberryeq"), audiobin_, error);
     if (!equalizer_) {
       return false;
     }
-    // Setting the equalizer bands:
-    //
-    // GStreamer's GstIirEqualizerNBands sets up shelve filters for the first and last bands as corner cases.
-    // That was causing the "inverted slider" bug.
-    // As a workaround, we create two dummy bands at both ends of the spectrum.
-    // This causes the actual first and last adjustable bands to be implemented using band-pass filters.
-
-    g_object_set(G_OBJECT(equalizer_), "num-bands", kEqBandCount + 2, nullptr);
-
-    // Dummy first band (bandwidth 0, cutting below 20Hz):
-    GstObject *first_band = GST_OBJECT(gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer_), 0));
-    if (first_band) {
-      g_object_set(G_OBJECT(first_band), "freq", 20.0, "bandwidth", 0, "gain", 0.0F, nullptr);
-      g_object_unref(G_OBJECT(first_band));
-    }
+    // Unlike GStreamer's GstIirEqualizerNBands, strawberryeq uses plain peaking filters for all bands,
+    // so no dummy guard bands are needed at the ends of the spectrum.
 
-    // Dummy last band (bandwidth 0, cutting over 20KHz):
-    GstObject *last_band = GST_OBJECT(gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer_), kEqBandCount + 1));
-    if (last_band) {
-      g_object_set(G_OBJECT(last_band), "freq", 20000.0, "bandwidth", 0, "gain", 0.0F, nullptr);
-      g_object_unref(G_OBJECT(last_band));
-    }
+    gst_strawberryeq_set_num_bands(GST_STRAWBERRYEQ(equalizer_), kEqBandCount);
 
     int last_band_frequency = 0;
     for (int i = 0; i < kEqBandCount; ++i) {
-      const int index_in_eq = i + 1;
-      GstObject *band = GST_OBJECT(gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer_), index_in_eq));
-      if (band) {
-        const float frequency = static_cast<float>(kEqBandFrequencies[i]);
-        const float bandwidth = frequency - static_cast<float>(last_band_frequency);
-        last_band_frequency = static_cast<int>(frequency);
-        g_object_set(G_OBJECT(band), "freq", frequency, "bandwidth", bandwidth, "gain", 0.0F, nullptr);
-        g_object_unref(G_OBJECT(band));
-      }
-
-    }  // for
+      const double frequency = static_cast<double>(kEqBandFrequencies[i]);
+      const double bandwidth = frequency - static_cast<double>(last_band_frequency);
+      last_band_frequency = static_cast<int>(frequency);
+      gst_strawberryeq_set_band(GST_STRAWBERRYEQ(equalizer_), i, frequency, bandwidth, 0.0);
+    }
 
   }
 
@@ -735,6 +743,8 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
 
   g_object_set(G_OBJECT(audioqueue_), "use-buffering", true, nullptr);
 
+  buffer_duration_current_nanosec_ = buffer_duration_nanosec_;
+
   if (buffer_duration_nanosec_ > 0) {
     qLog(Debug) << "Setting buffer duration:" << buffer_duration_nanosec_ << "low watermark:" << buffer_low_watermark_ << "high watermark:" << buffer_high_watermark_;
     g_object_set(G_OBJECT(audioqueue_), "max-size-buffers", 0, nullptr);
@@ -808,8 +818,16 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
   }
 
   // Link fading volume element if enabled.
+  // Force floating point samples into the gain stages here, the volume element only has vectorized (ORC) paths for float and falls back to scalar code for the 24 and 32 bit integer formats,
+  // which is measurable on weak CPUs during crossfades with high resolution content.
   if (fading_enabled_ && volume_fading_) {
-    if (!gst_element_link(element_link, volume_fading_)) {
+    GstStaticCaps static_raw_fp_audio_caps = GST_STATIC_CAPS(
+      "audio/x-raw,"
+      "format = (string) { F32LE, F64LE }");
+    GstCaps *raw_fp_audio_caps = gst_static_caps_get(&static_raw_fp_audio_caps);
+    const bool link_filtered_result = gst_element_link_filtered(element_link, volume_fading_, raw_fp_audio_caps);
+    gst_caps_unref(raw_fp_audio_caps);
+    if (!link_filtered_result) {
       error = QLatin1String("Failed to link fading volume.");
       return false;
     }
@@ -1120,19 +1138,9 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
 
   GstEnginePipeline *instance = reinterpret_cast<GstEnginePipeline*>(self);
 
-  QString format;
-  int channels = 1;
-  int rate = 0;
-
-  GstCaps *caps = gst_pad_get_current_caps(pad);
-  if (caps) {
-    GstStructure *structure = gst_caps_get_structure(caps, 0);
-    if (structure) {
-      format = QString::fromUtf8(gst_structure_get_string(structure, "format"));
-      gst_structure_get_int(structure, "channels", &channels);
-      gst_structure_get_int(structure, "rate", &rate);
-    }
-    gst_caps_unref(caps);
+  if (!instance->first_buffer_traced_) {
+    instance->first_buffer_traced_ = true;
+    PlaybackTrace::Record("first audio buffer", instance->media_url_.toString());
   }
 
   GstBuffer *buf = gst_pad_probe_info_get_buffer(info);
@@ -1142,6 +1150,60 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
   quint64 duration = GST_BUFFER_DURATION(buf);
   qint64 end_time = static_cast<qint64>(start_time + duration);
 
+  // Calculate the end time of this buffer so we can stop playback if it's after the end time of this song.
+  if (instance->end_offset_nanosec_ > 0 && end_time > instance->end_offset_nanosec_) {
+    if (instance->has_next_valid_url() && instance->next_stream_url_ == instance->stream_url_ && instance->next_beginning_offset_nanosec_ == instance->end_offset_nanosec_) {
+      // The "next" song is actually the next segment of this file - so cheat and keep on playing, but just tell the Engine we've moved on.
+      instance->end_offset_nanosec_ = instance->next_end_offset_nanosec_;
+      instance->next_media_url_.clear();
+      instance->next_stream_url_.clear();
+      instance->next_gst_url_.clear();
+      instance->next_beginning_offset_nanosec_ = 0;
+      instance->next_end_offset_nanosec_ = 0;
+
+      // GstEngine will try to seek to the start of the new section, but we're already there so ignore it.
+      instance->ignore_next_seek_ = true;
+      emit instance->EndOfStreamReached(instance->id(), true);
+    }
+    else {
+      // There's no next song
+      emit instance->EndOfStreamReached(instance->id(), false);
+    }
+  }
+
+  QList<GstBufferConsumer*> consumers;
+  {
+    QMutexLocker l(&instance->buffer_consumers_mutex_);
+    consumers = instance->buffer_consumers_;
+  }
+
+  // Without consumers there is nothing to convert or fan out.
+  if (consumers.isEmpty()) {
+    return GST_PAD_PROBE_OK;
+  }
+
+  // The caps only change when the stream is renegotiated, so reuse the parsed format until a different caps object shows up instead of parsing it for every 20ms buffer.
+  GstCaps *caps = gst_pad_get_current_caps(pad);
+  if (caps) {
+    if (caps == instance->buffer_probe_caps_) {
+      gst_caps_unref(caps);
+    }
+    else {
+      GstStructure *structure = gst_caps_get_structure(caps, 0);
+      if (structure) {
+        instance->buffer_probe_format_ = QString::fromUtf8(gst_structure_get_string(structure, "format"));
+        gst_structure_get_int(structure, "channels", &instance->buffer_probe_channels_);
+        gst_structure_get_int(structure, "rate", &instance->buffer_probe_rate_);
+      }
+      if (instance->buffer_probe_caps_) gst_caps_unref(instance->buffer_probe_caps_);
+      instance->buffer_probe_caps_ = caps;
+    }
+  }
+
+  const QString format = instance->buffer_probe_format_;
+  const int channels = instance->buffer_probe_channels_;
+  const int rate = instance->buffer_probe_rate_;
+
   if (format.startsWith(QLatin1String("S16LE"))) {
     instance->logged_unsupported_analyzer_format_ = false;
   }
@@ -1240,12 +1302,7 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
     qLog(Error) << "Unsupported audio format for the analyzer" << format;
   }
 
-  QList<GstBufferConsumer*> consumers;
-  {
-    QMutexLocker l(&instance->buffer_consumers_mutex_);
-    consumers = instance->buffer_consumers_;
-  }
-
+  // Every consumer gets a reference to the same buffer, so the format conversion above happens at most once per buffer no matter how many consumers are registered.
   for (GstBufferConsumer *consumer : consumers) {
     gst_buffer_ref(buf);
     consumer->ConsumeBuffer(buf, instance->id(), format);
@@ -1255,27 +1312,6 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
     gst_buffer_unref(buf16);
   }
 
-  // Calculate the end time of this buffer so we can stop playback if it's after the end time of this song.
-  if (instance->end_offset_nanosec_ > 0 && end_time > instance->end_offset_nanosec_) {
-    if (instance->has_next_valid_url() && instance->next_stream_url_ == instance->stream_url_ && instance->next_beginning_offset_nanosec_ == instance->end_offset_nanosec_) {
-      // The "next" song is actually the next segment of this file - so cheat and keep on playing, but just tell the Engine we've moved on.
-      instance->end_offset_nanosec_ = instance->next_end_offset_nanosec_;
-      instance->next_media_url_.clear();
-      instance->next_stream_url_.clear();
-      instance->next_gst_url_.clear();
-      instance->next_beginning_offset_nanosec_ = 0;
-      instance->next_end_offset_nanosec_ = 0;
-
-      // GstEngine will try to seek to the start of the new section, but we're already there so ignore it.
-      instance->ignore_next_seek_ = true;
-      emit instance->EndOfStreamReached(instance->id(), true);
-    }
-    else {
-      // There's no next song
-      emit instance->EndOfStreamReached(instance->id(), false);
-    }
-  }
-
   return GST_PAD_PROBE_OK;
 
 }
@@ -1329,6 +1365,10 @@ GstBusSyncReply GstEnginePipeline::BusSyncCallback(GstBus *bus, GstMessage *msg,
       instance->BufferingMessageReceived(msg);
       break;
 
+    case GST_MESSAGE_QOS:
+      instance->QosMessageReceived(msg);
+      break;
+
     case GST_MESSAGE_STREAM_STATUS:
       instance->StreamStatusMessageReceived(msg);
       break;
@@ -1405,6 +1445,14 @@ void GstEnginePipeline::StreamStartMessageReceived() {
     next_beginning_offset_nanosec_ = 0;
     next_end_offset_nanosec_ = 0;
 
+    // The pre-decoded start of this track is in the queue now, drop the time limit back to normal.
+    if (next_predecode_headroom_added_) {
+      next_predecode_headroom_added_ = false;
+      if (buffer_duration_current_nanosec_ > 0 && audioqueue_) {
+        g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_duration_current_nanosec_, nullptr);
+      }
+    }
+
     emit EndOfStreamReached(id(), true);
   }
 
@@ -1575,6 +1623,8 @@ void GstEnginePipeline::StateChangedMessageReceived(GstMessage *msg) {
 
   qLog(Debug) << "Pipeline state changed from" << GstStateText(old_state) << "to" << GstStateText(new_state);
 
+  PlaybackTrace::Record("pipeline state changed", QStringLiteral("%1 -> %2").arg(GstStateText(old_state), GstStateText(new_state)));
+
   if (!pipeline_is_active_ && (new_state == GST_STATE_PAUSED || new_state == GST_STATE_PLAYING)) {
     qLog(Debug) << "Pipeline is active";
     pipeline_is_active_ = true;
@@ -1630,6 +1680,19 @@ void GstEnginePipeline::BufferingMessageReceived(GstMessage *msg) {
 
   if (percent == 0 && current_state == GST_STATE_PLAYING && !buffering_) {
     buffering_ = true;
+    ++buffer_underruns_;
+
+    // A buffer that keeps underrunning is too small for this stream, so double it (up to a cap) before refilling.
+    // Local files never underrun on this queue, so this only kicks in for network streams.
+    if (buffer_duration_current_nanosec_ > 0 && buffer_duration_current_nanosec_ < kAdaptiveBufferDurationMaxNanosec && !media_url_.isLocalFile()) {
+      buffer_duration_current_nanosec_ = qMin(buffer_duration_current_nanosec_ * 2, kAdaptiveBufferDurationMaxNanosec);
+      qLog(Info) << "Buffer underrun" << buffer_underruns_ << "on stream" << media_url_ << "- growing buffer to" << buffer_duration_current_nanosec_ / kNsecPerMsec << "ms";
+      g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_duration_current_nanosec_, nullptr);
+    }
+    else {
+      qLog(Info) << "Buffer underrun" << buffer_underruns_ << "on stream" << media_url_;
+    }
+
     emit BufferingStarted();
 
     SetState(GST_STATE_PAUSED);
@@ -1646,6 +1709,186 @@ void GstEnginePipeline::BufferingMessageReceived(GstMessage *msg) {
 
 }
 
+void GstEnginePipeline::QosMessageReceived(GstMessage *msg) {
+
+  // Elements post QoS messages when they drop or delay data, so sampling them into counters is effectively free and tells us which element is struggling.
+
+  gint64 jitter = 0;
+  gdouble proportion = 0.0;
+  gint quality = 0;
+  gst_message_parse_qos_values(msg, &jitter, &proportion, &quality);
+
+  GstFormat format = GST_FORMAT_UNDEFINED;
+  guint64 processed = 0;
+  guint64 dropped = 0;
+  gst_message_parse_qos_stats(msg, &format, &processed, &dropped);
+
+  const QString element = QString::fromUtf8(GST_MESSAGE_SRC_NAME(msg));
+
+  qLog(Debug) << "QoS from" << element << "jitter:" << jitter << "processed:" << processed << "dropped:" << dropped;
+
+  QMutexLocker l(&telemetry_mutex_);
+  qos_jitter_nanosec_ = jitter;
+  QosStats &stats = qos_stats_[element];
+  stats.processed = processed;
+  stats.dropped = dropped;
+
+}
+
+GstEnginePipeline::Telemetry GstEnginePipeline::telemetry() const {
+
+  Telemetry t;
+  t.buffer_underruns = buffer_underruns_;
+
+  {
+    QMutexLocker l(&telemetry_mutex_);
+    t.qos_jitter_nanosec = qos_jitter_nanosec_;
+    for (QHash<QString, QosStats>::const_iterator it = qos_stats_.constBegin(); it != qos_stats_.constEnd(); ++it) {
+      t.qos_processed_buffers += it.value().processed;
+      t.qos_dropped_buffers += it.value().dropped;
+      if (it.value().dropped > 0) {
+        t.qos_dropped_by_element.insert(it.key(), it.value().dropped);
+      }
+    }
+  }
+
+  if (audiosink_ && pipeline_is_active_) {
+    GstQuery *query = gst_query_new_latency();
+    if (gst_element_query(audiosink_, query)) {
+      gboolean live = false;
+      GstClockTime min_latency = 0;
+      GstClockTime max_latency = 0;
+      gst_query_parse_latency(query, &live, &min_latency, &max_latency);
+      t.sink_latency_nanosec = static_cast<qint64>(min_latency);
+    }
+    gst_query_unref(query);
+  }
+
+  return t;
+
+}
+
+void GstEnginePipeline::AppendElementSnapshot(GstElement *element, const int depth, QStringList &lines) {
+
+  const QString indent(depth * 2, QLatin1Char(' '));
+
+  GstState state = GST_STATE_NULL;
+  GstState pending = GST_STATE_VOID_PENDING;
+  gst_element_get_state(element, &state, &pending, 0);
+
+  GstElementFactory *factory = gst_element_get_factory(element);
+  const QString factory_name = factory ? QString::fromUtf8(gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory))) : QStringLiteral("?");
+
+  QString line = indent + QString::fromUtf8(GST_ELEMENT_NAME(element)) + QStringLiteral(" (") + factory_name + QStringLiteral(") state=") + QString::fromUtf8(gst_element_state_get_name(state));
+  if (pending != GST_STATE_VOID_PENDING) {
+    line += QStringLiteral(" pending=") + QString::fromUtf8(gst_element_state_get_name(pending));
+  }
+  lines << line;
+
+  // Queue fill levels, for spotting which side of a queue is starving.
+  if (g_object_class_find_property(G_OBJECT_GET_CLASS(element), "current-level-bytes")) {
+    guint current_level_buffers = 0;
+    guint current_level_bytes = 0;
+    guint64 current_level_time = 0;
+    guint max_size_buffers = 0;
+    guint max_size_bytes = 0;
+    guint64 max_size_time = 0;
+    g_object_get(G_OBJECT(element), "current-level-buffers", &current_level_buffers, "current-level-bytes", &current_level_bytes, "current-level-time", &current_level_time, "max-size-buffers", &max_size_buffers, "max-size-bytes", &max_size_bytes, "max-size-time", &max_size_time, nullptr);
+    lines << indent + QStringLiteral("  fill: %1/%2 buffers, %3/%4 bytes, %5/%6 ms").arg(current_level_buffers).arg(max_size_buffers).arg(current_level_bytes).arg(max_size_bytes).arg(current_level_time / 1000000).arg(max_size_time / 1000000);
+  }
+
+  // Negotiated caps on every pad.
+  GstIterator *pad_iterator = gst_element_iterate_pads(element);
+  GValue value = G_VALUE_INIT;
+  bool done = false;
+  while (!done) {
+    switch (gst_iterator_next(pad_iterator, &value)) {
+      case GST_ITERATOR_OK:{
+        GstPad *pad = GST_PAD(g_value_get_object(&value));
+        GstCaps *caps = gst_pad_get_current_caps(pad);
+        if (caps) {
+          gchar *caps_str = gst_caps_to_string(caps);
+          lines << indent + QStringLiteral("  pad %1 (%2): %3").arg(QString::fromUtf8(GST_PAD_NAME(pad)), GST_PAD_IS_SRC(pad) ? QStringLiteral("src") : QStringLiteral("sink"), QString::fromUtf8(caps_str));
+          g_free(caps_str);
+          gst_caps_unref(caps);
+        }
+        g_value_reset(&value);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync(pad_iterator);
+        break;
+      case GST_ITERATOR_ERROR:
+      case GST_ITERATOR_DONE:
+        done = true;
+        break;
+    }
+  }
+  g_value_unset(&value);
+  gst_iterator_free(pad_iterator);
+
+  if (GST_IS_BIN(element)) {
+    GstIterator *element_iterator = gst_bin_iterate_elements(GST_BIN(element));
+    GValue child_value = G_VALUE_INIT;
+    done = false;
+    while (!done) {
+      switch (gst_iterator_next(element_iterator, &child_value)) {
+        case GST_ITERATOR_OK:
+          AppendElementSnapshot(GST_ELEMENT(g_value_get_object(&child_value)), depth + 1, lines);
+          g_value_reset(&child_value);
+          break;
+        case GST_ITERATOR_RESYNC:
+          gst_iterator_resync(element_iterator);
+          break;
+        case GST_ITERATOR_ERROR:
+        case GST_ITERATOR_DONE:
+          done = true;
+          break;
+      }
+    }
+    g_value_unset(&child_value);
+    gst_iterator_free(element_iterator);
+  }
+
+}
+
+QString GstEnginePipeline::DebugSnapshot() const {
+
+  if (!pipeline_) return QString();
+
+  QStringList lines;
+
+  lines << QStringLiteral("Media URL: %1").arg(media_url_.toString());
+  lines << QStringLiteral("Stream URL: %1").arg(stream_url_.toString());
+
+  GstClock *clock = gst_pipeline_get_clock(GST_PIPELINE(pipeline_));
+  if (clock) {
+    lines << QStringLiteral("Clock: %1").arg(QString::fromUtf8(GST_OBJECT_NAME(clock)));
+    gst_object_unref(clock);
+  }
+
+  GstQuery *query = gst_query_new_latency();
+  if (gst_element_query(pipeline_, query)) {
+    gboolean live = false;
+    GstClockTime min_latency = 0;
+    GstClockTime max_latency = 0;
+    gst_query_parse_latency(query, &live, &min_latency, &max_latency);
+    lines << QStringLiteral("Latency: live=%1 min=%2 ms max=%3 ms").arg(live ? QStringLiteral("yes") : QStringLiteral("no")).arg(static_cast<double>(min_latency) / 1e6, 0, 'f', 1).arg(GST_CLOCK_TIME_IS_VALID(max_latency) ? QString::number(static_cast<double>(max_latency) / 1e6, 'f', 1) : QStringLiteral("inf"));
+  }
+  gst_query_unref(query);
+
+  gint64 current_position = 0;
+  if (gst_element_query_position(pipeline_, GST_FORMAT_TIME, &current_position)) {
+    lines << QStringLiteral("Position: %1 s").arg(static_cast<double>(current_position) / 1e9, 0, 'f', 1);
+  }
+
+  lines << QString();
+  AppendElementSnapshot(pipeline_, 0, lines);
+
+  return lines.join(QLatin1Char('\n'));
+
+}
+
 qint64 GstEnginePipeline::position() const {
 
   if (pipeline_is_active_) {
@@ -1682,6 +1925,10 @@ GstState GstEnginePipeline::state() const {
 QFuture<GstStateChangeReturn> GstEnginePipeline::SetState(const GstState state) {
 
   qLog(Debug) << "Setting pipeline state to" << GstStateText(state);
+
+  PlaybackTrace::Record("pipeline set state", GstStateText(state));
+  if (state == GST_STATE_PLAYING) first_buffer_traced_ = false;
+
   return QtConcurrent::run(&set_state_threadpool_, &gst_element_set_state, pipeline_, state);
 
 }
@@ -1721,6 +1968,24 @@ bool GstEnginePipeline::Seek(const qint64 nanosec) {
 
 }
 
+bool GstEnginePipeline::SeekFast(const qint64 nanosec) {
+
+  // Used for coarse scrubbing feedback: seeking to the nearest keyframe skips the accurate decode from the preceding keyframe to the exact sample,
+  // which is what makes flushing seeks take seconds in long files and on network sources.
+  // The engine always follows up with an accurate Seek() once scrubbing settles, so the special cases (pending seeks, queued next URL) are left to that.
+
+  if (ignore_next_seek_ || !pipeline_is_connected_ || !pipeline_is_active_ || next_uri_set_) {
+    return true;
+  }
+
+  last_known_position_ns_ = nanosec;
+
+  qLog(Debug) << "Fast seeking to" << nanosec;
+
+  return gst_element_seek_simple(pipeline_, GST_FORMAT_TIME, static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_NEAREST), nanosec);
+
+}
+
 void GstEnginePipeline::SeekQueued(const qint64 nanosec) {
 
   QMetaObject::invokeMethod(this, "Seek", Qt::QueuedConnection, Q_ARG(qint64, nanosec));
@@ -1814,11 +2079,7 @@ void GstEnginePipeline::UpdateEqualizer() {
       gain *= 0.12F;
     }
 
-    const int index_in_eq = i + 1;
-    // Offset because of the first dummy band we created.
-    GstObject *band = GST_OBJECT(gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer_), index_in_eq));
-    g_object_set(G_OBJECT(band), "gain", gain, nullptr);
-    g_object_unref(G_OBJECT(band));
+    gst_strawberryeq_set_band_gain(GST_STRAWBERRYEQ(equalizer_), i, static_cast<double>(gain));
   }
 
   // Update preamp
@@ -1933,6 +2194,15 @@ void GstEnginePipeline::SetNextUrl() {
     qLog(Debug) << "Setting next URL to" << next_gst_url_;
     g_object_set(G_OBJECT(pipeline_), "uri", next_gst_url_.constData(), nullptr);
     about_to_finish_ = false;
+
+    // The queue holds the remaining seconds of the current track at this point, so without extra room
+    // the new decoder would sit idle until playback drains it and then cold-start right at the transition.
+    // Growing the time limit lets it decode the first seconds of the upcoming track ahead of time;
+    // the limit is restored in StreamStartMessageReceived() once the new stream is playing.
+    if (buffer_duration_current_nanosec_ > 0 && audioqueue_) {
+      g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_duration_current_nanosec_ + kNextTrackPreDecodeNanosec, nullptr);
+      next_predecode_headroom_added_ = true;
+    }
   }
 
 }
@@ -37,7 +37,10 @@
 #include <QTimeLine>
 #include <QEasingCurve>
 #include <QBasicTimer>
+#include <QHash>
 #include <QList>
+#include <QMap>
+#include <QStringList>
 #include <QByteArray>
 #include <QVariant>
 #include <QString>
@@ -82,6 +85,8 @@ class GstEnginePipeline : public QObject {
 
   // Creates the pipeline, returns false on error
   bool InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, const double ebur128_loudness_normalizing_gain_db, QString &error);
+  // Builds the pipeline and audiobin without assigning a URL yet, so a standby pipeline can be prepared ahead of a track change. Called by InitFromUrl() when it hasn't been done already.
+  bool InitPipeline(QString &error);
 
   // GstBufferConsumers get fed audio data.  Thread-safe.
   void AddBufferConsumer(GstBufferConsumer *consumer);
@@ -92,6 +97,8 @@ class GstEnginePipeline : public QObject {
   Q_INVOKABLE QFuture<GstStateChangeReturn> SetState(const GstState state);
   void SetStateDelayed(const GstState state);
   Q_INVOKABLE bool Seek(const qint64 nanosec);
+  // Cheap keyframe-aligned seek for coarse scrubbing, to be followed by an accurate Seek() once scrubbing settles.
+  bool SeekFast(const qint64 nanosec);
   void SeekQueued(const qint64 nanosec);
   void SeekDelayed(const qint64 nanosec);
   void SetEBUR128LoudnessNormalizingGain_dB(const double ebur128_loudness_normalizing_gain_db);
@@ -129,6 +136,21 @@ class GstEnginePipeline : public QObject {
   // Don't allow the user to change the playback state (playing/paused) while the pipeline is buffering.
   bool is_buffering() const { return buffering_; }
 
+  // Playback telemetry sampled from bus/QoS messages, so glitches can be attributed to an element without attaching a debugger.
+  struct Telemetry {
+    quint64 qos_processed_buffers = 0;
+    quint64 qos_dropped_buffers = 0;
+    qint64 qos_jitter_nanosec = 0;
+    int buffer_underruns = 0;
+    qint64 sink_latency_nanosec = -1;
+    QMap<QString, quint64> qos_dropped_by_element;
+  };
+  Telemetry telemetry() const;
+
+  // On-demand diagnostic snapshot for support: the element graph with negotiated caps,
+  // queue fill levels and clock/latency figures, without needing GST_DEBUG.
+  QString DebugSnapshot() const;
+
   QByteArray redirect_url() const { return redirect_url_; }
 
   QString source_device() const { return source_device_; }
@@ -157,6 +179,8 @@ class GstEnginePipeline : public QObject {
  private:
   static QString GstStateText(const GstState state);
   GstElement *CreateElement(const QString &factory_name, const QString &name, GstElement *bin, QString &error) const;
+
+  static void AppendElementSnapshot(GstElement *element, const int depth, QStringList &lines);
   bool InitAudioBin(QString &error);
   void SetupVolume(GstElement *element);
 
@@ -179,6 +203,7 @@ class GstEnginePipeline : public QObject {
   void ElementMessageReceived(GstMessage *msg);
   void StateChangedMessageReceived(GstMessage *msg);
   void BufferingMessageReceived(GstMessage *msg);
+  void QosMessageReceived(GstMessage *msg);
   void StreamStatusMessageReceived(GstMessage *msg);
   void StreamStartMessageReceived();
 
@@ -194,6 +219,8 @@ class GstEnginePipeline : public QObject {
 
  private:
   static const int kGstStateTimeoutNanosecs;
+  static const quint64 kAdaptiveBufferDurationMaxNanosec;
+  static const quint64 kNextTrackPreDecodeNanosec;
   static const int kFaderFudgeMsec;
   static const int kEqBandCount;
   static const int kEqBandFrequencies[];
@@ -234,9 +261,22 @@ class GstEnginePipeline : public QObject {
 
   // Buffering
   quint64 buffer_duration_nanosec_;
+  // The buffer duration currently set on the queue. Starts out as buffer_duration_nanosec_ and is grown on underruns when adaptive buffering kicks in.
+  quint64 buffer_duration_current_nanosec_;
   double buffer_low_watermark_;
   double buffer_high_watermark_;
   bool buffering_;
+  int buffer_underruns_;
+
+  // Per-element QoS statistics harvested from bus messages.
+  // Guarded by telemetry_mutex_ since they're written from GStreamer threads and read by telemetry().
+  struct QosStats {
+    quint64 processed = 0;
+    quint64 dropped = 0;
+  };
+  mutable QMutex telemetry_mutex_;
+  QHash<QString, QosStats> qos_stats_;
+  qint64 qos_jitter_nanosec_;
 
   // Proxy
   QString proxy_address_;
@@ -305,6 +345,9 @@ class GstEnginePipeline : public QObject {
   // Complete the transition to the next song when it starts playing
   bool next_uri_set_;
   bool next_uri_reset_;
+  // Whether the audio queue was temporarily grown when the next URL was set, so the first seconds of the
+  // upcoming track could be decoded ahead of the transition. Restored when the new stream starts.
+  bool next_predecode_headroom_added_;
 
   double ebur128_loudness_normalizing_gain_db_;
   bool volume_set_;
@@ -345,6 +388,15 @@ class GstEnginePipeline : public QObject {
 
   bool logged_unsupported_analyzer_format_;
 
+  // Cleared when a transition to playing is requested, so the playback trace records the first buffer that follows it.
+  bool first_buffer_traced_;
+
+  // The caps last seen by BufferProbeCallback() and the format parsed out of them, kept so the parse only happens when the stream is renegotiated.
+  GstCaps *buffer_probe_caps_;
+  QString buffer_probe_format_;
+  int buffer_probe_channels_;
+  int buffer_probe_rate_;
+
   bool about_to_finish_;
 
 };
@@ -30,18 +30,22 @@
 #include <QCoreApplication>
 #include <QStandardPaths>
 #include <QtConcurrent>
+#include <QMutexLocker>
 #include <QString>
 #include <QDir>
 #include <QFile>
 #include <QAbstractEventDispatcher>
 
 #include "core/logging.h"
+#include "core/startuptimeline.h"
 #include "utilities/envutils.h"
 
 #ifdef HAVE_MOODBAR
 #  include "ext/gstmoodbar/gstmoodbarplugin.h"
 #endif
 
+#include "ext/gstequalizer/gstequalizerplugin.h"
+
 #include "gststartup.h"
 
 GThread *GstStartup::kGThread = nullptr;
@@ -58,9 +62,11 @@ gpointer GstStartup::GLibMainLoopThreadFunc(gpointer) {
 
 }
 
-GstStartup::GstStartup(QObject *parent) : QObject(parent) {
+GstStartup::GstStartup(QObject *parent) : QObject(parent), initialize_started_(false) {
 
-  initializing_ = QtConcurrent::run(&GstStartup::InitializeGStreamer);
+  // Don't initialize GStreamer here: the registry scan would compete with the rest of the startup path for CPU and disk.
+  // Instead it's kicked off once the event loop is running (i.e. the UI is up), or by the first caller that actually needs GStreamer, whichever comes first.
+  QMetaObject::invokeMethod(this, &GstStartup::InitializeAsync, Qt::QueuedConnection);
 
   const QMetaObject *mo = QAbstractEventDispatcher::instance(qApp->thread())->metaObject();
   if (mo && strcmp(mo->className(), "QEventDispatcherGlib") != 0 && strcmp(mo->superClass()->className(), "QEventDispatcherGlib") != 0) {
@@ -73,8 +79,29 @@ GstStartup::~GstStartup() {
   if (kGThread) g_thread_unref(kGThread);
 }
 
+void GstStartup::InitializeAsync() {
+
+  QMutexLocker l(&mutex_);
+
+  if (initialize_started_) return;
+  initialize_started_ = true;
+
+  initializing_ = QtConcurrent::run(&GstStartup::InitializeGStreamer);
+
+}
+
+void GstStartup::EnsureInitialized() {
+
+  InitializeAsync();
+
+  initializing_.waitForFinished();
+
+}
+
 void GstStartup::InitializeGStreamer() {
 
+  const StartupTimeline::Phase phase("GstStartup::InitializeGStreamer");
+
   SetEnvironment();
 
   gst_init(nullptr, nullptr);
@@ -84,6 +111,8 @@ void GstStartup::InitializeGStreamer() {
   gstfastspectrum_register_static();
 #endif
 
+  gststrawberryeq_register_static();
+
 #ifdef Q_OS_WIN32
   // Use directsoundsink as the default sink on Windows.
   // wasapisink does not support device switching and wasapi2sink has issues, see #1227.
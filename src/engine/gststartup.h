@@ -28,6 +28,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QFuture>
+#include <QMutex>
 
 class GstStartup : public QObject {
   Q_OBJECT
@@ -36,7 +37,13 @@ class GstStartup : public QObject {
   explicit GstStartup(QObject *parent = nullptr);
   ~GstStartup() override;
 
-  void EnsureInitialized() { initializing_.waitForFinished(); }
+  // Blocks until GStreamer is initialized, starting the initialization if it hasn't been already.
+  void EnsureInitialized();
+
+ private slots:
+  // Starts the initialization on a background thread without waiting for it.
+  // Scheduled for the first event loop iteration so the registry scan overlaps the UI instead of competing with the startup path.
+  void InitializeAsync();
 
  private:
   static GThread *kGThread;
@@ -45,6 +52,8 @@ class GstStartup : public QObject {
   static void InitializeGStreamer();
   static void SetEnvironment();
 
+  QMutex mutex_;
+  bool initialize_started_;
   QFuture<void> initializing_;
 };
 
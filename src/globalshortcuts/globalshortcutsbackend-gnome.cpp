@@ -106,7 +106,7 @@ void GlobalShortcutsBackendGnome::DoUnregister() {
 
   qLog(Debug) << "Unregister";
 
-  if (!IsAvailable() || !interface_ || !is_connected_) return;
+  if (!IsAvailableCached() || !interface_ || !is_connected_) return;
 
   is_connected_ = false;
 
@@ -54,6 +54,16 @@ QString GlobalShortcutsBackend::name() const {
 
 }
 
+bool GlobalShortcutsBackend::IsAvailableCached() const {
+
+  if (!available_.has_value()) {
+    available_ = IsAvailable();
+  }
+
+  return available_.value();
+
+}
+
 bool GlobalShortcutsBackend::Register() {
 
   bool ret = DoRegister();
@@ -23,6 +23,8 @@
 
 #include "config.h"
 
+#include <optional>
+
 #include <QObject>
 #include <QString>
 
@@ -49,6 +51,9 @@ class GlobalShortcutsBackend : public QObject {
 
   virtual bool IsAvailable() const = 0;
 
+  // The availability probes for the D-Bus backends are blocking round trips, so the result is cached for the session.
+  bool IsAvailableCached() const;
+
   bool Register();
   void Unregister();
 
@@ -64,6 +69,9 @@ class GlobalShortcutsBackend : public QObject {
   GlobalShortcutsManager *manager_;
   Type type_;
   bool active_;
+
+ private:
+  mutable std::optional<bool> available_;
 };
 
 #endif  // GLOBALSHORTCUTSBACKEND_H
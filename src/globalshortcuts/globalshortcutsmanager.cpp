@@ -99,7 +99,8 @@ GlobalShortcutsManager::GlobalShortcutsManager(QWidget *parent) : QWidget(parent
   backends_ << new GlobalShortcutsBackendX11(this, this);
 #endif
 
-  ReloadSettings();
+  // Backend registration probes the session bus for KDE/GNOME/MATE with blocking calls, so defer it until the event loop is running instead of blocking startup.
+  QMetaObject::invokeMethod(this, &GlobalShortcutsManager::ReloadSettings, Qt::QueuedConnection);
 
 }
 
@@ -199,7 +200,7 @@ bool GlobalShortcutsManager::IsX11Available() {
 bool GlobalShortcutsManager::Register() {
 
   for (GlobalShortcutsBackend *backend : std::as_const(backends_)) {
-    if (backend->IsAvailable() && backends_enabled_.contains(backend->type())) {
+    if (backends_enabled_.contains(backend->type()) && backend->IsAvailableCached()) {
       return backend->Register();
     }
   }
@@ -38,6 +38,8 @@ constexpr char kLyricsStart[] = "<!-- Usage of azlyrics.com content by any third
 AzLyricsComLyricsProvider::AzLyricsComLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : HtmlLyricsProvider(QStringLiteral("azlyrics.com"), true, QLatin1String(kStartTag), QLatin1String(kEndTag), QLatin1String(kLyricsStart), false, network, parent) {}
 
+QUrl AzLyricsComLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrl)); }
+
 QUrl AzLyricsComLyricsProvider::Url(const LyricsSearchRequest &request) {
 
   return QUrl(QLatin1String(kUrl) + StringFixup(request.artist) + QLatin1Char('/') + StringFixup(request.title) + QStringLiteral(".html"));
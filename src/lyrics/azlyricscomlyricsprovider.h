@@ -36,6 +36,8 @@ class AzLyricsComLyricsProvider : public HtmlLyricsProvider {
  public:
   explicit AzLyricsComLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
 
+  QUrl ApiUrl() const override;
+
  protected:
   QUrl Url(const LyricsSearchRequest &request) override;
 
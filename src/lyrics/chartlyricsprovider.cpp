@@ -54,6 +54,8 @@ ChartLyricsProvider::~ChartLyricsProvider() {
 
 }
 
+QUrl ChartLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrlSearch)); }
+
 bool ChartLyricsProvider::StartSearch(const int id, const LyricsSearchRequest &request) {
 
   QUrlQuery url_query;
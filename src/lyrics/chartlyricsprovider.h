@@ -41,6 +41,7 @@ class ChartLyricsProvider : public LyricsProvider {
   explicit ChartLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~ChartLyricsProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const int id, const LyricsSearchRequest &request) override;
   void CancelSearch(int id) override;
 
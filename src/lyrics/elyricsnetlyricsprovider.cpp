@@ -38,6 +38,8 @@ constexpr char kLyricsStart[] = "<div id='inlyr'>";
 ElyricsNetLyricsProvider::ElyricsNetLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : HtmlLyricsProvider(QStringLiteral("elyrics.net"), true, QLatin1String(kStartTag), QLatin1String(kEndTag), QLatin1String(kLyricsStart), false, network, parent) {}
 
+QUrl ElyricsNetLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrl)); }
+
 QUrl ElyricsNetLyricsProvider::Url(const LyricsSearchRequest &request) {
 
   return QUrl(QLatin1String(kUrl) + request.artist[0].toLower() + QLatin1Char('/') + StringFixup(request.artist) + QLatin1String("-lyrics/") + StringFixup(request.title) + QLatin1String("-lyrics.html"));
@@ -36,6 +36,8 @@ class ElyricsNetLyricsProvider : public HtmlLyricsProvider {
  public:
   explicit ElyricsNetLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
 
+  QUrl ApiUrl() const override;
+
  protected:
   QUrl Url(const LyricsSearchRequest &request) override;
 
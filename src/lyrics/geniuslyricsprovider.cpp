@@ -290,6 +290,8 @@ void GeniusLyricsProvider::AccessTokenRequestFinished(QNetworkReply *reply) {
 
 }
 
+QUrl GeniusLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrlSearch)); }
+
 bool GeniusLyricsProvider::StartSearch(const int id, const LyricsSearchRequest &request) {
 
   if (access_token_.isEmpty()) return false;
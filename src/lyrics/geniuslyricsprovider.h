@@ -53,6 +53,7 @@ class GeniusLyricsProvider : public JsonLyricsProvider {
   void Authenticate() override;
   void Deauthenticate() override { access_token_.clear(); }
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const int id, const LyricsSearchRequest &request) override;
   void CancelSearch(const int id) override;
 
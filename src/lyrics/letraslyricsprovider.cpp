@@ -39,6 +39,8 @@ constexpr char kLyricsStart[] = "<div id=\"letra-cnt\">";
 LetrasLyricsProvider::LetrasLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : HtmlLyricsProvider(QStringLiteral("letras.mus.br"), true, QLatin1String(kStartTag), QLatin1String(kEndTag), QLatin1String(kLyricsStart), false, network, parent) {}
 
+QUrl LetrasLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrl)); }
+
 QUrl LetrasLyricsProvider::Url(const LyricsSearchRequest &request) {
 
   return QUrl(QLatin1String(kUrl) + QLatin1String("?musica=") + StringFixup(request.artist) + QLatin1String("&artista=") + StringFixup(request.title));
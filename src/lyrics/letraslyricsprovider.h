@@ -36,6 +36,8 @@ class LetrasLyricsProvider : public HtmlLyricsProvider {
  public:
   explicit LetrasLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
 
+  QUrl ApiUrl() const override;
+
  protected:
   QUrl Url(const LyricsSearchRequest &request) override;
 
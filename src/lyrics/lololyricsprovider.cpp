@@ -54,6 +54,8 @@ LoloLyricsProvider::~LoloLyricsProvider() {
 
 }
 
+QUrl LoloLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrlSearch)); }
+
 bool LoloLyricsProvider::StartSearch(const int id, const LyricsSearchRequest &request) {
 
   QUrlQuery url_query;
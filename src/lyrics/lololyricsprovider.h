@@ -42,6 +42,7 @@ class LoloLyricsProvider : public LyricsProvider {
   explicit LoloLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~LoloLyricsProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const int id, const LyricsSearchRequest &request) override;
   void CancelSearch(const int id) override;
 
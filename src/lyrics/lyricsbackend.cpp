@@ -0,0 +1,81 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QObject>
+#include <QMutexLocker>
+#include <QString>
+#include <QDateTime>
+#include <QSqlDatabase>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "lyricsbackend.h"
+
+LyricsBackend::LyricsBackend(SharedPtr<Database> db, QObject *parent)
+    : QObject(parent),
+      db_(db) {}
+
+bool LyricsBackend::GetLyrics(const QString &artist, const QString &title, CachedLyrics &cached) {
+
+  if (artist.isEmpty() || title.isEmpty()) return false;
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("SELECT provider, lyrics, fetchtime FROM lyrics WHERE artist = :artist COLLATE NOCASE AND title = :title COLLATE NOCASE"));
+  q.BindValue(QStringLiteral(":artist"), artist);
+  q.BindValue(QStringLiteral(":title"), title);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return false;
+  }
+
+  if (!q.next()) return false;
+
+  cached.provider = q.value(0).toString();
+  cached.lyrics = q.value(1).toString();
+  cached.fetchtime = q.value(2).toLongLong();
+
+  return !cached.lyrics.isEmpty();
+
+}
+
+void LyricsBackend::AddLyrics(const QString &artist, const QString &title, const QString &provider, const QString &lyrics) {
+
+  if (artist.isEmpty() || title.isEmpty() || lyrics.isEmpty()) return;
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("INSERT OR REPLACE INTO lyrics (artist, title, provider, lyrics, fetchtime) VALUES (:artist, :title, :provider, :lyrics, :fetchtime)"));
+  q.BindValue(QStringLiteral(":artist"), artist);
+  q.BindValue(QStringLiteral(":title"), title);
+  q.BindValue(QStringLiteral(":provider"), provider);
+  q.BindValue(QStringLiteral(":lyrics"), lyrics);
+  q.BindValue(QStringLiteral(":fetchtime"), QDateTime::currentSecsSinceEpoch());
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+  }
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LYRICSBACKEND_H
+#define LYRICSBACKEND_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QObject>
+#include <QString>
+
+#include "core/shared_ptr.h"
+
+class Database;
+
+// Persistent cache with the lyrics fetched from the providers, keyed by artist and title,
+// so replaying a song never asks the network again.
+class LyricsBackend : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit LyricsBackend(SharedPtr<Database> db, QObject *parent = nullptr);
+
+  struct CachedLyrics {
+    CachedLyrics() : fetchtime(0) {}
+    QString provider;
+    QString lyrics;
+    qint64 fetchtime;
+  };
+
+  // Returns true and fills cached when lyrics for the song are stored, matching case-insensitively.
+  bool GetLyrics(const QString &artist, const QString &title, CachedLyrics &cached);
+  void AddLyrics(const QString &artist, const QString &title, const QString &provider, const QString &lyrics);
+
+ private:
+  Q_DISABLE_COPY(LyricsBackend)
+
+  SharedPtr<Database> db_;
+};
+
+#endif  // LYRICSBACKEND_H
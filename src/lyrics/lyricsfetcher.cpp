@@ -28,6 +28,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/song.h"
+#include "lyricsbackend.h"
 #include "lyricsfetcher.h"
 #include "lyricsfetchersearch.h"
 #include "lyricssearchrequest.h"
@@ -37,9 +38,10 @@ using namespace std::chrono_literals;
 
 const int LyricsFetcher::kMaxConcurrentRequests = 5;
 
-LyricsFetcher::LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, QObject *parent)
+LyricsFetcher::LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, SharedPtr<LyricsBackend> lyrics_backend, QObject *parent)
     : QObject(parent),
       lyrics_providers_(lyrics_providers),
+      lyrics_backend_(lyrics_backend),
       next_id_(0),
       request_starter_(new QTimer(this)) {
 
@@ -59,6 +61,17 @@ quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QStrin
   Request request;
   request.id = ++next_id_;
   request.search_request = search_request;
+
+  // Consult the persistent cache before asking any provider, so replays and context pane visits don't hit the network.
+  if (lyrics_backend_) {
+    LyricsBackend::CachedLyrics cached;
+    if (lyrics_backend_->GetLyrics(search_request.artist, search_request.title, cached)) {
+      const quint64 id = request.id;
+      QTimer::singleShot(0, this, [this, id, cached]() { emit LyricsFetched(id, cached.provider, cached.lyrics); });
+      return request.id;
+    }
+  }
+
   AddRequest(request);
 
   return request.id;
@@ -125,6 +138,11 @@ void LyricsFetcher::SingleLyricsFetched(const quint64 request_id, const QString
   if (!active_requests_.contains(request_id)) return;
 
   LyricsFetcherSearch *search = active_requests_.take(request_id);
+
+  if (lyrics_backend_ && !lyrics.isEmpty()) {
+    lyrics_backend_->AddLyrics(search->request().artist, search->request().title, provider, lyrics);
+  }
+
   search->deleteLater();
   emit LyricsFetched(request_id, provider, lyrics);
 
@@ -37,6 +37,7 @@
 #include "lyricssearchresult.h"
 
 class QTimer;
+class LyricsBackend;
 class LyricsProviders;
 class LyricsFetcherSearch;
 
@@ -44,7 +45,7 @@ class LyricsFetcher : public QObject {
   Q_OBJECT
 
  public:
-  explicit LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, QObject *parent = nullptr);
+  explicit LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, SharedPtr<LyricsBackend> lyrics_backend, QObject *parent = nullptr);
   ~LyricsFetcher() override {}
 
   struct Request {
@@ -72,6 +73,7 @@ class LyricsFetcher : public QObject {
   static const int kMaxConcurrentRequests;
 
   SharedPtr<LyricsProviders> lyrics_providers_;
+  SharedPtr<LyricsBackend> lyrics_backend_;
   quint64 next_id_;
 
   QQueue<Request> queued_requests_;
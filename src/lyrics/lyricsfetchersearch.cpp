@@ -37,19 +37,40 @@
 const int LyricsFetcherSearch::kSearchTimeoutMs = 3000;
 const int LyricsFetcherSearch::kGoodLyricsLength = 60;
 const float LyricsFetcherSearch::kHighScore = 2.5;
+// A result at least this good stops the search after a short settle delay instead of waiting for every provider.
+const float LyricsFetcherSearch::kAcceptableScore = 1.5;
+const int LyricsFetcherSearch::kAcceptableSettleMs = 500;
+// How many providers are raced immediately; the rest only start if the first wave hasn't answered within the delay.
+const int LyricsFetcherSearch::kImmediateProviders = 2;
+const int LyricsFetcherSearch::kSecondWaveDelayMs = 500;
 
 LyricsFetcherSearch::LyricsFetcherSearch(const quint64 id, const LyricsSearchRequest &request, QObject *parent)
     : QObject(parent),
       id_(id),
       request_(request),
+      settle_timer_armed_(false),
       cancel_requested_(false) {
 
-  QTimer::singleShot(kSearchTimeoutMs, this, &LyricsFetcherSearch::TerminateSearch);
+  QTimer::singleShot(kSearchTimeoutMs, this, &LyricsFetcherSearch::TimeoutSearch);
+
+}
+
+void LyricsFetcherSearch::TimeoutSearch() {
+
+  // Count the providers that never answered as failures, so slow providers lose their head start in future searches.
+  const QList<int> ids = pending_requests_.keys();
+  for (const int id : ids) {
+    pending_requests_.value(id)->RecordSearchResult(search_timer_.elapsed() - request_started_ms_.value(id), false);
+  }
+
+  TerminateSearch();
 
 }
 
 void LyricsFetcherSearch::TerminateSearch() {
 
+  queued_providers_.clear();
+
   const QList<int> keys = pending_requests_.keys();
   for (const int id : keys) {
     pending_requests_.take(id)->CancelSearch(id);
@@ -66,20 +87,58 @@ void LyricsFetcherSearch::Start(SharedPtr<LyricsProviders> lyrics_providers) {
     return;
   }
 
+  lyrics_providers_ = lyrics_providers;
+  search_timer_.start();
+
   QList<LyricsProvider*> lyrics_providers_sorted = lyrics_providers->List();
   std::stable_sort(lyrics_providers_sorted.begin(), lyrics_providers_sorted.end(), ProviderCompareOrder);
 
   for (LyricsProvider *provider : std::as_const(lyrics_providers_sorted)) {
     if (!provider->is_enabled() || !provider->IsAuthenticated()) continue;
-    QObject::connect(provider, &LyricsProvider::SearchFinished, this, &LyricsFetcherSearch::ProviderSearchFinished);
-    const int id = lyrics_providers->NextId();
-    const bool success = provider->StartSearch(id, request_);
-    if (success) {
-      pending_requests_.insert(id, provider);
+    if (pending_requests_.count() < kImmediateProviders) {
+      StartProvider(provider);
+    }
+    else {
+      queued_providers_ << provider;
     }
   }
 
-  if (pending_requests_.isEmpty()) TerminateSearch();
+  if (pending_requests_.isEmpty()) {
+    if (queued_providers_.isEmpty()) {
+      TerminateSearch();
+      return;
+    }
+    StartQueuedProviders();
+  }
+  else if (!queued_providers_.isEmpty()) {
+    QTimer::singleShot(kSecondWaveDelayMs, this, &LyricsFetcherSearch::StartQueuedProviders);
+  }
+
+}
+
+void LyricsFetcherSearch::StartProvider(LyricsProvider *provider) {
+
+  QObject::connect(provider, &LyricsProvider::SearchFinished, this, &LyricsFetcherSearch::ProviderSearchFinished, Qt::UniqueConnection);
+  const int id = lyrics_providers_->NextId();
+  const bool success = provider->StartSearch(id, request_);
+  if (success) {
+    pending_requests_.insert(id, provider);
+    request_started_ms_.insert(id, search_timer_.elapsed());
+  }
+
+}
+
+void LyricsFetcherSearch::StartQueuedProviders() {
+
+  if (cancel_requested_ || queued_providers_.isEmpty()) return;
+
+  const QList<LyricsProvider*> providers = queued_providers_;
+  queued_providers_.clear();
+  for (LyricsProvider *provider : providers) {
+    StartProvider(provider);
+  }
+
+  if (pending_requests_.isEmpty()) AllProvidersFinished();
 
 }
 
@@ -88,6 +147,8 @@ void LyricsFetcherSearch::ProviderSearchFinished(const int id, const LyricsSearc
   if (!pending_requests_.contains(id)) return;
   LyricsProvider *provider = pending_requests_.take(id);
 
+  provider->RecordSearchResult(search_timer_.elapsed() - request_started_ms_.take(id), !results.isEmpty());
+
   LyricsSearchResults results_copy(results);
   float higest_score = 0.0;
   for (int i = 0; i < results_copy.count(); ++i) {
@@ -112,14 +173,21 @@ void LyricsFetcherSearch::ProviderSearchFinished(const int id, const LyricsSearc
   results_.append(results_copy);
   std::stable_sort(results_.begin(), results_.end(), LyricsSearchResultCompareScore);
 
-  if (!pending_requests_.isEmpty()) {
+  if (!pending_requests_.isEmpty() || !queued_providers_.isEmpty()) {
     if (!results_.isEmpty() && higest_score >= kHighScore) {  // Highest score, no need to wait for other providers.
       qLog(Debug) << "Got lyrics with high score from" << results_.last().provider << "for" << request_.artist << request_.title << "score" << results_.last().score << "finishing search.";
       TerminateSearch();
-    }
-    else {
       return;
     }
+    if (!results_.isEmpty() && results_.last().score >= kAcceptableScore && !settle_timer_armed_) {
+      // Acceptable result: give the remaining providers a short settle period to come up with something better, then stop instead of waiting for them all.
+      settle_timer_armed_ = true;
+      QTimer::singleShot(kAcceptableSettleMs, this, &LyricsFetcherSearch::TerminateSearch);
+    }
+    if (pending_requests_.isEmpty()) {
+      // The first wave came up empty before the second wave delay, start the held back providers now.
+      StartQueuedProviders();
+    }
     return;
   }
 
@@ -154,7 +222,12 @@ void LyricsFetcherSearch::Cancel() {
 }
 
 bool LyricsFetcherSearch::ProviderCompareOrder(LyricsProvider *a, LyricsProvider *b) {
+
+  // Races start with the providers that have answered fastest and most reliably this session, the configured order breaks ties.
+  if (a->search_success_rate() != b->search_success_rate()) return a->search_success_rate() > b->search_success_rate();
+  if (a->average_search_latency_ms() != b->average_search_latency_ms()) return a->average_search_latency_ms() < b->average_search_latency_ms();
   return a->order() < b->order();
+
 }
 
 bool LyricsFetcherSearch::LyricsSearchResultCompareScore(const LyricsSearchResult &a, const LyricsSearchResult &b) {
@@ -24,8 +24,10 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QList>
 #include <QMap>
 #include <QString>
+#include <QElapsedTimer>
 
 #include "core/shared_ptr.h"
 #include "lyricssearchrequest.h"
@@ -43,15 +45,20 @@ class LyricsFetcherSearch : public QObject {
   void Start(SharedPtr<LyricsProviders> lyrics_providers);
   void Cancel();
 
+  const LyricsSearchRequest &request() const { return request_; }
+
  signals:
   void SearchFinished(const quint64 id, const LyricsSearchResults &results);
   void LyricsFetched(const quint64 id, const QString &provider, const QString &lyrics);
 
  private slots:
   void ProviderSearchFinished(const int id, const LyricsSearchResults &results);
+  void TimeoutSearch();
   void TerminateSearch();
+  void StartQueuedProviders();
 
  private:
+  void StartProvider(LyricsProvider *provider);
   void AllProvidersFinished();
   static bool ProviderCompareOrder(LyricsProvider *a, LyricsProvider *b);
   static bool LyricsSearchResultCompareScore(const LyricsSearchResult &a, const LyricsSearchResult &b);
@@ -60,11 +67,22 @@ class LyricsFetcherSearch : public QObject {
   static const int kSearchTimeoutMs;
   static const int kGoodLyricsLength;
   static const float kHighScore;
+  static const float kAcceptableScore;
+  static const int kAcceptableSettleMs;
+  static const int kImmediateProviders;
+  static const int kSecondWaveDelayMs;
 
   quint64 id_;
   LyricsSearchRequest request_;
   LyricsSearchResults results_;
+  SharedPtr<LyricsProviders> lyrics_providers_;
   QMap<int, LyricsProvider*> pending_requests_;
+  // Providers held back until the first wave has had a head start, started early if the first wave comes up empty.
+  QList<LyricsProvider*> queued_providers_;
+  // When each request was started, relative to search_timer_, for the per-provider latency statistics.
+  QElapsedTimer search_timer_;
+  QMap<int, qint64> request_started_ms_;
+  bool settle_timer_armed_;
   bool cancel_requested_;
 };
 
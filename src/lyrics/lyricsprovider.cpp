@@ -27,4 +27,25 @@
 #include "lyricsprovider.h"
 
 LyricsProvider::LyricsProvider(const QString &name, const bool enabled, const bool authentication_required, SharedPtr<NetworkAccessManager> network, QObject *parent)
-    : QObject(parent), network_(network), name_(name), enabled_(enabled), order_(0), authentication_required_(authentication_required) {}
+    : QObject(parent), network_(network), name_(name), enabled_(enabled), order_(0), authentication_required_(authentication_required), searches_attempted_(0), searches_successful_(0), average_search_latency_ms_(0) {}
+
+void LyricsProvider::WarmUpConnection() {
+
+  if (enabled_ && network_) network_->AddWarmUpUrl(ApiUrl());
+
+}
+
+void LyricsProvider::RecordSearchResult(const qint64 elapsed_ms, const bool success) {
+
+  ++searches_attempted_;
+  if (success) ++searches_successful_;
+
+  // Moving average weighted towards history, so one slow reply doesn't reorder the providers.
+  if (average_search_latency_ms_ == 0) {
+    average_search_latency_ms_ = elapsed_ms;
+  }
+  else {
+    average_search_latency_ms_ = (average_search_latency_ms_ * 3 + elapsed_ms) / 4;
+  }
+
+}
@@ -47,6 +47,19 @@ class LyricsProvider : public QObject {
   void set_enabled(const bool enabled) { enabled_ = enabled; }
   void set_order(const int order) { order_ = order; }
 
+  // Per-session search statistics, used to start the most promising providers first when racing a search across providers.
+  // Providers without any searches yet report a perfect rate and zero latency, so new providers are given a chance first.
+  void RecordSearchResult(const qint64 elapsed_ms, const bool success);
+  int searches_attempted() const { return searches_attempted_; }
+  float search_success_rate() const { return searches_attempted_ > 0 ? static_cast<float>(searches_successful_) / static_cast<float>(searches_attempted_) : 1.0F; }
+  qint64 average_search_latency_ms() const { return average_search_latency_ms_; }
+
+  // The fixed API endpoint of the service, if it has one.
+  // Used to open the connection for enabled providers in the background at startup, so the first search of a session doesn't pay for DNS and the TLS handshake.
+  virtual QUrl ApiUrl() const { return QUrl(); }
+  // Queues the API endpoint for connection warmup if the provider is enabled.
+  void WarmUpConnection();
+
   virtual bool StartSearch(const int id, const LyricsSearchRequest &request) = 0;
   virtual void CancelSearch(const int id) { Q_UNUSED(id); }
   virtual bool AuthenticationRequired() const { return authentication_required_; }
@@ -68,6 +81,11 @@ class LyricsProvider : public QObject {
   bool enabled_;
   int order_;
   const bool authentication_required_;
+
+ private:
+  int searches_attempted_;
+  int searches_successful_;
+  qint64 average_search_latency_ms_;
 };
 
 #endif  // LYRICSPROVIDER_H
@@ -70,6 +70,7 @@ void LyricsProviders::ReloadSettings() {
     if (provider) {
       provider->set_enabled(true);
       provider->set_order(++i);
+      provider->WarmUpConnection();
       new_providers << provider;  // clazy:exclude=reserve-candidates
     }
   }
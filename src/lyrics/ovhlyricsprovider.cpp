@@ -53,6 +53,8 @@ OVHLyricsProvider::~OVHLyricsProvider() {
 
 }
 
+QUrl OVHLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrlSearch)); }
+
 bool OVHLyricsProvider::StartSearch(const int id, const LyricsSearchRequest &request) {
 
   QUrl url(QString::fromLatin1(kUrlSearch) + QString::fromLatin1(QUrl::toPercentEncoding(request.artist)) + QLatin1Char('/') + QString::fromLatin1(QUrl::toPercentEncoding(request.title)));
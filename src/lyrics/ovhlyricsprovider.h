@@ -42,6 +42,7 @@ class OVHLyricsProvider : public JsonLyricsProvider {
   explicit OVHLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
   ~OVHLyricsProvider() override;
 
+  QUrl ApiUrl() const override;
   bool StartSearch(const int id, const LyricsSearchRequest &request) override;
   void CancelSearch(const int id) override;
 
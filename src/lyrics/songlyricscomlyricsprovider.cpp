@@ -37,6 +37,8 @@ constexpr char kLyricsStart[] = "<p id=\"songLyricsDiv\"[^>]+>";
 SongLyricsComLyricsProvider::SongLyricsComLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : HtmlLyricsProvider(QStringLiteral("songlyrics.com"), true, QLatin1String(kStartTag), QLatin1String(kEndTag), QLatin1String(kLyricsStart), false, network, parent) {}
 
+QUrl SongLyricsComLyricsProvider::ApiUrl() const { return QUrl(QString::fromLatin1(kUrl)); }
+
 QUrl SongLyricsComLyricsProvider::Url(const LyricsSearchRequest &request) {
 
   return QUrl(QLatin1String(kUrl) + StringFixup(request.artist) + QLatin1Char('/') + StringFixup(request.title) + QLatin1String("-lyrics/"));
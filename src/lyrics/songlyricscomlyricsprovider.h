@@ -36,6 +36,8 @@ class SongLyricsComLyricsProvider : public HtmlLyricsProvider {
  public:
   explicit SongLyricsComLyricsProvider(SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
 
+  QUrl ApiUrl() const override;
+
  protected:
   QUrl Url(const LyricsSearchRequest &request) override;
 
@@ -58,6 +58,7 @@
 #include <QDir>
 #include <QString>
 #include <QSettings>
+#include <QTimer>
 #include <QLoggingCategory>
 #ifdef HAVE_TRANSLATIONS
 #  include <QTranslator>
@@ -65,6 +66,7 @@
 
 #include "main.h"
 
+#include "core/logbuffer.h"
 #include "core/logging.h"
 
 #include "core/scoped_ptr.h"
@@ -95,6 +97,7 @@
 #include "core/iconloader.h"
 #include "core/mainwindow.h"
 #include "core/commandlineoptions.h"
+#include "core/startuptimeline.h"
 #include "core/application.h"
 #include "core/networkproxyfactory.h"
 #ifdef Q_OS_MACOS
@@ -150,6 +153,7 @@ int main(int argc, char *argv[]) {
 
   // Initialize logging.  Log levels are set after the commandline options are parsed below.
   logging::Init();
+  logging::LogBuffer::Instance()->SetEnabled(true);  // Keeps a bounded in-memory copy of the log for the Console dialog.
   g_log_set_default_handler(reinterpret_cast<GLogFunc>(&logging::GLog), nullptr);
 
   CommandlineOptions options(argc, argv);
@@ -161,6 +165,7 @@ int main(int argc, char *argv[]) {
     // Parse commandline options - need to do this before starting the full QApplication, so it works without an X server
     if (!options.Parse()) return 1;
     logging::SetLevels(options.log_levels());
+    StartupTimeline::SetEnabled(options.profile_startup());
     if (!single_app.isPrimaryInstance()) {
       if (options.is_empty()) {
         qLog(Info) << "Strawberry is already running - activating existing window (1)";
@@ -271,15 +276,18 @@ int main(int argc, char *argv[]) {
 
   ScopedPtr<Translations> translations(new Translations);
 
+  {
+    StartupTimeline::Phase phase("Translations");
 #  if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  translations->LoadTranslation(QStringLiteral("qt"), QLibraryInfo::path(QLibraryInfo::TranslationsPath), language);
+    translations->LoadTranslation(QStringLiteral("qt"), QLibraryInfo::path(QLibraryInfo::TranslationsPath), language);
 #  else
-  translations->LoadTranslation(QStringLiteral("qt"), QLibraryInfo::location(QLibraryInfo::TranslationsPath), language);
+    translations->LoadTranslation(QStringLiteral("qt"), QLibraryInfo::location(QLibraryInfo::TranslationsPath), language);
 #  endif
-  translations->LoadTranslation(QStringLiteral("strawberry"), QStringLiteral(":/translations"), language);
-  translations->LoadTranslation(QStringLiteral("strawberry"), QStringLiteral(TRANSLATIONS_DIR), language);
-  translations->LoadTranslation(QStringLiteral("strawberry"), QCoreApplication::applicationDirPath(), language);
-  translations->LoadTranslation(QStringLiteral("strawberry"), QDir::currentPath(), language);
+    translations->LoadTranslation(QStringLiteral("strawberry"), QStringLiteral(":/translations"), language);
+    translations->LoadTranslation(QStringLiteral("strawberry"), QStringLiteral(TRANSLATIONS_DIR), language);
+    translations->LoadTranslation(QStringLiteral("strawberry"), QCoreApplication::applicationDirPath(), language);
+    translations->LoadTranslation(QStringLiteral("strawberry"), QDir::currentPath(), language);
+  }
 
 #  ifdef HAVE_QTSPARKLE
   //qtsparkle::LoadTranslations(language);
@@ -287,7 +295,9 @@ int main(int argc, char *argv[]) {
 
 #endif
 
+  StartupTimeline::BeginPhase("Application");
   Application app;
+  StartupTimeline::EndPhase("Application");
 
   // Network proxy
   QNetworkProxyFactory::setApplicationProxyFactory(NetworkProxyFactory::Instance());
@@ -308,7 +318,9 @@ int main(int argc, char *argv[]) {
 #endif
 
   // Window
+  StartupTimeline::BeginPhase("MainWindow");
   MainWindow w(&app, tray_icon, &osd, options);
+  StartupTimeline::EndPhase("MainWindow");
 
 #ifdef Q_OS_MACOS
   mac::EnableFullScreen(w);
@@ -319,8 +331,16 @@ int main(int argc, char *argv[]) {
 #endif
   QObject::connect(&single_app, &KDSingleApplication::messageReceived, &w, QOverload<const QByteArray&>::of(&MainWindow::CommandlineOptionsReceived));
 
+  // Dump the startup timeline on the first event loop turn, once everything up to the visible window is recorded.
+  if (StartupTimeline::enabled()) {
+    QTimer::singleShot(0, &w, []() { StartupTimeline::Dump(); });
+  }
+
   int ret = QCoreApplication::exec();
 
+  // Write out any settings changes still queued in the write-behind layer.
+  Settings::FlushPending();
+
   return ret;
 
 }
@@ -54,6 +54,14 @@ void MoodbarBuilder::Init(int bands, int rate_hz) {
     barkband_table_.append(barkband);
   }
 
+  // The table is non-decreasing, so every bark band covers a contiguous run of bins.
+  // Precompute the run boundaries once, AddFrame() sums each run with a plain loop over consecutive memory.
+  band_offsets_.resize(sBarkBandCount + 1);
+  for (int band = 0, i = 0; band <= sBarkBandCount; ++band) {
+    while (i < barkband_table_.count() && barkband_table_.at(i) < static_cast<uint>(band)) ++i;
+    band_offsets_[band] = i;
+  }
+
 }
 
 void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
@@ -64,12 +72,14 @@ void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
 
   // Calculate total magnitudes for different bark bands.
   double bands[sBarkBandCount];
-  for (int i = 0; i < sBarkBandCount; ++i) {
-    bands[i] = 0.0;
-  }
-
-  for (int i = 0; i < size; ++i) {
-    bands[barkband_table_[i]] += magnitudes[i];
+  for (int band = 0; band < sBarkBandCount; ++band) {
+    const int start = std::min(band_offsets_.at(band), size);
+    const int end = std::min(band_offsets_.at(band + 1), size);
+    double total = 0.0;
+    for (int i = start; i < end; ++i) {
+      total += magnitudes[i];
+    }
+    bands[band] = total;
   }
 
   // Now divide the bark bands into thirds and compute their total amplitudes.
@@ -80,6 +90,13 @@ void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
 
   frames_.append(Rgb(sqrt(rgb[0]), sqrt(rgb[1]), sqrt(rgb[2])));
 
+  // Total magnitude of the frame, used for the waveform envelope.
+  double energy = 0.0;
+  for (int i = 0; i < sBarkBandCount; ++i) {
+    energy += bands[i];
+  }
+  frame_energy_.append(energy);
+
 }
 
 void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
@@ -160,6 +177,34 @@ void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
 
 }
 
+QByteArray MoodbarBuilder::Envelope(int width) const {
+
+  QByteArray ret;
+  if (frame_energy_.count() == 0 || width <= 0) return ret;
+
+  double maxi = 0;
+  for (const double value : frame_energy_) {
+    if (value > maxi) maxi = value;
+  }
+  if (maxi <= 0) return ret;
+
+  ret.resize(width);
+  char *data = ret.data();
+  for (int i = 0; i < width; ++i) {
+    const int start = static_cast<int>(i * frame_energy_.count() / width);
+    const int end = std::max(static_cast<int>((i + 1) * frame_energy_.count() / width), start + 1);
+
+    double peak = 0;
+    for (int j = start; j < end && j < frame_energy_.count(); j++) {
+      peak = std::max(peak, frame_energy_.at(j));
+    }
+
+    *(data++) = static_cast<char>(peak / maxi * 255.0);
+  }
+  return ret;
+
+}
+
 QByteArray MoodbarBuilder::Finish(int width) {
 
   QByteArray ret;
@@ -29,6 +29,9 @@ class MoodbarBuilder {
   void Init(int bands, int rate_hz);
   void AddFrame(const double *magnitudes, int size);
   QByteArray Finish(int width);
+  // Peak amplitude envelope of the track downsampled to width points, one byte per point.
+  // Computed from the per-frame total magnitudes collected by AddFrame(), so it comes for free with the moodbar.
+  QByteArray Envelope(int width) const;
 
  private:
   struct Rgb {
@@ -42,10 +45,13 @@ class MoodbarBuilder {
   static void Normalize(QList<Rgb> *vals, double Rgb::*member);
 
   QList<uint> barkband_table_;
+  // First FFT bin of every bark band, so band b covers bins [band_offsets_[b], band_offsets_[b + 1]).
+  QList<int> band_offsets_;
   int bands_;
   int rate_hz_;
 
   QList<Rgb> frames_;
+  QList<double> frame_energy_;
 };
 
 #endif  // MOODBARBUILDER_H
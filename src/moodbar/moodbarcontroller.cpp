@@ -36,7 +36,8 @@ MoodbarController::MoodbarController(Application *app, QObject *parent)
       app_(app),
       enabled_(false) {
 
-  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &MoodbarController::CurrentSongChanged);
+  // Queued, so starting a moodbar analysis pipeline never adds to the latency of the track change itself.
+  QObject::connect(&*app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &MoodbarController::CurrentSongChanged, Qt::QueuedConnection);
   QObject::connect(&*app_->player(), &Player::Stopped, this, &MoodbarController::PlaybackStopped);
 
   ReloadSettings();
@@ -58,21 +59,24 @@ void MoodbarController::CurrentSongChanged(const Song &song) {
 
   QByteArray data;
   MoodbarPipeline *pipeline = nullptr;
-  const MoodbarLoader::Result result = app_->moodbar_loader()->Load(song.url(), song.has_cue(), &data, &pipeline);
+  const MoodbarLoader::Result result = app_->moodbar_loader()->Load(song.url(), song.has_cue(), &data, &pipeline, true);
 
   switch (result) {
     case MoodbarLoader::Result::CannotLoad:
       emit CurrentMoodbarDataChanged(QByteArray());
+      emit CurrentWaveformDataChanged(QByteArray());
       break;
 
     case MoodbarLoader::Result::Loaded:
       emit CurrentMoodbarDataChanged(data);
+      emit CurrentWaveformDataChanged(app_->moodbar_loader()->LoadEnvelope(song.url()));
       break;
 
     case MoodbarLoader::Result::WillLoadAsync:
       // Emit an empty array for now so the GUI reverts to a normal progress
       // bar.  Our slot will be called when the data is actually loaded.
       emit CurrentMoodbarDataChanged(QByteArray());
+      emit CurrentWaveformDataChanged(QByteArray());
 
       QObject::connect(pipeline, &MoodbarPipeline::Finished, this, [this, pipeline, song]() { AsyncLoadComplete(pipeline, song.url()); });
       break;
@@ -83,6 +87,7 @@ void MoodbarController::CurrentSongChanged(const Song &song) {
 void MoodbarController::PlaybackStopped() {
   if (enabled_) {
     emit CurrentMoodbarDataChanged(QByteArray());
+    emit CurrentWaveformDataChanged(QByteArray());
   }
 }
 
@@ -105,5 +110,6 @@ void MoodbarController::AsyncLoadComplete(MoodbarPipeline *pipeline, const QUrl
   }
 
   emit CurrentMoodbarDataChanged(pipeline->data());
+  emit CurrentWaveformDataChanged(pipeline->envelope_data());
 
 }
@@ -37,6 +37,7 @@ class MoodbarController : public QObject {
 
  signals:
   void CurrentMoodbarDataChanged(const QByteArray &data);
+  void CurrentWaveformDataChanged(const QByteArray &data);
 
  private slots:
   void CurrentSongChanged(const Song &song);
@@ -45,6 +45,18 @@
 
 #include "settings/moodbarsettingspage.h"
 
+namespace {
+
+// Render widths are quantized so that dragging a column edge doesn't re-render every visible row for each pixel of movement.
+// The paint path scales the cached pixmap into the exact rect.
+constexpr int kWidthBucket = 32;
+
+QSize BucketedSize(const QSize size) {
+  return QSize((size.width() / kWidthBucket + 1) * kWidthBucket, size.height());
+}
+
+}  // namespace
+
 MoodbarItemDelegate::Data::Data() : state_(State::None) {}
 
 MoodbarItemDelegate::MoodbarItemDelegate(Application *app, PlaylistView *view, QObject *parent)
@@ -89,7 +101,8 @@ void MoodbarItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
   drawBackground(painter, option, idx);
 
   if (!pixmap.isNull()) {
-    // Make a little border for the moodbar
+    // Make a little border for the moodbar.
+    // The pixmap is rendered at a bucketed width, drawPixmap scales it into the exact rect.
     const QRect moodbar_rect(option.rect.adjusted(1, 1, -1, -1));
     painter->drawPixmap(moodbar_rect, pixmap);
   }
@@ -112,7 +125,7 @@ QPixmap MoodbarItemDelegate::PixmapForIndex(const QModelIndex &idx, const QSize
   }
 
   data->indexes_.insert(idx);
-  data->desired_size_ = size;
+  data->desired_size_ = BucketedSize(size);
 
   switch (data->state_) {
     case Data::State::CannotLoad:
@@ -122,8 +135,8 @@ QPixmap MoodbarItemDelegate::PixmapForIndex(const QModelIndex &idx, const QSize
       return data->pixmap_;
 
     case Data::State::Loaded:
-      // Is the pixmap the right size?
-      if (data->pixmap_.size() != size) {
+      // Is the pixmap in the right size bucket?
+      if (data->pixmap_.size() != data->desired_size_) {
         StartLoadingImage(url, data);
       }
 
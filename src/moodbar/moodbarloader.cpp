@@ -41,6 +41,7 @@
 #include "core/scoped_ptr.h"
 #include "core/application.h"
 #include "core/settings.h"
+#include "core/taskmanager.h"
 
 #include "moodbarpipeline.h"
 
@@ -52,11 +53,24 @@ using namespace std::chrono_literals;
 #  include <windows.h>
 #endif
 
+namespace {
+// Enough for a few thousand moodbars at roughly 3 kB each.
+constexpr int kDataCacheMaxCost = 8 * 1024 * 1024;
+constexpr int kEnvelopeCacheMaxCost = 2 * 1024 * 1024;
+// Appended to the song filename to form the cache key for the waveform envelope stored beside the moodbar data.
+const char *kEnvelopeCacheSuffix = ".envelope";
+}  // namespace
+
 MoodbarLoader::MoodbarLoader(Application *app, QObject *parent)
     : QObject(parent),
+      app_(app),
       cache_(new QNetworkDiskCache(this)),
       thread_(new QThread(this)),
       kMaxActiveRequests(qMax(1, QThread::idealThreadCount() / 2)),
+      data_cache_(kDataCacheMaxCost),
+      envelope_cache_(kEnvelopeCacheMaxCost),
+      task_id_(0),
+      task_finished_count_(0),
       save_(false) {
 
   cache_->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/moodbar"));
@@ -99,14 +113,24 @@ QUrl MoodbarLoader::CacheUrlEntry(const QString &filename) {
 
 }
 
-MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline) {
+MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline, const bool priority) {
 
   if (!url.isLocalFile() || has_cue) {
     return Result::CannotLoad;
   }
 
+  // Do we have the data in memory already? This avoids any file access when scrolling back and forth or reloading colors.
+  if (QByteArray *cached_data = data_cache_.object(url)) {
+    *data = *cached_data;
+    return Result::Loaded;
+  }
+
   // Are we in the middle of loading this moodbar already?
   if (requests_.contains(url)) {
+    // A priority request jumps ahead of everything still waiting in the queue.
+    if (priority && queued_requests_.removeOne(url)) {
+      queued_requests_.prepend(url);
+    }
     *async_pipeline = requests_[url];
     return Result::WillLoadAsync;
   }
@@ -122,6 +146,7 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
         qLog(Info) << "Loading moodbar data from" << possible_mood_file;
         *data = f.readAll();
         f.close();
+        data_cache_.insert(url, new QByteArray(*data), static_cast<int>(data->size()));
         return Result::Loaded;
       }
       else {
@@ -139,6 +164,7 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
       qLog(Info) << "Loading cached moodbar data for" << filename;
       *data = device_cache_file->readAll();
       if (!data->isEmpty()) {
+        data_cache_.insert(url, new QByteArray(*data), static_cast<int>(data->size()));
         return Result::Loaded;
       }
     }
@@ -152,7 +178,10 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
   QObject::connect(pipeline, &MoodbarPipeline::Finished, this, [this, pipeline, url]() { RequestFinished(pipeline, url); });
 
   requests_[url] = pipeline;
-  queued_requests_ << url;
+  // Newest requests go first: they come from the playing track or from rows that are visible right now, while older entries may have scrolled out of view.
+  queued_requests_.prepend(url);
+
+  UpdateTask();
 
   MaybeTakeNextRequest();
 
@@ -161,6 +190,33 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
 
 }
 
+QByteArray MoodbarLoader::LoadEnvelope(const QUrl &url) {
+
+  if (!url.isLocalFile()) {
+    return QByteArray();
+  }
+
+  if (QByteArray *cached_data = envelope_cache_.object(url)) {
+    return *cached_data;
+  }
+
+  const QString filename(url.toLocalFile());
+  QNetworkCacheMetaData disk_cache_metadata = cache_->metaData(CacheUrlEntry(filename + QLatin1String(kEnvelopeCacheSuffix)));
+  if (disk_cache_metadata.isValid()) {
+    ScopedPtr<QIODevice> device_cache_file(cache_->data(disk_cache_metadata.url()));
+    if (device_cache_file) {
+      const QByteArray data = device_cache_file->readAll();
+      if (!data.isEmpty()) {
+        envelope_cache_.insert(url, new QByteArray(data), static_cast<int>(data.size()));
+        return data;
+      }
+    }
+  }
+
+  return QByteArray();
+
+}
+
 void MoodbarLoader::MaybeTakeNextRequest() {
 
   Q_ASSERT(QThread::currentThread() == qApp->thread());
@@ -187,6 +243,8 @@ void MoodbarLoader::RequestFinished(MoodbarPipeline *request, const QUrl &url) {
 
     qLog(Info) << "Moodbar data generated successfully for" << filename;
 
+    data_cache_.insert(url, new QByteArray(request->data()), static_cast<int>(request->data().size()));
+
     // Save the data in the cache
     QNetworkCacheMetaData disk_cache_metadata;
     disk_cache_metadata.setSaveToDisk(true);
@@ -202,6 +260,23 @@ void MoodbarLoader::RequestFinished(MoodbarPipeline *request, const QUrl &url) {
       }
     }
 
+    // Store the waveform envelope that was generated alongside the moodbar.
+    if (!request->envelope_data().isEmpty()) {
+      envelope_cache_.insert(url, new QByteArray(request->envelope_data()), static_cast<int>(request->envelope_data().size()));
+
+      QNetworkCacheMetaData envelope_metadata;
+      envelope_metadata.setSaveToDisk(true);
+      envelope_metadata.setUrl(CacheUrlEntry(filename + QLatin1String(kEnvelopeCacheSuffix)));
+      envelope_metadata.setRawHeaders(QNetworkCacheMetaData::RawHeaderList() << qMakePair(QByteArray("moodbar"), QByteArray("moodbar")));
+      QIODevice *device_envelope_file = cache_->prepare(envelope_metadata);
+      if (device_envelope_file) {
+        const qint64 envelope_written = device_envelope_file->write(request->envelope_data());
+        if (envelope_written > 0) {
+          cache_->insert(device_envelope_file);
+        }
+      }
+    }
+
     // Save the data alongside the original as well if we're configured to.
     if (save_) {
       QStringList mood_filenames = MoodFilenames(url.toLocalFile());
@@ -228,8 +303,29 @@ void MoodbarLoader::RequestFinished(MoodbarPipeline *request, const QUrl &url) {
   requests_.remove(url);
   active_requests_.remove(url);
 
+  ++task_finished_count_;
+  UpdateTask();
+
   QTimer::singleShot(1s, request, &MoodbarLoader::deleteLater);
 
   MaybeTakeNextRequest();
 
 }
+
+void MoodbarLoader::UpdateTask() {
+
+  if (requests_.isEmpty()) {
+    if (task_id_ != 0) {
+      app_->task_manager()->SetTaskFinished(task_id_);
+      task_id_ = 0;
+    }
+    task_finished_count_ = 0;
+  }
+  else {
+    if (task_id_ == 0) {
+      task_id_ = app_->task_manager()->StartTask(tr("Generating moodbar data"));
+    }
+    app_->task_manager()->SetTaskProgress(task_id_, task_finished_count_, task_finished_count_ + static_cast<quint64>(requests_.count()));
+  }
+
+}
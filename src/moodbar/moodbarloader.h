@@ -19,15 +19,16 @@
 #define MOODBARLOADER_H
 
 #include <QObject>
+#include <QCache>
 #include <QList>
 #include <QMap>
 #include <QSet>
+#include <QByteArray>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
 
 class QThread;
-class QByteArray;
 class QNetworkDiskCache;
 class Application;
 class MoodbarPipeline;
@@ -52,7 +53,12 @@ class MoodbarLoader : public QObject {
     WillLoadAsync
   };
 
-  Result Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline);
+  // When priority is set the request jumps to the front of the generation queue, used for the currently playing track.
+  Result Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline, const bool priority = false);
+
+  // Returns the cached waveform envelope for a song, or an empty array if there is none.
+  // Envelopes are stored beside the moodbar data as a by-product of moodbar generation, they are never generated on their own.
+  QByteArray LoadEnvelope(const QUrl &url);
 
  private slots:
   void ReloadSettings();
@@ -65,6 +71,10 @@ class MoodbarLoader : public QObject {
   static QUrl CacheUrlEntry(const QString &filename);
 
  private:
+  void UpdateTask();
+
+ private:
+  Application *app_;
   QNetworkDiskCache *cache_;
   QThread *thread_;
 
@@ -74,6 +84,14 @@ class MoodbarLoader : public QObject {
   QList<QUrl> queued_requests_;
   QSet<QUrl> active_requests_;
 
+  // Raw moodbar data kept in memory, so repaints and style changes don't go back to disk for songs that were already loaded once.
+  QCache<QUrl, QByteArray> data_cache_;
+  QCache<QUrl, QByteArray> envelope_cache_;
+
+  // Generation progress reported through the task manager while requests are outstanding.
+  int task_id_;
+  quint64 task_finished_count_;
+
   bool save_;
 };
 
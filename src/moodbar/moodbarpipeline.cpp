@@ -42,6 +42,7 @@
 using std::make_unique;
 
 const int MoodbarPipeline::kBands = 128;
+const int MoodbarPipeline::kEnvelopePoints = 2000;
 
 MoodbarPipeline::MoodbarPipeline(const QUrl &url, QObject *parent)
     : QObject(parent),
@@ -216,6 +217,7 @@ void MoodbarPipeline::Stop(const bool success) {
   success_ = success;
   running_ = false;
   if (builder_ != nullptr) {
+    envelope_data_ = builder_->Envelope(kEnvelopePoints);
     data_ = builder_->Finish(1000);
     builder_.reset();
   }
@@ -42,6 +42,8 @@ class MoodbarPipeline : public QObject {
 
   bool success() const { return success_; }
   const QByteArray &data() const { return data_; }
+  // Waveform envelope produced as a by-product of the same decode, see MoodbarBuilder::Envelope().
+  const QByteArray &envelope_data() const { return envelope_data_; }
 
  public slots:
   void Start();
@@ -64,6 +66,7 @@ class MoodbarPipeline : public QObject {
 
  private:
   static const int kBands;
+  static const int kEnvelopePoints;
 
   QUrl url_;
   GstElement *pipeline_;
@@ -74,6 +77,7 @@ class MoodbarPipeline : public QObject {
   bool success_;
   bool running_;
   QByteArray data_;
+  QByteArray envelope_data_;
 };
 
 #endif  // MOODBARPIPELINE_H
@@ -55,6 +55,7 @@ MoodbarProxyStyle::MoodbarProxyStyle(Application *app, QSlider *slider, QObject*
       app_(app),
       slider_(slider),
       enabled_(true),
+      waveform_enabled_(false),
       moodbar_style_(MoodbarRenderer::MoodbarStyle::Normal),
       state_(State::MoodbarOff),
       fade_timeline_(new QTimeLine(1000, this)),
@@ -62,6 +63,7 @@ MoodbarProxyStyle::MoodbarProxyStyle(Application *app, QSlider *slider, QObject*
       moodbar_pixmap_dirty_(true),
       context_menu_(nullptr),
       show_moodbar_action_(nullptr),
+      show_waveform_action_(nullptr),
       style_action_group_(nullptr) {
 
   slider->setStyle(this);
@@ -82,6 +84,13 @@ void MoodbarProxyStyle::ReloadSettings() {
   // Get the enabled/disabled setting, and start the timelines if there's a change.
   enabled_ = s.value("show", false).toBool();
 
+  const bool new_waveform_enabled = s.value("waveform", false).toBool();
+  if (new_waveform_enabled != waveform_enabled_) {
+    waveform_enabled_ = new_waveform_enabled;
+    moodbar_pixmap_dirty_ = true;
+    slider_->update();
+  }
+
   NextState();
 
   // Get the style, and redraw if there's a change.
@@ -105,6 +114,14 @@ void MoodbarProxyStyle::SetMoodbarData(const QByteArray &data) {
 
 }
 
+void MoodbarProxyStyle::SetWaveformData(const QByteArray &data) {
+
+  waveform_data_ = data;
+  moodbar_pixmap_dirty_ = true;  // Redraw next time
+  slider_->update();
+
+}
+
 void MoodbarProxyStyle::SetMoodbarEnabled(const bool enabled) {
 
   enabled_ = enabled;
@@ -119,6 +136,20 @@ void MoodbarProxyStyle::SetMoodbarEnabled(const bool enabled) {
 
 }
 
+void MoodbarProxyStyle::SetWaveformEnabled(const bool enabled) {
+
+  waveform_enabled_ = enabled;
+
+  // Save the enabled setting.
+  Settings s;
+  s.beginGroup(MoodbarSettingsPage::kSettingsGroup);
+  s.setValue("waveform", enabled);
+  s.endGroup();
+
+  app_->ReloadSettings();
+
+}
+
 void MoodbarProxyStyle::NextState() {
 
   const bool visible = enabled_ && !data_.isEmpty();
@@ -266,6 +297,9 @@ void MoodbarProxyStyle::EnsureMoodbarRendered(const QStyleOptionSlider *opt) {
 
   if (moodbar_pixmap_dirty_) {
     moodbar_pixmap_ = MoodbarPixmap(moodbar_colors_, slider_->size(), slider_->palette(), opt);
+    if (waveform_enabled_ && !waveform_data_.isEmpty()) {
+      DrawWaveform(&moodbar_pixmap_);
+    }
     moodbar_pixmap_dirty_ = false;
   }
 
@@ -334,6 +368,29 @@ void MoodbarProxyStyle::DrawArrow(const QStyleOptionSlider *option, QPainter *pa
 
 }
 
+void MoodbarProxyStyle::DrawWaveform(QPixmap *pixmap) const {
+
+  // The envelope is precomputed, so drawing it is one translucent vertical line per pixel column with no decoding involved.
+  QRect inner_rect(QPoint(0, 0), pixmap->size());
+  inner_rect.adjust(kMarginSize + kBorderSize, kMarginSize + kBorderSize, -(kMarginSize + kBorderSize), -(kMarginSize + kBorderSize));
+
+  if (inner_rect.width() <= 0 || inner_rect.height() <= 0) return;
+
+  const unsigned char *envelope = reinterpret_cast<const unsigned char*>(waveform_data_.constData());
+  const int points = static_cast<int>(waveform_data_.size());
+  const int mid = inner_rect.center().y();
+
+  QPainter p(pixmap);
+  p.setPen(QColor(0, 0, 0, 96));
+  for (int x = 0; x < inner_rect.width(); ++x) {
+    const int i = x * points / inner_rect.width();
+    const int h = envelope[i] * (inner_rect.height() / 2) / 255;
+    p.drawLine(inner_rect.left() + x, mid - h, inner_rect.left() + x, mid + h);
+  }
+  p.end();
+
+}
+
 QPixmap MoodbarProxyStyle::MoodbarPixmap(const ColorVector &colors, const QSize size, const QPalette &palette, const QStyleOptionSlider *opt) {
 
   Q_UNUSED(opt);
@@ -375,6 +432,10 @@ void MoodbarProxyStyle::ShowContextMenu(const QPoint pos) {
     show_moodbar_action_->setCheckable(true);
     show_moodbar_action_->setChecked(enabled_);
 
+    show_waveform_action_ = context_menu_->addAction(tr("Show waveform"), this, &MoodbarProxyStyle::SetWaveformEnabled);
+    show_waveform_action_->setCheckable(true);
+    show_waveform_action_->setChecked(waveform_enabled_);
+
     QMenu *styles_menu = context_menu_->addMenu(tr("Moodbar style"));
     style_action_group_ = new QActionGroup(styles_menu);
 
@@ -391,6 +452,8 @@ void MoodbarProxyStyle::ShowContextMenu(const QPoint pos) {
     QObject::connect(styles_menu, &QMenu::triggered, this, &MoodbarProxyStyle::ChangeStyle);
   }
 
+  show_waveform_action_->setChecked(waveform_enabled_);
+
   // Update the currently selected style
   const QList<QAction*> actions = style_action_group_->actions();
   for (QAction *action : actions) {
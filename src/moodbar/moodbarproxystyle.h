@@ -61,9 +61,14 @@ class MoodbarProxyStyle : public QProxyStyle {
   // An empty byte array means there's no moodbar, so just show a normal slider.
   void SetMoodbarData(const QByteArray &data);
 
+  // Waveform envelope of the current track, drawn over the moodbar when available. An empty array hides the overlay.
+  void SetWaveformData(const QByteArray &data);
+
   // If the moodbar is disabled then a normal slider will always be shown.
   void SetMoodbarEnabled(const bool enabled);
 
+  void SetWaveformEnabled(const bool enabled);
+
  private:
   enum class State {
     MoodbarOn,
@@ -78,6 +83,7 @@ class MoodbarProxyStyle : public QProxyStyle {
   void Render(ComplexControl control, const QStyleOptionSlider *option, QPainter *painter, const QWidget *widget);
   void EnsureMoodbarRendered(const QStyleOptionSlider *opt);
   void DrawArrow(const QStyleOptionSlider *option, QPainter *painter) const;
+  void DrawWaveform(QPixmap *pixmap) const;
   void ShowContextMenu(const QPoint pos);
 
   static QPixmap MoodbarPixmap(const ColorVector &colors, const QSize size, const QPalette &palette, const QStyleOptionSlider *opt);
@@ -92,7 +98,9 @@ class MoodbarProxyStyle : public QProxyStyle {
   QSlider *slider_;
 
   bool enabled_;
+  bool waveform_enabled_;
   QByteArray data_;
+  QByteArray waveform_data_;
   MoodbarRenderer::MoodbarStyle moodbar_style_;
 
   State state_;
@@ -108,6 +116,7 @@ class MoodbarProxyStyle : public QProxyStyle {
 
   QMenu *context_menu_;
   QAction *show_moodbar_action_;
+  QAction *show_waveform_action_;
   QActionGroup *style_action_group_;
 };
 
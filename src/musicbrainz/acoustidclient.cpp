@@ -52,6 +52,8 @@ namespace {
 constexpr char kClientId[] = "0qjUoxbowg";
 constexpr char kUrl[] = "https://api.acoustid.org/v2/lookup";
 constexpr int kDefaultTimeout = 5000;  // msec
+// How many fingerprints are looked up per batched request, using the indexed parameter form of the lookup API.
+constexpr int kMaxFingerprintsPerRequest = 50;
 }  // namespace
 
 AcoustidClient::AcoustidClient(SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -93,6 +95,44 @@ void AcoustidClient::Start(const int id, const QString &fingerprint, int duratio
 
 }
 
+void AcoustidClient::StartBatch(const LookupRequestList &requests) {
+
+  using Param = QPair<QString, QString>;
+  using ParamList = QList<Param>;
+
+  for (qsizetype i = 0; i < requests.count(); i += kMaxFingerprintsPerRequest) {
+
+    const LookupRequestList chunk = requests.mid(i, kMaxFingerprintsPerRequest);
+
+    ParamList params = ParamList() << Param(QStringLiteral("format"), QStringLiteral("json"))
+                                   << Param(QStringLiteral("client"), QLatin1String(kClientId))
+                                   << Param(QStringLiteral("meta"), QStringLiteral("recordingids+sources"));
+
+    QList<int> ids;
+    ids.reserve(chunk.count());
+    for (qsizetype j = 0; j < chunk.count(); ++j) {
+      params << Param(QStringLiteral("duration.%1").arg(j), QString::number(chunk[j].duration_msec / kMsecPerSec));
+      params << Param(QStringLiteral("fingerprint.%1").arg(j), chunk[j].fingerprint);
+      ids << chunk[j].id;
+    }
+
+    QUrlQuery url_query;
+    url_query.setQueryItems(params);
+
+    // The fingerprints don't fit in a URL, so batched lookups are sent as a form encoded POST body.
+    QNetworkRequest req((QUrl(QString::fromLatin1(kUrl))));
+    req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+    req.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/x-www-form-urlencoded"));
+    QNetworkReply *reply = network_->post(req, url_query.toString(QUrl::FullyEncoded).toUtf8());
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, ids]() { BatchRequestFinished(reply, ids); });
+    batch_requests_ << reply;
+
+    timeouts_->AddReply(reply);
+
+  }
+
+}
+
 void AcoustidClient::Cancel(const int id) {
 
   if (requests_.contains(id)) delete requests_.take(id);
@@ -102,8 +142,10 @@ void AcoustidClient::Cancel(const int id) {
 void AcoustidClient::CancelAll() {
 
   QList<QNetworkReply*> replies = requests_.values();
+  replies << batch_requests_;
   qDeleteAll(replies);
   requests_.clear();
+  batch_requests_.clear();
 
 }
 
@@ -156,17 +198,79 @@ void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id)
     return;
   }
 
+  emit Finished(request_id, ParseResults(json_object[QLatin1String("results")].toArray()));
+
+}
+
+void AcoustidClient::BatchRequestFinished(QNetworkReply *reply, const QList<int> ids) {
+
+  QObject::disconnect(reply, nullptr, this, nullptr);
+  reply->deleteLater();
+  batch_requests_.removeAll(reply);
+
+  if (reply->error() != QNetworkReply::NoError || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+    if (reply->error() != QNetworkReply::NoError) {
+      qLog(Error) << QStringLiteral("Acoustid: %1 (%2)").arg(reply->errorString()).arg(reply->error());
+    }
+    else {
+      qLog(Error) << QStringLiteral("Acoustid: Received HTTP code %1").arg(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+    }
+    for (const int id : ids) {
+      emit Finished(id, QStringList());
+    }
+    return;
+  }
+
+  QJsonParseError error;
+  QJsonDocument json_document = QJsonDocument::fromJson(reply->readAll(), &error);
+
+  if (error.error != QJsonParseError::NoError) {
+    for (const int id : ids) {
+      emit Finished(id, QStringList());
+    }
+    return;
+  }
+
+  QJsonObject json_object = json_document.object();
+
+  QString status = json_object[QLatin1String("status")].toString();
+  if (status != QLatin1String("ok")) {
+    for (const int id : ids) {
+      emit Finished(id, QStringList(), status);
+    }
+    return;
+  }
+
+  // Batched lookups answer with one entry per fingerprint, tagged with the index of the indexed parameters it was submitted under.
+  QList<int> ids_missing = ids;
+  const QJsonArray json_fingerprints = json_object[QLatin1String("fingerprints")].toArray();
+  for (const QJsonValue v : json_fingerprints) {
+    QJsonObject json_fingerprint = v.toObject();
+    const int index = json_fingerprint[QLatin1String("index")].toVariant().toInt();
+    if (index < 0 || index >= ids.count()) continue;
+    ids_missing.removeAll(ids[index]);
+    emit Finished(ids[index], ParseResults(json_fingerprint[QLatin1String("results")].toArray()));
+  }
+
+  // Make sure every ID gets an answer even when the server leaves some fingerprints out.
+  for (const int id : ids_missing) {
+    emit Finished(id, QStringList());
+  }
+
+}
+
+QStringList AcoustidClient::ParseResults(const QJsonArray &json_results) {
+
   // Get the results:
   // -in a first step, gather ids and their corresponding number of sources
   // -then sort results by number of sources (the results are originally
   //  unsorted but results with more sources are likely to be more accurate)
   // -keep only the ids, as sources where useful only to sort the results
-  QJsonArray json_results = json_object[QLatin1String("results")].toArray();
 
   // List of <id, nb of sources> pairs
   QList<IdSource> id_source_list;
 
-  for (const QJsonValueRef v : json_results) {
+  for (const QJsonValue v : json_results) {
     QJsonObject r = v.toObject();
     if (!r[QLatin1String("recordings")].isUndefined()) {
       QJsonArray json_recordings = r[QLatin1String("recordings")].toArray();
@@ -187,7 +291,7 @@ void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id)
     id_list << is.id_;
   }
 
-  emit Finished(request_id, id_list);
+  return id_list;
 
 }
 
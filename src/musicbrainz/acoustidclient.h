@@ -25,12 +25,14 @@
 #include "config.h"
 
 #include <QObject>
+#include <QList>
 #include <QMap>
 #include <QString>
 #include <QStringList>
 
 #include "core/shared_ptr.h"
 
+class QJsonArray;
 class QNetworkReply;
 class NetworkAccessManager;
 class NetworkTimeouts;
@@ -54,6 +56,18 @@ class AcoustidClient : public QObject {
   // Starts a request and returns immediately.  Finished() will be emitted later with the same ID.
   void Start(const int id, const QString &fingerprint, int duration_msec);
 
+  struct LookupRequest {
+    LookupRequest(const int _id, const QString &_fingerprint, const int _duration_msec) : id(_id), fingerprint(_fingerprint), duration_msec(_duration_msec) {}
+    int id;
+    QString fingerprint;
+    int duration_msec;
+  };
+  using LookupRequestList = QList<LookupRequest>;
+
+  // Looks up many fingerprints in a handful of batched requests instead of one request each.
+  // Finished() is emitted once per ID, in the order the server answers.  Batched requests can only be cancelled with CancelAll().
+  void StartBatch(const LookupRequestList &requests);
+
   // Cancels the request with the given ID.  Finished() will never be emitted for that ID.  Does nothing if there is no request with the given ID.
   void Cancel(const int id);
 
@@ -65,11 +79,15 @@ class AcoustidClient : public QObject {
 
  private slots:
   void RequestFinished(QNetworkReply *reply, const int id);
+  void BatchRequestFinished(QNetworkReply *reply, const QList<int> ids);
 
  private:
+  static QStringList ParseResults(const QJsonArray &json_results);
+
   SharedPtr<NetworkAccessManager> network_;
   NetworkTimeouts *timeouts_;
   QMap<int, QNetworkReply*> requests_;
+  QList<QNetworkReply*> batch_requests_;
 };
 
 #endif  // ACOUSTIDCLIENT_H
@@ -22,9 +22,11 @@
 #include "config.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <QObject>
 #include <QSet>
+#include <QHash>
 #include <QList>
 #include <QVariant>
 #include <QString>
@@ -41,11 +43,13 @@
 #include <QJsonObject>
 #include <QXmlStreamReader>
 #include <QTimer>
+#include <QDateTime>
 
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
 #include "core/networktimeouts.h"
+#include "utilities/timeconstants.h"
 #include "utilities/xmlutils.h"
 #include "musicbrainzclient.h"
 
@@ -54,15 +58,24 @@ constexpr char kTrackUrl[] = "https://musicbrainz.org/ws/2/recording/";
 constexpr char kDiscUrl[] = "https://musicbrainz.org/ws/2/discid/";
 constexpr char kDateRegex[] = "^[12]\\d{3}";
 constexpr int kRequestsDelay = 1200;
+// Bounds for the delay between requests when adapting to the server's rate limit headers.
+constexpr int kMinRequestsDelay = 250;
+constexpr int kMaxRequestsDelay = 10000;
 constexpr int kDefaultTimeout = 8000;
 constexpr int kMaxRequestPerTrack = 3;
+
+// Process-wide cache with the parsed results per recording MBID, so re-tagging the same or duplicate files never refetches identical release metadata.
+// Only touched from the main thread.
+constexpr qsizetype kMetadataCacheMaxEntries = 1024;
+QHash<QString, MusicBrainzClient::ResultList> sMetadataCache;
 }  // namespace
 
 MusicBrainzClient::MusicBrainzClient(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : QObject(parent),
       network_(network),
       timeouts_(new NetworkTimeouts(kDefaultTimeout, this)),
-      timer_flush_requests_(new QTimer(this)) {
+      timer_flush_requests_(new QTimer(this)),
+      request_delay_(kRequestsDelay) {
 
   timer_flush_requests_->setInterval(kRequestsDelay);
   timer_flush_requests_->setSingleShot(true);
@@ -121,6 +134,8 @@ void MusicBrainzClient::Cancel(int id) {
 
   while (!requests_.isEmpty() && requests_.contains(id)) {
     QNetworkReply *reply = requests_.take(id);
+    // A reply can serve coalesced lookups for several tracks, only abort it when no other track is waiting on it.
+    if (std::find(requests_.cbegin(), requests_.cend(), reply) != requests_.cend()) continue;
     QObject::disconnect(reply, nullptr, this, nullptr);
     if (reply->isRunning()) reply->abort();
     reply->deleteLater();
@@ -130,7 +145,11 @@ void MusicBrainzClient::Cancel(int id) {
 
 void MusicBrainzClient::CancelAll() {
 
-  qDeleteAll(requests_.values());
+  const QList<QNetworkReply*> replies = requests_.values();
+  const QSet<QNetworkReply*> unique_replies(replies.begin(), replies.end());
+  for (QNetworkReply *reply : unique_replies) {
+    delete reply;
+  }
   requests_.clear();
 
 }
@@ -138,15 +157,28 @@ void MusicBrainzClient::CancelAll() {
 void MusicBrainzClient::Start(const int id, const QStringList &mbid_list) {
 
   int request_number = 0;
+  bool queued = false;
   for (const QString &mbid : mbid_list) {
     ++request_number;
     if (request_number > kMaxRequestPerTrack) break;
+    // Answer from the cache when this recording was already fetched.
+    if (sMetadataCache.contains(mbid)) {
+      pending_results_[id] << PendingResults(request_number, sMetadataCache.value(mbid));
+      continue;
+    }
     Request request(id, mbid, request_number);
     requests_pending_.insert(id, request);
+    queued = true;
   }
 
-  if (!timer_flush_requests_->isActive()) {
-    timer_flush_requests_->start();
+  if (queued) {
+    if (!timer_flush_requests_->isActive()) {
+      timer_flush_requests_->start();
+    }
+  }
+  else {
+    // Everything was answered from the cache, finish asynchronously so the caller sees the same flow as with a request.
+    QMetaObject::invokeMethod(this, [this, id]() { MaybeFinishRequest(id); }, Qt::QueuedConnection);
   }
 
 }
@@ -173,7 +205,19 @@ void MusicBrainzClient::FlushRequests() {
 
   if (!requests_.isEmpty() || requests_pending_.isEmpty()) return;
 
-  Request request = requests_pending_.take(requests_pending_.firstKey());
+  const Request request = requests_pending_.take(requests_pending_.firstKey());
+
+  // Coalesce every pending lookup for the same recording into this request, so duplicate MBIDs cost one round trip.
+  QList<Request> requests = QList<Request>() << request;
+  for (QMultiMap<int, Request>::iterator it = requests_pending_.begin(); it != requests_pending_.end();) {
+    if (it.value().mbid == request.mbid) {
+      requests << it.value();
+      it = requests_pending_.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
 
   const ParamList params = ParamList() << Param(QStringLiteral("inc"), QStringLiteral("artists+releases+media"));
 
@@ -185,21 +229,60 @@ void MusicBrainzClient::FlushRequests() {
   QNetworkRequest req(url);
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
   QNetworkReply *reply = network_->get(req);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { RequestFinished(reply, request.id, request.number); });
-  requests_.insert(request.id, reply);
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, requests]() { RequestFinished(reply, requests); });
+  for (const Request &r : requests) {
+    requests_.insert(r.id, reply);
+  }
 
   timeouts_->AddReply(reply);
 
 }
 
-void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, const int request_number) {
+void MusicBrainzClient::UpdateRequestDelay(QNetworkReply *reply) {
+
+  const int http_status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  if (http_status == 503) {
+    // Throttled: back off exponentially until the server accepts us again.
+    request_delay_ = std::min(request_delay_ * 2, kMaxRequestsDelay);
+  }
+  else if (reply->hasRawHeader("X-RateLimit-Remaining")) {
+    // Spread the remaining allowance over the time left in the rate limit window.
+    const int remaining = reply->rawHeader("X-RateLimit-Remaining").toInt();
+    qint64 reset_in_ms = 0;
+    if (reply->hasRawHeader("X-RateLimit-Reset-In")) {
+      reset_in_ms = static_cast<qint64>(reply->rawHeader("X-RateLimit-Reset-In").toDouble() * kMsecPerSec);
+    }
+    else if (reply->hasRawHeader("X-RateLimit-Reset")) {
+      reset_in_ms = (reply->rawHeader("X-RateLimit-Reset").toLongLong() - QDateTime::currentSecsSinceEpoch()) * kMsecPerSec;
+    }
+    if (reset_in_ms > 0) {
+      const qint64 delay = remaining > 0 ? reset_in_ms / remaining : reset_in_ms;
+      request_delay_ = static_cast<int>(std::clamp(delay, static_cast<qint64>(kMinRequestsDelay), static_cast<qint64>(kMaxRequestsDelay)));
+    }
+  }
+  else {
+    // No rate limit information, fall back to the conservative fixed delay.
+    request_delay_ = kRequestsDelay;
+  }
+
+  timer_flush_requests_->setInterval(request_delay_);
+
+}
+
+void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const QList<Request> requests) {
 
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
-  const qint64 nb_removed = requests_.remove(id, reply);
-  if (nb_removed != 1) {
-    qLog(Debug) << "MusicBrainz: Unknown reply received:" << nb_removed << "requests removed, while only one was supposed to be removed";
+  UpdateRequestDelay(reply);
+
+  // Remove the (id, reply) pairs of the coalesced requests.  Pairs already gone were cancelled, their tracks get no results.
+  QList<Request> requests_alive;
+  requests_alive.reserve(requests.count());
+  for (const Request &r : requests) {
+    if (requests_.remove(r.id, reply) > 0) {
+      requests_alive << r;
+    }
   }
 
   if (!timer_flush_requests_->isActive() && requests_.isEmpty() && !requests_pending_.isEmpty()) {
@@ -221,19 +304,46 @@ void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, cons
         }
       }
     }
-    pending_results_[id] << PendingResults(request_number, res);
+    if (sMetadataCache.count() >= kMetadataCacheMaxEntries) sMetadataCache.clear();
+    sMetadataCache.insert(requests.first().mbid, res);
+    for (const Request &r : requests_alive) {
+      pending_results_[r.id] << PendingResults(r.number, res);
+    }
+  }
+
+  for (const Request &r : requests_alive) {
+    if (requests_.contains(r.id) || requests_pending_.contains(r.id)) {
+      // More replies are coming for this id: stream what we have so far so callers can already show the candidates.
+      emit ResultsUpdated(r.id, MergedResultsSoFar(r.id));
+    }
+    else {
+      MaybeFinishRequest(r.id, error);
+    }
   }
 
+}
+
+MusicBrainzClient::ResultList MusicBrainzClient::MergedResultsSoFar(const int id) const {
+
+  ResultList ret;
+  QList<PendingResults> result_list_list = pending_results_.value(id);
+  std::sort(result_list_list.begin(), result_list_list.end());
+  for (const PendingResults &result_list : std::as_const(result_list_list)) {
+    ret << result_list.results_;
+  }
+
+  return UniqueResults(ret, UniqueResultsSortOption::KeepOriginalOrder);
+
+}
+
+void MusicBrainzClient::MaybeFinishRequest(const int id, const QString &error) {
+
   // No more pending requests for this id: emit the results we have.
   if (!requests_.contains(id) && !requests_pending_.contains(id)) {
     // Merge the results we have
-    ResultList ret;
-    QList<PendingResults> result_list_list = pending_results_.take(id);
-    std::sort(result_list_list.begin(), result_list_list.end());
-    for (const PendingResults &result_list : result_list_list) {
-      ret << result_list.results_;
-    }
-    emit Finished(id, UniqueResults(ret, UniqueResultsSortOption::KeepOriginalOrder), error);
+    const ResultList ret = MergedResultsSoFar(id);
+    pending_results_.remove(id);
+    emit Finished(id, ret, error);
   }
 
 }
@@ -102,17 +102,13 @@ class MusicBrainzClient : public QObject {
   void CancelAll();
 
  signals:
+  // Emitted with the merged results so far each time a reply arrives while other requests for the same ID are still in flight, so callers can show candidates before the lookup is complete.
+  void ResultsUpdated(const int id, const MusicBrainzClient::ResultList &result);
   // Finished signal emitted when fechting songs tags
   void Finished(const int id, const MusicBrainzClient::ResultList &result, const QString &error = QString());
   // Finished signal emitted when fechting album's songs tags using DiscId
   void DiscIdFinished(const QString &artist, const QString &album, const MusicBrainzClient::ResultList &result, const QString &error = QString());
 
- private slots:
-  void FlushRequests();
-  // id identifies the track, and request_number means it's the 'request_number'th request for this track
-  void RequestFinished(QNetworkReply *reply, const int id, const int request_number);
-  void DiscIdRequestFinished(const QString &discid, QNetworkReply *reply);
-
  private:
   using Param = QPair<QString, QString>;
   using ParamList = QList<Param>;
@@ -125,6 +121,14 @@ class MusicBrainzClient : public QObject {
     int number;
   };
 
+ private slots:
+  void FlushRequests();
+  // One reply can serve several coalesced requests for the same MBID, each identifying a track (id) and which lookup it is for that track (number).
+  void RequestFinished(QNetworkReply *reply, const QList<Request> requests);
+  void DiscIdRequestFinished(const QString &discid, QNetworkReply *reply);
+
+ private:
+
   // Used as parameter for UniqueResults
   enum class UniqueResultsSortOption {
     SortResults = 0,
@@ -201,6 +205,13 @@ class MusicBrainzClient : public QObject {
   static ResultList UniqueResults(const ResultList &results, UniqueResultsSortOption opt = UniqueResultsSortOption::SortResults);
   static void Error(const QString &error, const QVariant &debug = QVariant());
 
+  // Merges and dedupes the results received for the id so far.
+  ResultList MergedResultsSoFar(const int id) const;
+  // Emits Finished() for the id when no requests for it are in flight or pending anymore.
+  void MaybeFinishRequest(const int id, const QString &error = QString());
+  // Adjusts the delay between requests from the rate limit headers of a reply, backing off when the server throttles us.
+  void UpdateRequestDelay(QNetworkReply *reply);
+
  private:
   SharedPtr<NetworkAccessManager> network_;
   NetworkTimeouts *timeouts_;
@@ -209,6 +220,7 @@ class MusicBrainzClient : public QObject {
   // Results we received so far, kept here until all the replies are finished
   QMap<int, QList<PendingResults>> pending_results_;
   QTimer *timer_flush_requests_;
+  int request_delay_;
 
 };
 
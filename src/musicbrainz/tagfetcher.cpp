@@ -29,6 +29,7 @@
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QString>
+#include <QTimer>
 
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
@@ -38,19 +39,37 @@
 #include "musicbrainzclient.h"
 #include "tagfetcher.h"
 
+namespace {
+// How many finished fingerprints are collected before they are sent to AcoustID as one batched lookup.
+constexpr int kLookupBatchSize = 10;
+// How long a partial batch may sit in the queue before it is flushed anyway.  msec
+constexpr int kLookupFlushDelay = 500;
+}  // namespace
+
 TagFetcher::TagFetcher(SharedPtr<NetworkAccessManager> network, QObject *parent)
     : QObject(parent),
       fingerprint_watcher_(nullptr),
       acoustid_client_(new AcoustidClient(network, this)),
-      musicbrainz_client_(new MusicBrainzClient(network, this)) {
+      musicbrainz_client_(new MusicBrainzClient(network, this)),
+      timer_flush_lookups_(new QTimer(this)) {
+
+  timer_flush_lookups_->setInterval(kLookupFlushDelay);
+  timer_flush_lookups_->setSingleShot(true);
+  QObject::connect(timer_flush_lookups_, &QTimer::timeout, this, &TagFetcher::FlushPendingLookups);
 
   QObject::connect(acoustid_client_, &AcoustidClient::Finished, this, &TagFetcher::PuidsFound);
+  QObject::connect(musicbrainz_client_, &MusicBrainzClient::ResultsUpdated, this, &TagFetcher::TagsUpdated);
   QObject::connect(musicbrainz_client_, &MusicBrainzClient::Finished, this, &TagFetcher::TagsFetched);
 
 }
 
 QString TagFetcher::GetFingerprint(const Song &song) {
+
+  // Reuse the fingerprint stored in the collection when the song already has one, so re-tagging never decodes the file again.
+  if (!song.fingerprint().isEmpty()) return song.fingerprint();
+
   return Chromaprinter(song.url().toLocalFile()).CreateFingerprint();
+
 }
 
 void TagFetcher::StartFetch(const SongList &songs) {
@@ -65,16 +84,23 @@ void TagFetcher::StartFetch(const SongList &songs) {
   }
 
   if (have_fingerprints) {
+    // All fingerprints are known up front, so identify the whole selection in a few batched lookups instead of one request per song.
+    AcoustidClient::LookupRequestList requests;
+    requests.reserve(songs_.count());
     for (int i = 0; i < songs_.count(); ++i) {
       const Song &song = songs_[i];
       emit Progress(song, tr("Identifying song"));
-      acoustid_client_->Start(i, song.fingerprint(), static_cast<int>(song.length_nanosec() / kNsecPerMsec));
+      requests << AcoustidClient::LookupRequest(i, song.fingerprint(), static_cast<int>(song.length_nanosec() / kNsecPerMsec));
     }
+    acoustid_client_->StartBatch(requests);
   }
   else {
+    // The stages overlap: fingerprinting runs on the thread pool while finished fingerprints are batched off to AcoustID,
+    // whose answers stream into MusicBrainz - so the CPU and the network stay busy at the same time.
     QFuture<QString> future = QtConcurrent::mapped(songs_, GetFingerprint);
     fingerprint_watcher_ = new QFutureWatcher<QString>(this);
     QObject::connect(fingerprint_watcher_, &QFutureWatcher<QString>::resultReadyAt, this, &TagFetcher::FingerprintFound);
+    QObject::connect(fingerprint_watcher_, &QFutureWatcher<QString>::finished, this, &TagFetcher::FingerprintingFinished);
     fingerprint_watcher_->setFuture(future);
     for (const Song &song : std::as_const(songs_)) {
       emit Progress(song, tr("Fingerprinting song"));
@@ -92,6 +118,8 @@ void TagFetcher::Cancel() {
     fingerprint_watcher_ = nullptr;
   }
 
+  timer_flush_lookups_->stop();
+  pending_lookups_.clear();
   acoustid_client_->CancelAll();
   musicbrainz_client_->CancelAll();
   songs_.clear();
@@ -112,7 +140,33 @@ void TagFetcher::FingerprintFound(const int index) {
   }
 
   emit Progress(song, tr("Identifying song"));
-  acoustid_client_->Start(index, fingerprint, static_cast<int>(song.length_nanosec() / kNsecPerMsec));
+
+  // Queue the lookup instead of sending it right away, so files that finish fingerprinting close together share one request.
+  pending_lookups_ << AcoustidClient::LookupRequest(index, fingerprint, static_cast<int>(song.length_nanosec() / kNsecPerMsec));
+  if (pending_lookups_.count() >= kLookupBatchSize) {
+    FlushPendingLookups();
+  }
+  else if (!timer_flush_lookups_->isActive()) {
+    timer_flush_lookups_->start();
+  }
+
+}
+
+void TagFetcher::FingerprintingFinished() {
+
+  // The last few fingerprints should not wait out the flush delay.
+  FlushPendingLookups();
+
+}
+
+void TagFetcher::FlushPendingLookups() {
+
+  timer_flush_lookups_->stop();
+
+  if (pending_lookups_.isEmpty()) return;
+
+  acoustid_client_->StartBatch(pending_lookups_);
+  pending_lookups_.clear();
 
 }
 
@@ -134,13 +188,8 @@ void TagFetcher::PuidsFound(const int index, const QStringList &puid_list, const
 
 }
 
-void TagFetcher::TagsFetched(const int index, const MusicBrainzClient::ResultList &results, const QString &error) {
+SongList TagFetcher::GuessedSongs(const MusicBrainzClient::ResultList &results) {
 
-  if (index >= songs_.count()) {
-    return;
-  }
-
-  const Song &original_song = songs_[index];
   SongList songs_guessed;
   songs_guessed.reserve(results.count());
   for (const MusicBrainzClient::Result &result : results) {
@@ -151,7 +200,27 @@ void TagFetcher::TagsFetched(const int index, const MusicBrainzClient::ResultLis
     songs_guessed << song;
   }
 
-  emit ResultAvailable(original_song, songs_guessed, error);
+  return songs_guessed;
+
+}
+
+void TagFetcher::TagsUpdated(const int index, const MusicBrainzClient::ResultList &results) {
+
+  if (index >= songs_.count() || results.isEmpty()) {
+    return;
+  }
+
+  emit ResultUpdated(songs_[index], GuessedSongs(results));
+
+}
+
+void TagFetcher::TagsFetched(const int index, const MusicBrainzClient::ResultList &results, const QString &error) {
+
+  if (index >= songs_.count()) {
+    return;
+  }
+
+  emit ResultAvailable(songs_[index], GuessedSongs(results), error);
 
 }
 
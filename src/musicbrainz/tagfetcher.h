@@ -31,10 +31,11 @@
 
 #include "core/shared_ptr.h"
 #include "core/song.h"
+#include "acoustidclient.h"
 #include "musicbrainzclient.h"
 
+class QTimer;
 class NetworkAccessManager;
-class AcoustidClient;
 
 class TagFetcher : public QObject {
   Q_OBJECT
@@ -51,21 +52,30 @@ class TagFetcher : public QObject {
 
  signals:
   void Progress(const Song &original_song, const QString &stage);
+  // Emitted with the candidates found so far while more metadata lookups for the song are still in flight.
+  void ResultUpdated(const Song &original_song, const SongList &songs_guessed);
   void ResultAvailable(const Song &original_song, const SongList &songs_guessed, const QString &error = QString());
 
  private slots:
   void FingerprintFound(const int index);
+  void FingerprintingFinished();
+  void FlushPendingLookups();
   void PuidsFound(const int index, const QStringList &puid_list, const QString &error = QString());
+  void TagsUpdated(const int index, const MusicBrainzClient::ResultList &results);
   void TagsFetched(const int index, const MusicBrainzClient::ResultList &results, const QString &error = QString());
 
  private:
   static QString GetFingerprint(const Song &song);
+  static SongList GuessedSongs(const MusicBrainzClient::ResultList &results);
 
   QFutureWatcher<QString> *fingerprint_watcher_;
   AcoustidClient *acoustid_client_;
   MusicBrainzClient *musicbrainz_client_;
 
   SongList songs_;
+  // Fingerprints that finished but have not been sent to AcoustID yet, flushed in batches while the remaining files are still fingerprinting.
+  AcoustidClient::LookupRequestList pending_lookups_;
+  QTimer *timer_flush_lookups_;
 };
 
 #endif  // TAGFETCHER_H
@@ -26,6 +26,10 @@
 #include <chrono>
 
 #include <QThread>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QCryptographicHash>
 #include <QFile>
 #include <QFileInfo>
 #include <QTimer>
@@ -35,6 +39,7 @@
 #include <QUrl>
 #include <QImage>
 
+#include "core/ioscheduler.h"
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/taskmanager.h"
@@ -42,6 +47,7 @@
 #include "core/tagreaderclient.h"
 #include "core/song.h"
 #include "utilities/strutils.h"
+#include "utilities/timeutils.h"
 #include "organize.h"
 #ifdef HAVE_GSTREAMER
 #  include "transcoder/transcoder.h"
@@ -51,12 +57,27 @@ using namespace std::chrono_literals;
 
 class OrganizeFormat;
 
+namespace {
+
+// Hash of the file contents, empty if the file could not be read.
+QByteArray FileChecksum(const QString &path) {
+
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  if (!hash.addData(&file)) return QByteArray();
+  return hash.result();
+
+}
+
+}  // namespace
+
 const int Organize::kBatchSize = 10;
 #ifdef HAVE_GSTREAMER
 const int Organize::kTranscodeProgressInterval = 500;
 #endif
 
-Organize::Organize(SharedPtr<TaskManager> task_manager, SharedPtr<MusicStorage> destination, const OrganizeFormat &format, const bool copy, const bool overwrite, const bool albumcover, const NewSongInfoList &songs_info, const bool eject_after, const QString &playlist, QObject *parent)
+Organize::Organize(SharedPtr<TaskManager> task_manager, SharedPtr<MusicStorage> destination, const OrganizeFormat &format, const bool copy, const bool overwrite, const bool albumcover, const bool verify, const NewSongInfoList &songs_info, const bool eject_after, const QString &playlist, QObject *parent)
     : QObject(parent),
       thread_(nullptr),
       task_manager_(task_manager),
@@ -69,14 +90,17 @@ Organize::Organize(SharedPtr<TaskManager> task_manager, SharedPtr<MusicStorage>
       copy_(copy),
       overwrite_(overwrite),
       albumcover_(albumcover),
+      verify_(verify),
       eject_after_(eject_after),
       task_count_(songs_info.count()),
       playlist_(playlist),
+      verifications_pending_(0),
       tasks_complete_(0),
       started_(false),
       task_id_(0),
       current_copy_progress_(0),
-      finished_(false) {
+      finished_(false),
+      smoothed_bytes_per_sec_(0.0) {
 
   original_thread_ = thread();
 
@@ -145,6 +169,12 @@ void Organize::ProcessSomeFiles() {
     }
 #endif
 
+    if (verifications_pending_ > 0) {
+      // Just wait - VerifyFinished will start us off again
+      qLog(Debug) << "Waiting for verification jobs";
+      return;
+    }
+
     UpdateProgress();
 
     QString error_text;
@@ -257,14 +287,36 @@ void Organize::ProcessSomeFiles() {
 
     job.progress_ = std::bind(&Organize::SetSongProgress, this, std::placeholders::_1, !task.transcoded_filename_.isEmpty());
 
+    bool verification_started = false;
+
     QString error_text;
-    if (destination_->CopyToStorage(job, error_text)) {
+    bool copied = false;
+    // Take the size before the copy, the source may be moved or removed by it.
+    const qint64 bytes = QFileInfo(job.source_).size();
+    copy_timer_.start();
+    {
+      // Take I/O tokens for the source and destination filesystems, so concurrent background jobs don't thrash the same spinning disk.
+      IoScheduler::ScopedToken io_token(QStringList() << job.source_ << destination_->LocalPath());
+      copied = destination_->CopyToStorage(job, error_text);
+    }
+    if (copied) {
+      // Fold this file into the smoothed transfer rate. The weight on the new sample keeps the ETA from jumping around on every small file.
+      const qint64 elapsed_msec = copy_timer_.elapsed();
+      if (elapsed_msec > 0 && bytes > 0) {
+        const double bytes_per_sec = static_cast<double>(bytes) * 1000.0 / static_cast<double>(elapsed_msec);
+        smoothed_bytes_per_sec_ = smoothed_bytes_per_sec_ > 0.0 ? smoothed_bytes_per_sec_ * 0.7 + bytes_per_sec * 0.3 : bytes_per_sec;
+      }
       if (job.remove_original_ && song.is_collection_song() && destination_->source() == Song::Source::Collection) {
         // Notify other aspects of system that song has been invalidated
         QString root = destination_->LocalPath();
         QFileInfo new_file = QFileInfo(root + QLatin1Char('/') + task.song_info_.new_filename_);
         emit SongPathChanged(song, new_file, destination_->collection_directory_id());
       }
+      // Verify the copy in the background while the next files are copied.
+      if (verify_ && copy_ && !destination_->LocalPath().isEmpty()) {
+        StartVerification(job.source_, destination_->LocalPath() + QLatin1Char('/') + task.song_info_.new_filename_, !task.transcoded_filename_.isEmpty());
+        verification_started = true;
+      }
     }
     else {
       files_with_errors_ << task.song_info_.song_.basefilename();
@@ -273,8 +325,8 @@ void Organize::ProcessSomeFiles() {
       }
     }
 
-    // Clean up the temporary transcoded file
-    if (!task.transcoded_filename_.isEmpty()) {
+    // Clean up the temporary transcoded file, unless the verification job still needs it, then it cleans it up itself.
+    if (!task.transcoded_filename_.isEmpty() && !verification_started) {
       QFile::remove(task.transcoded_filename_);
     }
 
@@ -359,6 +411,20 @@ void Organize::UpdateProgress() {
 
   task_manager_->SetTaskProgress(task_id_, progress, total);
 
+  // Show the smoothed transfer rate and the time the remaining bytes will take at that rate, so slow destinations are visible at a glance.
+  if (smoothed_bytes_per_sec_ > 0.0) {
+    qint64 bytes_remaining = 0;
+    for (const Task &task : std::as_const(tasks_pending_)) {
+      bytes_remaining += static_cast<qint64>(task.song_info_.song_.filesize());
+    }
+    const int eta_sec = static_cast<int>(static_cast<double>(bytes_remaining) / smoothed_bytes_per_sec_);
+    QString status = tr("%1/s").arg(Utilities::PrettySize(static_cast<quint64>(smoothed_bytes_per_sec_)));
+    if (bytes_remaining > 0) {
+      status += tr(", %1 left").arg(Utilities::PrettyTime(eta_sec));
+    }
+    task_manager_->SetTaskStatus(task_id_, status);
+  }
+
 }
 
 void Organize::FileTranscoded(const QString &input, const QString &output, bool success) {
@@ -382,6 +448,43 @@ void Organize::FileTranscoded(const QString &input, const QString &output, bool
 
 }
 
+void Organize::StartVerification(const QString &source, const QString &destination, const bool remove_source_after) {
+
+  ++verifications_pending_;
+
+  QFuture<bool> future = QtConcurrent::run([source, destination, remove_source_after]() {
+    const QByteArray source_checksum = FileChecksum(source);
+    if (remove_source_after) QFile::remove(source);
+    if (source_checksum.isEmpty()) return false;
+    const QByteArray destination_checksum = FileChecksum(destination);
+    return !destination_checksum.isEmpty() && source_checksum == destination_checksum;
+  });
+  QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+  QObject::connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, destination]() {
+    VerifyFinished(destination, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(future);
+
+}
+
+void Organize::VerifyFinished(const QString &filename, const bool ok) {
+
+  --verifications_pending_;
+
+  if (!ok) {
+    qLog(Error) << "Checksum verification failed for" << filename;
+    files_with_errors_ << filename;
+    LogLine(tr("Checksum mismatch for %1").arg(filename));
+  }
+
+  // If the copies are already done we are the last thing holding up Finished().
+  if (tasks_pending_.isEmpty() && !process_files_timer_->isActive()) {
+    process_files_timer_->start();
+  }
+
+}
+
 void Organize::timerEvent(QTimerEvent *e) {
 
   QObject::timerEvent(e);
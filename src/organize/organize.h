@@ -28,6 +28,7 @@
 
 #include <QObject>
 #include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QSet>
 #include <QList>
@@ -63,7 +64,7 @@ class Organize : public QObject {
   };
   using NewSongInfoList = QList<NewSongInfo>;
 
-  explicit Organize(SharedPtr<TaskManager> task_manager, SharedPtr<MusicStorage> destination, const OrganizeFormat &format, const bool copy, const bool overwrite, const bool albumcover, const NewSongInfoList &songs, const bool eject_after, const QString &playlist = QString(), QObject *parent = nullptr);
+  explicit Organize(SharedPtr<TaskManager> task_manager, SharedPtr<MusicStorage> destination, const OrganizeFormat &format, const bool copy, const bool overwrite, const bool albumcover, const bool verify, const NewSongInfoList &songs, const bool eject_after, const QString &playlist = QString(), QObject *parent = nullptr);
   ~Organize() override;
 
   static const int kBatchSize;
@@ -89,6 +90,10 @@ class Organize : public QObject {
  private:
   void SetSongProgress(float progress, bool transcoded = false);
   void UpdateProgress();
+  // Checksums the copied file against its source on a worker thread while the next copies proceed.
+  // With remove_source_after the source (a temporary transcoded file) is removed once it has been hashed.
+  void StartVerification(const QString &source, const QString &destination, const bool remove_source_after);
+  void VerifyFinished(const QString &filename, const bool ok);
 #ifdef HAVE_GSTREAMER
   Song::FileType CheckTranscode(Song::FileType original_type) const;
 #endif
@@ -120,6 +125,8 @@ class Organize : public QObject {
   const bool copy_;
   const bool overwrite_;
   const bool albumcover_;
+  // Verify copies by checksum. Only used when copying to a destination with a local path.
+  const bool verify_;
   const bool eject_after_;
   quint64 task_count_;
   const QString playlist_;
@@ -127,6 +134,8 @@ class Organize : public QObject {
   QBasicTimer transcode_progress_timer_;
   QVector<Task> tasks_pending_;
   QMap<QString, Task> tasks_transcoding_;
+  // Number of verification jobs still running. The organizer is only finished once this drops to zero.
+  int verifications_pending_;
   int tasks_complete_;
 
   bool started_;
@@ -135,6 +144,11 @@ class Organize : public QObject {
   int current_copy_progress_;
   bool finished_;
 
+  // Measures each file copy, feeding the smoothed transfer rate below.
+  QElapsedTimer copy_timer_;
+  // Exponential moving average of the copy rate in bytes per second, 0 until the first file has been copied.
+  double smoothed_bytes_per_sec_;
+
   QStringList files_with_errors_;
   QStringList log_;
 };
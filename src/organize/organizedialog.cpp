@@ -53,6 +53,7 @@
 #include <QShowEvent>
 #include <QCloseEvent>
 #include <QSettings>
+#include <QTimer>
 
 #include "core/shared_ptr.h"
 #include "core/iconloader.h"
@@ -78,6 +79,11 @@ using std::make_unique;
 namespace {
 constexpr char kSettingsGroup[] = "OrganizeDialog";
 constexpr char kDefaultFormat[] = "%albumartist/%album{ (Disc %disc)}/{%track - }{%albumartist - }%album{ (Disc %disc)} - %title.%extension";
+
+// How long preview updates are held back to coalesce the ones triggered by consecutive keystrokes in the naming field.
+constexpr int kPreviewUpdateDebounceMs = 200;
+// The preview only materializes this many rows, a list widget with an entire collection in it makes the dialog unusable.
+constexpr qsizetype kMaxPreviewRows = 500;
 }
 
 OrganizeDialog::OrganizeDialog(SharedPtr<TaskManager> task_manager, SharedPtr<CollectionBackend> collection_backend, QWidget *parentwindow, QWidget *parent)
@@ -87,10 +93,16 @@ OrganizeDialog::OrganizeDialog(SharedPtr<TaskManager> task_manager, SharedPtr<Co
       task_manager_(task_manager),
       collection_backend_(collection_backend),
       total_size_(0),
-      devices_(false) {
+      devices_(false),
+      preview_update_timer_(new QTimer(this)),
+      preview_generation_(0) {
 
   ui_->setupUi(this);
 
+  preview_update_timer_->setSingleShot(true);
+  preview_update_timer_->setInterval(kPreviewUpdateDebounceMs);
+  QObject::connect(preview_update_timer_, &QTimer::timeout, this, &OrganizeDialog::UpdatePreviews);
+
   setWindowFlags(windowFlags() | Qt::WindowMaximizeButtonHint);
 
   QPushButton *button_save = ui_->button_box->addButton(QStringLiteral("Save settings"), QDialogButtonBox::ApplyRole);
@@ -126,13 +138,13 @@ OrganizeDialog::OrganizeDialog(SharedPtr<TaskManager> task_manager, SharedPtr<Co
   // Naming scheme input field
   new OrganizeFormat::SyntaxHighlighter(ui_->naming);
 
-  QObject::connect(ui_->destination, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->naming, &LineTextEdit::textChanged, this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->remove_problematic, &QCheckBox::toggled, this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->remove_non_fat, &QCheckBox::toggled, this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->remove_non_ascii, &QCheckBox::toggled, this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->allow_ascii_ext, &QCheckBox::toggled, this, &OrganizeDialog::UpdatePreviews);
-  QObject::connect(ui_->replace_spaces, &QCheckBox::toggled, this, &OrganizeDialog::UpdatePreviews);
+  QObject::connect(ui_->destination, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->naming, &LineTextEdit::textChanged, this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->remove_problematic, &QCheckBox::toggled, this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->remove_non_fat, &QCheckBox::toggled, this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->remove_non_ascii, &QCheckBox::toggled, this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->allow_ascii_ext, &QCheckBox::toggled, this, &OrganizeDialog::SchedulePreviewUpdate);
+  QObject::connect(ui_->replace_spaces, &QCheckBox::toggled, this, &OrganizeDialog::SchedulePreviewUpdate);
   QObject::connect(ui_->remove_non_ascii, &QCheckBox::toggled, this, &OrganizeDialog::AllowExtASCII);
 
   // Get the titles of the tags to put in the insert menu
@@ -189,7 +201,7 @@ void OrganizeDialog::accept() {
 
   // It deletes itself when it's finished.
   const bool copy = ui_->aftercopying->currentIndex() == 0;
-  Organize *organize = new Organize(task_manager_, storage, format_, copy, ui_->overwrite->isChecked(), ui_->albumcover->isChecked(), new_songs_info_, ui_->eject_after->isChecked(), playlist_);
+  Organize *organize = new Organize(task_manager_, storage, format_, copy, ui_->overwrite->isChecked(), ui_->albumcover->isChecked(), ui_->verify->isChecked(), new_songs_info_, ui_->eject_after->isChecked(), playlist_);
   QObject::connect(organize, &Organize::Finished, this, &OrganizeDialog::OrganizeFinished);
   QObject::connect(organize, &Organize::FileCopied, this, &OrganizeDialog::FileCopied);
   if (collection_backend_) {
@@ -280,6 +292,7 @@ void OrganizeDialog::RestoreDefaults() {
   ui_->replace_spaces->setChecked(true);
   ui_->overwrite->setChecked(false);
   ui_->albumcover->setChecked(true);
+  ui_->verify->setChecked(false);
   ui_->eject_after->setChecked(false);
 
 }
@@ -296,6 +309,7 @@ void OrganizeDialog::LoadSettings() {
   ui_->replace_spaces->setChecked(s.value("replace_spaces", true).toBool());
   ui_->overwrite->setChecked(s.value("overwrite", false).toBool());
   ui_->albumcover->setChecked(s.value("albumcover", true).toBool());
+  ui_->verify->setChecked(s.value("verify", false).toBool());
   ui_->eject_after->setChecked(s.value("eject_after", false).toBool());
 
   QString destination = s.value("destination").toString();
@@ -322,6 +336,7 @@ void OrganizeDialog::SaveSettings() {
   s.setValue("replace_spaces", ui_->replace_spaces->isChecked());
   s.setValue("overwrite", ui_->overwrite->isChecked());
   s.setValue("albumcover", ui_->albumcover->isChecked());
+  s.setValue("verify", ui_->verify->isChecked());
   s.setValue("destination", ui_->destination->currentText());
   s.setValue("eject_after", ui_->eject_after->isChecked());
   s.endGroup();
@@ -512,36 +527,71 @@ void OrganizeDialog::UpdatePreviews() {
   bool ok = format_valid && !songs_.isEmpty();
   if (capacity != 0 && total_size_ > free) ok = false;
 
-  if (ok) {
-    QString extension;
-#ifdef HAVE_GSTREAMER
-    if (storage && storage->GetTranscodeMode() == MusicStorage::TranscodeMode::Transcode_Always) {
-      const Song::FileType format = storage->GetTranscodeFormat();
-      TranscoderPreset preset = Transcoder::PresetForFileType(format);
-      extension = preset.extension_;
-    }
-#endif
-    new_songs_info_ = ComputeNewSongsFilenames(songs_, format_, extension);
-    if (new_songs_info_.isEmpty()) {
-      ok = false;
-    }
-  }
-  else {
+  ui_->groupbox_preview->setVisible(has_local_destination);
+  ui_->groupbox_naming->setVisible(has_local_destination);
+
+  if (!ok) {
     new_songs_info_.clear();
+    ui_->preview->clear();
+    if (devices_) AdjustSize();
+    ui_->button_box->button(QDialogButtonBox::Ok)->setEnabled(false);
+    return;
   }
 
+  QString extension;
+#ifdef HAVE_GSTREAMER
+  if (storage && storage->GetTranscodeMode() == MusicStorage::TranscodeMode::Transcode_Always) {
+    const Song::FileType format = storage->GetTranscodeFormat();
+    TranscoderPreset preset = Transcoder::PresetForFileType(format);
+    extension = preset.extension_;
+  }
+#endif
+
+  // Compute the new filenames in the background, an entire collection takes too long for the UI thread.
+  // The Ok button stays disabled until the pass for the current settings has finished.
+  const int generation = ++preview_generation_;
+  const QString local_path = has_local_destination ? storage->LocalPath() : QString();
+  ui_->button_box->button(QDialogButtonBox::Ok)->setEnabled(false);
+  QFuture<Organize::NewSongInfoList> future = QtConcurrent::run(&OrganizeDialog::ComputeNewSongsFilenames, songs_, format_, extension);
+  QFutureWatcher<Organize::NewSongInfoList> *watcher = new QFutureWatcher<Organize::NewSongInfoList>();
+  QObject::connect(watcher, &QFutureWatcher<Organize::NewSongInfoList>::finished, this, [this, watcher, generation, local_path]() {
+    UpdatePreviewsFinished(generation, local_path, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(future);
+
+}
+
+void OrganizeDialog::UpdatePreviewsFinished(const int generation, const QString &local_path, const Organize::NewSongInfoList &new_songs_info) {
+
+  // A newer update was scheduled while this one was being computed.
+  if (generation != preview_generation_) return;
+
+  new_songs_info_ = new_songs_info;
+
+  bool ok = !new_songs_info_.isEmpty();
+
   // Update the previews
   ui_->preview->clear();
-  ui_->groupbox_preview->setVisible(has_local_destination);
-  ui_->groupbox_naming->setVisible(has_local_destination);
-  if (has_local_destination) {
+  if (!local_path.isEmpty()) {
+    // Conflicts are counted over the whole list, but only the first rows are materialized as items.
+    qsizetype conflicts = 0;
     for (const Organize::NewSongInfo &song_info : new_songs_info_) {
-      QString filename = storage->LocalPath() + QLatin1Char('/') + song_info.new_filename_;
-      QListWidgetItem *item = new QListWidgetItem(song_info.unique_filename_ ? IconLoader::Load(QStringLiteral("dialog-ok-apply")) : IconLoader::Load(QStringLiteral("dialog-warning")), QDir::toNativeSeparators(filename), ui_->preview);
-      ui_->preview->addItem(item);
-      if (!song_info.unique_filename_) {
-        ok = false;
-      }
+      if (!song_info.unique_filename_) ++conflicts;
+    }
+    if (conflicts > 0) {
+      ok = false;
+      new QListWidgetItem(IconLoader::Load(QStringLiteral("dialog-warning")), tr("%1 files would overwrite each other.").arg(conflicts), ui_->preview);
+    }
+    qsizetype shown = 0;
+    for (const Organize::NewSongInfo &song_info : new_songs_info_) {
+      if (shown >= kMaxPreviewRows) break;
+      QString filename = local_path + QLatin1Char('/') + song_info.new_filename_;
+      new QListWidgetItem(song_info.unique_filename_ ? IconLoader::Load(QStringLiteral("dialog-ok-apply")) : IconLoader::Load(QStringLiteral("dialog-warning")), QDir::toNativeSeparators(filename), ui_->preview);
+      ++shown;
+    }
+    if (new_songs_info_.count() > shown) {
+      new QListWidgetItem(tr("%1 more files...").arg(new_songs_info_.count() - shown), ui_->preview);
     }
   }
 
@@ -553,6 +603,10 @@ void OrganizeDialog::UpdatePreviews() {
 
 }
 
+void OrganizeDialog::SchedulePreviewUpdate() {
+  preview_update_timer_->start();
+}
+
 void OrganizeDialog::OrganizeFinished(const QStringList &files_with_errors, const QStringList &log) {
 
   if (files_with_errors.isEmpty()) return;
@@ -42,6 +42,7 @@
 #include "organizeformat.h"
 
 class QAbstractItemModel;
+class QTimer;
 class QWidget;
 class QResizeEvent;
 class QShowEvent;
@@ -86,6 +87,9 @@ class OrganizeDialog : public QDialog {
   static SongList LoadSongsBlocking(const QStringList &filenames);
   void SetLoadingSongs(const bool loading);
 
+  // Called when a background preview pass finishes. Results from passes that have been superseded are dropped.
+  void UpdatePreviewsFinished(const int generation, const QString &local_path, const Organize::NewSongInfoList &new_songs_info);
+
  signals:
   void FileCopied(const int);
 
@@ -98,6 +102,7 @@ class OrganizeDialog : public QDialog {
   void RestoreDefaults();
 
   void InsertTag(const QString &tag);
+  void SchedulePreviewUpdate();
   void UpdatePreviews();
 
   void OrganizeFinished(const QStringList &files_with_errors, const QStringList &log);
@@ -121,6 +126,11 @@ class OrganizeDialog : public QDialog {
   ScopedPtr<OrganizeErrorDialog> error_dialog_;
 
   bool devices_;
+
+  // Coalesces the preview updates triggered by every keystroke in the naming field.
+  QTimer *preview_update_timer_;
+  // Incremented for every preview pass, so stale results from superseded passes are dropped.
+  int preview_generation_;
 };
 
 #endif  // ORGANISEDIALOG_H
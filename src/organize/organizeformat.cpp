@@ -46,6 +46,13 @@
 namespace {
 constexpr char kBlockPattern[] = "\\{([^{}]+)\\}";
 constexpr char kTagPattern[] = "\\%([a-zA-Z]*)";
+
+// The sanitization expressions are compiled once and shared by every evaluation, instead of being rebuilt per file.
+const QRegularExpression kRegexProblematicCharacters(QLatin1String(kProblematicCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption);
+const QRegularExpression kRegexInvalidFatCharacters(QLatin1String(kInvalidFatCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption);
+const QRegularExpression kRegexInvalidDirCharacters(QLatin1String(kInvalidDirCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption);
+const QRegularExpression kRegexThePrefix(QStringLiteral("^the\\s+"), QRegularExpression::PatternOption::CaseInsensitiveOption);
+const QRegularExpression kRegexWhitespace(QStringLiteral("\\s"));
 }
 
 const QStringList OrganizeFormat::kKnownTags = QStringList() << QStringLiteral("title")
@@ -69,9 +76,6 @@ const QStringList OrganizeFormat::kKnownTags = QStringList() << QStringLiteral("
                                                              << QStringLiteral("grouping")
                                                              << QStringLiteral("lyrics");
 
-const QStringList OrganizeFormat::kUniqueTags = QStringList() << QStringLiteral("title")
-                                                              << QStringLiteral("track");
-
 const QRgb OrganizeFormat::SyntaxHighlighter::kValidTagColorLight = qRgb(64, 64, 255);
 const QRgb OrganizeFormat::SyntaxHighlighter::kInvalidTagColorLight = qRgb(255, 64, 64);
 const QRgb OrganizeFormat::SyntaxHighlighter::kBlockColorLight = qRgb(230, 230, 230);
@@ -86,11 +90,102 @@ OrganizeFormat::OrganizeFormat(const QString &format)
       remove_non_fat_(false),
       remove_non_ascii_(false),
       allow_ascii_ext_(false),
-      replace_spaces_(true) {}
+      replace_spaces_(true) {
+
+  Compile();
+
+}
 
 void OrganizeFormat::set_format(const QString &v) {
+
   format_ = v;
   format_.replace(QLatin1Char('\\'), QLatin1Char('/'));
+
+  Compile();
+
+}
+
+OrganizeFormat::Token::Tag OrganizeFormat::TagCodeFromName(const QString &name) {
+
+  if (name == QLatin1String("title")) return Token::Tag::Title;
+  if (name == QLatin1String("album")) return Token::Tag::Album;
+  if (name == QLatin1String("artist")) return Token::Tag::Artist;
+  if (name == QLatin1String("artistinitial")) return Token::Tag::ArtistInitial;
+  if (name == QLatin1String("albumartist")) return Token::Tag::AlbumArtist;
+  if (name == QLatin1String("composer")) return Token::Tag::Composer;
+  if (name == QLatin1String("track")) return Token::Tag::Track;
+  if (name == QLatin1String("disc")) return Token::Tag::Disc;
+  if (name == QLatin1String("year")) return Token::Tag::Year;
+  if (name == QLatin1String("originalyear")) return Token::Tag::OriginalYear;
+  if (name == QLatin1String("genre")) return Token::Tag::Genre;
+  if (name == QLatin1String("comment")) return Token::Tag::Comment;
+  if (name == QLatin1String("length")) return Token::Tag::Length;
+  if (name == QLatin1String("bitrate")) return Token::Tag::Bitrate;
+  if (name == QLatin1String("samplerate")) return Token::Tag::Samplerate;
+  if (name == QLatin1String("bitdepth")) return Token::Tag::Bitdepth;
+  if (name == QLatin1String("extension")) return Token::Tag::Extension;
+  if (name == QLatin1String("performer")) return Token::Tag::Performer;
+  if (name == QLatin1String("grouping")) return Token::Tag::Grouping;
+  if (name == QLatin1String("lyrics")) return Token::Tag::Lyrics;
+
+  return Token::Tag::Unknown;
+
+}
+
+void OrganizeFormat::CompileTags(const QString &text, QList<Token> &tokens) {
+
+  static const QRegularExpression tag_regexp(QString::fromLatin1(kTagPattern));
+
+  qint64 pos = 0;
+  QRegularExpressionMatch re_match;
+  for (re_match = tag_regexp.match(text, pos); re_match.hasMatch(); re_match = tag_regexp.match(text, pos)) {
+    if (re_match.capturedStart() > pos) {
+      Token literal;
+      literal.type = Token::Type::Literal;
+      literal.literal = text.mid(pos, re_match.capturedStart() - pos);
+      tokens << literal;
+    }
+    Token tag;
+    tag.type = Token::Type::Tag;
+    tag.tag = TagCodeFromName(re_match.captured(1));
+    tokens << tag;
+    pos = re_match.capturedEnd();
+  }
+  if (pos < text.length()) {
+    Token literal;
+    literal.type = Token::Type::Literal;
+    literal.literal = text.mid(pos);
+    tokens << literal;
+  }
+
+}
+
+void OrganizeFormat::Compile() {
+
+  static const QRegularExpression block_regexp(QString::fromLatin1(kBlockPattern));
+
+  compiled_.clear();
+
+  qint64 pos = 0;
+  QRegularExpressionMatch re_match;
+  for (re_match = block_regexp.match(format_, pos); re_match.hasMatch(); re_match = block_regexp.match(format_, pos)) {
+    if (re_match.capturedStart() > pos) {
+      Segment segment;
+      CompileTags(format_.mid(pos, re_match.capturedStart() - pos), segment.tokens);
+      if (!segment.tokens.isEmpty()) compiled_ << segment;
+    }
+    Segment block;
+    block.is_block = true;
+    CompileTags(re_match.captured(1), block.tokens);
+    compiled_ << block;
+    pos = re_match.capturedEnd();
+  }
+  if (pos < format_.length()) {
+    Segment segment;
+    CompileTags(format_.mid(pos), segment.tokens);
+    if (!segment.tokens.isEmpty()) compiled_ << segment;
+  }
+
 }
 
 bool OrganizeFormat::IsValid() const {
@@ -106,7 +201,46 @@ bool OrganizeFormat::IsValid() const {
 OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(const Song &song, QString extension) const {
 
   bool unique_filename = false;
-  QString filepath = ParseBlock(format_, song, &unique_filename);
+  QString filepath;
+  filepath.reserve(format_.length() + 64);
+
+  for (const Segment &segment : compiled_) {
+    if (segment.is_block) {
+      // A block is dropped whole if any tag inside it resolves empty.
+      QString block_value;
+      bool empty = false;
+      for (const Token &token : segment.tokens) {
+        if (token.type == Token::Type::Literal) {
+          block_value += token.literal;
+        }
+        else {
+          const QString value = TagValue(token.tag, song);
+          if (value.isEmpty()) {
+            empty = true;
+          }
+          else if (token.tag == Token::Tag::Title || token.tag == Token::Tag::Track) {
+            unique_filename = true;
+          }
+          block_value += value;
+        }
+      }
+      if (!empty) filepath += block_value;
+    }
+    else {
+      for (const Token &token : segment.tokens) {
+        if (token.type == Token::Type::Literal) {
+          filepath += token.literal;
+        }
+        else {
+          const QString value = TagValue(token.tag, song);
+          if (!value.isEmpty() && (token.tag == Token::Tag::Title || token.tag == Token::Tag::Track)) {
+            unique_filename = true;
+          }
+          filepath += value;
+        }
+      }
+    }
+  }
 
   if (filepath.isEmpty()) {
     filepath = song.basefilename();
@@ -133,9 +267,9 @@ OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(cons
     return GetFilenameForSongResult();
   }
 
-  if (remove_problematic_) filepath = filepath.remove(QRegularExpression(QLatin1String(kProblematicCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption));
+  if (remove_problematic_) filepath = filepath.remove(kRegexProblematicCharacters);
   if (remove_non_fat_ || (remove_non_ascii_ && !allow_ascii_ext_)) filepath = Utilities::Transliterate(filepath);
-  if (remove_non_fat_) filepath = filepath.remove(QRegularExpression(QLatin1String(kInvalidFatCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption));
+  if (remove_non_fat_) filepath = filepath.remove(kRegexInvalidFatCharacters);
 
   if (remove_non_ascii_) {
     int ascii = 128;
@@ -192,7 +326,7 @@ OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(cons
   }
   filepath = parts_new.join(QLatin1Char('/'));
 
-  if (replace_spaces_) filepath.replace(QRegularExpression(QStringLiteral("\\s")), QStringLiteral("_"));
+  if (replace_spaces_) filepath.replace(kRegexWhitespace, QStringLiteral("_"));
 
   if (!extension.isEmpty()) {
     filepath.append(QStringLiteral(".%1").arg(extension));
@@ -202,127 +336,86 @@ OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(cons
 
 }
 
-QString OrganizeFormat::ParseBlock(QString block, const Song &song, bool *have_tagdata, bool *any_empty) const {
-
-  // Find any blocks first
-  qint64 pos = 0;
-  const QRegularExpression block_regexp(QString::fromLatin1(kBlockPattern));
-  QRegularExpressionMatch re_match;
-  for (re_match = block_regexp.match(block, pos); re_match.hasMatch(); re_match = block_regexp.match(block, pos)) {
-    pos = re_match.capturedStart();
-    // Recursively parse the block
-    bool empty = false;
-    QString value = ParseBlock(re_match.captured(1), song, have_tagdata, &empty);
-    if (empty) value = QLatin1String("");
-
-    // Replace the block's value
-    block.replace(pos, re_match.capturedLength(), value);
-    pos += value.length();
-  }
-
-  // Now look for tags
-  bool empty = false;
-  pos = 0;
-  const QRegularExpression tag_regexp(QString::fromLatin1(kTagPattern));
-  for (re_match = tag_regexp.match(block, pos); re_match.hasMatch(); re_match = tag_regexp.match(block, pos)) {
-    pos = re_match.capturedStart();
-    const QString tag = re_match.captured(1);
-    const QString value = TagValue(tag, song);
-    if (value.isEmpty()) {
-      empty = true;
-    }
-    else if (have_tagdata && kUniqueTags.contains(tag)) {
-      *have_tagdata = true;
-    }
-
-    block.replace(pos, re_match.capturedLength(), value);
-    pos += value.length();
-  }
-
-  if (any_empty) {
-    *any_empty = empty;
-  }
-
-  return block;
-
-}
-
-QString OrganizeFormat::TagValue(const QString &tag, const Song &song) const {
+QString OrganizeFormat::TagValue(const Token::Tag tag, const Song &song) const {
 
   QString value;
 
-  if (tag == QLatin1String("title")) {
-    value = song.title();
-  }
-  else if (tag == QLatin1String("album")) {
-    value = song.album();
-  }
-  else if (tag == QLatin1String("artist")) {
-    value = song.artist();
-  }
-  else if (tag == QLatin1String("composer")) {
-    value = song.composer();
-  }
-  else if (tag == QLatin1String("performer")) {
-    value = song.performer();
-  }
-  else if (tag == QLatin1String("grouping")) {
-    value = song.grouping();
-  }
-  else if (tag == QLatin1String("lyrics")) {
-    value = song.lyrics();
-  }
-  else if (tag == QLatin1String("genre")) {
-    value = song.genre();
-  }
-  else if (tag == QLatin1String("comment")) {
-    value = song.comment();
-  }
-  else if (tag == QLatin1String("year")) {
-    value = QString::number(song.year());
-  }
-  else if (tag == QLatin1String("originalyear")) {
-    value = QString::number(song.effective_originalyear());
-  }
-  else if (tag == QLatin1String("track")) {
-    value = QString::number(song.track());
-  }
-  else if (tag == QLatin1String("disc")) {
-    value = QString::number(song.disc());
-  }
-  else if (tag == QLatin1String("length")) {
-    value = QString::number(song.length_nanosec() / kNsecPerSec);
-  }
-  else if (tag == QLatin1String("bitrate")) {
-    value = QString::number(song.bitrate());
-  }
-  else if (tag == QLatin1String("samplerate")) {
-    value = QString::number(song.samplerate());
-  }
-  else if (tag == QLatin1String("bitdepth")) {
-    value = QString::number(song.bitdepth());
-  }
-  else if (tag == QLatin1String("extension")) {
-    value = QFileInfo(song.url().toLocalFile()).suffix();
-  }
-  else if (tag == QLatin1String("artistinitial")) {
-    value = song.effective_albumartist().trimmed();
-    if (!value.isEmpty()) {
-      value.replace(QRegularExpression(QStringLiteral("^the\\s+"), QRegularExpression::CaseInsensitiveOption), QLatin1String(""));
-      value = value[0].toUpper();
-    }
-  }
-  else if (tag == QLatin1String("albumartist")) {
-    value = song.is_compilation() ? QStringLiteral("Various Artists") : song.effective_albumartist();
+  switch (tag) {
+    case Token::Tag::Title:
+      value = song.title();
+      break;
+    case Token::Tag::Album:
+      value = song.album();
+      break;
+    case Token::Tag::Artist:
+      value = song.artist();
+      break;
+    case Token::Tag::Composer:
+      value = song.composer();
+      break;
+    case Token::Tag::Performer:
+      value = song.performer();
+      break;
+    case Token::Tag::Grouping:
+      value = song.grouping();
+      break;
+    case Token::Tag::Lyrics:
+      value = song.lyrics();
+      break;
+    case Token::Tag::Genre:
+      value = song.genre();
+      break;
+    case Token::Tag::Comment:
+      value = song.comment();
+      break;
+    case Token::Tag::Year:
+      value = QString::number(song.year());
+      break;
+    case Token::Tag::OriginalYear:
+      value = QString::number(song.effective_originalyear());
+      break;
+    case Token::Tag::Track:
+      value = QString::number(song.track());
+      break;
+    case Token::Tag::Disc:
+      value = QString::number(song.disc());
+      break;
+    case Token::Tag::Length:
+      value = QString::number(song.length_nanosec() / kNsecPerSec);
+      break;
+    case Token::Tag::Bitrate:
+      value = QString::number(song.bitrate());
+      break;
+    case Token::Tag::Samplerate:
+      value = QString::number(song.samplerate());
+      break;
+    case Token::Tag::Bitdepth:
+      value = QString::number(song.bitdepth());
+      break;
+    case Token::Tag::Extension:
+      value = QFileInfo(song.url().toLocalFile()).suffix();
+      break;
+    case Token::Tag::ArtistInitial:
+      value = song.effective_albumartist().trimmed();
+      if (!value.isEmpty()) {
+        value.replace(kRegexThePrefix, QLatin1String(""));
+        value = value[0].toUpper();
+      }
+      break;
+    case Token::Tag::AlbumArtist:
+      value = song.is_compilation() ? QStringLiteral("Various Artists") : song.effective_albumartist();
+      break;
+    case Token::Tag::Unknown:
+      break;
   }
 
   if (value == QLatin1Char('0') || value == QLatin1String("-1")) value = QLatin1String("");
 
   // Prepend a 0 to single-digit track numbers
-  if (tag == QLatin1String("track") && value.length() == 1) value.prepend(QLatin1Char('0'));
+  if (tag == Token::Tag::Track && value.length() == 1) value.prepend(QLatin1Char('0'));
 
   // Replace characters that really shouldn't be in paths
-  value = value.remove(QRegularExpression(QString::fromLatin1(kInvalidDirCharactersRegex), QRegularExpression::PatternOption::CaseInsensitiveOption));
+  value = value.remove(kRegexInvalidDirCharacters);
   if (remove_problematic_) value = value.remove(QLatin1Char('.'));
   value = value.trimmed();
 
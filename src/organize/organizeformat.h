@@ -24,6 +24,7 @@
 
 #include "config.h"
 
+#include <QList>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -86,12 +87,28 @@ class OrganizeFormat {
 
  private:
   static const QStringList kKnownTags;
-  static const QStringList kUniqueTags;
 
-  QString ParseBlock(QString block, const Song &song, bool *have_tagdata = nullptr, bool *any_empty = nullptr) const;
-  QString TagValue(const QString &tag, const Song &song) const;
+  // The format string is tokenized once in Compile() when it is set; GetFilenameForSong() walks the tokens with pre-resolved field accessors instead of re-parsing the pattern per song.
+  struct Token {
+    enum class Type { Literal, Tag };
+    enum class Tag { Title, Album, Artist, ArtistInitial, AlbumArtist, Composer, Track, Disc, Year, OriginalYear, Genre, Comment, Length, Bitrate, Samplerate, Bitdepth, Extension, Performer, Grouping, Lyrics, Unknown };
+    Type type = Type::Literal;
+    Tag tag = Tag::Unknown;
+    QString literal;
+  };
+  // One {…} conditional block, or a run of top-level tokens when is_block is false. Blocks whose tags all resolve empty are dropped whole.
+  struct Segment {
+    bool is_block = false;
+    QList<Token> tokens;
+  };
+
+  void Compile();
+  static Token::Tag TagCodeFromName(const QString &name);
+  static void CompileTags(const QString &text, QList<Token> &tokens);
+  QString TagValue(const Token::Tag tag, const Song &song) const;
 
   QString format_;
+  QList<Segment> compiled_;
   bool remove_problematic_;
   bool remove_non_fat_;
   bool remove_non_ascii_;
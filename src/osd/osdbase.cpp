@@ -23,6 +23,9 @@
 
 #include <QObject>
 #include <QCoreApplication>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QString>
 #include <QStringList>
 #include <QImage>
@@ -128,6 +131,22 @@ void OSDBase::AlbumCoverLoaded(const Song &song, const QUrl &cover_url, const QI
   last_image_ = image;
   last_image_uri_ = cover_url;
 
+  // When the pretty OSD is going to show the cover, scale it on the thread pool first so showing the popup does not hitch the UI thread.
+  if (show_art_ && !image.isNull() && (behaviour_ == Behaviour::Pretty || pretty_popup_->toggle_mode())) {
+    const qreal device_pixel_ratio = pretty_popup_->devicePixelRatioF();
+    QFuture<QImage> future = QtConcurrent::run([image, device_pixel_ratio]() { return OSDPretty::ScaleImageForIcon(image, device_pixel_ratio); });
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, song, cover_url]() {
+      const QImage scaled_image = watcher->result();
+      watcher->deleteLater();
+      // The track can have changed while the cover was being scaled.
+      if (song != song_playing_) return;
+      ShowPlaying(song, cover_url, scaled_image);
+    });
+    watcher->setFuture(future);
+    return;
+  }
+
   ShowPlaying(song, cover_url, image);
 
 }
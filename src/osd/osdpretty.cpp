@@ -343,11 +343,24 @@ void OSDPretty::paintEvent(QPaintEvent*) {
 
 }
 
+QImage OSDPretty::ScaleImageForIcon(const QImage &image, const qreal device_pixel_ratio) {
+
+  QImage scaled_image = image.scaled(static_cast<int>(kMaxIconSize * device_pixel_ratio), static_cast<int>(kMaxIconSize * device_pixel_ratio), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  scaled_image.setDevicePixelRatio(device_pixel_ratio);
+
+  return scaled_image;
+
+}
+
 void OSDPretty::SetMessage(const QString &summary, const QString &message, const QImage &image) {
 
   if (!image.isNull()) {
-    QImage scaled_image = image.scaled(static_cast<int>(kMaxIconSize * devicePixelRatioF()), static_cast<int>(kMaxIconSize * devicePixelRatioF()), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    scaled_image.setDevicePixelRatio(devicePixelRatioF());
+    QImage scaled_image = image;
+    // Skip the smooth scale when the image was already scaled for us on a worker thread.
+    const int max_size = static_cast<int>(kMaxIconSize * devicePixelRatioF());
+    if (!qFuzzyCompare(scaled_image.devicePixelRatio(), devicePixelRatioF()) || (scaled_image.width() != max_size && scaled_image.height() != max_size)) {
+      scaled_image = ScaleImageForIcon(image, devicePixelRatioF());
+    }
     ui_->icon->setPixmap(QPixmap::fromImage(scaled_image));
     ui_->icon->show();
   }
@@ -73,6 +73,10 @@ class OSDPretty : public QWidget {
 
   bool IsTransparencyAvailable();
 
+  // Scales a cover down to the icon size used by the OSD.
+  // Safe to call from any thread, so the expensive smooth scale can be done on a worker before the OSD is shown.
+  static QImage ScaleImageForIcon(const QImage &image, const qreal device_pixel_ratio);
+
   void SetMessage(const QString &summary, const QString &message, const QImage &image);
   void ShowMessage(const QString &summary, const QString &message, const QImage &image);
 
@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <algorithm>
 #include <functional>
 #include <unordered_map>
@@ -47,6 +48,7 @@
 #include <QVariant>
 #include <QString>
 #include <QStringList>
+#include <QCollator>
 #include <QUrl>
 #include <QFont>
 #include <QBrush>
@@ -78,6 +80,7 @@
 #include "playlistbackend.h"
 #include "playlistfilter.h"
 #include "playlistitemmimedata.h"
+#include "playlistmutationjournal.h"
 #include "playlistundocommands.h"
 #include "songloaderinserter.h"
 #include "songmimedata.h"
@@ -117,6 +120,10 @@ constexpr qint64 kMaxScrobblePointNsecs = 240LL * kNsecPerSec;
 
 constexpr int kMaxPlayedIndexes = 100;
 
+// Inserts of at least this many songs build their playlist items on a worker thread and stream them into the model in chunks of kAsyncInsertChunkSize rows, so the UI stays responsive.
+constexpr int kAsyncInsertThreshold = 5000;
+constexpr int kAsyncInsertChunkSize = 1000;
+
 } // namespace
 
 Playlist::Playlist(SharedPtr<PlaylistBackend> backend, SharedPtr<TaskManager> task_manager, SharedPtr<CollectionBackend> collection_backend, const int id, const QString &special_type, const bool favorite, QObject *parent)
@@ -137,6 +144,7 @@ Playlist::Playlist(SharedPtr<PlaylistBackend> backend, SharedPtr<TaskManager> ta
       undo_stack_(new QUndoStack(this)),
       special_type_(special_type),
       cancel_restore_(false),
+      insert_generation_(0),
       scrobbled_(false),
       scrobble_point_(-1),
       auto_sort_(false),
@@ -177,6 +185,26 @@ Playlist::~Playlist() {
 template<typename T>
 void Playlist::InsertSongItems(const SongList &songs, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next) {
 
+  // For large drops, build the items on a worker thread and stream them into the model in bounded chunks instead of freezing the UI with one giant insert.
+  if (songs.count() >= kAsyncInsertThreshold) {
+    QFuture<PlaylistItemPtrList> future = QtConcurrent::run([songs]() {
+      PlaylistItemPtrList items;
+      items.reserve(songs.count());
+      for (const Song &song : songs) {
+        items << make_shared<T>(song);
+      }
+      return items;
+    });
+    QFutureWatcher<PlaylistItemPtrList> *watcher = new QFutureWatcher<PlaylistItemPtrList>();
+    QObject::connect(watcher, &QFutureWatcher<PlaylistItemPtrList>::finished, this, [this, watcher, pos, play_now, enqueue, enqueue_next]() {
+      const PlaylistItemPtrList items = watcher->result();
+      watcher->deleteLater();
+      InsertItemsChunked(items, pos, play_now, enqueue, enqueue_next);
+    });
+    watcher->setFuture(future);
+    return;
+  }
+
   PlaylistItemPtrList items;
   items.reserve(songs.count());
   for (const Song &song : songs) {
@@ -624,6 +652,27 @@ int Playlist::next_row(const bool ignore_repeat_track) {
 
 }
 
+QList<int> Playlist::next_rows(const int count) {
+
+  QList<int> rows;
+
+  // Any queued items take priority
+  for (int i = 0; i < queue_->rowCount() && rows.count() < count; ++i) {
+    rows << queue_->mapToSource(queue_->index(i, 0)).row();
+  }
+
+  // Walk the virtual indexes the same way NextVirtualIndex() advances them, but without reshuffling or wrapping - those decisions are only made when the track actually changes.
+  int virtual_index = current_virtual_index_;
+  while (rows.count() < count) {
+    virtual_index = NextVirtualIndex(virtual_index, true);
+    if (virtual_index < 0 || virtual_index >= virtual_items_.count()) break;
+    rows << virtual_items_[virtual_index];
+  }
+
+  return rows;
+
+}
+
 int Playlist::previous_row(const bool ignore_repeat_track) {
 
   while (!played_indexes_.isEmpty()) {
@@ -937,6 +986,10 @@ void Playlist::MoveItemWithoutUndo(const int source, const int dest) {
 
 void Playlist::MoveItemsWithoutUndo(const QList<int> &source_rows, int pos) {
 
+  if (!is_loading_ && id_ > 0) {
+    PlaylistMutationJournal::RecordMove(id_, source_rows, pos);
+  }
+
   emit layoutAboutToBeChanged();
 
   PlaylistItemPtrList old_items = items_;
@@ -984,10 +1037,7 @@ void Playlist::MoveItemsWithoutUndo(const QList<int> &source_rows, int pos) {
 
   // Update virtual items
   if (ShuffleMode() != PlaylistSequence::ShuffleMode::Off) {
-    const QList<int> old_virtual_items = virtual_items_;
-    for (int i = 0; i < virtual_items_.count(); ++i) {
-      virtual_items_[i] = static_cast<int>(items_.indexOf(old_items[old_virtual_items[i]]));
-    }
+    RemapVirtualItems(old_items);
   }
 
   // Update current virtual index
@@ -1006,6 +1056,10 @@ void Playlist::MoveItemsWithoutUndo(const QList<int> &source_rows, int pos) {
 
 void Playlist::MoveItemsWithoutUndo(int start, const QList<int> &dest_rows) {
 
+  if (!is_loading_ && id_ > 0) {
+    PlaylistMutationJournal::RecordMoveInverse(id_, start, dest_rows);
+  }
+
   emit layoutAboutToBeChanged();
 
   PlaylistItemPtrList old_items = items_;
@@ -1056,10 +1110,7 @@ void Playlist::MoveItemsWithoutUndo(int start, const QList<int> &dest_rows) {
 
   // Update virtual items
   if (ShuffleMode() != PlaylistSequence::ShuffleMode::Off) {
-    const QList<int> old_virtual_items = virtual_items_;
-    for (int i = 0; i < virtual_items_.count(); ++i) {
-      virtual_items_[i] = static_cast<int>(items_.indexOf(old_items[old_virtual_items[i]]));
-    }
+    RemapVirtualItems(old_items);
   }
 
   // Update current virtual index
@@ -1104,6 +1155,24 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   if (items.isEmpty()) return;
 
   const int start = pos == -1 ? static_cast<int>(items_.count()) : pos;
+
+  if (!is_loading_ && id_ > 0) {
+    SongList songs;
+    songs.reserve(items.count());
+    for (const PlaylistItemPtr &item : items) {
+      songs << item->Metadata();
+    }
+    PlaylistMutationJournal::RecordInsert(id_, start, songs);
+  }
+
+  InsertItemRows(items, start);
+
+  FinishInsert(start, start + static_cast<int>(items.count()) - 1, enqueue, enqueue_next);
+
+}
+
+void Playlist::InsertItemRows(const PlaylistItemPtrList &items, const int start) {
+
   const int end = start + static_cast<int>(items.count()) - 1;
 
   beginInsertRows(QModelIndex(), start, end);
@@ -1127,6 +1196,10 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   }
   endInsertRows();
 
+}
+
+void Playlist::FinishInsert(const int start, const int end, const bool enqueue, const bool enqueue_next) {
+
   if (enqueue) {
     QModelIndexList indexes;
     for (int i = start; i <= end; ++i) {
@@ -1153,6 +1226,59 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
 
 }
 
+void Playlist::InsertItemsChunked(const PlaylistItemPtrList &items, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next, std::function<void()> done) {
+
+  if (items.isEmpty()) {
+    if (done) done();
+    return;
+  }
+
+  // Always too big to keep in the undo stack, so clear it like the oversized path in InsertItems() does.
+  undo_stack_->clear();
+
+  SharedPtr<AsyncInsertState> state = make_shared<AsyncInsertState>();
+  state->items = items;
+  state->pos = pos;
+  state->play_now = play_now;
+  state->enqueue = enqueue;
+  state->enqueue_next = enqueue_next;
+  state->generation = insert_generation_;
+  state->done = std::move(done);
+
+  InsertNextChunk(state);
+
+}
+
+void Playlist::InsertNextChunk(SharedPtr<AsyncInsertState> state) {
+
+  // The playlist was cleared while items were still streaming in, abandon the remaining chunks.
+  if (state->generation != insert_generation_) {
+    if (state->done) state->done();
+    return;
+  }
+
+  // Clamp against the current row count because rows may have been inserted or removed between chunks.
+  const int start = state->pos == -1 ? static_cast<int>(items_.count()) : qMin(state->pos + state->offset, static_cast<int>(items_.count()));
+
+  InsertItemRows(state->items.mid(state->offset, kAsyncInsertChunkSize), start);
+
+  if (state->offset == 0) {
+    state->start = start;
+    if (state->play_now) emit PlayRequested(index(start, 0), AutoScroll::Maybe);
+  }
+
+  state->offset = qMin(state->offset + kAsyncInsertChunkSize, static_cast<int>(state->items.count()));
+
+  if (state->offset < state->items.count()) {
+    QMetaObject::invokeMethod(this, [this, state]() { InsertNextChunk(state); }, Qt::QueuedConnection);
+  }
+  else {
+    FinishInsert(state->start, qMin(state->start + static_cast<int>(state->items.count()), rowCount()) - 1, state->enqueue, state->enqueue_next);
+    if (state->done) state->done();
+  }
+
+}
+
 void Playlist::InsertCollectionItems(const SongList &songs, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next) {
   InsertSongItems<CollectionPlaylistItem>(songs, pos, play_now, enqueue, enqueue_next);
 }
@@ -1214,55 +1340,64 @@ void Playlist::UpdateItems(SongList songs) {
 
   qLog(Debug) << "Updating playlist with new tracks' info";
 
-  // We first convert our songs list into a linked list (a 'real' list), because removals are faster with QLinkedList.
-  // Next, we walk through the list of playlist's items then the list of songs
-  // we want to update: if an item corresponds to the song (we rely on URL for this), we update the item with the new metadata,
-  // then we remove song from our list because we will not need to check it again.
-  // And we also update undo actions.
+  // Index the loaded songs by URL first, so matching them against the playlist is one pass over the items instead of rescanning the whole songs list per item.
+  // Each loaded song still updates only one item (songs are consumed front to back), matching the old behavior for playlists with duplicate URLs.
+  QHash<QUrl, QList<Song>> songs_by_url;
+  for (const Song &song : std::as_const(songs)) {
+    songs_by_url[song.url()] << song;
+  }
+
+  QList<int> changed_rows;
 
   for (int i = 0; i < items_.size(); i++) {
-    // Update current items list
-    QMutableListIterator<Song> it(songs);
-    while (it.hasNext()) {
-      const Song &song = it.next();
-      const PlaylistItemPtr &item = items_[i];
-      if (item->Metadata().url() == song.url() && (item->Metadata().filetype() == Song::FileType::Unknown || item->Metadata().filetype() == Song::FileType::Stream || item->Metadata().filetype() == Song::FileType::CDDA || !item->Metadata().init_from_file())) {
-        PlaylistItemPtr new_item;
-        if (song.url().isLocalFile()) {
-          if (song.is_collection_song()) {
-            new_item = make_shared<CollectionPlaylistItem>(song);
-            if (collection_items_by_id_.contains(song.id(), item)) collection_items_by_id_.remove(song.id(), item);
-            collection_items_by_id_.insert(song.id(), new_item);
-          }
-          else {
-            new_item = make_shared<SongPlaylistItem>(song);
-          }
-        }
-        else {
-          if (song.is_radio()) {
-            new_item = make_shared<RadioPlaylistItem>(song);
-          }
-          else {
-            new_item = make_shared<StreamPlaylistItem>(song);
-          }
-        }
-        items_[i] = new_item;
-        emit dataChanged(index(i, 0), index(i, ColumnCount - 1));
-        // Also update undo actions
-        for (int y = 0; y < undo_stack_->count(); y++) {
-          QUndoCommand *undo_action = const_cast<QUndoCommand*>(undo_stack_->command(i));
-          PlaylistUndoCommands::InsertItems *undo_action_insert = dynamic_cast<PlaylistUndoCommands::InsertItems*>(undo_action);
-          if (undo_action_insert) {
-            bool found_and_updated = undo_action_insert->UpdateItem(new_item);
-            if (found_and_updated) break;
-          }
-        }
-        it.remove();
-        break;
+    const PlaylistItemPtr &item = items_[i];
+    if (item->Metadata().filetype() != Song::FileType::Unknown && item->Metadata().filetype() != Song::FileType::Stream && item->Metadata().filetype() != Song::FileType::CDDA && item->Metadata().init_from_file()) {
+      continue;
+    }
+    const QHash<QUrl, QList<Song>>::iterator it = songs_by_url.find(item->Metadata().url());
+    if (it == songs_by_url.end()) continue;
+    const Song song = it.value().takeFirst();
+    if (it.value().isEmpty()) songs_by_url.erase(it);
+    PlaylistItemPtr new_item;
+    if (song.url().isLocalFile()) {
+      if (song.is_collection_song()) {
+        new_item = make_shared<CollectionPlaylistItem>(song);
+        if (collection_items_by_id_.contains(song.id(), item)) collection_items_by_id_.remove(song.id(), item);
+        collection_items_by_id_.insert(song.id(), new_item);
+      }
+      else {
+        new_item = make_shared<SongPlaylistItem>(song);
+      }
+    }
+    else {
+      if (song.is_radio()) {
+        new_item = make_shared<RadioPlaylistItem>(song);
+      }
+      else {
+        new_item = make_shared<StreamPlaylistItem>(song);
+      }
+    }
+    items_[i] = new_item;
+    changed_rows << i;
+    // Also update undo actions
+    for (int y = 0; y < undo_stack_->count(); y++) {
+      QUndoCommand *undo_action = const_cast<QUndoCommand*>(undo_stack_->command(y));
+      PlaylistUndoCommands::InsertItems *undo_action_insert = dynamic_cast<PlaylistUndoCommands::InsertItems*>(undo_action);
+      if (undo_action_insert) {
+        bool found_and_updated = undo_action_insert->UpdateItem(new_item);
+        if (found_and_updated) break;
       }
     }
   }
 
+  // Coalesce the repaints into one dataChanged per contiguous run of rows instead of one per item, so completing the metadata for a large streamed insert doesn't trigger thousands of view updates.
+  for (qsizetype i = 0; i < changed_rows.count();) {
+    qsizetype last = i;
+    while (last + 1 < changed_rows.count() && changed_rows.at(last + 1) == changed_rows.at(last) + 1) ++last;
+    emit dataChanged(index(changed_rows.at(i), 0), index(changed_rows.at(last), ColumnCount - 1));
+    i = last + 1;
+  }
+
   emit PlaylistChanged();
 
   ScheduleSave();
@@ -1369,6 +1504,46 @@ bool Playlist::CompareItems(const Column column, const Qt::SortOrder order, Play
 
 }
 
+bool Playlist::column_is_collated(const Playlist::Column column) {
+
+  switch (column) {
+    case Column::Title:
+    case Column::Artist:
+    case Column::Album:
+    case Column::Genre:
+    case Column::AlbumArtist:
+    case Column::Composer:
+    case Column::Performer:
+    case Column::Grouping:
+    case Column::Comment:
+    case Column::Filename:
+      return true;
+    default:
+      break;
+  }
+
+  return false;
+
+}
+
+QString Playlist::collation_text(const Playlist::Column column, const PlaylistItemPtr &item) {
+
+  switch (column) {
+    case Column::Title:       return item->Metadata().title_sortable();
+    case Column::Artist:      return item->Metadata().artist_sortable();
+    case Column::Album:       return item->Metadata().album_sortable();
+    case Column::Genre:       return item->Metadata().genre();
+    case Column::AlbumArtist: return item->Metadata().playlist_albumartist_sortable();
+    case Column::Composer:    return item->Metadata().composer();
+    case Column::Performer:   return item->Metadata().performer();
+    case Column::Grouping:    return item->Metadata().grouping();
+    case Column::Comment:     return item->Metadata().comment();
+    case Column::Filename:    return item->Url().path();
+    default:                  return QString();
+  }
+
+}
+
 bool Playlist::ComparePathDepths(const Qt::SortOrder order, PlaylistItemPtr _a, PlaylistItemPtr _b) {
 
   PlaylistItemPtr a = order == Qt::AscendingOrder ? _a : _b;
@@ -1463,17 +1638,39 @@ void Playlist::sort(const int column_number, const Qt::SortOrder order) {
   if (dynamic_playlist_ && current_item_index_.isValid())
     begin += current_item_index_.row() + 1;
 
+  // Collating inside every comparison through QString::localeAwareCompare dominates sorting large playlists,
+  // so for text columns each item's collation key is computed once up front and the sort compares the precomputed keys instead.
+  auto collated_sort = [order](const PlaylistItemPtrList::iterator sort_begin, const PlaylistItemPtrList::iterator sort_end, const Column sort_column) {
+    QCollator collator;
+    std::vector<std::pair<QCollatorSortKey, PlaylistItemPtr>> keyed_items;
+    keyed_items.reserve(static_cast<std::size_t>(sort_end - sort_begin));
+    for (PlaylistItemPtrList::iterator it = sort_begin; it != sort_end; ++it) {
+      keyed_items.emplace_back(collator.sortKey(collation_text(sort_column, *it).toLower()), *it);
+    }
+    std::stable_sort(keyed_items.begin(), keyed_items.end(), [order](const std::pair<QCollatorSortKey, PlaylistItemPtr> &a, const std::pair<QCollatorSortKey, PlaylistItemPtr> &b) {
+      return order == Qt::AscendingOrder ? a.first.compare(b.first) < 0 : b.first.compare(a.first) < 0;
+    });
+    PlaylistItemPtrList::iterator it = sort_begin;
+    for (const std::pair<QCollatorSortKey, PlaylistItemPtr> &keyed_item : keyed_items) {
+      *it = keyed_item.second;
+      ++it;
+    }
+  };
+
   if (column == Column::Album) {
     // When sorting by album, also take into account discs and tracks.
     std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Track, order, std::placeholders::_1, std::placeholders::_2));
     std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Disc, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Album, order, std::placeholders::_1, std::placeholders::_2));
+    collated_sort(begin, new_items.end(), Column::Album);
   }
   else if (column == Column::Filename) {
     // When sorting by full paths we also expect a hierarchical order. This returns a breath-first ordering of paths.
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Filename, order, std::placeholders::_1, std::placeholders::_2));
+    collated_sort(begin, new_items.end(), Column::Filename);
     std::stable_sort(begin, new_items.end(), std::bind(&Playlist::ComparePathDepths, order, std::placeholders::_1, std::placeholders::_2));
   }
+  else if (column_is_collated(column)) {
+    collated_sort(begin, new_items.end(), column);
+  }
   else {
     std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, column, order, std::placeholders::_1, std::placeholders::_2));
   }
@@ -1484,6 +1681,19 @@ void Playlist::sort(const int column_number, const Qt::SortOrder order) {
 
 void Playlist::ReOrderWithoutUndo(const PlaylistItemPtrList &new_items) {
 
+  if (!is_loading_ && id_ > 0 && new_items.count() == items_.count()) {
+    QHash<const PlaylistItem*, int> old_rows;
+    for (int i = 0; i < items_.count(); ++i) {
+      old_rows[&*items_[i]] = i;
+    }
+    QList<int> permutation;
+    permutation.reserve(new_items.count());
+    for (const PlaylistItemPtr &item : new_items) {
+      permutation << old_rows.value(&*item, -1);
+    }
+    PlaylistMutationJournal::RecordReorder(id_, permutation);
+  }
+
   emit layoutAboutToBeChanged();
 
   PlaylistItemPtrList old_items = items_;
@@ -1501,10 +1711,7 @@ void Playlist::ReOrderWithoutUndo(const PlaylistItemPtrList &new_items) {
 
   // Update virtual items
   if (ShuffleMode() != PlaylistSequence::ShuffleMode::Off) {
-    const QList<int> old_virtual_items = virtual_items_;
-    for (int i = 0; i < virtual_items_.count(); ++i) {
-      virtual_items_[i] = static_cast<int>(items_.indexOf(old_items[old_virtual_items[i]]));
-    }
+    RemapVirtualItems(old_items);
   }
 
   // Update current virtual index
@@ -1606,9 +1813,36 @@ void Playlist::ItemsLoaded() {
     }
   }
 
+  // Edits that were journaled but not yet compacted into the database when the application last ran are patched in here.
+  // A save is scheduled afterwards so the database catches up and the journal is cleared.
+  bool replayed_journal = false;
+  if (PlaylistMutationJournal::HasJournal(id_)) {
+    items = PlaylistMutationJournal::Replay(id_, items);
+    replayed_journal = true;
+  }
+
   is_loading_ = true;
-  InsertItems(items, 0);
-  is_loading_ = false;
+
+  if (items.count() >= kAsyncInsertThreshold) {
+    // Stream a huge restored playlist into the model in bounded chunks so startup stays responsive.
+    InsertItemsChunked(items, 0, false, false, false, [this, replayed_journal]() {
+      is_loading_ = false;
+      if (!cancel_restore_) {
+        FinishRestore();
+        if (replayed_journal) ScheduleSave();
+      }
+    });
+  }
+  else {
+    InsertItems(items, 0);
+    is_loading_ = false;
+    FinishRestore();
+    if (replayed_journal) ScheduleSave();
+  }
+
+}
+
+void Playlist::FinishRestore() {
 
   PlaylistBackend::Playlist p = backend_->GetPlaylist(id_);
 
@@ -1730,32 +1964,38 @@ PlaylistItemPtrList Playlist::RemoveItemsWithoutUndo(const int row, const int co
     return PlaylistItemPtrList();
   }
 
+  if (!is_loading_ && id_ > 0) {
+    PlaylistMutationJournal::RecordRemove(id_, row, count);
+  }
+
   // Remove items
   beginRemoveRows(QModelIndex(), row, row + count - 1);
-  PlaylistItemPtrList ret;
-  ret.reserve(count);
-  for (int i = 0; i < count; ++i) {
-    PlaylistItemPtr item(items_.takeAt(row));
-    ret << item;
 
+  // Copy the range out and erase it in one go, instead of one takeAt() per item which shifts the tail of the list every time.
+  PlaylistItemPtrList ret = items_.mid(row, count);
+  items_.erase(items_.begin() + row, items_.begin() + row + count);
+
+  for (const PlaylistItemPtr &item : std::as_const(ret)) {
     if (item->source() == Song::Source::Collection) {
-      int id = item->Metadata().id();
+      const int id = item->Metadata().id();
       if (id != -1 && collection_items_by_id_.contains(id, item)) {
         collection_items_by_id_.remove(id, item);
       }
     }
   }
 
-  // Update virtual items
-  for (int i = row; i < items_.count() + count; ++i) {
-    Q_ASSERT(virtual_items_.count(i) == 1);
-    if (i >= row + count) {
-      virtual_items_[virtual_items_.indexOf(i)] = i - count;
+  // Update virtual items: drop the removed rows from the permutation and shift the rows above them down, in a single pass that keeps the shuffle order of the remaining rows.
+  QList<int> new_virtual_items;
+  new_virtual_items.reserve(virtual_items_.count() - count);
+  for (const int virtual_row : std::as_const(virtual_items_)) {
+    if (virtual_row >= row + count) {
+      new_virtual_items << virtual_row - count;
     }
-    else {
-      virtual_items_.removeAt(virtual_items_.indexOf(i));
+    else if (virtual_row < row) {
+      new_virtual_items << virtual_row;
     }
   }
+  virtual_items_ = new_virtual_items;
 
   endRemoveRows();
 
@@ -1852,6 +2092,9 @@ void Playlist::Clear() {
   // If loading songs from session restore async, don't insert them
   cancel_restore_ = true;
 
+  // Likewise for chunked inserts that are still streaming in
+  ++insert_generation_;
+
   const int count = static_cast<int>(items_.count());
 
   if (count > kUndoItemLimit) {
@@ -1981,6 +2224,21 @@ bool AlbumShuffleComparator(const QMap<QString, int> &album_key_positions, const
 
 }  // namespace
 
+void Playlist::RemapVirtualItems(const PlaylistItemPtrList &old_items) {
+
+  // Build a pointer to row lookup table once, so remapping the shuffle permutation after a sort or move is linear instead of one items_.indexOf() per row.
+  QHash<const PlaylistItem*, int> new_rows;
+  new_rows.reserve(static_cast<int>(items_.count()));
+  for (int i = 0; i < items_.count(); ++i) {
+    new_rows[&*items_[i]] = i;
+  }
+
+  for (int i = 0; i < virtual_items_.count(); ++i) {
+    virtual_items_[i] = new_rows.value(&*old_items[virtual_items_[i]], virtual_items_[i]);
+  }
+
+}
+
 void Playlist::ReshuffleIndices() {
 
   const PlaylistSequence::ShuffleMode shuffle_mode = ShuffleMode();
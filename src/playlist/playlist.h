@@ -24,6 +24,8 @@
 
 #include "config.h"
 
+#include <functional>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QAbstractItemModel>
@@ -149,6 +151,8 @@ class Playlist : public QAbstractListModel {
   static const int kUndoItemLimit;
 
   static bool CompareItems(const Column column, const Qt::SortOrder order, PlaylistItemPtr a, PlaylistItemPtr b);
+  static bool column_is_collated(const Column column);
+  static QString collation_text(const Column column, const PlaylistItemPtr &item);
 
   static QString column_name(const Column column);
   static QString abbreviated_column_name(const Column column);
@@ -175,6 +179,9 @@ class Playlist : public QAbstractListModel {
   void reset_last_played() { last_played_item_index_ = QPersistentModelIndex(); }
   void reset_played_indexes() { played_indexes_.clear(); }
   int next_row(const bool ignore_repeat_track = false);
+  // Returns up to count upcoming rows in playback order without advancing the playback position.
+  // Used by the player to prefetch stream URLs for upcoming streaming tracks.
+  QList<int> next_rows(const int count);
   int previous_row(const bool ignore_repeat_track = false);
 
   QModelIndex current_index() const;
@@ -331,6 +338,34 @@ class Playlist : public QAbstractListModel {
   template<typename T>
   void InsertSongItems(const SongList &songs, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next = false);
 
+  // State for an insert that streams items into the model in bounded chunks, so huge inserts don't block the UI.
+  struct AsyncInsertState {
+    AsyncInsertState() : pos(-1), start(-1), offset(0), play_now(false), enqueue(false), enqueue_next(false), generation(0) {}
+    PlaylistItemPtrList items;
+    int pos;
+    int start;
+    int offset;
+    bool play_now;
+    bool enqueue;
+    bool enqueue_next;
+    int generation;
+    std::function<void()> done;
+  };
+
+  // Inserts items in bounded beginInsertRows() chunks, yielding to the event loop between chunks.
+  // Always bypasses the undo stack, like oversized inserts in InsertItems(). Calls done (if set) when the last chunk is in.
+  void InsertItemsChunked(const PlaylistItemPtrList &items, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next, std::function<void()> done = std::function<void()>());
+  void InsertNextChunk(SharedPtr<AsyncInsertState> state);
+
+  // Remaps the shuffle permutation in virtual_items_ to the new row numbers after items_ was reordered.
+  void RemapVirtualItems(const PlaylistItemPtrList &old_items);
+
+  // The model insertion itself, and the bookkeeping (queueing, sorting, shuffling, saving) that runs once per insert.
+  void InsertItemRows(const PlaylistItemPtrList &items, const int start);
+  void FinishInsert(const int start, const int end, const bool enqueue, const bool enqueue_next);
+
+  void FinishRestore();
+
   // Modify the playlist without changing the undo stack.  These are used by our friends in PlaylistUndoCommands
   void InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const int pos, const bool enqueue = false, const bool enqueue_next = false);
   PlaylistItemPtrList RemoveItemsWithoutUndo(const int row, const int count);
@@ -403,6 +438,9 @@ class Playlist : public QAbstractListModel {
   // Cancel async restore if songs are already replaced
   bool cancel_restore_;
 
+  // Bumped whenever the playlist is cleared, so in-flight chunked inserts know to abandon their remaining chunks
+  int insert_generation_;
+
   bool scrobbled_;
   qint64 scrobble_point_;
 
@@ -29,6 +29,7 @@
 #include <QThread>
 #include <QMutex>
 #include <QIODevice>
+#include <QDataStream>
 #include <QDir>
 #include <QFile>
 #include <QByteArray>
@@ -36,6 +37,7 @@
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <QStandardPaths>
 #include <QSqlDatabase>
 
 #include "core/shared_ptr.h"
@@ -48,6 +50,7 @@
 #include "core/sqlrow.h"
 #include "collection/collectionbackend.h"
 #include "playlistitem.h"
+#include "playlistmutationjournal.h"
 #include "songplaylistitem.h"
 #include "playlistbackend.h"
 #include "playlistparsers/cueparser.h"
@@ -55,6 +58,11 @@
 
 using std::make_shared;
 
+namespace {
+constexpr quint32 kPlaylistCacheMagic = 0x53706c63;  // 'Splc'
+constexpr quint32 kPlaylistCacheVersion = 1;
+}  // namespace
+
 const int PlaylistBackend::kSongTableJoins = 2;
 
 PlaylistBackend::PlaylistBackend(Application *app, QObject *parent)
@@ -176,14 +184,149 @@ PlaylistBackend::Playlist PlaylistBackend::GetPlaylist(const int id) {
 
 }
 
+QString PlaylistBackend::CacheFilename(const int playlist) const {
+
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/playlist-items-%1.bin").arg(playlist);
+
+}
+
+bool PlaylistBackend::GetPlaylistRowStamp(const int playlist, qint64 &count, qint64 &max_rowid) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("SELECT COUNT(*), IFNULL(MAX(ROWID), 0) FROM playlist_items WHERE playlist = :playlist"));
+  q.BindValue(QStringLiteral(":playlist"), playlist);
+  if (!q.Exec() || !q.next()) {
+    db_->ReportErrors(q);
+    return false;
+  }
+
+  count = q.value(0).toLongLong();
+  max_rowid = q.value(1).toLongLong();
+
+  return true;
+
+}
+
+PlaylistItemPtrList PlaylistBackend::LoadCachedPlaylistItems(const int playlist, const qint64 count, const qint64 max_rowid) {
+
+  QFile file(CacheFilename(playlist));
+  if (!file.exists()) return PlaylistItemPtrList();
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Could not open playlist cache" << file.fileName() << "for reading:" << file.errorString();
+    return PlaylistItemPtrList();
+  }
+
+  QDataStream s(&file);
+
+  quint32 magic = 0, version = 0;
+  qint32 schema_version = 0;
+  qint64 cached_count = 0, cached_max_rowid = 0;
+  s >> magic >> version >> schema_version >> cached_count >> cached_max_rowid;
+  if (magic != kPlaylistCacheMagic || version != kPlaylistCacheVersion || schema_version != Database::kSchemaVersion || cached_count != count || cached_max_rowid != max_rowid) {
+    file.close();
+    return PlaylistItemPtrList();
+  }
+
+  PlaylistItemPtrList playlistitems;
+  playlistitems.reserve(static_cast<int>(cached_count));
+  for (qint64 i = 0; i < cached_count; ++i) {
+    Song song;
+    s >> song;
+    if (s.status() != QDataStream::Ok) {
+      file.close();
+      return PlaylistItemPtrList();
+    }
+    PlaylistItemPtr item = PlaylistItem::NewFromSong(song);
+    if (!item) {
+      file.close();
+      return PlaylistItemPtrList();
+    }
+    playlistitems << item;
+  }
+
+  file.close();
+
+  return playlistitems;
+
+}
+
+void PlaylistBackend::SaveCachedPlaylistItems(const int playlist, const PlaylistItemPtrList &items) {
+
+  qint64 count = 0, max_rowid = 0;
+  if (!GetPlaylistRowStamp(playlist, count, max_rowid) || count != items.count()) {
+    RemoveCachedPlaylistItems(playlist);
+    return;
+  }
+
+  QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QFile file(CacheFilename(playlist));
+  if (!file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Could not open playlist cache" << file.fileName() << "for writing:" << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  s << kPlaylistCacheMagic << kPlaylistCacheVersion;
+  s << static_cast<qint32>(Database::kSchemaVersion);
+  s << count << max_rowid;
+  for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
+    if (!item) {
+      file.close();
+      file.remove();
+      return;
+    }
+    s << item->Metadata();
+  }
+
+  file.close();
+
+}
+
+void PlaylistBackend::RemoveCachedPlaylistItems(const int playlist) {
+
+  QFile file(CacheFilename(playlist));
+  if (file.exists()) file.remove();
+
+}
+
+void PlaylistBackend::CollectionSongsChanged() {
+
+  // The row stamp only covers playlist_items, it can't see changes to the joined songs table,
+  // so any collection metadata change invalidates every cached playlist.
+  const QDir cache_dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+  const QStringList cache_files = cache_dir.entryList(QStringList() << QStringLiteral("playlist-items-*.bin"), QDir::Files);
+  for (const QString &cache_file : cache_files) {
+    QFile::remove(cache_dir.filePath(cache_file));
+  }
+
+}
+
 PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
 
   PlaylistItemPtrList playlistitems;
 
+  // Try the binary sidecar cache first, it's a bulk deserialize instead of converting every SQL row back into a song.
+  qint64 row_count = 0, max_rowid = 0;
+  const bool have_row_stamp = GetPlaylistRowStamp(playlist, row_count, max_rowid);
+  if (have_row_stamp && row_count > 0) {
+    playlistitems = LoadCachedPlaylistItems(playlist, row_count, max_rowid);
+    if (playlistitems.count() == row_count) {
+      if (QThread::currentThread() != thread() && QThread::currentThread() != qApp->thread()) {
+        Close();
+      }
+      return playlistitems;
+    }
+    playlistitems.clear();
+  }
+
   {
 
-    QMutexLocker l(db_->Mutex());
-    QSqlDatabase db(db_->Connect());
+    // Read-only snapshot connection, so restoring playlists doesn't queue behind a running scan transaction.
+    QSqlDatabase db(db_->ConnectRead());
 
     QString query = QStringLiteral("SELECT %1, %2, p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist").arg(Song::JoinSpec(QStringLiteral("songs")), Song::JoinSpec(QStringLiteral("p")));
 
@@ -205,6 +348,8 @@ PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
 
   }
 
+  SaveCachedPlaylistItems(playlist, playlistitems);
+
   if (QThread::currentThread() != thread() && QThread::currentThread() != qApp->thread()) {
     Close();
   }
@@ -218,8 +363,8 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
   SongList songs;
 
   {
-    QMutexLocker l(db_->Mutex());
-    QSqlDatabase db(db_->Connect());
+    // Read-only snapshot connection, see GetPlaylistItems above.
+    QSqlDatabase db(db_->ConnectRead());
 
     QString query = QStringLiteral("SELECT %1, %2, p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist").arg(Song::JoinSpec(QStringLiteral("songs")), Song::JoinSpec(QStringLiteral("p")));
 
@@ -348,14 +493,13 @@ void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &item
   }
 
   // Save the new ones
+  SqlQuery *insert_query = db_->GetCachedQuery(db, QStringLiteral("INSERT INTO playlist_items (playlist, type, collection_id, ") + Song::kColumnSpec + QStringLiteral(") VALUES (:playlist, :type, :collection_id, ") + Song::kBindSpec + QStringLiteral(")"));
   for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("INSERT INTO playlist_items (playlist, type, collection_id, ") + Song::kColumnSpec + QStringLiteral(") VALUES (:playlist, :type, :collection_id, ") + Song::kBindSpec + QStringLiteral(")"));
-    q.BindValue(QStringLiteral(":playlist"), playlist);
-    item->BindToQuery(&q);
+    insert_query->BindValue(QStringLiteral(":playlist"), playlist);
+    item->BindToQuery(insert_query);
 
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
+    if (!insert_query->Exec()) {
+      db_->ReportErrors(*insert_query);
       return;
     }
   }
@@ -384,6 +528,12 @@ void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &item
 
   transaction.Commit();
 
+  // The snapshot that just committed covers everything in the journal, so the journaled deltas are compacted away.
+  // An edit racing with this commit re-journals through the next scheduled save.
+  PlaylistMutationJournal::Clear(playlist);
+
+  SaveCachedPlaylistItems(playlist, items);
+
 }
 
 int PlaylistBackend::CreatePlaylist(const QString &name, const QString &special_type) {
@@ -433,6 +583,10 @@ void PlaylistBackend::RemovePlaylist(int id) {
 
   transaction.Commit();
 
+  PlaylistMutationJournal::Clear(id);
+
+  RemoveCachedPlaylistItems(id);
+
 }
 
 void PlaylistBackend::RenamePlaylist(const int id, const QString &new_name) {
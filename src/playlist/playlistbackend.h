@@ -91,6 +91,10 @@ class PlaylistBackend : public QObject {
  public slots:
   void Exit();
   void SavePlaylist(const int playlist, const PlaylistItemPtrList &items, const int last_played, PlaylistGeneratorPtr dynamic);
+  // Drops every sidecar item cache. The cached items embed collection metadata from the songs table,
+  // and tag edits, rating changes and play statistics updates don't re-save the playlists that contain the songs,
+  // so the caches can't be trusted once collection songs change.
+  void CollectionSongsChanged();
 
  signals:
   void ExitFinished();
@@ -105,6 +109,15 @@ class PlaylistBackend : public QObject {
   PlaylistItemPtr NewPlaylistItemFromQuery(const SqlRow &row, SharedPtr<NewSongFromQueryState> state);
   PlaylistItemPtr RestoreCueData(PlaylistItemPtr item, SharedPtr<NewSongFromQueryState> state);
 
+  // Binary sidecar cache with the items of a playlist, so session restore is a bulk deserialize instead of thousands of individual SQL row conversions.
+  // A cached playlist is only used while the row count and max ROWID of its playlist_items rows still match the database.
+  // Changes to the joined songs table are invisible to that stamp and are handled by CollectionSongsChanged() dropping the caches.
+  QString CacheFilename(const int playlist) const;
+  bool GetPlaylistRowStamp(const int playlist, qint64 &count, qint64 &max_rowid);
+  PlaylistItemPtrList LoadCachedPlaylistItems(const int playlist, const qint64 count, const qint64 max_rowid);
+  void SaveCachedPlaylistItems(const int playlist, const PlaylistItemPtrList &items);
+  void RemoveCachedPlaylistItems(const int playlist);
+
   enum GetPlaylistsFlags {
     GetPlaylists_OpenInUi = 1,
     GetPlaylists_Favorite = 2,
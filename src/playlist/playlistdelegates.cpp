@@ -71,6 +71,11 @@
 #include "playlist/playlist.h"
 #include "playlistdelegates.h"
 
+namespace {
+// Upper bound for the memoized display strings in the length, size and date delegates before the cache is dropped and rebuilt.
+constexpr int kDisplayTextCacheMaxEntries = 100000;
+}  // namespace
+
 const int QueuedItemDelegate::kQueueBoxBorder = 1;
 const int QueuedItemDelegate::kQueueBoxCornerRadius = 3;
 const int QueuedItemDelegate::kQueueBoxLength = 30;
@@ -302,8 +307,17 @@ QString LengthItemDelegate::displayText(const QVariant &value, const QLocale&) c
   bool ok = false;
   qint64 nanoseconds = value.toLongLong(&ok);
 
-  if (ok && nanoseconds > 0) return Utilities::PrettyTimeNanosec(nanoseconds);
-  return QString();
+  if (!ok || nanoseconds <= 0) return QString();
+
+  QHash<qint64, QString>::const_iterator it = cached_text_.constFind(nanoseconds);
+  if (it != cached_text_.constEnd()) return it.value();
+
+  if (cached_text_.count() >= kDisplayTextCacheMaxEntries) cached_text_.clear();
+
+  const QString text = Utilities::PrettyTimeNanosec(nanoseconds);
+  cached_text_.insert(nanoseconds, text);
+
+  return text;
 
 }
 
@@ -313,8 +327,17 @@ QString SizeItemDelegate::displayText(const QVariant &value, const QLocale&) con
   bool ok = false;
   qint64 bytes = value.toLongLong(&ok);
 
-  if (ok && bytes > 0) return Utilities::PrettySize(static_cast<quint64>(bytes));
-  return QString();
+  if (!ok || bytes <= 0) return QString();
+
+  QHash<qint64, QString>::const_iterator it = cached_text_.constFind(bytes);
+  if (it != cached_text_.constEnd()) return it.value();
+
+  if (cached_text_.count() >= kDisplayTextCacheMaxEntries) cached_text_.clear();
+
+  const QString text = Utilities::PrettySize(static_cast<quint64>(bytes));
+  cached_text_.insert(bytes, text);
+
+  return text;
 
 }
 
@@ -329,7 +352,15 @@ QString DateItemDelegate::displayText(const QVariant &value, const QLocale &loca
     return QString();
   }
 
-  return QDateTime::fromSecsSinceEpoch(time).toString(QLocale::system().dateTimeFormat(QLocale::ShortFormat));
+  QHash<qint64, QString>::const_iterator it = cached_text_.constFind(time);
+  if (it != cached_text_.constEnd()) return it.value();
+
+  if (cached_text_.count() >= kDisplayTextCacheMaxEntries) cached_text_.clear();
+
+  const QString text = QDateTime::fromSecsSinceEpoch(time).toString(QLocale::system().dateTimeFormat(QLocale::ShortFormat));
+  cached_text_.insert(time, text);
+
+  return text;
 
 }
 
@@ -342,7 +373,22 @@ QString LastPlayedItemDelegate::displayText(const QVariant &value, const QLocale
     return tr("Never");
   }
 
-  return Utilities::Ago(time, locale);
+  // The relative text only changes when the current date does, so drop the cache on the first paint of a new day.
+  const QDate today = QDate::currentDate();
+  if (cached_text_date_ != today) {
+    cached_text_.clear();
+    cached_text_date_ = today;
+  }
+
+  QHash<qint64, QString>::const_iterator it = cached_text_.constFind(time);
+  if (it != cached_text_.constEnd()) return it.value();
+
+  if (cached_text_.count() >= kDisplayTextCacheMaxEntries) cached_text_.clear();
+
+  const QString text = Utilities::Ago(time, locale);
+  cached_text_.insert(time, text);
+
+  return text;
 
 }
 
@@ -27,10 +27,12 @@
 #include <QObject>
 #include <QWidget>
 #include <QAbstractItemView>
+#include <QHash>
 #include <QStyledItemDelegate>
 #include <QStyleOptionViewItem>
 #include <QTreeView>
 #include <QCompleter>
+#include <QDate>
 #include <QLocale>
 #include <QVariant>
 #include <QUrl>
@@ -99,12 +101,19 @@ class PlaylistDelegateBase : public QueuedItemDelegate {
   QString suffix_;
 };
 
+// The length, size, date and last-played delegates format their text purely from the numeric cell value,
+// so the formatted string is memoized per value and a full-window repaint of a large playlist
+// doesn't re-format the same durations, file sizes and dates for every row.
+
 class LengthItemDelegate : public PlaylistDelegateBase {
   Q_OBJECT
 
  public:
   explicit LengthItemDelegate(QObject *parent) : PlaylistDelegateBase(parent) {}
   QString displayText(const QVariant &value, const QLocale &locale) const override;
+
+ private:
+  mutable QHash<qint64, QString> cached_text_;
 };
 
 class SizeItemDelegate : public PlaylistDelegateBase {
@@ -113,6 +122,9 @@ class SizeItemDelegate : public PlaylistDelegateBase {
  public:
   explicit SizeItemDelegate(QObject *parent) : PlaylistDelegateBase(parent) {}
   QString displayText(const QVariant &value, const QLocale &locale) const override;
+
+ private:
+  mutable QHash<qint64, QString> cached_text_;
 };
 
 class DateItemDelegate : public PlaylistDelegateBase {
@@ -121,6 +133,9 @@ class DateItemDelegate : public PlaylistDelegateBase {
  public:
   explicit DateItemDelegate(QObject *parent) : PlaylistDelegateBase(parent) {}
   QString displayText(const QVariant &value, const QLocale &locale) const override;
+
+ private:
+  mutable QHash<qint64, QString> cached_text_;
 };
 
 class LastPlayedItemDelegate : public PlaylistDelegateBase {
@@ -129,6 +144,11 @@ class LastPlayedItemDelegate : public PlaylistDelegateBase {
  public:
   explicit LastPlayedItemDelegate(QObject *parent) : PlaylistDelegateBase(parent) {}
   QString displayText(const QVariant &value, const QLocale &locale) const override;
+
+ private:
+  // The relative "Today"/"Yesterday" text is day-granular, so the cache is only valid for the date it was filled on (see displayText()).
+  mutable QHash<qint64, QString> cached_text_;
+  mutable QDate cached_text_date_;
 };
 
 class FileTypeItemDelegate : public PlaylistDelegateBase {
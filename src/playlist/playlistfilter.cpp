@@ -23,17 +23,28 @@
 
 #include <QObject>
 #include <QString>
+#include <QList>
+#include <QPair>
+#include <QBitArray>
+#include <QThread>
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
+#include <QtConcurrentMap>
 
 #include "playlist/playlist.h"
 #include "playlistfilter.h"
 #include "playlistfilterparser.h"
 
+namespace {
+// Below this many rows a serial filter pass is cheap enough that spreading it over the thread pool isn't worth the overhead.
+constexpr int kParallelFilterMinRows = 10000;
+}  // namespace
+
 PlaylistFilter::PlaylistFilter(QObject *parent)
     : QSortFilterProxyModel(parent),
       filter_tree_(new PlaylistNopFilter),
-      query_hash_(0) {
+      query_hash_(0),
+      accepted_rows_valid_(false) {
 
   setDynamicSortFilter(true);
 
@@ -80,12 +91,47 @@ void PlaylistFilter::sort(int column, Qt::SortOrder order) {
   sourceModel()->sort(column, order);
 }
 
-bool PlaylistFilter::filterAcceptsRow(const int row, const QModelIndex &parent) const {
+void PlaylistFilter::setSourceModel(QAbstractItemModel *source_model) {
+
+  if (sourceModel()) {
+    QObject::disconnect(sourceModel(), nullptr, this, nullptr);
+  }
+
+  // The column cache holds strings by (row, column), so any change to the source model invalidates it.
+  // Data changes keep the precomputed accept bits by re-evaluating the affected rows; structural changes shift the row indexes and drop them.
+  // These connections are made before the base class sees the model: slots run in connection order,
+  // so the caches are refreshed ahead of the proxy's internal dataChanged/rowsInserted handlers,
+  // which re-filter the affected rows and would otherwise read stale bits and cache entries.
+  if (source_model) {
+    QObject::connect(source_model, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &top_left, const QModelIndex &bottom_right) {
+      column_cache_.Invalidate();
+      if (accepted_rows_valid_ && sourceModel()) {
+        for (int row = top_left.row(); row <= bottom_right.row() && row < accepted_rows_.size(); ++row) {
+          accepted_rows_.setBit(row, filter_tree_->accept(row, QModelIndex(), sourceModel(), &column_cache_));
+        }
+      }
+    });
+    // Structural changes drop the caches from the "about to" signals, before the rows shift:
+    // the cache entries are keyed by row, so nothing may look them up once the old row numbers are gone,
+    // no matter in which order the other listeners process the change.
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeInserted, this, [this]() { column_cache_.Invalidate(); accepted_rows_valid_ = false; });
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeRemoved, this, [this]() { column_cache_.Invalidate(); accepted_rows_valid_ = false; });
+    QObject::connect(source_model, &QAbstractItemModel::rowsAboutToBeMoved, this, [this]() { column_cache_.Invalidate(); accepted_rows_valid_ = false; });
+    QObject::connect(source_model, &QAbstractItemModel::layoutAboutToBeChanged, this, [this]() { column_cache_.Invalidate(); accepted_rows_valid_ = false; });
+    QObject::connect(source_model, &QAbstractItemModel::modelAboutToBeReset, this, [this]() { column_cache_.Invalidate(); accepted_rows_valid_ = false; });
+  }
+
+  QSortFilterProxyModel::setSourceModel(source_model);
+  column_cache_.Invalidate();
+
+}
+
+void PlaylistFilter::EnsureFilterTree() const {
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  size_t hash = qHash(filter_text_);
+  const size_t hash = qHash(filter_text_);
 #else
-  uint hash = qHash(filter_text_);
+  const uint hash = qHash(filter_text_);
 #endif
   if (hash != query_hash_) {
     // Parse the query
@@ -95,14 +141,71 @@ bool PlaylistFilter::filterAcceptsRow(const int row, const QModelIndex &parent)
     query_hash_ = hash;
   }
 
+}
+
+bool PlaylistFilter::filterAcceptsRow(const int row, const QModelIndex &parent) const {
+
+  EnsureFilterTree();
+
+  // The playlist model is flat, so a valid precomputed pass answers every row.
+  if (accepted_rows_valid_ && !parent.isValid() && row >= 0 && row < accepted_rows_.size()) {
+    return accepted_rows_.testBit(row);
+  }
+
   // Test the row
-  return filter_tree_->accept(row, parent, sourceModel());
+  return filter_tree_->accept(row, parent, sourceModel(), &column_cache_);
+
+}
+
+void PlaylistFilter::UpdateAcceptedRows() {
+
+  accepted_rows_valid_ = false;
+
+  const QAbstractItemModel *model = sourceModel();
+  if (!model || filter_text_.isEmpty()) return;
+
+  const int row_count = model->rowCount();
+  if (row_count < kParallelFilterMinRows) return;
+
+  EnsureFilterTree();
+
+  // Split the rows into one chunk per thread and evaluate them on the thread pool.
+  // The workers only read const model data, and the model can't change under them because this thread blocks until all the chunks are done.
+  // Each chunk gets its own column cache since the shared one isn't thread safe; every cell is visited once anyway.
+  const int thread_count = qMax(1, QThread::idealThreadCount());
+  const int chunk_size = (row_count + thread_count - 1) / thread_count;
+  QList<QPair<int, int>> chunks;
+  chunks.reserve(thread_count);
+  for (int start = 0; start < row_count; start += chunk_size) {
+    chunks << qMakePair(start, qMin(start + chunk_size, row_count));
+  }
+
+  const PlaylistFilterTree *filter_tree = filter_tree_.data();
+  const QList<QBitArray> results = QtConcurrent::blockingMapped(chunks, [filter_tree, model](const QPair<int, int> &chunk) -> QBitArray {
+    PlaylistFilterColumnCache cache;
+    QBitArray accepted(chunk.second - chunk.first);
+    for (int row = chunk.first; row < chunk.second; ++row) {
+      accepted.setBit(row - chunk.first, filter_tree->accept(row, QModelIndex(), model, &cache));
+    }
+    return accepted;
+  });
+
+  accepted_rows_.resize(row_count);
+  int row = 0;
+  for (const QBitArray &chunk_result : results) {
+    for (int i = 0; i < chunk_result.size(); ++i) {
+      accepted_rows_.setBit(row++, chunk_result.testBit(i));
+    }
+  }
+
+  accepted_rows_valid_ = true;
 
 }
 
 void PlaylistFilter::SetFilterText(const QString &filter_text) {
 
   filter_text_ = filter_text;
+  UpdateAcceptedRows();
   setFilterFixedString(filter_text);
 
 }
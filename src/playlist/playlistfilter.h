@@ -30,8 +30,11 @@
 #include <QSet>
 #include <QScopedPointer>
 #include <QString>
+#include <QBitArray>
 #include <QSortFilterProxyModel>
 
+#include "playlistfilterparser.h"
+
 class PlaylistFilterTree;
 
 class PlaylistFilter : public QSortFilterProxyModel {
@@ -43,6 +46,7 @@ class PlaylistFilter : public QSortFilterProxyModel {
 
   // QAbstractItemModel
   void sort(const int column, const Qt::SortOrder order = Qt::AscendingOrder) override;
+  void setSourceModel(QAbstractItemModel *source_model) override;
 
   // QSortFilterProxyModel
   // public so Playlist::NextVirtualIndex and friends can get at it
@@ -54,6 +58,13 @@ class PlaylistFilter : public QSortFilterProxyModel {
   QMap<QString, int> column_names() const { return column_names_; }
 
  private:
+  // Re-parses the filter text into the filter tree when it changed.
+  void EnsureFilterTree() const;
+  // Evaluates the filter tree over all source rows in parallel into accepted_rows_,
+  // so filtering a large playlist uses all cores and filterAcceptsRow() becomes a bit lookup.
+  // Only kicks in above a row count threshold; below it the per-row path is cheap enough.
+  void UpdateAcceptedRows();
+
   // Mutable because they're modified from filterAcceptsRow() const
   mutable QScopedPointer<PlaylistFilterTree> filter_tree_;
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -62,6 +73,15 @@ class PlaylistFilter : public QSortFilterProxyModel {
   mutable uint query_hash_;
 #endif
 
+  // Lowercased cell strings reused between evaluations, cleared whenever the source model changes.
+  mutable PlaylistFilterColumnCache column_cache_;
+
+  // Precomputed accept bit per source row, only valid right after a bulk pass.
+  // Row inserts and removes shift the indexes, so they fall back to per-row evaluation until the next pass;
+  // data changes just re-evaluate the affected rows in place.
+  QBitArray accepted_rows_;
+  bool accepted_rows_valid_;
+
   QMap<QString, int> column_names_;
   QSet<int> numerical_columns_;
   QString filter_text_;
@@ -37,6 +37,26 @@
 #include "playlistfilterparser.h"
 #include "utilities/searchparserutils.h"
 
+const QString &PlaylistFilterColumnCache::Value(const int row, const int column, const QModelIndex &parent, const QAbstractItemModel *const model) {
+
+  const quint64 key = (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+  QHash<quint64, QString>::const_iterator it = cache_.constFind(key);
+  if (it != cache_.constEnd()) return it.value();
+
+  return *cache_.insert(key, model->index(row, column, parent).data().toString().toLower());
+
+}
+
+double PlaylistFilterColumnCache::NumericValue(const int row, const int column, const QModelIndex &parent, const QAbstractItemModel *const model) {
+
+  const quint64 key = (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+  QHash<quint64, double>::const_iterator it = numeric_cache_.constFind(key);
+  if (it != numeric_cache_.constEnd()) return it.value();
+
+  return *numeric_cache_.insert(key, model->index(row, column, parent).data().toDouble());
+
+}
+
 class PlaylistSearchTermComparator {
  public:
   PlaylistSearchTermComparator() = default;
@@ -119,152 +139,76 @@ class PlaylistLexicalLeComparator : public PlaylistSearchTermComparator {
   QString search_term_;
 };
 
-// Float Comparators are for the rating
-class PlaylistFloatEqComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatEqComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return search_term_ == element.toFloat();
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistFloatNeComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatNeComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return search_term_ != element.toFloat();
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistFloatGtComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatGtComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toFloat() > search_term_;
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistFloatGeComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatGeComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toFloat() >= search_term_;
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistFloatLtComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatLtComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toFloat() < search_term_;
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistFloatLeComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistFloatLeComparator(const float value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toFloat() <= search_term_;
-  }
- private:
-  float search_term_;
-};
-
-class PlaylistGtComparator : public PlaylistSearchTermComparator {
+// Filter that applies a SearchTermComparator to all fields of a playlist entry
+class PlaylistFilterTerm : public PlaylistFilterTree {
  public:
-  explicit PlaylistGtComparator(const int value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toInt() > search_term_;
-  }
- private:
-  int search_term_;
-};
+  explicit PlaylistFilterTerm(PlaylistSearchTermComparator *comparator, const QList<int> &columns) : cmp_(comparator), columns_(columns) {}
 
-class PlaylistGeComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistGeComparator(const int value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toInt() >= search_term_;
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+    for (const int i : columns_) {
+      if (cmp_->Matches(cache->Value(row, i, parent, model))) return true;
+    }
+    return false;
   }
+  FilterType type() override { return FilterType::Term; }
  private:
-  int search_term_;
+  QScopedPointer<PlaylistSearchTermComparator> cmp_;
+  QList<int> columns_;
 };
 
-class PlaylistLtComparator : public PlaylistSearchTermComparator {
+// Filter that compares one numeric column against a value lowered to numeric form at parse time,
+// so no string conversion or search term parsing happens per row.
+// The length column holds nanoseconds but the user types seconds, so it is truncated to whole seconds first.
+class PlaylistFilterNumericColumnTerm : public PlaylistFilterTree {
  public:
-  explicit PlaylistLtComparator(const int value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toInt() < search_term_;
-  }
- private:
-  int search_term_;
-};
+  enum class Op {
+    Eq,
+    Ne,
+    Gt,
+    Ge,
+    Lt,
+    Le
+  };
+
+  PlaylistFilterNumericColumnTerm(const int column, const Op op, const double search_value, const bool nanoseconds_to_seconds = false) : col_(column), op_(op), search_value_(search_value), nanoseconds_to_seconds_(nanoseconds_to_seconds) {}
+
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+
+    double value = cache->NumericValue(row, col_, parent, model);
+    if (nanoseconds_to_seconds_) {
+      qint64 seconds = static_cast<qint64>(value);
+      if (seconds >= 1000000000LL || seconds <= -1000000000LL) seconds /= 1000000000LL;
+      value = static_cast<double>(seconds);
+    }
 
-class PlaylistLeComparator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistLeComparator(const int value) : search_term_(value) {}
-  bool Matches(const QString &element) const override {
-    return element.toInt() <= search_term_;
-  }
- private:
-  int search_term_;
-};
+    switch (op_) {
+      case Op::Eq: return value == search_value_;
+      case Op::Ne: return value != search_value_;
+      case Op::Gt: return value > search_value_;
+      case Op::Ge: return value >= search_value_;
+      case Op::Lt: return value < search_value_;
+      case Op::Le: return value <= search_value_;
+    }
 
-// The length field of the playlist (entries) contains a song's running time in nanoseconds.
-// However, We don't really care about nanoseconds, just seconds.
-// Thus, with this decorator we drop the last 9 digits, if that many are present.
-class PlaylistDropTailComparatorDecorator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistDropTailComparatorDecorator(PlaylistSearchTermComparator *cmp) : cmp_(cmp) {}
+    return false;
 
-  bool Matches(const QString &element) const override {
-    if (element.length() > 9) {
-      return cmp_->Matches(element.left(element.length() - 9));
-    }
-    else {
-      return cmp_->Matches(element);
-    }
   }
- private:
-  QScopedPointer<PlaylistSearchTermComparator> cmp_;
-};
+  FilterType type() override { return FilterType::Column; }
 
-class PlaylistRatingComparatorDecorator : public PlaylistSearchTermComparator {
- public:
-  explicit PlaylistRatingComparatorDecorator(PlaylistSearchTermComparator *cmp) : cmp_(cmp) {}
-  bool Matches(const QString &element) const override {
-    return cmp_->Matches(QString::number(lround(element.toDouble() * 10.0)));
+  static Op OpFromPrefix(const QString &prefix) {
+    if (prefix == QLatin1String("!=") || prefix == QLatin1String("<>")) return Op::Ne;
+    if (prefix == QLatin1Char('>')) return Op::Gt;
+    if (prefix == QLatin1String(">=")) return Op::Ge;
+    if (prefix == QLatin1Char('<')) return Op::Lt;
+    if (prefix == QLatin1String("<=")) return Op::Le;
+    return Op::Eq;
   }
- private:
-  QScopedPointer<PlaylistSearchTermComparator> cmp_;
-};
-
-// Filter that applies a SearchTermComparator to all fields of a playlist entry
-class PlaylistFilterTerm : public PlaylistFilterTree {
- public:
-  explicit PlaylistFilterTerm(PlaylistSearchTermComparator *comparator, const QList<int> &columns) : cmp_(comparator), columns_(columns) {}
 
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
-    for (const int i : columns_) {
-      const QModelIndex idx = model->index(row, i, parent);
-      if (cmp_->Matches(idx.data().toString().toLower())) return true;
-    }
-    return false;
-  }
-  FilterType type() override { return FilterType::Term; }
  private:
-  QScopedPointer<PlaylistSearchTermComparator> cmp_;
-  QList<int> columns_;
+  int col_;
+  Op op_;
+  double search_value_;
+  bool nanoseconds_to_seconds_;
 };
 
 // Filter that applies a SearchTermComparator to one specific field of a playlist entry
@@ -272,9 +216,8 @@ class PlaylistFilterColumnTerm : public PlaylistFilterTree {
  public:
   PlaylistFilterColumnTerm(const int column, PlaylistSearchTermComparator *comparator) : col(column), cmp_(comparator) {}
 
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
-    const QModelIndex idx = model->index(row, col, parent);
-    return cmp_->Matches(idx.data().toString().toLower());
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+    return cmp_->Matches(cache->Value(row, col, parent, model));
   }
   FilterType type() override { return FilterType::Column; }
  private:
@@ -286,8 +229,8 @@ class PlaylistNotFilter : public PlaylistFilterTree {
  public:
   explicit PlaylistNotFilter(const PlaylistFilterTree *inv) : child_(inv) {}
 
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
-    return !child_->accept(row, parent, model);
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+    return !child_->accept(row, parent, model, cache);
   }
   FilterType type() override { return FilterType::Not; }
  private:
@@ -298,8 +241,8 @@ class PlaylistOrFilter : public PlaylistFilterTree {
  public:
   ~PlaylistOrFilter() override { qDeleteAll(children_); }
   virtual void add(PlaylistFilterTree *child) { children_.append(child); }
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
-    return std::any_of(children_.begin(), children_.end(), [row, parent, model](PlaylistFilterTree *child) { return child->accept(row, parent, model); });
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+    return std::any_of(children_.begin(), children_.end(), [row, parent, model, cache](PlaylistFilterTree *child) { return child->accept(row, parent, model, cache); });
   }
   FilterType type() override { return FilterType::Or; }
  private:
@@ -310,8 +253,8 @@ class PlaylistAndFilter : public PlaylistFilterTree {
  public:
   ~PlaylistAndFilter() override { qDeleteAll(children_); }
   virtual void add(PlaylistFilterTree *child) { children_.append(child); }
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
-    return !std::any_of(children_.begin(), children_.end(), [row, parent, model](PlaylistFilterTree *child) { return !child->accept(row, parent, model); });
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override {
+    return !std::any_of(children_.begin(), children_.end(), [row, parent, model, cache](PlaylistFilterTree *child) { return !child->accept(row, parent, model, cache); });
   }
   FilterType type() override { return FilterType::And; }
  private:
@@ -522,59 +465,25 @@ PlaylistFilterTree *PlaylistFilterParser::createSearchTermTreeNode(const QString
 
   // Handle the float based Rating Column
   if (columns_[col] == static_cast<int>(Playlist::Column::Rating)) {
-    float parsed_search = Utilities::ParseSearchRating(search);
-
-    if (prefix == QLatin1Char('=')) {
-      cmp = new PlaylistFloatEqComparator(parsed_search);
-    }
-    else if (prefix == QLatin1String("!=") || prefix == QLatin1String("<>")) {
-      cmp = new PlaylistFloatNeComparator(parsed_search);
-    }
-    else if (prefix == QLatin1Char('>')) {
-      cmp = new PlaylistFloatGtComparator(parsed_search);
-    }
-    else if (prefix == QLatin1String(">=")) {
-      cmp = new PlaylistFloatGeComparator(parsed_search);
-    }
-    else if (prefix == QLatin1Char('<')) {
-      cmp = new PlaylistFloatLtComparator(parsed_search);
-    }
-    else if (prefix == QLatin1String("<=")) {
-      cmp = new PlaylistFloatLeComparator(parsed_search);
-    }
-    else {
-      cmp = new PlaylistFloatEqComparator(parsed_search);
-    }
-  }
-  else if (prefix == QLatin1String("!=") || prefix == QLatin1String("<>")) {
-    cmp = new PlaylistNeComparator(search);
+    // The rating is parsed once here and compared numerically per row.
+    // The search value goes through float so it promotes to the same double as the model's float rating.
+    const float parsed_search = Utilities::ParseSearchRating(search);
+    return new PlaylistFilterNumericColumnTerm(columns_[col], PlaylistFilterNumericColumnTerm::OpFromPrefix(prefix), static_cast<double>(parsed_search));
   }
   else if (!col.isEmpty() && columns_.contains(col) && numerical_columns_.contains(columns_[col])) {
-    // The length column contains the time in seconds (nanoseconds, actually - the "nano" part is handled by the DropTailComparatorDecorator,  though).
+    // Durations like "3:21" are lowered to seconds once here; the per-row side is numeric model data, so no string parsing is left in the row loop.
     int search_value = 0;
-    if (columns_[col] == static_cast<int>(Playlist::Column::Length)) {
+    const bool is_length = columns_[col] == static_cast<int>(Playlist::Column::Length);
+    if (is_length) {
       search_value = Utilities::ParseSearchTime(search);
     }
     else {
       search_value = search.toInt();
     }
-    // Alright, back to deciding which comparator we'll use
-    if (prefix == QLatin1Char('>')) {
-      cmp = new PlaylistGtComparator(search_value);
-    }
-    else if (prefix == QLatin1String(">=")) {
-      cmp = new PlaylistGeComparator(search_value);
-    }
-    else if (prefix == QLatin1Char('<')) {
-      cmp = new PlaylistLtComparator(search_value);
-    }
-    else if (prefix == QLatin1String("<=")) {
-      cmp = new PlaylistLeComparator(search_value);
-    }
-    else {
-      // Convert back because for time/rating
-      cmp = new PlaylistEqComparator(QString::number(search_value));
-    }
+    return new PlaylistFilterNumericColumnTerm(columns_[col], PlaylistFilterNumericColumnTerm::OpFromPrefix(prefix), static_cast<double>(search_value), is_length);
+  }
+  else if (prefix == QLatin1String("!=") || prefix == QLatin1String("<>")) {
+    cmp = new PlaylistNeComparator(search);
   }
   else {
     if (prefix == QLatin1Char('=')) {
@@ -598,9 +507,6 @@ PlaylistFilterTree *PlaylistFilterParser::createSearchTermTreeNode(const QString
   }
 
   if (columns_.contains(col)) {
-    if (columns_[col] == static_cast<int>(Playlist::Column::Length)) {
-      cmp = new PlaylistDropTailComparatorDecorator(cmp);
-    }
     return new PlaylistFilterColumnTerm(columns_[col], cmp);
   }
   else {
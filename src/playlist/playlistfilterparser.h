@@ -24,6 +24,7 @@
 
 #include "config.h"
 
+#include <QHash>
 #include <QSet>
 #include <QMap>
 #include <QString>
@@ -31,12 +32,28 @@
 class QAbstractItemModel;
 class QModelIndex;
 
+// Caches the lowercased string and the numeric value of each (row, column) cell between filter evaluations,
+// so re-filtering the playlist on every keystroke doesn't refetch and convert the same cells again.
+// Numeric columns are read through NumericValue(), which keeps the model's numeric variant as-is instead of round-tripping it through a string.
+// The owner is responsible for invalidating the cache when the source model changes.
+class PlaylistFilterColumnCache {
+ public:
+  PlaylistFilterColumnCache() = default;
+  const QString &Value(const int row, const int column, const QModelIndex &parent, const QAbstractItemModel *const model);
+  double NumericValue(const int row, const int column, const QModelIndex &parent, const QAbstractItemModel *const model);
+  void Invalidate() { cache_.clear(); numeric_cache_.clear(); }
+ private:
+  QHash<quint64, QString> cache_;
+  QHash<quint64, double> numeric_cache_;
+  Q_DISABLE_COPY(PlaylistFilterColumnCache)
+};
+
 // Structure for filter parse tree
 class PlaylistFilterTree {
  public:
   PlaylistFilterTree() = default;
   virtual ~PlaylistFilterTree() {}
-  virtual bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const = 0;
+  virtual bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const = 0;
   enum class FilterType {
     Nop = 0,
     Or,
@@ -53,7 +70,7 @@ class PlaylistFilterTree {
 // Trivial filter that accepts *anything*
 class PlaylistNopFilter : public PlaylistFilterTree {
  public:
-  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override { Q_UNUSED(row); Q_UNUSED(parent); Q_UNUSED(model); return true; }
+  bool accept(const int row, const QModelIndex &parent, const QAbstractItemModel *const model, PlaylistFilterColumnCache *cache) const override { Q_UNUSED(row); Q_UNUSED(parent); Q_UNUSED(model); Q_UNUSED(cache); return true; }
   FilterType type() override { return FilterType::Nop; }
 };
 
@@ -37,6 +37,7 @@
 #include <QColor>
 
 #include "core/shared_ptr.h"
+#include "core/memorystats.h"
 #include "core/song.h"
 
 class QAction;
@@ -118,6 +119,9 @@ class PlaylistItem : public enable_shared_from_this<PlaylistItem> {
   bool GetShouldSkip() const;
 
  protected:
+  // Memory accounting: counts live playlist items across all playlists.
+  MemoryStats::InstanceCounter<&MemoryStats::playlist_item_instances> instance_counter_;
+
   bool should_skip_;
 
   enum DatabaseColumn { Column_CollectionId };
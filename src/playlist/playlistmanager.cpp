@@ -46,6 +46,7 @@
 #include "core/application.h"
 #include "core/player.h"
 #include "core/settings.h"
+#include "core/taskmanager.h"
 #include "utilities/filenameconstants.h"
 #include "utilities/timeutils.h"
 #include "collection/collectionbackend.h"
@@ -100,6 +101,12 @@ void PlaylistManager::Init(SharedPtr<CollectionBackend> collection_backend, Shar
   QObject::connect(&*collection_backend_, &CollectionBackend::SongsStatisticsChanged, this, &PlaylistManager::UpdateCollectionSongs);
   QObject::connect(&*collection_backend_, &CollectionBackend::SongsRatingChanged, this, &PlaylistManager::UpdateCollectionSongs);
 
+  // These updates only touch the in-memory playlist items and don't re-save the playlists,
+  // so the playlist item caches would keep restoring the old metadata on the next startup.
+  QObject::connect(&*collection_backend_, &CollectionBackend::SongsChanged, &*playlist_backend_, &PlaylistBackend::CollectionSongsChanged);
+  QObject::connect(&*collection_backend_, &CollectionBackend::SongsStatisticsChanged, &*playlist_backend_, &PlaylistBackend::CollectionSongsChanged);
+  QObject::connect(&*collection_backend_, &CollectionBackend::SongsRatingChanged, &*playlist_backend_, &PlaylistBackend::CollectionSongsChanged);
+
   QObject::connect(parser_, &PlaylistParser::Error, this, &PlaylistManager::Error);
 
   for (const PlaylistBackend::Playlist &p : playlist_backend->GetAllOpenPlaylists()) {
@@ -217,7 +224,7 @@ void PlaylistManager::Load(const QString &filename) {
 void PlaylistManager::Save(const int id, const QString &filename, const PlaylistSettingsPage::PathType path_type) {
 
   if (playlists_.contains(id)) {
-    parser_->Save(playlist(id)->GetAllSongs(), filename, path_type);
+    SavePlaylistSongs(playlist(id)->GetAllSongs(), filename, path_type);
   }
   else {
     // Playlist is not in the playlist manager: probably save action was triggered from the left sidebar and the playlist isn't loaded.
@@ -238,7 +245,19 @@ void PlaylistManager::Save(const int id, const QString &filename, const Playlist
 
 void PlaylistManager::ItemsLoadedForSavePlaylist(const SongList &songs, const QString &filename, const PlaylistSettingsPage::PathType path_type) {
 
-  parser_->Save(songs, filename, path_type);
+  SavePlaylistSongs(songs, filename, path_type);
+
+}
+
+void PlaylistManager::SavePlaylistSongs(const SongList &songs, const QString &filename, const PlaylistSettingsPage::PathType path_type) {
+
+  // Write the file on a worker thread with a task shown in the status bar, so exporting a huge playlist doesn't block the UI.
+  // The parsers stream entries to the device as they go, so this keeps memory constant apart from the song list itself.
+  (void)QtConcurrent::run([this, songs, filename, path_type]() {
+    const int task_id = app_->task_manager()->StartTask(tr("Saving playlist"));
+    TaskManager::ScopedTask task(task_id, &*app_->task_manager());
+    parser_->Save(songs, filename, path_type);
+  });
 
 }
 
@@ -235,6 +235,7 @@ class PlaylistManager : public PlaylistManagerInterface {
   void UpdateSummaryText();
   void UpdateCollectionSongs(const SongList &songs);
   void ItemsLoadedForSavePlaylist(const SongList &songs, const QString &filename, const PlaylistSettingsPage::PathType path_type);
+  void SavePlaylistSongs(const SongList &songs, const QString &filename, const PlaylistSettingsPage::PathType path_type);
   void PlaylistLoaded();
 
  private:
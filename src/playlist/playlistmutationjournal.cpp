@@ -0,0 +1,353 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <utility>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QString>
+
+#include "core/logging.h"
+#include "core/song.h"
+
+#include "playlistitem.h"
+#include "playlistmutationjournal.h"
+
+namespace PlaylistMutationJournal {
+
+namespace {
+
+constexpr quint32 kJournalMagic = 0x53504C4A;  // "SPLJ"
+constexpr quint8 kJournalVersion = 1;
+
+enum class RecordType : quint8 {
+  Insert = 1,
+  Remove = 2,
+  Move = 3,
+  MoveInverse = 4,
+  Reorder = 5,
+};
+
+QMutex sMutex;
+
+QString JournalFilename(const int playlist_id) {
+
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QStringLiteral("/playlistjournals/%1.journal").arg(playlist_id);
+
+}
+
+void Append(const int playlist_id, const QByteArray &payload) {
+
+  QMutexLocker locker(&sMutex);
+
+  const QString filename = JournalFilename(playlist_id);
+  QDir dir = QFileInfo(filename).dir();
+  if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
+    qLog(Error) << "Could not create playlist journal directory" << dir.path();
+    return;
+  }
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    qLog(Error) << "Could not open playlist journal" << filename << file.errorString();
+    return;
+  }
+
+  QDataStream s(&file);
+  s.setVersion(QDataStream::Qt_5_12);
+  if (file.pos() == 0) {
+    s << kJournalMagic << kJournalVersion;
+  }
+  s << static_cast<quint32>(payload.size()) << static_cast<quint32>(qChecksum(payload));
+  s.writeRawData(payload.constData(), static_cast<int>(payload.size()));
+  file.flush();
+  file.close();
+
+}
+
+// Mirrors Playlist::MoveItemsWithoutUndo(source_rows, pos).
+bool ApplyMove(PlaylistItemPtrList &items, const QList<int> &source_rows, int pos) {
+
+  for (const int source_row : source_rows) {
+    if (source_row < 0 || source_row >= items.count()) return false;
+  }
+  if (pos > items.count()) return false;
+
+  if (pos < 0) {
+    pos = static_cast<int>(items.count());
+  }
+
+  PlaylistItemPtrList moved_items;
+  moved_items.reserve(source_rows.count());
+
+  int offset = 0;
+  int start = pos;
+  for (const int source_row : source_rows) {
+    if (source_row - offset < 0 || source_row - offset >= items.count()) return false;
+    moved_items << items.takeAt(source_row - offset);
+    if (pos > source_row) {
+      --start;
+    }
+    ++offset;
+  }
+
+  for (int i = start; i < start + moved_items.count(); ++i) {
+    if (i < 0 || i > items.count()) return false;
+    items.insert(i, moved_items[i - start]);
+  }
+
+  return true;
+
+}
+
+// Mirrors Playlist::MoveItemsWithoutUndo(start, dest_rows).
+bool ApplyMoveInverse(PlaylistItemPtrList &items, int start, const QList<int> &dest_rows) {
+
+  int pos = start;
+  for (const int dest_row : dest_rows) {
+    if (dest_row < pos) --start;
+  }
+
+  if (start < 0) {
+    start = static_cast<int>(items.count() - dest_rows.count());
+  }
+  if (start < 0 || start + dest_rows.count() > items.count()) return false;
+
+  PlaylistItemPtrList moved_items;
+  moved_items.reserve(dest_rows.count());
+  for (int i = 0; i < dest_rows.count(); ++i) {
+    moved_items << items.takeAt(start);
+  }
+
+  int offset = 0;
+  for (const int dest_row : dest_rows) {
+    if (dest_row < 0 || dest_row > items.count()) return false;
+    items.insert(dest_row, moved_items[offset]);
+    offset++;
+  }
+
+  return true;
+
+}
+
+}  // namespace
+
+void RecordInsert(const int playlist_id, const int pos, const SongList &songs) {
+
+  QByteArray payload;
+  QDataStream s(&payload, QIODevice::WriteOnly);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << static_cast<quint8>(RecordType::Insert) << static_cast<qint32>(pos) << static_cast<qint32>(songs.count());
+  for (const Song &song : songs) {
+    s << song;
+  }
+
+  Append(playlist_id, payload);
+
+}
+
+void RecordRemove(const int playlist_id, const int row, const int count) {
+
+  QByteArray payload;
+  QDataStream s(&payload, QIODevice::WriteOnly);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << static_cast<quint8>(RecordType::Remove) << static_cast<qint32>(row) << static_cast<qint32>(count);
+
+  Append(playlist_id, payload);
+
+}
+
+void RecordMove(const int playlist_id, const QList<int> &source_rows, const int pos) {
+
+  QByteArray payload;
+  QDataStream s(&payload, QIODevice::WriteOnly);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << static_cast<quint8>(RecordType::Move) << source_rows << static_cast<qint32>(pos);
+
+  Append(playlist_id, payload);
+
+}
+
+void RecordMoveInverse(const int playlist_id, const int start, const QList<int> &dest_rows) {
+
+  QByteArray payload;
+  QDataStream s(&payload, QIODevice::WriteOnly);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << static_cast<quint8>(RecordType::MoveInverse) << static_cast<qint32>(start) << dest_rows;
+
+  Append(playlist_id, payload);
+
+}
+
+void RecordReorder(const int playlist_id, const QList<int> &permutation) {
+
+  QByteArray payload;
+  QDataStream s(&payload, QIODevice::WriteOnly);
+  s.setVersion(QDataStream::Qt_5_12);
+  s << static_cast<quint8>(RecordType::Reorder) << permutation;
+
+  Append(playlist_id, payload);
+
+}
+
+bool HasJournal(const int playlist_id) {
+
+  QMutexLocker locker(&sMutex);
+  return QFile::exists(JournalFilename(playlist_id));
+
+}
+
+PlaylistItemPtrList Replay(const int playlist_id, PlaylistItemPtrList items) {
+
+  QMutexLocker locker(&sMutex);
+
+  QFile file(JournalFilename(playlist_id));
+  if (!file.exists()) return items;
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Could not open playlist journal" << file.fileName() << file.errorString();
+    return items;
+  }
+
+  QDataStream s(&file);
+  s.setVersion(QDataStream::Qt_5_12);
+
+  quint32 magic = 0;
+  quint8 version = 0;
+  s >> magic >> version;
+  if (magic != kJournalMagic || version != kJournalVersion) {
+    qLog(Warning) << "Playlist journal" << file.fileName() << "has wrong magic or version, ignoring.";
+    return items;
+  }
+
+  int records_applied = 0;
+  while (!s.atEnd()) {
+
+    quint32 size = 0;
+    quint32 checksum = 0;
+    s >> size >> checksum;
+    if (size == 0 || size > 256 * 1024 * 1024) {
+      qLog(Warning) << "Playlist journal" << file.fileName() << "has a record with a bogus size, stopping replay.";
+      break;
+    }
+    QByteArray payload(static_cast<qsizetype>(size), Qt::Uninitialized);
+    if (s.readRawData(payload.data(), static_cast<int>(size)) != static_cast<int>(size) || static_cast<quint32>(qChecksum(payload)) != checksum) {
+      qLog(Warning) << "Playlist journal" << file.fileName() << "has a torn or corrupt record, stopping replay.";
+      break;
+    }
+
+    QDataStream record(&payload, QIODevice::ReadOnly);
+    record.setVersion(QDataStream::Qt_5_12);
+    quint8 type = 0;
+    record >> type;
+
+    bool ok = true;
+    switch (static_cast<RecordType>(type)) {
+      case RecordType::Insert:{
+        qint32 pos = 0, count = 0;
+        record >> pos >> count;
+        if (count < 0 || pos > items.count()) { ok = false; break; }
+        if (pos < 0) pos = static_cast<qint32>(items.count());
+        for (qint32 i = 0; i < count && ok; ++i) {
+          Song song;
+          record >> song;
+          if (record.status() != QDataStream::Ok) { ok = false; break; }
+          items.insert(pos + i, PlaylistItem::NewFromSong(song));
+        }
+        break;
+      }
+      case RecordType::Remove:{
+        qint32 row = 0, count = 0;
+        record >> row >> count;
+        if (row < 0 || count < 0 || row + count > items.count()) { ok = false; break; }
+        items.erase(items.begin() + row, items.begin() + row + count);
+        break;
+      }
+      case RecordType::Move:{
+        QList<int> source_rows;
+        qint32 pos = 0;
+        record >> source_rows >> pos;
+        ok = ApplyMove(items, source_rows, pos);
+        break;
+      }
+      case RecordType::MoveInverse:{
+        qint32 start = 0;
+        QList<int> dest_rows;
+        record >> start >> dest_rows;
+        ok = ApplyMoveInverse(items, start, dest_rows);
+        break;
+      }
+      case RecordType::Reorder:{
+        QList<int> permutation;
+        record >> permutation;
+        if (permutation.count() != items.count()) { ok = false; break; }
+        PlaylistItemPtrList reordered;
+        reordered.reserve(items.count());
+        for (const int old_row : std::as_const(permutation)) {
+          if (old_row < 0 || old_row >= items.count()) { ok = false; break; }
+          reordered << items[old_row];
+        }
+        if (ok) items = reordered;
+        break;
+      }
+      default:
+        ok = false;
+        break;
+    }
+
+    if (!ok || record.status() != QDataStream::Ok) {
+      qLog(Warning) << "Playlist journal" << file.fileName() << "has a record that does not apply, stopping replay.";
+      break;
+    }
+
+    ++records_applied;
+
+  }
+
+  file.close();
+
+  if (records_applied > 0) {
+    qLog(Info) << "Replayed" << records_applied << "journaled mutations for playlist" << playlist_id;
+  }
+
+  return items;
+
+}
+
+void Clear(const int playlist_id) {
+
+  QMutexLocker locker(&sMutex);
+
+  const QString filename = JournalFilename(playlist_id);
+  if (QFile::exists(filename)) {
+    QFile::remove(filename);
+  }
+
+}
+
+}  // namespace PlaylistMutationJournal
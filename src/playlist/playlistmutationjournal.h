@@ -0,0 +1,57 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PLAYLISTMUTATIONJOURNAL_H
+#define PLAYLISTMUTATIONJOURNAL_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QList>
+
+#include "core/song.h"
+#include "playlistitem.h"
+
+// Append-only journal of in-flight playlist mutations.
+// The playlist model appends a record per edit (insert, remove, move, reorder) which is flushed to disk immediately,
+// so an edit costs O(change) I/O while the full snapshot save stays on its debounce timer.
+// PlaylistBackend clears the journal when a snapshot commits; if the application dies before that,
+// Replay() patches the restored items with the journaled edits on the next startup.
+// Records are length-prefixed and checksummed, replay stops at the first torn or corrupt record.
+// All functions are thread safe, records are appended from the playlist thread and cleared from the backend thread.
+namespace PlaylistMutationJournal {
+
+void RecordInsert(const int playlist_id, const int pos, const SongList &songs);
+void RecordRemove(const int playlist_id, const int row, const int count);
+void RecordMove(const int playlist_id, const QList<int> &source_rows, const int pos);
+void RecordMoveInverse(const int playlist_id, const int start, const QList<int> &dest_rows);
+// permutation maps new row -> old row, i.e. new_items[i] == old_items[permutation[i]].
+void RecordReorder(const int playlist_id, const QList<int> &permutation);
+
+bool HasJournal(const int playlist_id);
+
+// Applies the journaled mutations to the restored items. Invalid records (stale rows, bad checksums) end the replay.
+PlaylistItemPtrList Replay(const int playlist_id, PlaylistItemPtrList items);
+
+// Deletes the journal, called after the full snapshot committed and when the playlist is removed.
+void Clear(const int playlist_id);
+
+}  // namespace PlaylistMutationJournal
+
+#endif  // PLAYLISTMUTATIONJOURNAL_H
@@ -84,8 +84,17 @@ void RemoveItems::redo() {
 
 void RemoveItems::undo() {
 
+  // Reinsert the ranges in ascending order, then run the post-insert bookkeeping (sorting, reshuffling, saving) once at the end instead of once per range.
+  int first_start = -1;
+  int last_end = -1;
   for (int i = static_cast<int>(ranges_.count() - 1); i >= 0; --i) {
-    playlist_->InsertItemsWithoutUndo(ranges_[i].items_, ranges_[i].pos_);
+    playlist_->InsertItemRows(ranges_[i].items_, ranges_[i].pos_);
+    if (first_start == -1) first_start = ranges_[i].pos_;
+    last_end = ranges_[i].pos_ + static_cast<int>(ranges_[i].items_.count()) - 1;
+  }
+
+  if (first_start != -1) {
+    playlist_->FinishInsert(first_start, last_end, false, false);
   }
 
 }
@@ -64,6 +64,7 @@
 #include "core/qt_blurimage.h"
 #include "core/song.h"
 #include "core/settings.h"
+#include "widgets/debugoverlay.h"
 #include "playlistmanager.h"
 #include "playlist.h"
 #include "playlistdelegates.h"
@@ -85,6 +86,7 @@ const int PlaylistView::kGlowIntensitySteps = 24;
 const int PlaylistView::kAutoscrollGraceTimeout = 30;  // seconds
 const int PlaylistView::kDropIndicatorWidth = 2;
 const int PlaylistView::kDropIndicatorGradientWidth = 5;
+const int PlaylistView::kRowPixmapCacheSizeKb = 32 * 1024;
 
 PlaylistView::PlaylistView(QWidget *parent)
     : QTreeView(parent),
@@ -131,6 +133,9 @@ PlaylistView::PlaylistView(QWidget *parent)
       currenttrack_play_(QStringLiteral(":/pictures/currenttrack_play.png")),
       currenttrack_pause_(QStringLiteral(":/pictures/currenttrack_pause.png")),
       cached_current_row_row_(-1),
+      cached_rows_(kRowPixmapCacheSizeKb),
+      row_cache_generation_(0),
+      hover_row_(-1),
       drop_indicator_row_(-1),
       drag_over_(false),
       header_state_version_(1),
@@ -160,6 +165,9 @@ PlaylistView::PlaylistView(QWidget *parent)
   QObject::connect(header_, &PlaylistHeader::sectionResized, this, &PlaylistView::InvalidateCachedCurrentPixmap);
   QObject::connect(header_, &PlaylistHeader::sectionMoved, this, &PlaylistView::InvalidateCachedCurrentPixmap);
   QObject::connect(header_, &PlaylistHeader::SectionVisibilityChanged, this, &PlaylistView::InvalidateCachedCurrentPixmap);
+  QObject::connect(header_, &PlaylistHeader::sectionResized, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(header_, &PlaylistHeader::sectionMoved, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(header_, &PlaylistHeader::SectionVisibilityChanged, this, &PlaylistView::InvalidateCachedRowPixmaps);
   QObject::connect(header_, &PlaylistHeader::StretchEnabledChanged, this, &PlaylistView::StretchChanged);
 
   QObject::connect(header_, &PlaylistHeader::SectionRatingLockStatusChanged, this, &PlaylistView::SetRatingLockStatus);
@@ -245,16 +253,29 @@ void PlaylistView::setModel(QAbstractItemModel *m) {
   if (model()) {
     QObject::disconnect(model(), &QAbstractItemModel::dataChanged, this, &PlaylistView::InvalidateCachedCurrentPixmap);
     QObject::disconnect(model(), &QAbstractItemModel::layoutAboutToBeChanged, this, &PlaylistView::RatingHoverOut);
+    QObject::disconnect(model(), &QAbstractItemModel::dataChanged, this, &PlaylistView::InvalidateCachedRowPixmaps);
+    QObject::disconnect(model(), &QAbstractItemModel::layoutChanged, this, &PlaylistView::InvalidateCachedRowPixmaps);
+    QObject::disconnect(model(), &QAbstractItemModel::modelReset, this, &PlaylistView::InvalidateCachedRowPixmaps);
+    QObject::disconnect(model(), &QAbstractItemModel::rowsInserted, this, &PlaylistView::InvalidateCachedRowPixmaps);
+    QObject::disconnect(model(), &QAbstractItemModel::rowsRemoved, this, &PlaylistView::InvalidateCachedRowPixmaps);
+    QObject::disconnect(model(), &QAbstractItemModel::rowsMoved, this, &PlaylistView::InvalidateCachedRowPixmaps);
 
     // When changing the model, always invalidate the current pixmap.
     // If a remote client uses "stop after", without invaliding the stop mark would not appear.
     InvalidateCachedCurrentPixmap();
+    InvalidateCachedRowPixmaps();
   }
 
   QTreeView::setModel(m);
 
   QObject::connect(model(), &QAbstractItemModel::dataChanged, this, &PlaylistView::InvalidateCachedCurrentPixmap);
   QObject::connect(model(), &QAbstractItemModel::layoutAboutToBeChanged, this, &PlaylistView::RatingHoverOut);
+  QObject::connect(model(), &QAbstractItemModel::dataChanged, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(model(), &QAbstractItemModel::layoutChanged, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(model(), &QAbstractItemModel::modelReset, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(model(), &QAbstractItemModel::rowsInserted, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(model(), &QAbstractItemModel::rowsRemoved, this, &PlaylistView::InvalidateCachedRowPixmaps);
+  QObject::connect(model(), &QAbstractItemModel::rowsMoved, this, &PlaylistView::InvalidateCachedRowPixmaps);
 
 }
 
@@ -565,7 +586,39 @@ void PlaylistView::drawRow(QPainter *painter, const QStyleOptionViewItem &option
     }
   }
   else {
-    QTreeView::drawRow(painter, opt, idx);
+    // Non-current rows are repainted far more often than they change while scrolling, so draw them through a cache of rendered row pixmaps.
+    // Rows whose painting depends on more than the model data and the paint state - the focused row, the hovered row and rows showing a rating hover preview - are drawn directly.
+    const bool whole_region = current_paint_region_.boundingRect().width() == viewport()->width();
+    const bool rating_hover = rating_delegate_ && rating_delegate_->mouse_over_index().isValid();
+    if (!whole_region ||
+        opt.rect.width() <= 0 ||
+        opt.rect.height() <= 0 ||
+        idx.row() == hover_row_ ||
+        (hasFocus() && currentIndex().row() == idx.row()) ||
+        (rating_hover && (rating_delegate_->mouse_over_index().row() == idx.row() || selectionModel()->isSelected(idx)))) {
+      QTreeView::drawRow(painter, opt, idx);
+      return;
+    }
+    // The base drawRow() derives the selection highlight from the live selection model, not from opt.state,
+    // so the row's selected state has to be part of the key for selecting and deselecting rows to repaint correctly.
+    const bool selected = selectionModel() && selectionModel()->isSelected(idx);
+    const QString cache_key = QStringLiteral("%1:%2:%3:%4:%5x%6").arg(row_cache_generation_).arg(idx.row()).arg(static_cast<quint32>(opt.state)).arg(selected ? 1 : 0).arg(opt.rect.width()).arg(opt.rect.height());
+    QPixmap *cached_row = cached_rows_.object(cache_key);
+    if (cached_row) {
+      painter->drawPixmap(opt.rect, *cached_row);
+    }
+    else {
+      QStyleOptionViewItem row_opt(opt);
+      row_opt.rect.moveTo(0, 0);
+      QPixmap pixmap(static_cast<int>(opt.rect.width() * device_pixel_ratio_), static_cast<int>(opt.rect.height() * device_pixel_ratio_));
+      pixmap.setDevicePixelRatio(device_pixel_ratio_);
+      pixmap.fill(Qt::transparent);
+      QPainter p(&pixmap);
+      QTreeView::drawRow(&p, row_opt, idx);
+      p.end();
+      painter->drawPixmap(opt.rect, pixmap);
+      cached_rows_.insert(cache_key, new QPixmap(pixmap), qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024));
+    }
   }
 
 }
@@ -589,6 +642,14 @@ void PlaylistView::InvalidateCachedCurrentPixmap() {
   cached_current_row_ = QPixmap();
 }
 
+void PlaylistView::InvalidateCachedRowPixmaps() {
+
+  // The generation is part of the cache key, so bumping it orphans every cached row. Clear as well to release the memory right away.
+  ++row_cache_generation_;
+  cached_rows_.clear();
+
+}
+
 void PlaylistView::timerEvent(QTimerEvent *event) {
   QTreeView::timerEvent(event);
   if (event->timerId() == glow_timer_.timerId()) GlowIntensityChanged();
@@ -801,6 +862,26 @@ void PlaylistView::closeEditor(QWidget *editor, const QAbstractItemDelegate::End
 
 }
 
+bool PlaylistView::viewportEvent(QEvent *event) {
+
+  // Track the hovered row the same way the base view derives its hover state,
+  // so drawRow() can bypass the row pixmap cache for the row that gets the hover highlight.
+  switch (event->type()) {
+    case QEvent::HoverEnter:
+    case QEvent::HoverMove:
+      hover_row_ = indexAt(static_cast<QHoverEvent*>(event)->position().toPoint()).row();
+      break;
+    case QEvent::HoverLeave:
+      hover_row_ = -1;
+      break;
+    default:
+      break;
+  }
+
+  return QTreeView::viewportEvent(event);
+
+}
+
 void PlaylistView::mouseMoveEvent(QMouseEvent *event) {
 
   // Check whether rating section is locked by user or not
@@ -885,7 +966,9 @@ void PlaylistView::mousePressEvent(QMouseEvent *event) {
 void PlaylistView::scrollContentsBy(const int dx, const int dy) {
 
   if (dx != 0) {
+    // PlaylistDelegateBase::Adjusted() paints the first visible column differently, so horizontal scrolling changes how rows are rendered.
     InvalidateCachedCurrentPixmap();
+    InvalidateCachedRowPixmaps();
   }
   cached_tree_ = QPixmap();
 
@@ -955,6 +1038,8 @@ void PlaylistView::JumpToLastPlayedTrack() {
 
 void PlaylistView::paintEvent(QPaintEvent *event) {
 
+  ScopedPaintTimer paint_timer("PlaylistView");
+
   // Reimplemented to draw the background image.
   // Reimplemented also to draw the drop indicator
   // When the user is dragging some stuff over the playlist paintEvent gets called for the entire viewport every time the user moves the mouse.
@@ -1270,6 +1355,9 @@ void PlaylistView::ReloadSettings() {
 
   if (playlist_) playlist_->set_auto_sort(auto_sort_);
 
+  // Colors, alternating rows or other appearance settings may have changed.
+  InvalidateCachedRowPixmaps();
+
 }
 
 void PlaylistView::SaveSettings() {
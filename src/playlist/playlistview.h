@@ -42,6 +42,7 @@
 #include <QStyleOption>
 #include <QPoint>
 #include <QBasicTimer>
+#include <QCache>
 
 #include "core/song.h"
 #include "covermanager/albumcoverloaderresult.h"
@@ -121,6 +122,7 @@ class PlaylistView : public QTreeView {
   void hideEvent(QHideEvent *event) override;
   void showEvent(QShowEvent *event) override;
   void timerEvent(QTimerEvent *event) override;
+  bool viewportEvent(QEvent *event) override;
   void mouseMoveEvent(QMouseEvent *event) override;
   void mousePressEvent(QMouseEvent *event) override;
   void leaveEvent(QEvent*) override;
@@ -150,6 +152,7 @@ class PlaylistView : public QTreeView {
   void InhibitAutoscrollTimeout();
   void MaybeAutoscroll(const Playlist::AutoScroll autoscroll);
   void InvalidateCachedCurrentPixmap();
+  void InvalidateCachedRowPixmaps();
   void PlaylistDestroyed();
   void StretchChanged(const bool stretch);
   void FadePreviousBackgroundImage(const qreal value);
@@ -190,6 +193,7 @@ class PlaylistView : public QTreeView {
   static const int kAutoscrollGraceTimeout;
   static const int kDropIndicatorWidth;
   static const int kDropIndicatorGradientWidth;
+  static const int kRowPixmapCacheSizeKb;
 
   QList<int> GetEditableColumns();
   QModelIndex NextEditableIndex(const QModelIndex &current);
@@ -264,6 +268,13 @@ class PlaylistView : public QTreeView {
   QRect cached_current_row_rect_;
   int cached_current_row_row_;
 
+  // Rendered pixmaps for the rows that are not the current row, keyed by row, paint state, selected state and size.
+  // The generation is part of the key and is bumped whenever the model or the appearance changes, invalidating every cached row at once.
+  mutable QCache<QString, QPixmap> cached_rows_;
+  quint64 row_cache_generation_;
+  // Row currently under the mouse, tracked in viewportEvent(). The hover highlight is painted by the base view, so this row bypasses the pixmap cache.
+  int hover_row_;
+
   QPixmap cached_tree_;
   int drop_indicator_row_;
   bool drag_over_;
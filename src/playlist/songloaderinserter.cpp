@@ -41,6 +41,7 @@ SongLoaderInserter::SongLoaderInserter(SharedPtr<TaskManager> task_manager, Shar
       play_now_(true),
       enqueue_(false),
       enqueue_next_(false),
+      streamed_rows_(0),
       collection_backend_(collection_backend),
       player_(player) {}
 
@@ -56,6 +57,7 @@ void SongLoaderInserter::Load(Playlist *destination, int row, bool play_now, boo
 
   QObject::connect(destination, &Playlist::destroyed, this, &SongLoaderInserter::DestinationDestroyed);
   QObject::connect(this, &SongLoaderInserter::PreloadFinished, this, &SongLoaderInserter::InsertSongs);
+  QObject::connect(this, &SongLoaderInserter::PartialLoadFinished, this, &SongLoaderInserter::InsertRemainingSongs);
   QObject::connect(this, &SongLoaderInserter::EffectiveLoadFinished, destination, &Playlist::UpdateItems);
 
   for (const QUrl &url : urls) {
@@ -164,37 +166,62 @@ void SongLoaderInserter::InsertSongs() {
 
 }
 
+void SongLoaderInserter::InsertRemainingSongs(const SongList &songs) {
+
+  // The first batch was already inserted and may have started playing, so these go right after it without taking over playback.
+  if (destination_ && !songs.isEmpty()) {
+    destination_->InsertSongsOrCollectionItems(songs, row_ >= 0 ? row_ + streamed_rows_ : -1, false, enqueue_, enqueue_next_);
+  }
+
+}
+
 void SongLoaderInserter::AsyncLoad() {
 
   // First, quick load raw songs.
   int async_progress = 0;
   int async_load_id = task_manager_->StartTask(tr("Loading tracks"));
   task_manager_->SetTaskProgress(async_load_id, async_progress, pending_.count());
-  bool first_loaded = false;
-  for (int i = 0; i < pending_.count(); ++i) {
-    SongLoader *loader = pending_[i];
-    SongLoader::Result res = loader->LoadFilenamesBlocking();
-    task_manager_->SetTaskProgress(async_load_id, ++async_progress);
 
-    if (res == SongLoader::Result::Error) {
-      for (const QString &error : loader->errors()) {
-        emit Error(error);
-      }
-      continue;
+  // Expand the first loader on its own and stream its songs into the playlist right away,
+  // so the first songs of a large drop show up (and can start playing) while the rest is still expanding.
+  SongLoader *first_loader = pending_.first();
+  const SongLoader::Result first_result = first_loader->LoadFilenamesBlocking();
+  task_manager_->SetTaskProgress(async_load_id, ++async_progress);
+  if (first_result == SongLoader::Result::Error) {
+    for (const QString &error : first_loader->errors()) {
+      emit Error(error);
     }
+  }
+  else {
+    // Load everything from the first song.
+    // It'll start playing as soon as we emit PreloadFinished, so it needs to have the duration set to show properly in the UI.
+    first_loader->LoadMetadataBlocking();
+    songs_ << first_loader->songs();
+  }
+  streamed_rows_ = static_cast<int>(songs_.count());
+  emit PreloadFinished();
 
-    if (!first_loaded) {
-      // Load everything from the first song.
-      // It'll start playing as soon as we emit PreloadFinished, so it needs to have the duration set to show properly in the UI.
-      loader->LoadMetadataBlocking();
-      first_loaded = true;
+  // Expand the remaining loaders in parallel on the thread pool.
+  // blockingMapped keeps the results in drop order, so the songs are assembled in the order the URLs were dropped.
+  const QList<SongLoader*> remaining = pending_.mid(1);
+  if (!remaining.isEmpty()) {
+    const QList<SongLoader::Result> results = QtConcurrent::blockingMapped(remaining, [](SongLoader *loader) { return loader->LoadFilenamesBlocking(); });
+    task_manager_->SetTaskProgress(async_load_id, pending_.count());
+    SongList remaining_songs;
+    for (qsizetype i = 0; i < remaining.count(); ++i) {
+      SongLoader *loader = remaining.value(i);
+      if (results.value(i) == SongLoader::Result::Error) {
+        for (const QString &error : loader->errors()) {
+          emit Error(error);
+        }
+        continue;
+      }
+      remaining_songs << loader->songs();
     }
-
-    songs_ << loader->songs();
-
+    songs_ << remaining_songs;
+    emit PartialLoadFinished(remaining_songs);
   }
   task_manager_->SetTaskFinished(async_load_id);
-  emit PreloadFinished();
 
   // Songs are inserted in playlist, now load them completely.
   async_progress = 0;
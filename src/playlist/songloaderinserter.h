@@ -51,6 +51,7 @@ class SongLoaderInserter : public QObject {
  signals:
   void Error(const QString &message);
   void PreloadFinished();
+  void PartialLoadFinished(const SongList &songs);
   void EffectiveLoadFinished(const SongList &songs);
 
  private slots:
@@ -58,6 +59,7 @@ class SongLoaderInserter : public QObject {
   void AudioCDTracksLoadFinished(SongLoader *loader);
   void AudioCDTagsLoaded(const bool success);
   void InsertSongs();
+  void InsertRemainingSongs(const SongList &songs);
 
  private:
   void AsyncLoad();
@@ -72,6 +74,8 @@ class SongLoaderInserter : public QObject {
   bool enqueue_next_;
 
   SongList songs_;
+  // Number of songs inserted by the first InsertSongs() call, the remaining songs are inserted right after them.
+  int streamed_rows_;
 
   QList<SongLoader*> pending_;
   SharedPtr<CollectionBackendInterface> collection_backend_;
@@ -21,10 +21,14 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QIODevice>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QStringList>
@@ -63,6 +67,20 @@ constexpr char kRem[] = "rem";
 constexpr char kGenre[] = "genre";
 constexpr char kDate[] = "date";
 constexpr char kDisc[] = "discnumber";
+
+// Process-wide cache of parsed CUE sheets for LoadFromFileCached(), keyed on path and validated by mtime.
+// Crude size cap, a full clear is fine since entries are rebuilt with one parse each.
+constexpr qsizetype kCueCacheMaxEntries = 512;
+
+struct CueCacheEntry {
+  qint64 mtime = 0;
+  bool collection_lookup = false;
+  SongList songs;
+};
+
+QMutex sCueCacheMutex;
+QHash<QString, CueCacheEntry> sCueCache;
+
 }  // namespace
 
 CueParser::CueParser(SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent)
@@ -385,6 +403,35 @@ qint64 CueParser::IndexToMarker(const QString &index) {
 
 }
 
+SongList CueParser::LoadFromFileCached(const QString &cue_path, const QDir &dir, const bool collection_lookup) const {
+
+  const qint64 mtime = QFileInfo(cue_path).lastModified().toSecsSinceEpoch();
+
+  {
+    QMutexLocker l(&sCueCacheMutex);
+    const QHash<QString, CueCacheEntry>::const_iterator it = sCueCache.constFind(cue_path);
+    if (it != sCueCache.constEnd() && it->mtime == mtime && it->collection_lookup == collection_lookup) {
+      return it->songs;
+    }
+  }
+
+  QFile cue_file(cue_path);
+  if (!cue_file.exists()) return SongList();
+  if (!cue_file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Could not open CUE file" << cue_path << "for reading:" << cue_file.errorString();
+    return SongList();
+  }
+  const SongList songs = Load(&cue_file, cue_path, dir, collection_lookup);
+  cue_file.close();
+
+  QMutexLocker l(&sCueCacheMutex);
+  if (sCueCache.count() >= kCueCacheMaxEntries) sCueCache.clear();
+  sCueCache.insert(cue_path, CueCacheEntry{mtime, collection_lookup, songs});
+
+  return songs;
+
+}
+
 void CueParser::Save(const SongList &songs, QIODevice *device, const QDir &dir, const PlaylistSettingsPage::PathType path_type) const {
 
   Q_UNUSED(songs);
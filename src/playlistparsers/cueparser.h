@@ -58,6 +58,11 @@ class CueParser : public ParserBase {
   SongList Load(QIODevice *device, const QString &playlist_path = QLatin1String(""), const QDir &dir = QDir(), const bool collection_lookup = true) const override;
   void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const override;
 
+  // Loads a .cue file, reusing the result of the previous parse when the file hasn't changed since.
+  // Scans and bulk operations hit the same sheet once per media file it references, this makes that one parse per file change.
+  // Returns an empty list if the file doesn't exist or can't be read.
+  SongList LoadFromFileCached(const QString &cue_path, const QDir &dir, const bool collection_lookup = true) const;
+
   static QString FindCueFilename(const QString &filename);
 
  private:
@@ -21,10 +21,10 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
-#include <QBuffer>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
+#include <QTextStream>
 #include <QSettings>
 
 #include "core/shared_ptr.h"
@@ -42,59 +42,66 @@ M3UParser::M3UParser(SharedPtr<CollectionBackendInterface> collection_backend, Q
 
 SongList M3UParser::Load(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
+  SongList ret;
+  LoadIncrementally(device, [&ret](const SongList &songs) { ret << songs; }, playlist_path, dir, collection_lookup);
+  return ret;
+
+}
+
+void M3UParser::LoadIncrementally(QIODevice *device, const SongBatchCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
   Q_UNUSED(playlist_path);
 
   M3UType type = M3UType::STANDARD;
   Metadata current_metadata;
 
-  QString data = QString::fromUtf8(device->readAll());
-  data.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-  data.replace(QLatin1String("\n\n"), QLatin1String("\n"));
-  QByteArray bytes = data.toUtf8();
-  QBuffer buffer(&bytes);
-  if (!buffer.open(QIODevice::ReadOnly)) return SongList();
-
-  QString line = QString::fromUtf8(buffer.readLine()).trimmed();
-  if (line.startsWith(QLatin1String("#EXTM3U"))) {
-    // This is in extended M3U format.
-    type = M3UType::EXTENDED;
-    line = QString::fromUtf8(buffer.readLine()).trimmed();
-  }
-
-  SongList ret;
-  forever {
-    if (line.startsWith(QLatin1Char('#'))) {
-      // Extended info or comment.
-      if (type == M3UType::EXTENDED && line.startsWith(QLatin1String("#EXT"))) {
-        if (!ParseMetadata(line, &current_metadata)) {
-          qLog(Warning) << "Failed to parse metadata: " << line;
+  // Read the file line by line instead of all at once, so a giant playlist never has to be held in memory whole.
+  // readLine() splits on '\n'; splitting the result on '\r' also handles '\r\n' and classic Mac line endings.
+  SongList batch;
+  bool first_line = true;
+  while (!device->atEnd()) {
+    const QStringList lines = QString::fromUtf8(device->readLine()).split(QLatin1Char('\r'), Qt::SkipEmptyParts);
+    for (const QString &raw_line : lines) {
+      const QString line = raw_line.trimmed();
+      if (first_line) {
+        first_line = false;
+        if (line.startsWith(QLatin1String("#EXTM3U"))) {
+          // This is in extended M3U format.
+          type = M3UType::EXTENDED;
+          continue;
         }
       }
-    }
-    else if (!line.isEmpty()) {
-      Song song = LoadSong(line, 0, 0, dir, collection_lookup);
-      if (!current_metadata.title.isEmpty()) {
-        song.set_title(current_metadata.title);
-      }
-      if (!current_metadata.artist.isEmpty()) {
-        song.set_artist(current_metadata.artist);
-      }
-      if (current_metadata.length > 0) {
-        song.set_length_nanosec(current_metadata.length);
+      if (line.startsWith(QLatin1Char('#'))) {
+        // Extended info or comment.
+        if (type == M3UType::EXTENDED && line.startsWith(QLatin1String("#EXT"))) {
+          if (!ParseMetadata(line, &current_metadata)) {
+            qLog(Warning) << "Failed to parse metadata: " << line;
+          }
+        }
       }
-      ret << song;
+      else if (!line.isEmpty()) {
+        Song song = LoadSong(line, 0, 0, dir, collection_lookup);
+        if (!current_metadata.title.isEmpty()) {
+          song.set_title(current_metadata.title);
+        }
+        if (!current_metadata.artist.isEmpty()) {
+          song.set_artist(current_metadata.artist);
+        }
+        if (current_metadata.length > 0) {
+          song.set_length_nanosec(current_metadata.length);
+        }
+        batch << song;
+        if (batch.count() >= kLoadBatchSize) {
+          callback(batch);
+          batch.clear();
+        }
 
-      current_metadata = Metadata();
-    }
-    if (buffer.atEnd()) {
-      break;
+        current_metadata = Metadata();
+      }
     }
-    line = QString::fromUtf8(buffer.readLine()).trimmed();
   }
 
-  buffer.close();
-
-  return ret;
+  if (!batch.isEmpty()) callback(batch);
 
 }
 
@@ -125,7 +132,10 @@ bool M3UParser::ParseMetadata(const QString &line, M3UParser::Metadata *metadata
 
 void M3UParser::Save(const SongList &songs, QIODevice *device, const QDir &dir, const PlaylistSettingsPage::PathType path_type) const {
 
-  device->write("#EXTM3U\n");
+  // Write through a QTextStream so the entries are buffered instead of hitting the device three times per song.
+  QTextStream stream(device);
+
+  stream << "#EXTM3U\n";
 
   Settings s;
   s.beginGroup(PlaylistSettingsPage::kSettingsGroup);
@@ -137,11 +147,9 @@ void M3UParser::Save(const SongList &songs, QIODevice *device, const QDir &dir,
       continue;
     }
     if (write_metadata || (song.is_stream() && !song.is_radio())) {
-      QString meta = QStringLiteral("#EXTINF:%1,%2 - %3\n").arg(song.length_nanosec() / kNsecPerSec).arg(song.artist(), song.title());
-      device->write(meta.toUtf8());
+      stream << QStringLiteral("#EXTINF:%1,%2 - %3\n").arg(song.length_nanosec() / kNsecPerSec).arg(song.artist(), song.title());
     }
-    device->write(URLOrFilename(song.url(), dir, path_type).toUtf8());
-    device->write("\n");
+    stream << URLOrFilename(song.url(), dir, path_type) << '\n';
   }
 
 }
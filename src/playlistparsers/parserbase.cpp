@@ -37,6 +37,13 @@
 ParserBase::ParserBase(SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent)
     : QObject(parent), collection_backend_(collection_backend) {}
 
+void ParserBase::LoadIncrementally(QIODevice *device, const SongBatchCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
+  const SongList songs = Load(device, playlist_path, dir, collection_lookup);
+  if (!songs.isEmpty()) callback(songs);
+
+}
+
 void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const {
 
   if (filename_or_url.isEmpty()) {
@@ -24,6 +24,8 @@
 
 #include "config.h"
 
+#include <functional>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QDir>
@@ -61,6 +63,18 @@ class ParserBase : public QObject {
   virtual SongList Load(QIODevice *device, const QString &playlist_path = QLatin1String(""), const QDir &dir = QDir(), const bool collection_lookup = true) const = 0;
   virtual void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const = 0;
 
+  // How many songs an incremental load hands to the callback at a time.
+  static constexpr int kLoadBatchSize = 500;
+
+  using SongBatchCallback = std::function<void(const SongList &songs)>;
+
+  // Incremental counterpart of Load() for very large playlist files.
+  // Parses the device and hands the songs to 'callback' in batches of at most kLoadBatchSize,
+  // so memory stays bounded by the batch size instead of the file size and the caller can use the first entries while the rest is still being parsed.
+  // The base implementation falls back to Load() and delivers everything as one batch;
+  // parsers whose format can be read sequentially override it with a real streaming implementation.
+  virtual void LoadIncrementally(QIODevice *device, const SongBatchCallback &callback, const QString &playlist_path = QLatin1String(""), const QDir &dir = QDir(), const bool collection_lookup = true) const;
+
  signals:
   void Error(const QString &error) const;
 
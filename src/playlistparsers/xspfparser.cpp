@@ -44,23 +44,35 @@ XSPFParser::XSPFParser(SharedPtr<CollectionBackendInterface> collection_backend,
 
 SongList XSPFParser::Load(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
-  Q_UNUSED(playlist_path);
-
   SongList songs;
+  LoadIncrementally(device, [&songs](const SongList &batch) { songs << batch; }, playlist_path, dir, collection_lookup);
+  return songs;
+
+}
 
+void XSPFParser::LoadIncrementally(QIODevice *device, const SongBatchCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
+  Q_UNUSED(playlist_path);
+
+  // QXmlStreamReader reads from the device incrementally, so only one batch of songs is in memory at a time.
   QXmlStreamReader reader(device);
   if (!Utilities::ParseUntilElement(&reader, QStringLiteral("playlist")) || !Utilities::ParseUntilElement(&reader, QStringLiteral("trackList"))) {
-    return songs;
+    return;
   }
 
+  SongList batch;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, QStringLiteral("track"))) {
     const Song song = ParseTrack(&reader, dir, collection_lookup);
     if (song.is_valid()) {
-      songs << song;
+      batch << song;
+      if (batch.count() >= kLoadBatchSize) {
+        callback(batch);
+        batch.clear();
+      }
     }
   }
 
-  return songs;
+  if (!batch.isEmpty()) callback(batch);
 
 }
 
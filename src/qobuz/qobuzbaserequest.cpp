@@ -39,6 +39,7 @@
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "qobuzservice.h"
 #include "qobuzbaserequest.h"
 
@@ -49,7 +50,7 @@ QobuzBaseRequest::QobuzBaseRequest(QobuzService *service, SharedPtr<NetworkAcces
 
 QobuzBaseRequest::~QobuzBaseRequest() = default;
 
-QNetworkReply *QobuzBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided) {
+QNetworkReply *QobuzBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided, const int cache_expiry_secs) {
 
   ParamList params = ParamList() << params_provided
                                  << Param(QStringLiteral("app_id"), app_id());
@@ -68,6 +69,7 @@ QNetworkReply *QobuzBaseRequest::CreateRequest(const QString &ressource_name, co
   req.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/x-www-form-urlencoded"));
   req.setRawHeader("X-App-Id", app_id().toUtf8());
   if (authenticated()) req.setRawHeader("X-User-Auth-Token", user_auth_token().toUtf8());
+  if (cache_expiry_secs > 0) req.setAttribute(NetworkAccessManager::kCacheExpirySecsAttribute, cache_expiry_secs);
 
   QNetworkReply *reply = network_->get(req);
   QObject::connect(reply, &QNetworkReply::sslErrors, this, &QobuzBaseRequest::HandleSSLErrors);
@@ -92,8 +94,17 @@ QByteArray QobuzBaseRequest::GetReplyData(QNetworkReply *reply) {
 
   if (reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
     data = reply->readAll();
+    // Requests tagged with an expiry time are idempotent, store the reply so browsing the same listing again is served from the disk cache.
+    const int cache_expiry_secs = reply->request().attribute(NetworkAccessManager::kCacheExpirySecsAttribute).toInt();
+    if (cache_expiry_secs > 0 && !reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+      network_->CacheResponse(reply->url(), data, cache_expiry_secs);
+    }
   }
   else {
+    // Feed 429 replies back into the rate limiter so the bucket for this host shrinks.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429) {
+      RateLimiter::RateLimited(reply->url());
+    }
     if (reply->error() != QNetworkReply::NoError && reply->error() < 200) {
       // This is a network error, there is nothing more to do.
       Error(QStringLiteral("%1 (%2)").arg(reply->errorString()).arg(reply->error()));
@@ -144,6 +155,10 @@ QJsonObject QobuzBaseRequest::ExtractJsonObj(QByteArray &data) {
     return QJsonObject();
   }
 
+  // The document holds its own copy of the parsed data, release the raw body now
+  // so peak memory while walking a large reply is one copy instead of two.
+  data.clear();
+
   if (!json_doc.isObject()) {
     Error(QStringLiteral("Json document is not an object."), json_doc);
     return QJsonObject();
@@ -63,7 +63,7 @@ class QobuzBaseRequest : public QObject {
   using Param = QPair<QString, QString>;
   using ParamList = QList<Param>;
 
-  QNetworkReply *CreateRequest(const QString &ressource_name, const ParamList &params_provided);
+  QNetworkReply *CreateRequest(const QString &ressource_name, const ParamList &params_provided, const int cache_expiry_secs = 0);
   QByteArray GetReplyData(QNetworkReply *reply);
   QJsonObject ExtractJsonObj(QByteArray &data);
   QJsonValue ExtractItems(QByteArray &data);
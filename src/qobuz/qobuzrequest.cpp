@@ -37,6 +37,7 @@
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "core/song.h"
 #include "core/application.h"
 #include "utilities/timeconstants.h"
@@ -55,6 +56,10 @@ constexpr int kMaxConcurrentArtistAlbumsRequests = 3;
 constexpr int kMaxConcurrentAlbumSongsRequests = 3;
 constexpr int kMaxConcurrentAlbumCoverRequests = 1;
 constexpr int kFlushRequestsDelay = 200;
+// How long idempotent replies stay valid in the disk cache.
+// Search results change more often than the albums and tracks of a given artist or album, favorites are never cached.
+constexpr int kSearchCacheExpirySecs = 60 * 60;
+constexpr int kBrowseCacheExpirySecs = 24 * 60 * 60;
 }  // namespace
 
 QobuzRequest::QobuzRequest(QobuzService *service, QobuzUrlHandler *url_handler, Application *app, SharedPtr<NetworkAccessManager> network, const Type query_type, QObject *parent)
@@ -123,6 +128,9 @@ QobuzRequest::~QobuzRequest() {
 
 void QobuzRequest::Process() {
 
+  // Warm up the connection to the API host so the first batch of requests doesn't pay for the TLS handshake.
+  network_->PreConnect(QUrl(QString::fromLatin1(QobuzService::kApiUrl)));
+
   switch (query_type_) {
     case Type::Artists:
       GetArtists();
@@ -221,7 +229,7 @@ void QobuzRequest::AddArtistsRequest(const int offset, const int limit) {
 
 void QobuzRequest::FlushArtistsRequests() {
 
-  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests) {
+  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(QobuzService::kApiUrl)))) {
 
     Request request = artists_requests_queue_.dequeue();
 
@@ -238,7 +246,7 @@ void QobuzRequest::FlushArtistsRequests() {
       reply = CreateRequest(QStringLiteral("favorite/getUserFavorites"), params);
     }
     else if (query_type_ == Type::SearchArtists) {
-      reply = CreateRequest(QStringLiteral("artist/search"), params);
+      reply = CreateRequest(QStringLiteral("artist/search"), params, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -273,7 +281,7 @@ void QobuzRequest::AddAlbumsRequest(const int offset, const int limit) {
 
 void QobuzRequest::FlushAlbumsRequests() {
 
-  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests) {
+  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(QobuzService::kApiUrl)))) {
 
     Request request = albums_requests_queue_.dequeue();
 
@@ -290,7 +298,7 @@ void QobuzRequest::FlushAlbumsRequests() {
       reply = CreateRequest(QStringLiteral("favorite/getUserFavorites"), params);
     }
     else if (query_type_ == Type::SearchAlbums) {
-      reply = CreateRequest(QStringLiteral("album/search"), params);
+      reply = CreateRequest(QStringLiteral("album/search"), params, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -325,7 +333,7 @@ void QobuzRequest::AddSongsRequest(const int offset, const int limit) {
 
 void QobuzRequest::FlushSongsRequests() {
 
-  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests) {
+  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(QobuzService::kApiUrl)))) {
 
     Request request = songs_requests_queue_.dequeue();
 
@@ -342,7 +350,7 @@ void QobuzRequest::FlushSongsRequests() {
       reply = CreateRequest(QStringLiteral("favorite/getUserFavorites"), params);
     }
     else if (query_type_ == Type::SearchSongs) {
-      reply = CreateRequest(QStringLiteral("track/search"), params);
+      reply = CreateRequest(QStringLiteral("track/search"), params, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -532,10 +540,13 @@ void QobuzRequest::ArtistsFinishCheck(const int limit, const int offset, const i
   if (finished_) return;
 
   if ((limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
-    int offset_next = offset + artists_received;
-    if (offset_next > 0 && offset_next < artists_total_) {
-      if (query_type_ == Type::Artists) AddArtistsRequest(offset_next);
-      else if (query_type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+    // The first reply tells us the page size and the total, so queue all the remaining pages at once.
+    // FlushRequests() keeps a window of them in flight, so pagination is not serialized on round-trips.
+    if (offset == 0 && artists_received > 0) {
+      for (int offset_next = artists_received; offset_next < artists_total_; offset_next += artists_received) {
+        if (query_type_ == Type::Artists) AddArtistsRequest(offset_next);
+        else if (query_type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+      }
     }
   }
 
@@ -583,7 +594,7 @@ void QobuzRequest::AddArtistAlbumsRequest(const Artist &artist, const int offset
 
 void QobuzRequest::FlushArtistAlbumsRequests() {
 
-  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests) {
+  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(QobuzService::kApiUrl)))) {
 
     const ArtistAlbumsRequest request = artist_albums_requests_queue_.dequeue();
 
@@ -591,7 +602,7 @@ void QobuzRequest::FlushArtistAlbumsRequests() {
                                    << Param(QStringLiteral("extra"), QStringLiteral("albums"));
 
     if (request.offset > 0) params << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("artist/get"), params);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("artist/get"), params, kBrowseCacheExpirySecs);
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
     replies_ << reply;
 
@@ -769,21 +780,23 @@ void QobuzRequest::AlbumsFinishCheck(const Artist &artist, const int limit, cons
   if (finished_) return;
 
   if (limit == 0 || limit > albums_received) {
-    int offset_next = offset + albums_received;
-    if (offset_next > 0 && offset_next < albums_total) {
-      switch (query_type_) {
-        case Type::Albums:
-          AddAlbumsRequest(offset_next);
-          break;
-        case Type::SearchAlbums:
-          AddAlbumsSearchRequest(offset_next);
-          break;
-        case Type::Artists:
-        case Type::SearchArtists:
-          AddArtistAlbumsRequest(artist, offset_next);
-          break;
-        default:
-          break;
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && albums_received > 0) {
+      for (int offset_next = albums_received; offset_next < albums_total; offset_next += albums_received) {
+        switch (query_type_) {
+          case Type::Albums:
+            AddAlbumsRequest(offset_next);
+            break;
+          case Type::SearchAlbums:
+            AddAlbumsSearchRequest(offset_next);
+            break;
+          case Type::Artists:
+          case Type::SearchArtists:
+            AddArtistAlbumsRequest(artist, offset_next);
+            break;
+          default:
+            break;
+        }
       }
     }
   }
@@ -841,12 +854,12 @@ void QobuzRequest::AddAlbumSongsRequest(const Artist &artist, const Album &album
 
 void QobuzRequest::FlushAlbumSongsRequests() {
 
-  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests) {
+  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests && RateLimiter::TryAcquire(QUrl(QString::fromLatin1(QobuzService::kApiUrl)))) {
 
     AlbumSongsRequest request = album_songs_requests_queue_.dequeue();
     ParamList params = ParamList() << Param(QStringLiteral("album_id"), request.album.album_id);
     if (request.offset > 0) params << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("album/get"), params);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("album/get"), params, kBrowseCacheExpirySecs);
     replies_ << reply;
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
 
@@ -1032,23 +1045,25 @@ void QobuzRequest::SongsFinishCheck(const Artist &artist, const Album &album, co
   if (finished_) return;
 
   if (limit == 0 || limit > songs_received) {
-    int offset_next = offset + songs_received;
-    if (offset_next > 0 && offset_next < songs_total) {
-      switch (query_type_) {
-        case Type::Songs:
-          AddSongsRequest(offset_next);
-          break;
-        case Type::SearchSongs:
-          AddSongsSearchRequest(offset_next);
-          break;
-        case Type::Artists:
-        case Type::SearchArtists:
-        case Type::Albums:
-        case Type::SearchAlbums:
-          AddAlbumSongsRequest(artist, album, offset_next);
-          break;
-        default:
-          break;
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && songs_received > 0) {
+      for (int offset_next = songs_received; offset_next < songs_total; offset_next += songs_received) {
+        switch (query_type_) {
+          case Type::Songs:
+            AddSongsRequest(offset_next);
+            break;
+          case Type::SearchSongs:
+            AddSongsSearchRequest(offset_next);
+            break;
+          case Type::Artists:
+          case Type::SearchArtists:
+          case Type::Albums:
+          case Type::SearchAlbums:
+            AddAlbumSongsRequest(artist, album, offset_next);
+            break;
+          default:
+            break;
+        }
       }
     }
   }
@@ -44,35 +44,44 @@ namespace {
 constexpr char kRowsMimetype[] = "application/x-strawberry-queue-rows";
 }
 
-Queue::Queue(Playlist *playlist, QObject *parent) : QAbstractProxyModel(parent), playlist_(playlist), total_length_ns_(0) {
+Queue::Queue(Playlist *playlist, QObject *parent) : QAbstractProxyModel(parent), source_rows_dirty_(true), playlist_(playlist), total_length_ns_(0) {
 
-  signal_item_count_changed_ = QObject::connect(this, &Queue::ItemCountChanged, this, &Queue::UpdateTotalLength);
   QObject::connect(this, &Queue::TotalLengthChanged, this, &Queue::UpdateSummaryText);
 
   UpdateSummaryText();
 
 }
 
-QModelIndex Queue::mapFromSource(const QModelIndex &source_index) const {
+void Queue::EnsurePositionCache() const {
 
-  if (!source_index.isValid()) return QModelIndex();
+  if (!source_rows_dirty_) return;
 
-  const int source_row = source_index.row();
+  source_rows_.clear();
+  source_rows_.reserve(static_cast<int>(source_indexes_.count()));
   for (int i = 0; i < source_indexes_.count(); ++i) {
-    if (source_indexes_[i].row() == source_row) {
-      return index(i, source_index.column());
-    }
+    source_rows_.insert(source_indexes_[i].row(), i);
   }
-  return QModelIndex();
+  source_rows_dirty_ = false;
+
+}
+
+void Queue::InvalidatePositionCache() { source_rows_dirty_ = true; }
+
+QModelIndex Queue::mapFromSource(const QModelIndex &source_index) const {
+
+  if (!source_index.isValid()) return QModelIndex();
+
+  EnsurePositionCache();
+  const int proxy_row = source_rows_.value(source_index.row(), -1);
+  if (proxy_row == -1) return QModelIndex();
+  return index(proxy_row, source_index.column());
 
 }
 
 bool Queue::ContainsSourceRow(const int source_row) const {
 
-  for (int i = 0; i < source_indexes_.count(); ++i) {
-    if (source_indexes_[i].row() == source_row) return true;
-  }
-  return false;
+  EnsurePositionCache();
+  return source_rows_.contains(source_row);
 
 }
 
@@ -90,6 +99,9 @@ void Queue::setSourceModel(QAbstractItemModel *source_model) {
     QObject::disconnect(sourceModel(), &QAbstractItemModel::dataChanged, this, &Queue::SourceDataChanged);
     QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &Queue::SourceLayoutChanged);
     QObject::disconnect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &Queue::SourceLayoutChanged);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &Queue::InvalidatePositionCache);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsMoved, this, &Queue::InvalidatePositionCache);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::modelReset, this, &Queue::InvalidatePositionCache);
   }
 
   QAbstractProxyModel::setSourceModel(source_model);
@@ -97,6 +109,10 @@ void Queue::setSourceModel(QAbstractItemModel *source_model) {
   QObject::connect(sourceModel(), &QAbstractItemModel::dataChanged, this, &Queue::SourceDataChanged);
   QObject::connect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &Queue::SourceLayoutChanged);
   QObject::connect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &Queue::SourceLayoutChanged);
+  // These shift the playlist rows behind the queued persistent indexes, so the row cache has to be rebuilt.
+  QObject::connect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &Queue::InvalidatePositionCache);
+  QObject::connect(sourceModel(), &QAbstractItemModel::rowsMoved, this, &Queue::InvalidatePositionCache);
+  QObject::connect(sourceModel(), &QAbstractItemModel::modelReset, this, &Queue::InvalidatePositionCache);
 
 }
 
@@ -108,13 +124,16 @@ void Queue::SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bo
 
     emit dataChanged(proxy_index, proxy_index);
   }
+
+  // The change may have altered song lengths, so the total is recomputed rather than adjusted.
+  UpdateTotalLength();
   emit ItemCountChanged(ItemCount());
 
 }
 
 void Queue::SourceLayoutChanged() {
 
-  QObject::disconnect(signal_item_count_changed_);
+  source_rows_dirty_ = true;
 
   for (int i = 0; i < source_indexes_.count(); ++i) {
     if (!source_indexes_[i].isValid()) {
@@ -125,8 +144,8 @@ void Queue::SourceLayoutChanged() {
     }
   }
 
-  signal_item_count_changed_ = QObject::connect(this, &Queue::ItemCountChanged, this, &Queue::UpdateTotalLength);
-
+  // The lengths of the pruned rows are no longer reachable, so the total is recomputed from the remaining items.
+  UpdateTotalLength();
   emit ItemCountChanged(ItemCount());
 
 }
@@ -177,19 +196,27 @@ void Queue::ToggleTracks(const QModelIndexList &source_indexes) {
     if (proxy_index.isValid()) {
       // Dequeue the track
       const int row = proxy_index.row();
+      const quint64 length = SongLength(source_indexes_[row]);
+      total_length_ns_ -= qMin(total_length_ns_, length);
       beginRemoveRows(QModelIndex(), row, row);
       source_indexes_.removeAt(row);
       endRemoveRows();
+      source_rows_dirty_ = true;
     }
     else {
       // Enqueue the track
       const int row = static_cast<int>(source_indexes_.count());
+      const QPersistentModelIndex persistent_index(source_index);
+      total_length_ns_ += SongLength(persistent_index);
       beginInsertRows(QModelIndex(), row, row);
-      source_indexes_ << QPersistentModelIndex(source_index);
+      source_indexes_ << persistent_index;
       endInsertRows();
+      source_rows_dirty_ = true;
     }
   }
 
+  EmitQueueChanged();
+
 }
 
 void Queue::InsertFirst(const QModelIndexList &source_indexes) {
@@ -199,9 +226,12 @@ void Queue::InsertFirst(const QModelIndexList &source_indexes) {
     if (proxy_index.isValid()) {
       // Already in the queue, so remove it to be reinserted later
       const int row = proxy_index.row();
+      const quint64 length = SongLength(source_indexes_[row]);
+      total_length_ns_ -= qMin(total_length_ns_, length);
       beginRemoveRows(QModelIndex(), row, row);
       source_indexes_.removeAt(row);
       endRemoveRows();
+      source_rows_dirty_ = true;
     }
   }
 
@@ -210,10 +240,15 @@ void Queue::InsertFirst(const QModelIndexList &source_indexes) {
   beginInsertRows(QModelIndex(), 0, rows - 1);
   int offset = 0;
   for (const QModelIndex &source_index : source_indexes) {
-    source_indexes_.insert(offset, QPersistentModelIndex(source_index));
+    const QPersistentModelIndex persistent_index(source_index);
+    total_length_ns_ += SongLength(persistent_index);
+    source_indexes_.insert(offset, persistent_index);
     offset++;
   }
   endInsertRows();
+  source_rows_dirty_ = true;
+
+  EmitQueueChanged();
 
 }
 
@@ -227,17 +262,22 @@ int Queue::ItemCount() const { return static_cast<int>(source_indexes_.length())
 
 quint64 Queue::GetTotalLength() const { return total_length_ns_; }
 
+quint64 Queue::SongLength(const QPersistentModelIndex &source_index) const {
+
+  const int source_row = source_index.row();
+  if (source_row < 0 || !playlist_->has_item_at(source_row)) return 0;
+
+  const qint64 length = playlist_->item_at(source_row)->Metadata().length_nanosec();
+  return length > 0 ? static_cast<quint64>(length) : 0;
+
+}
+
 void Queue::UpdateTotalLength() {
 
   quint64 total = 0;
 
   for (const QPersistentModelIndex &row : std::as_const(source_indexes_)) {
-    int id = row.row();
-
-    Q_ASSERT(playlist_->has_item_at(id));
-
-    quint64 length = playlist_->item_at(id)->Metadata().length_nanosec();
-    if (length > 0) total += length;
+    total += SongLength(row);
   }
 
   total_length_ns_ = total;
@@ -246,6 +286,14 @@ void Queue::UpdateTotalLength() {
 
 }
 
+void Queue::EmitQueueChanged() {
+
+  source_rows_dirty_ = true;
+  emit ItemCountChanged(ItemCount());
+  emit TotalLengthChanged(total_length_ns_);
+
+}
+
 void Queue::UpdateSummaryText() {
 
   QString summary;
@@ -270,6 +318,9 @@ void Queue::Clear() {
   source_indexes_.clear();
   endRemoveRows();
 
+  total_length_ns_ = 0;
+  EmitQueueChanged();
+
 }
 
 void Queue::Move(const QList<int> &proxy_rows, int pos) {
@@ -311,6 +362,7 @@ void Queue::Move(const QList<int> &proxy_rows, int pos) {
     }
   }
 
+  source_rows_dirty_ = true;
   emit layoutChanged();
 
 }
@@ -396,9 +448,12 @@ bool Queue::dropMimeData(const QMimeData *data, Qt::DropAction action, int row,
       const int insert_point = row == -1 ? static_cast<int>(source_indexes_.count()) : row;
       beginInsertRows(QModelIndex(), insert_point, insert_point + static_cast<int>(source_indexes.count() - 1));
       for (int i = 0; i < source_indexes.count(); ++i) {
-        source_indexes_.insert(insert_point + i, source_indexes[i]);
+        const QPersistentModelIndex persistent_index(source_indexes[i]);
+        total_length_ns_ += SongLength(persistent_index);
+        source_indexes_.insert(insert_point + i, persistent_index);
       }
       endInsertRows();
+      EmitQueueChanged();
     }
   }
 
@@ -432,10 +487,15 @@ int Queue::TakeNext() {
 
   if (source_indexes_.isEmpty()) return -1;
 
+  const quint64 length = SongLength(source_indexes_.first());
+  total_length_ns_ -= qMin(total_length_ns_, length);
+
   beginRemoveRows(QModelIndex(), 0, 0);
   int ret = source_indexes_.takeFirst().row();
   endRemoveRows();
 
+  EmitQueueChanged();
+
   return ret;
 
 }
@@ -459,6 +519,8 @@ void Queue::Remove(QList<int> &proxy_rows) {
   for (int row : proxy_rows) {
     // After the first row, the row number needs to be updated
     const int real_row = row - removed_rows;
+    const quint64 length = SongLength(source_indexes_[real_row]);
+    total_length_ns_ -= qMin(total_length_ns_, length);
     beginRemoveRows(QModelIndex(), real_row, real_row);
     source_indexes_.removeAt(real_row);
     endRemoveRows();
@@ -467,4 +529,6 @@ void Queue::Remove(QList<int> &proxy_rows) {
 
   emit layoutChanged();
 
+  EmitQueueChanged();
+
 }
@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QAbstractItemModel>
 #include <QAbstractProxyModel>
+#include <QHash>
 #include <QList>
 #include <QVariant>
 #include <QString>
@@ -88,13 +89,23 @@ class Queue : public QAbstractProxyModel {
  private slots:
   void SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right);
   void SourceLayoutChanged();
+  void InvalidatePositionCache();
   void UpdateTotalLength();
 
  private:
+  // Rebuilds the source row -> queue position hash if a queue or playlist change made it stale,
+  // so position lookups (done for every playlist row with a queue position column) are constant time instead of a queue scan.
+  void EnsurePositionCache() const;
+  // The length of the song behind the queued index, 0 when unknown.
+  quint64 SongLength(const QPersistentModelIndex &source_index) const;
+  // Emits the count, total length and summary updates after an incremental queue change.
+  void EmitQueueChanged();
+
   QList<QPersistentModelIndex> source_indexes_;
+  mutable QHash<int, int> source_rows_;
+  mutable bool source_rows_dirty_;
   const Playlist *playlist_;
   quint64 total_length_ns_;
-  QMetaObject::Connection signal_item_count_changed_;
 };
 
 #endif  // QUEUE_H
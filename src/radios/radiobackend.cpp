@@ -25,6 +25,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/database.h"
+#include "core/scopedtransaction.h"
 #include "core/sqlquery.h"
 #include "core/song.h"
 #include "radiobackend.h"
@@ -84,6 +85,47 @@ void RadioBackend::AddChannels(const RadioChannelList &channels) {
 
 }
 
+void RadioBackend::ReplaceChannelsAsync(const Song::Source source, const RadioChannelList &channels) {
+  QMetaObject::invokeMethod(this, "ReplaceChannels", Qt::QueuedConnection, Q_ARG(Song::Source, source), Q_ARG(RadioChannelList, channels));
+}
+
+void RadioBackend::ReplaceChannels(const Song::Source source, const RadioChannelList &channels) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  ScopedTransaction transaction(&db);
+
+  {
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("DELETE FROM radio_channels WHERE source = :source"));
+    q.BindValue(QStringLiteral(":source"), static_cast<int>(source));
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("INSERT INTO radio_channels (source, name, url, thumbnail_url) VALUES (:source, :name, :url, :thumbnail_url)"));
+
+  for (const RadioChannel &channel : channels) {
+    q.BindValue(QStringLiteral(":source"), static_cast<int>(channel.source));
+    q.BindValue(QStringLiteral(":name"), channel.name);
+    q.BindValue(QStringLiteral(":url"), channel.url);
+    q.BindValue(QStringLiteral(":thumbnail_url"), channel.thumbnail_url);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  transaction.Commit();
+
+  emit ChannelsReplaced();
+
+}
+
 void RadioBackend::GetChannelsAsync() {
 
   QMetaObject::invokeMethod(this, &RadioBackend::GetChannels, Qt::QueuedConnection);
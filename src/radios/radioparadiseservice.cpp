@@ -34,10 +34,12 @@
 
 namespace {
 constexpr char kApiChannelsUrl[] = "https://api.radioparadise.com/api/list_streams";
+// Radio Paradise has a small fixed set of channels, a monthly refresh of the cached channel list is plenty.
+constexpr int kChannelsTtlSecs = 30 * 24 * 60 * 60;
 }
 
 RadioParadiseService::RadioParadiseService(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent)
-    : RadioService(Song::Source::RadioParadise, QStringLiteral("Radio Paradise"), IconLoader::Load(QStringLiteral("radioparadise")), app, network, parent) {}
+    : RadioService(Song::Source::RadioParadise, QStringLiteral("Radio Paradise"), IconLoader::Load(QStringLiteral("radioparadise")), kChannelsTtlSecs, app, network, parent) {}
 
 QUrl RadioParadiseService::Homepage() { return QUrl(QStringLiteral("https://radioparadise.com/")); }
 QUrl RadioParadiseService::Donate() { return QUrl(QStringLiteral("https://payments.radioparadise.com/rp2s-content.php?name=Support&file=support")); }
@@ -31,13 +31,14 @@
 #include "core/application.h"
 #include "radioservice.h"
 
-RadioService::RadioService(const Song::Source source, const QString &name, const QIcon &icon, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent)
+RadioService::RadioService(const Song::Source source, const QString &name, const QIcon &icon, const int channels_ttl_secs, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent)
     : QObject(parent),
       app_(app),
       network_(network),
       source_(source),
       name_(name),
-      icon_(icon) {}
+      icon_(icon),
+      channels_ttl_secs_(channels_ttl_secs) {}
 
 QByteArray RadioService::ExtractData(QNetworkReply *reply) {
 
@@ -43,10 +43,12 @@ class RadioService : public QObject {
   Q_OBJECT
 
  public:
-  explicit RadioService(const Song::Source source, const QString &name, const QIcon &icon, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
+  explicit RadioService(const Song::Source source, const QString &name, const QIcon &icon, const int channels_ttl_secs, Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
 
   Song::Source source() const { return source_; }
   QString name() const { return name_; }
+  // How long cached channels for this service are served before they are revalidated in the background.
+  int channels_ttl_secs() const { return channels_ttl_secs_; }
 
   virtual void ReloadSettings() {}
 
@@ -71,6 +73,7 @@ class RadioService : public QObject {
   Song::Source source_;
   QString name_;
   QIcon icon_;
+  int channels_ttl_secs_;
 };
 
 Q_DECLARE_METATYPE(RadioService*)
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include <QObject>
+#include <QDateTime>
 #include <QSortFilterProxyModel>
 
 #include "core/logging.h"
@@ -27,6 +28,7 @@
 #include "core/application.h"
 #include "core/database.h"
 #include "core/networkaccessmanager.h"
+#include "core/settings.h"
 #include "radioservices.h"
 #include "radiobackend.h"
 #include "radiomodel.h"
@@ -37,6 +39,10 @@
 
 using std::make_shared;
 
+namespace {
+constexpr char kSettingsGroup[] = "radios";
+}
+
 RadioServices::RadioServices(Application *app, QObject *parent)
     : QObject(parent),
       network_(app->network()),
@@ -49,6 +55,7 @@ RadioServices::RadioServices(Application *app, QObject *parent)
   app->MoveToThread(&*backend_, app->database()->thread());
 
   QObject::connect(&*backend_, &RadioBackend::NewChannels, this, &RadioServices::GotChannelsFromBackend);
+  QObject::connect(&*backend_, &RadioBackend::ChannelsReplaced, this, &RadioServices::ChannelsReplacedInBackend);
 
   sort_model_->setSourceModel(model_);
   sort_model_->setSortRole(RadioModel::Role_SortText);
@@ -105,9 +112,24 @@ void RadioServices::ReloadSettings() {
 
 void RadioServices::GetChannels() {
 
+  // Serve whatever is cached in the database right away, the radio tab is usable instantly and offline.
   model_->Reset();
   backend_->GetChannelsAsync();
 
+  // Revalidate stale services in the background. Services never fetched before are handled by the empty-database path in GotChannelsFromBackend.
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+  Settings s;
+  s.beginGroup(kSettingsGroup);
+  const QList<RadioService*> services = services_.values();
+  for (RadioService *service : services) {
+    const qint64 last_refresh = s.value(QStringLiteral("channels_updated_%1").arg(static_cast<int>(service->source())), 0).toLongLong();
+    if (last_refresh > 0 && now - last_refresh >= service->channels_ttl_secs()) {
+      qLog(Debug) << "Cached channels for" << service->name() << "are stale, refreshing in the background";
+      service->GetChannels();
+    }
+  }
+  s.endGroup();
+
 }
 
 void RadioServices::RefreshChannels() {
@@ -141,6 +163,22 @@ void RadioServices::GotChannelsFromService(const RadioChannelList &channels) {
   RadioService *service = qobject_cast<RadioService*>(sender());
   if (!service) return;
 
-  backend_->AddChannelsAsync(channels);
+  // A failed fetch comes back empty, keep serving the cached channels and retry on the next TTL check.
+  if (channels.isEmpty()) return;
+
+  backend_->ReplaceChannelsAsync(service->source(), channels);
+
+  Settings s;
+  s.beginGroup(kSettingsGroup);
+  s.setValue(QStringLiteral("channels_updated_%1").arg(static_cast<int>(service->source())), QDateTime::currentSecsSinceEpoch());
+  s.endGroup();
+
+}
+
+void RadioServices::ChannelsReplacedInBackend() {
+
+  // Fresh channels for one service are in, rebuild the model from the database.
+  model_->Reset();
+  backend_->GetChannelsAsync();
 
 }
@@ -60,6 +60,7 @@ class RadioServices : public QObject {
   void ServiceDeleted();
   void GotChannelsFromBackend(const RadioChannelList &channels);
   void GotChannelsFromService(const RadioChannelList &channels);
+  void ChannelsReplacedInBackend();
 
  public slots:
   void GetChannels();
@@ -36,10 +36,12 @@
 
 namespace {
 constexpr char kApiChannelsUrl[] = "https://somafm.com/channels.json";
+// SomaFM adds and removes channels now and then, refresh the cached channel list weekly.
+constexpr int kChannelsTtlSecs = 7 * 24 * 60 * 60;
 }
 
 SomaFMService::SomaFMService(Application *app, SharedPtr<NetworkAccessManager> network, QObject *parent)
-    : RadioService(Song::Source::SomaFM, QStringLiteral("SomaFM"), IconLoader::Load(QStringLiteral("somafm")), app, network, parent) {}
+    : RadioService(Song::Source::SomaFM, QStringLiteral("SomaFM"), IconLoader::Load(QStringLiteral("somafm")), kChannelsTtlSecs, app, network, parent) {}
 
 SomaFMService::~SomaFMService() {
   Abort();
@@ -49,7 +49,12 @@
 #include "lastfmscrobbler.h"
 
 namespace {
-constexpr int kRequestsDelay = 2000;
+// One request is dispatched per tick with up to kMaxConcurrentRequests in flight,
+// so page fetches overlap server latency while staying below the last.fm rate limit.
+constexpr int kRequestsDelay = 500;
+constexpr int kMaxConcurrentRequests = 4;
+// Tracks per data page, also used to derive the page count when resuming an aborted import.
+constexpr int kTracksPerPage = 500;
 }
 
 LastFMImport::LastFMImport(SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -61,7 +66,9 @@ LastFMImport::LastFMImport(SharedPtr<NetworkAccessManager> network, QObject *par
       playcount_total_(0),
       lastplayed_total_(0),
       playcount_received_(0),
-      lastplayed_received_(0) {
+      lastplayed_received_(0),
+      lastplayed_resume_page_(0),
+      playcount_resume_page_(0) {
 
   timer_flush_requests_->setInterval(kRequestsDelay);
   timer_flush_requests_->setSingleShot(false);
@@ -91,6 +98,8 @@ void LastFMImport::AbortAll() {
 
   recent_tracks_requests_.clear();
   top_tracks_requests_.clear();
+  lastplayed_pages_received_.clear();
+  playcount_pages_received_.clear();
   timer_flush_requests_->stop();
 
 }
@@ -221,24 +230,69 @@ void LastFMImport::ImportData(const bool lastplayed, const bool playcount) {
   lastplayed_ = lastplayed;
   playcount_ = playcount;
 
+  LoadResumeState();
+
   if (lastplayed) AddGetRecentTracksRequest(0);
   if (playcount) AddGetTopTracksRequest(0);
 
 }
 
+void LastFMImport::LoadResumeState() {
+
+  lastplayed_resume_page_ = 0;
+  playcount_resume_page_ = 0;
+  lastplayed_pages_received_.clear();
+  playcount_pages_received_.clear();
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  if (s.value("import_username").toString() == username_) {
+    if (lastplayed_) lastplayed_resume_page_ = s.value("import_lastplayed_page", 0).toInt();
+    if (playcount_) playcount_resume_page_ = s.value("import_playcount_page", 0).toInt();
+  }
+  s.endGroup();
+
+}
+
+void LastFMImport::SaveResumeState() {
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  s.setValue("import_username", username_);
+  s.setValue("import_lastplayed_page", lastplayed_resume_page_);
+  s.setValue("import_playcount_page", playcount_resume_page_);
+  s.endGroup();
+
+}
+
+void LastFMImport::ClearResumeState() {
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  s.remove("import_username");
+  s.remove("import_lastplayed_page");
+  s.remove("import_playcount_page");
+  s.endGroup();
+
+}
+
 void LastFMImport::FlushRequests() {
 
-  if (!recent_tracks_requests_.isEmpty()) {
-    SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
+  if (recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) {
+    timer_flush_requests_->stop();
     return;
   }
 
-  if (!top_tracks_requests_.isEmpty()) {
-    SendGetTopTracksRequest(top_tracks_requests_.dequeue());
+  if (replies_.count() >= kMaxConcurrentRequests) {
     return;
   }
 
-  timer_flush_requests_->stop();
+  if (!recent_tracks_requests_.isEmpty()) {
+    SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
+    return;
+  }
+
+  SendGetTopTracksRequest(top_tracks_requests_.dequeue());
 
 }
 
@@ -262,7 +316,7 @@ void LastFMImport::SendGetRecentTracksRequest(GetRecentTracksRequest request) {
   }
   else {
     params << Param(QStringLiteral("page"), QString::number(request.page));
-    params << Param(QStringLiteral("limit"), QStringLiteral("500"));
+    params << Param(QStringLiteral("limit"), QString::number(kTracksPerPage));
   }
 
   QNetworkReply *reply = CreateRequest(params);
@@ -347,7 +401,18 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
   if (page == 0) {
     lastplayed_total_ = total;
     UpdateTotalCheck();
-    AddGetRecentTracksRequest(1);
+    if (lastplayed_resume_page_ > 0) {
+      // Resuming an aborted import: derive the page count from the total and skip the pages already imported.
+      const int total_pages = (total + kTracksPerPage - 1) / kTracksPerPage;
+      lastplayed_received_ = std::min(lastplayed_resume_page_ * kTracksPerPage, total);
+      UpdateProgressCheck();
+      for (int i = lastplayed_resume_page_ + 1; i <= total_pages; ++i) {
+        AddGetRecentTracksRequest(i);
+      }
+    }
+    else {
+      AddGetRecentTracksRequest(1);
+    }
   }
   else {
 
@@ -399,6 +464,13 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
       }
     }
 
+    // Pages finish out of order, so persist only the highest page with no gaps before it.
+    lastplayed_pages_received_.insert(page);
+    while (lastplayed_pages_received_.contains(lastplayed_resume_page_ + 1)) {
+      lastplayed_pages_received_.remove(++lastplayed_resume_page_);
+    }
+    SaveResumeState();
+
   }
 
   FinishCheck();
@@ -425,7 +497,7 @@ void LastFMImport::SendGetTopTracksRequest(GetTopTracksRequest request) {
   }
   else {
     params << Param(QStringLiteral("page"), QString::number(request.page));
-    params << Param(QStringLiteral("limit"), QStringLiteral("500"));
+    params << Param(QStringLiteral("limit"), QString::number(kTracksPerPage));
   }
 
   QNetworkReply *reply = CreateRequest(params);
@@ -510,7 +582,18 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
   if (page == 0) {
     playcount_total_ = total;
     UpdateTotalCheck();
-    AddGetTopTracksRequest(1);
+    if (playcount_resume_page_ > 0) {
+      // Resuming an aborted import: derive the page count from the total and skip the pages already imported.
+      const int total_pages = (total + kTracksPerPage - 1) / kTracksPerPage;
+      playcount_received_ = std::min(playcount_resume_page_ * kTracksPerPage, total);
+      UpdateProgressCheck();
+      for (int i = playcount_resume_page_ + 1; i <= total_pages; ++i) {
+        AddGetTopTracksRequest(i);
+      }
+    }
+    else {
+      AddGetTopTracksRequest(1);
+    }
   }
   else {
 
@@ -556,6 +639,13 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
       }
     }
 
+    // Pages finish out of order, so persist only the highest page with no gaps before it.
+    playcount_pages_received_.insert(page);
+    while (playcount_pages_received_.contains(playcount_resume_page_ + 1)) {
+      playcount_pages_received_.remove(++playcount_resume_page_);
+    }
+    SaveResumeState();
+
   }
 
   FinishCheck();
@@ -574,7 +664,12 @@ void LastFMImport::UpdateProgressCheck() {
 }
 
 void LastFMImport::FinishCheck() {
-  if (replies_.isEmpty() && recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) emit Finished();
+
+  if (replies_.isEmpty() && recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) {
+    ClearResumeState();
+    emit Finished();
+  }
+
 }
 
 void LastFMImport::Error(const QString &error, const QVariant &debug) {
@@ -28,6 +28,7 @@
 #include <QVariant>
 #include <QByteArray>
 #include <QString>
+#include <QSet>
 #include <QQueue>
 #include <QDateTime>
 
@@ -75,6 +76,11 @@ class LastFMImport : public QObject {
 
   void Error(const QString &error, const QVariant &debug = QVariant());
 
+  // Progress is persisted as the highest page with no gaps before it, so an aborted import resumes instead of refetching everything.
+  void LoadResumeState();
+  void SaveResumeState();
+  void ClearResumeState();
+
   void UpdateTotalCheck();
   void UpdateProgressCheck();
 
@@ -104,6 +110,10 @@ class LastFMImport : public QObject {
   int lastplayed_total_;
   int playcount_received_;
   int lastplayed_received_;
+  int lastplayed_resume_page_;
+  int playcount_resume_page_;
+  QSet<int> lastplayed_pages_received_;
+  QSet<int> playcount_pages_received_;
   QQueue<GetRecentTracksRequest> recent_tracks_requests_;
   QQueue<GetTopTracksRequest> top_tracks_requests_;
   QList<QNetworkReply*> replies_;
@@ -67,7 +67,8 @@ constexpr char kApiUrl[] = "https://api.listenbrainz.org";
 constexpr char kClientIDB64[] = "b2VBVU53cVNRZXIwZXIwOUZpcWkwUQ==";
 constexpr char kClientSecretB64[] = "Uk9GZ2hrZVEzRjNvUHlFaHFpeVdQQQ==";
 constexpr char kCacheFile[] = "listenbrainzscrobbler.cache";
-constexpr int kScrobblesPerRequest = 10;
+// ListenBrainz accepts large import payloads, so a backlog cached while offline drains in a few requests.
+constexpr int kScrobblesPerRequest = 50;
 }  // namespace
 
 ListenBrainzScrobbler::ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -81,13 +82,14 @@ ListenBrainzScrobbler::ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settin
       submitted_(false),
       scrobbled_(false),
       timestamp_(0),
-      submit_error_(false),
       prefer_albumartist_(false) {
 
   refresh_login_timer_.setSingleShot(true);
   QObject::connect(&refresh_login_timer_, &QTimer::timeout, this, &ListenBrainzScrobbler::RequestNewAccessToken);
 
   timer_submit_.setSingleShot(true);
+  // Submissions are not time critical, a very coarse timer lets the OS align the wakeup with other activity.
+  timer_submit_.setTimerType(Qt::VeryCoarseTimer);
   QObject::connect(&timer_submit_, &QTimer::timeout, this, &ListenBrainzScrobbler::Submit);
 
   ListenBrainzScrobbler::ReloadSettings();
@@ -124,6 +126,9 @@ void ListenBrainzScrobbler::ReloadSettings() {
   prefer_albumartist_ = s.value("albumartist", false).toBool();
   s.endGroup();
 
+  // Open the connection to the API host in the background, so the first scrobble of the session doesn't pay for DNS and the TLS handshake.
+  if (enabled_) network_->AddWarmUpUrl(QUrl(QString::fromLatin1(kApiUrl)));
+
 }
 
 void ListenBrainzScrobbler::LoadSession() {
@@ -522,15 +527,21 @@ void ListenBrainzScrobbler::Scrobble(const Song &song) {
 void ListenBrainzScrobbler::StartSubmit(const bool initial) {
 
   if (!submitted_ && cache_->Count() > 0) {
-    if (initial && settings_->submit_delay() <= 0 && !submit_error_) {
+    if (initial && settings_->submit_delay() <= 0 && !HasSubmitError()) {
+      if (timer_submit_.isActive()) {
+        timer_submit_.stop();
+      }
+      Submit();
+    }
+    else if (!HasSubmitError() && cache_->Count() > kScrobblesPerRequest) {
+      // More than one request's worth in the backlog, e.g. scrobbles cached while offline: drain back to back instead of one batch per submit delay.
       if (timer_submit_.isActive()) {
         timer_submit_.stop();
       }
       Submit();
     }
     else if (!timer_submit_.isActive()) {
-      int submit_delay = static_cast<int>(std::max(settings_->submit_delay(), submit_error_ ? 30 : 5) * kMsecPerSec);
-      timer_submit_.setInterval(submit_delay);
+      timer_submit_.setInterval(SubmitDelayMsec(settings_->submit_delay()));
       timer_submit_.start();
     }
   }
@@ -594,10 +605,10 @@ void ListenBrainzScrobbler::ScrobbleRequestFinished(QNetworkReply *reply, Scrobb
       qLog(Debug) << "ListenBrainz: Received scrobble reply without status.";
     }
     cache_->Flush(cache_items);
-    submit_error_ = false;
+    ResetSubmitError();
   }
   else {
-    submit_error_ = true;
+    HandleSubmitError();
     if (reply_result == ReplyResult::APIError) {
       if (cache_items.count() == 1) {
         const ScrobbleMetadata &metadata = cache_items.first()->metadata;
@@ -117,7 +117,6 @@ class ListenBrainzScrobbler : public ScrobblerService {
   quint64 timestamp_;
   QTimer refresh_login_timer_;
   QTimer timer_submit_;
-  bool submit_error_;
 
   bool prefer_albumartist_;
 
@@ -54,7 +54,9 @@ ScrobblerCache::ScrobblerCache(const QString &filename, QObject *parent)
   loaded_ = true;
 
   timer_flush_->setSingleShot(true);
-  timer_flush_->setInterval(10min);
+  // Short enough that a crash loses at most a few recent listens, coarse enough that a burst of scrobbles is written once.
+  timer_flush_->setInterval(30s);
+  timer_flush_->setTimerType(Qt::VeryCoarseTimer);
   QObject::connect(timer_flush_, &QTimer::timeout, this, &ScrobblerCache::WriteCache);
 
 }
@@ -230,10 +232,12 @@ void ScrobblerCache::WriteCache() {
   object.insert(QLatin1String("tracks"), array);
   QJsonDocument doc(object);
 
-  QFile file(filename_);
+  // Write to a temporary file first, so a crash in the middle of the write cannot destroy the listens already journaled.
+  const QString filename_tmp = filename_ + QLatin1String(".tmp");
+  QFile file(filename_tmp);
   bool result = file.open(QIODevice::WriteOnly | QIODevice::Text);
   if (!result) {
-    qLog(Error) << "Unable to open scrobbler cache file" << filename_;
+    qLog(Error) << "Unable to open scrobbler cache file" << filename_tmp;
     return;
   }
   QTextStream stream(&file);
@@ -245,6 +249,11 @@ void ScrobblerCache::WriteCache() {
   stream << doc.toJson();
   file.close();
 
+  if (QFile::exists(filename_)) QFile::remove(filename_);
+  if (!QFile::rename(filename_tmp, filename_)) {
+    qLog(Error) << "Unable to rename scrobbler cache file" << filename_tmp << "to" << filename_;
+  }
+
 }
 
 ScrobblerCacheItemPtr ScrobblerCache::Add(const Song &song, const quint64 timestamp) {
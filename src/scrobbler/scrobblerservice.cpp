@@ -19,6 +19,8 @@
 
 #include "config.h"
 
+#include <algorithm>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QString>
@@ -30,8 +32,28 @@
 #include "scrobblersettings.h"
 
 #include "core/song.h"
+#include "utilities/timeconstants.h"
+
+namespace {
+// Delay before retrying the next submit, without and with a pending error. The error delay doubles for every consecutive failure.
+constexpr int kSubmitMinDelaySeconds = 5;
+constexpr int kSubmitErrorDelaySeconds = 30;
+// Caps the backoff at 30 * 2^6 = 32 minutes.
+constexpr int kSubmitErrorMaxDoublings = 6;
+}  // namespace
+
+ScrobblerService::ScrobblerService(const QString &name, SharedPtr<ScrobblerSettings> settings, QObject *parent) : QObject(parent), name_(name), settings_(settings), consecutive_submit_errors_(0) {}
+
+int ScrobblerService::SubmitDelayMsec(const int submit_delay_seconds) const {
 
-ScrobblerService::ScrobblerService(const QString &name, SharedPtr<ScrobblerSettings> settings, QObject *parent) : QObject(parent), name_(name), settings_(settings) {}
+  if (consecutive_submit_errors_ > 0) {
+    const int backoff_seconds = kSubmitErrorDelaySeconds << std::min(consecutive_submit_errors_ - 1, kSubmitErrorMaxDoublings);
+    return static_cast<int>(std::max(submit_delay_seconds, backoff_seconds) * kMsecPerSec);
+  }
+
+  return static_cast<int>(std::max(submit_delay_seconds, kSubmitMinDelaySeconds) * kMsecPerSec);
+
+}
 
 bool ScrobblerService::ExtractJsonObj(const QByteArray &data, QJsonObject &json_obj, QString &error_description) {
 
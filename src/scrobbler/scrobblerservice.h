@@ -66,6 +66,14 @@ class ScrobblerService : public QObject {
   QString StripAlbum(const QString &album) const;
   QString StripTitle(const QString &title) const;
 
+  // Exponential backoff for failed submits, shared by all backends:
+  // every consecutive failure doubles the retry delay up to a cap, a successful submit resets it.
+  void HandleSubmitError() { ++consecutive_submit_errors_; }
+  void ResetSubmitError() { consecutive_submit_errors_ = 0; }
+  bool HasSubmitError() const { return consecutive_submit_errors_ > 0; }
+  // Delay in milliseconds before the next submit, from the configured submit delay and the current backoff.
+  int SubmitDelayMsec(const int submit_delay_seconds) const;
+
  public slots:
   virtual void Submit() = 0;
   virtual void WriteCache() = 0;
@@ -76,6 +84,9 @@ class ScrobblerService : public QObject {
  protected:
   QString name_;
   SharedPtr<ScrobblerSettings> settings_;
+
+ private:
+  int consecutive_submit_errors_;
 };
 
 using ScrobblerServicePtr = SharedPtr<ScrobblerService>;
@@ -82,8 +82,7 @@ ScrobblingAPI20::ScrobblingAPI20(const QString &name, const QString &settings_gr
       subscriber_(false),
       submitted_(false),
       scrobbled_(false),
-      timestamp_(0),
-      submit_error_(false) {
+      timestamp_(0) {
 
   timer_submit_.setSingleShot(true);
   QObject::connect(&timer_submit_, &QTimer::timeout, this, &ScrobblingAPI20::Submit);
@@ -122,6 +121,9 @@ void ScrobblingAPI20::ReloadSettings() {
   prefer_albumartist_ = s.value("albumartist", false).toBool();
   s.endGroup();
 
+  // Open the connection to the API host in the background, so the first scrobble of the session doesn't pay for DNS and the TLS handshake.
+  if (enabled_) network_->AddWarmUpUrl(QUrl(api_url_));
+
 }
 
 void ScrobblingAPI20::LoadSession() {
@@ -469,15 +471,21 @@ void ScrobblingAPI20::Scrobble(const Song &song) {
 void ScrobblingAPI20::StartSubmit(const bool initial) {
 
   if (!submitted_ && cache_->Count() > 0) {
-    if (initial && (!batch_ || settings_->submit_delay() <= 0) && !submit_error_) {
+    if (initial && (!batch_ || settings_->submit_delay() <= 0) && !HasSubmitError()) {
+      if (timer_submit_.isActive()) {
+        timer_submit_.stop();
+      }
+      Submit();
+    }
+    else if (batch_ && !HasSubmitError() && cache_->Count() > kScrobblesPerRequest) {
+      // More than one request's worth in the backlog, e.g. scrobbles cached while offline: drain back to back instead of one batch per submit delay.
       if (timer_submit_.isActive()) {
         timer_submit_.stop();
       }
       Submit();
     }
     else if (!timer_submit_.isActive()) {
-      int submit_delay = static_cast<int>(std::max(settings_->submit_delay(), submit_error_ ? 30 : 5) * kMsecPerSec);
-      timer_submit_.setInterval(submit_delay);
+      timer_submit_.setInterval(SubmitDelayMsec(settings_->submit_delay()));
       timer_submit_.start();
     }
   }
@@ -543,13 +551,13 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
   if (GetJsonObject(reply, json_obj, error_message) != ReplyResult::Success) {
     Error(error_message);
     cache_->ClearSent(cache_items);
-    submit_error_ = true;
+    HandleSubmitError();
     StartSubmit();
     return;
   }
 
   cache_->Flush(cache_items);
-  submit_error_ = false;
+  ResetSubmitError();
 
   if (!json_obj.contains(QLatin1String("scrobbles"))) {
     Error(QStringLiteral("Json reply from server is missing scrobbles."), json_obj);
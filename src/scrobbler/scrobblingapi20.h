@@ -153,7 +153,6 @@ class ScrobblingAPI20 : public ScrobblerService {
   Song song_playing_;
   bool scrobbled_;
   quint64 timestamp_;
-  bool submit_error_;
 
   QTimer timer_submit_;
 
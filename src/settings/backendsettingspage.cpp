@@ -100,6 +100,8 @@ BackendSettingsPage::BackendSettingsPage(SettingsDialog *dialog, QWidget *parent
   QObject::connect(ui_->checkbox_channels, &QCheckBox::toggled, ui_->widget_channels, &QSpinBox::setEnabled);
   QObject::connect(ui_->button_buffer_defaults, &QPushButton::clicked, this, &BackendSettingsPage::BufferDefaults);
 
+  QObject::connect(&*dialog->app()->device_finders(), &DeviceFinders::DevicesUpdated, this, &BackendSettingsPage::AudioDevicesUpdated);
+
 #ifdef Q_OS_WIN32
   ui_->widget_exclusive_mode->show();
 #else
@@ -370,13 +372,11 @@ void BackendSettingsPage::Load_Device(const QString &output, const QVariant &dev
 #endif
     ui_->combobox_device->addItem(IconLoader::Load(QStringLiteral("soundcard")), QLatin1String(kOutputAutomaticallySelect), QVariant());
 
-  for (DeviceFinder *f : dialog()->app()->device_finders()->ListFinders()) {
-    if (!f->outputs().contains(output)) continue;
-    for (const EngineDevice &d : f->ListDevices()) {
-      devices++;
-      ui_->combobox_device->addItem(IconLoader::Load(d.iconname), d.description, d.value);
-      if (d.value == device) { df_device = d; }
-    }
+  const EngineDeviceList engine_devices = dialog()->app()->device_finders()->GetDevices(output);
+  for (const EngineDevice &d : engine_devices) {
+    devices++;
+    ui_->combobox_device->addItem(IconLoader::Load(d.iconname), d.description, d.value);
+    if (d.value == device) { df_device = d; }
   }
 
   if (engine()->CustomDeviceSupport(output)) {
@@ -581,6 +581,21 @@ void BackendSettingsPage::OutputChanged(const int index) {
 
 }
 
+void BackendSettingsPage::AudioDevicesUpdated() {
+
+  if (!configloaded_ || !EngineInitialized()) return;
+
+  // The device cache has been refreshed in the background, re-populate the device list for the selected output, keeping the current selection.
+  const EngineBase::OutputDetails output = ui_->combobox_output->itemData(ui_->combobox_output->currentIndex()).value<EngineBase::OutputDetails>();
+
+  QVariant device;
+  if (ui_->combobox_device->currentText() == QLatin1String(kOutputCustom)) device = ui_->lineedit_device->text();
+  else device = ui_->combobox_device->itemData(ui_->combobox_device->currentIndex()).value<QVariant>();
+
+  Load_Device(output.name, device);
+
+}
+
 void BackendSettingsPage::DeviceSelectionChanged(int index) {
 
   if (!configloaded_ || !EngineInitialized()) return;
@@ -65,6 +65,7 @@ class BackendSettingsPage : public SettingsPage {
  private slots:
   void EngineChanged(const int index);
   void OutputChanged(const int index);
+  void AudioDevicesUpdated();
   void DeviceSelectionChanged(const int index);
   void DeviceStringChanged();
   void RgPreampChanged(const int value);
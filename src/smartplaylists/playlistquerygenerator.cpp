@@ -20,21 +20,31 @@
 
 #include "config.h"
 
+#include <utility>
+
 #include <QIODevice>
 #include <QDataStream>
 #include <QByteArray>
 #include <QString>
+#include <QMutexLocker>
 
 #include "playlistquerygenerator.h"
 #include "collection/collectionbackend.h"
 
-PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), current_pos_(0) {}
+namespace {
+// How many top-ups worth of candidates one collection query prefetches into the reservoir,
+// so fetching the next dynamic tracks is usually served from memory instead of re-querying the collection.
+constexpr int kReservoirRefillFactor = 5;
+}  // namespace
+
+PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), current_pos_(0), reservoir_connected_(false) {}
 
 PlaylistQueryGenerator::PlaylistQueryGenerator(const QString &name, const SmartPlaylistSearch &search, const bool dynamic, QObject *parent)
     : PlaylistGenerator(parent),
       search_(search),
       dynamic_(dynamic),
-      current_pos_(0) {
+      current_pos_(0),
+      reservoir_connected_(false) {
 
   set_name(name);
 
@@ -42,17 +52,23 @@ PlaylistQueryGenerator::PlaylistQueryGenerator(const QString &name, const SmartP
 
 void PlaylistQueryGenerator::Load(const SmartPlaylistSearch &search) {
 
+  QMutexLocker l(&reservoir_mutex_);
+
   search_ = search;
   dynamic_ = false;
   current_pos_ = 0;
+  reservoir_.clear();
 
 }
 
 void PlaylistQueryGenerator::Load(const QByteArray &data) {
 
+  QMutexLocker l(&reservoir_mutex_);
+
   QDataStream s(data);
   s >> search_;
   s >> dynamic_;
+  reservoir_.clear();
 
 }
 
@@ -69,20 +85,55 @@ QByteArray PlaylistQueryGenerator::Save() const {
 
 PlaylistItemPtrList PlaylistQueryGenerator::Generate() {
 
-  previous_ids_.clear();
-  current_pos_ = 0;
+  {
+    QMutexLocker l(&reservoir_mutex_);
+    previous_ids_.clear();
+    current_pos_ = 0;
+    reservoir_.clear();
+  }
+
   return GenerateMore(0);
 
 }
 
 PlaylistItemPtrList PlaylistQueryGenerator::GenerateMore(const int count) {
 
-  SmartPlaylistSearch search_copy = search_;
-  search_copy.id_not_in_ = previous_ids_;
+  QMutexLocker l(&reservoir_mutex_);
+
+  // Dynamic top-ups are served from the reservoir, so the collection is only queried when it runs low.
   if (count > 0) {
-    search_copy.limit_ = count;
+    if (!reservoir_connected_ && collection_backend_) {
+      reservoir_connected_ = true;
+      QObject::connect(&*collection_backend_, &CollectionBackend::SongsAdded, this, &PlaylistQueryGenerator::InvalidateReservoir);
+      QObject::connect(&*collection_backend_, &CollectionBackend::SongsChanged, this, &PlaylistQueryGenerator::InvalidateReservoir);
+      QObject::connect(&*collection_backend_, &CollectionBackend::SongsDeleted, this, &PlaylistQueryGenerator::InvalidateReservoir);
+      QObject::connect(&*collection_backend_, &CollectionBackend::DatabaseReset, this, &PlaylistQueryGenerator::InvalidateReservoir);
+    }
+
+    if (reservoir_.count() < count) {
+      RefillReservoir(count);
+    }
+
+    PlaylistItemPtrList items;
+    const int take_count = qMin(static_cast<int>(reservoir_.count()), count);
+    items.reserve(take_count);
+    for (int i = 0; i < take_count; ++i) {
+      const Song song = reservoir_.takeFirst();
+      items << PlaylistItem::NewFromSong(song);
+      previous_ids_ << song.id();
+
+      if (previous_ids_.count() > GetDynamicFuture() + GetDynamicHistory()) {
+        previous_ids_.removeFirst();
+      }
+    }
+
+    return items;
   }
 
+  // The initial load fetches exactly what the search asks for.
+  SmartPlaylistSearch search_copy = search_;
+  search_copy.id_not_in_ = previous_ids_;
+
   if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random) {
     search_copy.first_item_ = current_pos_;
     current_pos_ += search_copy.limit_;
@@ -103,3 +154,34 @@ PlaylistItemPtrList PlaylistQueryGenerator::GenerateMore(const int count) {
   return items;
 
 }
+
+void PlaylistQueryGenerator::RefillReservoir(const int count) {
+
+  SmartPlaylistSearch search_copy = search_;
+  // Exclude the candidates still in the reservoir as well, so the new batch doesn't duplicate them.
+  search_copy.id_not_in_ = previous_ids_;
+  for (const Song &song : std::as_const(reservoir_)) {
+    search_copy.id_not_in_ << song.id();
+  }
+  search_copy.limit_ = count * kReservoirRefillFactor;
+
+  if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random) {
+    search_copy.first_item_ = current_pos_;
+  }
+
+  const SongList songs = collection_backend_->SmartPlaylistsFindSongs(search_copy);
+
+  if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random) {
+    current_pos_ += songs.count();
+  }
+
+  reservoir_ << songs;
+
+}
+
+void PlaylistQueryGenerator::InvalidateReservoir() {
+
+  QMutexLocker l(&reservoir_mutex_);
+  reservoir_.clear();
+
+}
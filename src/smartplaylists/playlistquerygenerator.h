@@ -26,7 +26,9 @@
 #include <QList>
 #include <QByteArray>
 #include <QString>
+#include <QMutex>
 
+#include "core/song.h"
 #include "playlistgenerator.h"
 #include "smartplaylistsearch.h"
 
@@ -51,12 +53,26 @@ class PlaylistQueryGenerator : public PlaylistGenerator {
   SmartPlaylistSearch search() const { return search_; }
   int GetDynamicFuture() override { return search_.limit_; }
 
+ private slots:
+  // The prefetched candidates may no longer match the search or may have been removed, so the next top-up queries the collection again.
+  void InvalidateReservoir();
+
  private:
+  // Fetches several top-ups worth of candidates in one query and appends them to the reservoir.
+  // Must be called with reservoir_mutex_ held.
+  void RefillReservoir(const int count);
+
   SmartPlaylistSearch search_;
   bool dynamic_;
 
   QList<int> previous_ids_;
   int current_pos_;
+
+  // Candidates prefetched beyond the last top-up, so fetching the next dynamic tracks usually doesn't need a new collection query.
+  // Guarded by reservoir_mutex_: top-ups run on a worker thread while the collection change signals arrive on this object's thread.
+  SongList reservoir_;
+  QMutex reservoir_mutex_;
+  bool reservoir_connected_;
 };
 
 #endif  // PLAYLISTQUERYGENERATOR_H
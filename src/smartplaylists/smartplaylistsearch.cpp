@@ -25,6 +25,7 @@
 #include <QDataStream>
 
 #include "core/song.h"
+#include "core/sqlquery.h"
 
 #include "smartplaylistsearch.h"
 
@@ -49,7 +50,7 @@ void SmartPlaylistSearch::Reset() {
 
 }
 
-QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
+QString SmartPlaylistSearch::ToSql(const QString &songs_table, const bool use_placeholders) const {
 
   QString sql = QStringLiteral("SELECT %1 FROM %2").arg(Song::kRowIdColumnSpec, songs_table);
 
@@ -70,7 +71,7 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
   if (!id_not_in_.isEmpty()) {
     QString numbers;
     for (int id : id_not_in_) {
-      numbers += (numbers.isEmpty() ? QLatin1String("") : QLatin1String(",")) + QString::number(id);
+      numbers += (numbers.isEmpty() ? QLatin1String("") : QLatin1String(",")) + (use_placeholders ? QStringLiteral("?") : QString::number(id));
     }
     where_clauses << QStringLiteral("(ROWID NOT IN (") + numbers + QStringLiteral("))");
   }
@@ -93,10 +94,10 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
 
   // Add limit
   if (first_item_ > 0) {
-    sql += QStringLiteral(" LIMIT %1 OFFSET %2").arg(limit_).arg(first_item_);
+    sql += use_placeholders ? QStringLiteral(" LIMIT ? OFFSET ?") : QStringLiteral(" LIMIT %1 OFFSET %2").arg(limit_).arg(first_item_);
   }
   else if (limit_ != -1) {
-    sql += QLatin1String(" LIMIT ") + QString::number(limit_);
+    sql += QLatin1String(" LIMIT ") + (use_placeholders ? QStringLiteral("?") : QString::number(limit_));
   }
   //qLog(Debug) << sql;
 
@@ -104,6 +105,48 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
 
 }
 
+QString SmartPlaylistSearch::ToCountSql(const QString &songs_table) const {
+
+  QString sql = QStringLiteral("SELECT COUNT(*) FROM %1").arg(songs_table);
+
+  QStringList where_clauses;
+  QStringList term_where_clauses;
+  term_where_clauses.reserve(terms_.count());
+  for (const SmartPlaylistSearchTerm &term : terms_) {
+    term_where_clauses << term.ToSql();
+  }
+
+  if (!terms_.isEmpty() && search_type_ != SearchType::All) {
+    QString boolean_op = search_type_ == SearchType::And ? QLatin1String(" AND ") : QLatin1String(" OR ");
+    where_clauses << QStringLiteral("(") + term_where_clauses.join(boolean_op) + QStringLiteral(")");
+  }
+
+  where_clauses << QStringLiteral("unavailable = 0");
+
+  sql += QLatin1String(" WHERE ") + where_clauses.join(QLatin1String(" AND "));
+
+  return sql;
+
+}
+
+void SmartPlaylistSearch::BindParameters(SqlQuery *query) const {
+
+  // The binding order must match the placeholder order in ToSql(): the excluded IDs first, then the limit and offset.
+  int pos = 0;
+  for (const int id : id_not_in_) {
+    query->bindValue(pos++, id);
+  }
+
+  if (first_item_ > 0) {
+    query->bindValue(pos++, limit_);
+    query->bindValue(pos++, first_item_);
+  }
+  else if (limit_ != -1) {
+    query->bindValue(pos++, limit_);
+  }
+
+}
+
 bool SmartPlaylistSearch::is_valid() const {
 
   if (search_type_ == SearchType::All) return true;
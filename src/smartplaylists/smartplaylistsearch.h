@@ -30,6 +30,8 @@
 #include "playlistgenerator.h"
 #include "smartplaylistsearchterm.h"
 
+class SqlQuery;
+
 class SmartPlaylistSearch {
 
  public:
@@ -67,7 +69,13 @@ class SmartPlaylistSearch {
   int first_item_;
 
   void Reset();
-  QString ToSql(const QString &songs_table) const;
+  // With use_placeholders the volatile values (excluded IDs, limit and offset) become positional placeholders instead of literals,
+  // so the statement text only changes when the search definition changes and prepared statements can be reused across refreshes.
+  QString ToSql(const QString &songs_table, const bool use_placeholders = false) const;
+  // Binds the values for the placeholders generated by ToSql(songs_table, true).
+  void BindParameters(SqlQuery *query) const;
+  // Counts the matches without materializing, sorting or limiting any rows, used for the preview's total.
+  QString ToCountSql(const QString &songs_table) const;
 };
 
 QDataStream &operator<<(QDataStream &s, const SmartPlaylistSearch &search);
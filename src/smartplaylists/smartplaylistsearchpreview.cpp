@@ -25,6 +25,7 @@
 #include <QWidget>
 #include <QAbstractItemView>
 #include <QString>
+#include <QTimer>
 #include <QtConcurrentRun>
 #include <QFuture>
 #include <QFutureWatcher>
@@ -34,19 +35,30 @@
 #include "smartplaylistsearchpreview.h"
 #include "ui_smartplaylistsearchpreview.h"
 
+#include "collection/collectionbackend.h"
 #include "playlist/playlist.h"
 #include "playlistquerygenerator.h"
 
 using std::make_shared;
 
+namespace {
+// How long term edits are coalesced before the preview query runs.
+constexpr int kPreviewDebounceMs = 300;
+}  // namespace
+
 SmartPlaylistSearchPreview::SmartPlaylistSearchPreview(QWidget *parent)
     : QWidget(parent),
       ui_(new Ui_SmartPlaylistSearchPreview),
       collection_backend_(nullptr),
-      model_(nullptr) {
+      model_(nullptr),
+      debounce_timer_(new QTimer(this)) {
 
   ui_->setupUi(this);
 
+  debounce_timer_->setSingleShot(true);
+  debounce_timer_->setInterval(kPreviewDebounceMs);
+  QObject::connect(debounce_timer_, &QTimer::timeout, this, &SmartPlaylistSearchPreview::DebounceTimeout);
+
   // Prevent editing songs and saving settings (like header columns and geometry)
   ui_->tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
   ui_->tree->SetReadOnlySettings(true);
@@ -86,13 +98,16 @@ void SmartPlaylistSearchPreview::Update(const SmartPlaylistSearch &search) {
     return;
   }
 
+  pending_search_ = search;
+
   if (generator_ || isHidden()) {
-    // It's busy generating something already, or the widget isn't visible
-    pending_search_ = search;
+    // It's busy generating something already, or the widget isn't visible.
+    // SearchFinished() or showEvent() picks the pending search up.
     return;
   }
 
-  RunSearch(search);
+  // Every edit restarts the timer, so only the search the user settles on runs
+  debounce_timer_->start();
 
 }
 
@@ -100,60 +115,83 @@ void SmartPlaylistSearchPreview::showEvent(QShowEvent *e) {
 
   if (pending_search_.is_valid() && !generator_) {
     // There was a search waiting while we were hidden, so run it now
-    RunSearch(pending_search_);
-    pending_search_ = SmartPlaylistSearch();
+    debounce_timer_->start();
   }
 
   QWidget::showEvent(e);
 
 }
 
-namespace {
-PlaylistItemPtrList DoRunSearch(PlaylistGeneratorPtr gen) { return gen->Generate(); }
-}  // namespace
+void SmartPlaylistSearchPreview::DebounceTimeout() {
+
+  if (generator_ || isHidden() || !pending_search_.is_valid()) return;
+
+  const SmartPlaylistSearch search = pending_search_;
+  pending_search_ = SmartPlaylistSearch();
+  RunSearch(search);
+
+}
 
 void SmartPlaylistSearchPreview::RunSearch(const SmartPlaylistSearch &search) {
 
+  running_search_ = search;
+
+  // Only a sample is shown, so don't fetch more rows than the preview displays; the total comes from a separate COUNT query.
+  SmartPlaylistSearch sample_search = search;
+  if (sample_search.limit_ == -1 || sample_search.limit_ > PlaylistGenerator::kDefaultLimit) {
+    sample_search.limit_ = PlaylistGenerator::kDefaultLimit;
+  }
+
   generator_ = make_shared<PlaylistQueryGenerator>();
   generator_->set_collection_backend(collection_backend_);
-  std::dynamic_pointer_cast<PlaylistQueryGenerator>(generator_)->Load(search);
+  std::dynamic_pointer_cast<PlaylistQueryGenerator>(generator_)->Load(sample_search);
 
   ui_->busy_container->show();
   ui_->count_label->hide();
-  QFuture<PlaylistItemPtrList> future = QtConcurrent::run(DoRunSearch, generator_);
-  QFutureWatcher<PlaylistItemPtrList> *watcher = new QFutureWatcher<PlaylistItemPtrList>();
-  QObject::connect(watcher, &QFutureWatcher<PlaylistItemPtrList>::finished, this, &SmartPlaylistSearchPreview::SearchFinished);
+
+  PlaylistGeneratorPtr generator = generator_;
+  SharedPtr<CollectionBackend> collection_backend = collection_backend_;
+  QFuture<PreviewResult> future = QtConcurrent::run([generator, collection_backend, search]() {
+    PreviewResult result;
+    result.items = generator->Generate();
+    result.total_count = collection_backend->SmartPlaylistsCountSongs(search);
+    return result;
+  });
+  QFutureWatcher<PreviewResult> *watcher = new QFutureWatcher<PreviewResult>();
+  QObject::connect(watcher, &QFutureWatcher<PreviewResult>::finished, this, &SmartPlaylistSearchPreview::SearchFinished);
   watcher->setFuture(future);
 
 }
 
 void SmartPlaylistSearchPreview::SearchFinished() {
 
-  QFutureWatcher<PlaylistItemPtrList> *watcher = static_cast<QFutureWatcher<PlaylistItemPtrList>*>(sender());
-  PlaylistItemPtrList all_items = watcher->result();
+  QFutureWatcher<PreviewResult> *watcher = static_cast<QFutureWatcher<PreviewResult>*>(sender());
+  const PreviewResult result = watcher->result();
   watcher->deleteLater();
 
-  last_search_ = std::dynamic_pointer_cast<PlaylistQueryGenerator>(generator_)->search();
+  last_search_ = running_search_;
   generator_.reset();
 
   if (pending_search_.is_valid() && pending_search_ != last_search_) {
-    // There was another search done while we were running
-    // throw away these results and do that one now instead
-    RunSearch(pending_search_);
-    pending_search_ = SmartPlaylistSearch();
+    // The search changed while we were running, these results are superseded.
+    // Throw them away and debounce the new search.
+    debounce_timer_->start();
     return;
   }
 
-  PlaylistItemPtrList displayed_items = all_items.mid(0, PlaylistGenerator::kDefaultLimit);
-
   model_->Clear();
-  model_->InsertItems(displayed_items);
+  model_->InsertItems(result.items);
+
+  // The COUNT query ignores the search's own limit, so cap the total like the old full fetch did
+  int total_count = result.total_count;
+  if (total_count < 0) total_count = static_cast<int>(result.items.count());
+  if (last_search_.limit_ != -1 && total_count > last_search_.limit_) total_count = last_search_.limit_;
 
-  if (displayed_items.count() < all_items.count()) {
-    ui_->count_label->setText(tr("%1 songs found (showing %2)").arg(all_items.count()).arg(displayed_items.count()));
+  if (result.items.count() < total_count) {
+    ui_->count_label->setText(tr("%1 songs found (showing %2)").arg(total_count).arg(result.items.count()));
   }
   else {
-    ui_->count_label->setText(tr("%1 songs found").arg(all_items.count()));
+    ui_->count_label->setText(tr("%1 songs found").arg(total_count));
   }
 
   ui_->busy_container->hide();
@@ -30,8 +30,10 @@
 
 #include "smartplaylistsearch.h"
 #include "playlistgenerator_fwd.h"
+#include "playlist/playlistitem.h"
 
 class QShowEvent;
+class QTimer;
 
 class Application;
 class CollectionBackend;
@@ -54,9 +56,16 @@ class SmartPlaylistSearchPreview : public QWidget {
   void showEvent(QShowEvent*) override;
 
  private:
+  // What one preview pass produces: a limited sample of the matches plus the total match count from a separate COUNT query.
+  struct PreviewResult {
+    PlaylistItemPtrList items;
+    int total_count = -1;
+  };
+
   void RunSearch(const SmartPlaylistSearch &search);
 
  private slots:
+  void DebounceTimeout();
   void SearchFinished();
 
  private:
@@ -66,7 +75,11 @@ class SmartPlaylistSearchPreview : public QWidget {
   SharedPtr<CollectionBackend> collection_backend_;
   Playlist *model_;
 
+  // Coalesces rapid term edits, so only the search the user settles on hits the database.
+  QTimer *debounce_timer_;
+
   SmartPlaylistSearch pending_search_;
+  SmartPlaylistSearch running_search_;
   SmartPlaylistSearch last_search_;
   PlaylistGeneratorPtr generator_;
 };
@@ -36,6 +36,7 @@
 
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "spotifyservice.h"
 #include "spotifybaserequest.h"
 
@@ -44,7 +45,7 @@ SpotifyBaseRequest::SpotifyBaseRequest(SpotifyService *service, NetworkAccessMan
       service_(service),
       network_(network) {}
 
-QNetworkReply *SpotifyBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided) {
+QNetworkReply *SpotifyBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided, const int cache_expiry_secs) {
 
   ParamList params = ParamList() << params_provided;
 
@@ -59,6 +60,7 @@ QNetworkReply *SpotifyBaseRequest::CreateRequest(const QString &ressource_name,
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
   req.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/x-www-form-urlencoded"));
   if (!access_token().isEmpty()) req.setRawHeader("authorization", "Bearer " + access_token().toUtf8());
+  if (cache_expiry_secs > 0) req.setAttribute(NetworkAccessManager::kCacheExpirySecsAttribute, cache_expiry_secs);
 
   QNetworkReply *reply = network_->get(req);
   QObject::connect(reply, &QNetworkReply::sslErrors, this, &SpotifyBaseRequest::HandleSSLErrors);
@@ -83,8 +85,17 @@ QByteArray SpotifyBaseRequest::GetReplyData(QNetworkReply *reply) {
 
   if (reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
     data = reply->readAll();
+    // Requests tagged with an expiry time are idempotent, store the reply so browsing the same listing again is served from the disk cache.
+    const int cache_expiry_secs = reply->request().attribute(NetworkAccessManager::kCacheExpirySecsAttribute).toInt();
+    if (cache_expiry_secs > 0 && !reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+      network_->CacheResponse(reply->url(), data, cache_expiry_secs);
+    }
   }
   else {
+    // Feed 429 replies back into the rate limiter so the bucket for this host shrinks.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429) {
+      RateLimiter::RateLimited(reply->url());
+    }
     if (reply->error() != QNetworkReply::NoError && reply->error() < 200) {
       // This is a network error, there is nothing more to do.
       Error(QStringLiteral("%1 (%2)").arg(reply->errorString()).arg(reply->error()));
@@ -124,7 +135,7 @@ QByteArray SpotifyBaseRequest::GetReplyData(QNetworkReply *reply) {
 
 }
 
-QJsonObject SpotifyBaseRequest::ExtractJsonObj(const QByteArray &data) {
+QJsonObject SpotifyBaseRequest::ExtractJsonObj(QByteArray &data) {
 
   QJsonParseError json_error;
   QJsonDocument json_doc = QJsonDocument::fromJson(data, &json_error);
@@ -139,6 +150,10 @@ QJsonObject SpotifyBaseRequest::ExtractJsonObj(const QByteArray &data) {
     return QJsonObject();
   }
 
+  // The document holds its own copy of the parsed data, release the raw body now
+  // so peak memory while walking a large reply is one copy instead of two.
+  data.clear();
+
   if (!json_doc.isObject()) {
     Error(QStringLiteral("Json document is not an object."), json_doc);
     return QJsonObject();
@@ -154,7 +169,7 @@ QJsonObject SpotifyBaseRequest::ExtractJsonObj(const QByteArray &data) {
 
 }
 
-QJsonValue SpotifyBaseRequest::ExtractItems(const QByteArray &data) {
+QJsonValue SpotifyBaseRequest::ExtractItems(QByteArray &data) {
 
   QJsonObject json_obj = ExtractJsonObj(data);
   if (json_obj.isEmpty()) return QJsonValue();
@@ -34,6 +34,7 @@
 
 #include "core/logging.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "core/song.h"
 #include "core/application.h"
 #include "utilities/timeconstants.h"
@@ -51,6 +52,10 @@ const int kMaxConcurrentArtistAlbumsRequests = 1;
 const int kMaxConcurrentAlbumSongsRequests = 1;
 const int kMaxConcurrentAlbumCoverRequests = 10;
 const int kFlushRequestsDelay = 200;
+// How long idempotent replies stay valid in the disk cache.
+// Search results change more often than the albums and tracks of a given artist or album, favorites are never cached.
+const int kSearchCacheExpirySecs = 60 * 60;
+const int kBrowseCacheExpirySecs = 24 * 60 * 60;
 }
 
 SpotifyRequest::SpotifyRequest(SpotifyService *service, Application *app, NetworkAccessManager *network, Type type, QObject *parent)
@@ -128,6 +133,9 @@ void SpotifyRequest::Process() {
     return;
   }
 
+  // Warm up the connection to the API host so the first batch of requests doesn't pay for the TLS handshake.
+  network_->PreConnect(QUrl(QLatin1String(SpotifyService::kApiUrl)));
+
   switch (type_) {
     case Type::Artists:
       GetArtists();
@@ -228,7 +236,7 @@ void SpotifyRequest::AddArtistsRequest(const int offset, const int limit) {
 
 void SpotifyRequest::FlushArtistsRequests() {
 
-  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests) {
+  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(SpotifyService::kApiUrl)))) {
 
     Request request = artists_requests_queue_.dequeue();
 
@@ -247,7 +255,7 @@ void SpotifyRequest::FlushArtistsRequests() {
       reply = CreateRequest(QStringLiteral("me/following"), parameters);
     }
     if (type_ == Type::SearchArtists) {
-      reply = CreateRequest(QStringLiteral("search"), parameters);
+      reply = CreateRequest(QStringLiteral("search"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -282,7 +290,7 @@ void SpotifyRequest::AddAlbumsRequest(const int offset, const int limit) {
 
 void SpotifyRequest::FlushAlbumsRequests() {
 
-  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests) {
+  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(SpotifyService::kApiUrl)))) {
 
     Request request = albums_requests_queue_.dequeue();
 
@@ -301,7 +309,7 @@ void SpotifyRequest::FlushAlbumsRequests() {
       reply = CreateRequest(QStringLiteral("me/albums"), parameters);
     }
     if (type_ == Type::SearchAlbums) {
-      reply = CreateRequest(QStringLiteral("search"), parameters);
+      reply = CreateRequest(QStringLiteral("search"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -336,7 +344,7 @@ void SpotifyRequest::AddSongsRequest(const int offset, const int limit) {
 
 void SpotifyRequest::FlushSongsRequests() {
 
-  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests) {
+  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(SpotifyService::kApiUrl)))) {
 
     Request request = songs_requests_queue_.dequeue();
 
@@ -356,7 +364,7 @@ void SpotifyRequest::FlushSongsRequests() {
       reply = CreateRequest(QStringLiteral("me/tracks"), parameters);
     }
     if (type_ == Type::SearchSongs) {
-      reply = CreateRequest(QStringLiteral("search"), parameters);
+      reply = CreateRequest(QStringLiteral("search"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -537,10 +545,13 @@ void SpotifyRequest::ArtistsFinishCheck(const int limit, const int offset, const
   if (finished_) return;
 
   if ((limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
-    int offset_next = offset + artists_received;
-    if (offset_next > 0 && offset_next < artists_total_) {
-      if (type_ == Type::Artists) AddArtistsRequest(offset_next);
-      else if (type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+    // The first reply tells us the page size and the total, so queue all the remaining pages at once.
+    // FlushRequests() keeps a window of them in flight, so pagination is not serialized on round-trips.
+    if (offset == 0 && artists_received > 0) {
+      for (int offset_next = artists_received; offset_next < artists_total_; offset_next += artists_received) {
+        if (type_ == Type::Artists) AddArtistsRequest(offset_next);
+        else if (type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+      }
     }
   }
 
@@ -588,13 +599,13 @@ void SpotifyRequest::AddArtistAlbumsRequest(const Artist &artist, const int offs
 
 void SpotifyRequest::FlushArtistAlbumsRequests() {
 
-  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests) {
+  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(SpotifyService::kApiUrl)))) {
 
     ArtistAlbumsRequest request = artist_albums_requests_queue_.dequeue();
 
     ParamList parameters;
     if (request.offset > 0) parameters << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters, kBrowseCacheExpirySecs);
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
     replies_ << reply;
 
@@ -815,21 +826,23 @@ void SpotifyRequest::AlbumsFinishCheck(const Artist &artist, const int limit, co
   if (finished_) return;
 
   if (limit == 0 || limit > albums_received) {
-    int offset_next = offset + albums_received;
-    if (offset_next > 0 && offset_next < albums_total) {
-      switch (type_) {
-        case Type::Albums:
-          AddAlbumsRequest(offset_next);
-          break;
-        case Type::SearchAlbums:
-          AddAlbumsSearchRequest(offset_next);
-          break;
-        case Type::Artists:
-        case Type::SearchArtists:
-          AddArtistAlbumsRequest(artist, offset_next);
-          break;
-        default:
-          break;
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && albums_received > 0) {
+      for (int offset_next = albums_received; offset_next < albums_total; offset_next += albums_received) {
+        switch (type_) {
+          case Type::Albums:
+            AddAlbumsRequest(offset_next);
+            break;
+          case Type::SearchAlbums:
+            AddAlbumsSearchRequest(offset_next);
+            break;
+          case Type::Artists:
+          case Type::SearchArtists:
+            AddArtistAlbumsRequest(artist, offset_next);
+            break;
+          default:
+            break;
+        }
       }
     }
   }
@@ -893,13 +906,13 @@ void SpotifyRequest::AddAlbumSongsRequest(const Artist &artist, const Album &alb
 
 void SpotifyRequest::FlushAlbumSongsRequests() {
 
-  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests) {
+  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(SpotifyService::kApiUrl)))) {
 
     AlbumSongsRequest request = album_songs_requests_queue_.dequeue();
     ++album_songs_requests_active_;
     ParamList parameters;
     if (request.offset > 0) parameters << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters, kBrowseCacheExpirySecs);
     replies_ << reply;
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
 
@@ -1030,27 +1043,29 @@ void SpotifyRequest::SongsFinishCheck(const Artist &artist, const Album &album,
   if (finished_) return;
 
   if (limit == 0 || limit > songs_received) {
-    int offset_next = offset + songs_received;
-    if (offset_next > 0 && offset_next < songs_total) {
-      switch (type_) {
-        case Type::Songs:
-          AddSongsRequest(offset_next);
-          break;
-        case Type::SearchSongs:
-          // If artist_id and album_id isn't zero it means that it's a songs search where we fetch all albums too. So fallthrough.
-          if (artist.artist_id.isEmpty() && album.album_id.isEmpty()) {
-            AddSongsSearchRequest(offset_next);
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && songs_received > 0) {
+      for (int offset_next = songs_received; offset_next < songs_total; offset_next += songs_received) {
+        switch (type_) {
+          case Type::Songs:
+            AddSongsRequest(offset_next);
             break;
-          }
-          // fallthrough
-        case Type::Artists:
-        case Type::SearchArtists:
-        case Type::Albums:
-        case Type::SearchAlbums:
-          AddAlbumSongsRequest(artist, album, offset_next);
-          break;
-        default:
-          break;
+          case Type::SearchSongs:
+            // If artist_id and album_id isn't zero it means that it's a songs search where we fetch all albums too. So fallthrough.
+            if (artist.artist_id.isEmpty() && album.album_id.isEmpty()) {
+              AddSongsSearchRequest(offset_next);
+              break;
+            }
+            // fallthrough
+          case Type::Artists:
+          case Type::SearchArtists:
+          case Type::Albums:
+          case Type::SearchAlbums:
+            AddAlbumSongsRequest(artist, album, offset_next);
+            break;
+          default:
+            break;
+        }
       }
     }
   }
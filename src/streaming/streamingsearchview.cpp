@@ -108,7 +108,8 @@ StreamingSearchView::StreamingSearchView(QWidget *parent)
       search_type_(StreamingSearchView::SearchType::Artists),
       search_error_(false),
       last_search_id_(0),
-      searches_next_id_(1) {
+      searches_next_id_(1),
+      showing_provisional_results_(false) {
 
   ui_->setupUi(this);
 
@@ -389,6 +390,7 @@ void StreamingSearchView::TextEdited(const QString &text) {
 
   search_error_ = false;
   cover_loader_tasks_.clear();
+  showing_provisional_results_ = false;
 
   // Add results to the back model, switch models after some delay.
   back_model_->Clear();
@@ -410,6 +412,22 @@ void StreamingSearchView::TextEdited(const QString &text) {
   else {
     ui_->progressbar->reset();
     last_search_id_ = SearchAsync(trimmed, search_type_);
+
+    // When the new query just extends the query the current results are for,
+    // filter those results with the new terms and show them right away while the search runs.
+    if (!last_results_.isEmpty() && !last_results_query_.isEmpty() && trimmed.startsWith(last_results_query_, Qt::CaseInsensitive)) {
+      const QStringList tokens = TokenizeQuery(trimmed);
+      ResultList provisional_results;
+      for (const Result &result : std::as_const(last_results_)) {
+        if (Matches(tokens, result.metadata_.artist() + QLatin1Char(' ') + result.metadata_.album() + QLatin1Char(' ') + result.metadata_.title())) {
+          provisional_results << result;
+        }
+      }
+      if (!provisional_results.isEmpty()) {
+        showing_provisional_results_ = true;
+        current_model_->AddResults(provisional_results);
+      }
+    }
   }
 
 }
@@ -479,7 +497,7 @@ int StreamingSearchView::SearchAsync(const QString &query, const SearchType type
 void StreamingSearchView::SearchAsync(const int id, const QString &query, const SearchType type) {
 
   const int service_id = service_->Search(query, type);
-  pending_searches_[service_id] = PendingState(id, TokenizeQuery(query));
+  pending_searches_[service_id] = PendingState(id, TokenizeQuery(query), query);
 
 }
 
@@ -491,6 +509,9 @@ void StreamingSearchView::SearchDone(const int service_id, const SongMap &songs,
   const PendingState state = pending_searches_.take(service_id);
   const int search_id = state.orig_id_;
 
+  // This search was superseded while the reply was in flight, drop it without building results.
+  if (search_id != last_search_id_) return;
+
   if (songs.isEmpty()) {
     SearchError(search_id, error);
     return;
@@ -509,6 +530,10 @@ void StreamingSearchView::SearchDone(const int service_id, const SongMap &songs,
     it->pixmap_cache_key_ = PixmapCacheKey(*it);
   }
 
+  // Keep the results so the next keystroke that extends this query can show them filtered right away.
+  last_results_query_ = state.query_;
+  last_results_ = results;
+
   AddResults(search_id, results);
 
 }
@@ -523,6 +548,14 @@ void StreamingSearchView::CancelSearch(const int id) {
       return;
     }
   }
+
+  // The search is already in flight: forget it so a late reply is dropped early, and tell the service to abort it.
+  const QList<int> service_ids = pending_searches_.keys();
+  for (const int service_id : service_ids) {
+    if (pending_searches_[service_id].orig_id_ == id) {
+      pending_searches_.remove(service_id);
+    }
+  }
   service_->CancelSearch();
 
 }
@@ -534,6 +567,11 @@ void StreamingSearchView::AddResults(const int id, const StreamingSearchView::Re
   ui_->label_status->clear();
   ui_->progressbar->reset();
   ui_->progressbar->hide();
+  // Fresh results replace the provisional ones filtered from the previous search.
+  if (showing_provisional_results_) {
+    current_model_->Clear();
+    showing_provisional_results_ = false;
+  }
   current_model_->AddResults(results);
 
 }
@@ -91,9 +91,10 @@ class StreamingSearchView : public QWidget {
  protected:
   struct PendingState {
     PendingState() : orig_id_(-1) {}
-    PendingState(int orig_id, const QStringList &tokens) : orig_id_(orig_id), tokens_(tokens) {}
+    PendingState(int orig_id, const QStringList &tokens, const QString &query = QString()) : orig_id_(orig_id), tokens_(tokens), query_(query) {}
     int orig_id_;
     QStringList tokens_;
+    QString query_;
 
     bool operator<(const PendingState &b) const {
       return orig_id_ < b.orig_id_;
@@ -210,6 +211,11 @@ class StreamingSearchView : public QWidget {
   int last_search_id_;
   int searches_next_id_;
 
+  // The results of the last completed search, shown filtered as provisional results when the new query extends the old one.
+  QString last_results_query_;
+  ResultList last_results_;
+  bool showing_provisional_results_;
+
   QMap<int, DelayedSearch> delayed_searches_;
   QMap<int, PendingState> pending_searches_;
 
@@ -32,6 +32,7 @@
 #include <QContextMenuEvent>
 #include <QAction>
 #include <QSettings>
+#include <QTimer>
 
 #include "core/application.h"
 #include "core/iconloader.h"
@@ -46,6 +47,11 @@
 #include "streamingcollectionviewcontainer.h"
 #include "ui_streamingtabsview.h"
 
+namespace {
+// How long after startup the persisted collections are refreshed in the background.
+constexpr int kBackgroundRefreshStartupDelayMs = 10 * 1000;
+}  // namespace
+
 StreamingTabsView::StreamingTabsView(Application *app, StreamingServicePtr service, const QString &settings_group, const SettingsDialog::Page settings_page, QWidget *parent)
     : QWidget(parent),
       app_(app),
@@ -180,6 +186,10 @@ StreamingTabsView::StreamingTabsView(Application *app, StreamingServicePtr servi
 
   ReloadSettings();
 
+  // The views show the collections persisted in the database right away,
+  // revalidate them in the background a little after startup.
+  QTimer::singleShot(kBackgroundRefreshStartupDelayMs, this, &StreamingTabsView::RefreshInBackground);
+
 }
 
 StreamingTabsView::~StreamingTabsView() {
@@ -233,6 +243,28 @@ void StreamingTabsView::FocusSearchField() {
 
 }
 
+void StreamingTabsView::RefreshInBackground() {
+
+  // Stale-while-revalidate: refresh the collections quietly without switching to the progress page,
+  // the replies flow through the normal Finished handlers and are diffed into the database,
+  // which updates the models incrementally.
+  // Only collections that were loaded before are refreshed,
+  // and only when the service is already authenticated, so startup never pops a login.
+
+  if (!service_->authenticated()) return;
+
+  if (service_->artists_collection_model() && service_->artists_collection_model()->total_song_count() > 0) {
+    service_->GetArtists();
+  }
+  if (service_->albums_collection_model() && service_->albums_collection_model()->total_song_count() > 0) {
+    service_->GetAlbums();
+  }
+  if (service_->songs_collection_model() && service_->songs_collection_model()->total_song_count() > 0) {
+    service_->GetSongs();
+  }
+
+}
+
 void StreamingTabsView::GetArtists() {
 
   if (!service_->authenticated() && service_->oauth()) {
@@ -59,6 +59,7 @@ class StreamingTabsView : public QWidget {
 
  private slots:
   void OpenSettingsDialog();
+  void RefreshInBackground();
   void GetArtists();
   void GetAlbums();
   void GetSongs();
@@ -191,6 +191,10 @@ QJsonObject SubsonicBaseRequest::ExtractJsonObj(QByteArray &data) {
     return QJsonObject();
   }
 
+  // The document holds its own copy of the parsed data, release the raw body now
+  // so peak memory while walking a large reply is one copy instead of two.
+  data.clear();
+
   if (!json_doc.isObject()) {
     Error(QStringLiteral("Json document is not an object."), json_doc);
     return QJsonObject();
@@ -43,6 +43,7 @@
 #include "core/logging.h"
 #include "core/song.h"
 #include "core/networktimeouts.h"
+#include "collection/collectionbackend.h"
 #include "utilities/imageutils.h"
 #include "utilities/timeconstants.h"
 #include "subsonicservice.h"
@@ -113,6 +114,7 @@ void SubsonicRequest::Reset() {
   album_covers_requested_ = 0;
   album_covers_received_ = 0;
 
+  existing_songs_by_album_.clear();
   songs_.clear();
   cover_urls_.clear();
   errors_.clear();
@@ -126,10 +128,24 @@ void SubsonicRequest::GetAlbums() {
 
   emit UpdateStatus(tr("Retrieving albums..."));
   emit UpdateProgress(0);
+  LoadExistingSongs();
   AddAlbumsRequest();
 
 }
 
+void SubsonicRequest::LoadExistingSongs() {
+
+  existing_songs_by_album_.clear();
+
+  const SongList existing_songs = service_->collection_backend()->GetAllSongs();
+  for (const Song &song : existing_songs) {
+    if (!song.album_id().isEmpty()) {
+      existing_songs_by_album_[song.album_id()] << song;
+    }
+  }
+
+}
+
 void SubsonicRequest::AddAlbumsRequest(const int offset, const int size) {
 
   Request request;
@@ -280,6 +296,27 @@ void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset
 
     if (album_songs_requests_pending_.contains(album_id)) continue;
 
+    // Delta sync: when the album is unchanged since the last sync, reuse the songs we already have instead of fetching them again.
+    // An album is considered unchanged when the song count matches and it was not created after the songs we have for it.
+    if (obj_album.contains(QLatin1String("songCount")) && existing_songs_by_album_.contains(album_id)) {
+      const int song_count = obj_album[QLatin1String("songCount")].toInt();
+      qint64 album_created = 0;
+      if (obj_album.contains(QLatin1String("created"))) {
+        album_created = QDateTime::fromString(obj_album[QLatin1String("created")].toString(), Qt::ISODate).toSecsSinceEpoch();
+      }
+      const SongList &existing_songs = existing_songs_by_album_[album_id];
+      qint64 newest_ctime = 0;
+      for (const Song &song : existing_songs) {
+        newest_ctime = qMax(newest_ctime, song.ctime());
+      }
+      if (song_count > 0 && existing_songs.count() == song_count && album_created <= newest_ctime) {
+        for (const Song &song : existing_songs) {
+          songs_.insert(song.song_id(), song);
+        }
+        continue;
+      }
+    }
+
     Request request;
     request.album_id = album_id;
     request.album_artist = artist;
@@ -90,6 +90,7 @@ class SubsonicRequest : public SubsonicBaseRequest {
 
  private:
 
+  void LoadExistingSongs();
   void AddAlbumsRequest(const int offset = 0, const int size = 500);
   void FlushAlbumsRequests();
 
@@ -135,6 +136,9 @@ class SubsonicRequest : public SubsonicBaseRequest {
   int album_covers_requested_;
   int album_covers_received_;
 
+  // Songs already in the collection from the last sync, grouped by album, so unchanged albums can be reused without re-fetching their songs.
+  QHash<QString, SongList> existing_songs_by_album_;
+
   SongMap songs_;
   QMap<QString, QUrl> cover_urls_;
   QStringList errors_;
@@ -26,6 +26,7 @@
 #include <QByteArray>
 #include <QList>
 #include <QString>
+#include <QStringList>
 #include <QVariant>
 #include <QUrl>
 #include <QUrlQuery>
@@ -103,6 +104,13 @@ SubsonicService::~SubsonicService() {
     reply->deleteLater();
   }
 
+  while (!probe_replies_.isEmpty()) {
+    QNetworkReply *reply = probe_replies_.takeFirst();
+    QObject::disconnect(reply, nullptr, this, nullptr);
+    if (reply->isRunning()) reply->abort();
+    reply->deleteLater();
+  }
+
 }
 
 void SubsonicService::Exit() {
@@ -127,6 +135,14 @@ void SubsonicService::ReloadSettings() {
   if (password.isEmpty()) password_.clear();
   else password_ = QString::fromUtf8(QByteArray::fromBase64(password));
 
+  // Alternative URLs for the same server, for multi-homed servers that are reachable on more than one address.
+  mirror_urls_.clear();
+  const QStringList mirror_urls = s.value("mirrorurls").toStringList();
+  for (const QString &mirror_url : mirror_urls) {
+    const QUrl url(mirror_url);
+    if (url.isValid() && url != server_url_ && !mirror_urls_.contains(url)) mirror_urls_ << url;
+  }
+
   http2_ = s.value("http2", false).toBool();
   verify_certificate_ = s.value("verifycertificate", false).toBool();
   download_album_covers_ = s.value("downloadalbumcovers", true).toBool();
@@ -134,19 +150,15 @@ void SubsonicService::ReloadSettings() {
 
   s.endGroup();
 
+  ProbeServers();
+
 }
 
 void SubsonicService::SendPing() {
   SendPingWithCredentials(server_url_, username_, password_, auth_method_, false);
 }
 
-void SubsonicService::SendPingWithCredentials(QUrl url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method, const bool redirect) {
-
-  if (!network_ || !redirect) {
-    network_ = make_unique<QNetworkAccessManager>();
-    network_->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
-    ping_redirects_ = 0;
-  }
+QUrl SubsonicService::CreatePingUrl(QUrl url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method, const bool redirect) const {
 
   using Param = QPair<QString, QString>;
   using ParamList = QList<Param>;
@@ -184,6 +196,12 @@ void SubsonicService::SendPingWithCredentials(QUrl url, const QString &username,
 
   url.setQuery(url_query);
 
+  return url;
+
+}
+
+QNetworkRequest SubsonicService::CreatePingRequest(const QUrl &url) const {
+
   QNetworkRequest req(url);
 
   if (url.scheme() == QLatin1String("https") && !verify_certificate_) {
@@ -199,6 +217,22 @@ void SubsonicService::SendPingWithCredentials(QUrl url, const QString &username,
   req.setAttribute(QNetworkRequest::Http2AllowedAttribute, http2_);
 #endif
 
+  return req;
+
+}
+
+void SubsonicService::SendPingWithCredentials(QUrl url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method, const bool redirect) {
+
+  if (!network_ || !redirect) {
+    network_ = make_unique<QNetworkAccessManager>();
+    network_->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
+    ping_redirects_ = 0;
+  }
+
+  url = CreatePingUrl(url, username, password, auth_method, redirect);
+
+  QNetworkRequest req = CreatePingRequest(url);
+
   errors_.clear();
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
@@ -365,6 +399,71 @@ void SubsonicService::HandlePingReply(QNetworkReply *reply, const QUrl &url, con
 
 }
 
+void SubsonicService::ProbeServers() {
+
+  if (mirror_urls_.isEmpty() || !server_url_.isValid() || username_.isEmpty() || password_.isEmpty()) return;
+
+  // Abort any probes still in flight from a previous settings reload.
+  while (!probe_replies_.isEmpty()) {
+    QNetworkReply *reply = probe_replies_.takeFirst();
+    QObject::disconnect(reply, nullptr, this, nullptr);
+    if (reply->isRunning()) reply->abort();
+    reply->deleteLater();
+  }
+
+  if (!network_) {
+    network_ = make_unique<QNetworkAccessManager>();
+    network_->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
+  }
+
+  // Ping the configured URL and all mirrors in parallel, the fastest server to answer successfully is used for the rest of the session.
+  const QList<QUrl> urls = QList<QUrl>() << server_url_ << mirror_urls_;
+  for (const QUrl &server_url : urls) {
+    QNetworkRequest req = CreatePingRequest(CreatePingUrl(server_url, username_, password_, auth_method_, false));
+    QNetworkReply *reply = network_->get(req);
+    probe_replies_ << reply;
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, server_url]() { HandleProbeReply(reply, server_url); });
+  }
+
+}
+
+void SubsonicService::HandleProbeReply(QNetworkReply *reply, const QUrl &url) {
+
+  if (!probe_replies_.contains(reply)) return;
+  probe_replies_.removeAll(reply);
+  QObject::disconnect(reply, nullptr, this, nullptr);
+  reply->deleteLater();
+
+  // Unreachable and slow servers simply lose the race.
+  if (reply->error() != QNetworkReply::NoError || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+    if (probe_replies_.isEmpty()) {
+      qLog(Debug) << "Subsonic: No server answered the probes, keeping" << server_url_.toString();
+    }
+    return;
+  }
+
+  const QByteArray data = reply->readAll();
+  QJsonParseError parse_error;
+  const QJsonDocument json_doc = QJsonDocument::fromJson(data, &parse_error);
+  if (parse_error.error != QJsonParseError::NoError || !json_doc.isObject()) return;
+  const QJsonObject obj_response = json_doc.object()[QLatin1String("subsonic-response")].toObject();
+  if (obj_response[QLatin1String("status")].toString().toLower() != QLatin1String("ok")) return;
+
+  if (url != server_url_) {
+    qLog(Debug) << "Subsonic: Using fastest server" << url.toString() << "for this session";
+    server_url_ = url;
+  }
+
+  // The fastest server won, abort the probes of the others.
+  while (!probe_replies_.isEmpty()) {
+    QNetworkReply *other_reply = probe_replies_.takeFirst();
+    QObject::disconnect(other_reply, nullptr, this, nullptr);
+    if (other_reply->isRunning()) other_reply->abort();
+    other_reply->deleteLater();
+  }
+
+}
+
 void SubsonicService::CheckConfiguration() {
 
   if (server_url_.isEmpty()) {
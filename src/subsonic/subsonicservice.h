@@ -33,6 +33,7 @@
 #include <QStringList>
 #include <QUrl>
 #include <QNetworkAccessManager>
+#include <QNetworkRequest>
 #include <QSslError>
 #include <QDateTime>
 
@@ -91,6 +92,7 @@ class SubsonicService : public StreamingService {
   void ShowConfig() override;
   void SendPing();
   void SendPingWithCredentials(QUrl url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method, const bool redirect = false);
+  void ProbeServers();
   void GetSongs() override;
   void DeleteSongs();
   void ResetSongsRequest() override;
@@ -98,9 +100,12 @@ class SubsonicService : public StreamingService {
  private slots:
   void HandlePingSSLErrors(const QList<QSslError> &ssl_errors);
   void HandlePingReply(QNetworkReply *reply, const QUrl &url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method);
+  void HandleProbeReply(QNetworkReply *reply, const QUrl &url);
   void SongsResultsReceived(const SongMap &songs, const QString &error);
 
  private:
+  QUrl CreatePingUrl(QUrl url, const QString &username, const QString &password, const SubsonicSettingsPage::AuthMethod auth_method, const bool redirect) const;
+  QNetworkRequest CreatePingRequest(const QUrl &url) const;
   void PingError(const QString &error = QString(), const QVariant &debug = QVariant());
 
   Application *app_;
@@ -114,6 +119,9 @@ class SubsonicService : public StreamingService {
   SharedPtr<SubsonicScrobbleRequest> scrobble_request_;
 
   QUrl server_url_;
+  // Alternative URLs for the same server (e.g. LAN, WAN and VPN addresses of a multi-homed server).
+  // All URLs are probed in parallel and the fastest server to answer is used for the session.
+  QList<QUrl> mirror_urls_;
   QString username_;
   QString password_;
   bool http2_;
@@ -125,6 +133,7 @@ class SubsonicService : public StreamingService {
   int ping_redirects_;
 
   QList<QNetworkReply*> replies_;
+  QList<QNetworkReply*> probe_replies_;
 };
 
 using SubsonicServicePtr = SharedPtr<SubsonicService>;
@@ -37,6 +37,7 @@
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "tidalservice.h"
 #include "tidalbaserequest.h"
 
@@ -45,7 +46,7 @@ TidalBaseRequest::TidalBaseRequest(TidalService *service, SharedPtr<NetworkAcces
       service_(service),
       network_(network) {}
 
-QNetworkReply *TidalBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided) {
+QNetworkReply *TidalBaseRequest::CreateRequest(const QString &ressource_name, const ParamList &params_provided, const int cache_expiry_secs) {
 
   ParamList params = ParamList() << params_provided
                                  << Param(QStringLiteral("countryCode"), country_code());
@@ -62,6 +63,7 @@ QNetworkReply *TidalBaseRequest::CreateRequest(const QString &ressource_name, co
   req.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/x-www-form-urlencoded"));
   if (oauth() && !access_token().isEmpty()) req.setRawHeader("authorization", "Bearer " + access_token().toUtf8());
   else if (!session_id().isEmpty()) req.setRawHeader("X-Tidal-SessionId", session_id().toUtf8());
+  if (cache_expiry_secs > 0) req.setAttribute(NetworkAccessManager::kCacheExpirySecsAttribute, cache_expiry_secs);
 
   QNetworkReply *reply = network_->get(req);
   QObject::connect(reply, &QNetworkReply::sslErrors, this, &TidalBaseRequest::HandleSSLErrors);
@@ -86,8 +88,17 @@ QByteArray TidalBaseRequest::GetReplyData(QNetworkReply *reply, const bool send_
 
   if (reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
     data = reply->readAll();
+    // Requests tagged with an expiry time are idempotent, store the reply so browsing the same listing again is served from the disk cache.
+    const int cache_expiry_secs = reply->request().attribute(NetworkAccessManager::kCacheExpirySecsAttribute).toInt();
+    if (cache_expiry_secs > 0 && !reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+      network_->CacheResponse(reply->url(), data, cache_expiry_secs);
+    }
   }
   else {
+    // Feed 429 replies back into the rate limiter so the bucket for this host shrinks.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429) {
+      RateLimiter::RateLimited(reply->url());
+    }
     if (reply->error() != QNetworkReply::NoError && reply->error() < 200) {
       // This is a network error, there is nothing more to do.
       Error(QStringLiteral("%1 (%2)").arg(reply->errorString()).arg(reply->error()));
@@ -145,7 +156,7 @@ QByteArray TidalBaseRequest::GetReplyData(QNetworkReply *reply, const bool send_
 
 }
 
-QJsonObject TidalBaseRequest::ExtractJsonObj(const QByteArray &data) {
+QJsonObject TidalBaseRequest::ExtractJsonObj(QByteArray &data) {
 
   QJsonParseError json_error;
   QJsonDocument json_doc = QJsonDocument::fromJson(data, &json_error);
@@ -160,6 +171,10 @@ QJsonObject TidalBaseRequest::ExtractJsonObj(const QByteArray &data) {
     return QJsonObject();
   }
 
+  // The document holds its own copy of the parsed data, release the raw body now
+  // so peak memory while walking a large reply is one copy instead of two.
+  data.clear();
+
   if (!json_doc.isObject()) {
     Error(QStringLiteral("Json document is not an object."), json_doc);
     return QJsonObject();
@@ -175,7 +190,7 @@ QJsonObject TidalBaseRequest::ExtractJsonObj(const QByteArray &data) {
 
 }
 
-QJsonValue TidalBaseRequest::ExtractItems(const QByteArray &data) {
+QJsonValue TidalBaseRequest::ExtractItems(QByteArray &data) {
 
   QJsonObject json_obj = ExtractJsonObj(data);
   if (json_obj.isEmpty()) return QJsonValue();
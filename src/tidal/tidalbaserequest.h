@@ -63,10 +63,10 @@ class TidalBaseRequest : public QObject {
   using Param = QPair<QString, QString>;
   using ParamList = QList<Param>;
 
-  QNetworkReply *CreateRequest(const QString &ressource_name, const ParamList &params_provided);
+  QNetworkReply *CreateRequest(const QString &ressource_name, const ParamList &params_provided, const int cache_expiry_secs = 0);
   QByteArray GetReplyData(QNetworkReply *reply, const bool send_login);
-  QJsonObject ExtractJsonObj(const QByteArray &data);
-  QJsonValue ExtractItems(const QByteArray &data);
+  QJsonObject ExtractJsonObj(QByteArray &data);
+  QJsonValue ExtractItems(QByteArray &data);
   QJsonValue ExtractItems(const QJsonObject &json_obj);
 
   virtual void Error(const QString &error, const QVariant &debug = QVariant()) = 0;
@@ -37,6 +37,7 @@
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/ratelimiter.h"
 #include "core/song.h"
 #include "core/application.h"
 #include "utilities/timeconstants.h"
@@ -56,6 +57,10 @@ constexpr int kMaxConcurrentArtistAlbumsRequests = 3;
 constexpr int kMaxConcurrentAlbumSongsRequests = 3;
 constexpr int kMaxConcurrentAlbumCoverRequests = 1;
 constexpr int kFlushRequestsDelay = 200;
+// How long idempotent replies stay valid in the disk cache.
+// Search results change more often than the albums and tracks of a given artist or album, favorites are never cached.
+constexpr int kSearchCacheExpirySecs = 60 * 60;
+constexpr int kBrowseCacheExpirySecs = 24 * 60 * 60;
 }  // namespace
 
 TidalRequest::TidalRequest(TidalService *service, TidalUrlHandler *url_handler, Application *app, SharedPtr<NetworkAccessManager> network, Type query_type, QObject *parent)
@@ -147,6 +152,9 @@ void TidalRequest::Process() {
     return;
   }
 
+  // Warm up the connection to the API host so the first batch of requests doesn't pay for the TLS handshake.
+  network_->PreConnect(QUrl(QLatin1String(TidalService::kApiUrl)));
+
   switch (query_type_) {
     case Type::Artists:
       GetArtists();
@@ -245,7 +253,7 @@ void TidalRequest::AddArtistsRequest(const int offset, const int limit) {
 
 void TidalRequest::FlushArtistsRequests() {
 
-  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests) {
+  while (!artists_requests_queue_.isEmpty() && artists_requests_active_ < kMaxConcurrentArtistsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(TidalService::kApiUrl)))) {
 
     Request request = artists_requests_queue_.dequeue();
 
@@ -258,7 +266,7 @@ void TidalRequest::FlushArtistsRequests() {
       reply = CreateRequest(QStringLiteral("users/%1/favorites/artists").arg(service_->user_id()), parameters);
     }
     if (query_type_ == Type::SearchArtists) {
-      reply = CreateRequest(QStringLiteral("search/artists"), parameters);
+      reply = CreateRequest(QStringLiteral("search/artists"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -293,7 +301,7 @@ void TidalRequest::AddAlbumsRequest(const int offset, const int limit) {
 
 void TidalRequest::FlushAlbumsRequests() {
 
-  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests) {
+  while (!albums_requests_queue_.isEmpty() && albums_requests_active_ < kMaxConcurrentAlbumsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(TidalService::kApiUrl)))) {
 
     Request request = albums_requests_queue_.dequeue();
 
@@ -306,7 +314,7 @@ void TidalRequest::FlushAlbumsRequests() {
       reply = CreateRequest(QStringLiteral("users/%1/favorites/albums").arg(service_->user_id()), parameters);
     }
     if (query_type_ == Type::SearchAlbums) {
-      reply = CreateRequest(QStringLiteral("search/albums"), parameters);
+      reply = CreateRequest(QStringLiteral("search/albums"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -341,7 +349,7 @@ void TidalRequest::AddSongsRequest(const int offset, const int limit) {
 
 void TidalRequest::FlushSongsRequests() {
 
-  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests) {
+  while (!songs_requests_queue_.isEmpty() && songs_requests_active_ < kMaxConcurrentSongsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(TidalService::kApiUrl)))) {
 
     Request request = songs_requests_queue_.dequeue();
 
@@ -354,7 +362,7 @@ void TidalRequest::FlushSongsRequests() {
       reply = CreateRequest(QStringLiteral("users/%1/favorites/tracks").arg(service_->user_id()), parameters);
     }
     if (query_type_ == Type::SearchSongs) {
-      reply = CreateRequest(QStringLiteral("search/tracks"), parameters);
+      reply = CreateRequest(QStringLiteral("search/tracks"), parameters, kSearchCacheExpirySecs);
     }
     if (!reply) continue;
     replies_ << reply;
@@ -530,10 +538,13 @@ void TidalRequest::ArtistsFinishCheck(const int limit, const int offset, const i
   if (finished_) return;
 
   if ((limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
-    int offset_next = offset + artists_received;
-    if (offset_next > 0 && offset_next < artists_total_) {
-      if (query_type_ == Type::Artists) AddArtistsRequest(offset_next);
-      else if (query_type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+    // The first reply tells us the page size and the total, so queue all the remaining pages at once.
+    // FlushRequests() keeps a window of them in flight, so pagination is not serialized on round-trips.
+    if (offset == 0 && artists_received > 0) {
+      for (int offset_next = artists_received; offset_next < artists_total_; offset_next += artists_received) {
+        if (query_type_ == Type::Artists) AddArtistsRequest(offset_next);
+        else if (query_type_ == Type::SearchArtists) AddArtistsSearchRequest(offset_next);
+      }
     }
   }
 
@@ -581,13 +592,13 @@ void TidalRequest::AddArtistAlbumsRequest(const Artist &artist, const int offset
 
 void TidalRequest::FlushArtistAlbumsRequests() {
 
-  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests) {
+  while (!artist_albums_requests_queue_.isEmpty() && artist_albums_requests_active_ < kMaxConcurrentArtistAlbumsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(TidalService::kApiUrl)))) {
 
     const ArtistAlbumsRequest request = artist_albums_requests_queue_.dequeue();
 
     ParamList parameters;
     if (request.offset > 0) parameters << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("artists/%1/albums").arg(request.artist.artist_id), parameters, kBrowseCacheExpirySecs);
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { ArtistAlbumsReplyReceived(reply, request.artist, request.offset); });
     replies_ << reply;
 
@@ -780,21 +791,23 @@ void TidalRequest::AlbumsFinishCheck(const Artist &artist, const int limit, cons
   if (finished_) return;
 
   if (limit == 0 || limit > albums_received) {
-    int offset_next = offset + albums_received;
-    if (offset_next > 0 && offset_next < albums_total) {
-      switch (query_type_) {
-        case Type::Albums:
-          AddAlbumsRequest(offset_next);
-          break;
-        case Type::SearchAlbums:
-          AddAlbumsSearchRequest(offset_next);
-          break;
-        case Type::Artists:
-        case Type::SearchArtists:
-          AddArtistAlbumsRequest(artist, offset_next);
-          break;
-        default:
-          break;
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && albums_received > 0) {
+      for (int offset_next = albums_received; offset_next < albums_total; offset_next += albums_received) {
+        switch (query_type_) {
+          case Type::Albums:
+            AddAlbumsRequest(offset_next);
+            break;
+          case Type::SearchAlbums:
+            AddAlbumsSearchRequest(offset_next);
+            break;
+          case Type::Artists:
+          case Type::SearchArtists:
+            AddArtistAlbumsRequest(artist, offset_next);
+            break;
+          default:
+            break;
+        }
       }
     }
   }
@@ -857,12 +870,12 @@ void TidalRequest::AddAlbumSongsRequest(const Artist &artist, const Album &album
 
 void TidalRequest::FlushAlbumSongsRequests() {
 
-  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests) {
+  while (!album_songs_requests_queue_.isEmpty() && album_songs_requests_active_ < kMaxConcurrentAlbumSongsRequests && RateLimiter::TryAcquire(QUrl(QLatin1String(TidalService::kApiUrl)))) {
 
     AlbumSongsRequest request = album_songs_requests_queue_.dequeue();
     ParamList parameters;
     if (request.offset > 0) parameters << Param(QStringLiteral("offset"), QString::number(request.offset));
-    QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters);
+    QNetworkReply *reply = CreateRequest(QStringLiteral("albums/%1/tracks").arg(request.album.album_id), parameters, kBrowseCacheExpirySecs);
     replies_ << reply;
     QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { AlbumSongsReplyReceived(reply, request.artist, request.album, request.offset); });
 
@@ -986,27 +999,29 @@ void TidalRequest::SongsFinishCheck(const Artist &artist, const Album &album, co
   if (finished_) return;
 
   if (limit == 0 || limit > songs_received) {
-    int offset_next = offset + songs_received;
-    if (offset_next > 0 && offset_next < songs_total) {
-      switch (query_type_) {
-        case Type::Songs:
-          AddSongsRequest(offset_next);
-          break;
-        case Type::SearchSongs:
-          // If artist_id and album_id isn't zero it means that it's a songs search where we fetch all albums too. So fallthrough.
-          if (artist.artist_id.isEmpty() && album.album_id.isEmpty()) {
-            AddSongsSearchRequest(offset_next);
+    // Queue all the remaining pages as soon as the first reply reveals the total, see ArtistsFinishCheck().
+    if (offset == 0 && songs_received > 0) {
+      for (int offset_next = songs_received; offset_next < songs_total; offset_next += songs_received) {
+        switch (query_type_) {
+          case Type::Songs:
+            AddSongsRequest(offset_next);
+            break;
+          case Type::SearchSongs:
+            // If artist_id and album_id isn't zero it means that it's a songs search where we fetch all albums too. So fallthrough.
+            if (artist.artist_id.isEmpty() && album.album_id.isEmpty()) {
+              AddSongsSearchRequest(offset_next);
+              break;
+            }
+            [[fallthrough]];
+          case Type::Artists:
+          case Type::SearchArtists:
+          case Type::Albums:
+          case Type::SearchAlbums:
+            AddAlbumSongsRequest(artist, album, offset_next);
             break;
-          }
-          [[fallthrough]];
-        case Type::Artists:
-        case Type::SearchArtists:
-        case Type::Albums:
-        case Type::SearchAlbums:
-          AddAlbumSongsRequest(artist, album, offset_next);
-          break;
-        default:
-          break;
+          default:
+            break;
+        }
       }
     }
   }
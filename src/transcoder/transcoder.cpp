@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <glib.h>
 #include <glib/gtypes.h>
@@ -42,14 +43,60 @@
 #include <QString>
 #include <QSettings>
 
+#ifdef Q_OS_UNIX
+#  include <sys/time.h>
+#  include <sys/resource.h>
+#elif defined(Q_OS_WIN)
+#  include <windows.h>
+#endif
+
+#ifdef HAVE_EBUR128
+#  include <cstring>
+#  include <optional>
+#  include <gst/app/gstappsink.h>
+#endif
+
 #include "core/logging.h"
 #include "core/shared_ptr.h"
 #include "core/signalchecker.h"
 #include "core/settings.h"
 #include "transcoder.h"
 
+#ifdef HAVE_EBUR128
+#  include "engine/ebur128analysis.h"
+#endif
+
 using std::make_shared;
 
+namespace {
+
+// Lower bound for a measured codec cost, so cheap codecs can't oversubscribe the box without limit.
+constexpr double kMinJobCost = 0.25;
+
+// The process CPU time (user + system) in seconds, or -1 where it can't be read. Used to measure per-codec job cost.
+double ProcessCpuSeconds() {
+
+#ifdef Q_OS_UNIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return -1.0;
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+#elif defined(Q_OS_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time) == 0) return -1.0;
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernel_time.dwLowDateTime;
+  kernel.HighPart = kernel_time.dwHighDateTime;
+  user.LowPart = user_time.dwLowDateTime;
+  user.HighPart = user_time.dwHighDateTime;
+  return static_cast<double>(kernel.QuadPart + user.QuadPart) / 1.0e7;
+#else
+  return -1.0;
+#endif
+
+}
+
+}  // namespace
+
 int Transcoder::JobFinishedEvent::sEventType = -1;
 
 TranscoderPreset::TranscoderPreset(const Song::FileType filetype, const QString &name, const QString &extension, const QString &codec_mimetype, const QString &muxer_mimetype)
@@ -191,7 +238,13 @@ void Transcoder::JobState::PostFinished(const bool success) {
 Transcoder::Transcoder(QObject *parent, const QString &settings_postfix)
     : QObject(parent),
       max_threads_(QThread::idealThreadCount()),
-      settings_postfix_(settings_postfix) {
+      settings_postfix_(settings_postfix),
+      last_cpu_seconds_(-1.0)
+#ifdef HAVE_EBUR128
+      ,
+      analyze_loudness_(false)
+#endif
+{
 
   if (JobFinishedEvent::sEventType == -1)
     JobFinishedEvent::sEventType = QEvent::registerEventType();
@@ -211,6 +264,17 @@ Transcoder::Transcoder(QObject *parent, const QString &settings_postfix)
 
 }
 
+Transcoder::~Transcoder() {
+
+  // Destroy the parked pipelines, they are already in the NULL state.
+  for (const QList<PipelineTemplate> &pool : std::as_const(pipeline_pool_)) {
+    for (const PipelineTemplate &pipeline_template : pool) {
+      gst_object_unref(pipeline_template.pipeline_);
+    }
+  }
+
+}
+
 QList<TranscoderPreset> Transcoder::GetAllPresets() {
 
   QList<TranscoderPreset> ret;
@@ -328,9 +392,38 @@ void Transcoder::Start() {
 
 }
 
+void Transcoder::SampleCpuUsage() {
+
+  const double cpu_seconds = ProcessCpuSeconds();
+  if (cpu_seconds >= 0.0 && last_cpu_seconds_ >= 0.0 && !current_jobs_.isEmpty()) {
+    // The CPU time used since the last sample is split evenly, which is exact for the usual homogeneous batch.
+    const double share = (cpu_seconds - last_cpu_seconds_) / static_cast<double>(current_jobs_.count());
+    for (SharedPtr<JobState> &state : current_jobs_) {
+      state->attributed_cpu_seconds_ += share;
+    }
+  }
+  last_cpu_seconds_ = cpu_seconds;
+
+}
+
+double Transcoder::JobCost(const TranscoderPreset &preset) const {
+
+  return codec_costs_.value(preset.codec_mimetype_, 1.0);
+
+}
+
 Transcoder::StartJobStatus Transcoder::MaybeStartNextJob() {
 
-  if (current_jobs_.count() >= max_threads()) return StartJobStatus::AllThreadsBusy;
+  // Jobs are admitted against a CPU budget of max_threads() cores instead of a flat job count,
+  // so codecs measured at less than a full core get extra concurrency.
+  double busy_cost = 0.0;
+  for (const SharedPtr<JobState> &state : current_jobs_) {
+    busy_cost += JobCost(state->job_.preset);
+  }
+  if (!queued_jobs_.isEmpty() && !current_jobs_.isEmpty() && busy_cost + JobCost(queued_jobs_.first().preset) > static_cast<double>(max_threads())) {
+    return StartJobStatus::AllThreadsBusy;
+  }
+
   if (queued_jobs_.isEmpty()) {
     if (current_jobs_.isEmpty()) {
       emit AllJobsComplete();
@@ -364,6 +457,27 @@ void Transcoder::NewPadCallback(GstElement*, GstPad *pad, gpointer data) {
 
 }
 
+#ifdef HAVE_EBUR128
+GstFlowReturn Transcoder::NewAnalysisBufferCallback(GstAppSink *app_sink, gpointer data) {
+
+  JobState *state = reinterpret_cast<JobState*>(data);
+
+  GstSample *sample = gst_app_sink_pull_sample(app_sink);
+  if (!sample) return GST_FLOW_ERROR;
+
+  // A failed analysis shouldn't fail the transcode, so keep draining the branch and just drop the measures at the end.
+  if (!state->loudness_failed_ && !state->loudness_stream_->AddSample(sample)) {
+    qLog(Warning) << "Sample format changed mid-stream, discarding the loudness measures for" << state->job_.input;
+    state->loudness_failed_ = true;
+  }
+
+  gst_sample_unref(sample);
+
+  return GST_FLOW_OK;
+
+}
+#endif
+
 GstBusSyncReply Transcoder::BusCallbackSync(GstBus*, GstMessage *msg, gpointer data) {
 
   JobState *state = reinterpret_cast<JobState*>(data);
@@ -400,59 +514,140 @@ void Transcoder::JobState::ReportError(GstMessage *msg) const {
 
 }
 
+QString Transcoder::PipelinePoolKey(const TranscoderPreset &preset) const {
+
+  QString key = preset.codec_mimetype_ + QLatin1Char('|') + preset.muxer_mimetype_;
+#ifdef HAVE_EBUR128
+  // Pipelines with a loudness analysis branch are structurally different, keep them apart in the pool.
+  if (analyze_loudness_) key += QLatin1String("|r128");
+#endif
+
+  return key;
+
+}
+
 bool Transcoder::StartJob(const Job &job) {
 
   SharedPtr<JobState> state = make_shared<JobState>(job, this);
 
   emit LogLine(tr("Starting %1").arg(QDir::toNativeSeparators(job.input)));
 
-  // Create the pipeline.
-  // This should be a scoped_ptr, but scoped_ptr doesn't support custom destructors.
-  state->pipeline_ = gst_pipeline_new("pipeline");
-  if (!state->pipeline_) return false;
+  QList<PipelineTemplate> &pool = pipeline_pool_[PipelinePoolKey(job.preset)];
+  if (!pool.isEmpty()) {
+    // Reuse a parked pipeline from a previous job with this preset, only the file locations change.
+    // The decodebin re-typefinds the new input when the pipeline starts, so the source format doesn't matter.
+    const PipelineTemplate pipeline_template = pool.takeLast();
+    state->pipeline_ = pipeline_template.pipeline_;
+    state->src_element_ = pipeline_template.src_;
+    state->decode_element_ = pipeline_template.decode_;
+    state->convert_element_ = pipeline_template.convert_;
+    state->sink_element_ = pipeline_template.sink_;
+#ifdef HAVE_EBUR128
+    state->analysis_sink_ = pipeline_template.analysis_sink_;
+#endif
+  }
+  else {
 
-  // Create all the elements
-  GstElement *src      = CreateElement(QStringLiteral("filesrc"), state->pipeline_);
-  GstElement *decode   = CreateElement(QStringLiteral("decodebin"), state->pipeline_);
-  GstElement *convert  = CreateElement(QStringLiteral("audioconvert"), state->pipeline_);
-  GstElement *resample = CreateElement(QStringLiteral("audioresample"), state->pipeline_);
-  GstElement *codec    = CreateElementForMimeType(GST_ELEMENT_FACTORY_TYPE_AUDIO_ENCODER, job.preset.codec_mimetype_, state->pipeline_);
-  GstElement *muxer    = CreateElementForMimeType(GST_ELEMENT_FACTORY_TYPE_MUXER, job.preset.muxer_mimetype_, state->pipeline_);
-  GstElement *sink     = CreateElement(QStringLiteral("filesink"), state->pipeline_);
+    // Create the pipeline.
+    // This should be a scoped_ptr, but scoped_ptr doesn't support custom destructors.
+    state->pipeline_ = gst_pipeline_new("pipeline");
+    if (!state->pipeline_) return false;
+
+    // Create all the elements
+    GstElement *src      = CreateElement(QStringLiteral("filesrc"), state->pipeline_);
+    GstElement *decode   = CreateElement(QStringLiteral("decodebin"), state->pipeline_);
+    GstElement *convert  = CreateElement(QStringLiteral("audioconvert"), state->pipeline_);
+    GstElement *resample = CreateElement(QStringLiteral("audioresample"), state->pipeline_);
+    GstElement *codec    = CreateElementForMimeType(GST_ELEMENT_FACTORY_TYPE_AUDIO_ENCODER, job.preset.codec_mimetype_, state->pipeline_);
+    GstElement *muxer    = CreateElementForMimeType(GST_ELEMENT_FACTORY_TYPE_MUXER, job.preset.muxer_mimetype_, state->pipeline_);
+    GstElement *sink     = CreateElement(QStringLiteral("filesink"), state->pipeline_);
+
+    if (!src || !decode || !convert || !sink) return false;
+
+    if (!codec && !job.preset.codec_mimetype_.isEmpty()) {
+      emit LogLine(tr("Couldn't find an encoder for %1, check you have the correct GStreamer plugins installed").arg(job.preset.codec_mimetype_));
+      return false;
+    }
 
-  if (!src || !decode || !convert || !sink) return false;
+    if (!muxer && !job.preset.muxer_mimetype_.isEmpty()) {
+      emit LogLine(tr("Couldn't find a muxer for %1, check you have the correct GStreamer plugins installed").arg(job.preset.muxer_mimetype_));
+      return false;
+    }
 
-  if (!codec && !job.preset.codec_mimetype_.isEmpty()) {
-    emit LogLine(tr("Couldn't find an encoder for %1, check you have the correct GStreamer plugins installed").arg(job.preset.codec_mimetype_));
-    return false;
-  }
+    // Join them together
+    gst_element_link(src, decode);
+    gst_element_link(convert, resample);
+
+    GstElement *encode_from = resample;
+
+#ifdef HAVE_EBUR128
+    if (analyze_loudness_) {
+      // Tee the decoded audio into an appsink, so loudness is measured during the transcode pass instead of by decoding the output a second time.
+      GstElement *tee              = CreateElement(QStringLiteral("tee"), state->pipeline_);
+      GstElement *analysis_queue   = CreateElement(QStringLiteral("queue2"), state->pipeline_);
+      GstElement *analysis_convert = CreateElement(QStringLiteral("audioconvert"), state->pipeline_);
+      GstElement *analysis_sink    = CreateElement(QStringLiteral("appsink"), state->pipeline_);
+      if (!tee || !analysis_queue || !analysis_convert || !analysis_sink) return false;
+
+      gst_element_link(resample, tee);
+      gst_element_link(tee, analysis_queue);
+
+      GstStaticCaps static_caps = GST_STATIC_CAPS(
+        "audio/x-raw,"
+        "format = (string) { S16LE, S32LE, F32LE, F64LE },"
+        "layout = (string) interleaved");
+      GstCaps *caps = gst_static_caps_get(&static_caps);
+      gst_element_link(analysis_queue, analysis_convert);
+      gst_element_link_filtered(analysis_convert, analysis_sink, caps);
+      gst_caps_unref(caps);
+
+      // The queue decouples the analysis branch from the encoder branch, so a slow encoder never stalls behind the analysis and vice versa.
+      g_object_set(G_OBJECT(analysis_queue), "max-size-time", 60 * GST_SECOND, nullptr);
+      g_object_set(G_OBJECT(analysis_queue), "max-size-buffers", 0, nullptr);
+      g_object_set(G_OBJECT(analysis_queue), "max-size-bytes", 0, nullptr);
+      g_object_set(G_OBJECT(analysis_sink), "sync", FALSE, nullptr);
+      g_object_set(G_OBJECT(analysis_sink), "max-buffers", 1, nullptr);
+
+      state->analysis_sink_ = analysis_sink;
+      encode_from = tee;
+    }
+#endif
 
-  if (!muxer && !job.preset.muxer_mimetype_.isEmpty()) {
-    emit LogLine(tr("Couldn't find a muxer for %1, check you have the correct GStreamer plugins installed").arg(job.preset.muxer_mimetype_));
-    return false;
-  }
+    if (codec && muxer) gst_element_link_many(encode_from, codec, muxer, sink, nullptr);
+    else if (codec) gst_element_link_many(encode_from, codec, sink, nullptr);
+    else if (muxer) gst_element_link_many(encode_from, muxer, sink, nullptr);
 
-  // Join them together
-  gst_element_link(src, decode);
-  if (codec && muxer) gst_element_link_many(convert, resample, codec, muxer, sink, nullptr);
-  else if (codec) gst_element_link_many(convert, resample, codec, sink, nullptr);
-  else if (muxer) gst_element_link_many(convert, resample, muxer, sink, nullptr);
+    state->src_element_ = src;
+    state->decode_element_ = decode;
+    state->convert_element_ = convert;
+    state->sink_element_ = sink;
+  }
 
   // Set properties
-  g_object_set(src, "location", job.input.toUtf8().constData(), nullptr);
-  g_object_set(sink, "location", job.output.toUtf8().constData(), nullptr);
+  g_object_set(state->src_element_, "location", job.input.toUtf8().constData(), nullptr);
+  g_object_set(state->sink_element_, "location", job.output.toUtf8().constData(), nullptr);
 
   // Set callbacks
-  state->convert_element_ = convert;
-
-  CHECKED_GCONNECT(decode, "pad-added", &NewPadCallback, state.get());
+  state->pad_added_id_ = CHECKED_GCONNECT(state->decode_element_, "pad-added", &NewPadCallback, state.get());
   gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(state->pipeline_)), BusCallbackSync, state.get(), nullptr);
 
+#ifdef HAVE_EBUR128
+  if (state->analysis_sink_) {
+    state->loudness_stream_ = make_shared<EBUR128AnalysisStream>();
+    GstAppSinkCallbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    callbacks.new_sample = NewAnalysisBufferCallback;
+    gst_app_sink_set_callbacks(GST_APP_SINK(state->analysis_sink_), &callbacks, state.get(), nullptr);
+  }
+#endif
+
   // Start the pipeline
   gst_element_set_state(state->pipeline_, GST_STATE_PLAYING);
 
   // GStreamer now transcodes in another thread, so we can return now and do something else.
   // Keep the JobState object around.  It'll post an event to our event loop when it finishes.
+  SampleCpuUsage();
+  state->wall_timer_.start();
   current_jobs_ << state;
 
   return true;
@@ -486,10 +681,58 @@ bool Transcoder::event(QEvent *e) {
     QString input = (*it)->job_.input;
     QString output = (*it)->job_.output;
 
+    // Fold the cores this job kept busy into the cost estimate for its codec.
+    SampleCpuUsage();
+    const double wall_seconds = static_cast<double>((*it)->wall_timer_.elapsed()) / 1000.0;
+    if (wall_seconds > 0.0 && (*it)->attributed_cpu_seconds_ > 0.0) {
+      const double cores = std::clamp((*it)->attributed_cpu_seconds_ / wall_seconds, kMinJobCost, static_cast<double>(max_threads()));
+      const QString codec = (*it)->job_.preset.codec_mimetype_;
+      codec_costs_[codec] = codec_costs_.contains(codec) ? (codec_costs_[codec] + cores) / 2.0 : cores;
+    }
+
     // Remove event handlers from the gstreamer pipeline, so they don't get called after the pipeline is shutting down
     gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(finished_event->state_->pipeline_)), nullptr, nullptr, nullptr);
 
-    // Remove it from the list - this will also destroy the GStreamer pipeline
+#ifdef HAVE_EBUR128
+    if (finished_event->state_->analysis_sink_) {
+      GstAppSinkCallbacks callbacks;
+      memset(&callbacks, 0, sizeof(callbacks));
+      gst_app_sink_set_callbacks(GST_APP_SINK(finished_event->state_->analysis_sink_), &callbacks, nullptr, nullptr);
+    }
+    if (finished_event->success_ && finished_event->state_->loudness_stream_ && !finished_event->state_->loudness_failed_) {
+      const std::optional<EBUR128Measures> measures = finished_event->state_->loudness_stream_->Finalize();
+      if (measures) {
+        emit JobLoudnessComputed(input, output, measures.value());
+      }
+    }
+#endif
+
+    // Park the pipeline for the next job with the same preset, building one per file is a measurable cost on bulk syncs.
+    // Failed pipelines are not reused, and neither are ones that won't stop synchronously.
+    if (finished_event->success_) {
+      JobState *state = finished_event->state_;
+      QList<PipelineTemplate> &pool = pipeline_pool_[PipelinePoolKey(state->job_.preset)];
+      if (pool.count() < max_threads() && gst_element_set_state(state->pipeline_, GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS) {
+        if (state->pad_added_id_ != 0) {
+          g_signal_handler_disconnect(state->decode_element_, state->pad_added_id_);
+          state->pad_added_id_ = 0;
+        }
+        PipelineTemplate pipeline_template;
+        pipeline_template.pipeline_ = state->pipeline_;
+        pipeline_template.src_ = state->src_element_;
+        pipeline_template.decode_ = state->decode_element_;
+        pipeline_template.convert_ = state->convert_element_;
+        pipeline_template.sink_ = state->sink_element_;
+#ifdef HAVE_EBUR128
+        pipeline_template.analysis_sink_ = state->analysis_sink_;
+#endif
+        pool << pipeline_template;
+        // The pool owns the pipeline now, stop the JobState destructor from destroying it.
+        state->pipeline_ = nullptr;
+      }
+    }
+
+    // Remove it from the list - this will also destroy the GStreamer pipeline unless it was parked above
     current_jobs_.erase(it);  // clazy:exclude=strict-iterators
 
     // Emit the finished signal
@@ -29,6 +29,8 @@
 #include <gst/gst.h>
 
 #include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QMetaType>
@@ -36,9 +38,18 @@
 #include <QString>
 #include <QEvent>
 
+#ifdef HAVE_EBUR128
+#  include <gst/app/gstappsink.h>
+#endif
+
 #include "core/shared_ptr.h"
 #include "core/song.h"
 
+#ifdef HAVE_EBUR128
+#  include "engine/ebur128measures.h"
+class EBUR128AnalysisStream;
+#endif
+
 struct TranscoderPreset {
   explicit TranscoderPreset() : filetype_(Song::FileType::Unknown) {}
   TranscoderPreset(const Song::FileType filetype, const QString &name, const QString &extension, const QString &codec_mimetype, const QString &muxer_mimetype_ = QString());
@@ -56,6 +67,7 @@ class Transcoder : public QObject {
 
  public:
   explicit Transcoder(QObject *parent = nullptr, const QString &settings_postfix = QLatin1String(""));
+  ~Transcoder() override;
 
   static TranscoderPreset PresetForFileType(const Song::FileType filetype);
   static QList<TranscoderPreset> GetAllPresets();
@@ -64,6 +76,11 @@ class Transcoder : public QObject {
   int max_threads() const { return max_threads_; }
   void set_max_threads(int count) { max_threads_ = count; }
 
+#ifdef HAVE_EBUR128
+  // When enabled, jobs get a tee that measures the EBU R 128 loudness of the decoded audio during the transcode pass, reported through JobLoudnessComputed().
+  void set_analyze_loudness(const bool analyze) { analyze_loudness_ = analyze; }
+#endif
+
   static QString GetFile(const QString &input, const TranscoderPreset &preset, const QString &output = QString());
   void AddJob(const QString &input, const TranscoderPreset &preset, const QString &output);
 
@@ -78,6 +95,9 @@ class Transcoder : public QObject {
   void JobComplete(const QString &input, const QString &output, const bool success);
   void LogLine(const QString &message);
   void AllJobsComplete();
+#ifdef HAVE_EBUR128
+  void JobLoudnessComputed(const QString &input, const QString &output, const EBUR128Measures &measures);
+#endif
 
  protected:
   bool event(QEvent *e) override;
@@ -96,7 +116,16 @@ class Transcoder : public QObject {
         : job_(job),
           parent_(parent),
           pipeline_(nullptr),
-          convert_element_(nullptr) {}
+          src_element_(nullptr),
+          decode_element_(nullptr),
+          convert_element_(nullptr),
+          sink_element_(nullptr),
+#ifdef HAVE_EBUR128
+          analysis_sink_(nullptr),
+          loudness_failed_(false),
+#endif
+          pad_added_id_(0),
+          attributed_cpu_seconds_(0.0) {}
     ~JobState();
 
     void PostFinished(const bool success);
@@ -105,7 +134,20 @@ class Transcoder : public QObject {
     Job job_;
     Transcoder *parent_;
     GstElement *pipeline_;
+    GstElement *src_element_;
+    GstElement *decode_element_;
     GstElement *convert_element_;
+    GstElement *sink_element_;
+#ifdef HAVE_EBUR128
+    // Only set when the transcoder was asked to analyse loudness inline.
+    GstElement *analysis_sink_;
+    SharedPtr<EBUR128AnalysisStream> loudness_stream_;
+    bool loudness_failed_;
+#endif
+    gulong pad_added_id_;
+    // Used to measure how many cores this job kept busy, which feeds the per-codec cost estimates.
+    QElapsedTimer wall_timer_;
+    double attributed_cpu_seconds_;
    private:
     Q_DISABLE_COPY(JobState)
   };
@@ -122,6 +164,18 @@ class Transcoder : public QObject {
     Q_DISABLE_COPY(JobFinishedEvent)
   };
 
+  // A stopped pipeline parked for reuse by the next job with the same preset, so bulk syncs don't rebuild a pipeline per file.
+  struct PipelineTemplate {
+    GstElement *pipeline_ = nullptr;
+    GstElement *src_ = nullptr;
+    GstElement *decode_ = nullptr;
+    GstElement *convert_ = nullptr;
+    GstElement *sink_ = nullptr;
+#ifdef HAVE_EBUR128
+    GstElement *analysis_sink_ = nullptr;
+#endif
+  };
+
   enum class StartJobStatus {
     StartedSuccessfully,
     FailedToStart,
@@ -132,12 +186,22 @@ class Transcoder : public QObject {
   StartJobStatus MaybeStartNextJob();
   bool StartJob(const Job &job);
 
+  // Distributes the process CPU time used since the last sample evenly over the running jobs.
+  void SampleCpuUsage();
+  // The measured cost of one job with this preset, in cores. Defaults to a full core until the codec has been measured.
+  double JobCost(const TranscoderPreset &preset) const;
+
+  QString PipelinePoolKey(const TranscoderPreset &preset) const;
+
   GstElement *CreateElement(const QString &factory_name, GstElement *bin = nullptr, const QString &name = QString());
   GstElement *CreateElementForMimeType(GstElementFactoryListType element_type, const QString &mime_type, GstElement *bin = nullptr);
   void SetElementProperties(const QString &name, GObject *object);
 
   static void NewPadCallback(GstElement*, GstPad *pad, gpointer data);
   static GstBusSyncReply BusCallbackSync(GstBus*, GstMessage *msg, gpointer data);
+#ifdef HAVE_EBUR128
+  static GstFlowReturn NewAnalysisBufferCallback(GstAppSink *app_sink, gpointer data);
+#endif
 
  private:
   using JobStateList = QList<SharedPtr<JobState>>;
@@ -146,6 +210,17 @@ class Transcoder : public QObject {
   QList<Job> queued_jobs_;
   JobStateList current_jobs_;
   QString settings_postfix_;
+
+  // Measured cores per job, keyed on codec mimetype. Codecs that turn out to be I/O bound cost less than a core, so more of them run at once.
+  QHash<QString, double> codec_costs_;
+  double last_cpu_seconds_;
+
+  // Parked pipelines, keyed on (codec mimetype, muxer mimetype). At most max_threads() per key.
+  QHash<QString, QList<PipelineTemplate>> pipeline_pool_;
+
+#ifdef HAVE_EBUR128
+  bool analyze_loudness_;
+#endif
 };
 
 #endif  // TRANSCODER_H
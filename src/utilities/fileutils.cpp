@@ -22,6 +22,13 @@
 
 #include <memory>
 
+#ifdef Q_OS_LINUX
+#  include <cerrno>
+#  include <cstring>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 #include <QByteArray>
 #include <QString>
 #include <QIODevice>
@@ -37,6 +44,31 @@ namespace Utilities {
 
 using std::unique_ptr;
 
+namespace {
+
+// Buffer size for the portable copy loop. Large writes keep slow removable media streaming instead of seeking.
+constexpr qint64 kCopyBufferSize = 8 * 1024 * 1024;
+
+// Copies the remaining content with a large userspace buffer. Both files are open and positioned.
+bool CopyFileBuffered(QFile &source_file, QFile &destination_file) {
+
+  QByteArray buffer(kCopyBufferSize, Qt::Uninitialized);
+  forever {
+    const qint64 bytes_read = source_file.read(buffer.data(), buffer.size());
+    if (bytes_read < 0) return false;
+    if (bytes_read == 0) return true;
+    qint64 pos = 0;
+    while (pos < bytes_read) {
+      const qint64 bytes_written = destination_file.write(buffer.constData() + pos, bytes_read - pos);
+      if (bytes_written < 0) return false;
+      pos += bytes_written;
+    }
+  }
+
+}
+
+}  // namespace
+
 QByteArray ReadDataFromFile(const QString &filename) {
 
   QFile file(filename);
@@ -83,6 +115,72 @@ bool Copy(QIODevice *source, QIODevice *destination) {
 
 }
 
+bool CopyFileFast(const QString &source, const QString &destination) {
+
+  if (QFile::exists(destination)) return false;
+
+  QFile source_file(source);
+  if (!source_file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Failed to open file" << source << "for reading:" << source_file.errorString();
+    return false;
+  }
+
+  QFile destination_file(destination);
+  if (!destination_file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Failed to open file" << destination << "for writing:" << destination_file.errorString();
+    return false;
+  }
+
+  const qint64 size = source_file.size();
+  bool success = true;
+
+#ifdef Q_OS_LINUX
+  if (size > 0) {
+    // Reserve the space up front, so the filesystem can allocate contiguously instead of growing the file write by write.
+    // Not all filesystems support it, failure just means we don't get the preallocation.
+    (void)posix_fallocate(destination_file.handle(), 0, size);
+  }
+  // Let the kernel move the bytes directly between the files; falls back to the buffered loop on filesystems that don't support it.
+  qint64 remaining = size;
+  while (remaining > 0) {
+    const ssize_t result = copy_file_range(source_file.handle(), nullptr, destination_file.handle(), nullptr, static_cast<size_t>(remaining), 0);
+    if (result < 0) {
+      if (remaining == size && (errno == EINVAL || errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP)) {
+        success = CopyFileBuffered(source_file, destination_file);
+      }
+      else {
+        qLog(Error) << "Failed to copy file" << source << "to" << destination << ":" << strerror(errno);
+        success = false;
+      }
+      break;
+    }
+    if (result == 0) {
+      // Unexpected EOF: the source was truncated while being copied. Don't keep retrying, treat the short copy as a failure.
+      qLog(Error) << "Failed to copy file" << source << "to" << destination << ": file truncated while copying";
+      success = false;
+      break;
+    }
+    remaining -= result;
+  }
+#else
+  success = CopyFileBuffered(source_file, destination_file);
+#endif
+
+  source_file.close();
+  destination_file.close();
+
+  if (!success) {
+    // Same as QFile::copy, don't leave a partial destination file behind.
+    QFile::remove(destination);
+    return false;
+  }
+
+  destination_file.setPermissions(source_file.permissions());
+
+  return true;
+
+}
+
 bool CopyRecursive(const QString &source, const QString &destination) {
 
   // Make the destination directory
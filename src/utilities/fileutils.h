@@ -29,6 +29,9 @@ namespace Utilities {
 
 QByteArray ReadDataFromFile(const QString &filename);
 bool Copy(QIODevice *source, QIODevice *destination);
+// Copies one file with QFile::copy semantics (fails if the destination exists, no partial file left behind),
+// but preallocates the destination and uses copy_file_range where the platform supports it.
+bool CopyFileFast(const QString &source, const QString &destination);
 bool CopyRecursive(const QString &source, const QString &destination);
 bool RemoveRecursive(const QString &path);
 
@@ -17,6 +17,7 @@
  *
  */
 
+#include <QtConcurrent>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
@@ -101,8 +102,15 @@ QImage ImageUtils::ScaleImage(const QImage &image, const QSize desired_size, con
 
   QSize scale_size(static_cast<int>(desired_size.width() * device_pixel_ratio), static_cast<int>(desired_size.height() * device_pixel_ratio));
 
+  // For large shrinks, pre-scale with the fast transform to twice the target size first,
+  // so the smooth pass only has to filter a fraction of the pixels with no visible quality loss.
+  QImage source_image = image;
+  if (source_image.width() >= scale_size.width() * 4 && source_image.height() >= scale_size.height() * 4) {
+    source_image = source_image.scaled(scale_size * 2, Qt::KeepAspectRatio, Qt::FastTransformation);
+  }
+
   // Scale the image
-  QImage image_scaled = image.scaled(scale_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  QImage image_scaled = source_image.scaled(scale_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 
   // Pad the image
   if (pad && image_scaled.width() != image_scaled.height()) {
@@ -122,6 +130,16 @@ QImage ImageUtils::ScaleImage(const QImage &image, const QSize desired_size, con
 
 }
 
+QList<QImage> ImageUtils::ScaleImages(const QList<QImage> &images, const QSize desired_size, const qreal device_pixel_ratio, const bool pad) {
+
+  if (images.isEmpty()) return QList<QImage>();
+
+  return QtConcurrent::blockingMapped(images, [desired_size, device_pixel_ratio, pad](const QImage &image) {
+    return ScaleImage(image, desired_size, device_pixel_ratio, pad);
+  });
+
+}
+
 QImage ImageUtils::GenerateNoCoverImage(const QSize size, const qreal device_pixel_ratio) {
 
   QImage image(QStringLiteral(":/pictures/cdcase.png"));
@@ -22,6 +22,7 @@
 
 #include <QByteArray>
 #include <QByteArrayList>
+#include <QList>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -40,6 +41,9 @@ class ImageUtils {
   static QByteArray SaveImageToJpegData(const QImage &image = QImage());
   static QByteArray FileToJpegData(const QString &filename);
   static QImage ScaleImage(const QImage &image, const QSize desired_size, const qreal device_pixel_ratio = 1.0F, const bool pad = true);
+  // Scales many images at once, spreading the work over the global thread pool to amortize per-image cost.
+  // Returns the scaled images in the same order as images.
+  static QList<QImage> ScaleImages(const QList<QImage> &images, const QSize desired_size, const qreal device_pixel_ratio = 1.0F, const bool pad = true);
   static QImage GenerateNoCoverImage(const QSize size, const qreal device_pixel_ratio);
 };
 
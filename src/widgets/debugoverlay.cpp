@@ -0,0 +1,267 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <atomic>
+#include <utility>
+
+#include <QWidget>
+#include <QColor>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QFont>
+#include <QFontMetrics>
+#include <QList>
+#include <QMap>
+#include <QMouseEvent>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QSize>
+#include <QStandardPaths>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+
+#include "core/logging.h"
+#include "debugoverlay.h"
+
+namespace {
+
+// Heartbeat interval; any extra delay before the timer fires is time the event loop spent busy or backed up.
+constexpr int kHeartbeatIntervalMs = 100;
+
+// Smoothing factor for the latency average.
+constexpr double kLatencyAvgWeight = 0.05;
+
+// Upper bound for the in-memory trace, at 10 latency samples per second plus one sample per instrumented paint.
+constexpr int kTraceMaxSamples = 500000;
+
+struct PaintStats {
+  qint64 count = 0;
+  qint64 total_nsecs = 0;
+  qint64 max_nsecs = 0;
+  qint64 last_nsecs = 0;
+};
+
+struct TraceSample {
+  qint64 msec;
+  QString metric;
+  double value_ms;
+};
+
+std::atomic<bool> sActive(false);
+QMutex sMutex;
+QMap<QString, PaintStats> sPaintStats;
+QList<TraceSample> sTrace;
+QElapsedTimer sTraceTimer;
+
+void AddTraceSample(const QString &metric, const double value_ms) {
+
+  if (sTrace.count() >= kTraceMaxSamples) return;
+  sTrace << TraceSample{sTraceTimer.elapsed(), metric, value_ms};
+
+}
+
+}  // namespace
+
+DebugOverlay::DebugOverlay(QWidget *parent)
+    : QWidget(parent),
+      heartbeat_timer_(new QTimer(this)),
+      latency_last_ms_(0.0),
+      latency_avg_ms_(0.0),
+      latency_max_ms_(0.0) {
+
+  setAttribute(Qt::WA_ShowWithoutActivating);
+
+  {
+    QMutexLocker l(&sMutex);
+    sPaintStats.clear();
+    sTrace.clear();
+    sTraceTimer.start();
+  }
+  sActive.store(true, std::memory_order_relaxed);
+
+  heartbeat_timer_->setInterval(kHeartbeatIntervalMs);
+  heartbeat_timer_->setTimerType(Qt::PreciseTimer);
+  QObject::connect(heartbeat_timer_, &QTimer::timeout, this, &DebugOverlay::Heartbeat);
+  heartbeat_.start();
+  heartbeat_timer_->start();
+
+  if (parent) parent->installEventFilter(this);
+
+  resize(320, 120);
+  Reposition();
+  show();
+  raise();
+
+}
+
+DebugOverlay::~DebugOverlay() {
+
+  sActive.store(false, std::memory_order_relaxed);
+
+}
+
+bool DebugOverlay::IsActive() {
+  return sActive.load(std::memory_order_relaxed);
+}
+
+void DebugOverlay::RecordPaint(const char *name, const qint64 nsecs) {
+
+  const QString metric = QString::fromLatin1(name);
+
+  QMutexLocker l(&sMutex);
+  PaintStats &stats = sPaintStats[metric];
+  ++stats.count;
+  stats.total_nsecs += nsecs;
+  stats.last_nsecs = nsecs;
+  if (nsecs > stats.max_nsecs) stats.max_nsecs = nsecs;
+  AddTraceSample(metric, static_cast<double>(nsecs) / 1e6);
+
+}
+
+void DebugOverlay::Heartbeat() {
+
+  const qint64 elapsed_nsecs = heartbeat_.nsecsElapsed();
+  heartbeat_.restart();
+
+  latency_last_ms_ = qMax(0.0, static_cast<double>(elapsed_nsecs) / 1e6 - kHeartbeatIntervalMs);
+  latency_avg_ms_ = latency_avg_ms_ * (1.0 - kLatencyAvgWeight) + latency_last_ms_ * kLatencyAvgWeight;
+  if (latency_last_ms_ > latency_max_ms_) latency_max_ms_ = latency_last_ms_;
+
+  {
+    QMutexLocker l(&sMutex);
+    AddTraceSample(QStringLiteral("event_loop_latency"), latency_last_ms_);
+  }
+
+  update();
+
+}
+
+void DebugOverlay::paintEvent(QPaintEvent *event) {
+
+  Q_UNUSED(event)
+
+  QStringList lines;
+  lines << QStringLiteral("loop latency %1 / %2 / %3 ms (last/avg/max)").arg(latency_last_ms_, 0, 'f', 1).arg(latency_avg_ms_, 0, 'f', 1).arg(latency_max_ms_, 0, 'f', 1);
+
+  {
+    QMutexLocker l(&sMutex);
+    for (QMap<QString, PaintStats>::const_iterator it = sPaintStats.constBegin(); it != sPaintStats.constEnd(); ++it) {
+      const PaintStats &stats = it.value();
+      lines << QStringLiteral("%1 paint %2 / %3 / %4 ms (%5x)")
+                   .arg(it.key())
+                   .arg(static_cast<double>(stats.last_nsecs) / 1e6, 0, 'f', 1)
+                   .arg(static_cast<double>(stats.total_nsecs) / static_cast<double>(stats.count) / 1e6, 0, 'f', 1)
+                   .arg(static_cast<double>(stats.max_nsecs) / 1e6, 0, 'f', 1)
+                   .arg(stats.count);
+    }
+  }
+
+  lines << QStringLiteral("click to export trace");
+
+  QFont font(QStringLiteral("Monospace"));
+  font.setStyleHint(QFont::TypeWriter);
+  font.setPointSize(8);
+  const QFontMetrics metrics(font);
+
+  int width = 0;
+  for (const QString &line : std::as_const(lines)) {
+    width = qMax(width, metrics.horizontalAdvance(line));
+  }
+  const QSize size(width + 16, lines.count() * metrics.height() + 12);
+  if (size != this->size()) {
+    resize(size);
+    Reposition();
+  }
+
+  QPainter p(this);
+  p.setRenderHint(QPainter::Antialiasing);
+  p.setPen(Qt::NoPen);
+  p.setBrush(QColor(0, 0, 0, 176));
+  p.drawRoundedRect(rect(), 6, 6);
+
+  p.setFont(font);
+  p.setPen(QColor(224, 224, 224));
+  int y = 6 + metrics.ascent();
+  for (const QString &line : std::as_const(lines)) {
+    p.drawText(8, y, line);
+    y += metrics.height();
+  }
+
+}
+
+void DebugOverlay::mousePressEvent(QMouseEvent *event) {
+
+  Q_UNUSED(event)
+
+  ExportTrace();
+
+}
+
+bool DebugOverlay::eventFilter(QObject *object, QEvent *event) {
+
+  if (object == parentWidget() && event->type() == QEvent::Resize) {
+    Reposition();
+  }
+
+  return QWidget::eventFilter(object, event);
+
+}
+
+void DebugOverlay::Reposition() {
+
+  if (!parentWidget()) return;
+
+  move(parentWidget()->width() - width() - 12, 12);
+
+}
+
+void DebugOverlay::ExportTrace() {
+
+  const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  QDir().mkpath(directory);
+  const QString filename = directory + QStringLiteral("/debug-trace-") + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")) + QStringLiteral(".csv");
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    qLog(Error) << "Could not open" << filename << "for writing.";
+    return;
+  }
+
+  QTextStream s(&file);
+  s << "msec,metric,value_ms\n";
+  {
+    QMutexLocker l(&sMutex);
+    for (const TraceSample &sample : std::as_const(sTrace)) {
+      s << sample.msec << ',' << sample.metric << ',' << QString::number(sample.value_ms, 'f', 3) << '\n';
+    }
+  }
+  file.close();
+
+  qLog(Info) << "Exported debug trace to" << filename;
+
+}
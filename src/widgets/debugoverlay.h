@@ -0,0 +1,87 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DEBUGOVERLAY_H
+#define DEBUGOVERLAY_H
+
+#include "config.h"
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QString>
+
+class QTimer;
+class QEvent;
+class QPaintEvent;
+class QMouseEvent;
+
+// Semi-transparent overlay in the corner of the main window for attributing UI jank, toggled from the tools menu.
+// Shows main thread event loop latency sampled with a heartbeat timer, and the paint times of the instrumented views.
+// All samples are kept while the overlay is up; clicking the overlay exports them as a CSV trace.
+class DebugOverlay : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit DebugOverlay(QWidget *parent);
+  ~DebugOverlay() override;
+
+  // Cheap check for instrumentation sites; sampling only costs anything while the overlay is up.
+  static bool IsActive();
+  // Records one paint of an instrumented widget. Only call when IsActive().
+  static void RecordPaint(const char *name, const qint64 nsecs);
+
+ protected:
+  void paintEvent(QPaintEvent *event) override;
+  void mousePressEvent(QMouseEvent *event) override;
+  bool eventFilter(QObject *object, QEvent *event) override;
+
+ private slots:
+  void Heartbeat();
+
+ private:
+  void Reposition();
+  void ExportTrace();
+
+ private:
+  QTimer *heartbeat_timer_;
+  QElapsedTimer heartbeat_;
+  double latency_last_ms_;
+  double latency_avg_ms_;
+  double latency_max_ms_;
+};
+
+// Times a scope and records it to the overlay, used at the top of the instrumented paintEvent implementations.
+class ScopedPaintTimer {
+ public:
+  explicit ScopedPaintTimer(const char *name) : name_(name), active_(DebugOverlay::IsActive()) {
+    if (active_) timer_.start();
+  }
+  ~ScopedPaintTimer() {
+    if (active_) DebugOverlay::RecordPaint(name_, timer_.nsecsElapsed());
+  }
+
+ private:
+  Q_DISABLE_COPY(ScopedPaintTimer)
+
+  const char *name_;
+  bool active_;
+  QElapsedTimer timer_;
+};
+
+#endif  // DEBUGOVERLAY_H
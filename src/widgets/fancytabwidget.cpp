@@ -73,6 +73,10 @@ const int FancyTabWidget::TabSize_LargeSidebarMinWidth = 70;
 class FancyTabBar : public QTabBar {  // clazy:exclude=missing-qobject-macro
 
  private:
+  // The selection shadow/highlight lines extend slightly outside the tab rect, so the cached pixmaps carry a margin.
+  static const int kTabCacheMarginTop = 2;
+  static const int kTabCacheMarginBottom = 1;
+
   int mouseHoverTabIndex = -1;
   QHash<QWidget*, QString> labelCache;
   QMap<int, QWidget*> spacers;
@@ -231,118 +235,164 @@ class FancyTabBar : public QTabBar {  // clazy:exclude=missing-qobject-macro
 
     for (int index = 0; index < count(); ++index) {
       const bool selected = tabWidget->currentIndex() == index;
-      QRect tabrect = tabRect(index);
-      QRect selectionRect = tabrect;
-      if (selected) {
-        // Selection highlight
-        p.save();
-        QLinearGradient grad(selectionRect.topLeft(), selectionRect.topRight());
-        grad.setColorAt(0, QColor(255, 255, 255, 140));
-        grad.setColorAt(1, QColor(255, 255, 255, 210));
-        p.fillRect(selectionRect.adjusted(0,0,0,-1), grad);
-        p.restore();
-
-        // shadow lines
-        p.setPen(QColor(0, 0, 0, 110));
-        p.drawLine(selectionRect.topLeft()    + QPoint(1, -1), selectionRect.topRight()    - QPoint(0, 1));
-        p.drawLine(selectionRect.bottomLeft(), selectionRect.bottomRight());
-        p.setPen(QColor(0, 0, 0, 40));
-        p.drawLine(selectionRect.topLeft(),    selectionRect.bottomLeft());
-
-        // highlights
-        p.setPen(QColor(255, 255, 255, 50));
-        p.drawLine(selectionRect.topLeft()    + QPoint(0, -2), selectionRect.topRight()    - QPoint(0, 2));
-        p.drawLine(selectionRect.bottomLeft() + QPoint(0, 1),  selectionRect.bottomRight() + QPoint(0, 1));
-        p.setPen(QColor(255, 255, 255, 40));
-        p.drawLine(selectionRect.topLeft()    + QPoint(0, 0),  selectionRect.topRight());
-        p.drawLine(selectionRect.topRight()   + QPoint(0, 1),  selectionRect.bottomRight() - QPoint(0, 1));
-        p.drawLine(selectionRect.bottomLeft() + QPoint(0, -1), selectionRect.bottomRight() - QPoint(0, 1));
-
+      const bool hovered = !selected && index == mouseHoverTabIndex && isTabEnabled(index);
+      const QRect tabrect = tabRect(index);
+      const qreal dpr = devicePixelRatioF();
+
+      // Tab visuals only depend on these inputs, so cache the rendered tab and make repaints a blit.
+      // Theme, font, icon and size changes all change the key, stale entries age out of QPixmapCache.
+      const QString key = QStringLiteral("fancytabbar %1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12")
+        .arg(tabText(index))
+        .arg(tabIcon(index).cacheKey())
+        .arg(selected)
+        .arg(hovered)
+        .arg(tabrect.width())
+        .arg(tabrect.height())
+        .arg(QTabBar::width())
+        .arg(verticalTextTabs)
+        .arg(dpr)
+        .arg(verticalTextTabs ? tabWidget->iconsize_smallsidebar() : tabWidget->iconsize_largesidebar())
+        .arg(palette().cacheKey())
+        .arg(font().key());
+
+      QPixmap pixmap;
+      if (!QPixmapCache::find(key, &pixmap)) {
+        pixmap = RenderTab(index, tabrect.size(), selected, hovered, verticalTextTabs, tabWidget, dpr);
+        QPixmapCache::insert(key, pixmap);
       }
 
-      // Mouse hover effect
-      if (!selected && index == mouseHoverTabIndex && isTabEnabled(index)) {
-        p.save();
-        QLinearGradient grad(selectionRect.topLeft(),  selectionRect.topRight());
-        grad.setColorAt(0, Qt::transparent);
-        grad.setColorAt(0.5, QColor(255, 255, 255, 40));
-        grad.setColorAt(1, Qt::transparent);
-        p.fillRect(selectionRect, grad);
-        p.setPen(QPen(grad, 1.0));
-        p.drawLine(selectionRect.topLeft(),     selectionRect.topRight());
-        p.drawLine(selectionRect.bottomRight(), selectionRect.bottomLeft());
-        p.restore();
-      }
+      p.drawPixmap(tabrect.topLeft() - QPoint(0, kTabCacheMarginTop), pixmap);
+    }
+  }
+
+  QPixmap RenderTab(const int index, const QSize &size, const bool selected, const bool hovered, const bool verticalTextTabs, FancyTabWidget *tabWidget, const qreal dpr) const {
 
-      // Label (Icon and Text)
-      {
-        p.save();
-        QTransform m;
-        int textFlags = 0;
-        Qt::Alignment iconFlags;
+    QPixmap pixmap(QSize(size.width(), size.height() + kTabCacheMarginTop + kTabCacheMarginBottom) * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
 
-        QRect tabrectText;
-        QRect tabrectLabel;
+    QPainter p(&pixmap);
+    p.setFont(font());
+    p.translate(0, kTabCacheMarginTop);
+
+    const QRect tabrect(QPoint(0, 0), size);
+    const QRect selectionRect = tabrect;
+
+    if (selected) {
+      // Selection highlight
+      p.save();
+      QLinearGradient grad(selectionRect.topLeft(), selectionRect.topRight());
+      grad.setColorAt(0, QColor(255, 255, 255, 140));
+      grad.setColorAt(1, QColor(255, 255, 255, 210));
+      p.fillRect(selectionRect.adjusted(0,0,0,-1), grad);
+      p.restore();
+
+      // shadow lines
+      p.setPen(QColor(0, 0, 0, 110));
+      p.drawLine(selectionRect.topLeft()    + QPoint(1, -1), selectionRect.topRight()    - QPoint(0, 1));
+      p.drawLine(selectionRect.bottomLeft(), selectionRect.bottomRight());
+      p.setPen(QColor(0, 0, 0, 40));
+      p.drawLine(selectionRect.topLeft(),    selectionRect.bottomLeft());
+
+      // highlights
+      p.setPen(QColor(255, 255, 255, 50));
+      p.drawLine(selectionRect.topLeft()    + QPoint(0, -2), selectionRect.topRight()    - QPoint(0, 2));
+      p.drawLine(selectionRect.bottomLeft() + QPoint(0, 1),  selectionRect.bottomRight() + QPoint(0, 1));
+      p.setPen(QColor(255, 255, 255, 40));
+      p.drawLine(selectionRect.topLeft()    + QPoint(0, 0),  selectionRect.topRight());
+      p.drawLine(selectionRect.topRight()   + QPoint(0, 1),  selectionRect.bottomRight() - QPoint(0, 1));
+      p.drawLine(selectionRect.bottomLeft() + QPoint(0, -1), selectionRect.bottomRight() - QPoint(0, 1));
+
+    }
 
-        if (verticalTextTabs) {
-          m = QTransform::fromTranslate(tabrect.left(), tabrect.bottom());
-          m.rotate(-90);
-          textFlags = Qt::AlignVCenter;
-          iconFlags = Qt::AlignVCenter;
+    // Mouse hover effect
+    if (hovered) {
+      p.save();
+      QLinearGradient grad(selectionRect.topLeft(),  selectionRect.topRight());
+      grad.setColorAt(0, Qt::transparent);
+      grad.setColorAt(0.5, QColor(255, 255, 255, 40));
+      grad.setColorAt(1, Qt::transparent);
+      p.fillRect(selectionRect, grad);
+      p.setPen(QPen(grad, 1.0));
+      p.drawLine(selectionRect.topLeft(),     selectionRect.topRight());
+      p.drawLine(selectionRect.bottomRight(), selectionRect.bottomLeft());
+      p.restore();
+    }
 
-          tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
+    // Label (Icon and Text)
+    {
+      p.save();
+      QTransform m;
+      int textFlags = 0;
+      Qt::Alignment iconFlags;
 
-          tabrectText = tabrectLabel;
-          tabrectText.translate(tabWidget->iconsize_smallsidebar() + 8, 0);
-        }
-        else {
-          m = QTransform::fromTranslate(tabrect.left(), tabrect.top());
-          textFlags = Qt::AlignHCenter | Qt::AlignBottom | Qt::TextWordWrap;
-          iconFlags = Qt::AlignHCenter | Qt::AlignTop;
+      QRect tabrectText;
+      QRect tabrectLabel;
 
-          tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
+      if (verticalTextTabs) {
+        // setTransform() replaces the painter transform, so the cache margin offset is folded into it.
+        m = QTransform::fromTranslate(tabrect.left(), tabrect.bottom() + kTabCacheMarginTop);
+        m.rotate(-90);
+        textFlags = Qt::AlignVCenter;
+        iconFlags = Qt::AlignVCenter;
 
-          tabrectText = tabrectLabel;
-          tabrectText.translate(0, -5);
-        }
+        tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
 
-        p.setTransform(m);
+        tabrectText = tabrectLabel;
+        tabrectText.translate(tabWidget->iconsize_smallsidebar() + 8, 0);
+      }
+      else {
+        m = QTransform::fromTranslate(tabrect.left(), tabrect.top() + kTabCacheMarginTop);
+        textFlags = Qt::AlignHCenter | Qt::AlignBottom | Qt::TextWordWrap;
+        iconFlags = Qt::AlignHCenter | Qt::AlignTop;
 
-        QFont boldFont(p.font());
-        boldFont.setBold(true);
-        p.setFont(boldFont);
+        tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
 
-        // Text drop shadow color
-        p.setPen(selected ? QColor(255, 255, 255, 160) : QColor(0, 0, 0, 110));
-        p.translate(0, 3);
-        p.drawText(tabrectText, textFlags, tabText(index));
+        tabrectText = tabrectLabel;
+        tabrectText.translate(0, -5);
+      }
 
-        // Text foreground color
-        p.translate(0, -1);
-        p.setPen(selected ? QColor(60, 60, 60) : StyleHelper::panelTextColor());
-        p.drawText(tabrectText, textFlags, tabText(index));
+      p.setTransform(m);
 
+      QFont boldFont(p.font());
+      boldFont.setBold(true);
+      p.setFont(boldFont);
 
-        // Draw the icon
-        QRect tabrectIcon;
-        if (verticalTextTabs) {
-          tabrectIcon = tabrectLabel;
-          tabrectIcon.setSize(QSize(tabWidget->iconsize_smallsidebar(), tabWidget->iconsize_smallsidebar()));
-          // Center the icon
-          const int moveRight = (QTabBar::width() - tabWidget->iconsize_smallsidebar()) / 2;
-          tabrectIcon.translate(5, moveRight);
-        }
-        else {
-          tabrectIcon = tabrectLabel;
-          tabrectIcon.setSize(QSize(tabWidget->iconsize_largesidebar(), tabWidget->iconsize_largesidebar()));
-          // Center the icon
-          const int moveRight = (QTabBar::width() - tabWidget->iconsize_largesidebar() - 1) / 2;
-          tabrectIcon.translate(moveRight, 5);
-        }
-        tabIcon(index).paint(&p, tabrectIcon, iconFlags);
-        p.restore();
+      // Text drop shadow color
+      p.setPen(selected ? QColor(255, 255, 255, 160) : QColor(0, 0, 0, 110));
+      p.translate(0, 3);
+      p.drawText(tabrectText, textFlags, tabText(index));
+
+      // Text foreground color
+      p.translate(0, -1);
+      p.setPen(selected ? QColor(60, 60, 60) : StyleHelper::panelTextColor());
+      p.drawText(tabrectText, textFlags, tabText(index));
+
+
+      // Draw the icon
+      QRect tabrectIcon;
+      if (verticalTextTabs) {
+        tabrectIcon = tabrectLabel;
+        tabrectIcon.setSize(QSize(tabWidget->iconsize_smallsidebar(), tabWidget->iconsize_smallsidebar()));
+        // Center the icon
+        const int moveRight = (QTabBar::width() - tabWidget->iconsize_smallsidebar()) / 2;
+        tabrectIcon.translate(5, moveRight);
+      }
+      else {
+        tabrectIcon = tabrectLabel;
+        tabrectIcon.setSize(QSize(tabWidget->iconsize_largesidebar(), tabWidget->iconsize_largesidebar()));
+        // Center the icon
+        const int moveRight = (QTabBar::width() - tabWidget->iconsize_largesidebar() - 1) / 2;
+        tabrectIcon.translate(moveRight, 5);
       }
+      tabIcon(index).paint(&p, tabrectIcon, iconFlags);
+      p.restore();
     }
+
+    p.end();
+
+    return pixmap;
+
   }
 
 };
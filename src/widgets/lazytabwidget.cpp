@@ -0,0 +1,55 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <utility>
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QShowEvent>
+
+#include "lazytabwidget.h"
+
+LazyTabWidget::LazyTabWidget(QWidget *parent)
+    : QWidget(parent),
+      widget_(nullptr) {
+
+  QVBoxLayout *layout = new QVBoxLayout(this);
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->setSpacing(0);
+
+}
+
+void LazyTabWidget::SetFactory(std::function<QWidget*()> factory) {
+
+  factory_ = std::move(factory);
+
+}
+
+void LazyTabWidget::showEvent(QShowEvent *e) {
+
+  if (!widget_ && factory_) {
+    widget_ = factory_();
+    layout()->addWidget(widget_);
+  }
+
+  QWidget::showEvent(e);
+
+}
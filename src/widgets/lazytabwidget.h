@@ -0,0 +1,59 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LAZYTABWIDGET_H
+#define LAZYTABWIDGET_H
+
+#include "config.h"
+
+#include <functional>
+
+#include <QWidget>
+
+class QShowEvent;
+
+// A tab page that constructs its real view the first time it becomes visible,
+// so rarely used tabs do not add to the startup time of the main window.
+// Usage:
+//    LazyTabWidget *tab = new LazyTabWidget(this);
+//    tab->SetFactory([this]() { return CreateExpensiveView(); });
+//    ui_->tabs->AddTab(tab, ...);
+class LazyTabWidget : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit LazyTabWidget(QWidget *parent = nullptr);
+
+  // The factory creates the view and does any wiring it needs, it is called at most once.
+  void SetFactory(std::function<QWidget*()> factory);
+
+  bool loaded() const { return widget_ != nullptr; }
+  QWidget *widget() const { return widget_; }
+
+ protected:
+  void showEvent(QShowEvent *e) override;
+
+ private:
+  std::function<QWidget*()> factory_;
+  QWidget *widget_;
+
+  Q_DISABLE_COPY(LazyTabWidget)
+};
+
+#endif  // LAZYTABWIDGET_H
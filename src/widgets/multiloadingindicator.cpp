@@ -79,6 +79,10 @@ void MultiLoadingIndicator::UpdateText() {
       task_text += QStringLiteral(" %1%").arg(percentage);
     }
 
+    if (!task.status.isEmpty()) {
+      task_text += QStringLiteral(" (%1)").arg(task.status);
+    }
+
     strings << task_text;
   }
 
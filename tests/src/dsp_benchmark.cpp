@@ -0,0 +1,199 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Microbenchmarks for the DSP hot paths: the FHT used by the analyzers, and the moodbar build and render passes.
+// All fixtures are synthetic and seeded, so numbers are comparable between runs and between releases.
+// Results are printed as ns/op and MB/s of input data processed.
+//
+// EBUR128Analysis is not benchmarked here because it decodes real media through a GStreamer pipeline;
+// its cost is dominated by the decoder, not by code in this tree.
+
+#include "config.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <QApplication>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPalette>
+#include <QSize>
+
+#include "analyzer/fht.h"
+
+#ifdef HAVE_MOODBAR
+#  include "moodbar/moodbarbuilder.h"
+#  include "moodbar/moodbarrenderer.h"
+#endif
+
+namespace {
+
+constexpr qint64 kMinRunNanosec = 500000000LL;
+
+// Runs op repeatedly for at least kMinRunNanosec and prints ns/op and the throughput over bytes_per_op of input.
+template <typename F>
+void RunBenchmark(const char *name, const qint64 bytes_per_op, F &&op) {
+
+  op();  // Warmup.
+
+  QElapsedTimer timer;
+  qint64 iterations = 0;
+  timer.start();
+  do {
+    op();
+    ++iterations;
+  } while (timer.nsecsElapsed() < kMinRunNanosec);
+
+  const double ns_per_op = static_cast<double>(timer.nsecsElapsed()) / static_cast<double>(iterations);
+  const double mb_per_s = static_cast<double>(bytes_per_op) / (ns_per_op / 1e9) / (1024.0 * 1024.0);
+
+  printf("%-32s %12.1f ns/op %10.1f MB/s %10lld ops\n", name, ns_per_op, mb_per_s, static_cast<long long>(iterations));
+
+}
+
+// Deterministic pseudo-PCM in the -1.0 .. 1.0 range.
+std::vector<float> SyntheticScope(const int size) {
+
+  std::minstd_rand generator(42);
+  std::uniform_real_distribution<float> distribution(-1.0F, 1.0F);
+
+  std::vector<float> scope(size);
+  for (int i = 0; i < size; ++i) {
+    scope[i] = distribution(generator);
+  }
+  return scope;
+
+}
+
+void BenchmarkFHT(const int exponent) {
+
+  FHT fht(exponent);
+  const std::vector<float> fixture = SyntheticScope(fht.size());
+  std::vector<float> scratch(fht.size());
+  const qint64 bytes_per_op = static_cast<qint64>(fht.size()) * static_cast<qint64>(sizeof(float));
+
+  char name[64];
+
+  snprintf(name, sizeof(name), "FHT::spectrum %d", fht.size());
+  RunBenchmark(name, bytes_per_op, [&fht, &fixture, &scratch]() {
+    scratch = fixture;
+    fht.spectrum(scratch.data());
+  });
+
+  snprintf(name, sizeof(name), "FHT::logSpectrum %d", fht.size());
+  std::vector<float> out(fht.size());
+  RunBenchmark(name, bytes_per_op, [&fht, &fixture, &scratch, &out]() {
+    scratch = fixture;
+    fht.logSpectrum(out.data(), scratch.data());
+  });
+
+  snprintf(name, sizeof(name), "FHT::power2 %d", fht.size());
+  RunBenchmark(name, bytes_per_op, [&fht, &fixture, &scratch]() {
+    scratch = fixture;
+    fht.power2(scratch.data());
+  });
+
+}
+
+#ifdef HAVE_MOODBAR
+
+void BenchmarkMoodbarBuilder() {
+
+  constexpr int kFrameSize = 1024;
+  constexpr int kFrameCount = 10000;  // Roughly a 4 minute track.
+
+  std::minstd_rand generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<double> magnitudes(kFrameSize);
+  for (int i = 0; i < kFrameSize; ++i) {
+    magnitudes[i] = distribution(generator);
+  }
+
+  {
+    MoodbarBuilder builder;
+    builder.Init(kFrameSize, 44100);
+    RunBenchmark("MoodbarBuilder::AddFrame", kFrameSize * static_cast<qint64>(sizeof(double)), [&builder, &magnitudes]() {
+      builder.AddFrame(magnitudes.data(), kFrameSize);
+    });
+  }
+
+  {
+    MoodbarBuilder prototype;
+    prototype.Init(kFrameSize, 44100);
+    for (int i = 0; i < kFrameCount; ++i) {
+      // Vary the frames a little so normalization has a real distribution to work on.
+      magnitudes[i % kFrameSize] = distribution(generator);
+      prototype.AddFrame(magnitudes.data(), kFrameSize);
+    }
+    RunBenchmark("MoodbarBuilder::Finish", kFrameCount * 3LL * static_cast<qint64>(sizeof(double)), [&prototype]() {
+      MoodbarBuilder builder = prototype;
+      const QByteArray data = builder.Finish(1000);
+      Q_UNUSED(data)
+    });
+  }
+
+}
+
+void BenchmarkMoodbarRenderer() {
+
+  constexpr int kMoodbarSamples = 1000;
+
+  std::minstd_rand generator(42);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  QByteArray data(kMoodbarSamples * 3, Qt::Uninitialized);
+  for (qint64 i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(distribution(generator));
+  }
+
+  const QPalette palette = qApp->palette();
+
+  RunBenchmark("MoodbarRenderer::Colors", data.size(), [&data, &palette]() {
+    const ColorVector colors = MoodbarRenderer::Colors(data, MoodbarRenderer::MoodbarStyle::Normal, palette);
+    Q_UNUSED(colors)
+  });
+
+  const ColorVector colors = MoodbarRenderer::Colors(data, MoodbarRenderer::MoodbarStyle::Normal, palette);
+  RunBenchmark("MoodbarRenderer::RenderToImage", static_cast<qint64>(colors.size()) * static_cast<qint64>(sizeof(QColor)), [&colors]() {
+    const QImage image = MoodbarRenderer::RenderToImage(colors, QSize(1000, 20));
+    Q_UNUSED(image)
+  });
+
+}
+
+#endif  // HAVE_MOODBAR
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+
+  QApplication a(argc, argv);  // Needed for the palette and the raster paint engine used by the render benchmarks.
+
+  BenchmarkFHT(7);  // 128 point transform, the analyzer default.
+  BenchmarkFHT(9);  // 512 point transform, the largest the analyzers use (sonogram).
+
+#ifdef HAVE_MOODBAR
+  BenchmarkMoodbarBuilder();
+  BenchmarkMoodbarRenderer();
+#endif
+
+  return 0;
+
+}
@@ -0,0 +1,268 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Microbenchmarks for the filter and search hot paths: PlaylistFilterParser parse and evaluate,
+// the CollectionFilter trigram index, and the SearchParserUtils value parsers,
+// over a generated 100k-song fixture. The fixture is seeded, so numbers are comparable between runs and releases.
+//
+// Build and run manually: make filter_benchmark && ./tests/filter_benchmark [results.json]
+// With a filename argument the results are also written as JSON for charting.
+
+#include "config.h"
+
+#include <cstdio>
+#include <random>
+#include <utility>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QStandardItemModel>
+#include <QString>
+#include <QStringList>
+
+#include "core/song.h"
+#include "collection/collectionfilter.h"
+#include "playlist/playlistfilterparser.h"
+#include "utilities/searchparserutils.h"
+
+namespace {
+
+constexpr int kSongCount = 100000;
+constexpr qint64 kMinRunNanosec = 500000000LL;
+
+struct BenchmarkResult {
+  QString name;
+  double ns_per_op = 0.0;
+  qint64 ops = 0;
+  qint64 items_per_op = 0;
+};
+
+QList<BenchmarkResult> sResults;
+
+// Runs op repeatedly for at least kMinRunNanosec, prints ns/op and throughput over items_per_op, and records the result for the JSON output.
+template <typename F>
+void RunBenchmark(const char *name, const qint64 items_per_op, F &&op) {
+
+  op();  // Warmup.
+
+  QElapsedTimer timer;
+  qint64 iterations = 0;
+  timer.start();
+  do {
+    op();
+    ++iterations;
+  } while (timer.nsecsElapsed() < kMinRunNanosec);
+
+  const double ns_per_op = static_cast<double>(timer.nsecsElapsed()) / static_cast<double>(iterations);
+  const double items_per_sec = static_cast<double>(items_per_op) / (ns_per_op / 1e9);
+
+  printf("%-44s %14.1f ns/op %12.2f Mitems/s %8lld ops\n", name, ns_per_op, items_per_sec / 1e6, static_cast<long long>(iterations));
+
+  BenchmarkResult result;
+  result.name = QString::fromLatin1(name);
+  result.ns_per_op = ns_per_op;
+  result.ops = iterations;
+  result.items_per_op = items_per_op;
+  sResults << result;
+
+}
+
+// Deterministic fixture with enough vocabulary that trigram and substring matches hit a realistic fraction of the library.
+QStringList WordPool() {
+
+  QStringList words;
+  words << QStringLiteral("love") << QStringLiteral("night") << QStringLiteral("blue") << QStringLiteral("fire") << QStringLiteral("rain")
+        << QStringLiteral("heart") << QStringLiteral("road") << QStringLiteral("dream") << QStringLiteral("light") << QStringLiteral("time")
+        << QStringLiteral("stone") << QStringLiteral("river") << QStringLiteral("gold") << QStringLiteral("shadow") << QStringLiteral("wild")
+        << QStringLiteral("home") << QStringLiteral("star") << QStringLiteral("ghost") << QStringLiteral("summer") << QStringLiteral("winter");
+  return words;
+
+}
+
+SongList GenerateSongs() {
+
+  const QStringList words = WordPool();
+  std::minstd_rand generator(42);
+
+  SongList songs;
+  songs.reserve(kSongCount);
+  for (int i = 0; i < kSongCount; ++i) {
+    Song song;
+    song.set_id(i + 1);
+    song.set_title(QStringLiteral("%1 %2 %3").arg(words[static_cast<int>(generator() % static_cast<unsigned>(words.count()))]).arg(words[static_cast<int>(generator() % static_cast<unsigned>(words.count()))]).arg(i));
+    song.set_artist(QStringLiteral("Artist %1 %2").arg(words[static_cast<int>(generator() % static_cast<unsigned>(words.count()))]).arg(i % 1000));
+    song.set_album(QStringLiteral("Album %1 %2").arg(words[static_cast<int>(generator() % static_cast<unsigned>(words.count()))]).arg(i % 10000));
+    song.set_year(1960 + static_cast<int>(generator() % 65U));
+    songs << song;
+  }
+
+  return songs;
+
+}
+
+// Playlist-shaped model over the fixture: one row per song with the columns the filter parser addresses.
+QStandardItemModel *MakePlaylistModel(const SongList &songs) {
+
+  QStandardItemModel *model = new QStandardItemModel;
+  model->setColumnCount(4);
+  model->setRowCount(songs.count());
+  for (int i = 0; i < songs.count(); ++i) {
+    const Song &song = songs[i];
+    model->setData(model->index(i, 0), song.title());
+    model->setData(model->index(i, 1), song.artist());
+    model->setData(model->index(i, 2), song.album());
+    model->setData(model->index(i, 3), song.year());
+  }
+
+  return model;
+
+}
+
+void WriteJson(const QString &filename) {
+
+  QJsonArray benchmarks;
+  for (const BenchmarkResult &result : std::as_const(sResults)) {
+    QJsonObject o;
+    o.insert(QStringLiteral("name"), result.name);
+    o.insert(QStringLiteral("ns_per_op"), result.ns_per_op);
+    o.insert(QStringLiteral("ops"), result.ops);
+    o.insert(QStringLiteral("items_per_op"), result.items_per_op);
+    benchmarks.append(o);
+  }
+  QJsonObject root;
+  root.insert(QStringLiteral("benchmarks"), benchmarks);
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    fprintf(stderr, "Could not write %s\n", filename.toLocal8Bit().constData());
+    return;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+  file.close();
+
+  printf("Results written to %s\n", filename.toLocal8Bit().constData());
+
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+
+  QCoreApplication a(argc, argv);
+
+  const SongList songs = GenerateSongs();
+  QStandardItemModel *model = MakePlaylistModel(songs);
+
+  QMap<QString, int> columns;
+  columns.insert(QStringLiteral("title"), 0);
+  columns.insert(QStringLiteral("artist"), 1);
+  columns.insert(QStringLiteral("album"), 2);
+  columns.insert(QStringLiteral("year"), 3);
+  QSet<int> numerical_columns;
+  numerical_columns << 3;
+
+  const QString simple_filter = QStringLiteral("love");
+  const QString complex_filter = QStringLiteral("artist:love AND (year:>1990 OR title:\"blue night\") -album:winter");
+
+  RunBenchmark("playlistfilter parse simple", 1, [&]() {
+    PlaylistFilterParser parser(simple_filter, columns, numerical_columns);
+    delete parser.parse();
+  });
+
+  RunBenchmark("playlistfilter parse complex", 1, [&]() {
+    PlaylistFilterParser parser(complex_filter, columns, numerical_columns);
+    delete parser.parse();
+  });
+
+  {
+    PlaylistFilterParser parser(simple_filter, columns, numerical_columns);
+    PlaylistFilterTree *tree = parser.parse();
+    PlaylistFilterColumnCache cache;
+    RunBenchmark("playlistfilter eval simple 100k rows", kSongCount, [&]() {
+      int matches = 0;
+      for (int i = 0; i < kSongCount; ++i) {
+        if (tree->accept(i, QModelIndex(), model, &cache)) ++matches;
+      }
+      Q_UNUSED(matches)
+    });
+    delete tree;
+  }
+
+  {
+    PlaylistFilterParser parser(complex_filter, columns, numerical_columns);
+    PlaylistFilterTree *tree = parser.parse();
+    PlaylistFilterColumnCache cache;
+    RunBenchmark("playlistfilter eval complex 100k rows", kSongCount, [&]() {
+      int matches = 0;
+      for (int i = 0; i < kSongCount; ++i) {
+        if (tree->accept(i, QModelIndex(), model, &cache)) ++matches;
+      }
+      Q_UNUSED(matches)
+    });
+    delete tree;
+  }
+
+  {
+    CollectionFilter filter;
+    RunBenchmark("collectionfilter index 100k songs", kSongCount, [&]() {
+      filter.ClearIndex();
+      for (const Song &song : songs) {
+        filter.UpdateSongIndex(song);
+      }
+    });
+  }
+
+  {
+    const QStringList times = QStringList() << QStringLiteral("3:45") << QStringLiteral("125") << QStringLiteral("2:01:30") << QStringLiteral("0:59");
+    RunBenchmark("searchparser parse time", times.count(), [&]() {
+      int total = 0;
+      for (const QString &time : times) {
+        total += Utilities::ParseSearchTime(time);
+      }
+      Q_UNUSED(total)
+    });
+  }
+
+  {
+    const QStringList ratings = QStringList() << QStringLiteral("4.5") << QStringLiteral("0.8") << QStringLiteral("3") << QStringLiteral("5");
+    RunBenchmark("searchparser parse rating", ratings.count(), [&]() {
+      float total = 0.0F;
+      for (const QString &rating : ratings) {
+        total += Utilities::ParseSearchRating(rating);
+      }
+      Q_UNUSED(total)
+    });
+  }
+
+  delete model;
+
+  if (argc > 1) {
+    WriteJson(QString::fromLocal8Bit(argv[1]));
+  }
+
+  return 0;
+
+}
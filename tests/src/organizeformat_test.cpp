@@ -184,3 +184,89 @@ TEST_F(OrganizeFormatTest, ReplaceSlashes) {
   EXPECT_EQ(QStringLiteral("foobarbaz"), format_.GetFilenameForSong(song_).filename);
 
 }
+
+TEST_F(OrganizeFormatTest, LiteralPercentInTagValue) {
+
+  // A '%' inside a tag value is kept as a literal, it is never expanded as another tag.
+  song_.set_artist(QStringLiteral("bob"));
+  song_.set_album(QStringLiteral("album"));
+
+  format_.set_format(QStringLiteral("%title"));
+  ASSERT_TRUE(format_.IsValid());
+
+  song_.set_title(QStringLiteral("100%artist"));
+  EXPECT_EQ(QStringLiteral("100%artist"), format_.GetFilenameForSong(song_).filename);
+
+  song_.set_title(QStringLiteral("%album"));
+  EXPECT_EQ(QStringLiteral("%album"), format_.GetFilenameForSong(song_).filename);
+
+}
+
+TEST_F(OrganizeFormatTest, BlocksDropIndependently) {
+
+  format_.set_format(QStringLiteral("{%artist/}{%album/}%track %title"));
+  ASSERT_TRUE(format_.IsValid());
+
+  song_.set_artist(QStringLiteral("artist"));
+  song_.set_album(QStringLiteral("album"));
+  song_.set_track(4);
+  song_.set_title(QStringLiteral("title"));
+  EXPECT_EQ(QStringLiteral("artist/album/04_title"), format_.GetFilenameForSong(song_).filename);
+
+  song_.set_album(QLatin1String(""));
+  EXPECT_EQ(QStringLiteral("artist/04_title"), format_.GetFilenameForSong(song_).filename);
+
+  song_.set_artist(QLatin1String(""));
+  EXPECT_EQ(QStringLiteral("04_title"), format_.GetFilenameForSong(song_).filename);
+
+}
+
+TEST_F(OrganizeFormatTest, BlockWithMultipleTags) {
+
+  // A block is dropped whole, including its literals, if any tag inside it resolves empty.
+  format_.set_format(QStringLiteral("Before{%artist - %album}After"));
+  ASSERT_TRUE(format_.IsValid());
+
+  song_.set_artist(QStringLiteral("artist"));
+  song_.set_album(QStringLiteral("album"));
+  EXPECT_EQ(QStringLiteral("Beforeartist_-_albumAfter"), format_.GetFilenameForSong(song_).filename);
+
+  song_.set_album(QLatin1String(""));
+  EXPECT_EQ(QStringLiteral("BeforeAfter"), format_.GetFilenameForSong(song_).filename);
+
+}
+
+TEST_F(OrganizeFormatTest, UniqueFilename) {
+
+  song_.set_artist(QStringLiteral("artist"));
+  song_.set_album(QStringLiteral("album"));
+  song_.set_title(QStringLiteral("title"));
+  song_.set_track(4);
+
+  // Only a non-empty title or track makes the result unique.
+  format_.set_format(QStringLiteral("%artist/%album"));
+  ASSERT_TRUE(format_.IsValid());
+  EXPECT_FALSE(format_.GetFilenameForSong(song_).unique_filename);
+
+  format_.set_format(QStringLiteral("%artist %title"));
+  ASSERT_TRUE(format_.IsValid());
+  EXPECT_TRUE(format_.GetFilenameForSong(song_).unique_filename);
+
+  format_.set_format(QStringLiteral("%track"));
+  ASSERT_TRUE(format_.IsValid());
+  EXPECT_TRUE(format_.GetFilenameForSong(song_).unique_filename);
+
+  song_.set_track(0);
+  EXPECT_FALSE(format_.GetFilenameForSong(song_).unique_filename);
+
+  // Tags inside blocks count too.
+  format_.set_format(QStringLiteral("{%track }%album"));
+  ASSERT_TRUE(format_.IsValid());
+  EXPECT_FALSE(format_.GetFilenameForSong(song_).unique_filename);
+  EXPECT_EQ(QStringLiteral("album"), format_.GetFilenameForSong(song_).filename);
+
+  song_.set_track(4);
+  EXPECT_TRUE(format_.GetFilenameForSong(song_).unique_filename);
+  EXPECT_EQ(QStringLiteral("04_album"), format_.GetFilenameForSong(song_).filename);
+
+}
@@ -0,0 +1,429 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// End-to-end benchmark for collection scanning.
+//
+// Generates a synthetic library under a temporary directory (file count, directory shape, tag padding
+// and formats are configurable), then drives CollectionWatcher and CollectionBackend headlessly the
+// same way SCollection wires them up, and reports files/sec for the cold full scan and the warm
+// incremental rescan, plus raw database write throughput and peak RSS.
+//
+// The scan reads tags through the strawberry-tagreader worker, so that binary has to be in the
+// working directory or on PATH, e.g. from the build directory:
+//
+//   PATH="$PWD/ext/strawberry-tagreader:$PATH" ./tests/scan_benchmark --files 10000 --dirs 200
+//
+// Settings and the scratch database use a dedicated application name, so runs never touch a real
+// Strawberry configuration or collection database.
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdio>
+
+#ifdef Q_OS_UNIX
+#  include <sys/resource.h>
+#endif
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QObject>
+#include <QStandardPaths>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+
+#include "core/database.h"
+#include "core/settings.h"
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "core/tagreaderclient.h"
+#include "core/taskmanager.h"
+#include "collection/collection.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionwatcher.h"
+#include "settings/collectionsettingspage.h"
+
+#if defined(HAVE_TAGLIB)
+#  include "tagreadertaglib.h"
+#elif defined(HAVE_TAGPARSER)
+#  include "tagreadertagparser.h"
+#endif
+
+using std::make_shared;
+
+namespace {
+
+struct BenchmarkOptions {
+  int files = 2000;
+  int dirs = 50;
+  int depth = 2;
+  int tag_padding = 0;
+  int concurrency = 1;
+  QStringList formats = QStringList() << QStringLiteral("wav");
+};
+
+// Writes a minimal but valid PCM WAV file: 44.1 kHz, mono, 16 bit, with a short data chunk.
+// The audio content does not matter for scanning, only that the tag reader accepts the file.
+bool WriteWavFile(const QString &filename, const int data_size) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) return false;
+
+  QDataStream s(&file);
+  s.setByteOrder(QDataStream::LittleEndian);
+
+  s.writeRawData("RIFF", 4);
+  s << static_cast<quint32>(36 + data_size);
+  s.writeRawData("WAVE", 4);
+
+  s.writeRawData("fmt ", 4);
+  s << static_cast<quint32>(16);         // Chunk size
+  s << static_cast<quint16>(1);          // PCM
+  s << static_cast<quint16>(1);          // Mono
+  s << static_cast<quint32>(44100);      // Sample rate
+  s << static_cast<quint32>(44100 * 2);  // Byte rate
+  s << static_cast<quint16>(2);          // Block align
+  s << static_cast<quint16>(16);         // Bits per sample
+
+  s.writeRawData("data", 4);
+  s << static_cast<quint32>(data_size);
+  const QByteArray data(data_size, '\0');
+  s.writeRawData(data.constData(), data.size());
+
+  file.close();
+
+  return true;
+
+}
+
+// Writes a bare MPEG-1 layer III stream: a run of silent 128 kbps 44.1 kHz frames with no tags.
+// 417 bytes per frame from 144 * 128000 / 44100.
+bool WriteMp3File(const QString &filename, const int frames) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) return false;
+
+  QByteArray frame(417, '\0');
+  frame[0] = static_cast<char>(0xFF);
+  frame[1] = static_cast<char>(0xFB);
+  frame[2] = static_cast<char>(0x90);
+  frame[3] = static_cast<char>(0x00);
+
+  for (int i = 0; i < frames; ++i) {
+    file.write(frame);
+  }
+
+  file.close();
+
+  return true;
+
+}
+
+// Writes tags in-process through the same taglib wrapper the worker uses, so generation does not depend on the worker binary.
+bool WriteTags(const QString &filename, const int file_index, const int dir_index, const int tag_padding) {
+
+#if defined(HAVE_TAGLIB)
+  TagReaderTagLib tag_reader;
+#elif defined(HAVE_TAGPARSER)
+  TagReaderTagParser tag_reader;
+#else
+  Q_UNUSED(file_index)
+  Q_UNUSED(dir_index)
+  Q_UNUSED(tag_padding)
+  return true;
+#endif
+
+#if defined(HAVE_TAGLIB) || defined(HAVE_TAGPARSER)
+  Song song;
+  song.set_title(QStringLiteral("Title %1").arg(file_index));
+  song.set_artist(QStringLiteral("Artist %1").arg(file_index / 100));
+  song.set_album(QStringLiteral("Album %1").arg(dir_index));
+  song.set_track(file_index % 20 + 1);
+  if (tag_padding > 0) {
+    song.set_comment(QString(tag_padding, QLatin1Char('x')));
+  }
+
+  spb::tagreader::WriteFileRequest request;
+  request.set_filename(filename.toStdString());
+  request.set_save_tags(true);
+  song.ToProtobuf(request.mutable_metadata());
+
+  return tag_reader.WriteFile(filename, request).success();
+#endif
+
+}
+
+// Builds the directory tree: leaf directory d becomes a chain of `depth` path segments, with the
+// fanout derived from the leaf count so the shape stays roughly balanced.
+QString LeafDirectory(const QString &root, const BenchmarkOptions &options, const int dir_index) {
+
+  int fanout = 2;
+  while (std::pow(static_cast<double>(fanout), options.depth) < static_cast<double>(options.dirs)) ++fanout;
+
+  QString path = root;
+  int remainder = dir_index;
+  for (int level = 0; level < options.depth; ++level) {
+    path += QStringLiteral("/dir%1-%2").arg(level).arg(remainder % fanout);
+    remainder /= fanout;
+  }
+
+  return path;
+
+}
+
+// Generates the synthetic library and returns the number of files written.
+int GenerateLibrary(const QString &root, const BenchmarkOptions &options) {
+
+  int written = 0;
+  for (int i = 0; i < options.files; ++i) {
+    const int dir_index = i % options.dirs;
+    const QString dir = LeafDirectory(root, options, dir_index);
+    if (!QDir().mkpath(dir)) break;
+
+    const QString format = options.formats[i % options.formats.count()];
+    const QString filename = dir + QStringLiteral("/track%1.%2").arg(i, 6, 10, QLatin1Char('0')).arg(format);
+
+    bool success = false;
+    if (format == QLatin1String("mp3")) {
+      success = WriteMp3File(filename, 38);  // ~1 second of audio
+    }
+    else {
+      success = WriteWavFile(filename, 8192);
+    }
+    if (!success) break;
+
+    WriteTags(filename, i, dir_index, options.tag_padding);
+
+    ++written;
+  }
+
+  return written;
+
+}
+
+// Spins the main event loop until the watcher has started and finished its scan task and both worker threads have drained.
+void WaitForScanToFinish(SharedPtr<TaskManager> task_manager, const bool *scan_started, CollectionWatcher *watcher, CollectionBackend *backend) {
+
+  QEventLoop loop;
+  QTimer poll;
+  poll.setInterval(50);
+  QObject::connect(&poll, &QTimer::timeout, &loop, [&]() {
+    if (*scan_started && task_manager->GetTasks().isEmpty()) loop.quit();
+  });
+  poll.start();
+  loop.exec();
+
+  // The scan task is gone, but songs can still be queued to the backend; flush the watcher thread, then the backend thread.
+  QMetaObject::invokeMethod(watcher, []() {}, Qt::BlockingQueuedConnection);
+  QMetaObject::invokeMethod(backend, []() {}, Qt::BlockingQueuedConnection);
+
+}
+
+// Peak resident set size so far, in MB.
+double PeakRssMb() {
+
+#ifdef Q_OS_UNIX
+  struct rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#  ifdef Q_OS_MACOS
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#  else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#  endif
+  }
+#endif
+
+  return 0.0;
+
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+
+  QCoreApplication a(argc, argv);
+  // Keep settings and the scratch database away from any real Strawberry installation.
+  QCoreApplication::setApplicationName(QStringLiteral("strawberry-scan-benchmark"));
+  QCoreApplication::setOrganizationName(QStringLiteral("strawberry-scan-benchmark"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral("Collection scan benchmark on a synthetic library"));
+  parser.addHelpOption();
+  parser.addOption({QStringLiteral("files"), QStringLiteral("Number of files to generate."), QStringLiteral("n"), QStringLiteral("2000")});
+  parser.addOption({QStringLiteral("dirs"), QStringLiteral("Number of leaf directories."), QStringLiteral("n"), QStringLiteral("50")});
+  parser.addOption({QStringLiteral("depth"), QStringLiteral("Directory nesting depth."), QStringLiteral("n"), QStringLiteral("2")});
+  parser.addOption({QStringLiteral("tag-padding"), QStringLiteral("Extra bytes of comment tag per file."), QStringLiteral("n"), QStringLiteral("0")});
+  parser.addOption({QStringLiteral("concurrency"), QStringLiteral("Scan concurrency (subdirectories scanned in parallel)."), QStringLiteral("n"), QStringLiteral("1")});
+  parser.addOption({QStringLiteral("formats"), QStringLiteral("Comma-separated file formats to alternate between (wav, mp3)."), QStringLiteral("list"), QStringLiteral("wav")});
+  parser.process(a);
+
+  BenchmarkOptions options;
+  options.files = parser.value(QStringLiteral("files")).toInt();
+  options.dirs = qBound(1, parser.value(QStringLiteral("dirs")).toInt(), options.files > 0 ? options.files : 1);
+  options.depth = qBound(1, parser.value(QStringLiteral("depth")).toInt(), 10);
+  options.tag_padding = parser.value(QStringLiteral("tag-padding")).toInt();
+  options.concurrency = qBound(1, parser.value(QStringLiteral("concurrency")).toInt(), 32);
+  options.formats = parser.value(QStringLiteral("formats")).split(QLatin1Char(','), Qt::SkipEmptyParts);
+  if (options.formats.isEmpty()) options.formats << QStringLiteral("wav");
+
+  // The watcher reads its settings when it is created.
+  {
+    Settings s;
+    s.beginGroup(CollectionSettingsPage::kSettingsGroup);
+    s.setValue("startup_scan", true);
+    s.setValue("monitor", false);
+    s.setValue("scan_concurrency", options.concurrency);
+    s.setValue("song_tracking", false);
+    s.setValue("song_ebur128_loudness_analysis", false);
+    s.endGroup();
+  }
+
+  QTemporaryDir library_dir;
+  if (!library_dir.isValid()) {
+    fprintf(stderr, "Could not create a temporary directory for the synthetic library.\n");
+    return 1;
+  }
+
+  printf("Generating %d files in %d directories under %s\n", options.files, options.dirs, library_dir.path().toLocal8Bit().constData());
+
+  QElapsedTimer timer;
+  timer.start();
+  const int generated = GenerateLibrary(library_dir.path(), options);
+  const double generate_secs = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+  if (generated < options.files) {
+    fprintf(stderr, "Only generated %d of %d files, aborting.\n", generated, options.files);
+    return 1;
+  }
+
+  // Wire up the tag reader, database, backend and watcher the same way SCollection does.
+
+  TagReaderClient *tag_reader_client = new TagReaderClient;
+  QThread tag_reader_thread;
+  tag_reader_client->moveToThread(&tag_reader_thread);
+  tag_reader_thread.start();
+  QObject::connect(tag_reader_client, &TagReaderClient::WorkerFailedToStart, &a, []() {
+    fprintf(stderr, "The strawberry-tagreader worker was not found in the working directory or on PATH.\n");
+    ::exit(1);
+  });
+  tag_reader_client->Start();
+
+  SharedPtr<Database> database = make_shared<Database>(nullptr);
+  SharedPtr<TaskManager> task_manager = make_shared<TaskManager>();
+
+  SharedPtr<CollectionBackend> backend = make_shared<CollectionBackend>();
+  backend->Init(database, task_manager, Song::Source::Collection, QLatin1String(SCollection::kSongsTable), QLatin1String(SCollection::kDirsTable), QLatin1String(SCollection::kSubdirsTable));
+
+  CollectionWatcher *watcher = new CollectionWatcher(Song::Source::Collection);
+  QThread watcher_thread;
+  watcher->moveToThread(&watcher_thread);
+  watcher_thread.start();
+
+  watcher->set_backend(backend);
+  watcher->set_task_manager(task_manager);
+
+  QObject::connect(&*backend, &CollectionBackend::DirectoryAdded, watcher, &CollectionWatcher::AddDirectory);
+  QObject::connect(&*backend, &CollectionBackend::DirectoryDeleted, watcher, &CollectionWatcher::RemoveDirectory);
+  QObject::connect(watcher, &CollectionWatcher::NewOrUpdatedSongs, &*backend, &CollectionBackend::AddOrUpdateSongs);
+  QObject::connect(watcher, &CollectionWatcher::SongsMTimeUpdated, &*backend, &CollectionBackend::UpdateMTimesOnly);
+  QObject::connect(watcher, &CollectionWatcher::SongsDeleted, &*backend, &CollectionBackend::DeleteSongs);
+  QObject::connect(watcher, &CollectionWatcher::SongsUnavailable, &*backend, &CollectionBackend::MarkSongsUnavailable);
+  QObject::connect(watcher, &CollectionWatcher::SubdirsDiscovered, &*backend, &CollectionBackend::AddOrUpdateSubdirs);
+  QObject::connect(watcher, &CollectionWatcher::SubdirsMTimeUpdated, &*backend, &CollectionBackend::AddOrUpdateSubdirs);
+  QObject::connect(watcher, &CollectionWatcher::CompilationsNeedUpdating, &*backend, &CollectionBackend::CompilationsNeedUpdating);
+  QObject::connect(watcher, &CollectionWatcher::UpdateLastSeen, &*backend, &CollectionBackend::UpdateLastSeen);
+
+  bool scan_started = false;
+  QObject::connect(watcher, &CollectionWatcher::ScanStarted, &a, [&scan_started]() { scan_started = true; });
+
+  // Cold full scan: directory discovery, tag reads through the worker and database inserts.
+  timer.restart();
+  backend->AddDirectoryAsync(library_dir.path());
+  WaitForScanToFinish(task_manager, &scan_started, watcher, &*backend);
+  const double full_scan_secs = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+
+  const int songs_in_db = backend->GetAllSongs().count();
+
+  // Warm incremental rescan: everything unchanged, so this measures traversal and mtime comparison.
+  scan_started = false;
+  timer.restart();
+  watcher->IncrementalScanAsync();
+  WaitForScanToFinish(task_manager, &scan_started, watcher, &*backend);
+  const double incremental_secs = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+
+  // Raw database write throughput, bypassing the watcher: insert a batch of synthetic songs directly.
+  const int db_batch_size = 5000;
+  SongList db_songs;
+  db_songs.reserve(db_batch_size);
+  for (int i = 0; i < db_batch_size; ++i) {
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_url(QUrl::fromLocalFile(QStringLiteral("/nonexistent/dbwrite/track%1.flac").arg(i)));
+    song.set_title(QStringLiteral("DB Title %1").arg(i));
+    song.set_artist(QStringLiteral("DB Artist %1").arg(i / 100));
+    song.set_album(QStringLiteral("DB Album %1").arg(i / 10));
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    song.set_valid(true);
+    db_songs << song;
+  }
+  timer.restart();
+  backend->AddOrUpdateSongs(db_songs);
+  const double db_write_secs = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+
+  printf("\n");
+  printf("%-28s %10.2f s\n", "generate library", generate_secs);
+  printf("%-28s %10.2f s %12.1f files/s\n", "full scan (cold)", full_scan_secs, static_cast<double>(generated) / full_scan_secs);
+  printf("%-28s %10.2f s %12.1f files/s\n", "incremental scan (warm)", incremental_secs, static_cast<double>(generated) / incremental_secs);
+  printf("%-28s %10.2f s %12.1f songs/s\n", "db write throughput", db_write_secs, static_cast<double>(db_batch_size) / db_write_secs);
+  printf("%-28s %10d of %d files\n", "songs in database", songs_in_db, generated);
+  printf("%-28s %10.1f MB\n", "peak rss", PeakRssMb());
+
+  // Tear down and remove the scratch database.
+  watcher->Stop();
+  QObject::disconnect(watcher, nullptr, &*backend, nullptr);
+  watcher_thread.quit();
+  watcher_thread.wait(5000);
+
+  backend->Close();
+  database->Close();
+
+  tag_reader_client->ExitAsync();
+  tag_reader_thread.quit();
+  tag_reader_thread.wait(5000);
+  delete tag_reader_client;
+
+  const QString data_dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  if (data_dir.contains(QLatin1String("strawberry-scan-benchmark"))) {
+    QDir(data_dir).removeRecursively();
+  }
+
+  return 0;
+
+}